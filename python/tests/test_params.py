@@ -24,6 +24,7 @@ from zvec import (
     AlterColumnOption,
     CollectionOption,
     FlatIndexParam,
+    FtsQueryParam,
     HnswIndexParam,
     IvfRabitqIndexParam,
     IndexOption,
@@ -478,6 +479,43 @@ class TestIvfRabitqQueryParam:
             param.nprobe = 10
 
 
+# ----------------------------
+# FtsQueryParam Test Case
+# ----------------------------
+class TestFtsQueryParam:
+    def test_default(self):
+        param = FtsQueryParam()
+        assert param.default_operator == ""
+        assert param.anytime == False
+        assert param.anytime_budget_us == 0
+        assert param.type == IndexType.FTS
+
+    def test_custom(self):
+        param = FtsQueryParam(
+            default_operator="AND", anytime=True, anytime_budget_us=500
+        )
+        assert param.default_operator == "AND"
+        assert param.anytime == True
+        assert param.anytime_budget_us == 500
+
+    def test_pickle_roundtrip(self):
+        import pickle
+
+        param = FtsQueryParam(anytime=True, anytime_budget_us=500)
+        restored = pickle.loads(pickle.dumps(param))
+        assert restored.anytime == True
+        assert restored.anytime_budget_us == 500
+
+    def test_readonly_attributes(self):
+        param = FtsQueryParam()
+        if sys.version_info >= (3, 11):
+            match_pattern = r"(can't set attribute|has no setter|readonly attribute)"
+        else:
+            match_pattern = r"can't set attribute"
+        with pytest.raises(AttributeError, match=match_pattern):
+            param.anytime = True
+
+
 # # ----------------------------
 # # IVFQueryParam Test Case
 # # ----------------------------
@@ -55,6 +55,7 @@ def test_enum_names(member, name):
         (IOBackendType.PREAD, 0),
         (IOBackendType.IO_URING, 2),
         (MetricType.COSINE, 3),
+        (MetricType.HAMMING, 5),
         (QuantizeType.INT8, 2),
         (StatusCode.OK, 0),
     ],
@@ -63,7 +64,7 @@ def test_enum_values(member, value):
     assert member.value == value
 
 
-@pytest.mark.parametrize("member", ["L2", "IP", "COSINE"])
+@pytest.mark.parametrize("member", ["L2", "IP", "COSINE", "HAMMING"])
 def test_metric_type_has_member(member):
     assert member in MetricType.__members__
 
@@ -945,6 +945,14 @@ class FtsIndexParam(IndexParam):
                     - "stemmer_lang" (Snowball language/algorithm; default
                       "english"), for example {"stemmer_lang":"porter"} for ES
                       behaviour.
+            Index:
+                - "phrase_shingles" (array of two-word strings, e.g.
+                  ["new york"]; default []). Each pair is also indexed as one
+                  term, so exact phrases containing it skip most position
+                  checks.
+                - "impact_ordered" (bool, default false). Sealed segments also
+                  store postings ordered by BM25 impact, used by anytime
+                  queries.
             Default is "".
 
     Examples:
@@ -997,6 +1005,9 @@ class FtsIndexParam(IndexParam):
                     stemmer:
                         - "stemmer_lang" (Snowball language/algorithm; default
                           "english").
+                Index:
+                    - "phrase_shingles" (array of two-word strings; default []).
+                    - "impact_ordered" (bool; default false).
                 Defaults to "".
         """
 
@@ -1031,23 +1042,31 @@ class FtsQueryParam(QueryParam):
     Query parameters for full-text search (FTS) index.
 
     Controls the default boolean operator used to combine adjacent bare terms
-    in a query string.
+    in a query string, and anytime ranking.
 
     Attributes:
         type (IndexType): Always ``IndexType.FTS``.
         default_operator (str): Default boolean operator for adjacent bare terms.
             Supported values (case-insensitive): "OR" (default), "AND".
+        anytime (bool): Rank OR-of-terms queries on fields indexed with
+            ``impact_ordered=True`` score-at-a-time, possibly stopping early with
+            an approximate top-k. Default is False.
+        anytime_budget_us (int): Per-segment time budget of anytime ranking in
+            microseconds; 0 means no limit. Default is 0.
 
     Examples:
         >>> params = FtsQueryParam(default_operator="AND")
         >>> print(params.default_operator)
         AND
+        >>> params = FtsQueryParam(anytime=True, anytime_budget_us=500)
     """
 
     def __getstate__(self) -> tuple: ...
     def __init__(
         self,
         default_operator: str = "",
+        anytime: bool = False,
+        anytime_budget_us: typing.SupportsInt = 0,
     ) -> None:
         """
         Constructs an FtsQueryParam instance.
@@ -1055,10 +1074,25 @@ class FtsQueryParam(QueryParam):
         Args:
             default_operator (str, optional): Default boolean operator for adjacent
                 bare terms. Supported: "OR", "AND". Defaults to "" (uses engine default).
+            anytime (bool, optional): Whether to use anytime ranking. Defaults to False.
+            anytime_budget_us (int, optional): Per-segment time budget of anytime
+                ranking in microseconds; 0 means no limit. Defaults to 0.
         """
 
     def __repr__(self) -> str: ...
     def __setstate__(self, arg0: tuple) -> None: ...
+    @property
+    def anytime(self) -> bool:
+        """
+        bool: Whether to use anytime ranking.
+        """
+
+    @property
+    def anytime_budget_us(self) -> int:
+        """
+        int: Per-segment time budget of anytime ranking in microseconds.
+        """
+
     @property
     def default_operator(self) -> str:
         """
@@ -240,6 +240,7 @@ class MetricType:
     - COSINE: Cosine similarity.
     - IP: Inner product (dot product).
     - L2: Euclidean distance (L2 norm).
+    - HAMMING: Hamming distance, for BINARY32/BINARY64 vectors.
 
     Examples:
         >>> import zvec
@@ -254,14 +255,17 @@ class MetricType:
       IP
 
       L2
+
+      HAMMING
     """
 
     COSINE: typing.ClassVar[MetricType]  # value = <MetricType.COSINE: 3>
     IP: typing.ClassVar[MetricType]  # value = <MetricType.IP: 2>
     L2: typing.ClassVar[MetricType]  # value = <MetricType.L2: 1>
+    HAMMING: typing.ClassVar[MetricType]  # value = <MetricType.HAMMING: 5>
     __members__: typing.ClassVar[
         dict[str, MetricType]
-    ]  # value = {'COSINE': <MetricType.COSINE: 3>, 'IP': <MetricType.IP: 2>, 'L2': <MetricType.L2: 1>}
+    ]  # value = {'COSINE': <MetricType.COSINE: 3>, 'IP': <MetricType.IP: 2>, 'L2': <MetricType.L2: 1>, 'HAMMING': <MetricType.HAMMING: 5>}
 
     def __eq__(self, other: typing.Any) -> bool: ...
     def __getstate__(self) -> int: ...
@@ -39,6 +39,7 @@ def init(
     invert_to_forward_scan_ratio: Optional[float] = None,
     brute_force_by_keys_ratio: Optional[float] = None,
     fts_brute_force_by_keys_ratio: Optional[float] = None,
+    fts_query_cache_mb: Optional[int] = None,
     memory_limit_mb: Optional[int] = None,
     jieba_dict_dir: Optional[str] = None,
 ) -> None:
@@ -97,6 +98,10 @@ def init(
             highly selective. Independent from ``brute_force_by_keys_ratio``
             because per-candidate FTS cost is higher.
             Range: [0.0, 1.0]. Default: ``0.05``.
+        fts_query_cache_mb (Optional[int], optional):
+            Memory in MB for caching per-segment FTS results of repeated
+            queries on sealed segments, counted against the memory limit.
+            ``0`` disables the cache. Default: ``32``.
         memory_limit_mb (Optional[int], optional):
             Soft memory cap in MB. Zvec may throttle or fail operations
             approaching this limit.
@@ -176,6 +181,8 @@ def init(
         config_dict["brute_force_by_keys_ratio"] = brute_force_by_keys_ratio
     if fts_brute_force_by_keys_ratio is not None:
         config_dict["fts_brute_force_by_keys_ratio"] = fts_brute_force_by_keys_ratio
+    if fts_query_cache_mb is not None:
+        config_dict["fts_query_cache_mb"] = fts_query_cache_mb
     if memory_limit_mb is not None:
         config_dict["memory_limit_mb"] = memory_limit_mb
     if jieba_dict_dir is not None:
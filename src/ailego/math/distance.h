@@ -228,6 +228,20 @@ struct Distance {
     return result;
   }
 
+  //! Compute the hamming distance between two vectors (BINARY32)
+  static float Hamming(const uint32_t *lhs, const uint32_t *rhs, size_t dim) {
+    float result;
+    HammingDistanceMatrix<uint32_t, 1, 1>::Compute(lhs, rhs, dim, &result);
+    return result;
+  }
+
+  //! Compute the hamming distance between two vectors (BINARY64)
+  static float Hamming(const uint64_t *lhs, const uint64_t *rhs, size_t dim) {
+    float result;
+    HammingDistanceMatrix<uint64_t, 1, 1>::Compute(lhs, rhs, dim, &result);
+    return result;
+  }
+
   //! Compute the cosine distance between two vectors (FP32)
   static float Cosine(const float *lhs, const float *rhs, size_t dim) {
     float result;
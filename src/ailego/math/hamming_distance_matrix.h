@@ -0,0 +1,93 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <type_traits>
+#include <zvec/ailego/internal/platform.h>
+#include "distance_utility.h"
+
+namespace zvec {
+namespace ailego {
+
+/*! Hamming Distance Matrix
+ *  The dimension is the number of bits, which is a multiple of the bit width
+ *  of the value type.
+ */
+template <typename T, size_t M, size_t N, typename = void>
+struct HammingDistanceMatrix;
+
+/*! Hamming Distance Matrix (BINARY32, M=1, N=1)
+ */
+template <>
+struct HammingDistanceMatrix<uint32_t, 1, 1> {
+  //! Type of value
+  using ValueType = uint32_t;
+
+  //! Compute the distance between matrix and query
+  static void Compute(const ValueType *m, const ValueType *q, size_t dim,
+                      float *out);
+};
+
+/*! Hamming Distance Matrix (BINARY64, M=1, N=1)
+ */
+template <>
+struct HammingDistanceMatrix<uint64_t, 1, 1> {
+  //! Type of value
+  using ValueType = uint64_t;
+
+  //! Compute the distance between matrix and query
+  static void Compute(const ValueType *m, const ValueType *q, size_t dim,
+                      float *out);
+};
+
+/*! Hamming Distance Matrix (M>=2, N>=1)
+ */
+template <typename T, size_t M, size_t N>
+struct HammingDistanceMatrix<
+    T, M, N,
+    typename std::enable_if<(std::is_same<T, uint32_t>::value ||
+                             std::is_same<T, uint64_t>::value) &&
+                            M >= 2 && N >= 1>::type> {
+  //! Type of value
+  using ValueType = T;
+
+  //! Compute the distance between matrix and query
+  //! (matrix is column-interleaved: the i-th word of every row is adjacent)
+  static inline void Compute(const ValueType *m, const ValueType *q,
+                             size_t dim, float *out) {
+    ailego_assert(m && q && dim && out);
+
+    const size_t cnt = dim / (sizeof(ValueType) << 3);
+    for (size_t j = 0; j < N; ++j) {
+      for (size_t i = 0; i < M; ++i) {
+        out[j * M + i] = 0.0f;
+      }
+    }
+    for (size_t k = 0; k < cnt; ++k) {
+      const ValueType *m_row = m + k * M;
+      const ValueType *q_row = q + k * N;
+      for (size_t j = 0; j < N; ++j) {
+        float *r = out + j * M;
+        for (size_t i = 0; i < M; ++i) {
+          r[i] += static_cast<float>(
+              ailego_popcount64(static_cast<uint64_t>(m_row[i] ^ q_row[j])));
+        }
+      }
+    }
+  }
+};
+
+}  // namespace ailego
+}  // namespace zvec
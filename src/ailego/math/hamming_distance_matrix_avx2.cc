@@ -0,0 +1,77 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "distance_matrix_popcnt.i"
+#include "hamming_distance_matrix.h"
+
+namespace zvec {
+namespace ailego {
+
+#if defined(__AVX2__)
+uint64_t HammingDistanceScalar(const uint8_t *lhs, const uint8_t *rhs,
+                               size_t size);
+
+//! Compute the number of differing bits of two binary vectors (AVX2)
+uint64_t HammingDistanceAVX2(const uint8_t *lhs, const uint8_t *rhs,
+                             size_t size) {
+  const uint8_t *last = lhs + size;
+  const uint8_t *last_aligned = lhs + ((size >> 6) << 6);
+
+  // Per-byte counts come from the nibble lookup table and are folded into
+  // 64-bit lanes by sad right away, so the sums never overflow
+  __m256i ymm_sum_0 = _mm256_setzero_si256();
+  __m256i ymm_sum_1 = _mm256_setzero_si256();
+
+  for (; lhs != last_aligned; lhs += 64, rhs += 64) {
+    __m256i ymm_lhs_0 = _mm256_loadu_si256((const __m256i *)(lhs + 0));
+    __m256i ymm_lhs_1 = _mm256_loadu_si256((const __m256i *)(lhs + 32));
+    __m256i ymm_rhs_0 = _mm256_loadu_si256((const __m256i *)(rhs + 0));
+    __m256i ymm_rhs_1 = _mm256_loadu_si256((const __m256i *)(rhs + 32));
+
+    ymm_sum_0 = _mm256_add_epi64(
+        ymm_sum_0,
+        _mm256_sad_epu8(
+            VerticalPopCount_INT8_V256(_mm256_xor_si256(ymm_lhs_0, ymm_rhs_0)),
+            POPCNT_ZERO_AVX));
+    ymm_sum_1 = _mm256_add_epi64(
+        ymm_sum_1,
+        _mm256_sad_epu8(
+            VerticalPopCount_INT8_V256(_mm256_xor_si256(ymm_lhs_1, ymm_rhs_1)),
+            POPCNT_ZERO_AVX));
+  }
+  if (last >= lhs + 32) {
+    __m256i ymm_lhs = _mm256_loadu_si256((const __m256i *)lhs);
+    __m256i ymm_rhs = _mm256_loadu_si256((const __m256i *)rhs);
+    ymm_sum_0 = _mm256_add_epi64(
+        ymm_sum_0,
+        _mm256_sad_epu8(
+            VerticalPopCount_INT8_V256(_mm256_xor_si256(ymm_lhs, ymm_rhs)),
+            POPCNT_ZERO_AVX));
+    lhs += 32;
+    rhs += 32;
+  }
+  ymm_sum_0 = _mm256_add_epi64(ymm_sum_0, ymm_sum_1);
+  __m128i xmm_sum = _mm_add_epi64(_mm256_castsi256_si128(ymm_sum_0),
+                                  _mm256_extracti128_si256(ymm_sum_0, 1));
+  uint64_t count = static_cast<uint64_t>(HorizontalAdd_INT64_V128(xmm_sum));
+
+  if (lhs != last) {
+    count += HammingDistanceScalar(lhs, rhs, last - lhs);
+  }
+  return count;
+}
+#endif  // __AVX2__
+
+}  // namespace ailego
+}  // namespace zvec
@@ -0,0 +1,65 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "distance_matrix_popcnt.i"
+#include "hamming_distance_matrix.h"
+
+namespace zvec {
+namespace ailego {
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+uint64_t HammingDistanceScalar(const uint8_t *lhs, const uint8_t *rhs,
+                               size_t size);
+
+//! Compute the number of differing bits of two binary vectors
+//! (AVX512 VPOPCNTDQ)
+uint64_t HammingDistanceAVX512VPOPCNTDQ(const uint8_t *lhs,
+                                        const uint8_t *rhs, size_t size) {
+  const uint8_t *last = lhs + size;
+  const uint8_t *last_aligned = lhs + ((size >> 7) << 7);
+
+  __m512i zmm_sum_0 = _mm512_setzero_si512();
+  __m512i zmm_sum_1 = _mm512_setzero_si512();
+
+  for (; lhs != last_aligned; lhs += 128, rhs += 128) {
+    __m512i zmm_lhs_0 = _mm512_loadu_si512((const __m512i *)(lhs + 0));
+    __m512i zmm_lhs_1 = _mm512_loadu_si512((const __m512i *)(lhs + 64));
+    __m512i zmm_rhs_0 = _mm512_loadu_si512((const __m512i *)(rhs + 0));
+    __m512i zmm_rhs_1 = _mm512_loadu_si512((const __m512i *)(rhs + 64));
+
+    zmm_sum_0 = _mm512_add_epi64(
+        zmm_sum_0, _mm512_popcnt_epi64(_mm512_xor_si512(zmm_lhs_0, zmm_rhs_0)));
+    zmm_sum_1 = _mm512_add_epi64(
+        zmm_sum_1, _mm512_popcnt_epi64(_mm512_xor_si512(zmm_lhs_1, zmm_rhs_1)));
+  }
+  if (last >= lhs + 64) {
+    __m512i zmm_lhs = _mm512_loadu_si512((const __m512i *)lhs);
+    __m512i zmm_rhs = _mm512_loadu_si512((const __m512i *)rhs);
+    zmm_sum_0 = _mm512_add_epi64(
+        zmm_sum_0, _mm512_popcnt_epi64(_mm512_xor_si512(zmm_lhs, zmm_rhs)));
+    lhs += 64;
+    rhs += 64;
+  }
+  uint64_t count = static_cast<uint64_t>(
+      _mm512_reduce_add_epi64(_mm512_add_epi64(zmm_sum_0, zmm_sum_1)));
+
+  if (lhs != last) {
+    count += HammingDistanceScalar(lhs, rhs, last - lhs);
+  }
+  return count;
+}
+#endif  // __AVX512F__ && __AVX512VPOPCNTDQ__
+
+}  // namespace ailego
+}  // namespace zvec
@@ -0,0 +1,83 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ailego/internal/cpu_features.h>
+#include "hamming_distance_matrix.h"
+
+namespace zvec {
+namespace ailego {
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+uint64_t HammingDistanceAVX512VPOPCNTDQ(const uint8_t *lhs,
+                                        const uint8_t *rhs, size_t size);
+#endif
+
+#if defined(__AVX2__)
+uint64_t HammingDistanceAVX2(const uint8_t *lhs, const uint8_t *rhs,
+                             size_t size);
+#endif
+
+#if defined(__POPCNT__)
+uint64_t HammingDistancePopcnt(const uint8_t *lhs, const uint8_t *rhs,
+                               size_t size);
+#endif
+
+uint64_t HammingDistanceScalar(const uint8_t *lhs, const uint8_t *rhs,
+                               size_t size);
+
+//! Compute the number of differing bits of two binary vectors (bytes)
+static inline uint64_t HammingDistance(const uint8_t *lhs, const uint8_t *rhs,
+                                       size_t size) {
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX512_VPOPCNTDQ) {
+    return HammingDistanceAVX512VPOPCNTDQ(lhs, rhs, size);
+  }
+#endif  // __AVX512F__ && __AVX512VPOPCNTDQ__
+
+#if defined(__AVX2__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX2) {
+    return HammingDistanceAVX2(lhs, rhs, size);
+  }
+#endif  // __AVX2__
+
+#if defined(__POPCNT__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.POPCNT) {
+    return HammingDistancePopcnt(lhs, rhs, size);
+  }
+#endif  // __POPCNT__
+  return HammingDistanceScalar(lhs, rhs, size);
+}
+
+//! Compute the distance between matrix and query (BINARY32, M=1, N=1)
+void HammingDistanceMatrix<uint32_t, 1, 1>::Compute(const ValueType *m,
+                                                    const ValueType *q,
+                                                    size_t dim, float *out) {
+  *out = static_cast<float>(
+      HammingDistance(reinterpret_cast<const uint8_t *>(m),
+                      reinterpret_cast<const uint8_t *>(q),
+                      (dim >> 5) * sizeof(ValueType)));
+}
+
+//! Compute the distance between matrix and query (BINARY64, M=1, N=1)
+void HammingDistanceMatrix<uint64_t, 1, 1>::Compute(const ValueType *m,
+                                                    const ValueType *q,
+                                                    size_t dim, float *out) {
+  *out = static_cast<float>(
+      HammingDistance(reinterpret_cast<const uint8_t *>(m),
+                      reinterpret_cast<const uint8_t *>(q),
+                      (dim >> 6) * sizeof(ValueType)));
+}
+
+}  // namespace ailego
+}  // namespace zvec
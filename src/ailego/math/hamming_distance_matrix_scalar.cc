@@ -0,0 +1,49 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include "hamming_distance_matrix.h"
+
+namespace zvec {
+namespace ailego {
+
+//! Compute the number of differing bits of two binary vectors (bytes)
+uint64_t HammingDistanceScalar(const uint8_t *lhs, const uint8_t *rhs,
+                               size_t size) {
+  const uint8_t *last = lhs + size;
+  const uint8_t *last_aligned = lhs + ((size >> 3) << 3);
+  uint64_t count = 0;
+
+  for (; lhs != last_aligned; lhs += 8, rhs += 8) {
+    uint64_t l, r;
+    std::memcpy(&l, lhs, sizeof(l));
+    std::memcpy(&r, rhs, sizeof(r));
+    count += ailego_popcount64(l ^ r);
+  }
+  if (last >= lhs + 4) {
+    uint32_t l, r;
+    std::memcpy(&l, lhs, sizeof(l));
+    std::memcpy(&r, rhs, sizeof(r));
+    count += ailego_popcount32(l ^ r);
+    lhs += 4;
+    rhs += 4;
+  }
+  for (; lhs != last; ++lhs, ++rhs) {
+    count += ailego_popcount32(static_cast<uint32_t>(*lhs ^ *rhs));
+  }
+  return count;
+}
+
+}  // namespace ailego
+}  // namespace zvec
@@ -0,0 +1,53 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include "hamming_distance_matrix.h"
+
+namespace zvec {
+namespace ailego {
+
+#if defined(__POPCNT__)
+//! Compute the number of differing bits of two binary vectors (POPCNT)
+uint64_t HammingDistancePopcnt(const uint8_t *lhs, const uint8_t *rhs,
+                               size_t size) {
+  const uint8_t *last = lhs + size;
+  const uint8_t *last_aligned = lhs + ((size >> 5) << 5);
+  uint64_t count_0 = 0, count_1 = 0, count_2 = 0, count_3 = 0;
+
+  // Independent accumulators hide the 3-cycle latency of popcnt
+  for (; lhs != last_aligned; lhs += 32, rhs += 32) {
+    uint64_t l[4], r[4];
+    std::memcpy(l, lhs, sizeof(l));
+    std::memcpy(r, rhs, sizeof(r));
+    count_0 += _mm_popcnt_u64(l[0] ^ r[0]);
+    count_1 += _mm_popcnt_u64(l[1] ^ r[1]);
+    count_2 += _mm_popcnt_u64(l[2] ^ r[2]);
+    count_3 += _mm_popcnt_u64(l[3] ^ r[3]);
+  }
+  for (; last >= lhs + 8; lhs += 8, rhs += 8) {
+    uint64_t l, r;
+    std::memcpy(&l, lhs, sizeof(l));
+    std::memcpy(&r, rhs, sizeof(r));
+    count_0 += _mm_popcnt_u64(l ^ r);
+  }
+  for (; lhs != last; ++lhs, ++rhs) {
+    count_1 += _mm_popcnt_u32(static_cast<uint32_t>(*lhs ^ *rhs));
+  }
+  return (count_0 + count_1) + (count_2 + count_3);
+}
+#endif  // __POPCNT__
+
+}  // namespace ailego
+}  // namespace zvec
@@ -776,6 +776,9 @@ struct SparseSegmentInfo {
 constexpr static uint32_t SEGMENT_ID_BITS = 16;
 constexpr static uint32_t SEGMENT_ID_MASK = 0xFFFF;
 
+//! Set in the count of a sparse query which carries scattered dense tables
+constexpr static uint32_t SPARSE_QUERY_SCATTERED_FLAG = 0x80000000;
+
 template <typename T>
 struct MinusInnerProductSparseMatrix {
   //! Type of value
@@ -810,6 +813,16 @@ struct MinusInnerProductSparseMatrix<Float16> {
   static void Compute(const void *m_sparse_data_in,
                       const void *q_sparse_data_in, float *out);
 
+  //! Compute the distance between matrix and a query, which may be
+  //! scattered by transform_sparse_query
+  static void ComputeQuery(const void *m_sparse_data_in,
+                           const void *q_sparse_data_in, float *out);
+
+  //! Scatter the query segments into dense tables once per search, so
+  //! scoring a candidate is a gather over its own indices
+  static void transform_sparse_query(const void *q_sparse_data_in,
+                                     std::string &buffer);
+
   static void transform_sparse_format(uint32_t sparse_count,
                                       const uint32_t *sparse_index,
                                       const void *sparse_value,
@@ -907,6 +920,16 @@ struct MinusInnerProductSparseMatrix<float> {
   static void Compute(const void *m_sparse_data_in,
                       const void *q_sparse_data_in, float *out);
 
+  //! Compute the distance between matrix and a query, which may be
+  //! scattered by transform_sparse_query
+  static void ComputeQuery(const void *m_sparse_data_in,
+                           const void *q_sparse_data_in, float *out);
+
+  //! Scatter the query segments into dense tables once per search, so
+  //! scoring a candidate is a gather over its own indices
+  static void transform_sparse_query(const void *q_sparse_data_in,
+                                     std::string &buffer);
+
   static void transform_sparse_format(uint32_t sparse_count,
                                       const uint32_t *sparse_index,
                                       const void *sparse_value,
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include "distance_matrix_accum_fp16.i"
 #include "distance_matrix_inner_product_utility.i"
 #include "inner_product_matrix.h"
@@ -39,5 +40,35 @@ float MinusInnerProductFp16AVX512(const Float16 *lhs, const Float16 *rhs,
 }
 #endif  //__AVX512F__
 
+#if defined(__AVX512F__)
+//! Gather the scattered query table at the indices of a sparse segment
+float InnerProductSparseGatherFp16AVX512(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const Float16 *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size) {
+  const __m512i zmm_size = _mm512_set1_epi32(static_cast<int>(table_size));
+  __m512 zmm_sum = _mm512_setzero_ps();
+
+  uint32_t i = 0;
+  for (; i + 16 <= m_sparse_count; i += 16) {
+    __m512i zmm_index = _mm512_cvtepu16_epi32(_mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(m_sparse_index + i)));
+    zmm_index = _mm512_min_epu32(zmm_index, zmm_size);
+    __m512 zmm_q = _mm512_i32gather_ps(zmm_index, table, sizeof(float));
+    __m512 zmm_m = _mm512_cvtph_ps(_mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(m_sparse_value + i)));
+    zmm_sum = _mm512_fmadd_ps(zmm_m, zmm_q, zmm_sum);
+  }
+
+  float sum = HorizontalAdd_FP32_V512(zmm_sum);
+  for (; i < m_sparse_count; ++i) {
+    uint32_t index = std::min<uint32_t>(m_sparse_index[i], table_size);
+    sum += static_cast<float>(m_sparse_value[i]) * table[index];
+  }
+  return sum;
+}
+#endif  // __AVX512F__
+
 }  // namespace ailego
 }  // namespace zvec
@@ -175,5 +175,65 @@ float ComputeInnerProductSparseInSegmentFp16(uint32_t m_sparse_count,
                                                q_sparse_index, q_sparse_value);
 }
 
+#if defined(__AVX512F__)
+float InnerProductSparseGatherFp16AVX512(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const Float16 *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size);
+#endif
+
+#if defined(__AVX2__)
+float InnerProductSparseGatherFp16AVX2(uint32_t m_sparse_count,
+                                       const uint16_t *m_sparse_index,
+                                       const Float16 *m_sparse_value,
+                                       const float *table, uint32_t table_size);
+#endif
+
+float InnerProductSparseGatherFp16Scalar(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const Float16 *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size);
+
+float MinusInnerProductSparseQueryFp16Scalar(const void *m_sparse_data_in,
+                                             const void *q_sparse_data_in);
+
+void TransformSparseQueryFp16(const void *q_sparse_data_in,
+                              std::string &buffer);
+
+void MinusInnerProductSparseMatrix<Float16>::ComputeQuery(
+    const void *m_sparse_data_in, const void *q_sparse_data_in, float *out) {
+  *out = MinusInnerProductSparseQueryFp16Scalar(m_sparse_data_in,
+                                                q_sparse_data_in);
+}
+
+void MinusInnerProductSparseMatrix<Float16>::transform_sparse_query(
+    const void *q_sparse_data_in, std::string &buffer) {
+  TransformSparseQueryFp16(q_sparse_data_in, buffer);
+}
+
+float InnerProductSparseGatherFp16(uint32_t m_sparse_count,
+                                   const uint16_t *m_sparse_index,
+                                   const Float16 *m_sparse_value,
+                                   const float *table, uint32_t table_size) {
+#if defined(__AVX512F__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX512F) {
+    return InnerProductSparseGatherFp16AVX512(m_sparse_count, m_sparse_index,
+                                              m_sparse_value, table,
+                                              table_size);
+  }
+#endif
+#if defined(__AVX2__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX2 &&
+      zvec::ailego::internal::CpuFeatures::static_flags_.F16C) {
+    return InnerProductSparseGatherFp16AVX2(m_sparse_count, m_sparse_index,
+                                            m_sparse_value, table, table_size);
+  }
+#endif
+  return InnerProductSparseGatherFp16Scalar(m_sparse_count, m_sparse_index,
+                                            m_sparse_value, table, table_size);
+}
+
 }  // namespace ailego
 }  // namespace zvec
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include "distance_matrix_accum_fp32.i"
 #include "distance_matrix_inner_product_utility.i"
 #include "inner_product_matrix.h"
@@ -110,5 +111,37 @@ float MinusInnerProductFp32AVX(const float *lhs, const float *rhs,
 
 #endif  // __AVX__
 
+//--------------------------------------------------
+// Sparse
+//--------------------------------------------------
+#if defined(__AVX2__)
+//! Gather the scattered query table at the indices of a sparse segment
+float InnerProductSparseGatherFp32AVX2(uint32_t m_sparse_count,
+                                       const uint16_t *m_sparse_index,
+                                       const float *m_sparse_value,
+                                       const float *table,
+                                       uint32_t table_size) {
+  const __m256i ymm_size = _mm256_set1_epi32(static_cast<int>(table_size));
+  __m256 ymm_sum = _mm256_setzero_ps();
+
+  uint32_t i = 0;
+  for (; i + 8 <= m_sparse_count; i += 8) {
+    __m256i ymm_index = _mm256_cvtepu16_epi32(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(m_sparse_index + i)));
+    ymm_index = _mm256_min_epu32(ymm_index, ymm_size);
+    __m256 ymm_q = _mm256_i32gather_ps(table, ymm_index, sizeof(float));
+    ymm_sum = _mm256_fmadd_ps(_mm256_loadu_ps(m_sparse_value + i), ymm_q,
+                              ymm_sum);
+  }
+
+  float sum = HorizontalAdd_FP32_V256(ymm_sum);
+  for (; i < m_sparse_count; ++i) {
+    uint32_t index = std::min<uint32_t>(m_sparse_index[i], table_size);
+    sum += m_sparse_value[i] * table[index];
+  }
+  return sum;
+}
+#endif  // __AVX2__
+
 }  // namespace ailego
 }  // namespace zvec
@@ -151,5 +151,64 @@ float ComputeInnerProductSparseInSegmentFp32(uint32_t m_sparse_count,
                                                m_sparse_value, q_sparse_count,
                                                q_sparse_index, q_sparse_value);
 }
+
+#if defined(__AVX512F__)
+float InnerProductSparseGatherFp32AVX512(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const float *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size);
+#endif
+
+#if defined(__AVX2__)
+float InnerProductSparseGatherFp32AVX2(uint32_t m_sparse_count,
+                                       const uint16_t *m_sparse_index,
+                                       const float *m_sparse_value,
+                                       const float *table, uint32_t table_size);
+#endif
+
+float InnerProductSparseGatherFp32Scalar(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const float *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size);
+
+float MinusInnerProductSparseQueryFp32Scalar(const void *m_sparse_data_in,
+                                             const void *q_sparse_data_in);
+
+void TransformSparseQueryFp32(const void *q_sparse_data_in,
+                              std::string &buffer);
+
+void MinusInnerProductSparseMatrix<float>::ComputeQuery(
+    const void *m_sparse_data_in, const void *q_sparse_data_in, float *out) {
+  *out = MinusInnerProductSparseQueryFp32Scalar(m_sparse_data_in,
+                                                q_sparse_data_in);
+}
+
+void MinusInnerProductSparseMatrix<float>::transform_sparse_query(
+    const void *q_sparse_data_in, std::string &buffer) {
+  TransformSparseQueryFp32(q_sparse_data_in, buffer);
+}
+
+float InnerProductSparseGatherFp32(uint32_t m_sparse_count,
+                                   const uint16_t *m_sparse_index,
+                                   const float *m_sparse_value,
+                                   const float *table, uint32_t table_size) {
+#if defined(__AVX512F__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX512F) {
+    return InnerProductSparseGatherFp32AVX512(m_sparse_count, m_sparse_index,
+                                              m_sparse_value, table,
+                                              table_size);
+  }
+#endif
+#if defined(__AVX2__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX2) {
+    return InnerProductSparseGatherFp32AVX2(m_sparse_count, m_sparse_index,
+                                            m_sparse_value, table, table_size);
+  }
+#endif
+  return InnerProductSparseGatherFp32Scalar(m_sparse_count, m_sparse_index,
+                                            m_sparse_value, table, table_size);
+}
 }  // namespace ailego
 }  // namespace zvec
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <ailego/utility/math_helper.h>
@@ -295,5 +297,338 @@ float InnerProductSparseInSegmentFp32Scalar(uint32_t m_sparse_count,
   return sum;
 }
 
+//--------------------------------------------------
+// Sparse Query
+//--------------------------------------------------
+//! Query segments shorter than this are intersected instead of scattered
+constexpr uint32_t SPARSE_SCATTER_MIN_COUNT = 8;
+
+//! Upper bound of the dense tables of a scattered query, in floats
+constexpr uint32_t SPARSE_SCATTER_MAX_SIZE = 2 * 65536;
+
+//! Galloping replaces the merge once a side is this many times longer
+constexpr uint32_t SPARSE_GALLOP_RATIO = 16;
+
+float InnerProductSparseGatherFp32(uint32_t m_sparse_count,
+                                   const uint16_t *m_sparse_index,
+                                   const float *m_sparse_value,
+                                   const float *table, uint32_t table_size);
+
+float InnerProductSparseGatherFp16(uint32_t m_sparse_count,
+                                   const uint16_t *m_sparse_index,
+                                   const Float16 *m_sparse_value,
+                                   const float *table, uint32_t table_size);
+
+float InnerProductSparseGatherFp32Scalar(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const float *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size) {
+  float sum = 0.0f;
+  for (uint32_t i = 0; i < m_sparse_count; ++i) {
+    uint32_t index = std::min<uint32_t>(m_sparse_index[i], table_size);
+    sum += m_sparse_value[i] * table[index];
+  }
+  return sum;
+}
+
+float InnerProductSparseGatherFp16Scalar(uint32_t m_sparse_count,
+                                         const uint16_t *m_sparse_index,
+                                         const Float16 *m_sparse_value,
+                                         const float *table,
+                                         uint32_t table_size) {
+  float sum = 0.0f;
+  for (uint32_t i = 0; i < m_sparse_count; ++i) {
+    uint32_t index = std::min<uint32_t>(m_sparse_index[i], table_size);
+    sum += static_cast<float>(m_sparse_value[i]) * table[index];
+  }
+  return sum;
+}
+
+template <typename T>
+float InnerProductSparseGather(uint32_t m_sparse_count,
+                               const uint16_t *m_sparse_index,
+                               const T *m_sparse_value, const float *table,
+                               uint32_t table_size);
+
+template <>
+float InnerProductSparseGather<float>(uint32_t m_sparse_count,
+                                      const uint16_t *m_sparse_index,
+                                      const float *m_sparse_value,
+                                      const float *table,
+                                      uint32_t table_size) {
+  return InnerProductSparseGatherFp32(m_sparse_count, m_sparse_index,
+                                      m_sparse_value, table, table_size);
+}
+
+template <>
+float InnerProductSparseGather<Float16>(uint32_t m_sparse_count,
+                                        const uint16_t *m_sparse_index,
+                                        const Float16 *m_sparse_value,
+                                        const float *table,
+                                        uint32_t table_size) {
+  return InnerProductSparseGatherFp16(m_sparse_count, m_sparse_index,
+                                      m_sparse_value, table, table_size);
+}
+
+//! Intersect a short segment with a much longer one by exponential search
+template <typename T>
+float InnerProductSparseGallop(uint32_t s_sparse_count,
+                               const uint16_t *s_sparse_index,
+                               const T *s_sparse_value,
+                               uint32_t l_sparse_count,
+                               const uint16_t *l_sparse_index,
+                               const T *l_sparse_value) {
+  float sum = 0.0f;
+
+  uint32_t lo = 0;
+  for (uint32_t i = 0; i < s_sparse_count && lo < l_sparse_count; ++i) {
+    uint16_t key = s_sparse_index[i];
+
+    uint32_t bound = 1;
+    while (lo + bound < l_sparse_count && l_sparse_index[lo + bound] < key) {
+      bound <<= 1;
+    }
+    const uint16_t *it = std::lower_bound(
+        l_sparse_index + lo + (bound >> 1),
+        l_sparse_index + std::min(lo + bound + 1, l_sparse_count), key);
+    lo = static_cast<uint32_t>(it - l_sparse_index);
+
+    if (lo < l_sparse_count && l_sparse_index[lo] == key) {
+      sum += static_cast<float>(s_sparse_value[i]) *
+             static_cast<float>(l_sparse_value[lo]);
+      ++lo;
+    }
+  }
+
+  return sum;
+}
+
+template <typename T>
+float IntersectSparseInSegment(uint32_t m_sparse_count,
+                               const uint16_t *m_sparse_index,
+                               const T *m_sparse_value, uint32_t q_sparse_count,
+                               const uint16_t *q_sparse_index,
+                               const T *q_sparse_value) {
+  if (m_sparse_count / SPARSE_GALLOP_RATIO > q_sparse_count) {
+    return InnerProductSparseGallop(q_sparse_count, q_sparse_index,
+                                    q_sparse_value, m_sparse_count,
+                                    m_sparse_index, m_sparse_value);
+  }
+  if (q_sparse_count / SPARSE_GALLOP_RATIO > m_sparse_count) {
+    return InnerProductSparseGallop(m_sparse_count, m_sparse_index,
+                                    m_sparse_value, q_sparse_count,
+                                    q_sparse_index, q_sparse_value);
+  }
+  return ComputeInnerProductSparseInSegment(m_sparse_count, m_sparse_index,
+                                            m_sparse_value, q_sparse_count,
+                                            q_sparse_index, q_sparse_value);
+}
+
+//! Offset of the segment tables behind a sparse buffer of the given shape
+template <typename T>
+inline size_t SparseQueryTableInfoOffset(uint32_t sparse_count,
+                                         uint32_t seg_count) {
+  size_t size = 2 * sizeof(uint32_t) + seg_count * 2 * sizeof(uint32_t) +
+                sparse_count * (sizeof(uint16_t) + sizeof(T));
+  return (size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+}
+
+//! Offset of the dense tables, relative to the begin of the buffer
+inline size_t SparseQueryTableOffset(size_t info_offset, uint32_t seg_count) {
+  size_t offset = info_offset + seg_count * 2 * sizeof(uint32_t);
+  return (offset + 63) & ~static_cast<size_t>(63);
+}
+
+// A scattered query keeps the plain sparse format as its prefix, with
+// SPARSE_QUERY_SCATTERED_FLAG set in the count, followed by
+// [table offset u32 * seg_count][table size u32 * seg_count][tables].
+// A table holds size + 1 floats, the last one is zero and catches every
+// index beyond the query's largest, an offset of -1U means no table.
+template <typename T>
+void TransformSparseQuery(const void *q_sparse_data_in, std::string &buffer) {
+  const uint8_t *q_sparse_data =
+      reinterpret_cast<const uint8_t *>(q_sparse_data_in);
+
+  const uint32_t q_sparse_count =
+      *reinterpret_cast<const uint32_t *>(q_sparse_data);
+  const uint32_t q_seg_count =
+      *reinterpret_cast<const uint32_t *>(q_sparse_data + sizeof(uint32_t));
+
+  const size_t info_offset =
+      SparseQueryTableInfoOffset<T>(q_sparse_count, q_seg_count);
+  if (q_sparse_count == 0) {
+    buffer.assign(reinterpret_cast<const char *>(q_sparse_data), info_offset);
+    return;
+  }
+
+  const uint32_t *q_seg_vec_cnt = reinterpret_cast<const uint32_t *>(
+      q_sparse_data + 2 * sizeof(uint32_t) + q_seg_count * sizeof(uint32_t));
+  const uint16_t *q_sparse_index =
+      reinterpret_cast<const uint16_t *>(q_sparse_data + 2 * sizeof(uint32_t) +
+                                         q_seg_count * 2 * sizeof(uint32_t));
+  const T *q_sparse_value =
+      reinterpret_cast<const T *>(q_sparse_index + q_sparse_count);
+
+  std::vector<uint32_t> table_offsets(q_seg_count, -1U);
+  std::vector<uint32_t> table_sizes(q_seg_count, 0);
+
+  uint32_t total_size = 0;
+  size_t q_count = 0;
+  for (uint32_t s = 0; s < q_seg_count; ++s) {
+    uint32_t vec_cnt = q_seg_vec_cnt[s];
+    if (vec_cnt >= SPARSE_SCATTER_MIN_COUNT) {
+      uint32_t table_size = q_sparse_index[q_count + vec_cnt - 1] + 1U;
+      if (total_size + table_size + 1 <= SPARSE_SCATTER_MAX_SIZE) {
+        table_offsets[s] = total_size;
+        table_sizes[s] = table_size;
+        total_size += table_size + 1;
+      }
+    }
+    q_count += vec_cnt;
+  }
+
+  const size_t table_offset = SparseQueryTableOffset(info_offset, q_seg_count);
+  buffer.assign(reinterpret_cast<const char *>(q_sparse_data), info_offset);
+  buffer.resize(table_offset + total_size * sizeof(float), '\0');
+
+  char *data = &buffer[0];
+  *reinterpret_cast<uint32_t *>(data) |= SPARSE_QUERY_SCATTERED_FLAG;
+  std::memcpy(data + info_offset, table_offsets.data(),
+              q_seg_count * sizeof(uint32_t));
+  std::memcpy(data + info_offset + q_seg_count * sizeof(uint32_t),
+              table_sizes.data(), q_seg_count * sizeof(uint32_t));
+
+  float *tables = reinterpret_cast<float *>(data + table_offset);
+  q_count = 0;
+  for (uint32_t s = 0; s < q_seg_count; ++s) {
+    if (table_offsets[s] != -1U) {
+      float *table = tables + table_offsets[s];
+      for (uint32_t i = 0; i < q_seg_vec_cnt[s]; ++i) {
+        table[q_sparse_index[q_count + i]] =
+            static_cast<float>(q_sparse_value[q_count + i]);
+      }
+    }
+    q_count += q_seg_vec_cnt[s];
+  }
+}
+
+template <typename T>
+float ComputeQuerySegments(const void *m_sparse_data_in,
+                           const void *q_sparse_data_in) {
+  ailego_assert(m_sparse_data_in && q_sparse_data_in);
+
+  const uint8_t *q_sparse_data =
+      reinterpret_cast<const uint8_t *>(q_sparse_data_in);
+
+  const uint32_t q_count_word =
+      *reinterpret_cast<const uint32_t *>(q_sparse_data);
+  if (!(q_count_word & SPARSE_QUERY_SCATTERED_FLAG)) {
+    return ComputeSegments<T>(m_sparse_data_in, q_sparse_data_in);
+  }
+
+  const uint8_t *m_sparse_data =
+      reinterpret_cast<const uint8_t *>(m_sparse_data_in);
+
+  const uint32_t m_sparse_count =
+      *reinterpret_cast<const uint32_t *>(m_sparse_data);
+  const uint32_t q_sparse_count = q_count_word & ~SPARSE_QUERY_SCATTERED_FLAG;
+
+  if (m_sparse_count == 0 || q_sparse_count == 0) {
+    return 0.0f;
+  }
+
+  const uint32_t m_seg_count =
+      *reinterpret_cast<const uint32_t *>(m_sparse_data + sizeof(uint32_t));
+  const uint32_t q_seg_count =
+      *reinterpret_cast<const uint32_t *>(q_sparse_data + sizeof(uint32_t));
+
+  const uint32_t *m_seg_id =
+      reinterpret_cast<const uint32_t *>(m_sparse_data + 2 * sizeof(uint32_t));
+  const uint32_t *q_seg_id =
+      reinterpret_cast<const uint32_t *>(q_sparse_data + 2 * sizeof(uint32_t));
+
+  const uint32_t *m_seg_vec_cnt = m_seg_id + m_seg_count;
+  const uint32_t *q_seg_vec_cnt = q_seg_id + q_seg_count;
+
+  const uint16_t *m_sparse_index =
+      reinterpret_cast<const uint16_t *>(m_seg_vec_cnt + m_seg_count);
+  const uint16_t *q_sparse_index =
+      reinterpret_cast<const uint16_t *>(q_seg_vec_cnt + q_seg_count);
+
+  const T *m_sparse_value =
+      reinterpret_cast<const T *>(m_sparse_index + m_sparse_count);
+  const T *q_sparse_value =
+      reinterpret_cast<const T *>(q_sparse_index + q_sparse_count);
+
+  const size_t info_offset =
+      SparseQueryTableInfoOffset<T>(q_sparse_count, q_seg_count);
+  const uint32_t *q_table_offset =
+      reinterpret_cast<const uint32_t *>(q_sparse_data + info_offset);
+  const uint32_t *q_table_size = q_table_offset + q_seg_count;
+  const float *q_tables = reinterpret_cast<const float *>(
+      q_sparse_data + SparseQueryTableOffset(info_offset, q_seg_count));
+
+  float sum{0.0f};
+
+  size_t m_s = 0;
+  size_t q_s = 0;
+
+  size_t m_count = 0;
+  size_t q_count = 0;
+
+  while (m_s < m_seg_count && q_s < q_seg_count) {
+    if (m_seg_id[m_s] == q_seg_id[q_s]) {
+      if (q_table_offset[q_s] != -1U) {
+        sum += InnerProductSparseGather(
+            m_seg_vec_cnt[m_s], m_sparse_index + m_count,
+            m_sparse_value + m_count, q_tables + q_table_offset[q_s],
+            q_table_size[q_s]);
+      } else {
+        sum += IntersectSparseInSegment(
+            m_seg_vec_cnt[m_s], m_sparse_index + m_count,
+            m_sparse_value + m_count, q_seg_vec_cnt[q_s],
+            q_sparse_index + q_count, q_sparse_value + q_count);
+      }
+
+      m_count += m_seg_vec_cnt[m_s];
+      q_count += q_seg_vec_cnt[q_s];
+
+      ++m_s;
+      ++q_s;
+    } else if (m_seg_id[m_s] < q_seg_id[q_s]) {
+      m_count += m_seg_vec_cnt[m_s];
+
+      ++m_s;
+    } else {
+      q_count += q_seg_vec_cnt[q_s];
+
+      ++q_s;
+    }
+  }
+
+  return -sum;
+}
+
+float MinusInnerProductSparseQueryFp16Scalar(const void *m_sparse_data_in,
+                                             const void *q_sparse_data_in) {
+  return ComputeQuerySegments<Float16>(m_sparse_data_in, q_sparse_data_in);
+}
+
+float MinusInnerProductSparseQueryFp32Scalar(const void *m_sparse_data_in,
+                                             const void *q_sparse_data_in) {
+  return ComputeQuerySegments<float>(m_sparse_data_in, q_sparse_data_in);
+}
+
+void TransformSparseQueryFp16(const void *q_sparse_data_in,
+                              std::string &buffer) {
+  TransformSparseQuery<Float16>(q_sparse_data_in, buffer);
+}
+
+void TransformSparseQueryFp32(const void *q_sparse_data_in,
+                              std::string &buffer) {
+  TransformSparseQuery<float>(q_sparse_data_in, buffer);
+}
+
 }  // namespace ailego
 }  // namespace zvec
@@ -2941,6 +2941,8 @@ const char *zvec_metric_type_to_string(zvec_metric_type_t metric_type) {
       return "COSINE";
     case ZVEC_METRIC_TYPE_MIPSL2:
       return "MIPSL2";
+    case ZVEC_METRIC_TYPE_HAMMING:
+      return "HAMMING";
     default:
       return "UNKNOWN_METRIC_TYPE";
   }
@@ -5541,6 +5543,43 @@ const char *zvec_query_params_fts_get_default_operator(
   return ptr->default_operator().c_str();
 }
 
+zvec_error_code_t zvec_query_params_fts_set_anytime(
+    zvec_fts_query_params_t *params, bool anytime) {
+  if (!params) {
+    SET_LAST_ERROR(ZVEC_ERROR_INVALID_ARGUMENT,
+                   "FTS query params pointer is null");
+    return ZVEC_ERROR_INVALID_ARGUMENT;
+  }
+  auto *ptr = reinterpret_cast<zvec::FtsQueryParams *>(params);
+  ptr->set_anytime(anytime);
+  return ZVEC_OK;
+}
+
+bool zvec_query_params_fts_get_anytime(const zvec_fts_query_params_t *params) {
+  if (!params) return false;
+  auto *ptr = reinterpret_cast<const zvec::FtsQueryParams *>(params);
+  return ptr->anytime();
+}
+
+zvec_error_code_t zvec_query_params_fts_set_anytime_budget_us(
+    zvec_fts_query_params_t *params, uint32_t budget_us) {
+  if (!params) {
+    SET_LAST_ERROR(ZVEC_ERROR_INVALID_ARGUMENT,
+                   "FTS query params pointer is null");
+    return ZVEC_ERROR_INVALID_ARGUMENT;
+  }
+  auto *ptr = reinterpret_cast<zvec::FtsQueryParams *>(params);
+  ptr->set_anytime_budget_us(budget_us);
+  return ZVEC_OK;
+}
+
+uint32_t zvec_query_params_fts_get_anytime_budget_us(
+    const zvec_fts_query_params_t *params) {
+  if (!params) return 0;
+  auto *ptr = reinterpret_cast<const zvec::FtsQueryParams *>(params);
+  return ptr->anytime_budget_us();
+}
+
 // =============================================================================
 // Query implementation - owns zvec::SearchQuery via raw pointer
 // (external C symbol naming kept for ABI compatibility)
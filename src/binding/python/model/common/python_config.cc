@@ -189,6 +189,15 @@ void ZVecPyConfig::Initialize(pybind11::module_ &m) {
       data.fts_brute_force_by_keys_ratio = static_cast<float>(v);
     }
 
+    // set fts_query_cache_mb
+    if (has_key(config_dict, "fts_query_cache_mb")) {
+      auto mb = get_if<int64_t>(config_dict, "fts_query_cache_mb").value();
+      if (mb < 0) {
+        throw py::value_error("fts_query_cache_mb must be non-negative");
+      }
+      data.fts_query_cache_bytes = static_cast<uint64_t>(mb) * 1024 * 1024;
+    }
+
     // jieba_dict_dir: optional override of the SDK-registered default.
     // Empty value is a no-op (Initialize preserves the SDK default).
     if (has_key(config_dict, "jieba_dict_dir")) {
@@ -36,6 +36,8 @@ static std::string index_type_to_string(const IndexType type) {
       return "HNSW_RABITQ";
     case IndexType::IVF_RABITQ:
       return "IVF_RABITQ";
+    case IndexType::INVERTED_SPARSE:
+      return "INVERTED_SPARSE";
     case IndexType::DISKANN:
       return "DISKANN";
     case IndexType::VAMANA:
@@ -55,6 +57,8 @@ static std::string metric_type_to_string(const MetricType type) {
       return "IP";
     case MetricType::L2:
       return "L2";
+    case MetricType::HAMMING:
+      return "HAMMING";
     default:
       return "UNDEFINED";
   }
@@ -293,6 +297,14 @@ Attributes:
                 - "stemmer_lang" (Snowball language/algorithm; default
                   "english"), for example {"stemmer_lang":"porter"} for ES
                   behaviour.
+        Index:
+            - "phrase_shingles" (array of two-word strings, e.g.
+              ["new york"]; default []). Each pair is also indexed as one
+              term, so exact phrases containing it skip most position
+              checks.
+            - "impact_ordered" (bool, default false). Sealed segments also
+              store postings ordered by BM25 impact, used by anytime
+              queries.
         Default is "".
 
 Examples:
@@ -345,6 +357,9 @@ Args:
             stemmer:
                 - "stemmer_lang" (Snowball language/algorithm; default
                   "english").
+        Index:
+            - "phrase_shingles" (array of two-word strings; default []).
+            - "impact_ordered" (bool; default false).
         Defaults to "".
 )pbdoc")
       .def_property_readonly("tokenizer_name", &FtsIndexParams::tokenizer_name,
@@ -1830,55 +1845,80 @@ Args:
 Query parameters for full-text search (FTS) index.
 
 Controls the default boolean operator used to combine adjacent bare terms
-in a query string.
+in a query string, and anytime ranking.
 
 Attributes:
     type (IndexType): Always ``IndexType.FTS``.
     default_operator (str): Default boolean operator for adjacent bare terms.
         Supported values (case-insensitive): "OR" (default), "AND".
+    anytime (bool): Rank OR-of-terms queries on fields indexed with
+        ``impact_ordered=True`` score-at-a-time, possibly stopping early with
+        an approximate top-k. Default is False.
+    anytime_budget_us (int): Per-segment time budget of anytime ranking in
+        microseconds; 0 means no limit. Default is 0.
 
 Examples:
     >>> params = FtsQueryParam(default_operator="AND")
     >>> print(params.default_operator)
     AND
+    >>> params = FtsQueryParam(anytime=True, anytime_budget_us=500)
 )pbdoc");
   fts_query_params
-      .def(py::init([](const std::string &default_operator) {
+      .def(py::init([](const std::string &default_operator, bool anytime,
+                       uint32_t anytime_budget_us) {
              auto params = std::make_shared<FtsQueryParams>();
              if (!default_operator.empty()) {
                params->set_default_operator(default_operator);
              }
+             params->set_anytime(anytime);
+             params->set_anytime_budget_us(anytime_budget_us);
              return params;
            }),
-           py::arg("default_operator") = "",
+           py::arg("default_operator") = "", py::arg("anytime") = false,
+           py::arg("anytime_budget_us") = 0,
            R"pbdoc(
 Constructs an FtsQueryParam instance.
 
 Args:
     default_operator (str, optional): Default boolean operator for adjacent
         bare terms. Supported: "OR", "AND". Defaults to "" (uses engine default).
+    anytime (bool, optional): Whether to use anytime ranking. Defaults to False.
+    anytime_budget_us (int, optional): Per-segment time budget of anytime
+        ranking in microseconds; 0 means no limit. Defaults to 0.
 )pbdoc")
       .def_property_readonly("default_operator",
                              &FtsQueryParams::default_operator,
                              "str: Default boolean operator for bare terms.")
+      .def_property_readonly("anytime", &FtsQueryParams::anytime,
+                             "bool: Whether to use anytime ranking.")
+      .def_property_readonly(
+          "anytime_budget_us", &FtsQueryParams::anytime_budget_us,
+          "int: Per-segment time budget of anytime ranking in microseconds.")
       .def("__repr__",
            [](const FtsQueryParams &self) -> std::string {
              return "{"
                     "\"type\":\"" +
                     index_type_to_string(self.type()) +
                     "\", \"default_operator\":\"" + self.default_operator() +
-                    "\"}";
+                    "\", \"anytime\":" + (self.anytime() ? "true" : "false") +
+                    ", \"anytime_budget_us\":" +
+                    std::to_string(self.anytime_budget_us()) + "}";
            })
       .def(py::pickle(
           [](const FtsQueryParams &self) {
-            return py::make_tuple(self.default_operator());
+            return py::make_tuple(self.default_operator(), self.anytime(),
+                                  self.anytime_budget_us());
           },
           [](py::tuple t) {
-            if (t.size() != 1) {
+            if (t.size() != 1 && t.size() != 3) {
               throw std::runtime_error("Invalid state for FtsQueryParams");
             }
             auto obj = std::make_shared<FtsQueryParams>();
             obj->set_default_operator(t[0].cast<std::string>());
+            if (t.size() >= 3) {
+              obj->set_anytime(t[1].cast<bool>());
+              obj->set_anytime_budget_us(t[2].cast<uint32_t>());
+            }
             return obj;
           }));
 }
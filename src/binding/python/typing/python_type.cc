@@ -103,6 +103,7 @@ Examples:
       .value("HNSW_RABITQ", IndexType::HNSW_RABITQ)
       .value("DISKANN", IndexType::DISKANN)
       .value("VAMANA", IndexType::VAMANA)
+      .value("INVERTED_SPARSE", IndexType::INVERTED_SPARSE)
       .value("INVERT", IndexType::INVERT)
       .value("FTS", IndexType::FTS);
 }
@@ -114,6 +115,7 @@ Enumeration of supported distance/similarity metrics.
 - COSINE: Cosine similarity.
 - IP: Inner product (dot product).
 - L2: Euclidean distance (L2 norm).
+- HAMMING: Hamming distance, for BINARY32/BINARY64 vectors.
 
 Examples:
     >>> from zvec.typing import MetricType
@@ -122,7 +124,8 @@ Examples:
 )pbdoc")
       .value("COSINE", MetricType::COSINE)
       .value("IP", MetricType::IP)
-      .value("L2", MetricType::L2);
+      .value("L2", MetricType::L2)
+      .value("HAMMING", MetricType::HAMMING);
 }
 
 void ZVecPyTyping::bind_quantize_types(py::module_ &m) {
@@ -24,13 +24,24 @@ namespace core {
 DiskAnnAlgorithm::DiskAnnAlgorithm(DiskAnnEntity &entity, uint32_t max_degree)
     : entity_(entity), max_degree_(max_degree), lock_pool_(kLockCnt) {}
 
-std::vector<diskann_id_t> DiskAnnAlgorithm::get_init_ids(DiskAnnContext *ctx) {
+std::vector<diskann_id_t> DiskAnnAlgorithm::get_init_ids(diskann_id_t id,
+                                                         DiskAnnContext *ctx) {
   const auto &entity = ctx->get_entity();
 
   std::vector<diskann_id_t> init_ids;
 
   init_ids.emplace_back(entity.medoid());
 
+  // Searching from the label medoid as well links the node into its label
+  // subgraph while the global medoid keeps the whole graph connected
+  diskann_label_t label = entity.get_label(id);
+  if (label != kInvalidLabel) {
+    diskann_id_t label_medoid = entity.get_label_medoid(label);
+    if (label_medoid != kInvalidId && label_medoid != entity.medoid()) {
+      init_ids.emplace_back(label_medoid);
+    }
+  }
+
   return init_ids;
 }
 
@@ -210,89 +221,16 @@ int DiskAnnAlgorithm::iterate_to_fixed_point(
   return 0;
 }
 
-int DiskAnnAlgorithm::occlude_list(diskann_id_t id, std::vector<Neighbor> &pool,
-                                   std::vector<diskann_id_t> &result,
-                                   DiskAnnContext *ctx) {
-  if (pool.size() == 0) return 0;
-
-  DistCalculator &dc = ctx->dist_calculator();
-
-  ailego_assert(std::is_sorted(pool.begin(), pool.end()));
-  ailego_assert(result.size() == 0);
-
-  if (pool.size() > max_candidate_size_) {
-    pool.resize(max_candidate_size_);
-  }
-
-  std::vector<float> &occlude_factor = ctx->occlude_factor();
-
-  occlude_factor.clear();
-  occlude_factor.insert(occlude_factor.end(), pool.size(), 0.0f);
-
-  float cur_alpha = 1;
-  while (cur_alpha <= alpha_ && result.size() < max_degree_) {
-    for (auto iter = pool.begin();
-         result.size() < max_degree_ && iter != pool.end(); ++iter) {
-      if (occlude_factor[iter - pool.begin()] > cur_alpha) {
-        continue;
-      }
-
-      occlude_factor[iter - pool.begin()] = std::numeric_limits<float>::max();
-
-      if (iter->id != id) {
-        result.push_back(iter->id);
-      }
-
-      for (auto iter2 = iter + 1; iter2 != pool.end(); iter2++) {
-        auto t = iter2 - pool.begin();
-        if (occlude_factor[t] > alpha_) {
-          continue;
-        }
-
-        float djk = dc.dist(iter2->id, iter->id);
-
-        occlude_factor[t] =
-            (djk == 0) ? std::numeric_limits<float>::max()
-                       : std::max(occlude_factor[t], iter2->distance / djk);
-      }
-    }
-    cur_alpha *= 1.2f;
-  }
-
-  return 0;
-}
-
 int DiskAnnAlgorithm::prune_neighbors(diskann_id_t id,
                                       std::vector<Neighbor> &pool,
                                       std::vector<diskann_id_t> &pruned_list,
                                       DiskAnnContext *ctx) {
-  if (pool.size() == 0) {
-    pruned_list.clear();
-    return 0;
-  }
-
-  std::sort(pool.begin(), pool.end());
-
-  pruned_list.clear();
-  pruned_list.reserve(max_degree_);
-
-  occlude_list(id, pool, pruned_list, ctx);
-
-  ailego_assert(pruned_list.size() <= max_degree_);
-
-  if (saturate_graph_ && alpha_ > 1) {
-    for (const auto &node : pool) {
-      if (pruned_list.size() >= max_degree_) {
-        break;
-      }
+  DistCalculator &dc = ctx->dist_calculator();
 
-      if ((std::find(pruned_list.begin(), pruned_list.end(), node.id) ==
-           pruned_list.end()) &&
-          node.id != id) {
-        pruned_list.push_back(node.id);
-      }
-    }
-  }
+  robust_prune(id, pool, pruned_list, ctx->occlude_factor(),
+               [&dc](diskann_id_t lhs, diskann_id_t rhs) {
+                 return dc.dist(lhs, rhs);
+               });
 
   return 0;
 }
@@ -300,7 +238,7 @@ int DiskAnnAlgorithm::prune_neighbors(diskann_id_t id,
 int DiskAnnAlgorithm::search_neighbor_and_prune(
     diskann_id_t id, std::vector<diskann_id_t> &pruned_list,
     DiskAnnContext *ctx) {
-  const std::vector<diskann_id_t> init_ids = get_init_ids(ctx);
+  const std::vector<diskann_id_t> init_ids = get_init_ids(id, ctx);
 
   int ret = iterate_to_fixed_point(init_ids, ctx);
   if (ret != 0) {
@@ -13,6 +13,8 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <mutex>
 #include <zvec/core/framework/index_framework.h>
 #include <zvec/core/framework/index_meta.h>
@@ -32,6 +34,13 @@ class DiskAnnAlgorithm {
   int add_node(diskann_id_t id, DiskAnnContext *ctx);
   int prune_node(diskann_id_t id, DiskAnnContext *ctx);
 
+  //! RobustPrune the pool of id with the given pairwise distance
+  template <typename DistFunc>
+  void robust_prune(diskann_id_t id, std::vector<Neighbor> &pool,
+                    std::vector<diskann_id_t> &pruned_list,
+                    std::vector<float> &occlude_factor,
+                    const DistFunc &dist) const;
+
  private:
   int search_neighbor_and_prune(diskann_id_t id,
                                 std::vector<diskann_id_t> &pruned_list,
@@ -43,10 +52,13 @@ class DiskAnnAlgorithm {
                       DiskAnnContext *ctx);
   int inter_insert(diskann_id_t id, std::vector<diskann_id_t> &pruned_list,
                    DiskAnnContext *ctx);
-  int occlude_list(diskann_id_t id, std::vector<Neighbor> &pool,
-                   std::vector<diskann_id_t> &result, DiskAnnContext *ctx);
+  template <typename DistFunc>
+  void occlude_list(diskann_id_t id, std::vector<Neighbor> &pool,
+                    std::vector<diskann_id_t> &result,
+                    std::vector<float> &occlude_factor,
+                    const DistFunc &dist) const;
 
-  std::vector<diskann_id_t> get_init_ids(DiskAnnContext *ctx);
+  std::vector<diskann_id_t> get_init_ids(diskann_id_t id, DiskAnnContext *ctx);
 
  private:
   static constexpr uint32_t kLockCnt{1U << 16};
@@ -68,5 +80,96 @@ class DiskAnnAlgorithm {
   bool saturate_graph_{true};
 };
 
+template <typename DistFunc>
+void DiskAnnAlgorithm::occlude_list(diskann_id_t id,
+                                    std::vector<Neighbor> &pool,
+                                    std::vector<diskann_id_t> &result,
+                                    std::vector<float> &occlude_factor,
+                                    const DistFunc &dist) const {
+  if (pool.size() == 0) return;
+
+  ailego_assert(std::is_sorted(pool.begin(), pool.end()));
+  ailego_assert(result.size() == 0);
+
+  if (pool.size() > max_candidate_size_) {
+    pool.resize(max_candidate_size_);
+  }
+
+  occlude_factor.clear();
+  occlude_factor.insert(occlude_factor.end(), pool.size(), 0.0f);
+
+  // Filtered pruning: a neighbor sharing the label of id is only occluded by
+  // a node of that label, keeping every label subgraph navigable
+  diskann_label_t label = entity_.get_label(id);
+
+  float cur_alpha = 1;
+  while (cur_alpha <= alpha_ && result.size() < max_degree_) {
+    for (auto iter = pool.begin();
+         result.size() < max_degree_ && iter != pool.end(); ++iter) {
+      if (occlude_factor[iter - pool.begin()] > cur_alpha) {
+        continue;
+      }
+
+      occlude_factor[iter - pool.begin()] = std::numeric_limits<float>::max();
+
+      if (iter->id != id) {
+        result.push_back(iter->id);
+      }
+
+      for (auto iter2 = iter + 1; iter2 != pool.end(); iter2++) {
+        auto t = iter2 - pool.begin();
+        if (occlude_factor[t] > alpha_) {
+          continue;
+        }
+        if (label != kInvalidLabel && entity_.get_label(iter2->id) == label &&
+            entity_.get_label(iter->id) != label) {
+          continue;
+        }
+
+        float djk = dist(iter2->id, iter->id);
+
+        occlude_factor[t] =
+            (djk == 0) ? std::numeric_limits<float>::max()
+                       : std::max(occlude_factor[t], iter2->distance / djk);
+      }
+    }
+    cur_alpha *= 1.2f;
+  }
+}
+
+template <typename DistFunc>
+void DiskAnnAlgorithm::robust_prune(diskann_id_t id,
+                                    std::vector<Neighbor> &pool,
+                                    std::vector<diskann_id_t> &pruned_list,
+                                    std::vector<float> &occlude_factor,
+                                    const DistFunc &dist) const {
+  pruned_list.clear();
+  if (pool.size() == 0) {
+    return;
+  }
+
+  std::sort(pool.begin(), pool.end());
+
+  pruned_list.reserve(max_degree_);
+
+  occlude_list(id, pool, pruned_list, occlude_factor, dist);
+
+  ailego_assert(pruned_list.size() <= max_degree_);
+
+  if (saturate_graph_ && alpha_ > 1) {
+    for (const auto &node : pool) {
+      if (pruned_list.size() >= max_degree_) {
+        break;
+      }
+
+      if ((std::find(pruned_list.begin(), pruned_list.end(), node.id) ==
+           pruned_list.end()) &&
+          node.id != id) {
+        pruned_list.push_back(node.id);
+      }
+    }
+  }
+}
+
 }  // namespace core
 }  // namespace zvec
\ No newline at end of file
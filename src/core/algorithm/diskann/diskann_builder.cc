@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "diskann_builder.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -82,6 +83,28 @@ int DiskAnnBuilder::init(const IndexMeta &meta, const ailego::Params &params) {
     memory_limit_set_ = true;
   }
 
+  if (params.has(PARAM_DISKANN_BUILDER_MEMORY_BUDGET)) {
+    params.get(PARAM_DISKANN_BUILDER_MEMORY_BUDGET, &memory_budget_);
+    const double memory_budget_bytes = get_memory_in_bytes(memory_budget_);
+    if (!std::isfinite(memory_budget_) || memory_budget_ <= 0 ||
+        !std::isfinite(memory_budget_bytes) ||
+        memory_budget_bytes >
+            static_cast<double>(std::numeric_limits<size_t>::max())) {
+      LOG_ERROR("Invalid memory budget: %lf", memory_budget_);
+      return IndexError_InvalidArgument;
+    }
+
+    memory_budget_set_ = true;
+  }
+
+  params.get(PARAM_DISKANN_BUILDER_SHARD_COUNT, &shard_count_);
+  params.get(PARAM_DISKANN_BUILDER_SHARD_REPLICA_COUNT,
+             &shard_replica_count_);
+  if (shard_replica_count_ == 0) {
+    LOG_ERROR("Invalid shard replica count: %u", shard_replica_count_);
+    return IndexError_InvalidArgument;
+  }
+
   if (params.has(PARAM_DISKANN_BUILDER_MAX_TRAIN_SAMPLE_COUNT)) {
     params.get(PARAM_DISKANN_BUILDER_MAX_TRAIN_SAMPLE_COUNT,
                &max_train_sample_count_);
@@ -166,9 +189,15 @@ int DiskAnnBuilder::cleanup(void) {
   max_pq_chunk_num_ = kDefaultPqChunkNum;
   pq_chunk_num_ = kDefaultPqChunkNum;
   build_thread_count_ = 0;
+  shard_count_ = 0;
+  shard_replica_count_ = kDefaultShardReplicaCount;
+  memory_budget_ = 0.0;
+  memory_budget_set_ = false;
   max_train_sample_count_ = PQTable::kMaxTrainSampleCount;
   train_sample_ratio_ = PQTable::kTrainSampleRatio;
   universal_label_.clear();
+  labels_.clear();
+  label_medoid_shard_sizes_.clear();
   codebook_prefix_.clear();
   index_path_prefix_ = "./diskann";
   errcode_ = 0;
@@ -177,7 +206,7 @@ int DiskAnnBuilder::cleanup(void) {
   return 0;
 }
 
-int DiskAnnBuilder::calculate_entry_point() {
+int DiskAnnBuilder::calculate_entry_point(DiskAnnBuilderEntity *entity) {
   size_t dimension = build_meta_.dimension();
 
   if (build_meta_.data_type() != IndexMeta::DataType::DT_FP32 &&
@@ -193,8 +222,8 @@ int DiskAnnBuilder::calculate_entry_point() {
     case IndexMeta::DataType::DT_FP32: {
       centroid_fp32.resize(dimension);
       NumericalVectorMean<float> accumulator(dimension);
-      for (size_t id = 0; id < entity_.doc_cnt(); id++) {
-        accumulator.plus(entity_.get_vector(id), dimension * sizeof(float));
+      for (size_t id = 0; id < entity->doc_cnt(); id++) {
+        accumulator.plus(entity->get_vector(id), dimension * sizeof(float));
       }
       accumulator.mean(centroid_fp32.data(), dimension * sizeof(float));
       break;
@@ -202,8 +231,8 @@ int DiskAnnBuilder::calculate_entry_point() {
     case IndexMeta::DataType::DT_FP16: {
       centroid_fp16.resize(dimension);
       NumericalVectorMean<ailego::Float16> accumulator(dimension);
-      for (size_t id = 0; id < entity_.doc_cnt(); id++) {
-        accumulator.plus(entity_.get_vector(id),
+      for (size_t id = 0; id < entity->doc_cnt(); id++) {
+        accumulator.plus(entity->get_vector(id),
                          dimension * sizeof(ailego::Float16));
       }
       accumulator.mean(centroid_fp16.data(),
@@ -220,9 +249,9 @@ int DiskAnnBuilder::calculate_entry_point() {
 
   switch (build_meta_.data_type()) {
     case IndexMeta::DataType::DT_FP32:
-      for (size_t id = 0; id < entity_.doc_cnt(); id++) {
+      for (size_t id = 0; id < entity->doc_cnt(); id++) {
         const float *data_ptr =
-            reinterpret_cast<const float *>(entity_.get_vector(id));
+            reinterpret_cast<const float *>(entity->get_vector(id));
 
         float dist = 0.0f;
         ailego::SquaredEuclideanDistanceMatrix<float, 1, 1>::Compute(
@@ -235,9 +264,9 @@ int DiskAnnBuilder::calculate_entry_point() {
       }
       break;
     case IndexMeta::DataType::DT_FP16:
-      for (size_t id = 0; id < entity_.doc_cnt(); id++) {
+      for (size_t id = 0; id < entity->doc_cnt(); id++) {
         const ailego::Float16 *data_ptr =
-            reinterpret_cast<const ailego::Float16 *>(entity_.get_vector(id));
+            reinterpret_cast<const ailego::Float16 *>(entity->get_vector(id));
 
         float dist = 0.0f;
         ailego::SquaredEuclideanDistanceMatrix<ailego::Float16, 1, 1>::Compute(
@@ -253,13 +282,84 @@ int DiskAnnBuilder::calculate_entry_point() {
       return IndexError_Unsupported;
   }
 
-  (*entity_.mutable_medoid()) = medoid_id;
+  (*entity->mutable_medoid()) = medoid_id;
 
   LOG_INFO("Medoid Calculation Done. ID: %zu", (size_t)medoid_id);
 
   return 0;
 }
 
+int DiskAnnBuilder::set_labels(
+    std::unordered_map<diskann_key_t, diskann_label_t> labels) {
+  if (state_ != BUILD_STATE_INITED && state_ != BUILD_STATE_TRAINED) {
+    LOG_ERROR("Init the builder before DiskAnnBuilder::set_labels");
+    return IndexError_NoReady;
+  }
+
+  labels_ = std::move(labels);
+
+  return 0;
+}
+
+template <typename T>
+diskann_id_t DiskAnnBuilder::find_medoid(
+    const DiskAnnBuilderEntity *entity,
+    const std::vector<diskann_id_t> &ids) const {
+  size_t dimension = build_meta_.dimension();
+
+  std::vector<T> centroid(dimension);
+  NumericalVectorMean<T> accumulator(dimension);
+  for (diskann_id_t id : ids) {
+    accumulator.plus(entity->get_vector(id), dimension * sizeof(T));
+  }
+  accumulator.mean(centroid.data(), dimension * sizeof(T));
+
+  diskann_id_t medoid_id = kInvalidId;
+  float min_dist = std::numeric_limits<float>::max();
+  for (diskann_id_t id : ids) {
+    float dist = 0.0f;
+    ailego::SquaredEuclideanDistanceMatrix<T, 1, 1>::Compute(
+        centroid.data(), reinterpret_cast<const T *>(entity->get_vector(id)),
+        dimension, &dist);
+    if (dist < min_dist) {
+      min_dist = dist;
+      medoid_id = id;
+    }
+  }
+
+  return medoid_id;
+}
+
+int DiskAnnBuilder::calculate_label_medoids(DiskAnnBuilderEntity *entity) {
+  std::map<diskann_label_t, std::vector<diskann_id_t>> members;
+  for (diskann_id_t id = 0; id < entity->doc_cnt(); ++id) {
+    diskann_label_t label = entity->get_label(id);
+    if (label != kInvalidLabel) {
+      members[label].push_back(id);
+    }
+  }
+
+  for (const auto &it : members) {
+    diskann_id_t medoid_id = kInvalidId;
+    switch (build_meta_.data_type()) {
+      case IndexMeta::DataType::DT_FP32:
+        medoid_id = find_medoid<float>(entity, it.second);
+        break;
+      case IndexMeta::DataType::DT_FP16:
+        medoid_id = find_medoid<ailego::Float16>(entity, it.second);
+        break;
+      default:
+        LOG_ERROR("Data type not supported");
+        return IndexError_Unsupported;
+    }
+    entity->set_label_medoid(it.first, medoid_id);
+  }
+
+  LOG_INFO("Label Medoid Calculation Done. Label Count: %zu", members.size());
+
+  return 0;
+}
+
 int DiskAnnBuilder::calculate_pq_chunk_num() {
   size_t doc_cnt = holder_->count();
   if (doc_cnt == 0) {
@@ -304,7 +404,9 @@ int DiskAnnBuilder::calculate_pq_chunk_num() {
   return 0;
 }
 
-int DiskAnnBuilder::build_internal(IndexThreads::Pointer threads) {
+int DiskAnnBuilder::build_internal(IndexThreads::Pointer threads,
+                                   DiskAnnBuilderEntity *entity,
+                                   DiskAnnAlgorithm *algo) {
   auto task_group = threads->make_group();
   if (!task_group) {
     LOG_ERROR("Failed to create task group");
@@ -313,13 +415,14 @@ int DiskAnnBuilder::build_internal(IndexThreads::Pointer threads) {
 
   std::atomic<uint64_t> finished{0};
   for (size_t i = 0; i < threads->count(); ++i) {
-    task_group->submit(ailego::Closure ::New(this, &DiskAnnBuilder::do_build, i,
+    task_group->submit(ailego::Closure ::New(this, &DiskAnnBuilder::do_build,
+                                             entity, algo, i,
                                              threads->count(), &finished));
   }
 
   {
     std::unique_lock<std::mutex> lk(mutex_);
-    while (finished.load() < entity_.doc_cnt()) {
+    while (finished.load() < entity->doc_cnt()) {
       cond_.wait_until(lk, std::chrono::system_clock::now() +
                                std::chrono::seconds(check_interval_secs_));
       if (error_.load(std::memory_order_acquire)) {
@@ -328,7 +431,7 @@ int DiskAnnBuilder::build_internal(IndexThreads::Pointer threads) {
       }
       LOG_INFO("Built cnt %zu, finished percent %.3f%%",
                (size_t)finished.load(),
-               finished.load() * 100.0f / entity_.doc_cnt());
+               finished.load() * 100.0f / entity->doc_cnt());
     }
   }
 
@@ -341,7 +444,9 @@ int DiskAnnBuilder::build_internal(IndexThreads::Pointer threads) {
   return 0;
 }
 
-int DiskAnnBuilder::prune_internal(IndexThreads::Pointer threads) {
+int DiskAnnBuilder::prune_internal(IndexThreads::Pointer threads,
+                                   DiskAnnBuilderEntity *entity,
+                                   DiskAnnAlgorithm *algo) {
   auto task_group = threads->make_group();
   if (!task_group) {
     LOG_ERROR("Failed to create task group");
@@ -350,13 +455,14 @@ int DiskAnnBuilder::prune_internal(IndexThreads::Pointer threads) {
 
   std::atomic<uint64_t> finished{0};
   for (size_t i = 0; i < threads->count(); ++i) {
-    task_group->submit(ailego::Closure ::New(this, &DiskAnnBuilder::do_prune, i,
+    task_group->submit(ailego::Closure ::New(this, &DiskAnnBuilder::do_prune,
+                                             entity, algo, i,
                                              threads->count(), &finished));
   }
 
   {
     std::unique_lock<std::mutex> lk(mutex_);
-    while (finished.load() < entity_.doc_cnt()) {
+    while (finished.load() < entity->doc_cnt()) {
       cond_.wait_until(lk, std::chrono::system_clock::now() +
                                std::chrono::seconds(check_interval_secs_));
       if (error_.load(std::memory_order_acquire)) {
@@ -365,7 +471,7 @@ int DiskAnnBuilder::prune_internal(IndexThreads::Pointer threads) {
       }
       LOG_INFO("Prune cnt %zu, finished percent %.3f%%",
                (size_t)finished.load(),
-               finished.load() * 100.0f / entity_.doc_cnt());
+               finished.load() * 100.0f / entity->doc_cnt());
     }
   }
 
@@ -421,7 +527,9 @@ int DiskAnnBuilder::generate_quantized_data(IndexThreads::Pointer threads) {
   return 0;
 }
 
-void DiskAnnBuilder::do_build(uint64_t idx, size_t step_size,
+void DiskAnnBuilder::do_build(DiskAnnBuilderEntity *entity,
+                              DiskAnnAlgorithm *algo, uint64_t idx,
+                              size_t step_size,
                               std::atomic<uint64_t> *finished) {
   AILEGO_DEFER([&]() {
     std::lock_guard<std::mutex> latch(mutex_);
@@ -430,7 +538,7 @@ void DiskAnnBuilder::do_build(uint64_t idx, size_t step_size,
 
   DiskAnnContext *ctx = new (std::nothrow) DiskAnnContext(
       build_meta_, metric_,
-      std::shared_ptr<DiskAnnEntity>(&entity_, [](DiskAnnEntity *) {}));
+      std::shared_ptr<DiskAnnEntity>(entity, [](DiskAnnEntity *) {}));
 
   if (ailego_unlikely(ctx == nullptr)) {
     if (!error_.exchange(true)) {
@@ -452,9 +560,9 @@ void DiskAnnBuilder::do_build(uint64_t idx, size_t step_size,
   }
   ctx->set_list_size(list_size_);
 
-  for (uint64_t id = idx; id < entity_.doc_cnt(); id += step_size) {
-    ctx->reset_query(entity_.get_vector(id));
-    ret = algo_->add_node(id, ctx);
+  for (uint64_t id = idx; id < entity->doc_cnt(); id += step_size) {
+    ctx->reset_query(entity->get_vector(id));
+    ret = algo->add_node(id, ctx);
     if (ailego_unlikely(ret != 0)) {
       if (!error_.exchange(true)) {
         LOG_ERROR("DiskAnn graph add node failed");
@@ -467,7 +575,9 @@ void DiskAnnBuilder::do_build(uint64_t idx, size_t step_size,
   }
 }
 
-void DiskAnnBuilder::do_prune(uint64_t idx, size_t step_size,
+void DiskAnnBuilder::do_prune(DiskAnnBuilderEntity *entity,
+                              DiskAnnAlgorithm *algo, uint64_t idx,
+                              size_t step_size,
                               std::atomic<uint64_t> *finished) {
   AILEGO_DEFER([&]() {
     std::lock_guard<std::mutex> latch(mutex_);
@@ -476,7 +586,7 @@ void DiskAnnBuilder::do_prune(uint64_t idx, size_t step_size,
 
   DiskAnnContext *ctx = new (std::nothrow) DiskAnnContext(
       build_meta_, metric_,
-      std::shared_ptr<DiskAnnEntity>(&entity_, [](DiskAnnEntity *) {}));
+      std::shared_ptr<DiskAnnEntity>(entity, [](DiskAnnEntity *) {}));
 
   if (ailego_unlikely(ctx == nullptr)) {
     if (!error_.exchange(true)) {
@@ -498,9 +608,9 @@ void DiskAnnBuilder::do_prune(uint64_t idx, size_t step_size,
   }
   ctx->set_list_size(list_size_);
 
-  for (uint64_t id = idx; id < entity_.doc_cnt(); id += step_size) {
-    ctx->reset_query(entity_.get_vector(id));
-    ret = algo_->prune_node(id, ctx);
+  for (uint64_t id = idx; id < entity->doc_cnt(); id += step_size) {
+    ctx->reset_query(entity->get_vector(id));
+    ret = algo->prune_node(id, ctx);
     if (ailego_unlikely(ret != 0)) {
       if (!error_.exchange(true)) {
         LOG_ERROR("DiskAnn graph add node failed");
@@ -593,45 +703,15 @@ int DiskAnnBuilder::do_norm(const void *data_ptr, std::string *norm_data) {
   return 0;
 }
 
-int DiskAnnBuilder::build(IndexThreads::Pointer threads,
-                          IndexHolder::Pointer holder) {
-  if (state_ != BUILD_STATE_TRAINED) {
-    LOG_ERROR("Train the builder before DiskAnnBuilder::build");
-    return IndexError_NoReady;
-  }
-  if (!holder) {
-    LOG_ERROR("Invalid holder for DiskAnnBuilder::build");
-    return IndexError_InvalidArgument;
-  }
-
-  LOG_INFO("Start DiskAnnBuilder::build");
-
-  auto start_time = ailego::Monotime::MilliSeconds();
-
-  holder_ = holder;
-
-  if (!threads) {
-    threads =
-        std::make_shared<SingleQueueIndexThreads>(build_thread_count_, false);
-    if (!threads) {
-      return IndexError_NoMemory;
-    }
-  }
-
-  auto iter = holder->create_iterator();
+int DiskAnnBuilder::build_in_memory(IndexThreads::Pointer threads) {
+  auto iter = holder_->create_iterator();
   if (!iter) {
     LOG_ERROR("Create iterator for holder failed");
     return IndexError_Runtime;
   }
 
-  if (ailego_unlikely(holder->count() == 0)) {
-    LOG_ERROR("Holder is empty");
-    return IndexError_Runtime;
-  }
-
-  int ret = entity_.reserve_space(holder->count());
+  int ret = entity_.reserve_space(holder_->count());
 
-  error_ = false;
   while (iter->is_valid()) {
     ret = entity_.add_vector(iter->key(), iter->data());
     if (ailego_unlikely(ret != 0)) {
@@ -644,19 +724,27 @@ int DiskAnnBuilder::build(IndexThreads::Pointer threads,
   LOG_INFO("Finished saving vector");
 
   LOG_INFO("Start to calculate entrypoint");
-  ret = calculate_entry_point();
+  ret = calculate_entry_point(&entity_);
   if (ailego_unlikely(ret != 0)) {
     return ret;
   }
 
+  if (!labels_.empty()) {
+    entity_.set_labels(labels_);
+    ret = calculate_label_medoids(&entity_);
+    if (ailego_unlikely(ret != 0)) {
+      return ret;
+    }
+  }
+
   LOG_INFO("Start to build vamana graph");
-  ret = build_internal(threads);
+  ret = build_internal(threads, &entity_, algo_.get());
   if (ret != 0) {
     return ret;
   }
 
   LOG_INFO("Start final cleanup..");
-  ret = prune_internal(threads);
+  ret = prune_internal(threads, &entity_, algo_.get());
   if (ret != 0) {
     return ret;
   }
@@ -667,6 +755,436 @@ int DiskAnnBuilder::build(IndexThreads::Pointer threads,
     return ret;
   }
 
+  return 0;
+}
+
+uint32_t DiskAnnBuilder::calculate_shard_count(size_t doc_cnt) const {
+  const double budget = get_memory_in_bytes(memory_budget_);
+  const double neighbor_size =
+      sizeof(uint32_t) + max_degree_ * DiskAnnEntity::kDefaultGraphSlackFactor *
+                             sizeof(diskann_id_t);
+  const double node_size = raw_meta_.element_size() + neighbor_size;
+  if (doc_cnt * node_size <= budget) {
+    return 1U;
+  }
+
+  // The merged graph, keys and PQ codes stay resident during sharded build
+  double available =
+      budget - doc_cnt * (sizeof(diskann_key_t) + neighbor_size +
+                          build_meta_.dimension() / 2.0);
+  if (available < budget / 4) {
+    LOG_WARN("Memory budget %lf GB is too small for the merged graph",
+             memory_budget_);
+    available = budget / 4;
+  }
+  double shard_count =
+      std::ceil(doc_cnt * shard_replica_count_ * node_size / available);
+  return static_cast<uint32_t>(
+      std::min<double>(shard_count, std::numeric_limits<uint32_t>::max()));
+}
+
+int DiskAnnBuilder::build_sharded(IndexThreads::Pointer threads,
+                                  uint32_t shard_count) {
+  std::string centroids;
+  std::string sample_mean;
+  int ret = train_shards(threads, shard_count, &centroids, &sample_mean);
+  if (ret != 0) {
+    return ret;
+  }
+  shard_count =
+      static_cast<uint32_t>(centroids.size() / build_meta_.element_size());
+
+  std::vector<std::vector<diskann_id_t>> shards;
+  ret = assign_shards(centroids, sample_mean, shard_count, &shards);
+  if (ret != 0) {
+    return ret;
+  }
+  if (!labels_.empty()) {
+    entity_.set_labels(labels_);
+  }
+
+  // Merging prunes by the PQ codes, as shard vectors are not all resident
+  LOG_INFO("Start to generate quantized data");
+  ret = generate_quantized_data(threads);
+  if (ailego_unlikely(ret != 0)) {
+    return ret;
+  }
+
+  for (size_t i = 0; i < shards.size(); ++i) {
+    LOG_INFO("Start to build shard %zu/%zu, vector count %zu", i + 1,
+             shards.size(), shards[i].size());
+    ret = build_shard(threads, shards[i]);
+    if (ret != 0) {
+      return ret;
+    }
+    std::vector<diskann_id_t>().swap(shards[i]);
+  }
+
+  return 0;
+}
+
+int DiskAnnBuilder::train_shards(IndexThreads::Pointer threads,
+                                 uint32_t shard_count, std::string *centroids,
+                                 std::string *sample_mean) {
+  size_t element_size = build_meta_.element_size();
+  size_t dimension = build_meta_.dimension();
+  size_t doc_cnt = holder_->count();
+  size_t sample_step = std::max<size_t>(
+      1, doc_cnt / std::max<size_t>(max_train_sample_count_, shard_count));
+
+  auto features = std::make_shared<CompactIndexFeatures>(build_meta_);
+  auto iter = holder_->create_iterator();
+  if (!iter) {
+    LOG_ERROR("Create iterator for holder failed");
+    return IndexError_Runtime;
+  }
+  for (size_t i = 0; iter->is_valid(); iter->next(), ++i) {
+    if (i % sample_step == 0) {
+      features->emplace(iter->data());
+    }
+  }
+  if (features->count() < shard_count) {
+    LOG_ERROR("Too few samples %zu for %u shards", features->count(),
+              shard_count);
+    return IndexError_InvalidLength;
+  }
+
+  sample_mean->resize(element_size);
+  switch (build_meta_.data_type()) {
+    case IndexMeta::DataType::DT_FP32: {
+      NumericalVectorMean<float> accumulator(dimension);
+      for (size_t i = 0; i < features->count(); ++i) {
+        accumulator.plus(features->element(i), element_size);
+      }
+      accumulator.mean(&(*sample_mean)[0], element_size);
+      break;
+    }
+    case IndexMeta::DataType::DT_FP16: {
+      NumericalVectorMean<ailego::Float16> accumulator(dimension);
+      for (size_t i = 0; i < features->count(); ++i) {
+        accumulator.plus(features->element(i), element_size);
+      }
+      accumulator.mean(&(*sample_mean)[0], element_size);
+      break;
+    }
+    default:
+      LOG_ERROR("Data type not supported");
+      return IndexError_Unsupported;
+  }
+
+  auto cluster = IndexFactory::CreateCluster("OptKmeansCluster");
+  if (!cluster) {
+    LOG_ERROR("Failed to create OptKmeansCluster");
+    return IndexError_NoExist;
+  }
+  int ret = cluster->init(build_meta_, ailego::Params());
+  if (ret != 0) {
+    LOG_ERROR("Failed to initialize shard cluster, ret=%d", ret);
+    return ret;
+  }
+  ret = cluster->mount(features);
+  if (ret != 0) {
+    LOG_ERROR("Failed to mount shard samples, ret=%d", ret);
+    return ret;
+  }
+  cluster->suggest(shard_count);
+
+  IndexCluster::CentroidList shard_centroids;
+  ret = cluster->cluster(threads, shard_centroids);
+  if (ret != 0) {
+    LOG_ERROR("Failed to cluster shards, ret=%d", ret);
+    return ret;
+  }
+  if (shard_centroids.empty()) {
+    LOG_ERROR("No shard centroid trained");
+    return IndexError_Runtime;
+  }
+
+  centroids->clear();
+  for (const auto &centroid : shard_centroids) {
+    centroids->append(reinterpret_cast<const char *>(centroid.feature()),
+                      element_size);
+  }
+
+  LOG_INFO("Trained %zu shard centroids with %zu samples",
+           shard_centroids.size(), features->count());
+
+  return 0;
+}
+
+int DiskAnnBuilder::assign_shards(
+    const std::string &centroids, const std::string &sample_mean,
+    uint32_t shard_count, std::vector<std::vector<diskann_id_t>> *shards) {
+  size_t element_size = build_meta_.element_size();
+  size_t dimension = build_meta_.dimension();
+  uint32_t replica_count = std::min(shard_replica_count_, shard_count);
+  auto distance = metric_->distance();
+
+  shards->clear();
+  shards->resize(shard_count);
+  entity_.reserve_space(holder_->count(), false);
+
+  auto iter = holder_->create_iterator();
+  if (!iter) {
+    LOG_ERROR("Create iterator for holder failed");
+    return IndexError_Runtime;
+  }
+
+  std::vector<std::pair<float, uint32_t>> scores(shard_count);
+  diskann_id_t medoid_id = kInvalidId;
+  float min_dist = std::numeric_limits<float>::max();
+  diskann_id_t id = 0;
+  for (; iter->is_valid(); iter->next(), ++id) {
+    const void *vec = iter->data();
+    for (uint32_t i = 0; i < shard_count; ++i) {
+      float dist = 0.0f;
+      distance(vec, centroids.data() + i * element_size, dimension, &dist);
+      scores[i] = std::make_pair(dist, i);
+    }
+    std::partial_sort(scores.begin(), scores.begin() + replica_count,
+                      scores.end());
+    for (uint32_t i = 0; i < replica_count; ++i) {
+      (*shards)[scores[i].second].push_back(id);
+    }
+
+    float dist = 0.0f;
+    distance(vec, sample_mean.data(), dimension, &dist);
+    if (dist < min_dist) {
+      min_dist = dist;
+      medoid_id = id;
+    }
+
+    int ret = entity_.add_key(iter->key());
+    if (ailego_unlikely(ret != 0)) {
+      return ret;
+    }
+  }
+  if (id != holder_->count()) {
+    LOG_ERROR("Holder count mismatch, expect %zu, actual %zu",
+              holder_->count(), static_cast<size_t>(id));
+    return IndexError_Runtime;
+  }
+
+  (*entity_.mutable_medoid()) = medoid_id;
+  LOG_INFO("Assigned %zu vectors to %u shards, medoid: %zu",
+           static_cast<size_t>(id), shard_count, (size_t)medoid_id);
+
+  return 0;
+}
+
+int DiskAnnBuilder::build_shard(IndexThreads::Pointer threads,
+                                const std::vector<diskann_id_t> &members) {
+  // A lone vector is linked through the shards it is replicated in
+  if (members.size() < 2) {
+    return 0;
+  }
+
+  DiskAnnBuilderEntity shard;
+  int ret = shard.init(raw_meta_, max_degree_, list_size_, memory_limit_,
+                       build_thread_count_);
+  if (ret != 0) {
+    return ret;
+  }
+  shard.reserve_space(members.size());
+
+  // Only the vectors of this shard are loaded, keyed by their global id
+  auto iter = holder_->create_iterator();
+  if (!iter) {
+    LOG_ERROR("Create iterator for holder failed");
+    return IndexError_Runtime;
+  }
+  size_t next = 0;
+  for (diskann_id_t id = 0; iter->is_valid() && next < members.size();
+       iter->next(), ++id) {
+    if (members[next] != id) {
+      continue;
+    }
+    ret = shard.add_vector(id, iter->data());
+    if (ailego_unlikely(ret != 0)) {
+      return ret;
+    }
+    ++next;
+  }
+  if (next != members.size()) {
+    LOG_ERROR("Failed to load shard vectors, expect %zu, actual %zu",
+              members.size(), next);
+    return IndexError_Runtime;
+  }
+
+  ret = calculate_entry_point(&shard);
+  if (ret != 0) {
+    return ret;
+  }
+
+  // A label enters the index through the shard holding most of its vectors
+  if (entity_.has_labels()) {
+    std::vector<diskann_label_t> labels(members.size());
+    std::map<diskann_label_t, size_t> label_sizes;
+    for (size_t i = 0; i < members.size(); ++i) {
+      labels[i] = entity_.get_label(members[i]);
+      if (labels[i] != kInvalidLabel) {
+        label_sizes[labels[i]]++;
+      }
+    }
+    shard.set_labels(std::move(labels));
+    ret = calculate_label_medoids(&shard);
+    if (ret != 0) {
+      return ret;
+    }
+    for (const auto &it : shard.label_medoids()) {
+      size_t &best_size = label_medoid_shard_sizes_[it.first];
+      if (label_sizes[it.first] > best_size) {
+        best_size = label_sizes[it.first];
+        entity_.set_label_medoid(it.first, members[it.second]);
+      }
+    }
+  }
+
+  DiskAnnAlgorithm algo(shard, max_degree_);
+  ret = build_internal(threads, &shard, &algo);
+  if (ret != 0) {
+    return ret;
+  }
+  ret = prune_internal(threads, &shard, &algo);
+  if (ret != 0) {
+    return ret;
+  }
+
+  auto task_group = threads->make_group();
+  if (!task_group) {
+    LOG_ERROR("Failed to create task group");
+    return IndexError_Runtime;
+  }
+  for (size_t i = 0; i < threads->count(); ++i) {
+    task_group->submit(ailego::Closure::New(
+        this, &DiskAnnBuilder::do_merge,
+        static_cast<const DiskAnnBuilderEntity *>(&shard), i,
+        threads->count()));
+  }
+  task_group->wait_finish();
+
+  return 0;
+}
+
+void DiskAnnBuilder::do_merge(const DiskAnnBuilderEntity *shard,
+                              uint64_t idx, size_t step_size) {
+  bool fp16 = build_meta_.data_type() == IndexMeta::DataType::DT_FP16;
+  auto dist = [this, fp16](diskann_id_t lhs, diskann_id_t rhs) {
+    return fp16 ? pq_distance<ailego::Float16>(lhs, rhs)
+                : pq_distance<float>(lhs, rhs);
+  };
+
+  std::vector<diskann_id_t> merged;
+  std::vector<diskann_id_t> pruned;
+  std::vector<Neighbor> pool;
+  std::vector<float> occlude_factor;
+  for (uint64_t local = idx; local < shard->doc_cnt(); local += step_size) {
+    diskann_id_t id = static_cast<diskann_id_t>(shard->get_key(local));
+
+    // Union of the current list and the shard list, in global ids
+    auto current = entity_.get_neighbors(id);
+    merged.assign(current.second, current.second + current.first);
+    auto neighbors = shard->get_neighbors(local);
+    for (uint32_t i = 0; i < neighbors.first; ++i) {
+      diskann_id_t neighbor_id =
+          static_cast<diskann_id_t>(shard->get_key(neighbors.second[i]));
+      if (neighbor_id != id && std::find(merged.begin(), merged.end(),
+                                         neighbor_id) == merged.end()) {
+        merged.push_back(neighbor_id);
+      }
+    }
+    if (merged.size() <= max_degree_) {
+      entity_.set_neighbors(id, merged);
+      continue;
+    }
+
+    pool.clear();
+    for (diskann_id_t neighbor_id : merged) {
+      pool.emplace_back(neighbor_id, dist(id, neighbor_id));
+    }
+    algo_->robust_prune(id, pool, pruned, occlude_factor, dist);
+    entity_.set_neighbors(id, pruned);
+  }
+}
+
+template <typename T>
+float DiskAnnBuilder::pq_distance(diskann_id_t lhs, diskann_id_t rhs) {
+  const size_t dimension = build_meta_.dimension();
+  const auto &offsets = entity_.pq_chunk_offsets();
+  const T *pivots =
+      reinterpret_cast<const T *>(entity_.pq_full_pivot_data().data());
+  const uint8_t *lhs_codes =
+      entity_.block_compressed_data().data() + (size_t)lhs * pq_chunk_num_;
+  const uint8_t *rhs_codes =
+      entity_.block_compressed_data().data() + (size_t)rhs * pq_chunk_num_;
+
+  // The PQ centroid offset cancels out in the difference
+  float dist = 0.0f;
+  for (uint32_t c = 0; c < pq_chunk_num_; ++c) {
+    if (lhs_codes[c] == rhs_codes[c]) {
+      continue;
+    }
+    const T *lhs_pivot = pivots + lhs_codes[c] * dimension;
+    const T *rhs_pivot = pivots + rhs_codes[c] * dimension;
+    for (uint32_t d = offsets[c]; d < offsets[c + 1]; ++d) {
+      float diff =
+          static_cast<float>(lhs_pivot[d]) - static_cast<float>(rhs_pivot[d]);
+      dist += diff * diff;
+    }
+  }
+  return dist;
+}
+
+int DiskAnnBuilder::build(IndexThreads::Pointer threads,
+                          IndexHolder::Pointer holder) {
+  if (state_ != BUILD_STATE_TRAINED) {
+    LOG_ERROR("Train the builder before DiskAnnBuilder::build");
+    return IndexError_NoReady;
+  }
+  if (!holder) {
+    LOG_ERROR("Invalid holder for DiskAnnBuilder::build");
+    return IndexError_InvalidArgument;
+  }
+
+  LOG_INFO("Start DiskAnnBuilder::build");
+
+  auto start_time = ailego::Monotime::MilliSeconds();
+
+  holder_ = holder;
+
+  if (!threads) {
+    threads =
+        std::make_shared<SingleQueueIndexThreads>(build_thread_count_, false);
+    if (!threads) {
+      return IndexError_NoMemory;
+    }
+  }
+
+  if (ailego_unlikely(holder->count() == 0)) {
+    LOG_ERROR("Holder is empty");
+    return IndexError_Runtime;
+  }
+
+  uint32_t shard_count = shard_count_;
+  if (shard_count == 0 && memory_budget_set_) {
+    shard_count = calculate_shard_count(holder->count());
+  }
+  // Keep shards large enough to hold a meaningful graph
+  shard_count = static_cast<uint32_t>(std::min<size_t>(
+      shard_count, holder->count() / (2 * std::max(max_degree_, 1U))));
+
+  error_ = false;
+  int ret = 0;
+  if (shard_count > 1) {
+    LOG_INFO("Start to build vamana graph in %u shards", shard_count);
+    ret = build_sharded(threads, shard_count);
+  } else {
+    ret = build_in_memory(threads);
+  }
+  if (ret != 0) {
+    return ret;
+  }
+
   state_ = BUILD_STATE_BUILT;
 
   stats_.set_built_count(entity_.doc_cnt());
@@ -13,6 +13,8 @@
 // limitations under the License.
 #pragma once
 
+#include <map>
+#include <unordered_map>
 #include <zvec/ailego/parallel/thread_pool.h>
 #include <zvec/core/framework/index_builder.h>
 #include "diskann_algorithm.h"
@@ -54,23 +56,68 @@ class DiskAnnBuilder : public IndexBuilder {
 
   int do_norm(const void *data_ptr, std::string *norm_data);
 
+  //! Set the graph labels of the vectors, between init and build. Searches
+  //! restricted to a label start from its medoid and walk its subgraph.
+  int set_labels(std::unordered_map<diskann_key_t, diskann_label_t> labels);
+
  private:
   int train_quantized_data(IndexThreads::Pointer threads);
   int generate_quantized_data(IndexThreads::Pointer threads);
-  int build_internal(IndexThreads::Pointer threads);
-  int prune_internal(IndexThreads::Pointer threads);
+  int build_internal(IndexThreads::Pointer threads,
+                     DiskAnnBuilderEntity *entity, DiskAnnAlgorithm *algo);
+  int prune_internal(IndexThreads::Pointer threads,
+                     DiskAnnBuilderEntity *entity, DiskAnnAlgorithm *algo);
 
-  void do_build(uint64_t idx, size_t step_size,
+  void do_build(DiskAnnBuilderEntity *entity, DiskAnnAlgorithm *algo,
+                uint64_t idx, size_t step_size,
                 std::atomic<uint64_t> *finished);
 
-  void do_prune(uint64_t idx, size_t step_size,
+  void do_prune(DiskAnnBuilderEntity *entity, DiskAnnAlgorithm *algo,
+                uint64_t idx, size_t step_size,
                 std::atomic<uint64_t> *finished);
 
-  int calculate_entry_point();
+  int calculate_entry_point(DiskAnnBuilderEntity *entity);
+
+  //! Pick the medoid of every label of the entity
+  int calculate_label_medoids(DiskAnnBuilderEntity *entity);
+
+  //! Member of ids closest to their centroid
+  template <typename T>
+  diskann_id_t find_medoid(const DiskAnnBuilderEntity *entity,
+                           const std::vector<diskann_id_t> &ids) const;
 
   int calculate_pq_chunk_num();
 
-  double get_memory_in_bytes(double search_ram_budget) {
+  //! Build the whole graph with every vector resident
+  int build_in_memory(IndexThreads::Pointer threads);
+
+  //! Build the graph shard by shard, then merge the shard graphs
+  int build_sharded(IndexThreads::Pointer threads, uint32_t shard_count);
+
+  //! Cluster a sample into shard centroids
+  int train_shards(IndexThreads::Pointer threads, uint32_t shard_count,
+                   std::string *centroids, std::string *sample_mean);
+
+  //! Assign every vector to its nearest shards and pick the medoid
+  int assign_shards(const std::string &centroids,
+                    const std::string &sample_mean, uint32_t shard_count,
+                    std::vector<std::vector<diskann_id_t>> *shards);
+
+  //! Build the graph of one shard and merge it into the global graph
+  int build_shard(IndexThreads::Pointer threads,
+                  const std::vector<diskann_id_t> &members);
+
+  void do_merge(const DiskAnnBuilderEntity *shard, uint64_t idx,
+                size_t step_size);
+
+  //! Distance of two vectors reconstructed from their PQ codes
+  template <typename T>
+  float pq_distance(diskann_id_t lhs, diskann_id_t rhs);
+
+  //! Shards required to fit the build memory budget
+  uint32_t calculate_shard_count(size_t doc_cnt) const;
+
+  double get_memory_in_bytes(double search_ram_budget) const {
     return search_ram_budget * 1024 * 1024 * 1024;
   }
 
@@ -86,6 +133,7 @@ class DiskAnnBuilder : public IndexBuilder {
   constexpr static uint32_t kDefaultListSize = 50U;
   constexpr static uint32_t kDefaultMaxDegree = 100U;
   constexpr static uint32_t kDefaultPqChunkNum = -1U;
+  constexpr static uint32_t kDefaultShardReplicaCount = 2U;
 
   std::string data_file_;
 
@@ -96,9 +144,15 @@ class DiskAnnBuilder : public IndexBuilder {
   uint32_t max_pq_chunk_num_{kDefaultPqChunkNum};
   uint32_t pq_chunk_num_{kDefaultPqChunkNum};
   uint32_t build_thread_count_{0};
+  uint32_t shard_count_{0};
+  uint32_t shard_replica_count_{kDefaultShardReplicaCount};
+  double memory_budget_{0.0};
+  bool memory_budget_set_{false};
   uint32_t max_train_sample_count_{PQTable::kMaxTrainSampleCount};
   double train_sample_ratio_{PQTable::kTrainSampleRatio};
   std::string universal_label_{""};
+  std::unordered_map<diskann_key_t, diskann_label_t> labels_{};
+  std::map<diskann_label_t, size_t> label_medoid_shard_sizes_{};
   std::string codebook_prefix_{""};
   std::string index_path_prefix_{"./diskann"};
 
@@ -34,6 +34,8 @@ void DiskAnnBuilderEntity::clear() {
   keys_buffer_.clear();
   neighbors_buffer_.clear();
   entrypoints_.clear();
+  labels_.clear();
+  label_medoids_.clear();
   meta_.clear();
   pq_full_pivot_data_.clear();
   pq_centroid_.clear();
@@ -63,8 +65,11 @@ int DiskAnnBuilderEntity::init(const IndexMeta &meta, uint32_t max_degree,
   return 0;
 }
 
-int DiskAnnBuilderEntity::reserve_space(uint32_t docs) {
-  vectors_buffer_.reserve(meta_.element_size() * docs);
+int DiskAnnBuilderEntity::reserve_space(uint32_t docs,
+                                        bool resident_vectors) {
+  if (resident_vectors) {
+    vectors_buffer_.reserve(meta_.element_size() * docs);
+  }
   keys_buffer_.reserve(sizeof(diskann_key_t) * docs);
   neighbors_buffer_.reserve(neighbor_size_ * docs);
 
@@ -90,6 +95,30 @@ int DiskAnnBuilderEntity::add_vector(diskann_key_t key, const void *vec) {
   return 0;
 }
 
+int DiskAnnBuilderEntity::add_key(diskann_key_t key) {
+  keys_buffer_.append(reinterpret_cast<const char *>(&key), sizeof(key));
+
+  uint32_t neighbor_cnt = 0;
+  neighbors_buffer_.append(reinterpret_cast<const char *>(&neighbor_cnt),
+                           sizeof(uint32_t));
+  neighbors_buffer_.append(sizeof(diskann_id_t) * max_build_degree_, '\0');
+
+  (*mutable_doc_cnt())++;
+
+  return 0;
+}
+
+void DiskAnnBuilderEntity::set_labels(
+    const std::unordered_map<diskann_key_t, diskann_label_t> &labels) {
+  labels_.assign(doc_cnt(), kInvalidLabel);
+  for (diskann_id_t id = 0; id < doc_cnt(); ++id) {
+    auto it = labels.find(get_key(id));
+    if (it != labels.end()) {
+      labels_[id] = it->second;
+    }
+  }
+}
+
 const void *DiskAnnBuilderEntity::get_vector(diskann_id_t id) const {
   size_t offset = (size_t)id * meta_.element_size();
   return vectors_buffer_.data() + offset;
@@ -170,30 +199,7 @@ int64_t DiskAnnBuilderEntity::dump_segment(const IndexDumper::Pointer &dumper,
                                            const std::string &segment_id,
                                            const void *data,
                                            size_t size) const {
-  size_t len = dumper->write(data, size);
-  if (len != size) {
-    LOG_ERROR("Dump segment %s data failed, expect: %lu, actual: %lu",
-              segment_id.c_str(), size, len);
-    return IndexError_WriteData;
-  }
-
-  size_t padding_size = AlignSize(size) - size;
-  if (padding_size > 0) {
-    std::string padding(padding_size, '\0');
-    if (dumper->write(padding.data(), padding_size) != padding_size) {
-      LOG_ERROR("Append padding failed, size %lu", padding_size);
-      return IndexError_WriteData;
-    }
-  }
-
-  uint32_t crc = ailego::Crc32c::Hash(data, size);
-  int ret = dumper->append(segment_id, size, padding_size, crc);
-  if (ret != 0) {
-    LOG_ERROR("Dump segment %s meta failed, ret=%d", segment_id.c_str(), ret);
-    return ret;
-  }
-
-  return 0;
+  return DumpSegment(dumper, segment_id, data, size);
 }
 
 int DiskAnnBuilderEntity::dump_pq_meta_segment(
@@ -400,6 +406,29 @@ int DiskAnnBuilderEntity::dump_entrypoint_segment(
   return 0;
 }
 
+int DiskAnnBuilderEntity::dump_label_segment(
+    const IndexDumper::Pointer &dumper) const {
+  //! Label count, (label, medoid) pairs, then the label of every node
+  std::vector<uint32_t> buffer;
+  buffer.reserve(2 + label_medoids_.size() * 2 + labels_.size());
+  buffer.push_back(static_cast<uint32_t>(label_medoids_.size()));
+  buffer.push_back(0U);
+  for (const auto &it : label_medoids_) {
+    buffer.push_back(it.first);
+    buffer.push_back(it.second);
+  }
+  buffer.insert(buffer.end(), labels_.begin(), labels_.end());
+
+  int64_t ret = dump_segment(dumper, kDiskAnnLabelSegmentId, buffer.data(),
+                             buffer.size() * sizeof(uint32_t));
+  if (ret != 0) {
+    LOG_ERROR("Dump label segment failed");
+    return ret;
+  }
+
+  return 0;
+}
+
 int DiskAnnBuilderEntity::dump(IndexHolder::Pointer holder, IndexMeta &meta,
                                const IndexDumper::Pointer &dumper) {
   uint64_t doc_cnt = holder->count();
@@ -659,6 +688,16 @@ int DiskAnnBuilderEntity::dump(IndexHolder::Pointer holder, IndexMeta &meta,
     return ret;
   }
 
+  // dump labels
+  if (has_labels()) {
+    ret = dump_label_segment(dumper);
+    if (ret != 0) {
+      LOG_ERROR("Dump label segment failed");
+
+      return ret;
+    }
+  }
+
   LOG_INFO("DiskAnn Index File Dumped");
 
   return 0;
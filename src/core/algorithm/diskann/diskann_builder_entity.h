@@ -13,6 +13,8 @@
 // limitations under the License.
 #pragma once
 
+#include <map>
+#include <unordered_map>
 #include <zvec/ailego/parallel/thread_pool.h>
 #include <zvec/core/framework/index_holder.h>
 #include "diskann_entity.h"
@@ -45,6 +47,15 @@ class DiskAnnBuilderEntity : public DiskAnnEntity {
   diskann_key_t get_key(diskann_id_t id) const override;
   const void *get_vector(diskann_id_t id) const override;
 
+  diskann_label_t get_label(diskann_id_t id) const override {
+    return labels_.empty() ? kInvalidLabel : labels_[id];
+  }
+
+  diskann_id_t get_label_medoid(diskann_label_t label) const override {
+    auto it = label_medoids_.find(label);
+    return it == label_medoids_.end() ? kInvalidId : it->second;
+  }
+
  public:
   int init(const IndexMeta &meta, uint32_t max_degree, uint32_t list_size,
            double memory_limit, uint32_t build_threads);
@@ -61,8 +72,36 @@ class DiskAnnBuilderEntity : public DiskAnnEntity {
   int dump_key_mapping_segment(const IndexDumper::Pointer &dumper) const;
   int dump_entrypoint_segment(const IndexDumper::Pointer &dumper) const;
   int dump_key_segment(const IndexDumper::Pointer &dumper) const;
+  int dump_label_segment(const IndexDumper::Pointer &dumper) const;
+
+  int reserve_space(uint32_t docs, bool resident_vectors = true);
+
+  //! Append a node whose vector is not resident (sharded build)
+  int add_key(diskann_key_t key);
+
+  //! Assign the label of every node, unlisted keys stay unlabeled
+  void set_labels(
+      const std::unordered_map<diskann_key_t, diskann_label_t> &labels);
 
-  int reserve_space(uint32_t docs);
+  //! Assign the label of every node by node id
+  void set_labels(std::vector<diskann_label_t> &&labels) {
+    labels_ = std::move(labels);
+  }
+
+  //! Set the entry point of the nodes labeled label
+  void set_label_medoid(diskann_label_t label, diskann_id_t medoid) {
+    label_medoids_[label] = medoid;
+  }
+
+  //! Test if the nodes are labeled
+  bool has_labels(void) const {
+    return !labels_.empty();
+  }
+
+  //! Retrieve the entry points of every label
+  const std::map<diskann_label_t, diskann_id_t> &label_medoids(void) const {
+    return label_medoids_;
+  }
 
   std::vector<uint8_t> &pq_full_pivot_data() {
     return pq_full_pivot_data_;
@@ -96,6 +135,8 @@ class DiskAnnBuilderEntity : public DiskAnnEntity {
   std::string keys_buffer_{};
   std::string neighbors_buffer_{};
   std::vector<diskann_id_t> entrypoints_{};
+  std::vector<diskann_label_t> labels_{};
+  std::map<diskann_label_t, diskann_id_t> label_medoids_{};
 
   IndexMeta meta_;
 
@@ -121,6 +121,7 @@ int DiskAnnContext::update(const ailego::Params &params) {
   uint32_t list_size = list_size_;
   params.get(PARAM_DISKANN_SEARCHER_LIST_SIZE, &list_size);
   list_size_ = list_size;
+  params.get(PARAM_DISKANN_SEARCHER_QUERY_LABEL, &query_label_);
   return 0;
 }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
 #include <zvec/core/framework/index_context.h>
 #include "utility/topk_result_builder.h"
 #include "diskann_dist_calculator.h"
@@ -31,8 +32,30 @@ struct SearchStats {
   uint64_t disk_page_reads = 0;
   uint64_t io_num = 0;
   uint64_t dist_num = 0;
-  uint64_t cache_hits = 0;
+  uint64_t cache_hits = 0;  // hits of the static neighbor cache
   uint64_t hop_num = 0;
+  uint64_t node_cache_hits = 0;  // hits of the adaptive node cache
+  uint64_t saved_ios = 0;        // reads served by the adaptive node cache
+  float io_wait_us = 0;          // time blocked waiting for completions
+  uint64_t max_inflight_ios = 0;
+  uint32_t beam_width = 0;  // beam width the last search settled on
+
+  //! Accumulate the stats of one search
+  void merge(const SearchStats &other) {
+    total_us += other.total_us;
+    io_us += other.io_us;
+    cpu_us += other.cpu_us;
+    disk_page_reads += other.disk_page_reads;
+    io_num += other.io_num;
+    dist_num += other.dist_num;
+    cache_hits += other.cache_hits;
+    hop_num += other.hop_num;
+    node_cache_hits += other.node_cache_hits;
+    saved_ios += other.saved_ios;
+    io_wait_us += other.io_wait_us;
+    max_inflight_ios = std::max(max_inflight_ios, other.max_inflight_ios);
+    beam_width = other.beam_width;
+  }
 };
 
 class DiskAnnContext : public IndexContext,
@@ -142,6 +165,11 @@ class DiskAnnContext : public IndexContext,
     list_size_ = list_size;
   }
 
+  //! Restrict the search to the nodes of a graph label
+  void set_query_label(diskann_label_t label) {
+    query_label_ = label;
+  }
+
   void set_fetch_vector(bool v) override {
     fetch_vector_ = v;
   }
@@ -155,6 +183,10 @@ class DiskAnnContext : public IndexContext,
     return list_size_;
   }
 
+  inline diskann_label_t query_label() const {
+    return query_label_;
+  }
+
   inline void reset_query(const void *query) {
     memcpy(query_, query, element_size_);
     memcpy(query_rotated_, query, element_size_);
@@ -237,6 +269,7 @@ class DiskAnnContext : public IndexContext,
     group_topk_ = rhs.group_topk_;
     group_topk_heaps_.clear();
     list_size_ = rhs.list_size_;
+    query_label_ = rhs.query_label_;
     fetch_vector_ = rhs.fetch_vector_;
     debug_mode_ = rhs.debug_mode_;
   }
@@ -245,6 +278,11 @@ class DiskAnnContext : public IndexContext,
     return query_stats_;
   }
 
+  //! Retrieve stats of the last search, query_stats() accumulates them
+  SearchStats &last_query_stats() {
+    return last_query_stats_;
+  }
+
   const DiskAnnEntity &get_entity() const {
     return *entity_;
   }
@@ -268,6 +306,7 @@ class DiskAnnContext : public IndexContext,
   //! Reset context
   void reset(void) override {
     set_filter(nullptr);
+    set_query_label(kInvalidLabel);
     reset_threshold();
     set_fetch_vector(false);
     set_group_params(0, 0);
@@ -361,6 +400,7 @@ class DiskAnnContext : public IndexContext,
   uint32_t element_size_{0};
   uint32_t element_rotated_size_{0};
   uint32_t list_size_{0};
+  diskann_label_t query_label_{kInvalidLabel};
 
   TopkHeap topk_heap_{};
 
@@ -370,6 +410,7 @@ class DiskAnnContext : public IndexContext,
 
   IOContext io_ctx_{0};
   SearchStats query_stats_;
+  SearchStats last_query_stats_;
 
   float *pq_table_dist_buffer_{nullptr};
   void *pq_coord_buffer_{nullptr};
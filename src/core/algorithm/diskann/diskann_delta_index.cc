@@ -0,0 +1,584 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "diskann_delta_index.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace zvec {
+namespace core {
+
+namespace {
+
+//! Header of the delta meta segment
+struct DeltaMetaHeader {
+  uint32_t slot_count;
+  uint32_t entry_point;
+  uint32_t neighbor_stride;
+  uint32_t element_size;
+};
+
+}  // namespace
+
+int DiskAnnDeltaIndex::init(const IndexMeta &meta,
+                            const IndexMetric::Pointer &measure,
+                            uint32_t max_degree, uint32_t list_size,
+                            float alpha) {
+  if (!measure || max_degree == 0 || list_size == 0 || alpha < 1.0f) {
+    LOG_ERROR("Invalid delta index arguments, degree=%u list_size=%u "
+              "alpha=%f",
+              max_degree, list_size, alpha);
+    return IndexError_InvalidArgument;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  distance_ = measure->distance();
+  dimension_ = meta.dimension();
+  element_size_ = meta.element_size();
+  max_degree_ = max_degree;
+  list_size_ = std::max(list_size, max_degree);
+  alpha_ = alpha;
+  vectors_.clear();
+  keys_.clear();
+  labels_.clear();
+  neighbors_.clear();
+  deleted_.clear();
+  key_map_.clear();
+  entry_point_ = kInvalidId;
+  deleted_count_ = 0;
+  return 0;
+}
+
+void DiskAnnDeltaIndex::clear(void) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  vectors_.clear();
+  vectors_.shrink_to_fit();
+  keys_.clear();
+  labels_.clear();
+  neighbors_.clear();
+  deleted_.clear();
+  key_map_.clear();
+  entry_point_ = kInvalidId;
+  deleted_count_ = 0;
+}
+
+int DiskAnnDeltaIndex::add(uint64_t key, const void *vec,
+                           diskann_label_t label) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (key_map_.find(key) != key_map_.end()) {
+    LOG_ERROR("Key %lu already exists in delta index", (unsigned long)key);
+    return IndexError_Duplicate;
+  }
+  if (keys_.size() >= static_cast<size_t>(kInvalidId)) {
+    LOG_ERROR("Delta index is full");
+    return IndexError_IndexFull;
+  }
+
+  uint32_t id = static_cast<uint32_t>(keys_.size());
+  vectors_.append(static_cast<const char *>(vec), element_size_);
+  keys_.push_back(key);
+  labels_.push_back(label);
+  neighbors_.emplace_back();
+  deleted_.push_back(0);
+  key_map_.emplace(key, id);
+
+  if (entry_point_ == kInvalidId) {
+    entry_point_ = id;
+    return 0;
+  }
+
+  NeighborPriorityQueue best;
+  std::vector<Neighbor> pool;
+  greedy_search(vector(id), list_size_, &best, &pool);
+  pool.erase(std::remove_if(pool.begin(), pool.end(),
+                            [id](const Neighbor &n) { return n.id == id; }),
+             pool.end());
+
+  std::vector<uint32_t> pruned;
+  robust_prune(id, pool, &pruned);
+  neighbors_[id] = pruned;
+  for (uint32_t nbr : pruned) {
+    inter_insert(nbr, id);
+  }
+  return 0;
+}
+
+int DiskAnnDeltaIndex::remove(uint64_t key) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto it = key_map_.find(key);
+  if (it == key_map_.end()) {
+    return IndexError_NoExist;
+  }
+  deleted_[it->second] = 1;
+  ++deleted_count_;
+  key_map_.erase(it);
+  return 0;
+}
+
+bool DiskAnnDeltaIndex::contains(uint64_t key) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return key_map_.find(key) != key_map_.end();
+}
+
+int DiskAnnDeltaIndex::get_vector(uint64_t key, std::string *vec) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = key_map_.find(key);
+  if (it == key_map_.end()) {
+    return IndexError_NoExist;
+  }
+  vec->assign(static_cast<const char *>(vector(it->second)), element_size_);
+  return 0;
+}
+
+int DiskAnnDeltaIndex::get_vector_by_id(uint32_t id, std::string *vec) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (id >= keys_.size() || deleted_[id]) {
+    return IndexError_NoExist;
+  }
+  vec->assign(static_cast<const char *>(vector(id)), element_size_);
+  return 0;
+}
+
+uint64_t DiskAnnDeltaIndex::get_slot(uint32_t id, std::string *vec,
+                                     diskann_label_t *label) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (id >= keys_.size() || deleted_[id]) {
+    return kInvalidKey;
+  }
+  vec->assign(static_cast<const char *>(vector(id)), element_size_);
+  if (label) {
+    *label = labels_[id];
+  }
+  return keys_[id];
+}
+
+int DiskAnnDeltaIndex::dump(const IndexDumper::Pointer &dumper) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  uint32_t slot_count = static_cast<uint32_t>(keys_.size());
+
+  //! Neighbor lists are stored as a count followed by a fixed stride of ids
+  uint32_t degree = 0;
+  for (const auto &nbrs : neighbors_) {
+    degree = std::max(degree, static_cast<uint32_t>(nbrs.size()));
+  }
+  DeltaMetaHeader header{slot_count, entry_point_, degree + 1, element_size_};
+  int ret = DiskAnnEntity::DumpSegment(
+      dumper, DiskAnnEntity::kDiskAnnDeltaMetaSegmentId, &header,
+      sizeof(header));
+  if (ret != 0 || slot_count == 0) {
+    return ret;
+  }
+
+  std::vector<uint32_t> neighbors(static_cast<size_t>(slot_count) *
+                                  header.neighbor_stride);
+  for (size_t i = 0; i < slot_count; ++i) {
+    uint32_t *dst = neighbors.data() + i * header.neighbor_stride;
+    dst[0] = static_cast<uint32_t>(neighbors_[i].size());
+    std::copy(neighbors_[i].begin(), neighbors_[i].end(), dst + 1);
+  }
+
+  ret = DiskAnnEntity::DumpSegment(
+      dumper, DiskAnnEntity::kDiskAnnDeltaKeySegmentId, keys_.data(),
+      keys_.size() * sizeof(uint64_t));
+  if (ret == 0) {
+    ret = DiskAnnEntity::DumpSegment(
+        dumper, DiskAnnEntity::kDiskAnnDeltaLabelSegmentId, labels_.data(),
+        labels_.size() * sizeof(diskann_label_t));
+  }
+  if (ret == 0) {
+    ret = DiskAnnEntity::DumpSegment(
+        dumper, DiskAnnEntity::kDiskAnnDeltaTombstoneSegmentId,
+        deleted_.data(), deleted_.size());
+  }
+  if (ret == 0) {
+    ret = DiskAnnEntity::DumpSegment(
+        dumper, DiskAnnEntity::kDiskAnnDeltaVectorSegmentId, vectors_.data(),
+        vectors_.size());
+  }
+  if (ret == 0) {
+    ret = DiskAnnEntity::DumpSegment(
+        dumper, DiskAnnEntity::kDiskAnnDeltaNeighborSegmentId,
+        neighbors.data(), neighbors.size() * sizeof(uint32_t));
+  }
+  if (ret != 0) {
+    LOG_ERROR("Dump delta index failed, ret=%d", ret);
+  }
+  return ret;
+}
+
+int DiskAnnDeltaIndex::load(const IndexStorage::Pointer &storage) {
+  auto meta_segment = storage->get(DiskAnnEntity::kDiskAnnDeltaMetaSegmentId);
+  if (!meta_segment) {
+    return 0;
+  }
+
+  const void *data = nullptr;
+  DeltaMetaHeader header;
+  if (meta_segment->data_size() != sizeof(header) ||
+      meta_segment->read(0, &data, sizeof(header)) != sizeof(header)) {
+    LOG_ERROR("Read segment %s failed",
+              DiskAnnEntity::kDiskAnnDeltaMetaSegmentId.c_str());
+    return IndexError_ReadData;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.element_size != element_size_ || header.neighbor_stride == 0 ||
+      header.slot_count >= kInvalidId ||
+      (header.slot_count != 0 && header.entry_point >= header.slot_count)) {
+    LOG_ERROR("Mismatched delta index, slots=%u element_size=%u",
+              header.slot_count, header.element_size);
+    return IndexError_Mismatch;
+  }
+
+  size_t slot_count = header.slot_count;
+  auto read_segment = [&](const std::string &segment_id, size_t len,
+                          void *out) {
+    auto segment = storage->get(segment_id);
+    if (!segment || segment->data_size() != len ||
+        segment->read(0, &data, len) != len) {
+      LOG_ERROR("Read segment %s failed", segment_id.c_str());
+      return false;
+    }
+    memcpy(out, data, len);
+    return true;
+  };
+
+  std::vector<uint64_t> keys(slot_count);
+  std::vector<diskann_label_t> labels(slot_count);
+  std::vector<uint8_t> deleted(slot_count);
+  std::string vectors(slot_count * element_size_, '\0');
+  std::vector<uint32_t> neighbors(slot_count * header.neighbor_stride);
+  if (slot_count != 0 &&
+      (!read_segment(DiskAnnEntity::kDiskAnnDeltaKeySegmentId,
+                     keys.size() * sizeof(uint64_t), keys.data()) ||
+       !read_segment(DiskAnnEntity::kDiskAnnDeltaLabelSegmentId,
+                     labels.size() * sizeof(diskann_label_t),
+                     labels.data()) ||
+       !read_segment(DiskAnnEntity::kDiskAnnDeltaTombstoneSegmentId,
+                     deleted.size(), deleted.data()) ||
+       !read_segment(DiskAnnEntity::kDiskAnnDeltaVectorSegmentId,
+                     vectors.size(), &vectors[0]) ||
+       !read_segment(DiskAnnEntity::kDiskAnnDeltaNeighborSegmentId,
+                     neighbors.size() * sizeof(uint32_t), neighbors.data()))) {
+    return IndexError_ReadData;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  vectors_.swap(vectors);
+  keys_.swap(keys);
+  labels_.swap(labels);
+  deleted_.swap(deleted);
+  neighbors_.assign(slot_count, std::vector<uint32_t>());
+  key_map_.clear();
+  deleted_count_ = 0;
+  for (uint32_t i = 0; i < slot_count; ++i) {
+    const uint32_t *src = neighbors.data() + i * header.neighbor_stride;
+    uint32_t degree = std::min(src[0], header.neighbor_stride - 1);
+    for (uint32_t j = 1; j <= degree; ++j) {
+      if (src[j] < slot_count) {
+        neighbors_[i].push_back(src[j]);
+      }
+    }
+    if (deleted_[i]) {
+      ++deleted_count_;
+    } else {
+      key_map_.emplace(keys_[i], i);
+    }
+  }
+  entry_point_ = slot_count == 0 ? kInvalidId : header.entry_point;
+
+  LOG_INFO("Loaded delta index, %zu alive, %zu tombstones", key_map_.size(),
+           deleted_count_);
+  return 0;
+}
+
+int DiskAnnDeltaIndex::search(const void *query, uint32_t topk,
+                              uint32_t list_size, diskann_label_t label,
+                              const IndexFilter &filter,
+                              std::vector<Document> *docs) const {
+  docs->clear();
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (entry_point_ == kInvalidId || topk == 0) {
+    return 0;
+  }
+
+  // Tombstones are still walked through, so widen the list by their count
+  // to keep topk live results reachable, at most doubling it
+  uint32_t width = std::max(std::max(list_size, list_size_), topk);
+  width += static_cast<uint32_t>(std::min<size_t>(deleted_count_, width));
+  width = static_cast<uint32_t>(std::min<size_t>(width, keys_.size()));
+
+  NeighborPriorityQueue best;
+  greedy_search(query, width, &best, nullptr);
+  for (size_t i = 0; i < best.size() && docs->size() < topk; ++i) {
+    const Neighbor &n = best[i];
+    if (accepted(n.id, label, filter)) {
+      docs->push_back(Document{keys_[n.id], n.distance, n.id});
+    }
+  }
+  return 0;
+}
+
+int DiskAnnDeltaIndex::linear_search(const void *query, uint32_t topk,
+                                     diskann_label_t label,
+                                     const IndexFilter &filter,
+                                     std::vector<Document> *docs) const {
+  docs->clear();
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  for (uint32_t i = 0; i < keys_.size(); ++i) {
+    if (!accepted(i, label, filter)) {
+      continue;
+    }
+    docs->push_back(Document{keys_[i], distance(query, vector(i)), i});
+  }
+  keep_topk(topk, docs);
+  return 0;
+}
+
+int DiskAnnDeltaIndex::keys_search(const void *query,
+                                   const std::vector<uint64_t> &keys,
+                                   uint32_t topk, diskann_label_t label,
+                                   const IndexFilter &filter,
+                                   std::vector<Document> *docs) const {
+  docs->clear();
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  for (uint64_t key : keys) {
+    auto it = key_map_.find(key);
+    if (it == key_map_.end() || !accepted(it->second, label, filter)) {
+      continue;
+    }
+    docs->push_back(
+        Document{key, distance(query, vector(it->second)), it->second});
+  }
+  keep_topk(topk, docs);
+  return 0;
+}
+
+void DiskAnnDeltaIndex::keep_topk(uint32_t topk, std::vector<Document> *docs) {
+  auto less = [](const Document &lhs, const Document &rhs) {
+    return lhs.score < rhs.score;
+  };
+  if (docs->size() > topk) {
+    std::partial_sort(docs->begin(), docs->begin() + topk, docs->end(), less);
+    docs->resize(topk);
+  } else {
+    std::sort(docs->begin(), docs->end(), less);
+  }
+}
+
+int DiskAnnDeltaIndex::consolidate(void) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (deleted_count_ == 0) {
+    return 0;
+  }
+
+  size_t total = keys_.size();
+  std::vector<uint32_t> remap(total, kInvalidId);
+  uint32_t live = 0;
+  for (size_t i = 0; i < total; ++i) {
+    if (!deleted_[i]) {
+      remap[i] = live++;
+    }
+  }
+
+  // Route the edges of every live node around its tombstoned neighbors
+  std::vector<Neighbor> pool;
+  std::vector<uint32_t> pruned;
+  std::vector<uint8_t> seen(total, 0);
+  for (size_t i = 0; i < total; ++i) {
+    if (deleted_[i]) {
+      continue;
+    }
+    auto &nbrs = neighbors_[i];
+    bool dirty = false;
+    for (uint32_t n : nbrs) {
+      dirty |= deleted_[n] != 0;
+    }
+    if (!dirty) {
+      continue;
+    }
+
+    pool.clear();
+    seen[i] = 1;
+    auto visit = [&](uint32_t n) {
+      if (!seen[n] && !deleted_[n]) {
+        seen[n] = 1;
+        pool.emplace_back(n, distance(vector(i), vector(n)));
+      }
+    };
+    for (uint32_t n : nbrs) {
+      if (deleted_[n]) {
+        for (uint32_t m : neighbors_[n]) {
+          visit(m);
+        }
+      } else {
+        visit(n);
+      }
+    }
+    seen[i] = 0;
+    for (const auto &n : pool) {
+      seen[n.id] = 0;
+    }
+
+    if (pool.size() > max_degree_) {
+      robust_prune(static_cast<uint32_t>(i), pool, &pruned);
+      nbrs = pruned;
+    } else {
+      nbrs.clear();
+      for (const auto &n : pool) {
+        nbrs.push_back(n.id);
+      }
+    }
+  }
+
+  // Compact the live nodes
+  std::string vectors;
+  vectors.reserve(static_cast<size_t>(live) * element_size_);
+  std::vector<uint64_t> keys;
+  keys.reserve(live);
+  std::vector<diskann_label_t> labels;
+  labels.reserve(live);
+  std::vector<std::vector<uint32_t>> neighbors;
+  neighbors.reserve(live);
+  for (size_t i = 0; i < total; ++i) {
+    if (deleted_[i]) {
+      continue;
+    }
+    vectors.append(static_cast<const char *>(vector(i)), element_size_);
+    keys.push_back(keys_[i]);
+    labels.push_back(labels_[i]);
+    neighbors.emplace_back();
+    auto &nbrs = neighbors.back();
+    nbrs.reserve(neighbors_[i].size());
+    for (uint32_t n : neighbors_[i]) {
+      if (remap[n] != kInvalidId) {
+        nbrs.push_back(remap[n]);
+      }
+    }
+  }
+
+  uint32_t entry_point = kInvalidId;
+  if (live != 0) {
+    entry_point = remap[entry_point_];
+    if (entry_point == kInvalidId) {
+      // Promote the first live neighbor of the old entry point
+      for (uint32_t n : neighbors_[entry_point_]) {
+        if (remap[n] != kInvalidId) {
+          entry_point = remap[n];
+          break;
+        }
+      }
+      if (entry_point == kInvalidId) {
+        entry_point = 0;
+      }
+    }
+  }
+
+  vectors_.swap(vectors);
+  keys_.swap(keys);
+  labels_.swap(labels);
+  neighbors_.swap(neighbors);
+  deleted_.assign(live, 0);
+  key_map_.clear();
+  for (uint32_t i = 0; i < live; ++i) {
+    key_map_.emplace(keys_[i], i);
+  }
+  entry_point_ = entry_point;
+
+  LOG_INFO("Consolidated delta index, dropped %zu tombstones, %u alive",
+           deleted_count_, live);
+  deleted_count_ = 0;
+  return 0;
+}
+
+void DiskAnnDeltaIndex::greedy_search(const void *query, uint32_t list_size,
+                                      NeighborPriorityQueue *best,
+                                      std::vector<Neighbor> *visited) const {
+  best->reserve(list_size);
+  best->clear();
+
+  std::vector<uint8_t> seen(keys_.size(), 0);
+  seen[entry_point_] = 1;
+  best->insert(Neighbor(entry_point_, distance(query, vector(entry_point_))));
+
+  while (best->has_unexpanded_node()) {
+    Neighbor cur = best->closest_unexpanded();
+    if (visited) {
+      visited->push_back(cur);
+    }
+    for (uint32_t n : neighbors_[cur.id]) {
+      if (seen[n]) {
+        continue;
+      }
+      seen[n] = 1;
+      best->insert(Neighbor(n, distance(query, vector(n))));
+    }
+  }
+}
+
+void DiskAnnDeltaIndex::robust_prune(uint32_t id, std::vector<Neighbor> &pool,
+                                     std::vector<uint32_t> *pruned) const {
+  pruned->clear();
+  std::sort(pool.begin(), pool.end());
+
+  std::vector<float> occlude_factor(pool.size(), 0.0f);
+  float cur_alpha = 1.0f;
+  while (cur_alpha <= alpha_ && pruned->size() < max_degree_) {
+    for (size_t i = 0; i < pool.size() && pruned->size() < max_degree_; ++i) {
+      if (occlude_factor[i] > cur_alpha || pool[i].id == id) {
+        continue;
+      }
+      // Mark as selected so later rounds skip it
+      occlude_factor[i] = std::numeric_limits<float>::max();
+      pruned->push_back(pool[i].id);
+      const void *selected = vector(pool[i].id);
+      for (size_t j = i + 1; j < pool.size(); ++j) {
+        if (occlude_factor[j] > alpha_) {
+          continue;
+        }
+        float djk = distance(selected, vector(pool[j].id));
+        occlude_factor[j] =
+            (djk == 0) ? std::numeric_limits<float>::max()
+                       : std::max(occlude_factor[j], pool[j].distance / djk);
+      }
+    }
+    cur_alpha *= 1.2f;
+  }
+}
+
+void DiskAnnDeltaIndex::inter_insert(uint32_t nbr, uint32_t id) {
+  auto &nbrs = neighbors_[nbr];
+  if (std::find(nbrs.begin(), nbrs.end(), id) != nbrs.end()) {
+    return;
+  }
+  if (nbrs.size() < max_degree_) {
+    nbrs.push_back(id);
+    return;
+  }
+
+  std::vector<Neighbor> pool;
+  pool.reserve(nbrs.size() + 1);
+  const void *base = vector(nbr);
+  for (uint32_t n : nbrs) {
+    pool.emplace_back(n, distance(base, vector(n)));
+  }
+  pool.emplace_back(id, distance(base, vector(id)));
+
+  std::vector<uint32_t> pruned;
+  robust_prune(nbr, pool, &pruned);
+  nbrs.swap(pruned);
+}
+
+}  // namespace core
+}  // namespace zvec
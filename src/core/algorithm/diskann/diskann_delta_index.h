@@ -0,0 +1,172 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <zvec/core/framework/index_framework.h>
+#include "diskann_entity.h"
+#include "diskann_util.h"
+
+namespace zvec {
+namespace core {
+
+/*! DiskAnn Delta Index
+ *  In-memory Vamana graph holding the vectors streamed into a DiskAnn index
+ *  after it was built. Deleted nodes are tombstoned and stay navigable until
+ *  consolidate() repairs the neighbor lists pointing at them.
+ */
+class DiskAnnDeltaIndex {
+ public:
+  typedef std::shared_ptr<DiskAnnDeltaIndex> Pointer;
+
+  //! Search result of delta index
+  struct Document {
+    uint64_t key;
+    float score;
+    uint32_t id;
+  };
+
+  //! Constants
+  static constexpr uint32_t kDefaultMaxDegree = 32u;
+  static constexpr uint32_t kDefaultListSize = 100u;
+  static constexpr float kDefaultAlpha = 1.2f;
+
+  //! Initialize the delta index
+  int init(const IndexMeta &meta, const IndexMetric::Pointer &measure,
+           uint32_t max_degree, uint32_t list_size, float alpha);
+
+  //! Drop all vectors
+  void clear(void);
+
+  //! Insert a vector carrying a graph label, the key must not exist
+  int add(uint64_t key, const void *vec, diskann_label_t label = kInvalidLabel);
+
+  //! Tombstone a vector
+  int remove(uint64_t key);
+
+  //! Test if a live vector of key exists
+  bool contains(uint64_t key) const;
+
+  //! Copy the vector of key
+  int get_vector(uint64_t key, std::string *vec) const;
+
+  //! Copy the vector of id
+  int get_vector_by_id(uint32_t id, std::string *vec) const;
+
+  //! Search the nearest live vectors of label accepted by filter,
+  //! kInvalidLabel matches every label
+  int search(const void *query, uint32_t topk, uint32_t list_size,
+             diskann_label_t label, const IndexFilter &filter,
+             std::vector<Document> *docs) const;
+
+  //! Scan every live vector of label accepted by filter
+  int linear_search(const void *query, uint32_t topk, diskann_label_t label,
+                    const IndexFilter &filter,
+                    std::vector<Document> *docs) const;
+
+  //! Score the live vectors of keys of label accepted by filter
+  int keys_search(const void *query, const std::vector<uint64_t> &keys,
+                  uint32_t topk, diskann_label_t label,
+                  const IndexFilter &filter,
+                  std::vector<Document> *docs) const;
+
+  //! Drop tombstones and repair the neighbor lists referring to them
+  int consolidate(void);
+
+  //! Retrieve count of live vectors
+  size_t count(void) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return key_map_.size();
+  }
+
+  //! Retrieve count of tombstoned vectors
+  size_t deleted_count(void) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return deleted_count_;
+  }
+
+  //! Retrieve count of slots, tombstones included
+  size_t slot_count(void) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return keys_.size();
+  }
+
+  //! Copy the vector and label of a slot, returns its key or kInvalidKey
+  //! for tombstones and slots past the end
+  uint64_t get_slot(uint32_t id, std::string *vec,
+                    diskann_label_t *label = nullptr) const;
+
+  //! Dump the graph as delta segments
+  int dump(const IndexDumper::Pointer &dumper) const;
+
+  //! Load the graph from the delta segments of storage, if any
+  int load(const IndexStorage::Pointer &storage);
+
+ private:
+  //! Retrieve vector of id
+  const void *vector(uint32_t id) const {
+    return vectors_.data() + static_cast<size_t>(id) * element_size_;
+  }
+
+  //! Calculate distance between two vectors
+  float distance(const void *lhs, const void *rhs) const {
+    float score = 0.0f;
+    distance_(lhs, rhs, dimension_, &score);
+    return score;
+  }
+
+  //! Test if id may be returned by a search of label and filter
+  bool accepted(uint32_t id, diskann_label_t label,
+                const IndexFilter &filter) const {
+    return !deleted_[id] && (label == kInvalidLabel || labels_[id] == label) &&
+           !(filter.is_valid() && filter(keys_[id]));
+  }
+
+  //! Keep the topk nearest documents
+  static void keep_topk(uint32_t topk, std::vector<Document> *docs);
+
+  //! Greedy search from entry point, collecting every visited node
+  void greedy_search(const void *query, uint32_t list_size,
+                     NeighborPriorityQueue *best,
+                     std::vector<Neighbor> *visited) const;
+
+  //! Select diverse neighbors of id out of pool
+  void robust_prune(uint32_t id, std::vector<Neighbor> &pool,
+                    std::vector<uint32_t> *pruned) const;
+
+  //! Link id into the neighbor list of nbr
+  void inter_insert(uint32_t nbr, uint32_t id);
+
+  //! Members
+  IndexMetric::MatrixDistance distance_{};
+  uint32_t dimension_{0};
+  uint32_t element_size_{0};
+  uint32_t max_degree_{kDefaultMaxDegree};
+  uint32_t list_size_{kDefaultListSize};
+  float alpha_{kDefaultAlpha};
+
+  std::string vectors_{};
+  std::vector<uint64_t> keys_{};
+  std::vector<diskann_label_t> labels_{};
+  std::vector<std::vector<uint32_t>> neighbors_{};
+  std::vector<uint8_t> deleted_{};
+  std::unordered_map<uint64_t, uint32_t> key_map_{};
+  uint32_t entry_point_{kInvalidId};
+  size_t deleted_count_{0};
+  mutable std::shared_mutex mutex_{};
+};
+
+}  // namespace core
+}  // namespace zvec
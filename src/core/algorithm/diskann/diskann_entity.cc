@@ -27,6 +27,50 @@ const std::string DiskAnnEntity::kDiskAnnKeyMappingSegmentId =
 const std::string DiskAnnEntity::kDiskAnnEntryPointSegmentId =
     "diskann.entrypoint";
 const std::string DiskAnnEntity::kDiskAnnKeySegmentId = "diskann.key";
+const std::string DiskAnnEntity::kDiskAnnLabelSegmentId = "diskann.label";
+const std::string DiskAnnEntity::kDiskAnnTombstoneSegmentId =
+    "diskann.tombstone";
+const std::string DiskAnnEntity::kDiskAnnDeltaMetaSegmentId =
+    "diskann.delta.meta";
+const std::string DiskAnnEntity::kDiskAnnDeltaKeySegmentId =
+    "diskann.delta.key";
+const std::string DiskAnnEntity::kDiskAnnDeltaLabelSegmentId =
+    "diskann.delta.label";
+const std::string DiskAnnEntity::kDiskAnnDeltaTombstoneSegmentId =
+    "diskann.delta.tombstone";
+const std::string DiskAnnEntity::kDiskAnnDeltaVectorSegmentId =
+    "diskann.delta.vector";
+const std::string DiskAnnEntity::kDiskAnnDeltaNeighborSegmentId =
+    "diskann.delta.neighbor";
+
+int DiskAnnEntity::DumpSegment(const IndexDumper::Pointer &dumper,
+                               const std::string &segment_id,
+                               const void *data, size_t size) {
+  size_t len = dumper->write(data, size);
+  if (len != size) {
+    LOG_ERROR("Dump segment %s data failed, expect: %lu, actual: %lu",
+              segment_id.c_str(), size, len);
+    return IndexError_WriteData;
+  }
+
+  size_t padding_size = AlignSize(size) - size;
+  if (padding_size > 0) {
+    std::string padding(padding_size, '\0');
+    if (dumper->write(padding.data(), padding_size) != padding_size) {
+      LOG_ERROR("Append padding failed, size %lu", padding_size);
+      return IndexError_WriteData;
+    }
+  }
+
+  uint32_t crc = ailego::Crc32c::Hash(data, size);
+  int ret = dumper->append(segment_id, size, padding_size, crc);
+  if (ret != 0) {
+    LOG_ERROR("Dump segment %s meta failed, ret=%d", segment_id.c_str(), ret);
+    return ret;
+  }
+
+  return 0;
+}
 
 }  // namespace core
 }  // namespace zvec
@@ -22,9 +22,11 @@ namespace core {
 using dist_t = float;
 using diskann_key_t = uint64_t;
 using diskann_id_t = uint32_t;
+using diskann_label_t = uint32_t;
 
 constexpr diskann_id_t kInvalidId = static_cast<diskann_id_t>(-1);
 constexpr diskann_key_t kInvalidKey = static_cast<key_t>(-1);
+constexpr diskann_label_t kInvalidLabel = static_cast<diskann_label_t>(-1);
 
 struct VectorInfo {
   float dist_;
@@ -124,6 +126,11 @@ class DiskAnnEntity {
     return (size + 0xFFF) & (~0xFFF);
   }
 
+  //! Dump data as a segment padded to AlignSize
+  static int DumpSegment(const IndexDumper::Pointer &dumper,
+                         const std::string &segment_id, const void *data,
+                         size_t size);
+
  public:
   virtual int add_vector(diskann_key_t /*key*/, const void * /*vec*/) {
     return IndexError_NotImplemented;
@@ -153,6 +160,16 @@ class DiskAnnEntity {
   //! Get primary key of the node id
   virtual diskann_key_t get_key(diskann_id_t id) const = 0;
 
+  //! Get graph label of the node id, kInvalidLabel if unlabeled
+  virtual diskann_label_t get_label(diskann_id_t /*id*/) const {
+    return kInvalidLabel;
+  }
+
+  //! Get entry point of the nodes labeled label
+  virtual diskann_id_t get_label_medoid(diskann_label_t /*label*/) const {
+    return kInvalidId;
+  }
+
  public:
   uint64_t max_node_size() const {
     return meta_header_.max_node_size;
@@ -206,6 +223,14 @@ class DiskAnnEntity {
   const static std::string kDiskAnnKeyMappingSegmentId;
   const static std::string kDiskAnnEntryPointSegmentId;
   const static std::string kDiskAnnKeySegmentId;
+  const static std::string kDiskAnnLabelSegmentId;
+  const static std::string kDiskAnnTombstoneSegmentId;
+  const static std::string kDiskAnnDeltaMetaSegmentId;
+  const static std::string kDiskAnnDeltaKeySegmentId;
+  const static std::string kDiskAnnDeltaLabelSegmentId;
+  const static std::string kDiskAnnDeltaTombstoneSegmentId;
+  const static std::string kDiskAnnDeltaVectorSegmentId;
+  const static std::string kDiskAnnDeltaNeighborSegmentId;
 
   constexpr static float kDefaultBFNegativeProbility = 0.001f;
   constexpr static float kDefaultGraphSlackFactor = 1.3f;
@@ -745,6 +745,7 @@ int LinuxAlignedFileReader::submit(PendingBatch &batch,
   batch.used_pread = false;
   batch.cbs.clear();
   batch.cb_ptrs.clear();
+  batch.ready.clear();
 
   if (this->file_desc == -1) {
     LOG_ERROR("submit: invalid file descriptor");
@@ -889,6 +890,108 @@ static void quiesce_batch(PendingBatch &batch, IOContext &ctx) {
   }
 }
 
+int LinuxAlignedFileReader::append(PendingBatch &batch,
+                                   std::vector<AlignedRead> &read_reqs,
+                                   IOContext &ctx) {
+  if (this->file_desc == -1) {
+    LOG_ERROR("append: invalid file descriptor");
+    return IndexError_Runtime;
+  }
+
+  if (read_reqs.empty()) {
+    return 0;
+  }
+
+  uint32_t base = batch.n_submitted;
+  uint32_t n_ops = (uint32_t)read_reqs.size();
+
+  // Synchronous backends complete the reads before returning; they are
+  // handed out by the next get_completed()
+  if (ctx == nullptr || ctx == (IOContext)-1 ||
+      ctx->type != ailego::IOBackendType::kLibAio) {
+    int ret = -1;
+    if (ctx != nullptr && ctx != (IOContext)-1 &&
+        ctx->type == ailego::IOBackendType::kIoUring) {
+      ret = ctx->ring.execute(this->file_desc, read_reqs);
+      if (ret != 0) {
+        LOG_WARN("append: io_uring execute failed; falling back to pread");
+      }
+    }
+    if (ret != 0) {
+      ret = execute_io_pread(this->file_desc, read_reqs);
+      if (ret != 0) {
+        return ret;
+      }
+    }
+    for (uint32_t j = 0; j < n_ops; j++) {
+      batch.ready.push_back(base + j);
+    }
+    batch.n_submitted += n_ops;
+    return 0;
+  }
+
+  // Reads completed by an earlier synchronous submit() wait in ready from
+  // now on, as the batch gets requests in flight again
+  if (batch.used_pread) {
+    for (uint32_t i = batch.n_reaped; i < batch.n_submitted; i++) {
+      batch.ready.push_back(i);
+    }
+    batch.used_pread = false;
+  }
+
+  // Control blocks are indexed by request, including the synchronous ones
+  while (batch.cbs.size() < base) {
+    batch.cbs.emplace_back();
+  }
+  batch.cb_ptrs.resize(base, nullptr);
+  for (uint32_t j = 0; j < n_ops; j++) {
+    batch.cbs.emplace_back();
+    io_prep_pread(&batch.cbs.back(), this->file_desc, read_reqs[j].buf,
+                  read_reqs[j].len, read_reqs[j].offset);
+    batch.cbs.back().data = (void *)(uintptr_t)(base + j);
+    batch.cb_ptrs.push_back(&batch.cbs.back());
+  }
+
+  constexpr size_t kMaxSubmitRetries = 8;
+  uint32_t submitted = 0;
+  size_t n_tries = 0;
+  while (submitted < n_ops) {
+    uint32_t remaining = n_ops - submitted;
+    int ret = LibAioLoader::Instance().io_submit(
+        ctx->aio_ctx, (int64_t)remaining,
+        batch.cb_ptrs.data() + base + submitted);
+    if (ret > 0 && (uint32_t)ret <= remaining) {
+      submitted += (uint32_t)ret;
+      n_tries = 0;
+      continue;
+    }
+    if ((ret == -EAGAIN || ret == -EINTR) && n_tries < kMaxSubmitRetries) {
+      n_tries++;
+      continue;
+    }
+    LOG_WARN(
+        "append: io_submit stopped after %u/%u requests; returned: %d. "
+        "reading the rest with pread",
+        submitted, n_ops, ret);
+    break;
+  }
+
+  // The unsubmitted reads own distinct buffers, so they are safe to read
+  // synchronously while the submitted ones are in flight
+  for (uint32_t j = submitted; j < n_ops; j++) {
+    if (execute_one_pread(this->file_desc, read_reqs[j]) != 0) {
+      LOG_ERROR("append: pread of read %u failed", base + j);
+      batch.n_submitted = base + submitted;
+      quiesce_batch(batch, ctx);
+      return IndexError_Runtime;
+    }
+    batch.ready.push_back(base + j);
+  }
+
+  batch.n_submitted += n_ops;
+  return 0;
+}
+
 int LinuxAlignedFileReader::get_completed(
     PendingBatch &batch, IOContext &ctx, int min_completed,
     std::vector<uint32_t> &completed_indices) {
@@ -903,6 +1006,13 @@ int LinuxAlignedFileReader::get_completed(
       completed_indices.push_back(i);
     }
     batch.n_reaped = batch.n_submitted;
+    batch.ready.clear();
+    return (int)completed_indices.size();
+  }
+
+  if (!batch.ready.empty()) {
+    completed_indices.swap(batch.ready);
+    batch.n_reaped += (uint32_t)completed_indices.size();
     return (int)completed_indices.size();
   }
 
@@ -970,6 +1080,7 @@ int LinuxAlignedFileReader::submit(PendingBatch &batch,
   batch.n_submitted = 0;
   batch.n_reaped = 0;
   batch.used_pread = false;
+  batch.ready.clear();
 
   int ret = read(read_reqs, ctx);
   if (ret != 0) {
@@ -982,6 +1093,19 @@ int LinuxAlignedFileReader::submit(PendingBatch &batch,
   return 0;
 }
 
+int LinuxAlignedFileReader::append(PendingBatch &batch,
+                                   std::vector<AlignedRead> &read_reqs,
+                                   IOContext &ctx) {
+  int ret = read(read_reqs, ctx);
+  if (ret != 0) {
+    return ret;
+  }
+
+  batch.used_pread = true;
+  batch.n_submitted += static_cast<uint32_t>(read_reqs.size());
+  return 0;
+}
+
 int LinuxAlignedFileReader::get_completed(
     PendingBatch &batch, IOContext & /*ctx*/, int /*min_completed*/,
     std::vector<uint32_t> &completed_indices) {
@@ -23,6 +23,7 @@
 #endif
 
 #include <unistd.h>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -84,9 +85,12 @@ struct AlignedRead {
 
 struct PendingBatch {
 #if (defined(__linux) || defined(__linux__))
-  std::vector<struct iocb> cbs;
+  //! A deque keeps the control blocks in place while appending to the batch
+  std::deque<struct iocb> cbs;
   std::vector<struct iocb *> cb_ptrs;
 #endif
+  //! Appended reads completed synchronously, not reaped yet
+  std::vector<uint32_t> ready;
   uint32_t n_submitted{0};
   uint32_t n_reaped{0};
   bool used_pread{false};
@@ -115,6 +119,11 @@ class AlignedFileReader {
   virtual int submit(PendingBatch &batch, std::vector<AlignedRead> &read_reqs,
                      IOContext &ctx) = 0;
 
+  //! Add reads to a batch whose earlier reads may still be in flight, the
+  //! appended reads are indexed after the ones already submitted
+  virtual int append(PendingBatch &batch, std::vector<AlignedRead> &read_reqs,
+                     IOContext &ctx) = 0;
+
   virtual int get_completed(PendingBatch &batch, IOContext &ctx,
                             int min_completed,
                             std::vector<uint32_t> &completed_indices) = 0;
@@ -148,6 +157,9 @@ class LinuxAlignedFileReader : public AlignedFileReader {
   int submit(PendingBatch &batch, std::vector<AlignedRead> &read_reqs,
              IOContext &ctx);
 
+  int append(PendingBatch &batch, std::vector<AlignedRead> &read_reqs,
+             IOContext &ctx);
+
   int get_completed(PendingBatch &batch, IOContext &ctx, int min_completed,
                     std::vector<uint32_t> &completed_indices);
 };
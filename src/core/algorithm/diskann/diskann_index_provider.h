@@ -16,7 +16,9 @@
 #include <zvec/core/framework/index_provider.h>
 #include <zvec/core/framework/index_searcher.h>
 #include <zvec/core/framework/index_streamer.h>
+#include "diskann_delta_index.h"
 #include "diskann_entity.h"
+#include "diskann_indexer.h"
 
 namespace zvec {
 namespace core {
@@ -26,25 +28,41 @@ namespace core {
 //! Used by ``MixedStreamerReducer`` during segment merge: the reducer needs
 //! to walk every vector held by a source DiskAnn streamer and feed it into
 //! the merge target. Vectors are read on demand from the entity's on-disk
-//! vector segment via ``DiskAnnEntity::get_vector(id)``.
+//! vector segment via ``DiskAnnEntity::get_vector(id)``. A streamer also
+//! passes its indexer and delta graph, so tombstoned nodes are skipped and
+//! the streamed-in vectors follow the on-disk ones. Delta vectors are copied
+//! out under the delta lock, so adds may run while iterating.
 class DiskAnnIndexProvider : public IndexProvider {
  public:
   DiskAnnIndexProvider(const IndexMeta &meta,
                        const DiskAnnEntity::Pointer &entity,
-                       const std::string &owner)
-      : meta_(meta), entity_(entity), owner_class_(owner) {}
+                       const std::string &owner,
+                       const DiskAnnIndexer *indexer = nullptr,
+                       const DiskAnnDeltaIndex *delta = nullptr)
+      : meta_(meta),
+        entity_(entity),
+        owner_class_(owner),
+        indexer_(indexer),
+        delta_(delta) {}
 
   DiskAnnIndexProvider(const DiskAnnIndexProvider &) = delete;
   DiskAnnIndexProvider &operator=(const DiskAnnIndexProvider &) = delete;
 
  public:
   IndexProvider::Iterator::Pointer create_iterator() override {
-    return IndexProvider::Iterator::Pointer(new (std::nothrow)
-                                                Iterator(entity_));
+    return IndexProvider::Iterator::Pointer(
+        new (std::nothrow) Iterator(entity_, indexer_, delta_));
   }
 
   size_t count(void) const override {
-    return entity_->doc_cnt();
+    size_t cnt = entity_->doc_cnt();
+    if (indexer_) {
+      cnt -= indexer_->deleted_count();
+    }
+    if (delta_) {
+      cnt += delta_->count();
+    }
+    return cnt;
   }
 
   size_t dimension(void) const override {
@@ -60,8 +78,11 @@ class DiskAnnIndexProvider : public IndexProvider {
   }
 
   const void *get_vector(uint64_t key) const override {
+    if (delta_ && delta_->get_vector(key, &delta_vector_) == 0) {
+      return delta_vector_.data();
+    }
     diskann_id_t id = entity_->get_id(static_cast<diskann_key_t>(key));
-    if (id == kInvalidId) {
+    if (id == kInvalidId || (indexer_ && indexer_->is_deleted(id))) {
       return nullptr;
     }
     return entity_->get_vector(id);
@@ -74,21 +95,25 @@ class DiskAnnIndexProvider : public IndexProvider {
  private:
   class Iterator : public IndexProvider::Iterator {
    public:
-    explicit Iterator(const DiskAnnEntity::Pointer &entity)
-        : entity_(entity), cur_id_(0U) {
+    Iterator(const DiskAnnEntity::Pointer &entity,
+             const DiskAnnIndexer *indexer, const DiskAnnDeltaIndex *delta)
+        : entity_(entity), indexer_(indexer), delta_(delta), cur_id_(0U) {
       cur_id_ = next_valid_id(0U);
     }
 
     const void *data(void) const override {
+      if (cur_id_ >= disk_count()) {
+        return delta_vector_.data();
+      }
       return entity_->get_vector(cur_id_);
     }
 
     bool is_valid(void) const override {
-      return cur_id_ < static_cast<diskann_id_t>(entity_->doc_cnt());
+      return cur_id_ < total_count_;
     }
 
     uint64_t key(void) const override {
-      return static_cast<uint64_t>(entity_->get_key(cur_id_));
+      return static_cast<uint64_t>(cur_key_);
     }
 
     void next(void) override {
@@ -97,23 +122,53 @@ class DiskAnnIndexProvider : public IndexProvider {
 
    private:
     //! Skip ids that map to ``kInvalidKey`` (deleted / never populated slots).
-    diskann_id_t next_valid_id(diskann_id_t start_id) const {
-      const auto total = static_cast<diskann_id_t>(entity_->doc_cnt());
-      for (diskann_id_t i = start_id; i < total; ++i) {
-        if (entity_->get_key(i) != kInvalidKey) {
+    diskann_id_t next_valid_id(diskann_id_t start_id) {
+      total_count_ = total_count();
+      for (diskann_id_t i = start_id; i < total_count_; ++i) {
+        cur_key_ = key_of(i);
+        if (cur_key_ != kInvalidKey) {
           return i;
         }
       }
-      return total;
+      return total_count_;
+    }
+
+    //! Ids past the on-disk nodes address the delta graph slots, whose
+    //! vector is copied aside
+    diskann_key_t key_of(diskann_id_t id) {
+      if (id >= disk_count()) {
+        return delta_->get_slot(id - disk_count(), &delta_vector_);
+      }
+      if (indexer_ && indexer_->is_deleted(id)) {
+        return kInvalidKey;
+      }
+      return entity_->get_key(id);
+    }
+
+    diskann_id_t disk_count(void) const {
+      return static_cast<diskann_id_t>(entity_->doc_cnt());
+    }
+
+    diskann_id_t total_count(void) const {
+      return disk_count() +
+             (delta_ ? static_cast<diskann_id_t>(delta_->slot_count()) : 0U);
     }
 
     DiskAnnEntity::Pointer entity_;
+    const DiskAnnIndexer *indexer_;
+    const DiskAnnDeltaIndex *delta_;
     diskann_id_t cur_id_;
+    diskann_id_t total_count_{0U};
+    diskann_key_t cur_key_{kInvalidKey};
+    std::string delta_vector_{};
   };
 
   IndexMeta meta_;
   DiskAnnEntity::Pointer entity_;
   std::string owner_class_;
+  const DiskAnnIndexer *indexer_;
+  const DiskAnnDeltaIndex *delta_;
+  mutable std::string delta_vector_{};
 };
 
 }  // namespace core
@@ -19,6 +19,7 @@
 #include <set>
 #include <tuple>
 #include <unordered_set>
+#include <zvec/ailego/io/file.h>
 
 namespace zvec {
 namespace core {
@@ -75,13 +76,19 @@ int DiskAnnIndexer::init(DiskAnnSearcherEntity &entity) {
   }
 
   doc_cnt_ = entity.doc_cnt();
+  labels_ = entity.labels().empty() ? nullptr : entity.labels().data();
+  deleted_ = std::vector<std::atomic<uint8_t>>(doc_cnt_);
+  deleted_count_ = 0;
 
   max_degree_ = entity.max_degree();
 
   sector_num_per_node_ =
       DiskAnnUtil::div_round_up(max_node_size_, DiskAnnUtil::kSectorSize);
-  if (beam_width_ * sector_num_per_node_ > DiskAnnUtil::kMaxSectorReadNum) {
-    LOG_ERROR("Beamwidth can not be higher than kMaxSectorReadNum");
+  if (beam_width_ == 0 ||
+      beam_width_ * sector_num_per_node_ > DiskAnnUtil::kMaxSectorReadNum) {
+    LOG_ERROR("Invalid beam width %u, must be in [1, %u]", beam_width_,
+              static_cast<uint32_t>(DiskAnnUtil::kMaxSectorReadNum /
+                                    sector_num_per_node_));
 
     return IndexError_InvalidArgument;
   }
@@ -132,6 +139,59 @@ diskann_id_t DiskAnnIndexer::get_id(diskann_key_t key) const {
   return entity_->get_id(key);
 }
 
+bool DiskAnnIndexer::mark_deleted(diskann_id_t id) {
+  if (id >= doc_cnt_ || deleted_[id].exchange(1) != 0) {
+    return false;
+  }
+  deleted_count_.fetch_add(1);
+  return true;
+}
+
+int DiskAnnIndexer::dump_tombstones(const IndexDumper::Pointer &dumper) const {
+  std::vector<uint8_t> bitmap((doc_cnt_ + 7) / 8, 0);
+  for (diskann_id_t id = 0; id < doc_cnt_; ++id) {
+    if (is_deleted(id)) {
+      bitmap[id / 8] |= static_cast<uint8_t>(1u << (id % 8));
+    }
+  }
+  if (bitmap.empty()) {
+    return 0;
+  }
+  return DiskAnnEntity::DumpSegment(dumper,
+                                    DiskAnnEntity::kDiskAnnTombstoneSegmentId,
+                                    bitmap.data(), bitmap.size());
+}
+
+int DiskAnnIndexer::load_tombstones(const IndexStorage::Pointer &storage) {
+  auto segment = storage->get(DiskAnnEntity::kDiskAnnTombstoneSegmentId);
+  if (!segment) {
+    return 0;
+  }
+
+  const void *data = nullptr;
+  size_t len = (doc_cnt_ + 7) / 8;
+  if (segment->data_size() != len) {
+    LOG_ERROR("Tombstone bitmap of %zu bytes does not match %zu nodes",
+              segment->data_size(), (size_t)doc_cnt_);
+    return IndexError_Mismatch;
+  }
+  if (segment->read(0, &data, len) != len) {
+    LOG_ERROR("Read segment %s failed",
+              DiskAnnEntity::kDiskAnnTombstoneSegmentId.c_str());
+    return IndexError_ReadData;
+  }
+
+  const uint8_t *bitmap = static_cast<const uint8_t *>(data);
+  for (diskann_id_t id = 0; id < doc_cnt_; ++id) {
+    if (bitmap[id / 8] & (1u << (id % 8))) {
+      mark_deleted(id);
+    }
+  }
+
+  LOG_INFO("Loaded %zu tombstones", deleted_count());
+  return 0;
+}
+
 std::vector<bool> DiskAnnIndexer::read_nodes(
     const std::vector<diskann_id_t> &node_ids,
     std::vector<void *> &coord_buffers,
@@ -263,6 +323,105 @@ int DiskAnnIndexer::load_cache_list(
   return 0;
 }
 
+int DiskAnnIndexer::init_node_cache(size_t memory_size,
+                                    const std::string &hot_set_path) {
+  node_cache_.reset();
+  size_t capacity = memory_size / max_node_size_;
+  if (capacity == 0) {
+    return 0;
+  }
+  capacity = std::min<size_t>(capacity, doc_cnt_);
+  node_cache_ = std::make_shared<DiskAnnNodeCache>(max_node_size_, capacity);
+  LOG_INFO("Adaptive node cache enabled, capacity %zu nodes", capacity);
+
+  if (hot_set_path.empty() || !ailego::File::IsExist(hot_set_path)) {
+    return 0;
+  }
+
+  ailego::File file;
+  if (!file.open(hot_set_path, true)) {
+    LOG_WARN("Failed to open hot set file %s", hot_set_path.c_str());
+    return 0;
+  }
+  uint32_t header[2] = {0, 0};
+  if (file.read(header, sizeof(header)) != sizeof(header) ||
+      header[0] != kHotSetMagic) {
+    LOG_WARN("Invalid hot set file %s", hot_set_path.c_str());
+    return 0;
+  }
+  std::vector<diskann_id_t> hot_set(std::min<size_t>(header[1], capacity));
+  size_t bytes = hot_set.size() * sizeof(diskann_id_t);
+  if (file.read(hot_set.data(), bytes) != bytes) {
+    LOG_WARN("Truncated hot set file %s", hot_set_path.c_str());
+    return 0;
+  }
+  hot_set.erase(std::remove_if(hot_set.begin(), hot_set.end(),
+                               [this](diskann_id_t id) {
+                                 return id >= doc_cnt_;
+                               }),
+                hot_set.end());
+
+  // Rebuild the node images from the vectors and neighbor lists
+  constexpr size_t kBlockSize = 64;
+  std::string images(kBlockSize * max_node_size_, '\0');
+  for (size_t start = 0; start < hot_set.size(); start += kBlockSize) {
+    size_t end = std::min(hot_set.size(), start + kBlockSize);
+    std::vector<diskann_id_t> nodes(hot_set.begin() + start,
+                                    hot_set.begin() + end);
+    std::vector<void *> coord_buffers(nodes.size());
+    std::vector<std::pair<uint32_t, diskann_id_t *>> neighbor_buffers(
+        nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      uint8_t *image = reinterpret_cast<uint8_t *>(&images[0]) +
+                       i * max_node_size_;
+      coord_buffers[i] = image;
+      neighbor_buffers[i].second = reinterpret_cast<diskann_id_t *>(
+          DiskAnnUtil::offset_to_node_neighbor(image, meta_.element_size()) +
+          1);
+    }
+
+    auto read_status = read_nodes(nodes, coord_buffers, neighbor_buffers);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (!read_status[i]) {
+        continue;
+      }
+      uint8_t *image = static_cast<uint8_t *>(coord_buffers[i]);
+      *DiskAnnUtil::offset_to_node_neighbor(image, meta_.element_size()) =
+          neighbor_buffers[i].first;
+      node_cache_->insert(nodes[i], image);
+    }
+  }
+  LOG_INFO("Warmed up node cache with %zu nodes from %s", node_cache_->size(),
+           hot_set_path.c_str());
+  return 0;
+}
+
+int DiskAnnIndexer::save_node_cache(const std::string &hot_set_path) const {
+  if (!node_cache_ || hot_set_path.empty()) {
+    return 0;
+  }
+
+  std::vector<diskann_id_t> hot_set;
+  node_cache_->hot_set(&hot_set);
+
+  ailego::File file;
+  if (!file.create(hot_set_path, 0)) {
+    LOG_ERROR("Failed to create hot set file %s", hot_set_path.c_str());
+    return IndexError_CreateFile;
+  }
+  uint32_t header[2] = {kHotSetMagic, static_cast<uint32_t>(hot_set.size())};
+  size_t bytes = hot_set.size() * sizeof(diskann_id_t);
+  if (file.write(header, sizeof(header)) != sizeof(header) ||
+      file.write(hot_set.data(), bytes) != bytes) {
+    LOG_ERROR("Failed to write hot set file %s", hot_set_path.c_str());
+    return IndexError_WriteData;
+  }
+  LOG_INFO("Saved %zu hot nodes to %s, cache hits %zu misses %zu",
+           hot_set.size(), hot_set_path.c_str(),
+           (size_t)node_cache_->hit_count(), (size_t)node_cache_->miss_count());
+  return 0;
+}
+
 void DiskAnnIndexer::cache_bfs_levels(uint64_t num_nodes_to_cache,
                                       std::vector<diskann_id_t> &node_list) {
   std::set<diskann_id_t> node_set;
@@ -452,7 +611,7 @@ int DiskAnnIndexer::linear_search(DiskAnnContext *ctx) {
   diskann_id_t id = 0;
   while (id < doc_cnt_) {
     while (frontier.size() < beam_width_) {
-      if (!ctx->filter().is_valid() || !ctx->filter()(get_key(id))) {
+      if (accepted(ctx, id)) {
         auto iter = neighbor_cache_.find(id);
         if (iter != neighbor_cache_.end()) {
           cached_neighbors.push_back(
@@ -604,7 +763,7 @@ int DiskAnnIndexer::keys_search(const std::vector<uint64_t> &keys,
     while (frontier.size() < beam_width_) {
       if (!ctx->filter().is_valid() || !ctx->filter()(keys[idx])) {
         diskann_id_t id = get_id(keys[idx]);
-        if (id == kInvalidId) {
+        if (id == kInvalidId || is_deleted(id) || !label_matched(ctx, id)) {
           ++idx;
           if (idx >= keys.size()) {
             break;
@@ -802,7 +961,8 @@ int DiskAnnIndexer::knn_search(DiskAnnContext *ctx) {
 }
 
 int DiskAnnIndexer::cached_beam_search(DiskAnnContext *ctx) {
-  auto &stats = ctx->query_stats();
+  auto &stats = ctx->last_query_stats();
+  stats = SearchStats();
   auto &dc = ctx->dist_calculator();
   auto &topk_heap = ctx->topk_heap();
   auto &visit_filter = ctx->visit_filter();
@@ -829,16 +989,25 @@ int DiskAnnIndexer::cached_beam_search(DiskAnnContext *ctx) {
 
   candidates.reserve(ctx->list_size());
 
+  // A label restricted search starts from the medoid of its label
+  const diskann_label_t query_label = ctx->query_label();
   diskann_id_t best_medoid = entrypoints_.front();
-  float best_dist = (std::numeric_limits<float>::max)();
-  for (uint64_t cur_m = 0; cur_m < entrypoints_.size(); cur_m++) {
-    const void *entrypoint =
-        static_cast<const uint8_t *>(centroid_data_) + centroid_stride_ * cur_m;
-    float cur_expanded_dist = dc.dist(ctx->query(), entrypoint);
-
-    if (cur_expanded_dist < best_dist) {
-      best_medoid = entrypoints_[cur_m];
-      best_dist = cur_expanded_dist;
+  if (query_label != kInvalidLabel) {
+    best_medoid = labels_ ? entity_->get_label_medoid(query_label) : kInvalidId;
+    if (best_medoid == kInvalidId) {
+      return 0;
+    }
+  } else {
+    float best_dist = (std::numeric_limits<float>::max)();
+    for (uint64_t cur_m = 0; cur_m < entrypoints_.size(); cur_m++) {
+      const void *entrypoint = static_cast<const uint8_t *>(centroid_data_) +
+                               centroid_stride_ * cur_m;
+      float cur_expanded_dist = dc.dist(ctx->query(), entrypoint);
+
+      if (cur_expanded_dist < best_dist) {
+        best_medoid = entrypoints_[cur_m];
+        best_dist = cur_expanded_dist;
+      }
     }
   }
 
@@ -851,192 +1020,244 @@ int DiskAnnIndexer::cached_beam_search(DiskAnnContext *ctx) {
 
   uint32_t num_ios = 0;
 
-  // Cap beam width so one batch of frontier reads never exceeds the sector
-  // buffer capacity (kMaxSectorReadNum sectors), as each node occupies
-  // sector_num_per_node sectors.
-  uint32_t max_beam_width =
+  // Reads are pipelined: a slot of the sector buffer is refilled as soon as
+  // its read completes, keeping up to beam_width reads in flight. The width
+  // starts at the configured beam_width_, grows up to kMaxBeamWidthGrowth
+  // times that while the search waits on the device and shrinks while most
+  // reads land outside the candidate list.
+  const uint32_t slot_count =
       std::max(1u, static_cast<uint32_t>(DiskAnnUtil::kMaxSectorReadNum /
                                          sector_num_per_node));
-  uint32_t effective_beam_width = std::min(
-      std::max(8u, std::min(ctx->list_size() / 5, 32u)), max_beam_width);
-
-  std::vector<diskann_id_t> frontier;
-  frontier.reserve(2 * effective_beam_width);
-
-  std::vector<std::pair<diskann_id_t, uint8_t *>> frontier_neighbors;
-  frontier_neighbors.reserve(2 * effective_beam_width);
+  uint32_t beam_width = std::min(beam_width_, slot_count);
+  const uint32_t max_beam_width =
+      std::min(beam_width * kMaxBeamWidthGrowth, slot_count);
 
-  std::vector<AlignedRead> frontier_read_reqs;
-  frontier_read_reqs.reserve(2 * effective_beam_width);
-
-  std::vector<std::tuple<diskann_id_t, uint32_t, diskann_id_t *>>
-      cached_neighbors;
-  cached_neighbors.reserve(2 * effective_beam_width);
+  std::vector<uint32_t> free_slots(slot_count);
+  for (uint32_t i = 0; i < slot_count; ++i) {
+    free_slots[i] = slot_count - 1 - i;
+  }
+  auto slot_sector = [&](uint32_t slot) {
+    return sector_buffer +
+           sector_num_per_node * slot * DiskAnnUtil::kSectorSize;
+  };
 
-  PendingBatch pending;
+  // Request index of the pending batch -> (candidate, slot)
+  std::vector<std::pair<Neighbor, uint32_t>> requests;
+  requests.reserve(2 * max_beam_width);
 
-  while (candidates.has_unexpanded_node() && num_ios < io_limit_) {
-    frontier.clear();
-    frontier_neighbors.clear();
-    frontier_read_reqs.clear();
-    cached_neighbors.clear();
+  std::vector<AlignedRead> read_reqs;
+  read_reqs.reserve(max_beam_width);
+
+  // Score the unvisited neighbors by PQ and push them into candidates, a
+  // label restricted search only walks the subgraph of its label
+  std::vector<diskann_id_t> label_neighbors;
+  std::vector<float> distances;
+  auto push_neighbors = [&](uint32_t neighbor_num,
+                            const diskann_id_t *node_neighbors) {
+    if (query_label != kInvalidLabel) {
+      label_neighbors.clear();
+      for (uint32_t m = 0; m < neighbor_num; ++m) {
+        if (label_matched(ctx, node_neighbors[m])) {
+          label_neighbors.push_back(node_neighbors[m]);
+        }
+      }
+      neighbor_num = static_cast<uint32_t>(label_neighbors.size());
+      node_neighbors = label_neighbors.data();
+    }
 
-    uint64_t sector_buffer_idx = 0;
+    cpu_timer.reset();
+    distances.resize(neighbor_num);
+    pq_table_->compute_dists(neighbor_num, node_neighbors, pq_chunk_num_,
+                             ctx->pq_table_dist_buffer(),
+                             ctx->pq_coord_buffer(), distances.data());
 
-    uint32_t num_seen = 0;
-    while (candidates.has_unexpanded_node() &&
-           frontier.size() < effective_beam_width &&
-           num_seen < effective_beam_width) {
-      auto neighbor = candidates.closest_unexpanded();
-      num_seen++;
+    stats.dist_num += neighbor_num;
+    stats.cpu_us += cpu_timer.micro_seconds();
 
-      auto iter = neighbor_cache_.find(neighbor.id);
-      if (iter != neighbor_cache_.end()) {
-        cached_neighbors.push_back(std::make_tuple(
-            neighbor.id, iter->second.first, iter->second.second));
-        stats.cache_hits++;
-      } else {
-        frontier.push_back(neighbor.id);
+    cpu_timer.reset();
+    for (uint32_t m = 0; m < neighbor_num; ++m) {
+      diskann_id_t id = node_neighbors[m];
+      if (!visit_filter.visited(id)) {
+        visit_filter.set_visited(id);
+        stats.dist_num++;
+        Neighbor nn(id, distances[m]);
+        candidates.insert(nn);
       }
     }
 
-    if (!frontier.empty()) {
-      stats.hop_num++;
-
-      for (uint64_t i = 0; i < frontier.size(); i++) {
-        diskann_id_t cur_id = frontier[i];
-
-        std::pair<diskann_id_t, uint8_t *> frontier_neighbor;
-        frontier_neighbor.first = cur_id;
-        frontier_neighbor.second = sector_buffer + sector_num_per_node *
-                                                       sector_buffer_idx *
-                                                       DiskAnnUtil::kSectorSize;
-        frontier_neighbors.push_back(frontier_neighbor);
+    stats.cpu_us += cpu_timer.micro_seconds();
+  };
 
-        sector_buffer_idx++;
+  // Score a node image and push its unvisited neighbors into candidates
+  auto expand_node = [&](diskann_id_t node_id, uint8_t *sector) {
+    uint8_t *node_disk_buf = DiskAnnUtil::offset_to_node(
+        node_per_sector_, max_node_size_, sector, node_id);
+    uint32_t *node_buf = DiskAnnUtil::offset_to_node_neighbor(
+        node_disk_buf, meta_.element_size());
+    uint32_t neighbor_num = *node_buf;
 
-        frontier_read_reqs.emplace_back(
-            index_segment_offset_ +
-                DiskAnnUtil::get_node_sector(node_per_sector_, max_node_size_,
-                                             DiskAnnUtil::kSectorSize, cur_id) *
-                    DiskAnnUtil::kSectorSize,
-            sector_num_per_node * DiskAnnUtil::kSectorSize,
-            frontier_neighbor.second);
+    void *node_fp_coords = node_disk_buf;
 
-        stats.disk_page_reads++;
-        stats.io_num++;
-        num_ios++;
-      }
+    float cur_expanded_dist = dc.dist(ctx->query(), node_fp_coords);
 
-      io_timer.reset();
-      int submit_ret = reader_->submit(pending, frontier_read_reqs, io_ctx);
-      stats.io_us += io_timer.micro_seconds();
-      if (submit_ret != 0) {
-        LOG_ERROR("cached_beam_search: submit failed, ret=%d", submit_ret);
-        ctx->set_error(true);
-        return IndexError_Runtime;
-      }
+    if (accepted(ctx, node_id)) {
+      topk_heap.emplace(node_id, VectorInfo(cur_expanded_dist,
+                                            make_vector_copy(node_fp_coords)));
     }
 
-    for (auto &cached_neighbor : cached_neighbors) {
-      auto global_cache_iter = coord_cache_.find(std::get<0>(cached_neighbor));
-      void *node_fp_coords_copy = global_cache_iter->second;
+    push_neighbors(neighbor_num,
+                   reinterpret_cast<const diskann_id_t *>(node_buf + 1));
+  };
 
-      float cur_expanded_dist = dc.dist(ctx->query(), node_fp_coords_copy);
+  // Expand a node whose adjacency list is held by the static cache
+  auto expand_cached_neighbors = [&](diskann_id_t node_id) {
+    auto iter = neighbor_cache_.find(node_id);
+    void *node_fp_coords_copy = coord_cache_.find(node_id)->second;
 
-      if (!ctx->filter().is_valid() ||
-          !ctx->filter()(get_key(std::get<0>(cached_neighbor)))) {
-        topk_heap.emplace(std::get<0>(cached_neighbor),
-                          VectorInfo(cur_expanded_dist,
-                                     make_vector_copy(node_fp_coords_copy)));
-      }
+    float cur_expanded_dist = dc.dist(ctx->query(), node_fp_coords_copy);
 
-      uint32_t neighbor_num = std::get<1>(cached_neighbor);
-      diskann_id_t *node_neighbors = std::get<2>(cached_neighbor);
-
-      cpu_timer.reset();
+    if (accepted(ctx, node_id)) {
+      topk_heap.emplace(node_id,
+                        VectorInfo(cur_expanded_dist,
+                                   make_vector_copy(node_fp_coords_copy)));
+    }
 
-      std::vector<float> distances(neighbor_num);
-      pq_table_->compute_dists(neighbor_num, node_neighbors, pq_chunk_num_,
-                               ctx->pq_table_dist_buffer(),
-                               ctx->pq_coord_buffer(), distances.data());
+    push_neighbors(iter->second.first, iter->second.second);
+  };
 
-      stats.dist_num += neighbor_num;
-      stats.cpu_us += cpu_timer.micro_seconds();
+  ailego::ElapsedTime window_timer;
+  PendingBatch pending;
+  std::vector<uint32_t> completed;
+  uint32_t inflight = 0;
+  uint32_t window_reads = 0;
+  uint32_t window_wasted = 0;
+  float window_io_us = 0.0f;
+  float window_cpu_us = 0.0f;
+
+  while (true) {
+    // Top up the reads in flight with the closest unexpanded candidates,
+    // nodes found in memory are expanded right away
+    read_reqs.clear();
+    window_timer.reset();
+    while (candidates.has_unexpanded_node() && num_ios < io_limit_ &&
+           inflight + read_reqs.size() < beam_width && !free_slots.empty()) {
+      Neighbor neighbor = candidates.closest_unexpanded();
+      diskann_id_t cur_id = neighbor.id;
+
+      if (neighbor_cache_.find(cur_id) != neighbor_cache_.end()) {
+        stats.cache_hits++;
+        expand_cached_neighbors(cur_id);
+        continue;
+      }
 
-      for (uint64_t m = 0; m < neighbor_num; ++m) {
-        diskann_id_t id = node_neighbors[m];
-        if (!visit_filter.visited(id)) {
-          visit_filter.set_visited(id);
-          Neighbor nn(id, distances[m]);
-          candidates.insert(nn);
-        }
+      uint32_t slot = free_slots.back();
+      uint8_t *sector = slot_sector(slot);
+
+      // Nodes held by the adaptive cache are expanded without any I/O
+      if (node_cache_ &&
+          node_cache_->fetch(cur_id,
+                             DiskAnnUtil::offset_to_node(
+                                 node_per_sector_, max_node_size_, sector,
+                                 cur_id))) {
+        stats.node_cache_hits++;
+        stats.saved_ios++;
+        expand_node(cur_id, sector);
+        continue;
       }
+
+      free_slots.pop_back();
+      requests.emplace_back(neighbor, slot);
+      read_reqs.emplace_back(
+          index_segment_offset_ +
+              DiskAnnUtil::get_node_sector(node_per_sector_, max_node_size_,
+                                           DiskAnnUtil::kSectorSize, cur_id) *
+                  DiskAnnUtil::kSectorSize,
+          sector_num_per_node * DiskAnnUtil::kSectorSize, sector);
+
+      stats.disk_page_reads++;
+      stats.io_num++;
+      num_ios++;
     }
+    window_cpu_us += window_timer.micro_seconds();
 
-    if (!frontier.empty()) {
-      std::vector<uint32_t> completed;
-      while (pending.n_reaped < pending.n_submitted) {
-        completed.clear();
-        io_timer.reset();
-        int n = reader_->get_completed(pending, io_ctx, 1, completed);
-        stats.io_us += io_timer.micro_seconds();
-        if (n < 0) {
-          LOG_ERROR("cached_beam_search: get_completed failed, ret=%d", n);
-          ctx->set_error(true);
-          return IndexError_Runtime;
-        }
+    if (!read_reqs.empty()) {
+      stats.hop_num++;
 
-        for (uint32_t idx : completed) {
-          auto &frontier_neighbor = frontier_neighbors[idx];
-          uint8_t *node_disk_buf = DiskAnnUtil::offset_to_node(
-              node_per_sector_, max_node_size_, frontier_neighbor.second,
-              frontier_neighbor.first);
-          uint32_t *node_buf = DiskAnnUtil::offset_to_node_neighbor(
-              node_disk_buf, meta_.element_size());
-          uint32_t neighbor_num = *node_buf;
+      io_timer.reset();
+      int append_ret = reader_->append(pending, read_reqs, io_ctx);
+      float append_us = io_timer.micro_seconds();
+      stats.io_us += append_us;
+      window_io_us += append_us;
+      if (append_ret != 0) {
+        LOG_ERROR("cached_beam_search: append failed, ret=%d", append_ret);
+        ctx->set_error(true);
+        return IndexError_Runtime;
+      }
+      inflight += static_cast<uint32_t>(read_reqs.size());
+      stats.max_inflight_ios =
+          std::max<uint64_t>(stats.max_inflight_ios, inflight);
+    }
 
-          void *node_fp_coords = node_disk_buf;
+    if (inflight == 0) {
+      break;
+    }
 
-          float cur_expanded_dist = dc.dist(ctx->query(), node_fp_coords);
+    io_timer.reset();
+    int n = reader_->get_completed(pending, io_ctx, 1, completed);
+    float wait_us = io_timer.micro_seconds();
+    stats.io_us += wait_us;
+    stats.io_wait_us += wait_us;
+    window_io_us += wait_us;
+    if (n < 0) {
+      LOG_ERROR("cached_beam_search: get_completed failed, ret=%d", n);
+      ctx->set_error(true);
+      return IndexError_Runtime;
+    }
 
-          if (!ctx->filter().is_valid() ||
-              !ctx->filter()(get_key(frontier_neighbor.first))) {
-            topk_heap.emplace(frontier_neighbor.first,
-                              VectorInfo(cur_expanded_dist,
-                                         make_vector_copy(node_fp_coords)));
-          }
+    window_timer.reset();
+    for (uint32_t idx : completed) {
+      diskann_id_t node_id = requests[idx].first.id;
+      uint32_t slot = requests[idx].second;
+      uint8_t *sector = slot_sector(slot);
+      if (node_cache_) {
+        node_cache_->access(node_id,
+                            DiskAnnUtil::offset_to_node(
+                                node_per_sector_, max_node_size_, sector,
+                                node_id));
+      }
 
-          diskann_id_t *node_neighbors =
-              reinterpret_cast<diskann_id_t *>(node_buf + 1);
-
-          cpu_timer.reset();
-          std::vector<float> distances(neighbor_num);
-          pq_table_->compute_dists(neighbor_num, node_neighbors, pq_chunk_num_,
-                                   ctx->pq_table_dist_buffer(),
-                                   ctx->pq_coord_buffer(), distances.data());
-
-          stats.dist_num += neighbor_num;
-          stats.cpu_us += cpu_timer.micro_seconds();
-
-          cpu_timer.reset();
-          for (uint64_t m = 0; m < neighbor_num; ++m) {
-            diskann_id_t id = node_neighbors[m];
-            if (!visit_filter.visited(id)) {
-              visit_filter.set_visited(id);
-              stats.dist_num++;
-              Neighbor nn(id, distances[m]);
-              candidates.insert(nn);
-            }
-          }
+      // A read is wasted if its node fell out of the candidate list while
+      // it was in flight
+      if (candidates.size() == candidates.capacity() &&
+          candidates[candidates.size() - 1].distance <
+              requests[idx].first.distance) {
+        window_wasted++;
+      }
 
-          stats.cpu_us += cpu_timer.micro_seconds();
-        }
+      expand_node(node_id, sector);
+      free_slots.push_back(slot);
+      inflight--;
+      window_reads++;
+    }
+    window_cpu_us += window_timer.micro_seconds();
+
+    // Adapt the width once per beam of completions
+    if (window_reads >= beam_width) {
+      if (window_wasted * 2 > window_reads) {
+        beam_width = std::max(1u, beam_width / 2);
+      } else if (window_io_us > window_cpu_us) {
+        beam_width = std::min(max_beam_width, beam_width * 2);
       }
+      window_reads = 0;
+      window_wasted = 0;
+      window_io_us = 0.0f;
+      window_cpu_us = 0.0f;
     }
   }
+  stats.beam_width = beam_width;
 
   stats.total_us += query_timer.micro_seconds();
+  ctx->query_stats().merge(stats);
 
   return 0;
 }
@@ -1152,40 +1373,64 @@ int DiskAnnIndexer::cached_beam_search_by_group(DiskAnnContext *ctx) {
       if (!frontier.empty()) {
         stats.hop_num++;
 
+        size_t read_num = 0;
         for (uint64_t i = 0; i < frontier.size(); i++) {
           diskann_id_t cur_id = frontier[i];
 
-          std::pair<diskann_id_t, uint8_t *> frontier_neighbor;
-          frontier_neighbor.first = cur_id;
-          frontier_neighbor.second =
-              sector_buffer + sector_num_per_node * sector_buffer_idx *
-                                  DiskAnnUtil::kSectorSize;
-          frontier_neighbors.push_back(frontier_neighbor);
-
+          uint8_t *sector = sector_buffer + sector_num_per_node *
+                                                sector_buffer_idx *
+                                                DiskAnnUtil::kSectorSize;
           sector_buffer_idx++;
 
+          if (node_cache_ &&
+              node_cache_->fetch(cur_id,
+                                 DiskAnnUtil::offset_to_node(
+                                     node_per_sector_, max_node_size_, sector,
+                                     cur_id))) {
+            frontier_neighbors.emplace_back(cur_id, sector);
+            stats.node_cache_hits++;
+            stats.saved_ios++;
+            continue;
+          }
+
+          // Nodes read from disk go in front of the adaptive cache hits
+          frontier_neighbors.emplace_back(cur_id, sector);
+          std::swap(frontier_neighbors[read_num], frontier_neighbors.back());
+          read_num++;
+
           frontier_read_reqs.emplace_back(
               index_segment_offset_ + DiskAnnUtil::get_node_sector(
                                           node_per_sector_, max_node_size_,
                                           DiskAnnUtil::kSectorSize, cur_id) *
                                           DiskAnnUtil::kSectorSize,
-              sector_num_per_node * DiskAnnUtil::kSectorSize,
-              frontier_neighbor.second);
+              sector_num_per_node * DiskAnnUtil::kSectorSize, sector);
 
           stats.disk_page_reads++;
           stats.io_num++;
           num_ios++;
         }
 
-        io_timer.reset();
+        if (!frontier_read_reqs.empty()) {
+          io_timer.reset();
+
+          int read_ret = reader_->read(frontier_read_reqs, io_ctx);
+          stats.io_us += io_timer.micro_seconds();
+          if (read_ret != 0) {
+            LOG_ERROR(
+                "cached_beam_search_by_group: reader_->read failed, ret=%d",
+                read_ret);
+            ctx->set_error(true);
+            return IndexError_Runtime;
+          }
+        }
 
-        int read_ret = reader_->read(frontier_read_reqs, io_ctx);
-        stats.io_us += io_timer.micro_seconds();
-        if (read_ret != 0) {
-          LOG_ERROR("cached_beam_search_by_group: reader_->read failed, ret=%d",
-                    read_ret);
-          ctx->set_error(true);
-          return IndexError_Runtime;
+        for (size_t i = 0; node_cache_ && i < read_num; ++i) {
+          auto &frontier_neighbor = frontier_neighbors[i];
+          node_cache_->access(
+              frontier_neighbor.first,
+              DiskAnnUtil::offset_to_node(node_per_sector_, max_node_size_,
+                                          frontier_neighbor.second,
+                                          frontier_neighbor.first));
         }
       }
 
@@ -1196,8 +1441,7 @@ int DiskAnnIndexer::cached_beam_search_by_group(DiskAnnContext *ctx) {
 
         float cur_expanded_dist = dc.dist(ctx->query(), node_fp_coords_copy);
 
-        if (!ctx->filter().is_valid() ||
-            !ctx->filter()(get_key(std::get<0>(cached_neighbor)))) {
+        if (accepted(ctx, std::get<0>(cached_neighbor))) {
           std::string group_id =
               ctx->group_by()(get_key(std::get<0>(cached_neighbor)));
 
@@ -1231,6 +1475,9 @@ int DiskAnnIndexer::cached_beam_search_by_group(DiskAnnContext *ctx) {
 
         for (uint64_t m = 0; m < neighbor_num; ++m) {
           diskann_id_t id = node_neighbors[m];
+          if (!label_matched(ctx, id)) {
+            continue;
+          }
           visit_filter.set_visited(id);
 
           Neighbor nn(id, distances[m]);
@@ -1251,8 +1498,7 @@ int DiskAnnIndexer::cached_beam_search_by_group(DiskAnnContext *ctx) {
 
         float cur_expanded_dist = dc.dist(ctx->query(), data_buf);
 
-        if (!ctx->filter().is_valid() ||
-            !ctx->filter()(get_key(frontier_neighbor.first))) {
+        if (accepted(ctx, frontier_neighbor.first)) {
           std::string group_id =
               ctx->group_by()(get_key(frontier_neighbor.first));
 
@@ -1285,6 +1531,9 @@ int DiskAnnIndexer::cached_beam_search_by_group(DiskAnnContext *ctx) {
         cpu_timer.reset();
         for (uint64_t m = 0; m < neighbor_num; ++m) {
           diskann_id_t id = node_neighbors[m];
+          if (!label_matched(ctx, id)) {
+            continue;
+          }
           visit_filter.set_visited(id);
           stats.dist_num++;
 
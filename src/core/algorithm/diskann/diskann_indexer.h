@@ -13,10 +13,12 @@
 // limitations under the License.
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <zvec/core/framework/index_framework.h>
 #include "diskann_context.h"
 #include "diskann_file_reader.h"
+#include "diskann_node_cache.h"
 #include "diskann_pq_table.h"
 #include "diskann_searcher_entity.h"
 #include "diskann_util.h"
@@ -34,11 +36,28 @@ class DiskAnnIndexer {
 
  public:
   int init(DiskAnnSearcherEntity &entity);
+
+  //! Set the reads a beam search keeps in flight, applied by init()
+  void set_beam_width(uint32_t beam_width) {
+    beam_width_ = beam_width;
+  }
+
   int load_cache_list(const std::vector<diskann_id_t> &node_list);
 
   void cache_bfs_levels(uint64_t num_nodes_to_cache,
                         std::vector<diskann_id_t> &node_list);
 
+  //! Create the adaptive node cache, warmed up by a persisted hot set
+  int init_node_cache(size_t memory_size, const std::string &hot_set_path);
+
+  //! Persist the ids held by the adaptive node cache, hottest first
+  int save_node_cache(const std::string &hot_set_path) const;
+
+  //! Retrieve the adaptive node cache
+  const DiskAnnNodeCache *node_cache(void) const {
+    return node_cache_.get();
+  }
+
   int cached_beam_search(DiskAnnContext *ctx);
   int cached_beam_search_by_group(DiskAnnContext *ctx);
 
@@ -54,6 +73,26 @@ class DiskAnnIndexer {
   diskann_key_t get_key(diskann_id_t id) const;
   diskann_id_t get_id(diskann_key_t key) const;
 
+  //! Tombstone a node, returns false if it is absent or deleted already
+  bool mark_deleted(diskann_id_t id);
+
+  //! Test if a node is tombstoned
+  bool is_deleted(diskann_id_t id) const {
+    return deleted_count_.load(std::memory_order_relaxed) != 0 &&
+           deleted_[id].load(std::memory_order_relaxed) != 0;
+  }
+
+  //! Retrieve count of tombstoned nodes
+  size_t deleted_count(void) const {
+    return deleted_count_.load(std::memory_order_relaxed);
+  }
+
+  //! Dump the tombstones as a bitmap segment
+  int dump_tombstones(const IndexDumper::Pointer &dumper) const;
+
+  //! Restore the tombstones of the bitmap segment of storage, if any
+  int load_tombstones(const IndexStorage::Pointer &storage);
+
   //! Copy element_size() bytes from src into a new vector value string
   std::string make_vector_copy(const void *src) const {
     return std::string(static_cast<const char *>(src), meta_.element_size());
@@ -68,7 +107,25 @@ class DiskAnnIndexer {
   int use_medroids_data_as_centroids();
   void populate_group_topk_heaps(DiskAnnContext *ctx);
 
+  //! Test if node id carries the label a search of ctx is restricted to
+  bool label_matched(DiskAnnContext *ctx, diskann_id_t id) const {
+    return ctx->query_label() == kInvalidLabel ||
+           (labels_ != nullptr && labels_[id] == ctx->query_label());
+  }
+
+  //! Test if node id may be returned by a search of ctx
+  bool accepted(DiskAnnContext *ctx, diskann_id_t id) const {
+    return !is_deleted(id) && label_matched(ctx, id) &&
+           (!ctx->filter().is_valid() || !ctx->filter()(get_key(id)));
+  }
+
  private:
+  //! Magic of the persisted hot set file
+  static constexpr uint32_t kHotSetMagic = 0x53484e44u;
+
+  //! How far a pipelined search may widen its beam past beam_width_
+  static constexpr uint32_t kMaxBeamWidthGrowth = 4u;
+
   DiskAnnSearcherEntity *entity_;
 
   IndexStorage::Pointer storage_{};
@@ -89,6 +146,9 @@ class DiskAnnIndexer {
   diskann_id_t medoid_;
   std::vector<diskann_id_t> entrypoints_;
 
+  //! Graph labels of the nodes, nullptr if the index is unlabeled
+  const diskann_label_t *labels_{nullptr};
+
   std::shared_ptr<LinuxAlignedFileReader> reader_{nullptr};
 
   PQTable::Pointer pq_table_;
@@ -101,10 +161,16 @@ class DiskAnnIndexer {
   std::map<diskann_id_t, void *> coord_cache_;
   std::map<diskann_id_t, std::pair<uint32_t, diskann_id_t *>> neighbor_cache_;
 
+  DiskAnnNodeCache::Pointer node_cache_{};
+
   uint32_t beam_width_{2};
   uint32_t io_limit_{std::numeric_limits<uint32_t>::max()};
 
   uint64_t doc_cnt_{0};
+
+  //! Tombstones of deleted nodes, still walked through by searches
+  std::vector<std::atomic<uint8_t>> deleted_{};
+  std::atomic<size_t> deleted_count_{0};
 };
 
 }  // namespace core
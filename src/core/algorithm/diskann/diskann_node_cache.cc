@@ -0,0 +1,220 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "diskann_node_cache.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <zvec/ailego/buffer/block_eviction_queue.h>
+
+namespace zvec {
+namespace core {
+
+DiskAnnFrequencySketch::DiskAnnFrequencySketch(size_t capacity) {
+  size_t width = 64u;
+  while (width < capacity * 4u) {
+    width <<= 1;
+  }
+  mask_ = width - 1;
+  sample_size_ = std::max<size_t>(capacity, 64u) * 10u;
+  counters_ = std::vector<std::atomic<uint8_t>>(width);
+}
+
+size_t DiskAnnFrequencySketch::index(diskann_id_t id, uint32_t row) const {
+  static constexpr uint64_t kSeeds[kRowCount] = {
+      0xC3A5C85C97CB3127ull, 0xB492B66FBE98F273ull, 0x9AE16A3B2F90404Full,
+      0xCBF29CE484222325ull};
+  uint64_t hash = (static_cast<uint64_t>(id) + 1u) * kSeeds[row];
+  hash ^= hash >> 32;
+  return static_cast<size_t>(hash) & mask_;
+}
+
+void DiskAnnFrequencySketch::increment(diskann_id_t id) {
+  for (uint32_t row = 0; row < kRowCount; ++row) {
+    auto &counter = counters_[index(id, row)];
+    if (counter.load(std::memory_order_relaxed) < kMaxCount) {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if (additions_.fetch_add(1, std::memory_order_relaxed) % sample_size_ ==
+      sample_size_ - 1) {
+    age();
+  }
+}
+
+uint32_t DiskAnnFrequencySketch::estimate(diskann_id_t id) const {
+  uint32_t count = kMaxCount;
+  for (uint32_t row = 0; row < kRowCount; ++row) {
+    count = std::min<uint32_t>(
+        count, counters_[index(id, row)].load(std::memory_order_relaxed));
+  }
+  return count;
+}
+
+void DiskAnnFrequencySketch::age(void) {
+  // Racing increments may be lost, which only makes the estimate fuzzier
+  for (auto &counter : counters_) {
+    counter.store(counter.load(std::memory_order_relaxed) >> 1,
+                  std::memory_order_relaxed);
+  }
+}
+
+DiskAnnNodeCache::DiskAnnNodeCache(size_t node_size, size_t capacity)
+    : node_size_(node_size), capacity_(capacity), sketch_(capacity) {
+  uint32_t shard_capacity =
+      static_cast<uint32_t>((capacity + kShardCount - 1) / kShardCount);
+  for (auto &s : shards_) {
+    s.capacity = shard_capacity;
+    s.owners.reserve(shard_capacity);
+    s.referenced.reset(new std::atomic<uint8_t>[shard_capacity]);
+    for (uint32_t i = 0; i < shard_capacity; ++i) {
+      s.referenced[i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+DiskAnnNodeCache::~DiskAnnNodeCache(void) {
+  for (auto &s : shards_) {
+    for (char *chunk : s.chunks) {
+      ailego_free(chunk);
+    }
+  }
+  size_t allocated = allocated_size_.load();
+  if (allocated != 0) {
+    ailego::MemoryLimitPool::get_instance().release_external(allocated);
+  }
+}
+
+bool DiskAnnNodeCache::fetch(diskann_id_t id, void *dst) {
+  Shard &s = shard(id);
+  {
+    std::shared_lock<std::shared_mutex> lock(s.mutex);
+    auto it = s.slots.find(id);
+    if (it != s.slots.end()) {
+      std::memcpy(dst, slot_data(s, it->second), node_size_);
+      s.referenced[it->second].store(1, std::memory_order_relaxed);
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      sketch_.increment(id);
+      return true;
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void DiskAnnNodeCache::access(diskann_id_t id, const void *node) {
+  sketch_.increment(id);
+
+  // Admission is best effort, searches never wait for a busy shard
+  Shard &s = shard(id);
+  std::unique_lock<std::shared_mutex> lock(s.mutex, std::try_to_lock);
+  if (lock.owns_lock()) {
+    place(s, id, node, false);
+  }
+}
+
+bool DiskAnnNodeCache::insert(diskann_id_t id, const void *node) {
+  Shard &s = shard(id);
+  std::unique_lock<std::shared_mutex> lock(s.mutex);
+  return place(s, id, node, true);
+}
+
+bool DiskAnnNodeCache::place(Shard &s, diskann_id_t id, const void *node,
+                             bool force) {
+  if (s.slots.find(id) != s.slots.end()) {
+    return true;
+  }
+
+  uint32_t used = static_cast<uint32_t>(s.owners.size());
+  if (used < s.capacity) {
+    bool has_room = used < s.chunks.size() * kChunkSlotCount;
+    if (!has_room) {
+      auto &pool = ailego::MemoryLimitPool::get_instance();
+      if (pool.pool_size() == 0 || !pool.is_full()) {
+        size_t chunk_size =
+            std::min(kChunkSlotCount, s.capacity - used) * node_size_;
+        char *chunk = static_cast<char *>(ailego_malloc(chunk_size));
+        if (chunk) {
+          pool.charge_external(chunk_size);
+          allocated_size_.fetch_add(chunk_size);
+          s.chunks.push_back(chunk);
+          has_room = true;
+        }
+      }
+    }
+    if (has_room) {
+      s.owners.push_back(id);
+      std::memcpy(slot_data(s, used), node, node_size_);
+      s.referenced[used].store(0, std::memory_order_relaxed);
+      s.slots.emplace(id, used);
+      return true;
+    }
+  }
+  if (used == 0) {
+    return false;
+  }
+
+  // CLOCK sweep for a victim which was not referenced since the last pass
+  uint32_t victim = s.hand % used;
+  for (uint32_t n = 0; n < 2 * used; ++n) {
+    uint32_t cur = s.hand % used;
+    s.hand = cur + 1;
+    if (s.referenced[cur].exchange(0, std::memory_order_relaxed) == 0) {
+      victim = cur;
+      break;
+    }
+  }
+  if (!force && sketch_.estimate(id) <= sketch_.estimate(s.owners[victim])) {
+    return false;
+  }
+
+  s.slots.erase(s.owners[victim]);
+  s.owners[victim] = id;
+  std::memcpy(slot_data(s, victim), node, node_size_);
+  s.slots.emplace(id, victim);
+  return true;
+}
+
+void DiskAnnNodeCache::hot_set(std::vector<diskann_id_t> *ids) const {
+  std::vector<std::pair<uint32_t, diskann_id_t>> hot;
+  for (auto &s : shards_) {
+    std::shared_lock<std::shared_mutex> lock(s.mutex);
+    for (diskann_id_t id : s.owners) {
+      hot.emplace_back(sketch_.estimate(id), id);
+    }
+  }
+  std::sort(hot.begin(), hot.end(),
+            [](const std::pair<uint32_t, diskann_id_t> &lhs,
+               const std::pair<uint32_t, diskann_id_t> &rhs) {
+              return lhs.first > rhs.first;
+            });
+
+  ids->clear();
+  ids->reserve(hot.size());
+  for (const auto &it : hot) {
+    ids->push_back(it.second);
+  }
+}
+
+size_t DiskAnnNodeCache::size(void) const {
+  size_t count = 0;
+  for (auto &s : shards_) {
+    std::shared_lock<std::shared_mutex> lock(s.mutex);
+    count += s.owners.size();
+  }
+  return count;
+}
+
+}  // namespace core
+}  // namespace zvec
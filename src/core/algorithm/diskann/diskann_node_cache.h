@@ -0,0 +1,152 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include "diskann_entity.h"
+
+namespace zvec {
+namespace core {
+
+/*! DiskAnn Frequency Sketch
+ *  Count-min sketch of 4-bit saturating counters, halved every sample
+ *  period so the estimates follow the recent access distribution.
+ */
+class DiskAnnFrequencySketch {
+ public:
+  //! Constructor
+  explicit DiskAnnFrequencySketch(size_t capacity);
+
+  //! Record an access of id
+  void increment(diskann_id_t id);
+
+  //! Estimate the recent access count of id
+  uint32_t estimate(diskann_id_t id) const;
+
+ private:
+  //! Calculate counter index of id in row
+  size_t index(diskann_id_t id, uint32_t row) const;
+
+  //! Halve all counters
+  void age(void);
+
+  //! Constants
+  static constexpr uint32_t kRowCount = 4u;
+  static constexpr uint8_t kMaxCount = 15u;
+
+  //! Members
+  size_t mask_{0};
+  size_t sample_size_{0};
+  std::vector<std::atomic<uint8_t>> counters_{};
+  std::atomic<size_t> additions_{0};
+};
+
+/*! DiskAnn Node Cache
+ *  Adaptive cache of on-disk node images (vector, neighbor count and ids)
+ *  fed by the nodes beam searches read. Admission follows TinyLFU: a node
+ *  replaces the CLOCK victim only if it is estimated to be accessed more
+ *  often. Slots are allocated in chunks charged to the MemoryLimitPool and
+ *  growth stops once the pool is full.
+ */
+class DiskAnnNodeCache {
+ public:
+  typedef std::shared_ptr<DiskAnnNodeCache> Pointer;
+
+  //! Constructor
+  DiskAnnNodeCache(size_t node_size, size_t capacity);
+
+  //! Destructor
+  ~DiskAnnNodeCache(void);
+
+  DiskAnnNodeCache(const DiskAnnNodeCache &) = delete;
+  DiskAnnNodeCache &operator=(const DiskAnnNodeCache &) = delete;
+
+  //! Copy the node image of id into dst, returns false on miss
+  bool fetch(diskann_id_t id, void *dst);
+
+  //! Record a node read from disk, admitting it if it is hot enough
+  void access(diskann_id_t id, const void *node);
+
+  //! Insert a node regardless of its frequency, used to warm up
+  bool insert(diskann_id_t id, const void *node);
+
+  //! Retrieve the cached ids, hottest first
+  void hot_set(std::vector<diskann_id_t> *ids) const;
+
+  //! Retrieve count of cached nodes
+  size_t size(void) const;
+
+  //! Retrieve the maximum count of cached nodes
+  size_t capacity(void) const {
+    return capacity_;
+  }
+
+  //! Retrieve count of hits
+  uint64_t hit_count(void) const {
+    return hits_.load(std::memory_order_relaxed);
+  }
+
+  //! Retrieve count of misses
+  uint64_t miss_count(void) const {
+    return misses_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /*! Cache Shard
+   */
+  struct Shard {
+    mutable std::shared_mutex mutex{};
+    std::unordered_map<diskann_id_t, uint32_t> slots{};
+    std::vector<diskann_id_t> owners{};
+    std::unique_ptr<std::atomic<uint8_t>[]> referenced{};
+    std::vector<char *> chunks{};
+    uint32_t capacity{0};
+    uint32_t hand{0};
+  };
+
+  //! Retrieve shard of id
+  Shard &shard(diskann_id_t id) {
+    return shards_[(id * 0x9E3779B1u) >> (32 - kShardBits)];
+  }
+
+  //! Retrieve the image buffer of slot
+  char *slot_data(const Shard &s, uint32_t slot) const {
+    return s.chunks[slot / kChunkSlotCount] +
+           static_cast<size_t>(slot % kChunkSlotCount) * node_size_;
+  }
+
+  //! Place node into shard, evicting the victim if admitted
+  bool place(Shard &s, diskann_id_t id, const void *node, bool force);
+
+  //! Constants
+  static constexpr uint32_t kShardBits = 4u;
+  static constexpr uint32_t kShardCount = 1u << kShardBits;
+  static constexpr uint32_t kChunkSlotCount = 256u;
+
+  //! Members
+  size_t node_size_{0};
+  size_t capacity_{0};
+  std::atomic<size_t> allocated_size_{0};
+  Shard shards_[kShardCount];
+  DiskAnnFrequencySketch sketch_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace core
+}  // namespace zvec
@@ -36,11 +36,32 @@ static const std::string PARAM_DISKANN_BUILDER_TRAIN_SAMPLE_RATIO(
     "zvec.diskann.builder.train_sample_ratio");
 static const std::string PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM(
     "zvec.diskann.builder.max_pq_chunk_num");
+static const std::string PARAM_DISKANN_BUILDER_SHARD_COUNT(
+    "zvec.diskann.builder.shard_count");
+static const std::string PARAM_DISKANN_BUILDER_SHARD_REPLICA_COUNT(
+    "zvec.diskann.builder.shard_replica_count");
 
 static const std::string PARAM_DISKANN_SEARCHER_LIST_SIZE(
     "zvec.diskann.searcher.list_size");
+static const std::string PARAM_DISKANN_SEARCHER_BEAM_WIDTH(
+    "zvec.diskann.searcher.beam_width");
 static const std::string PARAM_DISKANN_SEARCHER_CACHE_NODE_NUM(
     "zvec.diskann.searcher.cache_node_num");
+static const std::string PARAM_DISKANN_SEARCHER_CACHE_MEMORY_SIZE(
+    "zvec.diskann.searcher.cache_memory_size");
+static const std::string PARAM_DISKANN_SEARCHER_CACHE_HOT_SET_PATH(
+    "zvec.diskann.searcher.cache_hot_set_path");
+static const std::string PARAM_DISKANN_SEARCHER_QUERY_LABEL(
+    "zvec.diskann.searcher.query_label");
+
+static const std::string PARAM_DISKANN_STREAMER_DELTA_MAX_DEGREE(
+    "zvec.diskann.streamer.delta_max_degree");
+static const std::string PARAM_DISKANN_STREAMER_DELTA_LIST_SIZE(
+    "zvec.diskann.streamer.delta_list_size");
+static const std::string PARAM_DISKANN_STREAMER_DELTA_ALPHA(
+    "zvec.diskann.streamer.delta_alpha");
+static const std::string PARAM_DISKANN_STREAMER_CONSOLIDATE_RATIO(
+    "zvec.diskann.streamer.consolidate_ratio");
 
 static const std::string PARAM_DISKANN_REDUCER_INDEX_NAME(
     "zvec.diskann.reducer.index_name");
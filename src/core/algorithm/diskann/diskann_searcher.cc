@@ -47,11 +47,17 @@ int DiskAnnSearcher::init(const ailego::Params &search_params) {
 
   params_ = search_params;
   list_size_ = 200;
+  beam_size_ = 2;
   cache_nodes_num_ = 0;
   log_diskann_io_backend();
 
   params_.get(PARAM_DISKANN_SEARCHER_LIST_SIZE, &list_size_);
+  params_.get(PARAM_DISKANN_SEARCHER_BEAM_WIDTH, &beam_size_);
   params_.get(PARAM_DISKANN_SEARCHER_CACHE_NODE_NUM, &cache_nodes_num_);
+  cache_memory_size_ = 0;
+  cache_hot_set_path_.clear();
+  params_.get(PARAM_DISKANN_SEARCHER_CACHE_MEMORY_SIZE, &cache_memory_size_);
+  params_.get(PARAM_DISKANN_SEARCHER_CACHE_HOT_SET_PATH, &cache_hot_set_path_);
   state_ = STATE_INITED;
   return 0;
 }
@@ -64,6 +70,7 @@ int DiskAnnSearcher::cleanup() {
   unload();
   params_.clear();
   list_size_ = 200;
+  beam_size_ = 2;
   cache_nodes_num_ = 0;
   state_ = STATE_INIT;
 
@@ -106,6 +113,7 @@ int DiskAnnSearcher::load(IndexStorage::Pointer storage,
   }
 
   diskann_indexer_ = std::make_shared<DiskAnnIndexer>(meta_);
+  diskann_indexer_->set_beam_width(beam_size_);
 
   int res = diskann_indexer_->init(entity_);
   if (res != 0) {
@@ -127,6 +135,12 @@ int DiskAnnSearcher::load(IndexStorage::Pointer storage,
     node_list.shrink_to_fit();
   }
 
+  ret = diskann_indexer_->init_node_cache(cache_memory_size_,
+                                          cache_hot_set_path_);
+  if (ret != 0) {
+    return ret;
+  }
+
   if (measure) {
     measure_ = measure;
   } else {
@@ -160,6 +174,9 @@ int DiskAnnSearcher::unload() {
   LOG_INFO("DiskAnnSearcher unload index");
 
   const State next_state = state_ == STATE_INIT ? STATE_INIT : STATE_INITED;
+  if (diskann_indexer_) {
+    diskann_indexer_->save_node_cache(cache_hot_set_path_);
+  }
   diskann_indexer_.reset();
   entity_.clear();
   measure_.reset();
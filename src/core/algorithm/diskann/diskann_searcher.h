@@ -151,6 +151,8 @@ class DiskAnnSearcher : public IndexSearcher {
 
   uint32_t list_size_{200};
   uint32_t cache_nodes_num_{0};
+  uint64_t cache_memory_size_{0};
+  std::string cache_hot_set_path_{};
 
   bool warm_up_{false};
   uint32_t beam_size_{2};
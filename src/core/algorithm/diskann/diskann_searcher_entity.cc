@@ -30,6 +30,8 @@ void DiskAnnSearcherEntity::clear() {
   key_buffer_.clear();
   key_mapping_buffer_.clear();
   entrypoints_.clear();
+  labels_.clear();
+  label_medoids_.clear();
   meta_.clear();
   meta_header_ = {};
   pq_meta_ = {};
@@ -132,6 +134,13 @@ int DiskAnnSearcherEntity::load(const IndexMeta &meta,
     return ret;
   }
 
+  ret = load_label_segment();
+  if (ret != 0) {
+    LOG_ERROR("Load Label Segment Failed, ret = %d", ret);
+
+    return ret;
+  }
+
   ret = load_vector_segment();
   if (ret != 0) {
     LOG_ERROR("Load Vector Segment Failed, ret = %d", ret);
@@ -459,5 +468,55 @@ std::pair<uint32_t, const diskann_id_t *> DiskAnnSearcherEntity::get_neighbors(
   return std::make_pair(neighbor_num, node_neighbor + 1);
 }
 
+int DiskAnnSearcherEntity::load_label_segment() {
+  // Indexes built without labels have no label segment
+  auto segment = storage_->get(kDiskAnnLabelSegmentId);
+  if (!segment) {
+    return 0;
+  }
+
+  const void *data = nullptr;
+  size_t header_len = 2 * sizeof(uint32_t);
+  if (segment->read(0, &data, header_len) != header_len) {
+    LOG_ERROR("Read segment %s failed", kDiskAnnLabelSegmentId.c_str());
+    return IndexError_ReadData;
+  }
+  uint32_t label_cnt = 0;
+  memcpy(&label_cnt, data, sizeof(uint32_t));
+
+  size_t medoids_len = label_cnt * 2 * sizeof(uint32_t);
+  size_t labels_len = doc_cnt() * sizeof(diskann_label_t);
+  if (segment->data_size() != header_len + medoids_len + labels_len) {
+    LOG_ERROR("Invalid segment %s size %zu",
+              kDiskAnnLabelSegmentId.c_str(), segment->data_size());
+    return IndexError_InvalidFormat;
+  }
+
+  if (medoids_len > 0) {
+    if (segment->read(header_len, &data, medoids_len) != medoids_len) {
+      LOG_ERROR("Read segment %s failed", kDiskAnnLabelSegmentId.c_str());
+      return IndexError_ReadData;
+    }
+    const uint32_t *pairs = static_cast<const uint32_t *>(data);
+    for (uint32_t i = 0; i < label_cnt; ++i) {
+      label_medoids_[pairs[2 * i]] = pairs[2 * i + 1];
+    }
+  }
+
+  if (labels_len > 0) {
+    if (segment->read(header_len + medoids_len, &data, labels_len) !=
+        labels_len) {
+      LOG_ERROR("Read segment %s failed", kDiskAnnLabelSegmentId.c_str());
+      return IndexError_ReadData;
+    }
+    labels_.resize(doc_cnt());
+    memcpy(labels_.data(), data, labels_len);
+  }
+
+  LOG_INFO("Loaded %u graph labels", label_cnt);
+
+  return 0;
+}
+
 }  // namespace core
 }  // namespace zvec
@@ -13,6 +13,7 @@
 // limitations under the License.
 #pragma once
 
+#include <map>
 #include <zvec/ailego/parallel/thread_pool.h>
 #include <zvec/core/framework/index_holder.h>
 #include "diskann_entity.h"
@@ -42,6 +43,7 @@ class DiskAnnSearcherEntity : public DiskAnnEntity {
   int load_key_segment();
   int load_key_mapping_segment();
   int load_entrypoint_segment();
+  int load_label_segment();
 
   PQTable::Pointer get_pq_table() {
     return pq_table_;
@@ -66,6 +68,25 @@ class DiskAnnSearcherEntity : public DiskAnnEntity {
   diskann_key_t get_key(diskann_id_t id) const override;
   const void *get_vector(diskann_id_t id) const override;
 
+  diskann_label_t get_label(diskann_id_t id) const override {
+    return labels_.empty() ? kInvalidLabel : labels_[id];
+  }
+
+  diskann_id_t get_label_medoid(diskann_label_t label) const override {
+    auto it = label_medoids_.find(label);
+    return it == label_medoids_.end() ? kInvalidId : it->second;
+  }
+
+  //! Retrieve the labels of every node, empty if the index is unlabeled
+  const std::vector<diskann_label_t> &labels(void) const {
+    return labels_;
+  }
+
+  //! Retrieve the entry points of every label
+  const std::map<diskann_label_t, diskann_id_t> &label_medoids(void) const {
+    return label_medoids_;
+  }
+
  private:
   DiskAnnSearcherEntity(
       const DiskAnnMetaHeader &meta_header, const DiskAnnPqMeta &pq_meta,
@@ -120,6 +141,10 @@ class DiskAnnSearcherEntity : public DiskAnnEntity {
   std::string key_buffer_;
   std::string key_mapping_buffer_;
   std::vector<diskann_id_t> entrypoints_;
+
+  //! Labels are served by the indexer, clones leave them out
+  std::vector<diskann_label_t> labels_;
+  std::map<diskann_label_t, diskann_id_t> label_medoids_;
 };
 
 }  // namespace core
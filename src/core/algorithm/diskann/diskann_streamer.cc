@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "diskann_streamer.h"
+#include <zvec/ailego/io/file.h>
+#include "diskann_builder.h"
 #include "diskann_context.h"
 #include "diskann_index_provider.h"
 #include "diskann_indexer.h"
@@ -50,12 +52,39 @@ int DiskAnnStreamer::init(const IndexMeta &meta,
   meta_ = meta;
   params_ = search_params;
   list_size_ = 200;
+  beam_size_ = 2;
   cache_nodes_num_ = 0;
 
   log_diskann_io_backend();
 
   params_.get(PARAM_DISKANN_SEARCHER_LIST_SIZE, &list_size_);
+  params_.get(PARAM_DISKANN_SEARCHER_BEAM_WIDTH, &beam_size_);
   params_.get(PARAM_DISKANN_SEARCHER_CACHE_NODE_NUM, &cache_nodes_num_);
+  cache_memory_size_ = 0;
+  cache_hot_set_path_.clear();
+  params_.get(PARAM_DISKANN_SEARCHER_CACHE_MEMORY_SIZE, &cache_memory_size_);
+  params_.get(PARAM_DISKANN_SEARCHER_CACHE_HOT_SET_PATH, &cache_hot_set_path_);
+
+  delta_max_degree_ = 0;
+  delta_list_size_ = DiskAnnDeltaIndex::kDefaultListSize;
+  delta_alpha_ = DiskAnnDeltaIndex::kDefaultAlpha;
+  params_.get(PARAM_DISKANN_STREAMER_DELTA_MAX_DEGREE, &delta_max_degree_);
+  params_.get(PARAM_DISKANN_STREAMER_DELTA_LIST_SIZE, &delta_list_size_);
+  params_.get(PARAM_DISKANN_STREAMER_DELTA_ALPHA, &delta_alpha_);
+  if (delta_list_size_ == 0 || delta_alpha_ < 1.0f) {
+    LOG_ERROR("Invalid delta graph params, list_size=%u alpha=%f",
+              delta_list_size_, delta_alpha_);
+    return IndexError_InvalidArgument;
+  }
+
+  consolidate_ratio_ = kDefaultConsolidateRatio;
+  params_.get(PARAM_DISKANN_STREAMER_CONSOLIDATE_RATIO, &consolidate_ratio_);
+  if (!(consolidate_ratio_ >= 0.0f)) {
+    LOG_ERROR("Invalid %s: %f",
+              PARAM_DISKANN_STREAMER_CONSOLIDATE_RATIO.c_str(),
+              consolidate_ratio_);
+    return IndexError_InvalidArgument;
+  }
   state_ = STATE_INITED;
   return 0;
 }
@@ -68,6 +97,7 @@ int DiskAnnStreamer::cleanup() {
   unload();
   params_.clear();
   list_size_ = 200;
+  beam_size_ = 2;
   cache_nodes_num_ = 0;
   state_ = STATE_INIT;
 
@@ -88,16 +118,52 @@ int DiskAnnStreamer::open(IndexStorage::Pointer storage) {
     return IndexError_NoReady;
   }
 
+  release_index();
+  storage_ = storage;
+
+  int ret = load_index(storage);
+  if (ret != 0) {
+    return ret;
+  }
+
+  ret = load_delta();
+  if (ret != 0) {
+    LOG_ERROR("Load the persisted delta failed, ret=%d", ret);
+    return ret;
+  }
+  state_ = STATE_LOADED;
+
+  LOG_INFO("DiskAnnStreamer::load Done");
+
+  return 0;
+}
+
+int DiskAnnStreamer::unload() {
+  LOG_INFO("DiskAnnStreamer unload index");
+
+  const State next_state = state_ == STATE_INIT ? STATE_INIT : STATE_INITED;
   {
     std::lock_guard<std::mutex> lock(fetch_mutex_);
-    fetch_ctx_.reset();
-    fetch_vector_buffer_.clear();
-    diskann_indexer_.reset();
-    entity_.clear();
-    measure_.reset();
-    stats_.clear();
+    if (diskann_indexer_) {
+      diskann_indexer_->save_node_cache(cache_hot_set_path_);
+    }
   }
+  release_index();
+  meta_.clear();
+  storage_.reset();
+
+  state_ = next_state;
+
+  return 0;
+}
+
+int DiskAnnStreamer::close(void) {
+  int ret = state_ == STATE_LOADED ? flush(0) : 0;
+  unload();
+  return ret;
+}
 
+int DiskAnnStreamer::load_index(IndexStorage::Pointer storage) {
   auto start_time = ailego::Monotime::MilliSeconds();
 
   int ret = IndexHelper::DeserializeFromStorage(storage.get(), &meta_);
@@ -113,6 +179,7 @@ int DiskAnnStreamer::open(IndexStorage::Pointer storage) {
   }
 
   diskann_indexer_ = std::make_shared<DiskAnnIndexer>(meta_);
+  diskann_indexer_->set_beam_width(beam_size_);
 
   int res = diskann_indexer_->init(entity_);
   if (res != 0) {
@@ -134,6 +201,12 @@ int DiskAnnStreamer::open(IndexStorage::Pointer storage) {
     node_list.shrink_to_fit();
   }
 
+  ret = diskann_indexer_->init_node_cache(cache_memory_size_,
+                                          cache_hot_set_path_);
+  if (ret != 0) {
+    return ret;
+  }
+
   measure_ = IndexFactory::CreateMetric(meta_.metric_name());
   if (!measure_) {
     LOG_ERROR("CreateMetric failed, name: %s", meta_.metric_name().c_str());
@@ -144,25 +217,29 @@ int DiskAnnStreamer::open(IndexStorage::Pointer storage) {
     LOG_ERROR("IndexMetric init failed, ret=%d", ret);
     return ret;
   }
+
+  uint32_t delta_max_degree =
+      delta_max_degree_ != 0 ? delta_max_degree_ : entity_.max_degree();
+  ret = delta_.init(meta_, measure_, delta_max_degree, delta_list_size_,
+                    delta_alpha_);
+  if (ret != 0) {
+    LOG_ERROR("Init delta graph failed, ret=%d", ret);
+    return ret;
+  }
+
   if (measure_->query_metric()) {
     measure_ = measure_->query_metric();
   }
 
   stats_.set_loaded_costtime(ailego::Monotime::MilliSeconds() - start_time);
   stats_.set_loaded_count(entity_.doc_cnt());
-  state_ = STATE_LOADED;
 
   magic_ = IndexContext::GenerateMagic();
 
-  LOG_INFO("DiskAnnStreamer::load Done");
-
   return 0;
 }
 
-int DiskAnnStreamer::unload() {
-  LOG_INFO("DiskAnnStreamer unload index");
-
-  const State next_state = state_ == STATE_INIT ? STATE_INIT : STATE_INITED;
+void DiskAnnStreamer::release_index(void) {
   {
     std::lock_guard<std::mutex> lock(fetch_mutex_);
     fetch_ctx_.reset();
@@ -170,12 +247,80 @@ int DiskAnnStreamer::unload() {
     diskann_indexer_.reset();
     entity_.clear();
     measure_.reset();
-    meta_.clear();
     stats_.clear();
   }
+  delta_.clear();
+}
+
+int DiskAnnStreamer::load_delta(void) {
+  const std::string path = delta_path();
+  if (path.empty() || !ailego::File::IsExist(path)) {
+    return 0;
+  }
 
-  state_ = next_state;
+  auto storage = IndexFactory::CreateStorage("FileReadStorage");
+  if (!storage) {
+    LOG_ERROR("Create storage FileReadStorage failed");
+    return IndexError_NoExist;
+  }
+  int ret = storage->open(path, false);
+  if (ret != 0) {
+    LOG_ERROR("Open delta file %s failed, ret=%d", path.c_str(), ret);
+    return ret;
+  }
+
+  ret = delta_.load(storage);
+  if (ret == 0) {
+    ret = diskann_indexer_->load_tombstones(storage);
+  }
+  storage->close();
+  return ret;
+}
+
+int DiskAnnStreamer::flush(uint64_t check_point) {
+  LOG_INFO("DiskAnnStreamer flush checkpoint=%zu", (size_t)check_point);
+
+  if (state_ != STATE_LOADED) {
+    LOG_ERROR("Open DiskAnnStreamer before flushing");
+    return IndexError_NoReady;
+  }
+  const std::string path = delta_path();
+  if (path.empty()) {
+    LOG_WARN("Storage has no file, the delta graph is not persisted");
+    return 0;
+  }
+  if (delta_.slot_count() == 0 && diskann_indexer_->deleted_count() == 0) {
+    if (ailego::File::IsExist(path)) {
+      ailego::File::Delete(path);
+    }
+    return 0;
+  }
 
+  // Write aside and rename, so a crash keeps the previous checkpoint
+  const std::string tmp_path = path + ".tmp";
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  if (!dumper) {
+    LOG_ERROR("Create dumper FileDumper failed");
+    return IndexError_NoExist;
+  }
+  int ret = dumper->create(tmp_path);
+  if (ret == 0) {
+    ret = delta_.dump(dumper);
+    if (ret == 0) {
+      ret = diskann_indexer_->dump_tombstones(dumper);
+    }
+    int close_ret = dumper->close();
+    ret = ret != 0 ? ret : close_ret;
+  }
+  if (ret != 0) {
+    LOG_ERROR("Dump delta file %s failed, ret=%d", tmp_path.c_str(), ret);
+    ailego::File::Delete(tmp_path);
+    return ret;
+  }
+  if (!ailego::File::Rename(tmp_path, path)) {
+    LOG_ERROR("Rename %s to %s failed", tmp_path.c_str(), path.c_str());
+    return IndexError_WriteData;
+  }
   return 0;
 }
 
@@ -212,6 +357,210 @@ int DiskAnnStreamer::ensure_compatible_context(ContextPointer &context,
   return 0;
 }
 
+int DiskAnnStreamer::add_impl(uint64_t key, const void *query,
+                              const IndexQueryMeta &qmeta,
+                              Context::Pointer &context) {
+  if (ailego_unlikely(state_ != STATE_LOADED)) {
+    LOG_ERROR("Open DiskAnnStreamer before adding vectors");
+    return IndexError_NoReady;
+  }
+  if (ailego_unlikely(!query)) {
+    LOG_ERROR("Invalid vector to add");
+    return IndexError_InvalidArgument;
+  }
+  if (ailego_unlikely(!query_meta_matches(meta_, qmeta))) {
+    LOG_ERROR("Query meta does not match DiskAnn index meta");
+    return IndexError_Mismatch;
+  }
+
+  // A key deleted from the on-disk graph stays tombstoned there and is
+  // served by the delta graph from now on
+  diskann_id_t id = diskann_indexer_->get_id(key);
+  if (id != kInvalidId && !diskann_indexer_->is_deleted(id)) {
+    LOG_ERROR("Key %lu already exists in DiskAnn index", (unsigned long)key);
+    return IndexError_Duplicate;
+  }
+
+  // The query label of the context labels the vector, unset leaves it
+  // unlabeled so only unrestricted searches return it
+  auto *ctx = dynamic_cast<DiskAnnContext *>(context.get());
+  diskann_label_t label = ctx ? ctx->query_label() : kInvalidLabel;
+
+  int ret = delta_.add(key, query, label);
+  if (ret != 0) {
+    return ret;
+  }
+  (*stats_.mutable_added_count())++;
+  return 0;
+}
+
+int DiskAnnStreamer::remove_impl(uint64_t key, Context::Pointer & /*context*/) {
+  if (ailego_unlikely(state_ != STATE_LOADED)) {
+    LOG_ERROR("Open DiskAnnStreamer before removing vectors");
+    return IndexError_NoReady;
+  }
+
+  if (delta_.remove(key) == 0) {
+    (*stats_.mutable_deleted_count())++;
+    return 0;
+  }
+
+  diskann_id_t id = diskann_indexer_->get_id(key);
+  if (id == kInvalidId || !diskann_indexer_->mark_deleted(id)) {
+    LOG_WARN("Key %lu does not exist in DiskAnn index", (unsigned long)key);
+    return IndexError_NoExist;
+  }
+  (*stats_.mutable_deleted_count())++;
+  return 0;
+}
+
+int DiskAnnStreamer::optimize_impl(IndexThreads::Pointer threads) {
+  if (ailego_unlikely(state_ != STATE_LOADED)) {
+    LOG_ERROR("Open DiskAnnStreamer before optimizing");
+    return IndexError_NoReady;
+  }
+
+  size_t disk_cnt = entity_.doc_cnt();
+  size_t disk_deleted = diskann_indexer_->deleted_count();
+  size_t delta_cnt = delta_.count();
+  LOG_INFO("DiskAnnStreamer optimize, delta=%zu disk_tombstones=%zu",
+           delta_cnt, disk_deleted);
+
+  // Tombstoned on-disk nodes keep routing searches and the sector segments
+  // are read only, so past the ratio a new graph replaces the old one
+  size_t changed = delta_cnt + disk_deleted;
+  if (changed != 0 && disk_cnt - disk_deleted + delta_cnt != 0 &&
+      !storage_->file_path().empty() &&
+      changed >= consolidate_ratio_ * disk_cnt) {
+    return rebuild(std::move(threads));
+  }
+  return delta_.consolidate();
+}
+
+int DiskAnnStreamer::rebuild(IndexThreads::Pointer threads) {
+  auto start_time = ailego::Monotime::MilliSeconds();
+
+  // Live on-disk vectors followed by the delta, with their graph labels
+  auto holder = std::make_shared<RandomAccessIndexHolder>(meta_);
+  std::unordered_map<diskann_key_t, diskann_label_t> labels;
+  for (diskann_id_t id = 0; id < entity_.doc_cnt(); ++id) {
+    if (diskann_indexer_->is_deleted(id)) {
+      continue;
+    }
+    diskann_key_t key = entity_.get_key(id);
+    const void *vec = entity_.get_vector(id);
+    if (!vec) {
+      LOG_ERROR("Read vector %u for the rebuild failed", id);
+      return IndexError_ReadData;
+    }
+    holder->emplace(key, vec);
+    diskann_label_t label = entity_.get_label(id);
+    if (label != kInvalidLabel) {
+      labels.emplace(key, label);
+    }
+  }
+  std::string vec;
+  for (uint32_t id = 0, cnt = static_cast<uint32_t>(delta_.slot_count());
+       id < cnt; ++id) {
+    diskann_label_t label = kInvalidLabel;
+    uint64_t key = delta_.get_slot(id, &vec, &label);
+    if (key == kInvalidKey) {
+      continue;
+    }
+    holder->emplace(key, vec.data());
+    if (label != kInvalidLabel) {
+      labels.emplace(key, label);
+    }
+  }
+
+  auto builder = std::make_shared<DiskAnnBuilder>();
+  int ret = builder->init(meta_, meta_.builder_params());
+  if (ret == 0 && !labels.empty()) {
+    ret = builder->set_labels(std::move(labels));
+  }
+  if (ret == 0) {
+    ret = builder->train(threads, holder);
+  }
+  if (ret == 0) {
+    ret = builder->build(threads, holder);
+  }
+  if (ret != 0) {
+    LOG_ERROR("Rebuild DiskAnn graph failed, ret=%d", ret);
+    return ret;
+  }
+
+  const std::string path = storage_->file_path();
+  const std::string tmp_path = path + ".tmp";
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  if (!dumper) {
+    LOG_ERROR("Create dumper FileDumper failed");
+    return IndexError_NoExist;
+  }
+  ret = dumper->create(tmp_path);
+  if (ret == 0) {
+    ret = builder->dump(dumper);
+    int close_ret = dumper->close();
+    ret = ret != 0 ? ret : close_ret;
+  }
+  if (ret != 0) {
+    LOG_ERROR("Dump rebuilt graph %s failed, ret=%d", tmp_path.c_str(), ret);
+    ailego::File::Delete(tmp_path);
+    return ret;
+  }
+  builder.reset();
+  holder.reset();
+
+  // The new graph holds the delta and none of the tombstones
+  if (!ailego::File::Rename(tmp_path, path)) {
+    LOG_ERROR("Rename %s to %s failed", tmp_path.c_str(), path.c_str());
+    return IndexError_WriteData;
+  }
+  const std::string stale_delta = delta_path();
+  if (ailego::File::IsExist(stale_delta)) {
+    ailego::File::Delete(stale_delta);
+  }
+
+  release_index();
+  storage_->close();
+  ret = storage_->open(path, false);
+  if (ret == 0) {
+    ret = load_index(storage_);
+  }
+  if (ret != 0) {
+    LOG_ERROR("Reopen rebuilt graph %s failed, ret=%d", path.c_str(), ret);
+    state_ = STATE_INITED;
+    return ret;
+  }
+
+  LOG_INFO("Rebuilt DiskAnn graph of %zu vectors, cost %zu ms",
+           (size_t)entity_.doc_cnt(),
+           (size_t)(ailego::Monotime::MilliSeconds() - start_time));
+  return 0;
+}
+
+void DiskAnnStreamer::merge_delta_result(
+    uint32_t idx, const std::vector<DiskAnnDeltaIndex::Document> &docs,
+    DiskAnnContext *ctx) const {
+  if (docs.empty()) {
+    return;
+  }
+
+  auto &result = *ctx->mutable_result(idx);
+  uint32_t disk_cnt = static_cast<uint32_t>(entity_.doc_cnt());
+  std::string vec;
+  for (const auto &doc : docs) {
+    if (ctx->fetch_vector() && delta_.get_vector_by_id(doc.id, &vec) == 0) {
+      result.emplace_back(doc.key, doc.score, disk_cnt + doc.id, vec);
+    } else {
+      result.emplace_back(doc.key, doc.score, disk_cnt + doc.id);
+    }
+  }
+  std::stable_sort(result.begin(), result.end());
+  if (result.size() > ctx->topk()) {
+    result.resize(ctx->topk());
+  }
+}
+
 int DiskAnnStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
                                  uint32_t count,
                                  Context::Pointer &context) const {
@@ -246,6 +595,7 @@ int DiskAnnStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
   ctx->clear();
   ctx->resize_results(count);
 
+  std::vector<DiskAnnDeltaIndex::Document> delta_docs;
   for (uint32_t i = 0; i < count; i++) {
     ctx->reset_query(query);
 
@@ -260,6 +610,12 @@ int DiskAnnStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
 
     ctx->topk_to_result(i);
 
+    if (delta_.count() != 0 && !ctx->group_by_search()) {
+      delta_.search(query, ctx->topk(), ctx->list_size(), ctx->query_label(),
+                    ctx->filter(), &delta_docs);
+      merge_delta_result(i, delta_docs, ctx);
+    }
+
     query = static_cast<const char *>(query) + qmeta.element_size();
   }
 
@@ -300,6 +656,7 @@ int DiskAnnStreamer::search_bf_impl(const void *query,
   ctx->clear();
   ctx->resize_results(count);
 
+  std::vector<DiskAnnDeltaIndex::Document> delta_docs;
   for (size_t i = 0; i < count; ++i) {
     ctx->reset_query(query);
 
@@ -310,6 +667,12 @@ int DiskAnnStreamer::search_bf_impl(const void *query,
 
     ctx->topk_to_result(i);
 
+    if (delta_.count() != 0 && !ctx->group_by_search()) {
+      delta_.linear_search(query, ctx->topk(), ctx->query_label(),
+                           ctx->filter(), &delta_docs);
+      merge_delta_result(i, delta_docs, ctx);
+    }
+
     query = static_cast<const char *>(query) + qmeta.element_size();
   }
 
@@ -360,6 +723,7 @@ int DiskAnnStreamer::search_bf_by_p_keys_impl(
   ctx->clear();
   ctx->resize_results(count);
 
+  std::vector<DiskAnnDeltaIndex::Document> delta_docs;
   for (size_t i = 0; i < count; ++i) {
     ctx->reset_query(query);
 
@@ -370,6 +734,12 @@ int DiskAnnStreamer::search_bf_by_p_keys_impl(
 
     ctx->topk_to_result(i);
 
+    if (delta_.count() != 0 && !ctx->group_by_search()) {
+      delta_.keys_search(query, p_keys[i], ctx->topk(), ctx->query_label(),
+                         ctx->filter(), &delta_docs);
+      merge_delta_result(i, delta_docs, ctx);
+    }
+
     query = static_cast<const char *>(query) + qmeta.element_size();
   }
 
@@ -401,8 +771,12 @@ int DiskAnnStreamer::get_vector(uint64_t key, Context::Pointer &context,
     return ret;
   }
 
+  if (delta_.get_vector(key, &vector) == 0) {
+    return 0;
+  }
+
   diskann_id_t id = diskann_indexer_->get_id(key);
-  if (id == kInvalidId) {
+  if (id == kInvalidId || diskann_indexer_->is_deleted(id)) {
     LOG_ERROR("Vector key does not exist: %lu", (unsigned long)key);
     return IndexError_NoExist;
   }
@@ -474,7 +848,7 @@ IndexSearcher::Provider::Pointer DiskAnnStreamer::create_provider(void) const {
     return nullptr;
   }
   return IndexProvider::Pointer(new (std::nothrow) DiskAnnIndexProvider(
-      meta_, entity, "DiskAnnStreamer"));
+      meta_, entity, "DiskAnnStreamer", diskann_indexer_.get(), &delta_));
 }
 
 IndexSearcher::Context::Pointer DiskAnnStreamer::create_context() const {
@@ -16,6 +16,7 @@
 #include <mutex>
 #include <zvec/core/framework/index_framework.h>
 #include "diskann_context.h"
+#include "diskann_delta_index.h"
 #include "diskann_indexer.h"
 
 class LinuxAlignedFileReader;
@@ -41,12 +42,26 @@ class DiskAnnStreamer : public IndexStreamer {
   //! Cleanup Searcher
   int cleanup(void) override;
 
-  //! Load Index from storage
+  //! Load Index from storage, with the delta graph and the tombstones
+  //! persisted next to it
   int open(IndexStorage::Pointer storage) override;
 
   //! Unload index from storage
   int unload(void) override;
 
+  //! Insert a vector into the in-memory delta graph, labeled with the
+  //! query label of context so labeled searches reach it
+  int add_impl(uint64_t key, const void *query, const IndexQueryMeta &qmeta,
+               ContextPointer &context) override;
+
+  //! Delete a vector, tombstoning it if it lives in the on-disk graph
+  int remove_impl(uint64_t key, ContextPointer &context) override;
+
+  //! Consolidate the deletes of the delta graph, or rebuild the on-disk
+  //! graph once the delta and the tombstones outgrow consolidate_ratio of
+  //! it. A rebuild swaps the index file and must not overlap other calls.
+  int optimize_impl(IndexThreads::Pointer threads) override;
+
   //! KNN Search
   int search_impl(const void *query, const IndexQueryMeta &qmeta,
                   ContextPointer &context) const override {
@@ -131,13 +146,11 @@ class DiskAnnStreamer : public IndexStreamer {
     return meta_;
   }
 
-  int flush(uint64_t /*check_point*/) override {
-    return 0;
-  }
+  //! Persist the delta graph and the tombstones next to the index file
+  int flush(uint64_t check_point) override;
 
-  int close(void) override {
-    return this->unload();
-  }
+  //! Flush and unload the index
+  int close(void) override;
 
   void print_debug_info() override;
 
@@ -153,7 +166,37 @@ class DiskAnnStreamer : public IndexStreamer {
   int ensure_compatible_context(ContextPointer &context,
                                 DiskAnnContext *&ctx) const;
 
+  //! Load the index of storage, the delta graph starts empty
+  int load_index(IndexStorage::Pointer storage);
+
+  //! Drop the loaded index
+  void release_index(void);
+
+  //! Restore the persisted delta graph and tombstones, if any
+  int load_delta(void);
+
+  //! Build a new on-disk graph of the live vectors and swap it in
+  int rebuild(IndexThreads::Pointer threads);
+
+  //! Retrieve path of the persisted delta, empty if storage has no file
+  std::string delta_path(void) const {
+    return storage_ && !storage_->file_path().empty()
+               ? storage_->file_path() + kDeltaFileSuffix
+               : std::string();
+  }
+
+  //! Merge the delta graph hits into result idx of ctx
+  void merge_delta_result(uint32_t idx,
+                          const std::vector<DiskAnnDeltaIndex::Document> &docs,
+                          DiskAnnContext *ctx) const;
+
  private:
+  //! Suffix of the file persisting the delta graph and the tombstones
+  static constexpr const char *kDeltaFileSuffix = ".delta";
+
+  //! Default share of the on-disk graph the delta may reach before rebuild
+  static constexpr float kDefaultConsolidateRatio = 0.2f;
+
   enum State { STATE_INIT = 0, STATE_INITED = 1, STATE_LOADED = 2 };
 
   IndexMetric::Pointer measure_{};
@@ -162,13 +205,25 @@ class DiskAnnStreamer : public IndexStreamer {
 
   uint32_t list_size_{200};
   uint32_t cache_nodes_num_{0};
+  uint64_t cache_memory_size_{0};
+  std::string cache_hot_set_path_{};
 
   bool warm_up_{false};
   uint32_t beam_size_{2};
 
+  uint32_t delta_max_degree_{0};
+  uint32_t delta_list_size_{DiskAnnDeltaIndex::kDefaultListSize};
+  float delta_alpha_{DiskAnnDeltaIndex::kDefaultAlpha};
+  float consolidate_ratio_{kDefaultConsolidateRatio};
+
+  IndexStorage::Pointer storage_{};
+
   DiskAnnIndexer::Pointer diskann_indexer_{nullptr};
   DiskAnnSearcherEntity entity_{};
 
+  // Vectors streamed in after the on-disk graph was built
+  DiskAnnDeltaIndex delta_{};
+
   // Fetches share the expensive I/O context, while returned MemoryBlocks own
   // independent copies so their lifetime does not depend on this buffer.
   mutable std::mutex fetch_mutex_;
@@ -192,6 +192,9 @@ void HnswAlgorithm<EntityType>::add_neighbors(node_id_t id, level_t level,
 //   fast_search_neighbors:       mmap/contiguous with direct vector pointers.
 //                                Uses BlockHeap (AVX2) or LinearPool (scalar)
 //                                for visited tracking and top-k maintenance.
+//   code_search_neighbors:       contiguous kNeighborCodes layout. Same pools,
+//                                but hops are scored from inline neighbor
+//                                codes and expanded nodes exactly.
 //   dual_heap_search_neighbors:  CandidateHeap + TopkHeap + VisitFilter.
 //                                Used for add_node (use_pool=false), filtered
 //                                search, upper levels, and BufferPool fallback.
@@ -270,6 +273,63 @@ void fast_search_neighbors(const EntityType &entity, HeapType &pool,
   }
 }
 
+// neighbor-codes variant: a hop reads the popped node's record only, and
+// scores its unvisited neighbors from the 4-bit PQ codes stored inline after
+// the neighbor list. The pool is ordered by estimated distances, while topk
+// takes the exact distance of every expanded node, computed from the vector
+// of the same record. The search ends once every retained node is expanded,
+// so the final pool is re-ranked exactly as a side effect.
+template <typename EntityType, typename HeapType>
+void code_search_neighbors(const EntityType &entity, HeapType &pool,
+                           VisitFilter &visit, HnswDistCalculator &dc,
+                           const float *lut, uint32_t topk, uint32_t ef,
+                           node_id_t entry_point, dist_t entry_dist,
+                           TopkHeap &topk_heap) {
+  const uint32_t max_deg = entity.max_degree(0);
+  const uint32_t cap = std::max(topk, ef);
+  const size_t code_size = entity.neighbor_code_size();
+  pool.reset(static_cast<int32_t>(cap), static_cast<int32_t>(max_deg));
+  visit.clear();
+
+  visit.set_visited(entry_point);
+  pool.push_block(&entry_dist, &entry_point, 1);
+
+  uint32_t buf_capacity = max_deg;
+  std::vector<node_id_t> neighbor_ids(buf_capacity);
+  std::vector<float> dists(buf_capacity);
+
+  while (pool.has_next()) {
+    node_id_t current_node = static_cast<node_id_t>(pool.pop());
+
+    const auto neighbors = entity.get_neighbors_typed(0, current_node);
+    const uint8_t *codes = entity.get_neighbor_codes_ptr(current_node);
+    ailego_prefetch(codes);
+    topk_heap.emplace(current_node,
+                      dc.dist(entity.get_vector_ptr(current_node)));
+
+    if (neighbors.size() > buf_capacity) {
+      buf_capacity = neighbors.size();
+      neighbor_ids.resize(buf_capacity);
+      dists.resize(buf_capacity);
+    }
+
+    uint32_t unvisited_count = 0;
+    for (uint32_t i = 0; i < neighbors.size(); ++i) {
+      node_id_t node = neighbors[i];
+      if (visit.visited(node)) continue;
+      visit.set_visited(node);
+      neighbor_ids[unvisited_count] = node;
+      dists[unvisited_count] =
+          entity.estimate_neighbor_code(lut, codes + i * code_size);
+      unvisited_count++;
+    }
+
+    if (unvisited_count == 0) continue;
+    pool.push_block(dists.data(), neighbor_ids.data(),
+                    static_cast<int32_t>(unvisited_count));
+  }
+}
+
 // ============================================================================
 // dual_heap_search_neighbors: shared core for the fallback dual-heap path.
 //
@@ -411,6 +471,7 @@ void dual_heap_search_neighbors(const EntityType &entity, level_t level,
 // - add_node / filtered / upper levels  →  dual_heap_search_neighbors
 // - level-0 unfiltered search:
 //     MmapMemoryBlock  →  fast_search_neighbors (BlockHeap/LinearPool)
+//     neighbor codes   →  code_search_neighbors (BlockHeap/LinearPool)
 //     BufferPool       →  dual_heap_search_neighbors (fallback)
 // ============================================================================
 template <typename EntityType>
@@ -454,6 +515,23 @@ void HnswAlgorithm<EntityType>::search_neighbors(level_t level,
 
       auto &visit = ctx->visit_filter();
 
+      if constexpr (std::is_same_v<EntityType, HnswContiguousStreamerEntity>) {
+        if (entity.has_neighbor_codes()) {
+          auto &lut = ctx->neighbor_code_lut();
+          entity.build_neighbor_code_lut(
+              static_cast<const float *>(dc.query()), &lut);
+          if (avx2_ok) {
+            code_search_neighbors(entity, ctx->block_pool(), visit, dc,
+                                  lut.data(), topk_v, ef_v, *entry_point,
+                                  *dist, topk);
+          } else {
+            code_search_neighbors(entity, ctx->pool(), visit, dc, lut.data(),
+                                  topk_v, ef_v, *entry_point, *dist, topk);
+          }
+          return;
+        }
+      }
+
       if (avx2_ok) {
         auto &bpool = ctx->block_pool();
         fast_search_neighbors(entity, bpool, visit, dc, topk_v, ef_v,
@@ -603,7 +681,9 @@ void HnswAlgorithm<EntityType>::update_neighbors(HnswDistCalculator &dc,
   uint32_t max_neighbor_cnt = entity_.neighbor_cnt(level);
   if (topk_heap.size() <= static_cast<size_t>(entity_.prune_cnt())) {
     if (topk_heap.size() <= static_cast<size_t>(max_neighbor_cnt)) {
+      write_lock(version_of(id));
       entity_.update_neighbors(level, id, topk_heap.container());
+      write_unlock(version_of(id));
       return;
     }
   }
@@ -653,7 +733,9 @@ void HnswAlgorithm<EntityType>::update_neighbors(HnswDistCalculator &dc,
   }
 
   topk_heap.truncate(cur_size);
+  write_lock(version_of(id));
   entity_.update_neighbors(level, id, topk_heap.container());
+  write_unlock(version_of(id));
 
   return;
 }
@@ -663,60 +745,106 @@ void HnswAlgorithm<EntityType>::reverse_update_neighbors(
     HnswDistCalculator &dc, node_id_t id, level_t level, node_id_t link_id,
     dist_t dist, TopkHeap &update_heap) {
   const size_t max_neighbor_cnt = entity_.neighbor_cnt(level);
+  std::atomic<uint32_t> &version = version_of(id);
+
+  // The first rounds snapshot and prune the list without holding the stripe,
+  // and publish only if no other writer got in between. Under contention the
+  // last round holds the stripe for the whole update.
+  for (uint32_t round = 0;; ++round) {
+    const bool optimistic = round < kOptimisticRetries;
+    uint32_t v = 0;
+    if (optimistic) {
+      v = read_begin(version);
+    } else {
+      write_lock(version);
+    }
 
-  uint32_t lock_idx = id & kLockMask;
-  lock_pool_[lock_idx].lock();
-  const Neighbors neighbors = entity_.get_neighbors(level, id);
-  size_t size = neighbors.size();
-  ailego_assert_with(size <= max_neighbor_cnt, "invalid neighbor size");
-  if (size < max_neighbor_cnt) {
-    entity_.add_neighbor(level, id, size, link_id);
-    lock_pool_[lock_idx].unlock();
-    return;
-  }
-
-  update_heap.emplace(link_id, dist);
+    const Neighbors neighbors = entity_.get_neighbors(level, id);
+    size_t size =
+        std::min(static_cast<size_t>(neighbors.size()), max_neighbor_cnt);
+    if (size < max_neighbor_cnt) {
+      if (optimistic && !try_write_lock(version, v)) {
+        continue;
+      }
+      entity_.add_neighbor(level, id, size, link_id);
+      write_unlock(version);
+      return;
+    }
 
-  for (size_t i = 0; i < size; ++i) {
-    node_id_t node = neighbors[i];
-    dist_t cur_dist = dc.dist(id, node);
-    update_heap.emplace(node, cur_dist);
-  }
+    // Copy the ids first: the snapshot is torn if a writer got in while it
+    // was read, and its ids must not be dereferenced before that is ruled
+    // out. They stay in list order after link_id; prune sorts them below.
+    update_heap.clear();
+    auto &candidates = update_heap.mutable_container();
+    candidates.emplace_back(link_id, dist);
+    for (size_t i = 0; i < size; ++i) {
+      candidates.emplace_back(neighbors[i], 0.0f);
+    }
+    if (optimistic && !read_validate(version, v)) {
+      continue;
+    }
+    for (size_t i = 1; i < candidates.size(); ++i) {
+      candidates[i].second = dc.dist(id, candidates[i].first);
+    }
+
+    //! TODO: optimize prune
+    //! prune edges
+    update_heap.sort();
+    size_t cur_size = 0;
+    for (size_t i = 0; i < update_heap.size(); ++i) {
+      node_id_t cur_node = update_heap[i].first;
+      dist_t cur_node_dist = update_heap[i].second;
+      bool good = true;
+      for (size_t j = 0; j < cur_size; ++j) {
+        dist_t tmp_dist = dc.dist(cur_node, update_heap[j].first);
+        if (tmp_dist <= cur_node_dist) {
+          good = false;
+          break;
+        }
+      }
 
-  //! TODO: optimize prune
-  //! prune edges
-  update_heap.sort();
-  size_t cur_size = 0;
-  for (size_t i = 0; i < update_heap.size(); ++i) {
-    node_id_t cur_node = update_heap[i].first;
-    dist_t cur_node_dist = update_heap[i].second;
-    bool good = true;
-    for (size_t j = 0; j < cur_size; ++j) {
-      dist_t tmp_dist = dc.dist(cur_node, update_heap[j].first);
-      if (tmp_dist <= cur_node_dist) {
-        good = false;
-        break;
+      if (good) {
+        update_heap.mutable_at(cur_size).first = cur_node;
+        update_heap.mutable_at(cur_size).second = cur_node_dist;
+        cur_size++;
+        if (cur_size >= max_neighbor_cnt) {
+          break;
+        }
       }
     }
 
-    if (good) {
-      update_heap.mutable_at(cur_size).first = cur_node;
-      update_heap.mutable_at(cur_size).second = cur_node_dist;
-      cur_size++;
-      if (cur_size >= max_neighbor_cnt) {
-        break;
-      }
+    update_heap.truncate(cur_size);
+    if (optimistic && !try_write_lock(version, v)) {
+      continue;
     }
-  }
+    entity_.update_neighbors(level, id, update_heap.container());
+    write_unlock(version);
 
-  update_heap.truncate(cur_size);
-  entity_.update_neighbors(level, id, update_heap.container());
+    update_heap.clear();
+    return;
+  }
+}
 
-  lock_pool_[lock_idx].unlock();
+template <typename EntityType>
+int HnswAlgorithm<EntityType>::prune_neighbors(node_id_t id, level_t level,
+                                               HnswContext *ctx) {
+  const Neighbors neighbors = entity_.get_neighbors(level, id);
+  size_t size = neighbors.size();
+  if (size <= static_cast<size_t>(entity_.prune_cnt())) {
+    return 0;
+  }
 
-  update_heap.clear();
+  HnswDistCalculator &dc = ctx->dist_calculator();
+  TopkHeap &heap = ctx->update_heap();
+  heap.clear();
+  for (size_t i = 0; i < size; ++i) {
+    node_id_t node = neighbors[i];
+    heap.emplace(node, dc.dist(id, node));
+  }
+  update_neighbors(dc, id, level, heap);
+  heap.clear();
 
-  return;
+  return 0;
 }
 
 // Explicit template instantiation
@@ -14,7 +14,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <vector>
 #include <ailego/internal/cpu_features.h>
 #include <ailego/parallel/lock.h>
@@ -35,6 +37,8 @@ class HnswAlgorithmBase {
 
   virtual int cleanup() = 0;
   virtual int add_node(node_id_t id, level_t level, HnswContext *ctx) = 0;
+  virtual int prune_neighbors(node_id_t id, level_t level,
+                              HnswContext *ctx) = 0;
   virtual int search(HnswContext *ctx) const = 0;
   virtual int init() = 0;
   virtual uint32_t get_random_level() const = 0;
@@ -50,7 +54,7 @@ class HnswAlgorithm : public HnswAlgorithmBase {
   explicit HnswAlgorithm(EntityType &entity)
       : entity_(entity),
         mt_(std::chrono::system_clock::now().time_since_epoch().count()),
-        lock_pool_(kLockCnt) {}
+        version_pool_(new std::atomic<uint32_t>[kLockCnt]()) {}
 
   //! Destructor
   ~HnswAlgorithm() override = default;
@@ -66,6 +70,11 @@ class HnswAlgorithm : public HnswAlgorithmBase {
   //! return 0 on success, or errCode in failure
   int add_node(node_id_t id, level_t level, HnswContext *ctx) override;
 
+  //! Re-prune the node's neighbors on level if they exceed the prune count,
+  //! for lists filled by reverse links without pruning. The caller must be
+  //! the only writer of the node's neighbors
+  int prune_neighbors(node_id_t id, level_t level, HnswContext *ctx) override;
+
   //! do knn search in graph
   //! return 0 on success, or errCode in failure. results saved in ctx
   int search(HnswContext *ctx) const override;
@@ -134,13 +143,54 @@ class HnswAlgorithm : public HnswAlgorithmBase {
   //! expand neighbors until group nums are reached
   void expand_neighbors_by_group(TopkHeap &topk, HnswContext *ctx) const;
 
+  //! Seqlock stripe guarding the neighbor lists of node id. An odd version
+  //! means a writer holds the stripe
+  std::atomic<uint32_t> &version_of(node_id_t id) {
+    return version_pool_[id & kLockMask];
+  }
+
+  //! Wait until no writer holds the stripe and return its version
+  static uint32_t read_begin(const std::atomic<uint32_t> &version) {
+    uint32_t v = version.load(std::memory_order_acquire);
+    while (v & 1U) {
+      ailego_yield();
+      v = version.load(std::memory_order_acquire);
+    }
+    return v;
+  }
+
+  //! Whether no writer got in since read_begin returned v, so the data read
+  //! in between is consistent
+  static bool read_validate(const std::atomic<uint32_t> &version,
+                            uint32_t v) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version.load(std::memory_order_relaxed) == v;
+  }
+
+  //! Acquire the stripe if it still has the version observed by read_begin
+  static bool try_write_lock(std::atomic<uint32_t> &version, uint32_t v) {
+    return version.compare_exchange_strong(v, v + 1U,
+                                           std::memory_order_acquire);
+  }
+
+  static void write_lock(std::atomic<uint32_t> &version) {
+    while (!try_write_lock(version, read_begin(version))) {
+    }
+  }
+
+  static void write_unlock(std::atomic<uint32_t> &version) {
+    version.fetch_add(1U, std::memory_order_release);
+  }
+
  private:
   HnswAlgorithm(const HnswAlgorithm &) = delete;
   HnswAlgorithm &operator=(const HnswAlgorithm &) = delete;
 
  private:
-  static constexpr uint32_t kLockCnt{1U << 8};
+  static constexpr uint32_t kLockCnt{1U << 16};
   static constexpr uint32_t kLockMask{kLockCnt - 1U};
+  //! Optimistic reverse updates before falling back to holding the stripe
+  static constexpr uint32_t kOptimisticRetries{4U};
 
   EntityType &entity_;
   mutable std::mt19937 mt_{};
@@ -148,8 +198,7 @@ class HnswAlgorithm : public HnswAlgorithmBase {
 
   mutable ailego::SpinMutex spin_lock_{};  // global spin lock
   std::mutex mutex_{};                     // global mutex
-  // TODO: spin lock?
-  std::vector<std::mutex> lock_pool_{};
+  std::unique_ptr<std::atomic<uint32_t>[]> version_pool_{};
 };
 
 }  // namespace core
@@ -410,6 +410,11 @@ class HnswContext : public IndexContext {
     dc_.set_provider(nullptr);
   }
 
+  //! Query lookup table for estimating inline neighbor codes
+  inline std::vector<float> &neighbor_code_lut() {
+    return neighbor_code_lut_;
+  }
+
   inline std::map<std::string, TopkHeap> &group_topk_heaps() {
     return group_topk_heaps_;
   }
@@ -601,6 +606,7 @@ class HnswContext : public IndexContext {
   uint32_t stats_get_vector_cnt_{0u};
   uint32_t stats_visit_dup_cnt_{0u};
   std::string preprocess_buffer_;
+  std::vector<float> neighbor_code_lut_{};
 
   LinearPool<dist_t> pool_;
   BlockHeap block_pool_;
@@ -231,6 +231,11 @@ class HnswDistCalculator {
     return dim_;
   }
 
+  //! Retrieve the current query vector
+  inline const void *query() const {
+    return query_;
+  }
+
   //! Bind a provider which supplies the original vectors, so vector
   //! fetches by node id go through it instead of the entity
   void set_provider(IndexProvider::Pointer provider) {
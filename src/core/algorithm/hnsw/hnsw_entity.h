@@ -678,6 +678,7 @@ class HnswEntity {
   constexpr static float kDefaultBFNegativeProbability = 0.001f;
   constexpr static uint32_t kDefaultScalingFactor = 50U;
   constexpr static uint32_t kDefaultBruteForceThreshold = 1000U;
+  constexpr static uint32_t kDefaultBuildSeedCount = 10000U;
   constexpr static uint32_t kDefaultDocsHardLimit = 1 << 30U;  // 1 billion
   constexpr static float kDefaultDocsSoftLimitRatio = 0.9f;
   constexpr static size_t kMaxChunkSize = 0xFFFFFFFF;
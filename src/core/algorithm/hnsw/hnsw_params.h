@@ -102,6 +102,10 @@ static const std::string PARAM_HNSW_STREAMER_ESTIMATE_DOC_COUNT(
     "proxima.hnsw.streamer.estimate_doc_count");
 static const std::string PARAM_HNSW_STREAMER_USE_ID_MAP(
     "proxima.hnsw.streamer.use_id_map");
+static const std::string PARAM_HNSW_STREAMER_BUILD_THREAD_COUNT(
+    "proxima.hnsw.streamer.build_thread_count");
+static const std::string PARAM_HNSW_STREAMER_BUILD_SEED_COUNT(
+    "proxima.hnsw.streamer.build_seed_count");
 
 static const std::string PARAM_HNSW_REDUCER_WORKING_PATH(
     "proxima.hnsw.reducer.working_path");
@@ -114,6 +118,8 @@ static const std::string PARAM_HNSW_REDUCER_EFCONSTRUCTION(
 
 static const std::string PARAM_HNSW_STREAMER_USE_CONTIGUOUS_MEMORY(
     "proxima.hnsw.streamer.use_contiguous_memory");
+static const std::string PARAM_HNSW_STREAMER_CONTIGUOUS_LAYOUT(
+    "proxima.hnsw.streamer.contiguous_layout");
 
 static const std::string PARAM_HNSW_STREAMER_USE_EXTERNAL_VECTOR(
     "proxima.hnsw.streamer.use_external_vector");
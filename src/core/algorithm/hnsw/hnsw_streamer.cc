@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "hnsw_streamer.h"
+#include <algorithm>
 #include <iostream>
+#include <thread>
 #include <ailego/internal/cpu_features.h>
 #include <ailego/pattern/defer.h>
 #include <ailego/utility/memory_helper.h>
@@ -72,7 +74,10 @@ int HnswStreamer::init(const IndexMeta &imeta, const ailego::Params &params) {
   params.get(PARAM_HNSW_STREAMER_USE_ID_MAP, &use_id_map_);
   params.get(PARAM_HNSW_STREAMER_USE_CONTIGUOUS_MEMORY,
              &use_contiguous_memory_);
+  params.get(PARAM_HNSW_STREAMER_CONTIGUOUS_LAYOUT, &contiguous_layout_);
   params.get(PARAM_HNSW_STREAMER_USE_EXTERNAL_VECTOR, &use_external_vector_);
+  params.get(PARAM_HNSW_STREAMER_BUILD_THREAD_COUNT, &build_thread_cnt_);
+  params.get(PARAM_HNSW_STREAMER_BUILD_SEED_COUNT, &build_seed_cnt_);
 
   params.get(PARAM_HNSW_STREAMER_DOCS_SOFT_LIMIT, &docs_soft_limit_);
   if (docs_soft_limit_ > 0 && docs_soft_limit_ > docs_hard_limit_) {
@@ -156,6 +161,21 @@ int HnswStreamer::init(const IndexMeta &imeta, const ailego::Params &params) {
               HnswEntity::kMaxChunkSize);
     return IndexError_InvalidArgument;
   }
+  if (contiguous_layout_ >
+      static_cast<uint32_t>(HnswContiguousLayout::kNeighborCodes)) {
+    LOG_ERROR("[%s] must be <= %u",
+              PARAM_HNSW_STREAMER_CONTIGUOUS_LAYOUT.c_str(),
+              static_cast<uint32_t>(HnswContiguousLayout::kNeighborCodes));
+    return IndexError_InvalidArgument;
+  }
+  if (build_thread_cnt_ == 0) {
+    build_thread_cnt_ = std::thread::hardware_concurrency();
+  }
+  if (build_thread_cnt_ > std::thread::hardware_concurrency()) {
+    LOG_WARN("[%s] greater than cpu cores %u",
+             PARAM_HNSW_STREAMER_BUILD_THREAD_COUNT.c_str(),
+             std::thread::hardware_concurrency());
+  }
 
   LOG_DEBUG(
       "Init params: maxIndexSize=%zu docsHardLimit=%zu docsSoftLimit=%zu "
@@ -395,6 +415,19 @@ int HnswStreamer::open(IndexStorage::Pointer stg) {
     case HnswStorageMode::kContiguous: {
       auto &contiguous_entity =
           static_cast<HnswContiguousStreamerEntity &>(*entity_);
+      contiguous_entity.set_contiguous_layout(
+          static_cast<HnswContiguousLayout>(contiguous_layout_));
+      // Neighbor codes are estimated in the raw fp32 space, so only metrics
+      // that decompose per dimension can use them
+      const IndexMetric::Measure measure = metric_->measure();
+      if (meta_.data_type() == IndexMeta::DataType::DT_FP32 &&
+          (measure == IndexMetric::Measure::kSquaredEuclidean ||
+           measure == IndexMetric::Measure::kInnerProduct)) {
+        contiguous_entity.set_neighbor_code_space(
+            meta_.dimension(), measure == IndexMetric::Measure::kInnerProduct);
+      } else {
+        contiguous_entity.set_neighbor_code_space(0, false);
+      }
       int build_ret = contiguous_entity.build_contiguous_memory();
       if (build_ret != 0) {
         LOG_ERROR("Failed to build contiguous memory, ret=%d", build_ret);
@@ -725,6 +758,170 @@ int HnswStreamer::add_impl(uint64_t pkey, const void *query,
   return 0;
 }
 
+int HnswStreamer::build(IndexThreads::Pointer threads,
+                        IndexHolder::Pointer holder) {
+  if (ailego_unlikely(state_ != STATE_OPENED)) {
+    LOG_ERROR("Open storage before HnswStreamer::build");
+    return IndexError_NoReady;
+  }
+  if (!holder) {
+    LOG_ERROR("Input holder is nullptr while building index");
+    return IndexError_InvalidArgument;
+  }
+  if (!holder->is_matched(meta_)) {
+    LOG_ERROR("Input holder doesn't match index meta while building index");
+    return IndexError_Mismatch;
+  }
+  if (entity_->doc_cnt() != 0 || provider_ != nullptr) {
+    LOG_ERROR("Bulk build requires an empty index without provider");
+    return IndexError_Unsupported;
+  }
+  if (!threads) {
+    threads =
+        std::make_shared<SingleQueueIndexThreads>(build_thread_cnt_, false);
+  }
+  if (ailego_unlikely(!shared_mutex_.try_lock_shared())) {
+    LOG_ERROR("Cannot build index while dumping index");
+    return IndexError_Unsupported;
+  }
+  AILEGO_DEFER([&]() { shared_mutex_.unlock_shared(); });
+
+  ailego::ElapsedTime timer;
+  LOG_INFO("Begin HnswStreamer::build");
+
+  // Stage all vectors first, so the graph is built over a fixed node set
+  std::vector<std::pair<level_t, node_id_t>> nodes;
+  if (holder->count() != static_cast<size_t>(-1)) {
+    nodes.reserve(holder->count());
+  }
+  auto iter = holder->create_iterator();
+  if (!iter) {
+    LOG_ERROR("Create iterator for holder failed");
+    return IndexError_Runtime;
+  }
+  for (; iter->is_valid(); iter->next()) {
+    if (entity_->doc_cnt() >= docs_hard_limit_) {
+      LOG_ERROR("Current docs %u exceed [%s]", entity_->doc_cnt(),
+                PARAM_HNSW_STREAMER_DOCS_HARD_LIMIT.c_str());
+      (*stats_.mutable_discarded_count())++;
+      return IndexError_IndexFull;
+    }
+    int ret = 0;
+    if (metric_->support_train()) {
+      ret = metric_->train(iter->data(), meta_.dimension());
+      if (ailego_unlikely(ret != 0)) {
+        LOG_ERROR("Hnsw streamer metric train failed");
+        return ret;
+      }
+    }
+    level_t level = alg_->get_random_level();
+    node_id_t id;
+    ret = entity_->add_vector(level, iter->key(), iter->data(), &id);
+    if (ailego_unlikely(ret != 0)) {
+      LOG_ERROR("Hnsw streamer add vector failed");
+      (*stats_.mutable_discarded_count())++;
+      return ret;
+    }
+    nodes.emplace_back(level, id);
+  }
+  holder.reset();
+
+  // Highest levels first: the serial seed settles the upper layers and the
+  // entry point, so the parallel inserts mostly contend on level 0 only
+  std::stable_sort(nodes.begin(), nodes.end(),
+                   [](const std::pair<level_t, node_id_t> &lhs,
+                      const std::pair<level_t, node_id_t> &rhs) {
+                     return lhs.first > rhs.first;
+                   });
+  size_t seed_cnt =
+      std::min(nodes.size(), static_cast<size_t>(build_seed_cnt_));
+  std::vector<std::pair<level_t, node_id_t>> seed(nodes.begin(),
+                                                   nodes.begin() + seed_cnt);
+  std::vector<std::pair<level_t, node_id_t>> rest(nodes.begin() + seed_cnt,
+                                                   nodes.end());
+
+  std::atomic<int> result{0};
+  do_build(&seed, 0, 1, false, &result);
+
+  auto run_parallel = [&](const std::vector<std::pair<level_t, node_id_t>> &in,
+                          bool prune) {
+    auto task_group = threads->make_group();
+    if (!task_group) {
+      LOG_ERROR("Failed to create task group");
+      result.store(IndexError_Runtime);
+      return;
+    }
+    for (size_t i = 0; i < threads->count(); ++i) {
+      task_group->submit(ailego::Closure::New(this, &HnswStreamer::do_build,
+                                              &in, i, threads->count(), prune,
+                                              &result));
+    }
+    task_group->wait_finish();
+  };
+  if (result.load() == 0) {
+    run_parallel(rest, false);
+  }
+  if (result.load() == 0) {
+    run_parallel(nodes, true);
+  }
+  if (result.load() != 0) {
+    LOG_ERROR("Failed to build graph, ret=%d", result.load());
+    return result.load();
+  }
+
+  *stats_.mutable_added_count() += nodes.size();
+  LOG_INFO("End HnswStreamer::build, docs=%zu seed=%zu threads=%zu cost=%zums",
+           nodes.size(), seed_cnt, threads->count(),
+           (size_t)timer.milli_seconds());
+  return 0;
+}
+
+void HnswStreamer::do_build(
+    const std::vector<std::pair<level_t, node_id_t>> *nodes, size_t begin,
+    size_t step, bool prune, std::atomic<int> *result) {
+  auto context = create_context();
+  HnswContext *ctx = dynamic_cast<HnswContext *>(context.get());
+  if (ailego_unlikely(ctx == nullptr)) {
+    int expected = 0;
+    result->compare_exchange_strong(expected, IndexError_Runtime);
+    return;
+  }
+  ctx->bind_dist_space(add_distance_, add_batch_distance_, provider_);
+
+  for (size_t i = begin; i < nodes->size(); i += step) {
+    if (ailego_unlikely(result->load(std::memory_order_relaxed) != 0)) {
+      return;
+    }
+    level_t level = (*nodes)[i].first;
+    node_id_t id = (*nodes)[i].second;
+    ctx->clear();
+
+    int ret = 0;
+    if (prune) {
+      for (level_t cur_level = 0; cur_level <= level && ret == 0;
+           ++cur_level) {
+        ret = alg_->prune_neighbors(id, cur_level, ctx);
+      }
+    } else {
+      IndexStorage::MemoryBlock block;
+      ret = entity_->get_vector(id, block);
+      if (ret == 0) {
+        ctx->reset_query(block.data(), meta_);
+        ret = alg_->add_node(id, level, ctx);
+      }
+    }
+    if (ret == 0 && ailego_unlikely(ctx->error())) {
+      ret = IndexError_Runtime;
+    }
+    if (ailego_unlikely(ret != 0)) {
+      LOG_ERROR("Hnsw streamer build node %u failed, ret=%d", id, ret);
+      int expected = 0;
+      result->compare_exchange_strong(expected, ret);
+      return;
+    }
+  }
+}
+
 
 int HnswStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
                               IndexStreamer::Context::Pointer &context) const {
@@ -88,6 +88,17 @@ class HnswStreamer : public IndexStreamer {
     return entity_->storage_mode();
   }
 
+  //! Retrieve the byte size of one level 0 node record when the contiguous
+  //! entity is built with a colocated layout, or 0 otherwise.
+  //! Intended for introspection and debug/testing usage.
+  size_t contiguous_record_size() const {
+    if (!entity_ || entity_->storage_mode() != HnswStorageMode::kContiguous) {
+      return 0;
+    }
+    return static_cast<const HnswContiguousStreamerEntity &>(*entity_)
+        .colocated_record_size();
+  }
+
  protected:
   //! Initialize Streamer
   int init(const IndexMeta &imeta, const ailego::Params &params) override;
@@ -110,6 +121,12 @@ class HnswStreamer : public IndexStreamer {
                        const IndexQueryMeta &qmeta,
                        Context::Pointer &context) override;
 
+  //! Bulk build an empty index from holder. The highest-level nodes are
+  //! linked serially as a seed, the rest in parallel, then every neighbor
+  //! list left unpruned by reverse linking is pruned in parallel
+  int build(IndexThreads::Pointer threads,
+            IndexHolder::Pointer holder) override;
+
   //! Similarity search
   int search_impl(const void *query, const IndexQueryMeta &qmeta,
                   Context::Pointer &context) const override;
@@ -220,6 +237,12 @@ class HnswStreamer : public IndexStreamer {
   //! current streamer/searcher
   int update_context(HnswContext *ctx) const;
 
+  //! Link (or prune when prune is set) the staged nodes from begin with
+  //! stride step. The first failure is saved in result
+  void do_build(const std::vector<std::pair<level_t, node_id_t>> *nodes,
+                size_t begin, size_t step, bool prune,
+                std::atomic<int> *result);
+
  private:
   enum State { STATE_INIT = 0, STATE_INITED = 1, STATE_OPENED = 2 };
   class Stats : public IndexStreamer::Stats {
@@ -270,6 +293,8 @@ class HnswStreamer : public IndexStreamer {
   uint32_t pl_{0};
   uint32_t ef_construction_{HnswEntity::kDefaultEfConstruction};
   uint32_t scaling_factor_{HnswEntity::kDefaultScalingFactor};
+  uint32_t build_thread_cnt_{0u};
+  uint32_t build_seed_cnt_{HnswEntity::kDefaultBuildSeedCount};
   size_t bruteforce_threshold_{HnswEntity::kDefaultBruteForceThreshold};
   size_t max_scan_limit_{HnswEntity::kDefaultMaxScanLimit};
   size_t min_scan_limit_{HnswEntity::kDefaultMinScanLimit};
@@ -285,6 +310,8 @@ class HnswStreamer : public IndexStreamer {
   bool force_padding_topk_enabled_{false};
   bool use_id_map_{true};
   bool use_contiguous_memory_{false};
+  uint32_t contiguous_layout_{
+      static_cast<uint32_t>(HnswContiguousLayout::kSplit)};
   bool use_external_vector_{false};
 
   //! avoid add vector while dumping index
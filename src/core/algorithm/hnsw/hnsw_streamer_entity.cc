@@ -16,13 +16,19 @@
 #if defined(__linux__) || defined(__APPLE__)
 #include <sys/mman.h>
 #endif
+#include <ailego/algorithm/kmeans.h>
 #include <ailego/utility/memory_helper.h>
+#include <zvec/core/framework/index_threads.h>
+#include "utility/pq_utility.h"
 
 // #define DEBUG_PRINT
 
 namespace zvec {
 namespace core {
 
+const std::string HnswContiguousStreamerEntity::kNeighborCodeBookSegmentId =
+    "HnswNeighborCodeBook";
+
 HnswStreamerEntity::HnswStreamerEntity(IndexStreamer::Stats &stats)
     : stats_(stats) {}
 
@@ -846,9 +852,18 @@ const HnswEntity::Pointer HnswContiguousStreamerEntity::clone() const {
   // Share contiguous memory with the clone (zero-copy)
   entity->vector_memory_ = vector_memory_;
   entity->vector_base_ = vector_base_;
+  entity->vector_stride_ = vector_stride_;
   entity->graph_memory_ = graph_memory_;
   entity->graph_base_ = graph_base_;
   entity->graph_stride_ = graph_stride_;
+  entity->layout_ = layout_;
+  entity->code_book_ = code_book_;
+  entity->code_dim_ = code_dim_;
+  entity->code_inner_product_ = code_inner_product_;
+  entity->code_subspace_count_ = code_subspace_count_;
+  entity->code_subspace_dim_ = code_subspace_dim_;
+  entity->code_size_ = code_size_;
+  entity->codes_offset_ = codes_offset_;
   entity->upper_neighbor_memory_ = upper_neighbor_memory_;
   entity->upper_neighbor_base_ = upper_neighbor_base_;
   entity->upper_chunk_offsets_ = upper_chunk_offsets_;
@@ -940,8 +955,14 @@ char *HnswContiguousStreamerEntity::allocate_contiguous(size_t size) {
 int HnswContiguousStreamerEntity::build_contiguous_memory() {
   vector_memory_.reset();
   vector_base_ = nullptr;
+  vector_stride_ = 0;
   graph_memory_.reset();
   graph_base_ = nullptr;
+  code_book_.reset();
+  code_subspace_count_ = 0;
+  code_subspace_dim_ = 0;
+  code_size_ = 0;
+  codes_offset_ = 0;
   upper_neighbor_memory_.reset();
   upper_neighbor_base_ = nullptr;
   upper_chunk_offsets_.clear();
@@ -951,10 +972,72 @@ int HnswContiguousStreamerEntity::build_contiguous_memory() {
     return 0;
   }
 
+  int ret = layout_ == HnswContiguousLayout::kSplit
+                ? build_split_nodes(total_docs)
+                : build_colocated_nodes(total_docs);
+  if (ret != 0) {
+    return ret;
+  }
+  const auto &chunks = node_chunks_;
+
+  // --- Build contiguous upper neighbor memory ---
+  const auto &upper_chunks = upper_neighbor_chunks_;
+  if (upper_chunks.empty()) {
+    LOG_INFO(
+        "Built HNSW contiguous memory: layout=%d total_docs=%u "
+        "node_chunks=%zu",
+        static_cast<int>(layout_), total_docs, chunks.size());
+    return 0;
+  }
+
+  // Sync all upper neighbor chunks
+  sync_upper_neighbor_chunks(upper_chunks.size() - 1);
+
+  // Calculate cumulative offsets and total size
+  upper_chunk_offsets_.resize(upper_chunks.size());
+  size_t total_upper_size = 0;
+  for (size_t i = 0; i < upper_chunks.size(); ++i) {
+    upper_chunk_offsets_[i] = total_upper_size;
+    total_upper_size += upper_chunks[i]->data_size();
+  }
+
+  size_t upper_memory_size = AlignHugePageSize(total_upper_size);
+  char *raw_upper = allocate_contiguous(upper_memory_size);
+  if (!raw_upper) {
+    vector_memory_.reset();
+    vector_base_ = nullptr;
+    graph_memory_.reset();
+    graph_base_ = nullptr;
+    code_book_.reset();
+    return IndexError_Runtime;
+  }
+  upper_neighbor_memory_.reset(raw_upper, ContiguousDeleter{upper_memory_size});
+  upper_neighbor_base_ = raw_upper;
+
+  // Copy upper neighbor data from chunks into contiguous memory
+  for (size_t i = 0; i < upper_chunks.size(); ++i) {
+    const void *chunk_data = nullptr;
+    size_t data_size = upper_chunks[i]->data_size();
+    upper_chunks[i]->read(0, &chunk_data, data_size);
+    std::memcpy(upper_neighbor_base_ + upper_chunk_offsets_[i], chunk_data,
+                data_size);
+  }
+
+  LOG_INFO(
+      "Built HNSW contiguous memory: layout=%d upper_neighbor_mem=%zu "
+      "total_docs=%u node_chunks=%zu upper_chunks=%zu",
+      static_cast<int>(layout_), upper_memory_size, total_docs, chunks.size(),
+      upper_chunks.size());
+
+  return 0;
+}
+
+int HnswContiguousStreamerEntity::build_split_nodes(uint32_t total_docs) {
   const size_t per_node = node_size();
   const size_t vec_size = vector_size();
   // graph_stride = key + L0 neighbors (everything except vector)
   graph_stride_ = sizeof(key_t) + neighbor_size_;
+  vector_stride_ = vec_size;
 
   // --- Allocate flat vector array (stride = vector_size) ---
   const size_t total_vec_data = static_cast<size_t>(total_docs) * vec_size;
@@ -1005,57 +1088,280 @@ int HnswContiguousStreamerEntity::build_contiguous_memory() {
     }
   }
 
-  // --- Build contiguous upper neighbor memory ---
-  const auto &upper_chunks = upper_neighbor_chunks_;
-  if (upper_chunks.empty()) {
-    LOG_INFO(
-        "Built HNSW contiguous memory (split layout): "
-        "vector_mem=%zu graph_mem=%zu total_docs=%u node_chunks=%zu",
-        vector_memory_size, graph_memory_size, total_docs, chunks.size());
-    return 0;
-  }
+  LOG_DEBUG("Split HNSW nodes: vector_mem=%zu graph_mem=%zu",
+            vector_memory_size, graph_memory_size);
+  return 0;
+}
 
-  // Sync all upper neighbor chunks
-  sync_upper_neighbor_chunks(upper_chunks.size() - 1);
+int HnswContiguousStreamerEntity::build_colocated_nodes(uint32_t total_docs) {
+  const size_t per_node = node_size();
+  const size_t vec_size = vector_size();
 
-  // Calculate cumulative offsets and total size
-  upper_chunk_offsets_.resize(upper_chunks.size());
-  size_t total_upper_size = 0;
-  for (size_t i = 0; i < upper_chunks.size(); ++i) {
-    upper_chunk_offsets_[i] = total_upper_size;
-    total_upper_size += upper_chunks[i]->data_size();
+  if (layout_ == HnswContiguousLayout::kNeighborCodes) {
+    if (code_dim_ == 0 || vec_size != code_dim_ * sizeof(float)) {
+      LOG_WARN(
+          "Neighbor codes need fp32 vectors, vector_size=%zu dim=%u, "
+          "falling back to colocated layout",
+          vec_size, code_dim_);
+    } else if (total_docs < kNeighborCodeCentroids) {
+      LOG_WARN(
+          "Too few vectors %u to train neighbor codes, "
+          "falling back to colocated layout",
+          total_docs);
+    } else {
+      code_subspace_count_ =
+          PQSubspaceCount(code_dim_, kMaxNeighborCodeSubspaces);
+      if (code_subspace_count_ == 0) {
+        LOG_WARN(
+            "No neighbor code subspaces divide dim=%u, "
+            "falling back to colocated layout",
+            code_dim_);
+      } else {
+        code_subspace_dim_ = code_dim_ / code_subspace_count_;
+        code_size_ = (code_subspace_count_ + 1) / 2;
+      }
+    }
   }
 
-  size_t upper_memory_size = AlignHugePageSize(total_upper_size);
-  char *raw_upper = allocate_contiguous(upper_memory_size);
-  if (!raw_upper) {
-    vector_memory_.reset();
-    vector_base_ = nullptr;
-    graph_memory_.reset();
-    graph_base_ = nullptr;
+  // Record layout: [vector | key | L0 neighbors | neighbor codes], padded to
+  // a cache line so a record never straddles more lines than it needs.
+  codes_offset_ = sizeof(key_t) + neighbor_size_;
+  const size_t record_size =
+      vec_size + codes_offset_ + l0_neighbor_cnt() * code_size_;
+  const size_t stride = (record_size + 63) & ~static_cast<size_t>(63);
+
+  const size_t total_data = static_cast<size_t>(total_docs) * stride;
+  size_t memory_size = AlignHugePageSize(total_data);
+  char *raw = allocate_contiguous(memory_size);
+  if (!raw) {
     return IndexError_Runtime;
   }
-  upper_neighbor_memory_.reset(raw_upper, ContiguousDeleter{upper_memory_size});
-  upper_neighbor_base_ = raw_upper;
+  vector_memory_.reset(raw, ContiguousDeleter{memory_size});
+  vector_base_ = raw;
+  vector_stride_ = stride;
+  graph_memory_ = vector_memory_;
+  graph_base_ = raw + vec_size;
+  graph_stride_ = stride;
 
-  // Copy upper neighbor data from chunks into contiguous memory
-  for (size_t i = 0; i < upper_chunks.size(); ++i) {
+  const auto &chunks = node_chunks_;
+  const uint32_t nodes_per_chunk = 1U << node_index_mask_bits_;
+  for (size_t chunk_idx = 0; chunk_idx < chunks.size(); ++chunk_idx) {
     const void *chunk_data = nullptr;
-    size_t data_size = upper_chunks[i]->data_size();
-    upper_chunks[i]->read(0, &chunk_data, data_size);
-    std::memcpy(upper_neighbor_base_ + upper_chunk_offsets_[i], chunk_data,
-                data_size);
+    size_t data_size = chunks[chunk_idx]->data_size();
+    chunks[chunk_idx]->read(0, &chunk_data, data_size);
+
+    uint32_t base_id = chunk_idx * nodes_per_chunk;
+    uint32_t count_in_chunk = std::min(nodes_per_chunk, total_docs - base_id);
+
+    const char *src = static_cast<const char *>(chunk_data);
+    for (uint32_t i = 0; i < count_in_chunk; ++i) {
+      std::memcpy(raw + static_cast<size_t>(base_id + i) * stride,
+                  src + static_cast<size_t>(i) * per_node,
+                  vec_size + codes_offset_);
+    }
   }
 
-  LOG_INFO(
-      "Built HNSW contiguous memory (split layout): "
-      "vector_mem=%zu graph_mem=%zu upper_neighbor_mem=%zu "
-      "total_docs=%u node_chunks=%zu upper_chunks=%zu",
-      vector_memory_size, graph_memory_size, upper_memory_size, total_docs,
-      chunks.size(), upper_chunks.size());
+  // The codebook is trained and codes are encoded from the copied vectors
+  // once every record is in place, as neighbors may live in chunks that were
+  // copied later. Only the first open trains it; later ones reuse the
+  // stored one.
+  if (code_size_ != 0) {
+    auto book = load_neighbor_codes();
+    if (!book) {
+      book = train_neighbor_codes(total_docs);
+      store_neighbor_codes(*book);
+    }
+    for (uint32_t id = 0; id < total_docs; ++id) {
+      const auto *hd = reinterpret_cast<const NeighborsHeader *>(
+          graph_base_ + static_cast<size_t>(id) * stride + sizeof(key_t));
+      uint8_t *codes = const_cast<uint8_t *>(get_neighbor_codes_ptr(id));
+      for (uint32_t i = 0; i < hd->neighbor_cnt; ++i) {
+        const float *vec = reinterpret_cast<const float *>(
+            vector_base_ + static_cast<size_t>(hd->neighbors[i]) * stride);
+        encode_neighbor_code(*book, vec, codes + i * code_size_);
+      }
+    }
+    code_book_ = std::move(book);
+  }
 
+  LOG_DEBUG(
+      "Colocated HNSW nodes: stride=%zu node_mem=%zu code_size=%zu "
+      "code_subspaces=%u",
+      stride, memory_size, code_size_, code_subspace_count_);
   return 0;
 }
 
+std::shared_ptr<HnswContiguousStreamerEntity::NeighborCodeBook>
+HnswContiguousStreamerEntity::train_neighbor_codes(uint32_t total_docs) const {
+  // Evenly strided sample of the colocated vectors
+  const size_t step = std::max<size_t>(
+      1u, (total_docs + kMaxNeighborCodeTrainVectors - 1) /
+              kMaxNeighborCodeTrainVectors);
+  std::vector<const float *> samples;
+  samples.reserve(total_docs / step + 1);
+  for (size_t id = 0; id < total_docs; id += step) {
+    samples.push_back(
+        reinterpret_cast<const float *>(vector_base_ + id * vector_stride_));
+  }
+
+  auto book = std::make_shared<NeighborCodeBook>();
+  book->centroids.assign(static_cast<size_t>(code_dim_) *
+                             kNeighborCodeCentroids,
+                         0.0f);
+
+  SingleQueueIndexThreads threads(1, false);
+  for (uint32_t s = 0; s < code_subspace_count_; ++s) {
+    const uint32_t offset = s * code_subspace_dim_;
+    ailego::NumericalKmeans<float, SingleQueueIndexThreads> kmeans(
+        kNeighborCodeCentroids, code_subspace_dim_);
+    for (const float *vec : samples) {
+      kmeans.append(vec + offset, code_subspace_dim_);
+    }
+    ailego::Kmc2CentroidsGenerator<
+        ailego::NumericalKmeans<float, SingleQueueIndexThreads>,
+        SingleQueueIndexThreads>
+        gen;
+    kmeans.init_centroids(threads, gen);
+
+    double cost = 0.0;
+    for (uint32_t iter = 0; iter < kMaxNeighborCodeKmeansIters; ++iter) {
+      double old_cost = cost;
+      if (!kmeans.cluster_once(threads, &cost) ||
+          std::abs(cost - old_cost) < std::numeric_limits<float>::epsilon()) {
+        break;
+      }
+    }
+
+    const auto &cents = kmeans.centroids();
+    float *out = &book->centroids[static_cast<size_t>(offset) *
+                                  kNeighborCodeCentroids];
+    for (size_t c = 0; c < cents.count() && c < kNeighborCodeCentroids; ++c) {
+      std::memcpy(out + c * code_subspace_dim_, cents[c],
+                  code_subspace_dim_ * sizeof(float));
+    }
+  }
+  return book;
+}
+
+std::shared_ptr<HnswContiguousStreamerEntity::NeighborCodeBook>
+HnswContiguousStreamerEntity::load_neighbor_codes() const {
+  auto segment = broker_->storage()->get(kNeighborCodeBookSegmentId);
+  if (!segment) {
+    return nullptr;
+  }
+  NeighborCodeBookHeader hd;
+  const size_t centroids_size =
+      static_cast<size_t>(code_dim_) * kNeighborCodeCentroids * sizeof(float);
+  const void *data = nullptr;
+  if (segment->data_size() < sizeof(hd) + centroids_size ||
+      segment->read(0, &data, sizeof(hd)) != sizeof(hd)) {
+    LOG_WARN("Invalid neighbor code book segment, size=%zu",
+             segment->data_size());
+    return nullptr;
+  }
+  std::memcpy(&hd, data, sizeof(hd));
+  if (hd.dimension != code_dim_ ||
+      hd.subspace_count != code_subspace_count_ ||
+      hd.centroid_count != kNeighborCodeCentroids) {
+    LOG_WARN(
+        "Neighbor code book of dim=%u subspaces=%u does not match dim=%u "
+        "subspaces=%u, retraining",
+        hd.dimension, hd.subspace_count, code_dim_, code_subspace_count_);
+    return nullptr;
+  }
+  if (segment->read(sizeof(hd), &data, centroids_size) != centroids_size) {
+    LOG_WARN("Read neighbor code book failed");
+    return nullptr;
+  }
+  auto book = std::make_shared<NeighborCodeBook>();
+  book->centroids.resize(centroids_size / sizeof(float));
+  std::memcpy(book->centroids.data(), data, centroids_size);
+  return book;
+}
+
+void HnswContiguousStreamerEntity::store_neighbor_codes(
+    const NeighborCodeBook &book) {
+  NeighborCodeBookHeader hd;
+  hd.dimension = code_dim_;
+  hd.subspace_count = code_subspace_count_;
+  hd.centroid_count = kNeighborCodeCentroids;
+  hd.reserved = 0;
+  const size_t centroids_size = book.centroids.size() * sizeof(float);
+
+  // A book of another code space is overwritten in place when it fits
+  auto storage = broker_->storage();
+  auto segment = storage->get(kNeighborCodeBookSegmentId);
+  if (!segment) {
+    int ret =
+        storage->append(kNeighborCodeBookSegmentId, sizeof(hd) + centroids_size);
+    if (ret != 0) {
+      LOG_WARN("Append neighbor code book segment failed for %s",
+               IndexError::What(ret));
+      return;
+    }
+    segment = storage->get(kNeighborCodeBookSegmentId);
+    if (!segment) {
+      LOG_WARN("Get neighbor code book segment failed");
+      return;
+    }
+    *stats_.mutable_index_size() += sizeof(hd) + centroids_size;
+  }
+  if (segment->capacity() < sizeof(hd) + centroids_size ||
+      segment->write(0, &hd, sizeof(hd)) != sizeof(hd) ||
+      segment->write(sizeof(hd), book.centroids.data(), centroids_size) !=
+          centroids_size) {
+    LOG_WARN("Write neighbor code book failed, capacity=%zu",
+             segment->capacity());
+  }
+}
+
+void HnswContiguousStreamerEntity::encode_neighbor_code(
+    const NeighborCodeBook &book, const float *vec, uint8_t *code) const {
+  std::memset(code, 0, code_size_);
+  const float *cents = book.centroids.data();
+  for (uint32_t s = 0; s < code_subspace_count_; ++s) {
+    const float *sub = vec + s * code_subspace_dim_;
+    float best = std::numeric_limits<float>::max();
+    uint32_t c = 0;
+    for (uint32_t k = 0; k < kNeighborCodeCentroids;
+         ++k, cents += code_subspace_dim_) {
+      float dist = 0.0f;
+      for (uint32_t d = 0; d < code_subspace_dim_; ++d) {
+        float diff = sub[d] - cents[d];
+        dist += diff * diff;
+      }
+      if (dist < best) {
+        best = dist;
+        c = k;
+      }
+    }
+    code[s >> 1] |= static_cast<uint8_t>(c << ((s & 1) << 2));
+  }
+}
+
+void HnswContiguousStreamerEntity::build_neighbor_code_lut(
+    const float *query, std::vector<float> *lut) const {
+  const float *cents = code_book_->centroids.data();
+  lut->resize(static_cast<size_t>(code_subspace_count_) *
+              kNeighborCodeCentroids);
+  float *out = lut->data();
+  for (uint32_t s = 0; s < code_subspace_count_; ++s) {
+    const float *sub = query + s * code_subspace_dim_;
+    for (uint32_t c = 0; c < kNeighborCodeCentroids;
+         ++c, cents += code_subspace_dim_) {
+      float score = 0.0f;
+      for (uint32_t d = 0; d < code_subspace_dim_; ++d) {
+        if (code_inner_product_) {
+          score -= sub[d] * cents[d];
+        } else {
+          float diff = sub[d] - cents[d];
+          score += diff * diff;
+        }
+      }
+      *out++ = score;
+    }
+  }
+}
+
 }  // namespace core
 }  // namespace zvec
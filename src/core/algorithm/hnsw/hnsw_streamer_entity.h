@@ -43,6 +43,17 @@ enum class HnswStorageMode {
   kExternal = 3
 };
 
+//! Node record layout built by HnswContiguousStreamerEntity
+enum class HnswContiguousLayout {
+  //! flat vector array + [key | L0 neighbors] array
+  kSplit = 0,
+  //! one array of [vector | key | L0 neighbors] records, 64-byte aligned
+  kColocated = 1,
+  //! colocated records followed by a 4-bit PQ code of every L0 neighbor, so
+  //! a hop is scored without touching the neighbors' own records
+  kNeighborCodes = 2
+};
+
 //! HnswStreamerEntity manage vector data, pkey, and node's neighbors
 class HnswStreamerEntity : public HnswEntity {
  public:
@@ -976,6 +987,8 @@ class HnswContiguousStreamerEntity : public HnswMmapStreamerEntity {
   void degrade_to_mmap() {
     vector_memory_.reset();
     vector_base_ = nullptr;
+    vector_stride_ = 0;
+    code_book_.reset();
     graph_memory_.reset();
     graph_base_ = nullptr;
     upper_neighbor_memory_.reset();
@@ -988,6 +1001,64 @@ class HnswContiguousStreamerEntity : public HnswMmapStreamerEntity {
     return vector_base_ != nullptr;
   }
 
+  //! Select the record layout used by the next build_contiguous_memory()
+  void set_contiguous_layout(HnswContiguousLayout layout) {
+    layout_ = layout;
+  }
+
+  HnswContiguousLayout contiguous_layout() const {
+    return layout_;
+  }
+
+  //! Describe the fp32 space neighbor codes are estimated in. Distances are
+  //! squared euclidean, or minus inner product if inner_product is true.
+  void set_neighbor_code_space(uint32_t dim, bool inner_product) {
+    code_dim_ = dim;
+    code_inner_product_ = inner_product;
+  }
+
+  //! Whether L0 records carry inline neighbor codes
+  bool has_neighbor_codes() const {
+    return code_book_ != nullptr && graph_base_ != nullptr;
+  }
+
+  //! Byte size of one colocated L0 record, 0 in split layout
+  size_t colocated_record_size() const {
+    return layout_ != HnswContiguousLayout::kSplit && is_contiguous()
+               ? vector_stride_
+               : 0;
+  }
+
+  //! Byte size of one neighbor code slot
+  inline size_t neighbor_code_size() const {
+    return code_size_;
+  }
+
+  //! Inline codes of node id's L0 neighbors, in neighbor list order
+  ailego_force_inline const uint8_t *get_neighbor_codes_ptr(
+      node_id_t id) const {
+    return reinterpret_cast<const uint8_t *>(
+        graph_base_ + static_cast<size_t>(id) * graph_stride_ + codes_offset_);
+  }
+
+  //! Fill lut with 16 partial distances per subspace for the query
+  void build_neighbor_code_lut(const float *query,
+                               std::vector<float> *lut) const;
+
+  //! Estimate the distance of one neighbor code with a query lut
+  ailego_force_inline float estimate_neighbor_code(const float *lut,
+                                                   const uint8_t *code) const {
+    float score = 0.0f;
+    const uint32_t pairs = code_subspace_count_ >> 1;
+    for (uint32_t i = 0; i < pairs; ++i, lut += 32) {
+      score += lut[code[i] & 0x0F] + lut[16 + (code[i] >> 4)];
+    }
+    if (code_subspace_count_ & 1) {
+      score += lut[code[pairs] & 0x0F];
+    }
+    return score;
+  }
+
   int add_vector(level_t level, key_t key, const void *vec,
                  node_id_t *id) override {
     if (ailego_unlikely(is_contiguous())) degrade_to_mmap();
@@ -1035,7 +1106,7 @@ class HnswContiguousStreamerEntity : public HnswMmapStreamerEntity {
       vec_blocks.resize(count);
       for (auto i = 0U; i < count; ++i) {
         const char *ptr =
-            vector_base_ + static_cast<size_t>(ids[i]) * vector_size();
+            vector_base_ + static_cast<size_t>(ids[i]) * vector_stride_;
         vec_blocks[i].reset(const_cast<char *>(ptr));
       }
       return 0;
@@ -1054,11 +1125,11 @@ class HnswContiguousStreamerEntity : public HnswMmapStreamerEntity {
     return HnswMmapStreamerEntity::get_key_typed(id);
   }
 
-  //! Direct vector pointer from flat vector array (stride = vector_size).
+  //! Direct vector pointer from the vector array (stride = vector_stride_).
   //! For use in the merged search loop to avoid intermediate allocations.
   ailego_force_inline const void *get_vector_ptr(node_id_t id) const {
     if (ailego_likely(vector_base_ != nullptr)) {
-      return vector_base_ + static_cast<size_t>(id) * vector_size();
+      return vector_base_ + static_cast<size_t>(id) * vector_stride_;
     }
     // Fallback to mmap chunk-based access
     uint32_t chunk_idx = id >> node_index_mask_bits_;
@@ -1083,14 +1154,52 @@ class HnswContiguousStreamerEntity : public HnswMmapStreamerEntity {
     }
   };
 
-  //! Flat vector array: vectors stored densely (stride = vector_size).
+  //! Centroids of the 4-bit PQ neighbor codes, kNeighborCodeCentroids per
+  //! subspace, laid out [subspace][centroid][subspace dimension]
+  struct NeighborCodeBook {
+    std::vector<float> centroids;
+  };
+
+  //! Header of the persisted codebook, followed by its centroids
+  struct NeighborCodeBookHeader {
+    uint32_t dimension;
+    uint32_t subspace_count;
+    uint32_t centroid_count;
+    uint32_t reserved;
+  };
+
+  //! Storage segment holding the trained codebook across reopens
+  static const std::string kNeighborCodeBookSegmentId;
+
+  //! Centroids per subspace, addressed by one 4-bit code
+  static constexpr uint32_t kNeighborCodeCentroids = 16u;
+  //! Upper bound of the subspace count, 16 bytes per neighbor code
+  static constexpr uint32_t kMaxNeighborCodeSubspaces = 32u;
+  static constexpr uint32_t kMaxNeighborCodeKmeansIters = 16u;
+  static constexpr size_t kMaxNeighborCodeTrainVectors = 16384u;
+
+  //! Vector array. In split layout vectors are stored densely (stride =
+  //! vector_size), otherwise it points at the first colocated record.
   std::shared_ptr<char> vector_memory_{};
   char *vector_base_{nullptr};
+  size_t vector_stride_{0};
 
   //! Graph array: [key | L0 neighbors] stored densely (stride = graph_stride_).
+  //! In colocated layouts it aliases vector_memory_ at offset vector_size.
   std::shared_ptr<char> graph_memory_{};
   char *graph_base_{nullptr};
-  size_t graph_stride_{0};  // sizeof(key_t) + neighbor_size_
+  size_t graph_stride_{0};  // sizeof(key_t) + neighbor_size_ in split layout
+
+  HnswContiguousLayout layout_{HnswContiguousLayout::kSplit};
+
+  //! Neighbor codes, present only in kNeighborCodes layout
+  std::shared_ptr<const NeighborCodeBook> code_book_{};
+  uint32_t code_dim_{0};
+  bool code_inner_product_{false};
+  uint32_t code_subspace_count_{0};
+  uint32_t code_subspace_dim_{0};
+  size_t code_size_{0};     // bytes per neighbor code, (subspaces + 1) / 2
+  size_t codes_offset_{0};  // codes offset from the key of a record
 
   //! Shared ownership of upper neighbor contiguous memory
   std::shared_ptr<char> upper_neighbor_memory_{};
@@ -1102,6 +1211,28 @@ class HnswContiguousStreamerEntity : public HnswMmapStreamerEntity {
  private:
   //! Allocate contiguous memory with hugepage/THP support
   static char *allocate_contiguous(size_t size);
+
+  //! Copy node chunks into the split vector and graph arrays
+  int build_split_nodes(uint32_t total_docs);
+
+  //! Copy node chunks into colocated records, and encode neighbor codes
+  //! when the layout asks for them
+  int build_colocated_nodes(uint32_t total_docs);
+
+  //! Train the PQ codebook over a sample of the colocated vectors
+  std::shared_ptr<NeighborCodeBook> train_neighbor_codes(
+      uint32_t total_docs) const;
+
+  //! Load the codebook stored by an earlier open, nullptr if there is none
+  //! for the current code space
+  std::shared_ptr<NeighborCodeBook> load_neighbor_codes() const;
+
+  //! Store a freshly trained codebook so later opens skip the training
+  void store_neighbor_codes(const NeighborCodeBook &book);
+
+  //! Encode a fp32 vector into a code slot of 4-bit subspace codes
+  void encode_neighbor_code(const NeighborCodeBook &book, const float *vec,
+                            uint8_t *code) const;
 };
 
 //! Typed entity subclass that reads vectors from an external vector source.
@@ -453,8 +453,9 @@ class HnswSparseContext : public IndexContext {
   }
 
   inline void update_dist_caculator_distance(
-      const IndexMetric::MatrixSparseDistance &distance) {
-    dc_.update_distance(distance);
+      const IndexMetric::MatrixSparseDistance &distance,
+      IndexMetric::SparseQueryPreprocessFunc preprocess = nullptr) {
+    dc_.update_distance(distance, preprocess);
   }
 
   //! Get topk
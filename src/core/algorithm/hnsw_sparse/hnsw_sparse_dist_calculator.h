@@ -29,6 +29,7 @@ class HnswSparseDistCalculator {
                            const IndexMetric::Pointer &metric)
       : entity_(entity),
         distance_(metric->sparse_distance()),
+        preprocess_(metric->get_sparse_query_preprocess_func()),
         query_{nullptr},
         compare_cnt_(0) {}
 
@@ -38,6 +39,7 @@ class HnswSparseDistCalculator {
                            const void *query)
       : entity_(entity),
         distance_(metric->sparse_distance()),
+        preprocess_(metric->get_sparse_query_preprocess_func()),
         query_(query),
         compare_cnt_(0) {}
 
@@ -45,17 +47,25 @@ class HnswSparseDistCalculator {
               const IndexMetric::Pointer &metric) {
     entity_ = entity;
     distance_ = metric->sparse_distance();
+    preprocess_ = metric->get_sparse_query_preprocess_func();
   }
 
   inline void update_distance(
-      const IndexMetric::MatrixSparseDistance &distance) {
+      const IndexMetric::MatrixSparseDistance &distance,
+      IndexMetric::SparseQueryPreprocessFunc preprocess = nullptr) {
     distance_ = distance;
+    preprocess_ = preprocess;
   }
 
-  //! Reset query vector data
+  //! Reset query vector data, preprocessed once for all the candidates
   inline void reset_query(const void *query) {
     error_ = false;
-    query_ = query;
+    if (preprocess_ != nullptr && query != nullptr) {
+      preprocess_(query, query_buffer_);
+      query_ = query_buffer_.data();
+    } else {
+      query_ = query;
+    }
   }
 
   //! Returns distance
@@ -173,8 +183,10 @@ class HnswSparseDistCalculator {
   const HnswSparseEntity *entity_;
 
   IndexMetric::MatrixSparseDistance distance_;
+  IndexMetric::SparseQueryPreprocessFunc preprocess_{nullptr};
 
   const void *query_;
+  std::string query_buffer_{};
 
   uint32_t compare_cnt_;  // record distance compute times
   bool error_{false};
@@ -315,6 +315,13 @@ int HnswSparseStreamer::open(IndexStorage::Pointer stg) {
     search_distance_ = metric_->query_metric()->sparse_distance();
   }
 
+  // Queries are scattered once per search when the query metric supports it
+  auto query_metric = metric_->query_metric();
+  if (query_metric && query_metric->get_sparse_query_preprocess_func()) {
+    search_distance_ = query_metric->sparse_distance();
+    search_preprocess_ = query_metric->get_sparse_query_preprocess_func();
+  }
+
   state_ = STATE_OPENED;
   magic_ = IndexContext::GenerateMagic();
 
@@ -639,7 +646,7 @@ int HnswSparseStreamer::search_impl(
   }
 
   ctx->clear();
-  ctx->update_dist_caculator_distance(search_distance_);
+  ctx->update_dist_caculator_distance(search_distance_, search_preprocess_);
   ctx->resize_results(count);
   ctx->check_need_adjuct_ctx(entity_.doc_cnt());
 
@@ -727,7 +734,7 @@ int HnswSparseStreamer::search_bf_impl(
   }
 
   ctx->clear();
-  ctx->update_dist_caculator_distance(search_distance_);
+  ctx->update_dist_caculator_distance(search_distance_, search_preprocess_);
   ctx->resize_results(count);
 
   const uint32_t *sparse_indices_tmp = sparse_indices;
@@ -851,7 +858,7 @@ int HnswSparseStreamer::search_bf_by_p_keys_impl(
   }
 
   ctx->clear();
-  ctx->update_dist_caculator_distance(search_distance_);
+  ctx->update_dist_caculator_distance(search_distance_, search_preprocess_);
   ctx->resize_results(count);
 
   const uint32_t *sparse_indices_tmp = sparse_indices;
@@ -184,6 +184,7 @@ class HnswSparseStreamer : public IndexStreamer {
 
   IndexMetric::MatrixSparseDistance add_distance_{};
   IndexMetric::MatrixSparseDistance search_distance_{};
+  IndexMetric::SparseQueryPreprocessFunc search_preprocess_{nullptr};
   std::mutex mutex_{};
 
   size_t max_index_size_{0UL};
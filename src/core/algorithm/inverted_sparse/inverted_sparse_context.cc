@@ -0,0 +1,73 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "inverted_sparse_context.h"
+#include "inverted_sparse_params.h"
+#include "inverted_sparse_searcher.h"
+#include "inverted_sparse_streamer.h"
+
+namespace zvec {
+namespace core {
+
+InvertedSparseContext::InvertedSparseContext(
+    const InvertedSparseStreamer *streamer_ptr) {
+  this->reset(streamer_ptr);
+}
+
+InvertedSparseContext::InvertedSparseContext(
+    const InvertedSparseSearcher *searcher_ptr) {
+  this->reset(searcher_ptr);
+}
+
+void InvertedSparseContext::reset(const InvertedSparseStreamer *streamer_ptr) {
+  magic_ = streamer_ptr->magic();
+  heap_factor_ = streamer_ptr->heap_factor();
+  streamer_owner_ = streamer_ptr;
+  context_type_ = kStreamerContext;
+}
+
+void InvertedSparseContext::reset(const InvertedSparseSearcher *searcher_ptr) {
+  magic_ = searcher_ptr->magic();
+  heap_factor_ = searcher_ptr->heap_factor();
+  searcher_owner_ = searcher_ptr;
+  context_type_ = kSearcherContext;
+}
+
+int InvertedSparseContext::update(const ailego::Params &params) {
+  const std::string &p = context_type_ == kSearcherContext
+                             ? PARAM_INVERTED_SPARSE_SEARCHER_HEAP_FACTOR
+                             : PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR;
+  if (params.has(p)) {
+    float heap_factor = heap_factor_;
+    params.get(p, &heap_factor);
+    if (heap_factor <= 0.0f || heap_factor > 1.0f) {
+      LOG_ERROR("Invalid %s %f, expected in (0, 1]", p.c_str(), heap_factor);
+      return IndexError_InvalidArgument;
+    }
+    heap_factor_ = heap_factor;
+  }
+  return 0;
+}
+
+const FlatSparseEntity *InvertedSparseContext::entity() const {
+  if (context_type_ == kStreamerContext) {
+    return &streamer_owner_->entity();
+  } else if (context_type_ == kSearcherContext) {
+    return &searcher_owner_->entity();
+  }
+  return nullptr;
+}
+
+}  // namespace core
+}  // namespace zvec
@@ -0,0 +1,438 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "inverted_sparse_index.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility/sparse_utility.h>
+#include <zvec/ailego/utility/float_helper.h>
+#include "flat_sparse/flat_sparse_index_format.h"
+
+namespace zvec {
+namespace core {
+
+namespace {
+
+//! Position of a query dimension in its posting list
+struct Cursor {
+  const InvertedSparseIndex::PostingList *list;
+  float weight;
+  float bound;
+  size_t pos;
+  size_t block;
+};
+
+//! Leads the serialized posting lists, followed per dimension by its index,
+//! posting count, ids and values. Blocks are recomputed on load
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t data_type;
+  uint32_t doc_count;
+  uint32_t term_count;
+};
+
+constexpr uint32_t kSerializedMagic = 0x53504956u;  // "VIPS"
+
+}  // namespace
+
+int InvertedSparseIndex::init(IndexMeta::DataType data_type) {
+  if (data_type != IndexMeta::DataType::DT_FP32 &&
+      data_type != IndexMeta::DataType::DT_FP16) {
+    LOG_ERROR("Unsupported sparse data type %d", data_type);
+    return IndexError_Unsupported;
+  }
+  data_type_ = data_type;
+  return 0;
+}
+
+float InvertedSparseIndex::value_at(const void *values, size_t i) const {
+  if (data_type_ == IndexMeta::DataType::DT_FP16) {
+    return ailego::FloatHelper::ToFP32(
+        reinterpret_cast<const uint16_t *>(values)[i]);
+  }
+  return reinterpret_cast<const float *>(values)[i];
+}
+
+int InvertedSparseIndex::add(node_id_t id, const void *sparse_data) {
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(sparse_data);
+  if (ailego_unlikely(data == nullptr)) {
+    return IndexError_InvalidArgument;
+  }
+
+  // [count][seg count][seg ids][seg sizes][u16 indices][values]
+  const uint32_t sparse_count = *reinterpret_cast<const uint32_t *>(data);
+  if (sparse_count == 0) {
+    std::unique_lock<ailego::SharedMutex> lock(mutex_);
+    doc_count_ = std::max(doc_count_, id + 1);
+    return 0;
+  }
+  const uint32_t seg_count =
+      *reinterpret_cast<const uint32_t *>(data + sizeof(uint32_t));
+  const uint32_t *seg_ids =
+      reinterpret_cast<const uint32_t *>(data + 2 * sizeof(uint32_t));
+  const uint32_t *seg_sizes = seg_ids + seg_count;
+  const uint16_t *indices =
+      reinterpret_cast<const uint16_t *>(seg_sizes + seg_count);
+  const void *values = indices + sparse_count;
+
+  std::unique_lock<ailego::SharedMutex> lock(mutex_);
+  doc_count_ = std::max(doc_count_, id + 1);
+  uint32_t i = 0;
+  for (uint32_t s = 0; s < seg_count; ++s) {
+    uint32_t base = seg_ids[s] << SEGMENT_ID_BITS;
+    for (uint32_t j = 0; j < seg_sizes[s] && i < sparse_count; ++j, ++i) {
+      float value = value_at(values, i);
+      if (value != 0.0f) {
+        insert_posting(&postings_[base + indices[i]], id, value);
+      }
+    }
+  }
+  return 0;
+}
+
+int InvertedSparseIndex::build(const FlatSparseEntity &entity) {
+  node_id_t doc_cnt = entity.doc_cnt();
+  for (node_id_t id = 0; id < doc_cnt; ++id) {
+    IndexStorage::MemoryBlock block;
+    const void *data = nullptr;
+    uint32_t len = 0;
+    int ret = entity.get_sparse_vector_ptr_by_id(id, block, &len);
+    if (ret == IndexError_NotImplemented) {
+      ret = entity.get_sparse_vector_ptr_by_id(id, &data, &len);
+    } else {
+      data = block.data();
+    }
+    if (ailego_unlikely(ret != 0)) {
+      LOG_ERROR("Failed to read sparse vector, id=%u, ret=%s", id,
+                IndexError::What(ret));
+      return ret;
+    }
+
+    ret = this->add(id, data);
+    if (ailego_unlikely(ret != 0)) {
+      LOG_ERROR("Failed to index sparse vector, id=%u, ret=%s", id,
+                IndexError::What(ret));
+      return ret;
+    }
+  }
+
+  LOG_INFO("Built inverted sparse index, docs=%u, terms=%zu", doc_cnt,
+           this->term_count());
+  return 0;
+}
+
+void InvertedSparseIndex::clear(void) {
+  std::unique_lock<ailego::SharedMutex> lock(mutex_);
+  postings_.clear();
+  doc_count_ = 0;
+}
+
+void InvertedSparseIndex::serialize(std::string *out) const {
+  std::shared_lock<ailego::SharedMutex> lock(mutex_);
+
+  size_t size = sizeof(SerializedHeader);
+  for (const auto &it : postings_) {
+    size += 2 * sizeof(uint32_t) +
+            it.second.ids.size() * (sizeof(node_id_t) + sizeof(float));
+  }
+  size_t offset = out->size();
+  out->resize(offset + size);
+  char *buf = &(*out)[offset];
+
+  SerializedHeader header{kSerializedMagic,
+                          static_cast<uint32_t>(data_type_), doc_count_,
+                          static_cast<uint32_t>(postings_.size())};
+  std::memcpy(buf, &header, sizeof(header));
+  buf += sizeof(header);
+  for (const auto &it : postings_) {
+    const PostingList &list = it.second;
+    const uint32_t count = static_cast<uint32_t>(list.ids.size());
+    std::memcpy(buf, &it.first, sizeof(uint32_t));
+    std::memcpy(buf + sizeof(uint32_t), &count, sizeof(uint32_t));
+    buf += 2 * sizeof(uint32_t);
+    std::memcpy(buf, list.ids.data(), count * sizeof(node_id_t));
+    buf += count * sizeof(node_id_t);
+    std::memcpy(buf, list.values.data(), count * sizeof(float));
+    buf += count * sizeof(float);
+  }
+}
+
+int InvertedSparseIndex::deserialize(const void *data, size_t size) {
+  const char *buf = reinterpret_cast<const char *>(data);
+  const char *end = buf + size;
+  SerializedHeader header;
+  if (ailego_unlikely(size < sizeof(header))) {
+    LOG_ERROR("Serialized posting lists too short, size=%zu", size);
+    return IndexError_InvalidFormat;
+  }
+  std::memcpy(&header, buf, sizeof(header));
+  buf += sizeof(header);
+  if (ailego_unlikely(header.magic != kSerializedMagic)) {
+    LOG_ERROR("Invalid magic of serialized posting lists %#x", header.magic);
+    return IndexError_InvalidFormat;
+  }
+  if (ailego_unlikely(header.data_type != static_cast<uint32_t>(data_type_))) {
+    LOG_ERROR("Serialized posting lists of data type %u, expected %d",
+              header.data_type, data_type_);
+    return IndexError_Mismatch;
+  }
+
+  std::unordered_map<uint32_t, PostingList> postings;
+  postings.reserve(header.term_count);
+  for (uint32_t t = 0; t < header.term_count; ++t) {
+    uint32_t index = 0;
+    uint32_t count = 0;
+    if (ailego_unlikely(static_cast<size_t>(end - buf) <
+                        2 * sizeof(uint32_t))) {
+      LOG_ERROR("Serialized posting lists truncated at term %u", t);
+      return IndexError_InvalidFormat;
+    }
+    std::memcpy(&index, buf, sizeof(uint32_t));
+    std::memcpy(&count, buf + sizeof(uint32_t), sizeof(uint32_t));
+    buf += 2 * sizeof(uint32_t);
+    const size_t bytes =
+        static_cast<size_t>(count) * (sizeof(node_id_t) + sizeof(float));
+    if (ailego_unlikely(count == 0 ||
+                        static_cast<size_t>(end - buf) < bytes)) {
+      LOG_ERROR("Serialized posting lists truncated at term %u", t);
+      return IndexError_InvalidFormat;
+    }
+
+    PostingList &list = postings[index];
+    list.ids.resize(count);
+    list.values.resize(count);
+    std::memcpy(list.ids.data(), buf, count * sizeof(node_id_t));
+    buf += count * sizeof(node_id_t);
+    std::memcpy(list.values.data(), buf, count * sizeof(float));
+    buf += count * sizeof(float);
+    if (ailego_unlikely(list.ids.back() >= header.doc_count)) {
+      LOG_ERROR("Serialized posting of id %u beyond %u docs", list.ids.back(),
+                header.doc_count);
+      return IndexError_InvalidFormat;
+    }
+    update_blocks(&list, 0);
+  }
+
+  std::unique_lock<ailego::SharedMutex> lock(mutex_);
+  postings_.swap(postings);
+  doc_count_ = header.doc_count;
+  return 0;
+}
+
+void InvertedSparseIndex::insert_posting(PostingList *list, node_id_t id,
+                                         float value) {
+  auto &ids = list->ids;
+  size_t pos = ids.size();
+  if (!ids.empty() && ids.back() >= id) {
+    pos = std::lower_bound(ids.begin(), ids.end(), id) - ids.begin();
+    if (ids[pos] == id) {
+      // The old value may have been the maximum
+      list->values[pos] = value;
+      list->max_value = 0.0f;
+      update_blocks(list, 0);
+      return;
+    }
+  }
+
+  ids.insert(ids.begin() + pos, id);
+  list->values.insert(list->values.begin() + pos, value);
+  update_blocks(list, pos / kBlockSize);
+}
+
+void InvertedSparseIndex::update_blocks(PostingList *list,
+                                        size_t first_block) {
+  size_t count = list->ids.size();
+  size_t block_count = (count + kBlockSize - 1) / kBlockSize;
+  list->blocks.resize(block_count);
+
+  for (size_t b = first_block; b < block_count; ++b) {
+    size_t begin = b * kBlockSize;
+    size_t end = std::min(count, begin + kBlockSize);
+    float max_value = 0.0f;
+    for (size_t i = begin; i < end; ++i) {
+      max_value = std::max(max_value, std::abs(list->values[i]));
+    }
+    list->blocks[b].last_id = list->ids[end - 1];
+    list->blocks[b].max_value = max_value;
+    list->max_value = std::max(list->max_value, max_value);
+  }
+}
+
+int InvertedSparseIndex::make_query(uint32_t sparse_count,
+                                    const uint32_t *sparse_indices,
+                                    const void *sparse_values,
+                                    std::vector<QueryTerm> *terms) const {
+  terms->clear();
+  terms->reserve(sparse_count);
+  for (uint32_t i = 0; i < sparse_count; ++i) {
+    float weight = value_at(sparse_values, i);
+    if (weight != 0.0f) {
+      terms->push_back(QueryTerm{sparse_indices[i], weight});
+    }
+  }
+
+  std::sort(terms->begin(), terms->end(),
+            [](const QueryTerm &lhs, const QueryTerm &rhs) {
+              return lhs.index < rhs.index;
+            });
+  size_t size = 0;
+  for (size_t i = 0; i < terms->size(); ++i) {
+    if (size > 0 && (*terms)[size - 1].index == (*terms)[i].index) {
+      (*terms)[size - 1].weight += (*terms)[i].weight;
+    } else {
+      (*terms)[size++] = (*terms)[i];
+    }
+  }
+  terms->resize(size);
+  return 0;
+}
+
+int InvertedSparseIndex::search(const std::vector<QueryTerm> &terms,
+                                const FlatSparseEntity &entity,
+                                const IndexFilter &filter, float heap_factor,
+                                IndexDocumentHeap *heap,
+                                SearchStats *stats) const {
+  if (ailego_unlikely(heap_factor <= 0.0f || heap_factor > 1.0f)) {
+    LOG_ERROR("Invalid heap factor %f", heap_factor);
+    return IndexError_InvalidArgument;
+  }
+
+  std::shared_lock<ailego::SharedMutex> lock(mutex_);
+
+  std::vector<Cursor> cursors;
+  cursors.reserve(terms.size());
+  for (const auto &term : terms) {
+    auto it = postings_.find(term.index);
+    if (it == postings_.end() || it->second.ids.empty()) {
+      continue;
+    }
+    float bound = std::abs(term.weight) * it->second.max_value;
+    cursors.push_back(Cursor{&it->second, term.weight, bound, 0u, 0u});
+  }
+  if (cursors.empty()) {
+    return 0;
+  }
+
+  // With ascending bounds, the lists whose bounds sum up below the threshold
+  // form the non-essential prefix
+  std::sort(cursors.begin(), cursors.end(),
+            [](const Cursor &lhs, const Cursor &rhs) {
+              return lhs.bound < rhs.bound;
+            });
+  const size_t count = cursors.size();
+  std::vector<float> bound_sums(count);
+  float sum = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    sum += cursors[i].bound;
+    bound_sums[i] = sum;
+  }
+
+  float threshold = -std::numeric_limits<float>::max();
+  size_t essential = 0;
+  auto update_threshold = [&]() {
+    if (!heap->full()) {
+      return;
+    }
+    float kth = -heap->front().score();
+    threshold = kth > 0.0f ? kth / heap_factor : kth;
+    while (essential < count && bound_sums[essential] <= threshold) {
+      ++essential;
+    }
+  };
+
+  std::vector<float> block_sums(count);
+  while (essential < count) {
+    node_id_t id = kInvalidNodeId;
+    for (size_t i = essential; i < count; ++i) {
+      const Cursor &c = cursors[i];
+      if (c.pos < c.list->ids.size()) {
+        id = std::min(id, c.list->ids[c.pos]);
+      }
+    }
+    if (id == kInvalidNodeId) {
+      break;
+    }
+
+    float score = 0.0f;
+    for (size_t i = essential; i < count; ++i) {
+      Cursor &c = cursors[i];
+      if (c.pos < c.list->ids.size() && c.list->ids[c.pos] == id) {
+        score += c.weight * c.list->values[c.pos];
+        ++c.pos;
+      }
+    }
+
+    if (essential > 0) {
+      if (score + bound_sums[essential - 1] <= threshold) {
+        ++stats->pruned_count;
+        continue;
+      }
+
+      // Tighten the bound with the blocks holding id, then probe the
+      // non-essential lists from the largest bound down
+      float block_sum = 0.0f;
+      for (size_t i = 0; i < essential; ++i) {
+        Cursor &c = cursors[i];
+        const auto &blocks = c.list->blocks;
+        while (c.block < blocks.size() && blocks[c.block].last_id < id) {
+          ++c.block;
+        }
+        if (c.block < blocks.size()) {
+          block_sum += std::abs(c.weight) * blocks[c.block].max_value;
+        }
+        block_sums[i] = block_sum;
+      }
+
+      bool pruned = score + block_sum <= threshold;
+      for (size_t i = essential; !pruned && i-- > 0;) {
+        Cursor &c = cursors[i];
+        const auto &ids = c.list->ids;
+        if (c.block < c.list->blocks.size()) {
+          size_t begin = std::max(c.pos, c.block * kBlockSize);
+          size_t end = std::min(ids.size(), (c.block + 1) * kBlockSize);
+          c.pos = std::lower_bound(ids.begin() + begin, ids.begin() + end, id) -
+                  ids.begin();
+          if (c.pos < end && ids[c.pos] == id) {
+            score += c.weight * c.list->values[c.pos];
+          }
+        }
+        pruned = i > 0 && score + block_sums[i - 1] <= threshold;
+      }
+      if (pruned) {
+        ++stats->pruned_count;
+        continue;
+      }
+    }
+
+    uint64_t key = entity.get_key(id);
+    if (ailego_unlikely(key == kInvalidKey)) {
+      continue;
+    }
+    if (filter.is_valid() && filter(key)) {
+      ++stats->filtered_count;
+      continue;
+    }
+
+    ++stats->scored_count;
+    heap->emplace(key, -score);
+    update_threshold();
+  }
+
+  return 0;
+}
+
+}  // namespace core
+}  // namespace zvec
@@ -0,0 +1,145 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ailego/parallel/lock.h>
+#include <zvec/core/framework/index_framework.h>
+#include "flat_sparse/flat_sparse_entity.h"
+
+namespace zvec {
+namespace core {
+
+/*! Inverted Sparse Index
+ *
+ * Keeps one posting list per sparse dimension, ordered by node id and cut
+ * into fixed size blocks which remember the largest absolute value they
+ * hold. Queries are answered with block-max MaxScore: the dimensions whose
+ * bounds cannot lift a document into the top-k are only probed for the
+ * documents found through the others.
+ */
+class InvertedSparseIndex {
+ public:
+  //! Postings per block, matches the blocks of the full text posting lists
+  static constexpr uint32_t kBlockSize = 128u;
+
+  struct Block {
+    node_id_t last_id{kInvalidNodeId};
+    float max_value{0.0f};
+  };
+
+  struct PostingList {
+    std::vector<node_id_t> ids{};
+    std::vector<float> values{};
+    std::vector<Block> blocks{};
+    float max_value{0.0f};
+  };
+
+  //! One dimension of a query
+  struct QueryTerm {
+    uint32_t index{0};
+    float weight{0.0f};
+  };
+
+  //! Counters of a single query
+  struct SearchStats {
+    size_t scored_count{0};
+    size_t pruned_count{0};
+    size_t filtered_count{0};
+  };
+
+ public:
+  InvertedSparseIndex(void) = default;
+
+  InvertedSparseIndex(const InvertedSparseIndex &) = delete;
+  InvertedSparseIndex &operator=(const InvertedSparseIndex &) = delete;
+
+  //! Initialize with the data type of the sparse values
+  int init(IndexMeta::DataType data_type);
+
+  //! Index a sparse vector in the entity format
+  int add(node_id_t id, const void *sparse_data);
+
+  //! Index every vector of the entity
+  int build(const FlatSparseEntity &entity);
+
+  //! Drop all postings
+  void clear(void);
+
+  //! Serialize the posting lists, appending them to out
+  void serialize(std::string *out) const;
+
+  //! Replace the posting lists with serialized ones
+  int deserialize(const void *data, size_t size);
+
+  //! Convert a query into sorted terms, repeated dimensions are summed
+  int make_query(uint32_t sparse_count, const uint32_t *sparse_indices,
+                 const void *sparse_values,
+                 std::vector<QueryTerm> *terms) const;
+
+  //! Search the top documents by inner product, scores in the heap are the
+  //! negated inner products like the sparse inner product metric
+  int search(const std::vector<QueryTerm> &terms,
+             const FlatSparseEntity &entity, const IndexFilter &filter,
+             float heap_factor, IndexDocumentHeap *heap,
+             SearchStats *stats) const;
+
+  //! Retrieve the count of indexed dimensions
+  size_t term_count(void) const {
+    std::shared_lock<ailego::SharedMutex> lock(mutex_);
+    return postings_.size();
+  }
+
+  //! Retrieve the count of indexed documents, one past the largest id
+  node_id_t doc_count(void) const {
+    std::shared_lock<ailego::SharedMutex> lock(mutex_);
+    return doc_count_;
+  }
+
+  //! Copy the posting list of a dimension, false if absent. The copy is
+  //! taken under the lock, so a concurrent add cannot tear it
+  bool posting_list(uint32_t index, PostingList *list) const {
+    std::shared_lock<ailego::SharedMutex> lock(mutex_);
+    auto it = postings_.find(index);
+    if (it == postings_.end()) {
+      return false;
+    }
+    *list = it->second;
+    return true;
+  }
+
+ private:
+  //! Read the value at position i of a value array
+  float value_at(const void *values, size_t i) const;
+
+  //! Insert a posting, keeping the list ordered by id
+  static void insert_posting(PostingList *list, node_id_t id, float value);
+
+  //! Recompute the blocks starting from the given one
+  static void update_blocks(PostingList *list, size_t first_block);
+
+ private:
+  IndexMeta::DataType data_type_{IndexMeta::DataType::DT_FP32};
+  std::unordered_map<uint32_t, PostingList> postings_{};
+  node_id_t doc_count_{0};
+  mutable ailego::SharedMutex mutex_{};
+};
+
+}  // namespace core
+}  // namespace zvec
@@ -0,0 +1,40 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+namespace zvec {
+namespace core {
+
+//! Upper bounds are scaled by the heap factor before they are compared with
+//! the top-k threshold, 1.0 keeps the search exact and smaller values trade
+//! recall for skipping more postings
+static const std::string PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR(
+    "proxima.inverted.sparse_streamer.heap_factor");
+static const std::string PARAM_INVERTED_SPARSE_SEARCHER_HEAP_FACTOR(
+    "proxima.inverted.sparse_searcher.heap_factor");
+
+//! Posting lists dumped next to the flat sparse segments
+static const std::string PARAM_INVERTED_SPARSE_DUMP_POSTINGS_SEG_ID =
+    "inverted_sparse_searcher_postings_segment";
+
+//! Posting lists flushed by the streamer. A segment cannot grow, so postings
+//! outgrowing theirs move to the next generation, suffixed to the prefix
+static const std::string PARAM_INVERTED_SPARSE_POSTINGS_SEG_ID_PREFIX =
+    "inverted_sparse_streamer_postings_";
+
+}  // namespace core
+}  // namespace zvec
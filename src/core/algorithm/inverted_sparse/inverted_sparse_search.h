@@ -0,0 +1,125 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "flat_sparse/flat_sparse_search.h"
+#include "inverted_sparse_context.h"
+#include "inverted_sparse_index.h"
+
+namespace zvec {
+namespace core {
+
+//! Search through the posting lists, or scan the entity linearly when
+//! exhaustive, by primary keys or grouped
+static inline int InvertedSparseSearch(
+    const uint32_t *sparse_count, const uint32_t *sparse_indices,
+    const void *sparse_query, bool exhaustive, bool with_p_keys,
+    const std::vector<std::vector<uint64_t>> &p_keys,
+    const IndexQueryMeta &qmeta, uint32_t count,
+    IndexContext::Pointer &context, const FlatSparseEntity *entity,
+    const InvertedSparseIndex *index) {
+  int ret;
+
+  InvertedSparseContext *ctx =
+      dynamic_cast<InvertedSparseContext *>(context.get());
+  ailego_do_if_false(ctx) {
+    LOG_ERROR("Cast context to InvertedSparseContext failed");
+    return IndexError_Cast;
+  }
+
+  ctx->reset_results(count);
+
+  const uint32_t *sparse_indices_tmp = sparse_indices;
+  const void *sparse_query_tmp = sparse_query;
+
+  for (size_t q = 0; q < count; ++q) {
+    if (ctx->group_by_search()) {
+      if (!ctx->group_by().is_valid()) {
+        LOG_ERROR("Invalid group-by function");
+        return IndexError_InvalidArgument;
+      }
+      std::function<std::string(uint64_t)> group_by = [&](uint64_t key) {
+        return ctx->group_by()(key);
+      };
+
+      std::string sparse_query_buffer;
+      ailego::MinusInnerProductSparseMatrix<float>::transform_sparse_format(
+          sparse_count[q], sparse_indices_tmp, sparse_query_tmp,
+          sparse_query_buffer);
+
+      std::unordered_map<std::string, IndexDocumentHeap> group_heap{};
+      if (with_p_keys) {
+        ret = entity->search_group_p_keys(sparse_query_buffer, p_keys[q],
+                                          ctx->filter(), group_by,
+                                          ctx->group_topk(), &group_heap);
+      } else {
+        ret = entity->search_group(sparse_query_buffer, ctx->filter(), group_by,
+                                   ctx->group_topk(), &group_heap);
+      }
+      if (ailego_unlikely(ret != 0)) {
+        LOG_ERROR("Failed to search group, ret=%s", IndexError::What(ret));
+        return ret;
+      }
+
+      for (auto &group : group_heap) {
+        group.second.sort();
+      }
+      auto group_result =
+          ConvertGroupMapToResult(std::move(group_heap), ctx->group_num());
+      ctx->mutable_group_result(q)->swap(group_result);
+    } else {
+      auto heap = ctx->result_heap();
+      heap->clear();
+
+      if (exhaustive || with_p_keys) {
+        std::string sparse_query_buffer;
+        ailego::MinusInnerProductSparseMatrix<float>::transform_sparse_format(
+            sparse_count[q], sparse_indices_tmp, sparse_query_tmp,
+            sparse_query_buffer);
+        if (with_p_keys) {
+          ret = entity->search_p_keys(sparse_query_buffer, p_keys[q],
+                                      ctx->filter(), heap);
+        } else {
+          ret = entity->search(sparse_query_buffer, ctx->filter(), heap);
+        }
+      } else {
+        auto terms = ctx->query_terms();
+        index->make_query(sparse_count[q], sparse_indices_tmp,
+                          sparse_query_tmp, terms);
+
+        InvertedSparseIndex::SearchStats stats;
+        ret = index->search(*terms, *entity, ctx->filter(),
+                            ctx->heap_factor(), heap, &stats);
+        ctx->mutable_stats(q)->set_dist_calced_count(stats.scored_count);
+        ctx->mutable_stats(q)->set_filtered_count(stats.filtered_count);
+      }
+      if (ailego_unlikely(ret != 0)) {
+        LOG_ERROR("Failed to search, ret=%s", IndexError::What(ret));
+        return ret;
+      }
+
+      ctx->topk_to_result(q);
+    }
+
+    sparse_indices_tmp += sparse_count[q];
+    sparse_query_tmp = reinterpret_cast<const char *>(sparse_query_tmp) +
+                       sparse_count[q] * qmeta.unit_size();
+  }
+
+  return 0;
+}
+
+}  // namespace core
+}  // namespace zvec
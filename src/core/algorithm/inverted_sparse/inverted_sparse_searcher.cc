@@ -0,0 +1,216 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "inverted_sparse_searcher.h"
+#include <utility/sparse_utility.h>
+#include <zvec/core/framework/index_error.h>
+#include <zvec/core/framework/index_factory.h>
+#include "flat_sparse/flat_sparse_provider.h"
+#include "inverted_sparse_context.h"
+#include "inverted_sparse_params.h"
+#include "inverted_sparse_search.h"
+
+namespace zvec {
+namespace core {
+
+const uint32_t InvertedSparseSearcher::VERSION = 0U;
+
+InvertedSparseSearcher::InvertedSparseSearcher(void) {}
+
+InvertedSparseSearcher::~InvertedSparseSearcher(void) {}
+
+int InvertedSparseSearcher::init(const ailego::Params &params) {
+  params_ = params;
+  state_ = STATE_INITED;
+
+  return 0;
+}
+
+int InvertedSparseSearcher::cleanup(void) {
+  this->unload();
+  params_.clear();
+  return 0;
+}
+
+int InvertedSparseSearcher::load(IndexStorage::Pointer container,
+                                 IndexMetric::Pointer /*measure*/) {
+  if (state_ != STATE_INITED) {
+    LOG_ERROR("Init the searcher first before load index");
+    return IndexError_Runtime;
+  }
+
+  LOG_INFO("Begin InvertedSparseSearcher::load");
+
+  int ret = IndexHelper::DeserializeFromStorage(container.get(), &meta_);
+  if (ret != 0) {
+    LOG_ERROR("Failed to deserialize meta from container");
+    return ret;
+  }
+
+  if (meta_.searcher_revision() != VERSION) {
+    LOG_ERROR("Unsupported searcher revision %u", meta_.searcher_revision());
+    return IndexError_Unsupported;
+  }
+
+  // The searcher params take precedence over the dumped ones
+  heap_factor_ = 1.0f;
+  meta_.searcher_params().get(PARAM_INVERTED_SPARSE_SEARCHER_HEAP_FACTOR,
+                              &heap_factor_);
+  params_.get(PARAM_INVERTED_SPARSE_SEARCHER_HEAP_FACTOR, &heap_factor_);
+  if (heap_factor_ <= 0.0f || heap_factor_ > 1.0f) {
+    LOG_ERROR("Invalid %s %f, expected in (0, 1]",
+              PARAM_INVERTED_SPARSE_SEARCHER_HEAP_FACTOR.c_str(),
+              heap_factor_);
+    return IndexError_InvalidArgument;
+  }
+
+  ret = index_.init(meta_.data_type());
+  if (ret != 0) {
+    return ret;
+  }
+
+  ret = entity_.load(container, meta_);
+  if (ret != 0) {
+    LOG_ERROR("InvertedSparseSearcher load index failed");
+    return ret;
+  }
+
+  // Indexes dumped without posting lists have them rebuilt from the vectors
+  auto segment = container->get(PARAM_INVERTED_SPARSE_DUMP_POSTINGS_SEG_ID);
+  const void *data = nullptr;
+  if (segment &&
+      segment->read(0, &data, segment->data_size()) == segment->data_size() &&
+      index_.deserialize(data, segment->data_size()) == 0 &&
+      index_.doc_count() == entity_.doc_cnt()) {
+    LOG_INFO("Loaded %zu posting lists", index_.term_count());
+  } else {
+    index_.clear();
+    ret = index_.build(entity_);
+    if (ret != 0) {
+      LOG_ERROR("Failed to build posting lists, ret=%s",
+                IndexError::What(ret));
+      entity_.unload();
+      index_.clear();
+      return ret;
+    }
+  }
+
+  state_ = STATE_LOADED;
+  magic_ = IndexContext::GenerateMagic();
+
+  LOG_INFO("End InvertedSparseSearcher::load");
+
+  return 0;
+}
+
+int InvertedSparseSearcher::unload(void) {
+  LOG_INFO("Begin InvertedSparseSearcher::unload");
+
+  meta_.clear();
+  index_.clear();
+  entity_.unload();
+  state_ = STATE_INITED;
+
+  LOG_INFO("End InvertedSparseSearcher::unload");
+
+  return 0;
+}
+
+int InvertedSparseSearcher::get_sparse_vector(
+    uint64_t key, uint32_t *sparse_count, std::string *sparse_indices_buffer,
+    std::string *sparse_values_buffer) const {
+  if (state_ != STATE_LOADED) {
+    LOG_ERROR("Failed to get sparse vector, load container first!");
+    return IndexError_NoIndexLoaded;
+  }
+
+  std::string sparse_data;
+
+  int ret = entity_.get_sparse_vector(key, &sparse_data);
+  if (ailego_unlikely(ret != 0)) {
+    LOG_ERROR("Failed to get sparse vector, key=%zu, ret=%s", (size_t)key,
+              IndexError::What(ret));
+    return ret;
+  }
+
+  SparseUtility::ReverseSparseFormat(sparse_data, sparse_count,
+                                     sparse_indices_buffer,
+                                     sparse_values_buffer, meta_.unit_size());
+
+  return 0;
+}
+
+InvertedSparseSearcher::ContextPointer InvertedSparseSearcher::create_context()
+    const {
+  if (state_ != STATE_LOADED) {
+    LOG_ERROR("Failed to create Context, load container first!");
+    return Context::UPointer();
+  }
+  return InvertedSparseSearcher::ContextPointer(
+      new InvertedSparseContext(this));
+}
+
+//! Create a new iterator
+IndexSearcher::SparseProvider::Pointer
+InvertedSparseSearcher::create_sparse_provider(void) const {
+  if (state_ != STATE_LOADED) {
+    LOG_ERROR("Failed to create provider, load container first!");
+    return SparseProvider::Pointer();
+  }
+
+  auto entity = entity_.clone();
+  if (ailego_unlikely(!entity)) {
+    LOG_ERROR("Clone entity failed");
+    return SparseProvider::Pointer();
+  }
+  return SparseProvider::Pointer(
+      new FlatSparseIndexProvider<FlatSparseSearcherEntity>(
+          entity, meta_, "InvertedSparseSearcher"));
+}
+
+int InvertedSparseSearcher::do_search(
+    const uint32_t *sparse_count, const uint32_t *sparse_indices,
+    const void *sparse_query, bool exhaustive, bool with_p_keys,
+    const std::vector<std::vector<uint64_t>> &p_keys,
+    const IndexQueryMeta &qmeta, uint32_t count,
+    ContextPointer &context) const {
+  if (state_ != STATE_LOADED) {
+    LOG_ERROR("Failed to do search, load container first!");
+    return IndexError_NoIndexLoaded;
+  }
+
+  int ret = check_params(qmeta);
+  if (ailego_unlikely(ret != 0)) {
+    return ret;
+  }
+
+  InvertedSparseContext *ctx =
+      dynamic_cast<InvertedSparseContext *>(context.get());
+  ailego_do_if_false(ctx) {
+    LOG_ERROR("Cast context to InvertedSparseContext failed");
+    return IndexError_Cast;
+  }
+  if (ctx->magic() != magic_) {
+    ctx->reset(this);
+  }
+
+  return InvertedSparseSearch(sparse_count, sparse_indices, sparse_query,
+                              exhaustive, with_p_keys, p_keys, qmeta, count,
+                              context, &entity_, &index_);
+}
+
+INDEX_FACTORY_REGISTER_SEARCHER(InvertedSparseSearcher);
+
+}  // namespace core
+}  // namespace zvec
@@ -0,0 +1,524 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "inverted_sparse_streamer.h"
+#include <cstdint>
+#include <utility/sparse_utility.h>
+#include <zvec/core/framework/index_error.h>
+#include <zvec/core/framework/index_factory.h>
+#include <zvec/core/framework/index_meta.h>
+#include "flat_sparse/flat_sparse_provider.h"
+#include "inverted_sparse_context.h"
+#include "inverted_sparse_params.h"
+#include "inverted_sparse_search.h"
+
+namespace zvec {
+namespace core {
+
+const uint32_t InvertedSparseStreamer::VERSION = 0U;
+
+InvertedSparseStreamer::InvertedSparseStreamer() : entity_(stats_) {}
+
+InvertedSparseStreamer::~InvertedSparseStreamer() {
+  this->close();
+}
+
+int InvertedSparseStreamer::init(const IndexMeta &imeta,
+                                 const ailego::Params &params) {
+  LOG_DEBUG("InvertedSparseStreamer init");
+
+  // Posting lists accumulate inner products only
+  if (imeta.metric_name() != "InnerProductSparse") {
+    LOG_ERROR("Unsupported metric %s, expected InnerProductSparse",
+              imeta.metric_name().c_str());
+    return IndexError_Unsupported;
+  }
+
+  params.get(PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR, &heap_factor_);
+  if (heap_factor_ <= 0.0f || heap_factor_ > 1.0f) {
+    LOG_ERROR("Invalid %s %f, expected in (0, 1]",
+              PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR.c_str(),
+              heap_factor_);
+    return IndexError_InvalidArgument;
+  }
+
+  int ret = index_.init(imeta.data_type());
+  if (ret != 0) {
+    return ret;
+  }
+
+  meta_ = imeta;
+  meta_.set_streamer("InvertedSparseStreamer", VERSION, params);
+
+  state_ = STATE_INITED;
+
+  return 0;
+}
+
+int InvertedSparseStreamer::cleanup() {
+  LOG_DEBUG("InvertedSparseStreamer cleanup");
+
+  this->close();
+
+  meta_.clear();
+  heap_factor_ = 1.0f;
+
+  return 0;
+}
+
+int InvertedSparseStreamer::open(IndexStorage::Pointer stg) {
+  LOG_DEBUG("InvertedSparseStreamer open");
+
+  if (ailego_unlikely(state_ != STATE_INITED)) {
+    LOG_ERROR("Open storage failed, init streamer first!");
+    return IndexError_NoReady;
+  }
+
+  storage_ = stg;
+  int ret = entity_.open(std::move(stg), meta_);
+  if (ret != 0) {
+    LOG_ERROR("InvertedSparseStreamer entity failed to open storage");
+    storage_.reset();
+    return ret;
+  }
+
+  IndexMeta index_meta;
+  ret = entity_.get_index_sparse_meta(&index_meta);
+  if (ret == IndexError_NoExist) {
+    // Set IndexMeta for the new index
+    ret = entity_.set_index_sparse_meta(meta_);
+    if (ret != 0) {
+      LOG_ERROR("Failed to set index meta for %s", IndexError::What(ret));
+      return ret;
+    }
+  } else {
+    if (index_meta.streamer_revision() != meta_.streamer_revision()) {
+      LOG_ERROR("Streamer revision mismatch, expect=%u, actual=%u",
+                meta_.streamer_revision(), index_meta.streamer_revision());
+      return IndexError_Mismatch;
+    }
+    if (index_meta.metric_name() != meta_.metric_name() ||
+        index_meta.data_type() != meta_.data_type()) {
+      LOG_ERROR("IndexMeta mismatch from the previous in index");
+      return IndexError_Mismatch;
+    }
+  }
+
+  ret = load_postings();
+  if (ret != 0) {
+    entity_.close();
+    index_.clear();
+    postings_segment_.reset();
+    storage_.reset();
+    return ret;
+  }
+
+  state_ = STATE_OPENED;
+  magic_ = IndexContext::GenerateMagic();
+
+  return 0;
+}
+
+int InvertedSparseStreamer::close() {
+  if (state_ != STATE_OPENED) {
+    return 0;
+  }
+
+  LOG_DEBUG("InvertedSparseStreamer close");
+
+  stats_.clear();
+  index_.clear();
+  postings_segment_.reset();
+  storage_.reset();
+  int ret = entity_.close();
+  if (ret != 0) {
+    LOG_ERROR("Failed to close entity %s", IndexError::What(ret));
+    return ret;
+  }
+  state_ = STATE_INITED;
+  return 0;
+}
+
+int InvertedSparseStreamer::flush(uint64_t checkpoint) {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to flush, open streamer first!");
+    return IndexError_NoReady;
+  }
+
+  LOG_INFO("InvertedSparseStreamer flush, checkpoint=%zu", (size_t)checkpoint);
+
+  int ret = store_postings();
+  if (ret != 0) {
+    return ret;
+  }
+  return entity_.flush(checkpoint);
+}
+
+int InvertedSparseStreamer::load_postings(void) {
+  // The newest generation holds the posting lists of the last flush
+  postings_generation_ = 0U;
+  while (storage_->has(ailego::StringHelper::Concat(
+      PARAM_INVERTED_SPARSE_POSTINGS_SEG_ID_PREFIX, postings_generation_))) {
+    ++postings_generation_;
+  }
+  if (postings_generation_ != 0U) {
+    postings_segment_ = storage_->get(ailego::StringHelper::Concat(
+        PARAM_INVERTED_SPARSE_POSTINGS_SEG_ID_PREFIX,
+        postings_generation_ - 1));
+  }
+
+  if (postings_segment_) {
+    const void *data = nullptr;
+    uint64_t size = 0;
+    if (postings_segment_->fetch(0, &size, sizeof(size)) == sizeof(size) &&
+        size != 0 &&
+        postings_segment_->read(sizeof(size), &data, size) == size &&
+        index_.deserialize(data, size) == 0) {
+      // Vectors added after the flush are missing from the postings
+      if (index_.doc_count() == entity_.doc_cnt()) {
+        return 0;
+      }
+      LOG_WARN("Flushed posting lists cover %u of %u docs, rebuilding",
+               index_.doc_count(), entity_.doc_cnt());
+    }
+    index_.clear();
+  }
+
+  int ret = index_.build(entity_);
+  if (ret != 0) {
+    LOG_ERROR("Failed to build posting lists, ret=%s", IndexError::What(ret));
+    return ret;
+  }
+  return 0;
+}
+
+int InvertedSparseStreamer::store_postings(void) {
+  std::string buffer(sizeof(uint64_t), '\0');
+  index_.serialize(&buffer);
+  const uint64_t size = buffer.size() - sizeof(uint64_t);
+
+  // Outgrown postings move to a new generation twice their size, the older
+  // ones are left behind as the storage cannot drop segments
+  if (!postings_segment_ || postings_segment_->capacity() < buffer.size()) {
+    const std::string segment_id = ailego::StringHelper::Concat(
+        PARAM_INVERTED_SPARSE_POSTINGS_SEG_ID_PREFIX, postings_generation_);
+    const size_t capacity = 2 * buffer.size();
+    int ret = storage_->append(segment_id, capacity);
+    if (ret != 0) {
+      LOG_ERROR("Failed to append postings segment %s, ret=%s",
+                segment_id.c_str(), IndexError::What(ret));
+      return ret;
+    }
+    postings_segment_ = storage_->get(segment_id);
+    if (!postings_segment_) {
+      LOG_ERROR("Failed to get postings segment %s", segment_id.c_str());
+      return IndexError_Runtime;
+    }
+    ++postings_generation_;
+    *stats_.mutable_index_size() += capacity;
+  }
+
+  // The size goes last, a torn write leaves the postings unreadable rather
+  // than wrong
+  const uint64_t zero = 0;
+  if (postings_segment_->write(0, &zero, sizeof(zero)) != sizeof(zero) ||
+      postings_segment_->write(sizeof(size), buffer.data() + sizeof(size),
+                               size) != size ||
+      postings_segment_->write(0, &size, sizeof(size)) != sizeof(size)) {
+    LOG_ERROR("Failed to write postings segment");
+    return IndexError_WriteData;
+  }
+  return 0;
+}
+
+int InvertedSparseStreamer::dump(const IndexDumper::Pointer &dumper) {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to dump, open streamer first!");
+    return IndexError_NoReady;
+  }
+
+  LOG_INFO("InvertedSparseStreamer dump");
+
+  shared_mutex_.lock();
+  AILEGO_DEFER([&]() { shared_mutex_.unlock(); });
+
+  ailego::Params searcher_params;
+  searcher_params.set(PARAM_INVERTED_SPARSE_SEARCHER_HEAP_FACTOR, heap_factor_);
+  meta_.set_searcher("InvertedSparseSearcher", VERSION, searcher_params);
+
+  int ret = IndexHelper::SerializeToDumper(meta_, dumper.get());
+  if (ret != 0) {
+    LOG_ERROR("Failed to serialize meta into dumper.");
+    return ret;
+  }
+
+  ret = entity_.dump(dumper);
+  if (ret != 0) {
+    return ret;
+  }
+
+  // The searcher loads the postings instead of rebuilding them
+  std::string buffer;
+  index_.serialize(&buffer);
+  size_t padding_size = ailego_align(buffer.size(), 32) - buffer.size();
+  buffer.append(padding_size, '\0');
+  if (dumper->write(buffer.data(), buffer.size()) != buffer.size()) {
+    LOG_ERROR("Failed to write posting lists to dumper %s",
+              dumper->name().c_str());
+    return IndexError_WriteData;
+  }
+  return dumper->append(PARAM_INVERTED_SPARSE_DUMP_POSTINGS_SEG_ID,
+                        buffer.size() - padding_size, padding_size, 0);
+}
+
+InvertedSparseStreamer::ContextPointer InvertedSparseStreamer::create_context()
+    const {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to create Context, open streamer first!");
+    return Context::UPointer();
+  }
+  return InvertedSparseStreamer::ContextPointer(
+      new InvertedSparseContext(this));
+}
+
+IndexStreamer::SparseProvider::Pointer
+InvertedSparseStreamer::create_sparse_provider(void) const {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to create provider, open streamer first!");
+    return SparseProvider::Pointer();
+  }
+
+  auto entity = entity_.clone();
+  if (ailego_unlikely(!entity)) {
+    LOG_ERROR("Clone entity failed");
+    return SparseProvider::Pointer();
+  }
+  return SparseProvider::Pointer(
+      new FlatSparseIndexProvider<FlatSparseStreamerEntity>(
+          entity, meta_, "InvertedSparseStreamerProvider"));
+}
+
+int InvertedSparseStreamer::add_impl(uint64_t pkey,
+                                     const uint32_t sparse_count,
+                                     const uint32_t *sparse_indices,
+                                     const void *sparse_query,
+                                     const IndexQueryMeta &qmeta,
+                                     Context::Pointer &context) {
+  return add_vector(pkey, false, sparse_count, sparse_indices, sparse_query,
+                    qmeta, context);
+}
+
+int InvertedSparseStreamer::add_with_id_impl(uint32_t pkey,
+                                             const uint32_t sparse_count,
+                                             const uint32_t *sparse_indices,
+                                             const void *sparse_query,
+                                             const IndexQueryMeta &qmeta,
+                                             Context::Pointer &context) {
+  return add_vector(pkey, true, sparse_count, sparse_indices, sparse_query,
+                    qmeta, context);
+}
+
+int InvertedSparseStreamer::add_vector(uint64_t pkey, bool with_id,
+                                       const uint32_t sparse_count,
+                                       const uint32_t *sparse_indices,
+                                       const void *sparse_query,
+                                       const IndexQueryMeta &qmeta,
+                                       Context::Pointer &context) {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to add vector, open streamer first!");
+    (*stats_.mutable_discarded_count())++;
+    return IndexError_NoReady;
+  }
+
+  int ret = check_params(qmeta);
+  if (ailego_unlikely(ret != 0)) {
+    (*stats_.mutable_discarded_count())++;
+    return ret;
+  }
+
+  if (ailego_unlikely(sparse_count > PARAM_FLAT_SPARSE_MAX_DIM_SIZE)) {
+    LOG_ERROR(
+        "Failed to add sparse vector: number of non-zero elements (%u) exceeds "
+        "maximum allowed (%u), key=%zu",
+        sparse_count, PARAM_FLAT_SPARSE_MAX_DIM_SIZE, (size_t)pkey);
+    (*stats_.mutable_discarded_count())++;
+    return IndexError_InvalidValue;
+  }
+
+  InvertedSparseContext *ctx =
+      dynamic_cast<InvertedSparseContext *>(context.get());
+  ailego_do_if_false(ctx) {
+    LOG_ERROR("Cast context to InvertedSparseContext failed");
+    (*stats_.mutable_discarded_count())++;
+    return IndexError_Cast;
+  }
+
+  if (ailego_unlikely(!shared_mutex_.try_lock_shared())) {
+    LOG_ERROR("Cannot add vector while dumping index");
+    (*stats_.mutable_discarded_count())++;
+    return IndexError_Unsupported;
+  }
+  AILEGO_DEFER([&]() { shared_mutex_.unlock_shared(); });
+
+  // convert to sparse format and add to entity
+  std::string sparse_query_buffer;
+  SparseUtility::TransSparseFormat(sparse_count, sparse_indices, sparse_query,
+                                   meta_.unit_size(), sparse_query_buffer);
+
+  if (with_id) {
+    ret = entity_.add_vector_with_id(static_cast<uint32_t>(pkey),
+                                     sparse_query_buffer, sparse_count);
+  } else {
+    ret = entity_.add(pkey, sparse_query_buffer, sparse_count);
+  }
+  if (ret != 0) {
+    LOG_ERROR("Failed to add sparse vector, key=%zu, ret=%s", (size_t)pkey,
+              IndexError::What(ret));
+    (*stats_.mutable_discarded_count())++;
+    return ret;
+  }
+
+  ret = index_.add(entity_.get_id(pkey), sparse_query_buffer.data());
+  if (ret != 0) {
+    LOG_ERROR("Failed to index sparse vector, key=%zu, ret=%s", (size_t)pkey,
+              IndexError::What(ret));
+    (*stats_.mutable_discarded_count())++;
+    return ret;
+  }
+
+  (*stats_.mutable_added_count())++;
+  return 0;
+}
+
+//! Similarity search with sparse inputs
+int InvertedSparseStreamer::search_impl(const uint32_t sparse_count,
+                                        const uint32_t *sparse_indices,
+                                        const void *sparse_query,
+                                        const IndexQueryMeta &qmeta,
+                                        Context::Pointer &context) const {
+  return search_impl(&sparse_count, sparse_indices, sparse_query, qmeta, 1,
+                     context);
+}
+
+//! Similarity search with sparse inputs
+int InvertedSparseStreamer::search_impl(const uint32_t *sparse_count,
+                                        const uint32_t *sparse_indices,
+                                        const void *sparse_query,
+                                        const IndexQueryMeta &qmeta,
+                                        uint32_t count,
+                                        Context::Pointer &context) const {
+  return do_search(sparse_count, sparse_indices, sparse_query, false, false,
+                   {}, qmeta, count, context);
+}
+
+//! Similarity brute force search with sparse inputs
+int InvertedSparseStreamer::search_bf_impl(const uint32_t sparse_count,
+                                           const uint32_t *sparse_indices,
+                                           const void *sparse_query,
+                                           const IndexQueryMeta &qmeta,
+                                           Context::Pointer &context) const {
+  return search_bf_impl(&sparse_count, sparse_indices, sparse_query, qmeta, 1,
+                        context);
+}
+
+//! Similarity brute force search with sparse inputs
+int InvertedSparseStreamer::search_bf_impl(const uint32_t *sparse_count,
+                                           const uint32_t *sparse_indices,
+                                           const void *sparse_query,
+                                           const IndexQueryMeta &qmeta,
+                                           uint32_t count,
+                                           Context::Pointer &context) const {
+  return do_search(sparse_count, sparse_indices, sparse_query, true, false, {},
+                   qmeta, count, context);
+}
+
+//! Linear search by primary keys
+int InvertedSparseStreamer::search_bf_by_p_keys_impl(
+    const uint32_t sparse_count, const uint32_t *sparse_indices,
+    const void *sparse_query, const std::vector<std::vector<uint64_t>> &p_keys,
+    const IndexQueryMeta &qmeta, ContextPointer &context) const {
+  return search_bf_by_p_keys_impl(&sparse_count, sparse_indices, sparse_query,
+                                  p_keys, qmeta, 1, context);
+}
+
+//! Linear search by primary keys with sparse inputs
+int InvertedSparseStreamer::search_bf_by_p_keys_impl(
+    const uint32_t *sparse_count, const uint32_t *sparse_indices,
+    const void *sparse_query, const std::vector<std::vector<uint64_t>> &p_keys,
+    const IndexQueryMeta &qmeta, uint32_t count,
+    ContextPointer &context) const {
+  return do_search(sparse_count, sparse_indices, sparse_query, true, true,
+                   p_keys, qmeta, count, context);
+}
+
+//! Fetch sparse vector by key
+int InvertedSparseStreamer::get_sparse_vector(
+    uint64_t key, uint32_t *sparse_count, std::string *sparse_indices_buffer,
+    std::string *sparse_values_buffer) const {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to get_sparse_vector, open streamer first!");
+    return IndexError_NoReady;
+  }
+
+  std::string sparse_data;
+
+  int ret = entity_.get_sparse_vector_by_key(key, &sparse_data);
+  if (ailego_unlikely(ret != 0)) {
+    LOG_ERROR("Failed to get sparse vector, key=%zu, ret=%s", (size_t)key,
+              IndexError::What(ret));
+    return ret;
+  }
+
+  SparseUtility::ReverseSparseFormat(sparse_data, sparse_count,
+                                     sparse_indices_buffer,
+                                     sparse_values_buffer, meta_.unit_size());
+
+  return 0;
+}
+
+int InvertedSparseStreamer::do_search(
+    const uint32_t *sparse_count, const uint32_t *sparse_indices,
+    const void *sparse_query, bool exhaustive, bool with_p_keys,
+    const std::vector<std::vector<uint64_t>> &p_keys,
+    const IndexQueryMeta &qmeta, uint32_t count,
+    ContextPointer &context) const {
+  if (state_ != STATE_OPENED) {
+    LOG_ERROR("Failed to do_search, open streamer first!");
+    return IndexError_NoReady;
+  }
+
+  int ret = check_params(qmeta);
+  if (ailego_unlikely(ret != 0)) {
+    return ret;
+  }
+
+  InvertedSparseContext *ctx =
+      dynamic_cast<InvertedSparseContext *>(context.get());
+  ailego_do_if_false(ctx) {
+    LOG_ERROR("Cast context to InvertedSparseContext failed");
+    return IndexError_Cast;
+  }
+  if (ctx->magic() != magic_) {
+    ctx->reset(this);
+  }
+
+  return InvertedSparseSearch(sparse_count, sparse_indices, sparse_query,
+                              exhaustive, with_p_keys, p_keys, qmeta, count,
+                              context, &entity_, &index_);
+}
+
+INDEX_FACTORY_REGISTER_STREAMER(InvertedSparseStreamer);
+
+}  // namespace core
+}  // namespace zvec
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "ivf_builder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ailego/algorithm/kmeans.h>
 #include <ailego/pattern/defer.h>
 #include <zvec/ailego/utility/string_helper.h>
 #include "algorithm/cluster/cluster_params.h"
@@ -188,12 +192,21 @@ int IVFBuilder::cleanup(void) {
   cluster_params_.clear();
 
   labels_.clear();
+  residual_sums_.clear();
+  residual_maxs_.clear();
+  centroid_list_.clear();
   centroid_index_.reset();
   holder_.reset();
   converted_meta_ = meta_;
   converter_.reset();
   quantized_meta_ = meta_;
   quantizers_.clear();
+  fastscan_.reset();
+  rebalance_enable_ = false;
+  rebalance_split_ratio_ = kDefaultRebalanceSplitRatio;
+  rebalance_merge_ratio_ = kDefaultRebalanceMergeRatio;
+  rebalance_imbalance_factor_ = kDefaultRebalanceImbalanceFactor;
+  rebalance_interval_ = 0u;
 
   error_ = false;
   err_code_ = 0;
@@ -301,11 +314,24 @@ int IVFBuilder::train(const IndexTrainer::Pointer &trainer) {
     converted_meta_ = meta;
   }
 
+  ret = this->build_centroid_index(centroid_list);
+  ivf_check_error_code(ret);
+
+  stats_.set_trained_costtime(timer.milli_seconds());
+
+  LOG_DEBUG("End IVFBuilder::train by trainer");
+
+  state_ = TRAINED;
+  return 0;
+}
+
+int IVFBuilder::build_centroid_index(
+    const IndexCluster::CentroidList &centroid_list) {
   centroid_index_ = std::make_shared<IVFCentroidIndex>();
   if (!centroid_index_) {
     return IndexError_NoMemory;
   }
-  ret = centroid_index_->init(converted_meta_, params_);
+  int ret = centroid_index_->init(converted_meta_, params_);
   ivf_check_error_code(ret);
 
   ret = centroid_index_->build(centroid_list);
@@ -329,11 +355,8 @@ int IVFBuilder::train(const IndexTrainer::Pointer &trainer) {
     ivf_check_with_msg(ret, "Failed to build centroid index");
   }
 
-  stats_.set_trained_costtime(timer.milli_seconds());
-
-  LOG_DEBUG("End IVFBuilder::train by trainer");
-
-  state_ = TRAINED;
+  //! Keep the levels of centroids, rebalancing replaces the leaves in place
+  centroid_list_ = centroid_list;
   return 0;
 }
 
@@ -387,13 +410,21 @@ int IVFBuilder::build(IndexThreads::Pointer threads,
   }
 
   labels_.resize(centroid_index_->centroids_count());
+  residual_sums_.assign(labels_.size(), 0.0);
+  residual_maxs_.assign(labels_.size(), 0.0f);
   int ret = this->build_label_index(threads.get(), converted_holder);
   ivf_check_with_msg(ret, "Failed to build index for %s",
                      IndexError::What(ret));
 
+  ret = this->check_and_rebalance(threads.get(), converted_holder);
+  ivf_check_with_msg(ret, "Failed to rebalance inverted lists");
+
   ret = this->prepare_quantizer(threads.get());
   ivf_check_error_code(ret);
 
+  ret = this->prepare_fastscan();
+  ivf_check_error_code(ret);
+
   stats_.set_built_costtime(timer.milli_seconds());
 
   LOG_INFO("End IVFBuilder::build");
@@ -575,6 +606,31 @@ int IVFBuilder::parse_general_params(const ailego::Params &params) {
     LOG_ERROR("block_vector_count * element_size not align with 32 bytes.");
     return IndexError_InvalidArgument;
   }
+
+  if (params.get_as_bool(PARAM_IVF_BUILDER_FASTSCAN_ENABLE)) {
+    fastscan_ = std::make_shared<IVFFastScan>();
+    int ret = fastscan_->init(
+        meta_, params.get_as_uint32(PARAM_IVF_BUILDER_FASTSCAN_SUBSPACE_COUNT));
+    ivf_check_with_msg(ret, "Failed to init fast scan");
+  }
+
+  params.get(PARAM_IVF_BUILDER_REBALANCE_ENABLE, &rebalance_enable_);
+  params.get(PARAM_IVF_BUILDER_REBALANCE_SPLIT_RATIO, &rebalance_split_ratio_);
+  params.get(PARAM_IVF_BUILDER_REBALANCE_MERGE_RATIO, &rebalance_merge_ratio_);
+  params.get(PARAM_IVF_BUILDER_REBALANCE_IMBALANCE_FACTOR,
+             &rebalance_imbalance_factor_);
+  params.get(PARAM_IVF_BUILDER_REBALANCE_INTERVAL, &rebalance_interval_);
+  if (rebalance_split_ratio_ <= 1.0f || rebalance_merge_ratio_ < 0.0f ||
+      rebalance_merge_ratio_ >= 1.0f) {
+    LOG_ERROR("Invalid rebalance split ratio %f or merge ratio %f",
+              rebalance_split_ratio_, rebalance_merge_ratio_);
+    return IndexError_InvalidArgument;
+  }
+  if (rebalance_imbalance_factor_ < 1.0f) {
+    LOG_ERROR("Invalid rebalance imbalance factor %f, expected >= 1.0",
+              rebalance_imbalance_factor_);
+    return IndexError_InvalidArgument;
+  }
   return 0;
 }
 
@@ -626,6 +682,7 @@ int IVFBuilder::build_label_index(IndexThreads *threads,
   });
 
   size_t elem_size = holder->element_size();
+  size_t next_check = rebalance_interval_;
   std::shared_ptr<VectorList> vectors = std::make_shared<VectorList>();
   ivf_assert(vectors, IndexError_NoMemory);
   for (; iter && iter->is_valid(); iter->next()) {
@@ -640,6 +697,13 @@ int IVFBuilder::build_label_index(IndexThreads *threads,
       ivf_assert(vectors, IndexError_NoMemory);
       vectors->reserve(kBatchSize);
     }
+    //! Repair the drifted lists before labeling the following vectors
+    if (next_check != 0 && id >= next_check && id < holder_->count()) {
+      task_group->wait_finish();
+      int ret = this->check_and_rebalance(threads, holder);
+      ivf_check_with_msg(ret, "Failed to rebalance inverted lists");
+      next_check += rebalance_interval_;
+    }
     if (!(id & 0xFFFFF)) {
       LOG_INFO("Current built count:%zu", id);
     }
@@ -663,8 +727,9 @@ int IVFBuilder::dump_index(const IndexDumper::Pointer &dumper) {
 
   //! Dump inverted vectors
   std::vector<uint32_t> dumped_ids;
+  std::vector<size_t> list_ends;
   std::function<void(uint32_t)> record_dumped_id = [&](uint32_t) {};
-  if (store_original_features_) {
+  if (store_original_features_ || fastscan_) {
     dumped_ids.reserve(holder_->count());
     record_dumped_id = [&](uint32_t id) { dumped_ids.emplace_back(id); };
   }
@@ -679,6 +744,7 @@ int IVFBuilder::dump_index(const IndexDumper::Pointer &dumper) {
                                                holder_->element(id));
         ivf_check_error_code(ret);
       }
+      list_ends.push_back(dumped_ids.size());
     }
   } else {
     for (size_t i = 0; i < centroid_index_->centroids_count(); ++i) {
@@ -700,6 +766,7 @@ int IVFBuilder::dump_index(const IndexDumper::Pointer &dumper) {
             ivf_dumper->dump_inverted_vector(i, holder_->key(id), iter->data());
         ivf_check_error_code(ret);
       }
+      list_ends.push_back(dumped_ids.size());
     }
   }
 
@@ -715,6 +782,33 @@ int IVFBuilder::dump_index(const IndexDumper::Pointer &dumper) {
                                         centroid_index->size());
   ivf_check_with_msg(ret, "Failed to dump CentroidIndex");
 
+  ret = ivf_dumper->dump_centroid_stats(this->centroid_stats());
+  ivf_check_with_msg(ret, "Failed to dump centroid stats");
+
+  if (fastscan_) {
+    //! Pack the codes in the same order as the inverted vectors
+    const size_t block_vecs = IVFFastScan::kBlockVectorCount;
+    const float *vecs[IVFFastScan::kBlockVectorCount];
+    std::string codes;
+    size_t begin = 0;
+    for (size_t end : list_ends) {
+      for (size_t i = begin; i < end; i += block_vecs) {
+        size_t count = std::min(block_vecs, end - i);
+        for (size_t k = 0; k < count; ++k) {
+          vecs[k] = static_cast<const float *>(
+              holder_->element(dumped_ids[i + k]));
+        }
+        size_t off = codes.size();
+        codes.resize(off + fastscan_->block_size());
+        fastscan_->encode_block(vecs, count,
+                                reinterpret_cast<uint8_t *>(&codes[off]));
+      }
+      begin = end;
+    }
+    ret = ivf_dumper->dump_fastscan(*fastscan_, codes);
+    ivf_check_with_msg(ret, "Failed to dump fast scan codes");
+  }
+
   if (store_original_features_) {
     for (size_t i = 0; i < dumped_ids.size(); ++i) {
       ret = ivf_dumper->dump_original_vector(holder_->element(dumped_ids[i]),
@@ -823,6 +917,248 @@ int IVFBuilder::prepare_quantizer(IndexThreads *threads) {
   return 0;
 }
 
+int IVFBuilder::prepare_fastscan(void) {
+  if (!fastscan_) {
+    return 0;
+  }
+  if (holder_->count() < IVFFastScan::kCentroidCount) {
+    LOG_WARN("Too few vectors %zu for fast scan, disable it",
+             holder_->count());
+    fastscan_.reset();
+    return 0;
+  }
+
+  int ret = fastscan_->train(holder_);
+  ivf_check_with_msg(ret, "Failed to train fast scan codebook");
+
+  LOG_INFO("Trained fast scan codebook, subspaces=%u",
+           fastscan_->subspace_count());
+  return 0;
+}
+
+std::vector<InvertedCentroidStats> IVFBuilder::centroid_stats(void) const {
+  std::vector<InvertedCentroidStats> stats(labels_.size());
+  for (size_t i = 0; i < labels_.size(); ++i) {
+    stats[i].vector_count = static_cast<uint32_t>(labels_[i].size());
+    if (!labels_[i].empty()) {
+      stats[i].residual_mean =
+          static_cast<float>(residual_sums_[i] / labels_[i].size());
+      stats[i].residual_max = residual_maxs_[i];
+    }
+  }
+  return stats;
+}
+
+float IVFBuilder::imbalance_factor(void) const {
+  std::vector<size_t> list_sizes(labels_.size());
+  for (size_t i = 0; i < labels_.size(); ++i) {
+    list_sizes[i] = labels_[i].size();
+  }
+  return IVFUtility::ComputeImbalanceFactor(list_sizes);
+}
+
+int IVFBuilder::check_and_rebalance(IndexThreads *threads,
+                                    const IndexHolder::Pointer &holder) {
+  if (!rebalance_enable_) {
+    return 0;
+  }
+  float factor = this->imbalance_factor();
+  if (factor <= rebalance_imbalance_factor_) {
+    LOG_DEBUG("Inverted lists are balanced enough, imbalance factor=%f",
+              factor);
+    return 0;
+  }
+  if (converted_meta_.data_type() != IndexMeta::DataType::DT_FP32) {
+    LOG_WARN("Rebalance supports fp32 vectors only, skip it");
+    return 0;
+  }
+  LOG_INFO("Rebalance inverted lists, imbalance factor=%f", factor);
+  return this->rebalance_lists(threads, holder);
+}
+
+int IVFBuilder::rebalance_lists(IndexThreads *threads,
+                                const IndexHolder::Pointer &holder) {
+  //! Detect the oversized and tiny lists among the labeled vectors
+  const size_t list_count = labels_.size();
+  size_t labeled_count = 0;
+  for (const auto &it : labels_) {
+    labeled_count += it.size();
+  }
+  const float avg = static_cast<float>(labeled_count) / list_count;
+  std::vector<bool> split(list_count, false);
+  std::vector<bool> merged(list_count, false);
+  size_t split_count = 0;
+  size_t merged_count = 0;
+  for (size_t i = 0; i < list_count; ++i) {
+    float size = static_cast<float>(labels_[i].size());
+    if (size > avg * rebalance_split_ratio_) {
+      split[i] = true;
+      ++split_count;
+    } else if (size < avg * rebalance_merge_ratio_) {
+      merged[i] = true;
+      ++merged_count;
+    }
+  }
+  if (split_count == 0 && merged_count == 0) {
+    LOG_INFO("No inverted list exceeds the split or merge ratio, lists=%zu",
+             list_count);
+    return 0;
+  }
+
+  //! Gather the vectors of the affected lists only
+  constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> slots(holder_->count(), kNoSlot);
+  for (size_t i = 0; i < list_count; ++i) {
+    if (split[i] || merged[i]) {
+      for (auto id : labels_[i]) {
+        slots[id] = 0;
+      }
+    }
+  }
+  auto moved = std::make_shared<VectorList>();
+  ivf_assert(moved, IndexError_NoMemory);
+  const size_t elem_size = holder->element_size();
+  if (holder.get() == holder_.get()) {
+    for (uint32_t id = 0; id < slots.size(); ++id) {
+      if (slots[id] != kNoSlot) {
+        slots[id] = static_cast<uint32_t>(moved->size());
+        moved->emplace_back(holder_->element(id), elem_size, id);
+      }
+    }
+  } else {
+    if (!holder->multipass()) {
+      LOG_WARN("Converted holder is not multipass, skip rebalance");
+      return 0;
+    }
+    uint32_t id = 0;
+    for (auto iter = holder->create_iterator(); iter && iter->is_valid();
+         iter->next(), ++id) {
+      if (slots[id] != kNoSlot) {
+        slots[id] = static_cast<uint32_t>(moved->size());
+        moved->emplace_back(iter->data(), elem_size, id);
+      }
+    }
+  }
+
+  //! Split the oversized lists by local k-means on their own vectors
+  const size_t dim = converted_meta_.dimension();
+  std::vector<IndexCluster::CentroidList> parts(list_count);
+  SingleQueueIndexThreads kmeans_threads(1, false);
+  for (size_t list_id = 0; list_id < list_count; ++list_id) {
+    if (!split[list_id]) {
+      continue;
+    }
+    const auto &members = labels_[list_id];
+    size_t part_count =
+        std::min({kRebalanceMaxSplitCount, members.size(),
+                  static_cast<size_t>(std::ceil(members.size() / avg))});
+
+    ailego::NumericalKmeans<float, SingleQueueIndexThreads> kmeans(part_count,
+                                                                   dim);
+    for (auto id : members) {
+      kmeans.append(static_cast<const float *>((*moved)[slots[id]].data()),
+                    dim);
+    }
+    ailego::Kmc2CentroidsGenerator<
+        ailego::NumericalKmeans<float, SingleQueueIndexThreads>,
+        SingleQueueIndexThreads>
+        gen;
+    kmeans.init_centroids(kmeans_threads, gen);
+    double cost = 0.0;
+    for (uint32_t iter = 0; iter < kRebalanceKmeansIters; ++iter) {
+      double old_cost = cost;
+      if (!kmeans.cluster_once(kmeans_threads, &cost) ||
+          std::abs(cost - old_cost) < std::numeric_limits<float>::epsilon()) {
+        break;
+      }
+    }
+    const auto &cents = kmeans.centroids();
+    for (size_t c = 0; c < cents.count(); ++c) {
+      parts[list_id].emplace_back(cents[c], dim * sizeof(float));
+    }
+    if (parts[list_id].empty()) {
+      LOG_WARN("Failed to split inverted list %zu, keep it", list_id);
+    }
+  }
+
+  //! Replace the affected leaves in place, so the upper levels are kept and
+  //! a parent loses its leaf only when the whole branch is merged away
+  std::vector<uint32_t> new_ids(list_count, kNoSlot);
+  uint32_t old_id = 0;
+  uint32_t new_id = 0;
+  std::function<void(IndexCluster::CentroidList *)> replace_leaves =
+      [&](IndexCluster::CentroidList *cents) {
+        IndexCluster::CentroidList result;
+        for (auto &it : *cents) {
+          if (!it.subitems().empty()) {
+            replace_leaves(it.mutable_subitems());
+            if (!it.subitems().empty()) {
+              result.emplace_back(std::move(it));
+            }
+            continue;
+          }
+          uint32_t id = old_id++;
+          if (merged[id]) {
+            continue;
+          }
+          if (split[id] && !parts[id].empty()) {
+            for (auto &part : parts[id]) {
+              result.emplace_back(std::move(part));
+              ++new_id;
+            }
+            continue;
+          }
+          new_ids[id] = new_id++;
+          result.emplace_back(std::move(it));
+        }
+        cents->swap(result);
+      };
+  IndexCluster::CentroidList centroid_list = centroid_list_;
+  replace_leaves(&centroid_list);
+  ivf_assert_with_msg(old_id == list_count, IndexError_Logic,
+                      "Mismatch centroids count");
+
+  //! Keep the unaffected lists, the moved vectors are labeled again below
+  std::vector<std::vector<uint32_t>> labels(new_id);
+  std::vector<double> residual_sums(new_id, 0.0);
+  std::vector<float> residual_maxs(new_id, 0.0f);
+  for (size_t i = 0; i < list_count; ++i) {
+    if (new_ids[i] != kNoSlot && !split[i]) {
+      labels[new_ids[i]].swap(labels_[i]);
+      residual_sums[new_ids[i]] = residual_sums_[i];
+      residual_maxs[new_ids[i]] = residual_maxs_[i];
+    }
+  }
+  labels_.swap(labels);
+  residual_sums_.swap(residual_sums);
+  residual_maxs_.swap(residual_maxs);
+
+  int ret = this->build_centroid_index(centroid_list);
+  ivf_check_with_msg(ret, "Failed to rebuild centroid index");
+  ivf_assert_with_msg(centroid_index_->centroids_count() == labels_.size(),
+                      IndexError_Logic, "Mismatch centroids count");
+
+  //! Label the moved vectors as the others, by the centroid index search
+  auto task_group = threads->make_group();
+  ivf_assert_with_msg(task_group, IndexError_Runtime,
+                      "Failed to create task group");
+  for (size_t i = 0; i < moved->size(); i += kBatchSize) {
+    auto vectors = std::make_shared<VectorList>(
+        moved->begin() + i,
+        moved->begin() + std::min(i + kBatchSize, moved->size()));
+    task_group->submit(
+        ailego::Closure::New(this, &IVFBuilder::label, vectors));
+  }
+  task_group->wait_finish();
+  ivf_assert(!error_, err_code_);
+
+  LOG_INFO(
+      "Rebalanced inverted lists, split=%zu merged=%zu lists=%zu->%zu "
+      "moved=%zu",
+      split_count, merged_count, list_count, labels_.size(), moved->size());
+  return 0;
+}
+
 INDEX_FACTORY_REGISTER_BUILDER(IVFBuilder);
 
 }  // namespace core
@@ -16,6 +16,7 @@
 #include <zvec/core/framework/index_builder.h>
 #include <zvec/core/framework/index_meta.h>
 #include "ivf_centroid_index.h"
+#include "ivf_fastscan.h"
 
 namespace zvec {
 namespace core {
@@ -64,6 +65,13 @@ class IVFBuilder : public IndexBuilder {
     return centroid_index_;
   }
 
+  //! Retrieve the statistics of inverted lists, valid after build
+  std::vector<InvertedCentroidStats> centroid_stats(void) const;
+
+  //! Retrieve the imbalance factor of the labeled inverted lists, the same
+  //! measure as IVFEntity::imbalance_factor()
+  float imbalance_factor(void) const;
+
  public:
   /*! Random Access Index Holder
    */
@@ -217,6 +225,9 @@ class IVFBuilder : public IndexBuilder {
   //! Prepare params for trainer
   int prepare_trainer_params(ailego::Params &params);
 
+  //! Build the centroid index and keep the centroid list
+  int build_centroid_index(const IndexCluster::CentroidList &centroid_list);
+
   //! Build the index
   int build_label_index(IndexThreads *threads,
                         const IndexHolder::Pointer &holder);
@@ -227,6 +238,17 @@ class IVFBuilder : public IndexBuilder {
   //! Prepare the quantizer for inverted index
   int prepare_quantizer(IndexThreads *threads);
 
+  //! Train the fast scan codebook for inverted lists
+  int prepare_fastscan(void);
+
+  //! Rebalance the inverted lists if the imbalance factor exceeds the limit
+  int check_and_rebalance(IndexThreads *threads,
+                          const IndexHolder::Pointer &holder);
+
+  //! Split the oversized inverted lists and merge the tiny ones
+  int rebalance_lists(IndexThreads *threads,
+                      const IndexHolder::Pointer &holder);
+
   //! Quantize the centrods list
   int quantize_centroids();
 
@@ -253,8 +275,10 @@ class IVFBuilder : public IndexBuilder {
     for (size_t i = 0; i < vecs->size(); ++i) {
       auto &vec = (*vecs)[i];
 
-      uint32_t centroid_idx =
-          centroid_index_->search_nearest_centroid(vec.data(), vec.size());
+      //! The residual is the distance the centroid search already computed
+      float residual = 0.0f;
+      uint32_t centroid_idx = centroid_index_->search_nearest_centroid(
+          vec.data(), vec.size(), &residual);
       if (centroid_idx == IVFCentroidIndex::kInvalidID) {
         LOG_ERROR("Failed to search nearest centroid in CentroidIndex");
         if (!error_.exchange(true)) {
@@ -265,6 +289,9 @@ class IVFBuilder : public IndexBuilder {
       ailego_assert_with(centroid_idx < labels_.size(), "Index Overflow");
       mutex_.lock();
       labels_[centroid_idx].emplace_back(vec.id());
+      residual_sums_[centroid_idx] += residual;
+      residual_maxs_[centroid_idx] =
+          std::max(residual_maxs_[centroid_idx], residual);
       mutex_.unlock();
     }
   }
@@ -275,6 +302,11 @@ class IVFBuilder : public IndexBuilder {
   static constexpr size_t kThreadPoolQueueSize = 300u;
   static constexpr size_t kBatchSize = 10u;
   static constexpr size_t kDefaultBlockCount = 32u;
+  static constexpr size_t kRebalanceMaxSplitCount = 8u;
+  static constexpr uint32_t kRebalanceKmeansIters = 16u;
+  static constexpr float kDefaultRebalanceSplitRatio = 3.0f;
+  static constexpr float kDefaultRebalanceMergeRatio = 0.1f;
+  static constexpr float kDefaultRebalanceImbalanceFactor = 1.5f;
 
   enum BuilderState { INIT = 0, INITED = 1, TRAINED = 2, BUILT = 3 };
 
@@ -290,7 +322,10 @@ class IVFBuilder : public IndexBuilder {
   std::vector<ailego::Params> cluster_params_{};
 
   std::vector<std::vector<uint32_t>> labels_{};
+  std::vector<double> residual_sums_{};
+  std::vector<float> residual_maxs_{};
   std::mutex mutex_{};
+  IndexCluster::CentroidList centroid_list_{};  // in converted meta
   IVFCentroidIndex::Pointer centroid_index_{};
   IVFCentroidIndex::Pointer searcher_centroid_index_{};
   RandomAccessIndexHolder::Pointer holder_{};
@@ -298,6 +333,7 @@ class IVFBuilder : public IndexBuilder {
   IndexConverter::Pointer converter_{};
   IndexMeta quantized_meta_{};
   std::vector<IndexConverter::Pointer> quantizers_{};
+  IVFFastScan::Pointer fastscan_{};
 
   std::atomic_bool error_{false};
   int err_code_{0};
@@ -306,6 +342,11 @@ class IVFBuilder : public IndexBuilder {
   uint32_t sample_count_{0};
   float sample_ratio_{0.0};
   uint32_t block_vector_count_{kDefaultBlockCount};
+  float rebalance_split_ratio_{kDefaultRebalanceSplitRatio};
+  float rebalance_merge_ratio_{kDefaultRebalanceMergeRatio};
+  float rebalance_imbalance_factor_{kDefaultRebalanceImbalanceFactor};
+  uint32_t rebalance_interval_{0u};
+  bool rebalance_enable_{false};
   bool cluster_auto_tuning_{false};
   bool store_original_features_{false};
   bool quantize_by_centroid_{false};
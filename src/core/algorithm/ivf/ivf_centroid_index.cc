@@ -291,7 +291,8 @@ int IVFCentroidIndex::search(const void *query, const IndexQueryMeta &qmeta,
 }
 
 uint32_t IVFCentroidIndex::search_nearest_centroid(const void *query,
-                                                   size_t len) {
+                                                   size_t len,
+                                                   float *distance) {
   //! Called in building index precedure, so transform the query is needless
   if (len != meta_.element_size()) {
     LOG_ERROR("Invalid query size actual: %zu, expected: %u", len,
@@ -310,6 +311,9 @@ uint32_t IVFCentroidIndex::search_nearest_centroid(const void *query,
     return kInvalidID;
   }
 
+  if (distance) {
+    *distance = context->result()[0].score();
+  }
   return static_cast<uint32_t>(context->result()[0].key());
 }
 
@@ -69,8 +69,10 @@ class IVFCentroidIndex {
   int search(const void *query, const IndexQueryMeta &qmeta, size_t count,
              IndexSearcher::Context::Pointer &ctx);
 
-  //! Search the nearest point, must be called in local thread pool
-  uint32_t search_nearest_centroid(const void *query, size_t len);
+  //! Search the nearest point, must be called in local thread pool.
+  //! The distance to it is stored in \p distance if not null
+  uint32_t search_nearest_centroid(const void *query, size_t len,
+                                   float *distance = nullptr);
 
   //! Transform Data and Search the nearest point, called while adding record
   uint32_t transform_and_search_nearest_centroid(
@@ -237,6 +237,29 @@ int IVFDumper::dump_quantizer_params(
       params.data(), params.size() * sizeof(InvertedIntegerQuantizerParams));
 }
 
+int IVFDumper::dump_fastscan(const IVFFastScan &fastscan,
+                             const std::string &codes) {
+  std::string codebook;
+  fastscan.serialize(&codebook);
+  int ret = this->dump_segment(IVF_FASTSCAN_CODEBOOK_SEG_ID, codebook.data(),
+                               codebook.size());
+  ivf_check_error_code(ret);
+
+  return this->dump_segment(IVF_FASTSCAN_CODES_SEG_ID, codes.data(),
+                            codes.size());
+}
+
+int IVFDumper::dump_centroid_stats(
+    const std::vector<InvertedCentroidStats> &stats) {
+  if (stats.size() != inverted_lists_meta_.size()) {
+    LOG_ERROR("Mismatch centroid stats count=%zu, invertedListCnt=%zu",
+              stats.size(), inverted_lists_meta_.size());
+    return IndexError_Logic;
+  }
+  return this->dump_segment(IVF_CENTROID_STATS_SEG_ID, stats.data(),
+                            stats.size() * sizeof(InvertedCentroidStats));
+}
+
 int IVFDumper::dump_original_vector(const void *data, size_t size) {
   if (dumped_feature_count_ >= header_.total_vector_count) {
     LOG_ERROR("Dump too much orignal features, expect=%u",
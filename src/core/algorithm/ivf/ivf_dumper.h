@@ -16,6 +16,7 @@
 #include <core/quantizer/quantizer_params.h>
 #include <zvec/core/framework/index_framework.h>
 #include "metric/metric_params.h"
+#include "ivf_fastscan.h"
 #include "ivf_index_format.h"
 #include "ivf_params.h"
 #include "ivf_utility.h"
@@ -205,6 +206,12 @@ class IVFDumper {
   int dump_quantizer_params(
       const std::vector<IndexConverter::Pointer> &quantizers);
 
+  //! Dump the fast scan codebook and the packed codes of inverted lists
+  int dump_fastscan(const IVFFastScan &fastscan, const std::string &codes);
+
+  //! Dump the statistics of inverted lists
+  int dump_centroid_stats(const std::vector<InvertedCentroidStats> &stats);
+
   //! Dump the original vector, which doesnot been quantized
   int dump_original_vector(const void *data, size_t size);
 
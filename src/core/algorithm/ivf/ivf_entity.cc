@@ -579,6 +579,20 @@ int IVFEntity::load(const IndexStorage::Pointer &container) {
     norm_value_ = 1.0f;
   }
 
+  if (container_->get(IVF_FASTSCAN_CODEBOOK_SEG_ID)) {
+    ret = this->load_fastscan();
+    ivf_check_error_code(ret);
+  }
+
+  if (container_->get(IVF_CENTROID_STATS_SEG_ID)) {
+    centroid_stats_ =
+        load_segment(IVF_CENTROID_STATS_SEG_ID,
+                     header_.inverted_list_count * sizeof(InvertedCentroidStats));
+    if (!centroid_stats_) {
+      return IndexError_InvalidFormat;
+    }
+  }
+
   if (container_->get(IVF_FEATURES_SEG_ID)) {
     features_ = load_segment(IVF_FEATURES_SEG_ID, 0);
     if (!features_) {
@@ -600,6 +614,55 @@ int IVFEntity::load(const IndexStorage::Pointer &container) {
   return 0;
 }
 
+int IVFEntity::load_fastscan(void) {
+  auto codebook = load_segment(IVF_FASTSCAN_CODEBOOK_SEG_ID, 0);
+  if (!codebook) {
+    return IndexError_InvalidFormat;
+  }
+  const void *data = nullptr;
+  if (codebook->read(0, &data, codebook->data_size()) !=
+      codebook->data_size()) {
+    LOG_ERROR("Failed to read segment %s",
+              IVF_FASTSCAN_CODEBOOK_SEG_ID.c_str());
+    return IndexError_ReadData;
+  }
+  auto fastscan = std::make_shared<IVFFastScan>();
+  int ret = fastscan->deserialize(data, codebook->data_size());
+  ivf_check_error_code(ret);
+
+  //! The codes of each inverted list are padded to whole blocks
+  auto offsets = std::make_shared<std::vector<uint32_t>>();
+  offsets->reserve(header_.inverted_list_count);
+  size_t blocks = 0;
+  for (size_t i = 0; i < header_.inverted_list_count; ++i) {
+    auto list_meta = this->inverted_list_meta(i);
+    ivf_assert(list_meta, IndexError_ReadData);
+    offsets->push_back(static_cast<uint32_t>(blocks));
+    blocks += (list_meta->vector_count + IVFFastScan::kBlockVectorCount - 1) /
+              IVFFastScan::kBlockVectorCount;
+  }
+  fastscan_codes_ =
+      load_segment(IVF_FASTSCAN_CODES_SEG_ID, blocks * fastscan->block_size());
+  if (!fastscan_codes_) {
+    return IndexError_InvalidFormat;
+  }
+  fastscan_ = std::move(fastscan);
+  fastscan_block_offsets_ = std::move(offsets);
+  return 0;
+}
+
+float IVFEntity::imbalance_factor(void) const {
+  std::vector<size_t> list_sizes(header_.inverted_list_count);
+  for (size_t i = 0; i < list_sizes.size(); ++i) {
+    auto list_meta = this->inverted_list_meta(i);
+    if (!list_meta) {
+      return 0.0f;
+    }
+    list_sizes[i] = list_meta->vector_count;
+  }
+  return IVFUtility::ComputeImbalanceFactor(list_sizes);
+}
+
 int IVFEntity::search(size_t inverted_list_id, const void *query,
                       const IndexFilter &filter, uint32_t *scan_count,
                       IndexDocumentHeap *heap,
@@ -731,6 +794,193 @@ int IVFEntity::search(size_t inverted_list_id, const void *query,
   return 0;
 }
 
+int IVFEntity::search(size_t inverted_list_id, const void *queries,
+                      size_t qnum, const IndexFilter &filter,
+                      IndexDocumentHeap *const *heaps,
+                      IndexContext::Stats *const *context_stats) const {
+  ailego_assert_with(inverted_list_id < header_.inverted_list_count,
+                     "invalid id");
+  auto list_meta = this->inverted_list_meta(inverted_list_id);
+  ivf_assert(list_meta, IndexError_ReadData);
+  if (list_meta->vector_count == 0) {
+    return 0;
+  }
+
+  //! Split the queries into power of two chunks, which are transposed for
+  //! the column major blocks
+  const size_t element_size = meta_.element_size();
+  const bool column_major = meta_.major_order() == IndexMeta::MO_COLUMN;
+  std::vector<std::pair<size_t, size_t>> chunks;  // (first query, count)
+  for (size_t q = 0, chunk = kMaxBatchQueries; q < qnum; chunk /= 2) {
+    for (; qnum - q >= chunk; q += chunk) {
+      chunks.emplace_back(q, chunk);
+    }
+  }
+  if (column_major) {
+    const size_t align_size = IndexMeta::AlignSizeof(meta_.data_type());
+    batch_queries_.resize(qnum * element_size);
+    for (auto &chunk : chunks) {
+      const size_t off = chunk.first * element_size;
+      IVFUtility::Transpose(align_size,
+                            static_cast<const char *>(queries) + off,
+                            chunk.second, element_size / align_size,
+                            &batch_queries_[off]);
+    }
+  }
+
+  const void *data = nullptr;
+  const size_t block_vecs = header_.block_vector_count;
+  std::vector<float> distances(block_vecs * kMaxBatchQueries);
+  const size_t batch_size = kBatchBlocks;
+  const size_t block_size = header_.block_size;
+  const auto norm_val = this->inverted_list_normalize_value(inverted_list_id);
+  for (size_t i = 0; i < list_meta->block_count; i += batch_size) {
+    //! Read vecs
+    const size_t off = list_meta->offset + i * block_size;
+    const size_t blocks = std::min(batch_size, list_meta->block_count - i);
+    const size_t size =
+        std::min(blocks * block_size,
+                 static_cast<size_t>(header_.inverted_body_size - off));
+    if (inverted_->read(off, &data, size) != size) {
+      LOG_ERROR("Failed to read block, off=%zu, size=%zu", off, size);
+      return IndexError_ReadData;
+    }
+
+    //! Read keys
+    size_t items = std::min(blocks * block_vecs,
+                            list_meta->vector_count - (i * block_vecs));
+    auto keys = get_keys(list_meta->id_offset + i * block_vecs, items);
+    if (!keys) {
+      return IndexError_ReadData;
+    }
+
+    //! Compute distances for each block, the filter is shared by queries
+    for (size_t b = 0; b < blocks; ++b) {
+      const size_t vecs_count =
+          std::min(block_vecs, list_meta->vector_count - (i + b) * block_vecs);
+      auto block_keys = keys + b * block_vecs;
+      size_t keeps = 0;
+      size_t filtered = 0;
+      ailego_assert_with(block_vecs < sizeof(keeps) * 8, "bits overflow");
+      for (size_t k = 0; k < vecs_count; ++k) {
+        if (filter(block_keys[k])) {
+          ++filtered;
+        } else if (block_keys[k] != kInvalidKey) {
+          keeps |= (1ULL << k);
+        }
+      }
+      if (filtered > 0) {
+        for (size_t q = 0; q < qnum; ++q) {
+          *(context_stats[q]->mutable_filtered_count()) += filtered;
+        }
+      }
+      if (keeps == 0) {
+        continue;
+      }
+
+      const void *block_data = static_cast<const char *>(data) + b * block_size;
+      const bool block_column_major = column_major && vecs_count == block_vecs;
+      uint32_t id_off = list_meta->id_offset + (i + b) * block_vecs;
+      for (auto &chunk : chunks) {
+        if (block_column_major) {
+          calculator_->query_centroids_distance(
+              &batch_queries_[chunk.first * element_size], chunk.second,
+              block_data, vecs_count, distances.data());
+        } else {
+          for (size_t q = 0; q < chunk.second; ++q) {
+            calculator_->query_features_distance(
+                static_cast<const char *>(queries) +
+                    (chunk.first + q) * element_size,
+                block_data, vecs_count, &distances[q * block_vecs]);
+          }
+        }
+        for (size_t q = 0; q < chunk.second; ++q) {
+          auto heap = heaps[chunk.first + q];
+          const float *dists = &distances[q * block_vecs];
+          for (size_t k = 0; k < vecs_count; ++k) {
+            if (keeps & (1ULL << k)) {
+              heap->emplace(block_keys[k], dists[k] * norm_val, id_off + k);
+            }
+          }
+          *(context_stats[chunk.first + q]->mutable_dist_calced_count()) +=
+              vecs_count;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+int IVFEntity::fastscan(size_t inverted_list_id, const IVFFastScanLut &lut,
+                        const IndexFilter &filter, uint32_t *scan_count,
+                        IndexDocumentHeap *candidates,
+                        IndexContext::Stats *context_stats) const {
+  ailego_assert_with(inverted_list_id < header_.inverted_list_count,
+                     "invalid id");
+  auto list_meta = this->inverted_list_meta(inverted_list_id);
+  ivf_assert(list_meta, IndexError_ReadData);
+  *scan_count = list_meta->vector_count;
+  if (list_meta->vector_count == 0) {
+    return 0;
+  }
+
+  const size_t block_vecs = IVFFastScan::kBlockVectorCount;
+  const size_t block_size = fastscan_->block_size();
+  const size_t blocks = (list_meta->vector_count + block_vecs - 1) / block_vecs;
+  const size_t off = (*fastscan_block_offsets_)[inverted_list_id] * block_size;
+  const size_t size = blocks * block_size;
+  const void *data = nullptr;
+  if (fastscan_codes_->read(off, &data, size) != size) {
+    LOG_ERROR("Failed to read codes, off=%zu, size=%zu", off, size);
+    return IndexError_ReadData;
+  }
+  auto keys = get_keys(list_meta->id_offset, list_meta->vector_count);
+  if (!keys) {
+    return IndexError_ReadData;
+  }
+
+  const float reciprocal = 1.0f / lut.scale;
+  uint16_t sums[IVFFastScan::kBlockVectorCount];
+  for (size_t b = 0; b < blocks; ++b) {
+    fastscan_->scan_block(static_cast<const uint8_t *>(data) + b * block_size,
+                          lut, sums);
+    const size_t vecs_count =
+        std::min(block_vecs, list_meta->vector_count - b * block_vecs);
+    const uint32_t id_off = list_meta->id_offset + b * block_vecs;
+    for (size_t k = 0; k < vecs_count; ++k) {
+      uint64_t key = keys[b * block_vecs + k];
+      if (key == kInvalidKey) {
+        continue;
+      }
+      if (filter.is_valid() && filter(key)) {
+        ++(*context_stats->mutable_filtered_count());
+        continue;
+      }
+      candidates->emplace(inverted_list_id, sums[k] * reciprocal + lut.bias,
+                          id_off + k);
+    }
+  }
+  return 0;
+}
+
+int IVFEntity::rerank(const void *query, const IndexDocumentHeap &candidates,
+                      IndexDocumentHeap *heap,
+                      IndexContext::Stats *context_stats) const {
+  for (const auto &it : candidates) {
+    const void *vec = this->get_inverted_vector(it.index());
+    uint64_t key = this->get_key(it.index());
+    if (!vec || key == kInvalidKey) {
+      return IndexError_ReadData;
+    }
+    float dist = 0.0f;
+    calculator_->query_features_distance(query, vec, false, 1, &dist);
+    heap->emplace(key, dist * this->inverted_list_normalize_value(it.key()),
+                  it.index());
+  }
+  *(context_stats->mutable_dist_calced_count()) += candidates.size();
+  return 0;
+}
+
 //! search all inverted list with filter
 int IVFEntity::search(const void *query, const IndexFilter &filter,
                       IndexDocumentHeap *heap,
@@ -772,6 +1022,10 @@ const void *IVFEntity::get_vector(size_t id) const {
     return data;
   }
 
+  return this->get_inverted_vector(id);
+}
+
+const void *IVFEntity::get_inverted_vector(size_t id) const {
   const void *data = nullptr;
   size_t size = sizeof(InvertedVecLocation);
   if (offsets_->read(id * size, &data, size) != size) {
@@ -964,6 +1218,18 @@ IVFEntity::Pointer IVFEntity::clone(const IVFEntity::Pointer &entity) const {
   entity->mapping_ = mapping;
   entity->integer_quantizer_params_ = integer_quantizer_params;
   entity->features_ = features;
+  if (fastscan_) {
+    entity->fastscan_codes_ = fastscan_codes_->clone();
+    ivf_assert_with_msg(entity->fastscan_codes_, nullptr,
+                        "Failed to clone fast scan codes segment");
+    entity->fastscan_ = fastscan_;
+    entity->fastscan_block_offsets_ = fastscan_block_offsets_;
+  }
+  if (centroid_stats_) {
+    entity->centroid_stats_ = centroid_stats_->clone();
+    ivf_assert_with_msg(entity->centroid_stats_, nullptr,
+                        "Failed to clone centroid stats segment");
+  }
   entity->norm_value_ = this->norm_value_;
   entity->norm_value_sqrt_ = this->norm_value_sqrt_;
 
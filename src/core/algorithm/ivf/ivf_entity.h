@@ -17,6 +17,7 @@
 #include <zvec/core/framework/index_framework.h>
 #include "metric/metric_params.h"
 #include "ivf_distance_calculator.h"
+#include "ivf_fastscan.h"
 #include "ivf_index_format.h"
 #include "ivf_params.h"
 
@@ -61,6 +62,34 @@ class IVFEntity {
   int search(const void *query, IndexDocumentHeap *heap,
              IndexContext::Stats *context_stats) const;
 
+  //! Search a group of row major queries in inverted list, each block is
+  //! read once and scored against all the queries by M x N distance kernels
+  int search(size_t inverted_list_id, const void *queries, size_t qnum,
+             const IndexFilter &filter, IndexDocumentHeap *const *heaps,
+             IndexContext::Stats *const *context_stats) const;
+
+  //! Fast scan the codes of inverted list, keep the approximate candidates
+  //! with the inverted list id as key
+  int fastscan(size_t inverted_list_id, const IVFFastScanLut &lut,
+               const IndexFilter &filter, uint32_t *scan_count,
+               IndexDocumentHeap *candidates,
+               IndexContext::Stats *context_stats) const;
+
+  //! Rerank the fast scan candidates with the inverted vectors
+  int rerank(const void *query, const IndexDocumentHeap &candidates,
+             IndexDocumentHeap *heap,
+             IndexContext::Stats *context_stats) const;
+
+  //! Build the fast scan lookup table of a fp32 query
+  void build_fastscan_lut(const void *query, IVFFastScanLut *lut) const {
+    fastscan_->build_lut(static_cast<const float *>(query), lut);
+  }
+
+  //! Check whether the fast scan codes exist
+  bool has_fastscan(void) const {
+    return !!fastscan_;
+  }
+
   //! Clone the entity
   virtual IVFEntity::Pointer clone(void) const;
 
@@ -145,6 +174,25 @@ class IVFEntity {
     return static_cast<const InvertedListMeta *>(data);
   }
 
+  //! Retrieve the statistics of inverted list, nullptr if not dumped
+  const InvertedCentroidStats *centroid_stats(size_t inverted_list_id) const {
+    if (!centroid_stats_) {
+      return nullptr;
+    }
+    const void *data = nullptr;
+    const size_t size = sizeof(InvertedCentroidStats);
+    const size_t offset = inverted_list_id * size;
+    if (centroid_stats_->read(offset, &data, size) != size) {
+      LOG_ERROR("Failed to read centroid stats, id=%zu", inverted_list_id);
+      return nullptr;
+    }
+    return static_cast<const InvertedCentroidStats *>(data);
+  }
+
+  //! Retrieve the imbalance factor of inverted lists (1.0 if balanced), the
+  //! same measure that triggers rebalancing in the builder
+  float imbalance_factor(void) const;
+
   //! Retrieve the keys by consecutive local ids
   const uint64_t *get_keys(size_t id, size_t count) const {
     const void *data = nullptr;
@@ -335,6 +383,12 @@ class IVFEntity {
   //! Load the header segment
   int load_header(const IndexStorage::Pointer &container);
 
+  //! Load the fast scan codebook and codes
+  int load_fastscan(void);
+
+  //! Retrieve vector in inverted list by local id
+  const void *get_inverted_vector(size_t id) const;
+
   //! Convert the int8 quantizer scale to normalize value
   float convert_to_normalize_value(float scale) const {
     auto v = scale == 0.0 ? 1.0 : (1.0 / scale);
@@ -344,6 +398,7 @@ class IVFEntity {
  protected:
   //! Constants
   static constexpr size_t kBatchBlocks = 10u;
+  static constexpr size_t kMaxBatchQueries = 32u;
 
   //! Members
   IndexMeta meta_{};
@@ -357,7 +412,12 @@ class IVFEntity {
   IndexStorage::Segment::Pointer mapping_{};
   IndexStorage::Segment::Pointer features_{};
   IndexStorage::Segment::Pointer integer_quantizer_params_{};
+  IndexStorage::Segment::Pointer fastscan_codes_{};
+  IndexStorage::Segment::Pointer centroid_stats_{};
+  IVFFastScan::Pointer fastscan_{};
+  std::shared_ptr<std::vector<uint32_t>> fastscan_block_offsets_{};
   mutable std::string vector_{};  // temporary buffer for colomn major order
+  mutable std::string batch_queries_{};  // transposed queries of a group
   float norm_value_{0.0f};  // normalize the inverted vector to orignal score
   bool norm_value_sqrt_{false};  // does the norm value need to sqrt
   InvertedIndexHeader header_;
@@ -0,0 +1,304 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "ivf_fastscan.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <ailego/algorithm/kmeans.h>
+#include <ailego/internal/cpu_features.h>
+#include <zvec/core/framework/index_threads.h>
+#include "utility/pq_utility.h"
+#include "ivf_params.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace zvec {
+namespace core {
+
+int IVFFastScan::init(const IndexMeta &meta, uint32_t subspace_count) {
+  if (meta.data_type() != IndexMeta::DataType::DT_FP32) {
+    LOG_ERROR("Fast scan supports fp32 vectors only");
+    return IndexError_Unsupported;
+  }
+  if (meta.metric_name() == kIPMetricName) {
+    inner_product_ = true;
+  } else if (meta.metric_name() == kL2MetricName) {
+    inner_product_ = false;
+  } else {
+    LOG_ERROR("Fast scan unsupported metric %s", meta.metric_name().c_str());
+    return IndexError_Unsupported;
+  }
+
+  dimension_ = meta.dimension();
+  if (subspace_count == 0) {
+    // Prime dimensions above the cap keep one subspace spanning them all
+    subspace_count =
+        std::max(PQSubspaceCount(dimension_, kMaxSubspaceCount), 1u);
+  }
+  if (dimension_ % subspace_count != 0 ||
+      subspace_count > kMaxSubspaceCount) {
+    LOG_ERROR("Invalid fast scan subspace count %u for dimension %u",
+              subspace_count, dimension_);
+    return IndexError_InvalidArgument;
+  }
+  subspace_count_ = subspace_count;
+  padded_subspace_count_ = (subspace_count + 1) & ~1u;
+  subspace_dim_ = dimension_ / subspace_count;
+  centroids_.assign(
+      static_cast<size_t>(subspace_count_) * kCentroidCount * subspace_dim_,
+      0.0f);
+  return 0;
+}
+
+int IVFFastScan::train(const IndexHolder::Pointer &holder) {
+  //! Reservoir sampling, the same limit as PQ training
+  std::vector<float> data;
+  std::mt19937 rng(42);
+  size_t count = 0;
+  for (auto iter = holder->create_iterator(); iter && iter->is_valid();
+       iter->next(), ++count) {
+    const float *vec = static_cast<const float *>(iter->data());
+    if (count < kMaxTrainVectors) {
+      data.insert(data.end(), vec, vec + dimension_);
+      continue;
+    }
+    size_t j = std::uniform_int_distribution<size_t>(0, count)(rng);
+    if (j < kMaxTrainVectors) {
+      std::copy(vec, vec + dimension_, &data[j * dimension_]);
+    }
+  }
+  count = std::min(count, kMaxTrainVectors);
+  if (count < kCentroidCount) {
+    LOG_ERROR("Too few vectors %zu to train fast scan codebook", count);
+    return IndexError_InvalidArgument;
+  }
+
+  SingleQueueIndexThreads threads(1, false);
+  for (uint32_t s = 0; s < subspace_count_; ++s) {
+    ailego::NumericalKmeans<float, SingleQueueIndexThreads> kmeans(
+        kCentroidCount, subspace_dim_);
+    for (size_t i = 0; i < count; ++i) {
+      kmeans.append(&data[i * dimension_ + s * subspace_dim_], subspace_dim_);
+    }
+    ailego::Kmc2CentroidsGenerator<
+        ailego::NumericalKmeans<float, SingleQueueIndexThreads>,
+        SingleQueueIndexThreads>
+        gen;
+    kmeans.init_centroids(threads, gen);
+
+    double cost = 0.0;
+    for (uint32_t iter = 0; iter < kMaxKmeansIters; ++iter) {
+      double old_cost = cost;
+      if (!kmeans.cluster_once(threads, &cost) ||
+          std::abs(cost - old_cost) < std::numeric_limits<float>::epsilon()) {
+        break;
+      }
+    }
+
+    const auto &cents = kmeans.centroids();
+    float *out = &centroids_[static_cast<size_t>(s) * kCentroidCount *
+                             subspace_dim_];
+    for (size_t c = 0; c < cents.count() && c < kCentroidCount; ++c) {
+      std::memcpy(out + c * subspace_dim_, cents[c],
+                  subspace_dim_ * sizeof(float));
+    }
+  }
+  return 0;
+}
+
+void IVFFastScan::encode(const float *vec, uint8_t *codes) const {
+  const float *cents = centroids_.data();
+  for (uint32_t s = 0; s < subspace_count_; ++s) {
+    const float *sub = vec + s * subspace_dim_;
+    float best = std::numeric_limits<float>::max();
+    uint8_t code = 0;
+    for (uint32_t c = 0; c < kCentroidCount; ++c, cents += subspace_dim_) {
+      float dist = 0.0f;
+      for (uint32_t d = 0; d < subspace_dim_; ++d) {
+        float diff = sub[d] - cents[d];
+        dist += diff * diff;
+      }
+      if (dist < best) {
+        best = dist;
+        code = static_cast<uint8_t>(c);
+      }
+    }
+    codes[s] = code;
+  }
+}
+
+void IVFFastScan::encode_block(const float *const *vecs, size_t count,
+                               uint8_t *block) const {
+  ailego_assert_with(count <= kBlockVectorCount, "invalid count");
+
+  std::vector<uint8_t> codes(kBlockVectorCount * padded_subspace_count_, 0);
+  for (size_t i = 0; i < count; ++i) {
+    this->encode(vecs[i], &codes[i * padded_subspace_count_]);
+  }
+  for (uint32_t s = 0; s < padded_subspace_count_; ++s) {
+    uint8_t *out = block + s * kCentroidCount;
+    for (uint32_t j = 0; j < kCentroidCount; ++j) {
+      uint8_t lo = codes[j * padded_subspace_count_ + s];
+      uint8_t hi = codes[(j + kCentroidCount) * padded_subspace_count_ + s];
+      out[j] = static_cast<uint8_t>(lo | (hi << 4));
+    }
+  }
+}
+
+void IVFFastScan::build_lut(const float *query, IVFFastScanLut *lut) const {
+  std::vector<float> dists(
+      static_cast<size_t>(subspace_count_) * kCentroidCount);
+  const float *cents = centroids_.data();
+  float max_range = 0.0f;
+  lut->bias = 0.0f;
+  for (uint32_t s = 0; s < subspace_count_; ++s) {
+    const float *sub = query + s * subspace_dim_;
+    float *out = &dists[s * kCentroidCount];
+    float min_val = std::numeric_limits<float>::max();
+    float max_val = std::numeric_limits<float>::lowest();
+    for (uint32_t c = 0; c < kCentroidCount; ++c, cents += subspace_dim_) {
+      float dist = 0.0f;
+      for (uint32_t d = 0; d < subspace_dim_; ++d) {
+        if (inner_product_) {
+          dist -= sub[d] * cents[d];
+        } else {
+          float diff = sub[d] - cents[d];
+          dist += diff * diff;
+        }
+      }
+      out[c] = dist;
+      min_val = std::min(min_val, dist);
+      max_val = std::max(max_val, dist);
+    }
+    for (uint32_t c = 0; c < kCentroidCount; ++c) {
+      out[c] -= min_val;
+    }
+    lut->bias += min_val;
+    max_range = std::max(max_range, max_val - min_val);
+  }
+
+  // One scale for all the subspaces, so the uint16 sums stay comparable
+  lut->scale = max_range > 0.0f ? 255.0f / max_range : 1.0f;
+  lut->table.assign(block_size(), 0);
+  for (size_t i = 0; i < dists.size(); ++i) {
+    float q = std::round(dists[i] * lut->scale);
+    lut->table[i] = static_cast<uint8_t>(std::min(q, 255.0f));
+  }
+}
+
+#if defined(__AVX2__)
+static inline void ScanBlockAVX2(const uint8_t *block, const uint8_t *lut,
+                                 size_t padded_subspace_count, uint16_t *out) {
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc0 = zero;  // vectors 0..7, one subspace per lane
+  __m256i acc1 = zero;  // vectors 8..15
+  __m256i acc2 = zero;  // vectors 16..23
+  __m256i acc3 = zero;  // vectors 24..31
+  for (size_t s = 0; s < padded_subspace_count; s += 2) {
+    __m256i codes = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(block + s * 16));
+    __m256i table =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lut + s * 16));
+    __m256i lo = _mm256_and_si256(codes, mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(codes, 4), mask);
+    __m256i dlo = _mm256_shuffle_epi8(table, lo);
+    __m256i dhi = _mm256_shuffle_epi8(table, hi);
+    acc0 = _mm256_add_epi16(acc0, _mm256_unpacklo_epi8(dlo, zero));
+    acc1 = _mm256_add_epi16(acc1, _mm256_unpackhi_epi8(dlo, zero));
+    acc2 = _mm256_add_epi16(acc2, _mm256_unpacklo_epi8(dhi, zero));
+    acc3 = _mm256_add_epi16(acc3, _mm256_unpackhi_epi8(dhi, zero));
+  }
+
+  // Fold the two subspace lanes together
+  auto fold = [](__m256i v) {
+    return _mm_add_epi16(_mm256_castsi256_si128(v),
+                         _mm256_extracti128_si256(v, 1));
+  };
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 0), fold(acc0));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), fold(acc1));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), fold(acc2));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 24), fold(acc3));
+}
+#endif  // __AVX2__
+
+void IVFFastScan::scan_block(const uint8_t *block, const IVFFastScanLut &lut,
+                             uint16_t *out) const {
+#if defined(__AVX2__)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX2) {
+    ScanBlockAVX2(block, lut.table.data(), padded_subspace_count_, out);
+    return;
+  }
+#endif
+  std::fill(out, out + kBlockVectorCount, static_cast<uint16_t>(0));
+  const uint8_t *table = lut.table.data();
+  for (uint32_t s = 0; s < padded_subspace_count_; ++s) {
+    const uint8_t *codes = block + s * kCentroidCount;
+    const uint8_t *t = table + s * kCentroidCount;
+    for (uint32_t j = 0; j < kCentroidCount; ++j) {
+      out[j] += t[codes[j] & 0x0f];
+      out[j + kCentroidCount] += t[codes[j] >> 4];
+    }
+  }
+}
+
+void IVFFastScan::serialize(std::string *out) const {
+  InvertedFastScanHeader header;
+  header.dimension = dimension_;
+  header.subspace_count = subspace_count_;
+  header.subspace_dim = subspace_dim_;
+  header.inner_product = inner_product_ ? 1u : 0u;
+  std::memset(header.reserved_, 0, sizeof(header.reserved_));
+  out->assign(reinterpret_cast<const char *>(&header), sizeof(header));
+  out->append(reinterpret_cast<const char *>(centroids_.data()),
+              centroids_.size() * sizeof(float));
+}
+
+int IVFFastScan::deserialize(const void *data, size_t size) {
+  if (size < sizeof(InvertedFastScanHeader)) {
+    LOG_ERROR("Invalid fast scan codebook size %zu", size);
+    return IndexError_InvalidFormat;
+  }
+  InvertedFastScanHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.subspace_count == 0 ||
+      header.subspace_count > kMaxSubspaceCount ||
+      header.subspace_count * header.subspace_dim != header.dimension) {
+    LOG_ERROR("Invalid fast scan codebook, dim=%u subspaces=%u",
+              header.dimension, header.subspace_count);
+    return IndexError_InvalidFormat;
+  }
+  size_t cents_size = static_cast<size_t>(header.dimension) * kCentroidCount;
+  if (size != sizeof(header) + cents_size * sizeof(float)) {
+    LOG_ERROR("Mismatch fast scan codebook size %zu", size);
+    return IndexError_InvalidFormat;
+  }
+
+  dimension_ = header.dimension;
+  subspace_count_ = header.subspace_count;
+  padded_subspace_count_ = (subspace_count_ + 1) & ~1u;
+  subspace_dim_ = header.subspace_dim;
+  inner_product_ = header.inner_product != 0;
+  const float *cents = reinterpret_cast<const float *>(
+      static_cast<const char *>(data) + sizeof(header));
+  centroids_.assign(cents, cents + cents_size);
+  return 0;
+}
+
+}  // namespace core
+}  // namespace zvec
@@ -0,0 +1,97 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <zvec/core/framework/index_framework.h>
+#include "ivf_index_format.h"
+
+namespace zvec {
+namespace core {
+
+/*! Quantized lookup table of one query
+ */
+struct IVFFastScanLut {
+  std::vector<uint8_t> table{};  // [padded_subspace_count][16]
+  float scale{1.0f};             // quantized sum = (dist - bias) * scale
+  float bias{0.0f};
+};
+
+/*! IVF Fast Scan
+ *  4-bit product quantizer (16 centroids per subspace). Codes of an inverted
+ *  list are packed in blocks of 32 vectors, transposed so that the 16 bytes
+ *  of one subspace hold the codes of vector j (low nibble) and vector j + 16
+ *  (high nibble). The per-query table is quantized to uint8 so a subspace
+ *  fits in one 128-bit lane and is looked up with a byte shuffle.
+ */
+class IVFFastScan {
+ public:
+  typedef std::shared_ptr<IVFFastScan> Pointer;
+
+  //! Constants
+  static constexpr uint32_t kBlockVectorCount = 32u;
+  static constexpr uint32_t kCentroidCount = 16u;
+  static constexpr uint32_t kMaxSubspaceCount = 256u;
+
+  //! Initialize the quantizer
+  int init(const IndexMeta &meta, uint32_t subspace_count);
+
+  //! Train the codebook by the vectors in holder
+  int train(const IndexHolder::Pointer &holder);
+
+  //! Encode up to 32 vectors into a packed block
+  void encode_block(const float *const *vecs, size_t count,
+                    uint8_t *block) const;
+
+  //! Build the quantized lookup table of a query
+  void build_lut(const float *query, IVFFastScanLut *lut) const;
+
+  //! Accumulate the quantized distances of a block
+  void scan_block(const uint8_t *block, const IVFFastScanLut &lut,
+                  uint16_t *out) const;
+
+  //! Serialize the codebook
+  void serialize(std::string *out) const;
+
+  //! Deserialize the codebook
+  int deserialize(const void *data, size_t size);
+
+  //! Retrieve the bytes of a packed block
+  size_t block_size(void) const {
+    return static_cast<size_t>(padded_subspace_count_) * kCentroidCount;
+  }
+
+  //! Retrieve the subspace count
+  uint32_t subspace_count(void) const {
+    return subspace_count_;
+  }
+
+ private:
+  //! Encode a vector into one code per subspace
+  void encode(const float *vec, uint8_t *codes) const;
+
+  //! Constants
+  static constexpr uint32_t kMaxKmeansIters = 16u;
+  static constexpr size_t kMaxTrainVectors = 65536u;
+
+  //! Members
+  uint32_t dimension_{0};
+  uint32_t subspace_count_{0};
+  uint32_t padded_subspace_count_{0};
+  uint32_t subspace_dim_{0};
+  bool inner_product_{false};
+  std::vector<float> centroids_{};  // [subspace][16][subspace_dim]
+};
+
+}  // namespace core
+}  // namespace zvec
@@ -71,6 +71,28 @@ struct InvertedIntegerQuantizerParams {
   float bias{0.0};
 };
 
+/*! Index Format of Fast Scan Codebook Header
+ */
+struct InvertedFastScanHeader {
+  uint32_t dimension{0};
+  uint32_t subspace_count{0};
+  uint32_t subspace_dim{0};
+  uint32_t inner_product{0};
+  char reserved_[16];
+};
+
+/*! Index Format of Statistics for each inverted list
+ */
+struct InvertedCentroidStats {
+  uint32_t vector_count{0};
+  float residual_mean{0.0f};  // mean distance to the centroid
+  float residual_max{0.0f};   // max distance to the centroid
+  uint32_t reserved_{0};
+};
+
+static_assert(sizeof(InvertedCentroidStats) == 16,
+              "InvertedCentroidStats must be 16 bytes");
+
 /*! Location of Vectors Block in Storage Segment
  */
 struct BlockLocation {
@@ -166,6 +188,9 @@ const std::string IVF_MAPPING_SEG_ID("ivf.mapping");
 const std::string IVF_FEATURES_SEG_ID("ivf.features");
 const std::string IVF_INT8_QUANTIZED_PARAMS_SEG_ID("ivf.int8_quantized_params");
 const std::string IVF_INT4_QUANTIZED_PARAMS_SEG_ID("ivf.int4_quantized_params");
+const std::string IVF_FASTSCAN_CODEBOOK_SEG_ID("ivf.fastscan_codebook");
+const std::string IVF_FASTSCAN_CODES_SEG_ID("ivf.fastscan_codes");
+const std::string IVF_CENTROID_STATS_SEG_ID("ivf.centroid_stats");
 
 const std::string IVF_INVERTED_LIST_HEAD_SEG_ID("ivf.inverted_list_head");
 const std::string IVF_STORAGE_SEGMENT_ID("ivf.S");
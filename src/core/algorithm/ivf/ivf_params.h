@@ -58,6 +58,20 @@ static const std::string PARAM_IVF_BUILDER_OPTIMIZER_QUANTIZER_PARAMS(
     "proxima.ivf.builder.optimizer_quantizer_params");
 static const std::string PARAM_IVF_BUILDER_BLOCK_VECTOR_COUNT(
     "proxima.ivf.builder.block_vector_count");
+static const std::string PARAM_IVF_BUILDER_FASTSCAN_ENABLE(
+    "proxima.ivf.builder.fastscan_enable");
+static const std::string PARAM_IVF_BUILDER_FASTSCAN_SUBSPACE_COUNT(
+    "proxima.ivf.builder.fastscan_subspace_count");
+static const std::string PARAM_IVF_BUILDER_REBALANCE_ENABLE(
+    "proxima.ivf.builder.rebalance_enable");
+static const std::string PARAM_IVF_BUILDER_REBALANCE_SPLIT_RATIO(
+    "proxima.ivf.builder.rebalance_split_ratio");
+static const std::string PARAM_IVF_BUILDER_REBALANCE_MERGE_RATIO(
+    "proxima.ivf.builder.rebalance_merge_ratio");
+static const std::string PARAM_IVF_BUILDER_REBALANCE_IMBALANCE_FACTOR(
+    "proxima.ivf.builder.rebalance_imbalance_factor");
+static const std::string PARAM_IVF_BUILDER_REBALANCE_INTERVAL(
+    "proxima.ivf.builder.rebalance_interval");
 
 // searcher params
 static const std::string PARAM_IVF_SEARCHER_SCAN_RATIO(
@@ -72,6 +86,12 @@ static const std::string PARAM_IVF_SEARCHER_CONVERTER_REFORMER(
     "proxima.ivf.searcher.converter_reformer");
 static const std::string PARAM_IVF_SEARCHER_NPROBE(
     "proxima.ivf.searcher.nprobe");
+static const std::string PARAM_IVF_SEARCHER_FASTSCAN_ENABLE(
+    "proxima.ivf.searcher.fastscan_enable");
+static const std::string PARAM_IVF_SEARCHER_FASTSCAN_RERANK_FACTOR(
+    "proxima.ivf.searcher.fastscan_rerank_factor");
+static const std::string PARAM_IVF_SEARCHER_BATCH_SCAN_ENABLE(
+    "proxima.ivf.searcher.batch_scan_enable");
 
 // Constants
 static constexpr char const *kIPMetricName = "InnerProduct";
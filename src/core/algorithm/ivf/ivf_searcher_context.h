@@ -13,6 +13,7 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
 #include <zvec/ailego/container/heap.h>
 #include "ivf_entity.h"
 #include "ivf_utility.h"
@@ -91,6 +92,17 @@ class IVFSearcherContext : public IndexSearcher::Context {
           std::ceil(entity_->vector_count() * scan_ratio_));
     }
     max_scan_count_ = std::max(bruteforce_threshold_, max_scan_count_);
+
+    params.get(PARAM_IVF_SEARCHER_FASTSCAN_ENABLE, &fastscan_enable_);
+    params.get(PARAM_IVF_SEARCHER_FASTSCAN_RERANK_FACTOR,
+               &fastscan_rerank_factor_);
+    if (fastscan_rerank_factor_ == 0) {
+      LOG_ERROR("Invalid params %s=%u",
+                PARAM_IVF_SEARCHER_FASTSCAN_RERANK_FACTOR.c_str(),
+                fastscan_rerank_factor_);
+      return IndexError_InvalidArgument;
+    }
+    params.get(PARAM_IVF_SEARCHER_BATCH_SCAN_ENABLE, &batch_scan_enable_);
     return 0;
   }
 
@@ -139,6 +151,96 @@ class IVFSearcherContext : public IndexSearcher::Context {
     return result_heap_;
   }
 
+  //! Test if searching with the fast scan codes of entity
+  bool fastscan_enable(const IndexQueryMeta &qmeta) const {
+    return fastscan_enable_ && entity_->has_fastscan() &&
+           qmeta.data_type() == IndexMeta::DataType::DT_FP32;
+  }
+
+  //! Test if searching the queries of a batch by shared list scans
+  bool batch_scan_enable(uint32_t count, bool fastscan) const {
+    return batch_scan_enable_ && count > 1 && !fastscan;
+  }
+
+  //! Search the transformed queries of a batch. The probes of all queries
+  //! are grouped by inverted list, so each list is scanned only once
+  int batch_search(const void *query, const IndexQueryMeta &qmeta,
+                   uint32_t count) {
+    //! Collect the (list, query) probes in the same order as single search
+    probes_.clear();
+    for (uint32_t q = 0; q < count; ++q) {
+      auto &centroids = centroid_searcher_ctx_->result(q);
+      size_t total_scan_count = 0;
+      for (size_t i = 0;
+           i < centroids.size() && total_scan_count < max_scan_count_; ++i) {
+        auto cid = static_cast<uint32_t>(centroids[i].key());
+        auto list_meta = entity_->inverted_list_meta(cid);
+        ivf_assert(list_meta, IndexError_ReadData);
+        probes_.emplace_back(cid, q);
+        total_scan_count += list_meta->vector_count;
+      }
+    }
+    std::sort(probes_.begin(), probes_.end());
+
+    batch_heaps_.resize(count);
+    for (auto &heap : batch_heaps_) {
+      heap.clear();
+      heap.limit(topk_);
+      heap.set_threshold(this->threshold());
+    }
+
+    //! Scan each inverted list once for all the interested queries
+    std::vector<IndexDocumentHeap *> heaps;
+    std::vector<Stats *> stats;
+    for (size_t i = 0; i < probes_.size();) {
+      const uint32_t cid = probes_[i].first;
+      batch_queries_.clear();
+      heaps.clear();
+      stats.clear();
+      for (; i < probes_.size() && probes_[i].first == cid; ++i) {
+        const uint32_t q = probes_[i].second;
+        batch_queries_.append(static_cast<const char *>(query) +
+                                  static_cast<size_t>(q) * qmeta.element_size(),
+                              qmeta.element_size());
+        heaps.push_back(&batch_heaps_[q]);
+        stats.push_back(&stats_vec_[q]);
+      }
+      int ret = entity_->search(cid, batch_queries_.data(), heaps.size(),
+                                this->filter(), heaps.data(), stats.data());
+      ivf_check_with_msg(ret, "Failed to search in entity for %s",
+                         IndexError::What(ret));
+    }
+
+    for (uint32_t q = 0; q < count; ++q) {
+      auto &heap = batch_heaps_[q];
+      heap.sort();
+      if (!this->filter().is_valid()) {
+        // mapping the local id to key if query without filter
+        int ret = entity_->retrieve_keys(&heap);
+        ivf_check_error_code(ret);
+      }
+      entity_->normalize(q, &heap);
+      this->topk_to_result(q, &heap);
+    }
+    return 0;
+  }
+
+  //! Reset the fast scan candidates for a new query
+  void reset_fastscan_candidates() {
+    fastscan_candidates_.clear();
+    fastscan_candidates_.limit(topk_ * fastscan_rerank_factor_);
+  }
+
+  //! Retrieve the fast scan candidates
+  IndexDocumentHeap &fastscan_candidates() {
+    return fastscan_candidates_;
+  }
+
+  //! Retrieve the fast scan lookup table
+  IVFFastScanLut &fastscan_lut() {
+    return fastscan_lut_;
+  }
+
   void set_fetch_vector(bool v) override {
     fetch_vector_ = v;
   }
@@ -190,21 +292,25 @@ class IVFSearcherContext : public IndexSearcher::Context {
   }
 
   void topk_to_result(uint32_t idx) {
-    if (ailego_unlikely(result_heap_.size() == 0)) {
+    this->topk_to_result(idx, &result_heap_);
+  }
+
+  void topk_to_result(uint32_t idx, IndexDocumentHeap *heap) {
+    if (ailego_unlikely(heap->size() == 0)) {
       return;
     }
 
     ailego_assert_with(idx < results_.size(), "invalid idx");
-    int size = std::min(topk_, static_cast<uint32_t>(result_heap_.size()));
-    result_heap_.sort();
+    int size = std::min(topk_, static_cast<uint32_t>(heap->size()));
+    heap->sort();
     results_[idx].clear();
     for (int i = 0; i < size; ++i) {
-      auto score = result_heap_[i].score();
+      auto score = (*heap)[i].score();
       if (score > this->threshold()) {
         break;
       }
 
-      key_t key = result_heap_[i].key();
+      key_t key = (*heap)[i].key();
       if (fetch_vector_) {
         IndexStorage::MemoryBlock block;
         entity_->get_vector_by_key(key, block);
@@ -219,11 +325,17 @@ class IVFSearcherContext : public IndexSearcher::Context {
   //! Constants
   static constexpr float kDefaultScanRatio = 0.1f;
   static constexpr uint32_t kDefaultBfThreshold = 1000u;
+  static constexpr uint32_t kDefaultRerankFactor = 8u;
 
   //! Members
   IVFEntity::Pointer entity_{};
   IndexSearcher::Context::Pointer centroid_searcher_ctx_{};
   IndexDocumentHeap result_heap_;
+  IndexDocumentHeap fastscan_candidates_{};
+  std::vector<IndexDocumentHeap> batch_heaps_{};
+  std::vector<std::pair<uint32_t, uint32_t>> probes_{};  // (list, query)
+  std::string batch_queries_{};
+  IVFFastScanLut fastscan_lut_{};
   std::vector<IndexDocumentList> results_{};
   std::vector<Stats> stats_vec_{};
 
@@ -233,6 +345,9 @@ class IVFSearcherContext : public IndexSearcher::Context {
   float scan_ratio_{kDefaultScanRatio};
   uint32_t max_scan_count_{0};
   uint32_t bruteforce_threshold_{kDefaultBfThreshold};
+  uint32_t fastscan_rerank_factor_{kDefaultRerankFactor};
+  bool fastscan_enable_{true};
+  bool batch_scan_enable_{true};
 };
 
 }  // namespace core
@@ -219,23 +219,38 @@ int IVFStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
   int ret = centroid_index_->search(query, qmeta, count, centroid_index_ctx);
   ivf_check_error_code(ret);
 
+  //! The fast scan lookup table is built from the original query
+  const void *fastscan_query = query;
+  const bool fastscan = ctx->fastscan_enable(qmeta);
+
   //! Transform the querys for querying in inverted vector index later
   IndexQueryMeta iv_qmeta;
   ret = entity->transform(query, qmeta, count, &query, &iv_qmeta);
   ivf_check_with_msg(ret, "Failed to transform querys");
 
+  if (ctx->batch_scan_enable(count, fastscan)) {
+    return ctx->batch_search(query, iv_qmeta, count);
+  }
+
   for (size_t q = 0; q < count; ++q) {
     auto &centroids = centroid_index_ctx->result(q);
     auto &context_stats = ctx->mutable_stats(q);
     auto &heap = ctx->mutable_result_heap();
     heap.clear();
+    if (fastscan) {
+      entity->build_fastscan_lut(fastscan_query, &ctx->fastscan_lut());
+      ctx->reset_fastscan_candidates();
+    }
     size_t total_scan_count = 0;
     for (size_t i = 0;
          i < centroids.size() && total_scan_count < ctx->max_scan_count();
          ++i) {
       auto cid = centroids[i].key();
       uint32_t scan_count = 0;
-      if (!filter.is_valid()) {
+      if (fastscan) {
+        ret = entity->fastscan(cid, ctx->fastscan_lut(), filter, &scan_count,
+                               &ctx->fastscan_candidates(), &context_stats);
+      } else if (!filter.is_valid()) {
         ret = entity->search(cid, query, &scan_count, &heap, &context_stats);
       } else {
         ret = entity->search(cid, query, filter, &scan_count, &heap,
@@ -245,6 +260,12 @@ int IVFStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
                          IndexError::What(ret));
       total_scan_count += scan_count;
     }
+    if (fastscan) {
+      ret = entity->rerank(query, ctx->fastscan_candidates(), &heap,
+                           &context_stats);
+      ivf_check_with_msg(ret, "Failed to rerank in entity for %s",
+                         IndexError::What(ret));
+    }
     heap.sort();  // sort the results
     if (!filter.is_valid()) {
       // mapping the local id to key if query without filter
@@ -254,6 +275,8 @@ int IVFStreamer::search_impl(const void *query, const IndexQueryMeta &qmeta,
     entity->normalize(q, &heap);
     ctx->topk_to_result(q);
     query = static_cast<const char *>(query) + iv_qmeta.element_size();
+    fastscan_query =
+        static_cast<const char *>(fastscan_query) + qmeta.element_size();
   }
 
   return 0;
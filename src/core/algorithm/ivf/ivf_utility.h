@@ -73,6 +73,22 @@ class IVFUtility {
     return scan_ratio;
   }
 
+  //! Compute the imbalance factor of inverted lists by their sizes, that is
+  //! count * sum(size^2) / sum(size)^2, 1.0 if they are evenly filled
+  static inline float ComputeImbalanceFactor(
+      const std::vector<size_t> &list_sizes) {
+    double sum = 0.0;
+    double square_sum = 0.0;
+    for (auto size : list_sizes) {
+      sum += size;
+      square_sum += static_cast<double>(size) * size;
+    }
+    if (sum == 0.0) {
+      return 1.0f;
+    }
+    return static_cast<float>(square_sum * list_sizes.size() / (sum * sum));
+  }
+
   //! Transpose the vectors in row major order to column major order
   static inline void Transpose(size_t align_size, const void *src, size_t m,
                                size_t dim, void *dst);
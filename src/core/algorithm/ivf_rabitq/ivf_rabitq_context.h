@@ -85,6 +85,7 @@ class IvfRabitqContext : public IndexContext {
       }
       nprobe_ = static_cast<uint32_t>(val);
     }
+    params.get(PARAM_IVF_RABITQ_BATCH_SCAN_ENABLE, &batch_scan_enable_);
 
     return 0;
   }
@@ -197,23 +198,38 @@ class IvfRabitqContext : public IndexContext {
     group_state_->heaps.clear();
   }
 
+  //! Reset the per-query heaps of a batch search
+  std::vector<IndexDocumentHeap> &reset_batch_heaps(size_t qnum,
+                                                    uint32_t topk) {
+    batch_heaps_.resize(qnum);
+    for (auto &heap : batch_heaps_) {
+      heap.clear();
+      heap.limit(topk);
+    }
+    return batch_heaps_;
+  }
+
   //! Drain heap → results_[idx], sorted by score ascending (same as IVF)
   void topk_to_result(uint32_t idx) {
-    if (result_heap_.empty()) {
+    this->topk_to_result(idx, &result_heap_);
+  }
+
+  void topk_to_result(uint32_t idx, IndexDocumentHeap *heap) {
+    if (heap->empty()) {
       return;
     }
     if (idx >= results_.size()) {
       results_.resize(idx + 1);
     }
-    int sz = std::min(topk_, static_cast<uint32_t>(result_heap_.size()));
-    result_heap_.sort();
+    int sz = std::min(topk_, static_cast<uint32_t>(heap->size()));
+    heap->sort();
     results_[idx].clear();
     for (int i = 0; i < sz; ++i) {
-      float score = result_heap_[i].score();
+      float score = (*heap)[i].score();
       if (score > this->threshold()) {
         break;
       }
-      results_[idx].emplace_back(result_heap_[i].key(), score);
+      results_[idx].emplace_back((*heap)[i].key(), score);
     }
   }
 
@@ -309,6 +325,9 @@ class IvfRabitqContext : public IndexContext {
   uint32_t bruteforce_threshold() const {
     return bruteforce_threshold_;
   }
+  bool batch_scan_enable() const {
+    return batch_scan_enable_;
+  }
 
   int update_search_limits(uint32_t vector_count, uint32_t cluster_count,
                            uint32_t *effective_nprobe) {
@@ -346,6 +365,10 @@ class IvfRabitqContext : public IndexContext {
   IvfRabitqQueryState query_state;
   std::vector<IvfRabitqProbeCentroid> probe_centroids;
 
+  // Per-query states of a batch search, indexed by query
+  std::vector<IvfRabitqQueryState> batch_query_states;
+  std::vector<std::vector<IvfRabitqProbeCentroid>> batch_probe_centroids;
+
  private:
   struct GroupSearchState {
     uint32_t group_num{0};
@@ -355,6 +378,7 @@ class IvfRabitqContext : public IndexContext {
   };
 
   IndexDocumentHeap result_heap_;
+  std::vector<IndexDocumentHeap> batch_heaps_;
   std::vector<IndexDocumentList> results_;
   std::unique_ptr<GroupSearchState> group_state_;
 
@@ -364,6 +388,7 @@ class IvfRabitqContext : public IndexContext {
   float scan_ratio_{kDefaultIvfRabitqScanRatio};
   uint32_t bruteforce_threshold_{kDefaultIvfRabitqBruteForceThreshold};
   bool fetch_vector_{false};
+  bool batch_scan_enable_{true};
 };
 
 }  // namespace core
@@ -180,8 +180,10 @@ int IvfRabitqEntity::search_cluster(uint32_t cluster_id,
                                     const IvfRabitqQueryState &query_state,
                                     size_t padded_dim, size_t ex_bits,
                                     IndexDocumentHeap *heap) const {
-  return search_cluster_impl<false>(cluster_id, query_state, padded_dim,
-                                    ex_bits, nullptr, heap);
+  const IvfRabitqQueryState *query_states[] = {&query_state};
+  IndexDocumentHeap *heaps[] = {heap};
+  return search_cluster_tile_impl<false>(cluster_id, query_states, 1,
+                                         padded_dim, ex_bits, nullptr, heaps);
 }
 
 int IvfRabitqEntity::search_cluster(uint32_t cluster_id,
@@ -189,8 +191,26 @@ int IvfRabitqEntity::search_cluster(uint32_t cluster_id,
                                     size_t padded_dim, size_t ex_bits,
                                     const IndexFilter &filter,
                                     IndexDocumentHeap *heap) const {
-  return search_cluster_impl<true>(cluster_id, query_state, padded_dim, ex_bits,
-                                   &filter, heap);
+  const IvfRabitqQueryState *query_states[] = {&query_state};
+  IndexDocumentHeap *heaps[] = {heap};
+  return search_cluster_tile_impl<true>(cluster_id, query_states, 1, padded_dim,
+                                        ex_bits, &filter, heaps);
+}
+
+int IvfRabitqEntity::search_cluster_tile(
+    uint32_t cluster_id, const IvfRabitqQueryState *const *query_states,
+    size_t tile_size, size_t padded_dim, size_t ex_bits,
+    IndexDocumentHeap *const *heaps) const {
+  return search_cluster_tile_impl<false>(cluster_id, query_states, tile_size,
+                                         padded_dim, ex_bits, nullptr, heaps);
+}
+
+int IvfRabitqEntity::search_cluster_tile(
+    uint32_t cluster_id, const IvfRabitqQueryState *const *query_states,
+    size_t tile_size, size_t padded_dim, size_t ex_bits,
+    const IndexFilter &filter, IndexDocumentHeap *const *heaps) const {
+  return search_cluster_tile_impl<true>(cluster_id, query_states, tile_size,
+                                        padded_dim, ex_bits, &filter, heaps);
 }
 
 int IvfRabitqEntity::search_cluster_group_by(
@@ -468,27 +488,44 @@ int IvfRabitqEntity::compute_distances(uint32_t cluster_id,
 }
 
 // Cluster scan with lower-bound pruning — mirrors rabitqlib IVF::scan_one_batch
+// Every query of the tile estimates against a 32-vector batch before moving on
+// to the next one, so the batch codes, keys and filter verdicts are pulled into
+// cache once per tile instead of once per query.
 template <bool HasFilter>
-int IvfRabitqEntity::search_cluster_impl(uint32_t cluster_id,
-                                         const IvfRabitqQueryState &query_state,
-                                         size_t padded_dim, size_t ex_bits,
-                                         const IndexFilter *filter,
-                                         IndexDocumentHeap *heap) const {
+int IvfRabitqEntity::search_cluster_tile_impl(
+    uint32_t cluster_id, const IvfRabitqQueryState *const *query_states,
+    size_t tile_size, size_t padded_dim, size_t ex_bits,
+    const IndexFilter *filter, IndexDocumentHeap *const *heaps) const {
   if (cluster_id >= cluster_metas_.size()) {
     LOG_ERROR("Invalid cluster_id=%zu", (size_t)cluster_id);
     return IndexError_OutOfRange;
   }
+  if (!query_states || !heaps || tile_size == 0 || tile_size > kMaxScanTile) {
+    LOG_ERROR("Invalid scan tile, size=%zu", tile_size);
+    return IndexError_InvalidArgument;
+  }
 
   const auto &meta = cluster_metas_[cluster_id];
   if (meta.vector_count == 0) {
     return 0;
   }
 
-  const auto *bq = static_cast<const rabitqlib::SplitBatchQuery<float> *>(
-      query_state.batch_query.get());
-  if (!bq) {
-    LOG_ERROR("Null batch_query in query_state");
-    return IndexError_InvalidArgument;
+  std::array<const rabitqlib::SplitBatchQuery<float> *, kMaxScanTile> bqs;
+  std::array<float, kMaxScanTile> distk;
+  for (size_t t = 0; t < tile_size; ++t) {
+    if (!query_states[t] || !heaps[t]) {
+      LOG_ERROR("Null query state or heap in scan tile");
+      return IndexError_InvalidArgument;
+    }
+    bqs[t] = static_cast<const rabitqlib::SplitBatchQuery<float> *>(
+        query_states[t]->batch_query.get());
+    if (!bqs[t]) {
+      LOG_ERROR("Null batch_query in query_state");
+      return IndexError_InvalidArgument;
+    }
+    // distk: current worst distance in heap, updated after each insertion
+    distk[t] = heaps[t]->full() ? heaps[t]->begin()->score()
+                                : std::numeric_limits<float>::max();
   }
 
   const size_t batch_stride =
@@ -510,62 +547,56 @@ int IvfRabitqEntity::search_cluster_impl(uint32_t cluster_id,
   uint32_t remaining = meta.vector_count;
   uint32_t offset = 0;
 
+  std::array<float, rabitqlib::fastscan::kBatchSize> est_dist;
+  std::array<float, rabitqlib::fastscan::kBatchSize> low_dist;
+  std::array<float, rabitqlib::fastscan::kBatchSize> ip_x0_qr;
+  // Filter verdicts of the current batch, shared by the tile:
+  // 0 = not evaluated yet, 1 = kept, 2 = filtered out
+  std::array<uint8_t, rabitqlib::fastscan::kBatchSize> verdicts;
+
   while (remaining > 0) {
     const uint32_t batch_size =
         std::min(remaining, (uint32_t)rabitqlib::fastscan::kBatchSize);
+    if constexpr (HasFilter) {
+      verdicts.fill(0);
+    }
 
-    // Step 1: 1-bit estimation for all 32 vectors at once (cheap, SIMD)
-    std::array<float, rabitqlib::fastscan::kBatchSize> est_dist;
-    std::array<float, rabitqlib::fastscan::kBatchSize> low_dist;
-    std::array<float, rabitqlib::fastscan::kBatchSize> ip_x0_qr;
+    for (size_t t = 0; t < tile_size; ++t) {
+      const auto &bq = *bqs[t];
+      IndexDocumentHeap *heap = heaps[t];
 
-    rabitqlib::split_batch_estdist(cur_batch, *bq, padded_dim, est_dist.data(),
-                                   low_dist.data(), ip_x0_qr.data(),
-                                   true /* use_hacc */);
+      // Step 1: 1-bit estimation for all 32 vectors at once (cheap, SIMD)
+      rabitqlib::split_batch_estdist(cur_batch, bq, padded_dim,
+                                     est_dist.data(), low_dist.data(),
+                                     ip_x0_qr.data(), true /* use_hacc */);
 
-    if (ex_bits == 0) {
-      // 1-bit only: scalar fast-reject before the heavy heap emplace so that
-      // rejected candidates cost a single float compare instead of building a
-      // full IndexDocument (matches rabitqlib SearchBuffer semantics).
-      float distk = heap->full() ? heap->begin()->score()
-                                 : std::numeric_limits<float>::max();
+      // Step 2: scalar fast-reject on the estimate (1-bit only) or the lower
+      // bound (extra bits) before the heap emplace, so rejected candidates
+      // cost a single float compare (matches rabitqlib SearchBuffer
+      // semantics); extra-bit boosting only runs for the survivors.
+      const float *bound = ex_bits == 0 ? est_dist.data() : low_dist.data();
       for (uint32_t i = 0; i < batch_size; ++i) {
-        if (est_dist[i] >= distk) {
+        if (bound[i] >= distk[t]) {
           continue;
         }
         uint64_t key = cur_keys[offset + i];
         if constexpr (HasFilter) {
-          if ((*filter)(key)) {
+          if (verdicts[i] == 0) {
+            verdicts[i] = (*filter)(key) ? 2 : 1;
+          }
+          if (verdicts[i] == 2) {
             continue;
           }
         }
-        heap->emplace(key, est_dist[i]);
-        if (heap->full()) {
-          distk = heap->begin()->score();
+        float dist = est_dist[i];
+        if (ex_bits > 0) {
+          dist = rabitqlib::split_distance_boosting(cur_ex + i * ex_stride,
+                                                    ip_func_, bq, padded_dim,
+                                                    ex_bits, ip_x0_qr[i]);
         }
-      }
-    } else {
-      // Step 2: lower-bound pruning + extra-bit boosting (same as rabitqlib)
-      // distk: current worst distance in heap, updated after each insertion
-      float distk = heap->full() ? heap->begin()->score()
-                                 : std::numeric_limits<float>::max();
-
-      for (uint32_t i = 0; i < batch_size; ++i) {
-        if (low_dist[i] < distk) {
-          uint64_t key = cur_keys[offset + i];
-          if constexpr (HasFilter) {
-            if ((*filter)(key)) {
-              continue;
-            }
-          }
-          // Extra-bit boosting (expensive, but only when needed)
-          const float ex_dist = rabitqlib::split_distance_boosting(
-              cur_ex + i * ex_stride, ip_func_, *bq, padded_dim, ex_bits,
-              ip_x0_qr[i]);
-          heap->emplace(key, ex_dist);
-          if (heap->full()) {
-            distk = heap->begin()->score();
-          }
+        heap->emplace(key, dist);
+        if (heap->full()) {
+          distk[t] = heap->begin()->score();
         }
       }
     }
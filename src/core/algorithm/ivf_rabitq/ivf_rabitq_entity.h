@@ -34,6 +34,9 @@ class IvfRabitqEntity {
  public:
   typedef std::shared_ptr<IvfRabitqEntity> Pointer;
 
+  //! Maximum number of queries sharing one cluster scan
+  static constexpr size_t kMaxScanTile = 8;
+
   IvfRabitqEntity() = default;
   ~IvfRabitqEntity() = default;
 
@@ -52,6 +55,21 @@ class IvfRabitqEntity {
                      size_t ex_bits, const IndexFilter &filter,
                      IndexDocumentHeap *heap) const;
 
+  //! Scan one cluster for a tile of up to kMaxScanTile queries, each with its
+  //! own prepared query state and heap. Every batch of codes is estimated
+  //! for the whole tile while it is cache resident, and filter verdicts are
+  //! evaluated once per vector. Results match per-query search_cluster.
+  int search_cluster_tile(uint32_t cluster_id,
+                          const IvfRabitqQueryState *const *query_states,
+                          size_t tile_size, size_t padded_dim, size_t ex_bits,
+                          IndexDocumentHeap *const *heaps) const;
+
+  int search_cluster_tile(uint32_t cluster_id,
+                          const IvfRabitqQueryState *const *query_states,
+                          size_t tile_size, size_t padded_dim, size_t ex_bits,
+                          const IndexFilter &filter,
+                          IndexDocumentHeap *const *heaps) const;
+
   int search_cluster_group_by(uint32_t cluster_id,
                               const IvfRabitqQueryState &query_state,
                               size_t padded_dim, size_t ex_bits,
@@ -133,11 +151,11 @@ class IvfRabitqEntity {
   rabitqlib::ex_ipfunc ip_func_{nullptr};
 
   template <bool HasFilter>
-  int search_cluster_impl(uint32_t cluster_id,
-                          const IvfRabitqQueryState &query_state,
-                          size_t padded_dim, size_t ex_bits,
-                          const IndexFilter *filter,
-                          IndexDocumentHeap *heap) const;
+  int search_cluster_tile_impl(uint32_t cluster_id,
+                               const IvfRabitqQueryState *const *query_states,
+                               size_t tile_size, size_t padded_dim,
+                               size_t ex_bits, const IndexFilter *filter,
+                               IndexDocumentHeap *const *heaps) const;
 
   template <bool HasFilter>
   int search_cluster_group_by_impl(
@@ -27,6 +27,8 @@ static const std::string PARAM_IVF_RABITQ_BRUTE_FORCE_THRESHOLD(
     "proxima.ivf_rabitq.brute_force_threshold");
 static const std::string PARAM_IVF_RABITQ_BUILDER_THREAD_COUNT(
     "proxima.ivf_rabitq.builder.thread_count");
+static const std::string PARAM_IVF_RABITQ_BATCH_SCAN_ENABLE(
+    "proxima.ivf_rabitq.batch_scan_enable");
 
 // Segment IDs
 static const std::string IVF_RABITQ_HEADER_SEG_ID{"ivf_rabitq.header"};
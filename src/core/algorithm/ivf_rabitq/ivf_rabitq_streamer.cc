@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include "ivf_rabitq_streamer.h"
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <map>
 #include <new>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <zvec/ailego/logger/logger.h>
@@ -332,6 +335,11 @@ int IvfRabitqStreamer::search_impl_internal(const void *query,
   // Reset results and heap for all queries
   ctx->reset_results(count);
 
+  if (count > 1 && ctx->batch_scan_enable()) {
+    return this->search_batch_impl_internal(query, qmeta, count, ctx, nprobe,
+                                            max_scan);
+  }
+
   for (uint32_t q = 0; q < count; ++q) {
     const float *q_vec = reinterpret_cast<const float *>(
         static_cast<const char *>(query) +
@@ -397,6 +405,103 @@ int IvfRabitqStreamer::search_impl_internal(const void *query,
   return 0;
 }
 
+int IvfRabitqStreamer::search_batch_impl_internal(
+    const void *query, const IndexQueryMeta &qmeta, uint32_t count,
+    IvfRabitqContext *ctx, uint32_t nprobe, uint32_t max_scan) const {
+  uint32_t topk = ctx->topk();
+  if (topk == 0) {
+    topk = 10;
+  }
+  size_t padded_dim = reformer_->padded_dim();
+  size_t ex_bits = reformer_->ex_bits();
+
+  auto &states = ctx->batch_query_states;
+  auto &probes = ctx->batch_probe_centroids;
+  states.resize(count);
+  probes.resize(count);
+
+  //! (cluster, query, probe) triples, sorted to visit each cluster once
+  std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> schedule;
+  schedule.reserve(static_cast<size_t>(count) * nprobe);
+  for (uint32_t q = 0; q < count; ++q) {
+    const float *q_vec = reinterpret_cast<const float *>(
+        static_cast<const char *>(query) +
+        (static_cast<size_t>(q) * qmeta.element_size()));
+
+    int ret = reformer_->create_query_state(q_vec, &states[q]);
+    if (ret != 0) {
+      LOG_ERROR("Failed to create query state, ret=%d", ret);
+      return ret;
+    }
+    ret = reformer_->select_probe_centroids(q_vec, nprobe, &states[q],
+                                            &probes[q]);
+    if (ret != 0) {
+      LOG_ERROR("Failed to select probe centroids, ret=%d", ret);
+      return ret;
+    }
+
+    // Same scan budget as the single query path
+    uint32_t scanned = 0;
+    for (uint32_t p = 0; p < probes[q].size() && scanned < max_scan; ++p) {
+      uint32_t cid = probes[q][p].id;
+      schedule.emplace_back(cid, q, p);
+      scanned += entity_->cluster_meta(cid).vector_count;
+    }
+  }
+  std::sort(schedule.begin(), schedule.end());
+
+  auto &heaps = ctx->reset_batch_heaps(count, topk);
+  const auto &filter = ctx->filter();
+  std::array<const IvfRabitqQueryState *, IvfRabitqEntity::kMaxScanTile>
+      tile_states;
+  std::array<IndexDocumentHeap *, IvfRabitqEntity::kMaxScanTile> tile_heaps;
+  size_t begin = 0;
+  while (begin < schedule.size()) {
+    // Queries probing the same cluster are scanned together, a tile at a time
+    uint32_t cid = std::get<0>(schedule[begin]);
+    size_t end = begin;
+    size_t tile_size = 0;
+    while (end < schedule.size() && std::get<0>(schedule[end]) == cid &&
+           tile_size < IvfRabitqEntity::kMaxScanTile) {
+      uint32_t q = std::get<1>(schedule[end]);
+      int ret = reformer_->prepare_for_cluster(
+          probes[q][std::get<2>(schedule[end])], &states[q]);
+      ++end;
+      if (ret != 0) {
+        LOG_ERROR("Failed to prepare for cluster %zu, ret=%d", (size_t)cid,
+                  ret);
+        continue;
+      }
+      tile_states[tile_size] = &states[q];
+      tile_heaps[tile_size] = &heaps[q];
+      ++tile_size;
+    }
+    begin = end;
+    if (tile_size == 0) {
+      continue;
+    }
+
+    int ret = 0;
+    if (!filter.is_valid()) {
+      ret = entity_->search_cluster_tile(cid, tile_states.data(), tile_size,
+                                         padded_dim, ex_bits,
+                                         tile_heaps.data());
+    } else {
+      ret = entity_->search_cluster_tile(cid, tile_states.data(), tile_size,
+                                         padded_dim, ex_bits, filter,
+                                         tile_heaps.data());
+    }
+    if (ret != 0) {
+      LOG_ERROR("Failed to search cluster %zu, ret=%d", (size_t)cid, ret);
+    }
+  }
+
+  for (uint32_t q = 0; q < count; ++q) {
+    ctx->topk_to_result(q, &heaps[q]);
+  }
+  return 0;
+}
+
 int IvfRabitqStreamer::search_group_by_impl_internal(
     const void *query, const IndexQueryMeta &qmeta, uint32_t count,
     Context::Pointer &context, bool force_brute_force) const {
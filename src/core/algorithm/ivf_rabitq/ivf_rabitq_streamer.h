@@ -24,6 +24,7 @@ namespace core {
 
 class IvfRabitqReformer;
 class IvfRabitqEntity;
+class IvfRabitqContext;
 
 /*! IVF RaBitQ Streamer
  * Combines IVF partitioning with RaBitQ quantization for fast approximate
@@ -115,6 +116,12 @@ class IvfRabitqStreamer : public IndexStreamer {
                            uint32_t count, Context::Pointer &context,
                            bool force_brute_force) const;
 
+  //! Scan the probed clusters of all queries, grouped by cluster
+  int search_batch_impl_internal(const void *query,
+                                 const IndexQueryMeta &qmeta, uint32_t count,
+                                 IvfRabitqContext *ctx, uint32_t nprobe,
+                                 uint32_t max_scan) const;
+
   int search_group_by_impl_internal(const void *query,
                                     const IndexQueryMeta &qmeta, uint32_t count,
                                     Context::Pointer &context,
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "vamana_algorithm.h"
+#include <algorithm>
 #include <type_traits>
 #include <ailego/internal/cpu_features.h>
 
@@ -85,10 +86,20 @@ int VamanaAlgorithm<EntityType>::add_node(node_id_t id, VamanaContext *ctx) {
 // every point is visible, this pass searches from the final entry point,
 // combines the search result with each node's existing outgoing edges, and
 // applies RobustPrune with the configured target alpha.
+//
+// Nodes are refined in rounds of doubling size (ParlayANN style). Within a
+// round the graph is frozen while the new neighbor lists are computed in
+// parallel; they are then written, and the reverse edges are grouped by
+// target so every target is merged and pruned once by a single thread.
+// Nothing depends on scheduling, so the graph is reproducible.
 // ============================================================================
 template <typename EntityType>
-int VamanaAlgorithm<EntityType>::refine_graph(VamanaContext *ctx, float alpha) {
-  if (ctx == nullptr) return IndexError_InvalidArgument;
+int VamanaAlgorithm<EntityType>::refine_graph(
+    const std::vector<VamanaContext *> &ctxs, IndexThreads *threads,
+    float alpha) {
+  if (ctxs.empty() || ctxs.front() == nullptr) {
+    return IndexError_InvalidArgument;
+  }
   int ret = entity_.ensure_dist_storage();
   if (ailego_unlikely(ret != 0)) {
     return ret;
@@ -99,17 +110,120 @@ int VamanaAlgorithm<EntityType>::refine_graph(VamanaContext *ctx, float alpha) {
     return 0;
   }
 
-  ctx->check_need_adjuct_ctx(n);
+  for (auto *ctx : ctxs) {
+    ctx->check_need_adjuct_ctx(n);
+  }
+
+  std::vector<node_id_t> ids;
+  ids.reserve(n);
   for (node_id_t id = 0; id < n; ++id) {
     if (entity_.get_key(id) == kInvalidKey) continue;
     if (entity_.get_vector(id) == nullptr) continue;
-    ret = refine_node(id, alpha, ctx);
+    ids.push_back(id);
+  }
+
+  const size_t max_batch_size = std::max<size_t>(
+      1, static_cast<size_t>(ids.size() * kMaxBatchFraction));
+  std::vector<std::vector<std::pair<node_id_t, dist_t>>> pruned(
+      std::min(max_batch_size, ids.size()));
+  std::vector<ReverseLink> links;
+  std::vector<size_t> groups;
+
+  size_t batch_size = 1;
+  for (size_t begin = 0; begin < ids.size(); begin += batch_size,
+              batch_size = std::min(batch_size * 2, max_batch_size)) {
+    const size_t end = std::min(begin + batch_size, ids.size());
+
+    // Compute the new neighbor lists against the frozen graph
+    ret = parallel_for(ctxs, threads, end - begin,
+                       [&](VamanaContext *ctx, size_t i) {
+                         return refine_node(ids[begin + i], alpha, ctx,
+                                            &pruned[i]);
+                       });
+    if (ailego_unlikely(ret != 0)) {
+      return ret;
+    }
+
+    links.clear();
+    for (size_t i = 0; i < end - begin; ++i) {
+      node_id_t id = ids[begin + i];
+      entity_.update_neighbors(id, pruned[i]);
+      entity_.update_neighbor_dists(id, pruned[i]);
+      for (const auto &[neighbor_id, dist] : pruned[i]) {
+        links.push_back({neighbor_id, id, dist});
+      }
+    }
+
+    // Group the reverse edges by target, ordered by source within a group
+    std::sort(links.begin(), links.end(),
+              [](const ReverseLink &lhs, const ReverseLink &rhs) {
+                return lhs.target != rhs.target ? lhs.target < rhs.target
+                                                : lhs.source < rhs.source;
+              });
+    groups.clear();
+    for (size_t i = 0; i < links.size(); ++i) {
+      if (i == 0 || links[i].target != links[i - 1].target) {
+        groups.push_back(i);
+      }
+    }
+    groups.push_back(links.size());
+
+    ret = parallel_for(ctxs, threads, groups.size() - 1,
+                       [&](VamanaContext *ctx, size_t g) {
+                         const ReverseLink *first = &links[groups[g]];
+                         reverse_update_neighbors(first->target, first,
+                                                  groups[g + 1] - groups[g],
+                                                  ctx);
+                         return 0;
+                       });
     if (ailego_unlikely(ret != 0)) {
       return ret;
     }
-    if (ailego_unlikely(ctx->error())) {
+  }
+  return 0;
+}
+
+template <typename EntityType>
+template <typename Func>
+int VamanaAlgorithm<EntityType>::parallel_for(
+    const std::vector<VamanaContext *> &ctxs, IndexThreads *threads,
+    size_t count, const Func &func) const {
+  size_t worker_cnt = threads ? std::min(ctxs.size(), threads->count()) : 1;
+  worker_cnt = std::max<size_t>(1, std::min(worker_cnt, count));
+
+  std::vector<int> results(worker_cnt, 0);
+  auto work = [&](size_t w) {
+    VamanaContext *ctx = ctxs[w];
+    for (size_t i = w; i < count; i += worker_cnt) {
+      int ret = func(ctx, i);
+      if (ailego_unlikely(ret == 0 && ctx->error())) {
+        ret = IndexError_Runtime;
+      }
+      if (ailego_unlikely(ret != 0)) {
+        results[w] = ret;
+        return;
+      }
+    }
+  };
+
+  if (worker_cnt == 1) {
+    work(0);
+  } else {
+    auto task_group = threads->make_group();
+    if (!task_group) {
+      LOG_ERROR("Failed to create task group");
       return IndexError_Runtime;
     }
+    for (size_t w = 0; w < worker_cnt; ++w) {
+      task_group->submit(ailego::Closure::New([&work, w]() { work(w); }));
+    }
+    task_group->wait_finish();
+  }
+
+  for (int ret : results) {
+    if (ret != 0) {
+      return ret;
+    }
   }
   return 0;
 }
@@ -409,8 +523,11 @@ void VamanaAlgorithm<EntityType>::greedy_search(node_id_t entry_point,
 }
 
 template <typename EntityType>
-int VamanaAlgorithm<EntityType>::refine_node(node_id_t id, float alpha,
-                                             VamanaContext *ctx) {
+int VamanaAlgorithm<EntityType>::refine_node(
+    node_id_t id, float alpha, VamanaContext *ctx,
+    std::vector<std::pair<node_id_t, dist_t>> *pruned) const {
+  pruned->clear();
+
   const void *query_vec = entity_.get_vector(id);
   if (ailego_unlikely(query_vec == nullptr)) {
     return IndexError_ReadData;
@@ -476,11 +593,7 @@ int VamanaAlgorithm<EntityType>::refine_node(node_id_t id, float alpha,
   }
 
   robust_prune(id, candidates, alpha, entity_.max_degree(), ctx);
-  auto pruned_neighbors = ctx->prune_result();
-
-  entity_.update_neighbors(id, pruned_neighbors);
-  entity_.update_neighbor_dists(id, pruned_neighbors);
-  update_neighbors_and_reverse_links(id, pruned_neighbors, ctx);
+  *pruned = ctx->prune_result();
 
   return 0;
 }
@@ -724,6 +837,66 @@ void VamanaAlgorithm<EntityType>::reverse_update_neighbor(node_id_t id,
   entity_.update_neighbor_dists(neighbor_id, prune_result);
 }
 
+// ============================================================================
+// reverse_update_neighbors: Add the sources of `count` reverse links as
+// neighbors of `target`. The links are appended while they fit, otherwise
+// the current neighbors and all new links are pruned together once.
+// ============================================================================
+template <typename EntityType>
+void VamanaAlgorithm<EntityType>::reverse_update_neighbors(
+    node_id_t target, const ReverseLink *links, size_t count,
+    VamanaContext *ctx) {
+  const Neighbors current_neighbors = entity_.get_neighbors(target);
+  const uint32_t current_size = current_neighbors.size();
+  const uint32_t max_deg = entity_.max_degree();
+
+  auto &merged = ctx->prune_result();
+  merged.clear();
+
+  const dist_t *cached_dists = entity_.get_neighbor_dists(target);
+  const void *target_vec = entity_.get_vector(target);
+  VamanaDistCalculator &dc = ctx->dist_calculator();
+  for (uint32_t i = 0; i < current_size; ++i) {
+    node_id_t nbr = current_neighbors[i];
+    if (cached_dists != nullptr) {
+      merged.emplace_back(nbr, cached_dists[i]);
+      continue;
+    }
+    const void *nbr_vec = entity_.get_vector(nbr);
+    if (ailego_unlikely(target_vec == nullptr || nbr_vec == nullptr)) {
+      continue;
+    }
+    merged.emplace_back(nbr, dc.dist(target_vec, nbr_vec));
+  }
+
+  bool added = false;
+  for (size_t i = 0; i < count; ++i) {
+    bool found = links[i].source == target;
+    for (uint32_t j = 0; !found && j < current_size; ++j) {
+      found = current_neighbors[j] == links[i].source;
+    }
+    if (!found) {
+      merged.emplace_back(links[i].source, links[i].dist);
+      added = true;
+    }
+  }
+  if (!added) return;
+
+  if (merged.size() > max_deg) {
+    TopkHeap &prune_candidates = ctx->update_heap();
+    prune_candidates.clear();
+    prune_candidates.limit(merged.size());
+    for (const auto &it : merged) {
+      prune_candidates.emplace(it.first, it.second);
+    }
+    robust_prune(target, prune_candidates, entity_.alpha(), max_deg, ctx);
+  }
+
+  const auto &result = ctx->prune_result();
+  entity_.update_neighbors(target, result);
+  entity_.update_neighbor_dists(target, result);
+}
+
 // Explicit template instantiation for all entity types
 template class VamanaAlgorithm<VamanaMmapStreamerEntity>;
 template class VamanaAlgorithm<VamanaBufferPoolStreamerEntity>;
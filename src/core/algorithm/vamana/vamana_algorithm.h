@@ -17,6 +17,7 @@
 #include <mutex>
 #include <vector>
 #include <ailego/parallel/lock.h>
+#include <zvec/core/framework/index_threads.h>
 #include "vamana_context.h"
 #include "vamana_dist_calculator.h"
 #include "vamana_streamer_entity.h"
@@ -41,8 +42,11 @@ class VamanaAlgorithmBase {
   // Greedy search: find approximate nearest neighbors.
   virtual int search(VamanaContext *ctx) const = 0;
 
-  // Revisit every node after the initial alpha=1.0 graph pass.
-  virtual int refine_graph(VamanaContext *ctx, float alpha) = 0;
+  // Revisit every node after the initial alpha=1.0 graph pass. Each thread
+  // of `threads` works with its own context out of `ctxs`; without threads
+  // the pass runs on ctxs[0]. The result does not depend on thread count.
+  virtual int refine_graph(const std::vector<VamanaContext *> &ctxs,
+                           IndexThreads *threads, float alpha) = 0;
 
   virtual int init() = 0;
 };
@@ -79,8 +83,9 @@ class VamanaAlgorithm : public VamanaAlgorithmBase {
   // Greedy search from entry point. Results are stored in ctx->topk_heap().
   int search(VamanaContext *ctx) const override;
 
-  // Full-graph second construction pass.
-  int refine_graph(VamanaContext *ctx, float alpha) override;
+  // Full-graph second construction pass, run in batched rounds.
+  int refine_graph(const std::vector<VamanaContext *> &ctxs,
+                   IndexThreads *threads, float alpha) override;
 
  private:
   // GreedySearch: starting from entry_point, greedily expand the closest
@@ -95,8 +100,27 @@ class VamanaAlgorithm : public VamanaAlgorithmBase {
   void robust_prune(node_id_t id, TopkHeap &candidates, float alpha,
                     uint32_t max_degree, VamanaContext *ctx) const;
 
-  // Refine one node during a full-graph construction pass.
-  int refine_node(node_id_t id, float alpha, VamanaContext *ctx);
+  // A reverse edge target -> source produced by a refine round.
+  struct ReverseLink {
+    node_id_t target;
+    node_id_t source;
+    dist_t dist;
+  };
+
+  // Compute the refined neighbor list of one node against the current
+  // graph, leaving the graph untouched. Result is stored in `pruned`.
+  int refine_node(node_id_t id, float alpha, VamanaContext *ctx,
+                  std::vector<std::pair<node_id_t, dist_t>> *pruned) const;
+
+  // Add all reverse links of one target at once, pruning it at most once.
+  void reverse_update_neighbors(node_id_t target, const ReverseLink *links,
+                                size_t count, VamanaContext *ctx);
+
+  // Run func(ctx, i) for i in [0, count), spread over the threads.
+  template <typename Func>
+  int parallel_for(const std::vector<VamanaContext *> &ctxs,
+                   IndexThreads *threads, size_t count,
+                   const Func &func) const;
 
   // Update node's neighbors and handle reverse links.
   void update_neighbors_and_reverse_links(
@@ -113,6 +137,9 @@ class VamanaAlgorithm : public VamanaAlgorithmBase {
   VamanaAlgorithm(const VamanaAlgorithm &) = delete;
   VamanaAlgorithm &operator=(const VamanaAlgorithm &) = delete;
 
+  // Refine rounds double in size up to this fraction of the graph.
+  static constexpr float kMaxBatchFraction{0.02f};
+
   static constexpr uint32_t kLockCnt{1U << 8};
   static constexpr uint32_t kLockMask{kLockCnt - 1U};
 
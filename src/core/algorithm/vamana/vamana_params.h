@@ -78,6 +78,8 @@ static const std::string PARAM_VAMANA_STREAMER_USE_CONTIGUOUS_MEMORY(
     "proxima.vamana.streamer.use_contiguous_memory");
 static const std::string PARAM_VAMANA_STREAMER_TWO_PASS_BUILD_ENABLE(
     "proxima.vamana.streamer.two_pass_build_enable");
+static const std::string PARAM_VAMANA_STREAMER_BUILD_THREAD_COUNT(
+    "proxima.vamana.streamer.build_thread_count");
 
 }  // namespace core
 }  // namespace zvec
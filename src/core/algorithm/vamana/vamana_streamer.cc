@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "vamana_streamer.h"
 #include <iostream>
+#include <thread>
 #include <ailego/pattern/defer.h>
 #include <ailego/utility/memory_helper.h>
 #include "vamana_algorithm.h"
@@ -57,6 +58,7 @@ int VamanaStreamer::init(const IndexMeta &imeta, const ailego::Params &params) {
              &use_contiguous_memory_);
   params.get(PARAM_VAMANA_STREAMER_TWO_PASS_BUILD_ENABLE,
              &two_pass_build_enabled_);
+  params.get(PARAM_VAMANA_STREAMER_BUILD_THREAD_COUNT, &build_thread_count_);
 
   size_t docs_soft_limit = 0;
   params.get(PARAM_VAMANA_STREAMER_DOCS_SOFT_LIMIT, &docs_soft_limit);
@@ -151,6 +153,7 @@ int VamanaStreamer::cleanup(void) {
   check_crc_enabled_ = false;
   get_vector_enabled_ = false;
   two_pass_build_enabled_ = false;
+  build_thread_count_ = 0U;
   build_finalized_.store(false);
 
   return 0;
@@ -410,32 +413,47 @@ int VamanaStreamer::finalize_build_locked() {
     return 0;
   }
 
+  // One context per refine thread, the pass is reproducible for any count
+  uint32_t thread_count = build_thread_count_;
+  if (thread_count == 0) {
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+  IndexThreads::Pointer threads;
+  if (thread_count > 1) {
+    threads = std::make_shared<SingleQueueIndexThreads>(thread_count, false);
+    thread_count = static_cast<uint32_t>(threads->count());
+  }
+
   VamanaEntity::Pointer entity_ref(entity_.get(), [](VamanaEntity *) {});
-  auto ctx =
-      std::make_unique<VamanaContext>(meta_.dimension(), metric_, entity_ref);
-  ctx->set_ef(ef_);
-  ctx->set_max_scan_limit(max_scan_limit_);
-  ctx->set_min_scan_limit(min_scan_limit_);
-  ctx->set_max_scan_ratio(max_scan_ratio_);
-  ctx->set_magic(magic_);
-  ctx->set_force_padding_topk(force_padding_topk_enabled_);
-  ctx->set_bruteforce_threshold(bruteforce_threshold_);
+  std::vector<std::unique_ptr<VamanaContext>> ctxs;
+  std::vector<VamanaContext *> ctx_ptrs;
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    auto ctx =
+        std::make_unique<VamanaContext>(meta_.dimension(), metric_, entity_ref);
+    ctx->set_ef(ef_);
+    ctx->set_max_scan_limit(max_scan_limit_);
+    ctx->set_min_scan_limit(min_scan_limit_);
+    ctx->set_max_scan_ratio(max_scan_ratio_);
+    ctx->set_magic(magic_);
+    ctx->set_force_padding_topk(force_padding_topk_enabled_);
+    ctx->set_bruteforce_threshold(bruteforce_threshold_);
+
+    int ret = ctx->init(VamanaContext::kStreamerContext);
+    if (ret != 0) {
+      LOG_ERROR("Init Vamana refine context failed");
+      return ret;
+    }
 
-  int ret = ctx->init(VamanaContext::kStreamerContext);
-  if (ret != 0) {
-    LOG_ERROR("Init Vamana refine context failed");
-    return ret;
+    ctx->check_need_adjuct_ctx(entity_->doc_cnt());
+    ctx->update_dist_calculator_distance(add_distance_, add_batch_distance_);
+    ctx_ptrs.push_back(ctx.get());
+    ctxs.push_back(std::move(ctx));
   }
 
-  ctx->check_need_adjuct_ctx(entity_->doc_cnt());
-  ctx->update_dist_calculator_distance(add_distance_, add_batch_distance_);
-
-  LOG_INFO("Vamana two-pass second graph pass: alpha=%.2f", alpha_);
-  ret = alg_->refine_graph(ctx.get(), alpha_);
+  LOG_INFO("Vamana two-pass second graph pass: alpha=%.2f threads=%u", alpha_,
+           thread_count);
+  int ret = alg_->refine_graph(ctx_ptrs, threads.get(), alpha_);
   if (ret != 0) return ret;
-  if (ctx->error()) {
-    return IndexError_Runtime;
-  }
 
   stats_.mutable_attributes()->set("vamana_refine_pass_count", uint32_t{1});
   stats_.mutable_attributes()->set("vamana_build_pass_count", uint32_t{2});
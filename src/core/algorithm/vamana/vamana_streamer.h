@@ -177,6 +177,7 @@ class VamanaStreamer : public IndexStreamer {
   size_t max_scan_limit_{VamanaEntity::kDefaultMaxScanLimit};
   size_t min_scan_limit_{VamanaEntity::kDefaultMinScanLimit};
   float max_scan_ratio_{VamanaEntity::kDefaultScanRatio};
+  uint32_t build_thread_count_{0U};
 
   uint32_t magic_{0U};
   State state_{STATE_INIT};
@@ -114,6 +114,9 @@ int Index::ParseMetricName(const BaseIndexParam &param) {
       case MetricType::kMIPSL2sq:
         metric_name = "MipsSquaredEuclidean";
         break;
+      case MetricType::kHamming:
+        metric_name = "Hamming";
+        break;
       default:
         LOG_ERROR("Unsupported metric type");
         return core::IndexError_Runtime;
@@ -647,9 +650,8 @@ int Index::_dense_fetch(const uint32_t doc_id,
       return core::IndexError_Runtime;
     }
   } else {
-    out_vector_buffer = std::string(
-        static_cast<const char *>(vector),
-        input_vector_meta_.dimension() * input_vector_meta_.unit_size());
+    out_vector_buffer = std::string(static_cast<const char *>(vector),
+                                    input_vector_meta_.element_size());
   }
   vector_data_buffer->vector_buffer = std::move(dense_vector_buffer);
   return 0;
@@ -1112,6 +1114,8 @@ std::string Index::get_metric_name(MetricType metric_type, bool is_sparse) {
         return "Cosine";
       case MetricType::kMIPSL2sq:
         return "MipsSquaredEuclidean";
+      case MetricType::kHamming:
+        return "Hamming";
       default:
         return "";
     }
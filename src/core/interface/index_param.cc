@@ -241,6 +241,10 @@ ailego::JsonObject FlatIndexParam::SerializeToJsonObject(
     json_obj.set("major_order",
                  ailego::JsonValue(magic_enum::enum_name(major_order).data()));
   }
+  if (!omit_empty_value || use_inverted) {
+    json_obj.set("use_inverted", ailego::JsonValue(use_inverted));
+    json_obj.set("heap_factor", ailego::JsonValue(heap_factor));
+  }
   return json_obj;
 }
 
@@ -305,6 +309,8 @@ bool FlatIndexParam::DeserializeFromJsonObject(
   }
 
   DESERIALIZE_ENUM_FIELD(json_obj, major_order, IndexMeta::MajorOrder);
+  DESERIALIZE_VALUE_FIELD(json_obj, use_inverted);
+  DESERIALIZE_VALUE_FIELD(json_obj, heap_factor);
   return true;
 }
 
@@ -16,6 +16,7 @@
 #include <string>
 #include <zvec/core/interface/index.h>
 #include "algorithm/flat/flat_utility.h"
+#include "algorithm/inverted_sparse/inverted_sparse_params.h"
 
 namespace zvec::core_interface {
 
@@ -25,7 +26,11 @@ int FlatIndex::CreateAndInitStreamer(const BaseIndexParam &param) {
   proxima_index_params_.set(core::PARAM_FLAT_COLUMN_MAJOR_ORDER,
                             param_.major_order == IndexMeta::MO_COLUMN);
   proxima_index_params_.set(core::PARAM_FLAT_USE_ID_MAP, param_.use_id_map);
-  if (is_sparse_) {
+  if (is_sparse_ && param_.use_inverted) {
+    proxima_index_params_.set(core::PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR,
+                              param_.heap_factor);
+    streamer_ = core::IndexFactory::CreateStreamer("InvertedSparseStreamer");
+  } else if (is_sparse_) {
     streamer_ = core::IndexFactory::CreateStreamer("FlatSparseStreamer");
   } else {
     streamer_ = core::IndexFactory::CreateStreamer("FlatStreamer");
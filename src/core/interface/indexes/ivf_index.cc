@@ -32,6 +32,8 @@ int IVFIndex::CreateAndInitStreamer(const BaseIndexParam &param) {
 
   proxima_index_params_.set(core::PARAM_IVF_BUILDER_CENTROID_COUNT,
                             param_.nlist);
+  proxima_index_params_.set(core::PARAM_IVF_BUILDER_FASTSCAN_ENABLE,
+                            param_.use_fastscan);
 
   // TODO: add_vector_with_id & fetch_by_id don't rely on this param
   builder_ = core::IndexFactory::CreateBuilder("IVFBuilder");
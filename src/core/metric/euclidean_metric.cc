@@ -623,6 +623,11 @@ class SquaredEuclideanMetric : public IndexMetric {
     }
   }
 
+  //! Retrieve how the metric measures raw vectors
+  Measure measure(void) const override {
+    return Measure::kSquaredEuclidean;
+  }
+
   //! Retrieve params of Metric
   const ailego::Params &params(void) const override {
     return params_;
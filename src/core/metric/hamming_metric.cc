@@ -0,0 +1,277 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <ailego/math/hamming_distance_matrix.h>
+#include <zvec/core/framework/index_error.h>
+#include <zvec/core/framework/index_factory.h>
+#include <zvec/core/framework/index_metric.h>
+
+namespace zvec {
+namespace core {
+
+//! Retrieve distance function for index features (BINARY32)
+static inline IndexMetric::MatrixDistanceHandle HammingDistanceMatrixBinary32(
+    size_t m, size_t n) {
+  static const IndexMetric::MatrixDistanceHandle distance_table[6][6] = {
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 1, 1>::Compute),
+       nullptr,
+       nullptr,
+       nullptr,
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 2, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 2, 2>::Compute),
+       nullptr,
+       nullptr,
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 4, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 4, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 4, 4>::Compute),
+       nullptr,
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 8, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 8, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 8, 4>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 8, 8>::Compute),
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 16, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 16, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 16, 4>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 16, 8>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 16, 16>::Compute),
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 32, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 32, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 32, 4>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 32, 8>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 32, 16>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint32_t, 32, 32>::Compute)},
+  };
+  if (m > 32 || n > 32 || ailego_popcount(m) != 1 || ailego_popcount(n) != 1) {
+    return nullptr;
+  }
+  return distance_table[ailego_ctz(m)][ailego_ctz(n)];
+}
+
+//! Retrieve distance function for index features (BINARY64)
+static inline IndexMetric::MatrixDistanceHandle HammingDistanceMatrixBinary64(
+    size_t m, size_t n) {
+  static const IndexMetric::MatrixDistanceHandle distance_table[6][6] = {
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 1, 1>::Compute),
+       nullptr,
+       nullptr,
+       nullptr,
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 2, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 2, 2>::Compute),
+       nullptr,
+       nullptr,
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 4, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 4, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 4, 4>::Compute),
+       nullptr,
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 8, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 8, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 8, 4>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 8, 8>::Compute),
+       nullptr,
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 16, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 16, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 16, 4>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 16, 8>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 16, 16>::Compute),
+       nullptr},
+      {reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 32, 1>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 32, 2>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 32, 4>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 32, 8>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 32, 16>::Compute),
+       reinterpret_cast<IndexMetric::MatrixDistanceHandle>(
+           ailego::HammingDistanceMatrix<uint64_t, 32, 32>::Compute)},
+  };
+  if (m > 32 || n > 32 || ailego_popcount(m) != 1 || ailego_popcount(n) != 1) {
+    return nullptr;
+  }
+  return distance_table[ailego_ctz(m)][ailego_ctz(n)];
+}
+
+//! Compute the distances between a batch of vectors and the query
+template <typename T>
+static void HammingDistanceBatch(const T **m, const T *q, size_t num,
+                                 size_t dim, float *out) {
+  for (size_t i = 0; i < num; ++i) {
+    ailego::HammingDistanceMatrix<T, 1, 1>::Compute(m[i], q, dim, out + i);
+  }
+}
+
+/*! Hamming Metric
+ *  The distance is the number of differing bits of two binary vectors, the
+ *  dimension of which is counted in bits.
+ */
+class HammingMetric : public IndexMetric {
+ public:
+  //! Initialize Metric
+  int init(const IndexMeta &meta, const ailego::Params &index_params) override {
+    IndexMeta::DataType dt = meta.data_type();
+    if (dt != IndexMeta::DataType::DT_BINARY32 &&
+        dt != IndexMeta::DataType::DT_BINARY64) {
+      LOG_ERROR("HammingMetric: unsupported type %d", dt);
+      return IndexError_Unsupported;
+    }
+    if (IndexMeta::UnitSizeof(dt) != meta.unit_size()) {
+      return IndexError_Unsupported;
+    }
+    if (meta.dimension() % (meta.unit_size() << 3) != 0) {
+      LOG_ERROR("HammingMetric: dimension %u is not a multiple of %u bits",
+                meta.dimension(), meta.unit_size() << 3);
+      return IndexError_InvalidArgument;
+    }
+    data_type_ = dt;
+    params_ = index_params;
+    return 0;
+  }
+
+  //! Cleanup Metric
+  int cleanup(void) override {
+    return 0;
+  }
+
+  //! Retrieve if it matched
+  bool is_matched(const IndexMeta &meta) const override {
+    return (meta.data_type() == data_type_ &&
+            meta.unit_size() == IndexMeta::UnitSizeof(data_type_));
+  }
+
+  //! Retrieve if it matched
+  bool is_matched(const IndexMeta &meta,
+                  const IndexQueryMeta &qmeta) const override {
+    return (qmeta.data_type() == data_type_ &&
+            qmeta.unit_size() == IndexMeta::UnitSizeof(data_type_) &&
+            qmeta.dimension() == meta.dimension());
+  }
+
+  //! Retrieve distance function for query
+  MatrixDistance distance(void) const override {
+    switch (data_type_) {
+      case IndexMeta::DataType::DT_BINARY32:
+        return reinterpret_cast<MatrixDistanceHandle>(
+            ailego::HammingDistanceMatrix<uint32_t, 1, 1>::Compute);
+
+      case IndexMeta::DataType::DT_BINARY64:
+        return reinterpret_cast<MatrixDistanceHandle>(
+            ailego::HammingDistanceMatrix<uint64_t, 1, 1>::Compute);
+
+      default:
+        return nullptr;
+    }
+  }
+
+  //! Retrieve distance function for index features
+  MatrixDistance distance_matrix(size_t m, size_t n) const override {
+    switch (data_type_) {
+      case IndexMeta::DataType::DT_BINARY32:
+        return HammingDistanceMatrixBinary32(m, n);
+
+      case IndexMeta::DataType::DT_BINARY64:
+        return HammingDistanceMatrixBinary64(m, n);
+
+      default:
+        return nullptr;
+    }
+  }
+
+  //! Retrieve distance function for query
+  MatrixBatchDistance batch_distance(void) const override {
+    switch (data_type_) {
+      case IndexMeta::DataType::DT_BINARY32:
+        return reinterpret_cast<IndexMetric::MatrixBatchDistanceHandle>(
+            HammingDistanceBatch<uint32_t>);
+
+      case IndexMeta::DataType::DT_BINARY64:
+        return reinterpret_cast<IndexMetric::MatrixBatchDistanceHandle>(
+            HammingDistanceBatch<uint64_t>);
+
+      default:
+        return nullptr;
+    }
+  }
+
+  //! Retrieve params of Metric
+  const ailego::Params &params(void) const override {
+    return params_;
+  }
+
+  //! Retrieve query metric object of this index metric
+  Pointer query_metric(void) const override {
+    return nullptr;
+  }
+
+ private:
+  IndexMeta::DataType data_type_{IndexMeta::DataType::DT_BINARY32};
+  ailego::Params params_{};
+};
+
+INDEX_FACTORY_REGISTER_METRIC_ALIAS(Hamming, HammingMetric);
+
+}  // namespace core
+}  // namespace zvec
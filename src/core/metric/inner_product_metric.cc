@@ -388,6 +388,11 @@ class InnerProductMetric : public IndexMetric {
     return true;
   }
 
+  //! Retrieve how the metric measures raw vectors
+  Measure measure(void) const override {
+    return Measure::kInnerProduct;
+  }
+
   //! Retrieve params of Metric
   const ailego::Params &params(void) const override {
     return params_;
@@ -515,15 +520,64 @@ class InnerProductSparseMetric : public IndexMetric {
   }
 
   //! Retrieve query measure object of this index measure
-  Pointer query_metric(void) const override {
-    return nullptr;
-  }
+  Pointer query_metric(void) const override;
 
- private:
+ protected:
   IndexMeta::DataType data_type_{IndexMeta::DataType::DT_FP32};
   ailego::Params params_{};
 };
 
+/*! Inner Product Sparse Query Metric
+ *  Scatters each query into dense tables before it is scored
+ */
+class InnerProductSparseQueryMetric : public InnerProductSparseMetric {
+ public:
+  //! Constructor
+  InnerProductSparseQueryMetric(IndexMeta::DataType data_type,
+                                const ailego::Params &params) {
+    data_type_ = data_type;
+    params_ = params;
+  }
+
+  //! Retrieve sparse distance function for query
+  MatrixSparseDistance sparse_distance(void) const override {
+    switch (data_type_) {
+      case IndexMeta::DataType::DT_FP16:
+        return reinterpret_cast<MatrixSparseDistanceHandle>(
+            ailego::MinusInnerProductSparseMatrix<
+                ailego::Float16>::ComputeQuery);
+      case IndexMeta::DataType::DT_FP32:
+        return reinterpret_cast<MatrixSparseDistanceHandle>(
+            ailego::MinusInnerProductSparseMatrix<float>::ComputeQuery);
+      default:
+        return nullptr;
+    }
+  }
+
+  //! Retrieve the query preprocess function of sparse distance
+  SparseQueryPreprocessFunc get_sparse_query_preprocess_func() const override {
+    switch (data_type_) {
+      case IndexMeta::DataType::DT_FP16:
+        return ailego::MinusInnerProductSparseMatrix<
+            ailego::Float16>::transform_sparse_query;
+      case IndexMeta::DataType::DT_FP32:
+        return ailego::MinusInnerProductSparseMatrix<
+            float>::transform_sparse_query;
+      default:
+        return nullptr;
+    }
+  }
+
+  //! Retrieve query measure object of this index measure
+  Pointer query_metric(void) const override {
+    return nullptr;
+  }
+};
+
+IndexMetric::Pointer InnerProductSparseMetric::query_metric(void) const {
+  return std::make_shared<InnerProductSparseQueryMetric>(data_type_, params_);
+}
+
 INDEX_FACTORY_REGISTER_METRIC_ALIAS(InnerProduct, InnerProductMetric);
 INDEX_FACTORY_REGISTER_METRIC_ALIAS(NormalizedCosine, NormalizedCosineMetric);
 
@@ -0,0 +1,37 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace zvec {
+namespace core {
+
+//! Subspace count of a 4-bit PQ code: the largest divisor of the dimension
+//! that keeps at least two dimensions per subspace, capped by max_count.
+//! Dimensions up to the cap without such a divisor fall back to one
+//! dimension per subspace, larger ones to 0 (no valid split).
+inline uint32_t PQSubspaceCount(uint32_t dimension, uint32_t max_count) {
+  const uint32_t limit = std::min(dimension / 2, max_count);
+  for (uint32_t count = limit; count > 1; --count) {
+    if (dimension % count == 0) {
+      return count;
+    }
+  }
+  return dimension <= max_count ? dimension : 0u;
+}
+
+}  // namespace core
+}  // namespace zvec
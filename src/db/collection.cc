@@ -43,6 +43,7 @@
 #include "db/common/profiler.h"
 #include "db/common/typedef.h"
 #include "db/doc_iterator_internal.h"
+#include "db/index/column/fts_column/fts_batch_tokenizer.h"
 #include "db/index/common/delete_store.h"
 #include "db/index/common/id_map.h"
 #include "db/index/common/index_filter.h"
@@ -254,11 +255,11 @@ class CollectionImpl : public Collection {
   // Called via Impl::release_slot when an iterator is closed or destroyed.
   void decrement_active_iterators();
 
-  Status handle_upsert(Doc &doc);
+  Status handle_upsert(Doc &doc, const fts::FtsTokenizedFields *fts_tokens);
 
-  Status handle_update(Doc &doc);
+  Status handle_update(Doc &doc, const fts::FtsTokenizedFields *fts_tokens);
 
-  Status handle_insert(Doc &doc);
+  Status handle_insert(Doc &doc, const fts::FtsTokenizedFields *fts_tokens);
 
   Status internal_fetch_by_doc(const Doc &doc, Doc::Ptr *doc_out);
 
@@ -1562,21 +1563,26 @@ Status CollectionImpl::internal_fetch_by_doc(const Doc &doc,
   return Status::OK();
 }
 
-Status CollectionImpl::handle_upsert(Doc &doc) {
-  return writing_segment_->Upsert(doc);
+Status CollectionImpl::handle_upsert(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
+  return writing_segment_->Upsert(doc, fts_tokens);
 }
 
-Status CollectionImpl::handle_update(Doc &doc) {
+Status CollectionImpl::handle_update(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
   Doc::Ptr old_doc{nullptr};
   auto s = internal_fetch_by_doc(doc, &old_doc);
   CHECK_RETURN_STATUS(s);
 
   old_doc->merge(doc);
-  return writing_segment_->Update(*old_doc);
+  // Fields the update leaves untouched are not in fts_tokens and get
+  // re-tokenized from old_doc by the segment.
+  return writing_segment_->Update(*old_doc, fts_tokens);
 }
 
-Status CollectionImpl::handle_insert(Doc &doc) {
-  return writing_segment_->Insert(doc);
+Status CollectionImpl::handle_insert(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
+  return writing_segment_->Insert(doc, fts_tokens);
 }
 
 Result<WriteResults> CollectionImpl::write_impl(std::vector<Doc> &docs,
@@ -1593,10 +1599,6 @@ Result<WriteResults> CollectionImpl::write_impl(std::vector<Doc> &docs,
     CHECK_RETURN_STATUS_EXPECTED(s);
   }
 
-  // TODO: The granularity of the write_lock is too coarse.
-  std::lock_guard write_lock(write_mtx_);
-
-  WriteResults results;
   // validate write batch size
   if (docs.size() > kMaxWriteBatchSize) {
     CHECK_RETURN_STATUS_EXPECTED(Status::InvalidArgument(
@@ -1604,7 +1606,23 @@ Result<WriteResults> CollectionImpl::write_impl(std::vector<Doc> &docs,
         kMaxWriteBatchSize));
   }
 
-  for (auto &&doc : docs) {
+  // Tokenize FTS fields before entering the ordered write section: it needs
+  // no segment state and is the dominant CPU cost for text-heavy docs.
+  std::vector<fts::FtsTokenizedFields> fts_tokens;
+  auto tokenize_status = fts::tokenize_fts_batch(
+      schema_->fts_fields(), docs,
+      GlobalResource::Instance().optimize_thread_pool(), &fts_tokens);
+  CHECK_RETURN_STATUS_EXPECTED(tokenize_status);
+
+  // TODO: The granularity of the write_lock is too coarse.
+  std::lock_guard write_lock(write_mtx_);
+
+  WriteResults results;
+  for (size_t i = 0; i < docs.size(); ++i) {
+    auto &doc = docs[i];
+    const fts::FtsTokenizedFields *doc_fts_tokens =
+        fts_tokens.empty() ? nullptr : &fts_tokens[i];
+
     if (need_switch_to_new_segment()) {
       auto s = switch_to_new_segment_for_writing();
       CHECK_RETURN_STATUS_EXPECTED(s);
@@ -1614,13 +1632,13 @@ Result<WriteResults> CollectionImpl::write_impl(std::vector<Doc> &docs,
 
     switch (mode) {
       case WriteMode::UPSERT:
-        s = handle_upsert(doc);
+        s = handle_upsert(doc, doc_fts_tokens);
         break;
       case WriteMode::UPDATE:
-        s = handle_update(doc);
+        s = handle_update(doc, doc_fts_tokens);
         break;
       case WriteMode::INSERT:
-        s = handle_insert(doc);
+        s = handle_insert(doc, doc_fts_tokens);
         break;
       default:
         s = Status::InvalidArgument("Invalid write mode");
@@ -39,6 +39,7 @@ GlobalConfig::ConfigData::ConfigData()
       invert_to_forward_scan_ratio(0.9),
       brute_force_by_keys_ratio(0.1),
       fts_brute_force_by_keys_ratio(0.05),
+      fts_query_cache_bytes(DEFAULT_FTS_QUERY_CACHE_BYTES),
       optimize_thread_count(query_thread_count),
       optimize_thread_binding(false),
       jieba_dict_dir() {}
@@ -80,6 +81,12 @@ Status GlobalConfig::validate(const ConfigData &config) const {
         "fts_brute_force_by_keys_ratio must be between 0 and 1");
   }
 
+  // Validate fts_query_cache_bytes (a share of the memory limit)
+  if (config.fts_query_cache_bytes > config.memory_limit_bytes) {
+    return Status::InvalidArgument(
+        "fts_query_cache_bytes must not exceed memory_limit_bytes");
+  }
+
   // Validate optimize thread count
   if (config.optimize_thread_count == 0) {
     return Status::InvalidArgument(
@@ -56,4 +56,8 @@ TERM: TERM_START TERM_BODY*;
 // ── Whitespace (skip) ─────────────────────────────────────────────────────────
 SPACES: [ \t\r\n]+ -> skip;
 
+// ── Phrase slop ──────────────────────────────────────────────────────────────
+// Must precede DEFAULT, which would otherwise claim the same single character.
+TILDE:       '~';
+
 DEFAULT: . ;
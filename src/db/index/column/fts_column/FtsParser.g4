@@ -86,7 +86,7 @@ fts_term
     | fts_natural_term
     ;
 
-// ── Phrase: double-quoted string ─────────────────────────────────────────────
+// ── Phrase: double-quoted string with optional slop '~' NUMBER ───────────────
 fts_phrase
-    : DQUOTA_STRING
+    : DQUOTA_STRING (TILDE NUMBER)?
     ;
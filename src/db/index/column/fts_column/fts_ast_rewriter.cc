@@ -23,8 +23,8 @@ namespace {
 
 // Two AST nodes are dedup-equivalent when they are the same leaf kind and
 // carry identical modifiers and identical scoring key (term string for
-// TermNode, terms vector for PhraseNode). Boost is intentionally NOT part of
-// the key — it is what we accumulate during dedup.
+// TermNode, terms vector and slop for PhraseNode). Boost is intentionally NOT
+// part of the key — it is what we accumulate during dedup.
 bool same_dedup_key(const FtsAstNode &a, const FtsAstNode &b) {
   if (a.type() != b.type()) {
     return false;
@@ -37,8 +37,9 @@ bool same_dedup_key(const FtsAstNode &a, const FtsAstNode &b) {
            static_cast<const TermNode &>(b).term;
   }
   if (a.type() == FtsNodeType::PHRASE) {
-    return static_cast<const PhraseNode &>(a).terms ==
-           static_cast<const PhraseNode &>(b).terms;
+    const auto &pa = static_cast<const PhraseNode &>(a);
+    const auto &pb = static_cast<const PhraseNode &>(b);
+    return pa.terms == pb.terms && pa.slop == pb.slop;
   }
   return false;
 }
@@ -54,8 +55,9 @@ bool same_term_or_phrase_text(const FtsAstNode &a, const FtsAstNode &b) {
            static_cast<const TermNode &>(b).term;
   }
   if (a.type() == FtsNodeType::PHRASE) {
-    return static_cast<const PhraseNode &>(a).terms ==
-           static_cast<const PhraseNode &>(b).terms;
+    const auto &pa = static_cast<const PhraseNode &>(a);
+    const auto &pb = static_cast<const PhraseNode &>(b);
+    return pa.terms == pb.terms && pa.slop == pb.slop;
   }
   return false;
 }
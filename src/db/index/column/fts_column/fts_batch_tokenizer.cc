@@ -0,0 +1,89 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fts_batch_tokenizer.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "tokenizer/tokenizer_factory.h"
+#include "fts_pipeline.h"
+
+namespace zvec::fts {
+
+Status tokenize_fts_batch(const FieldSchemaPtrList &fts_fields,
+                          const std::vector<Doc> &docs,
+                          ailego::ThreadPool *pool,
+                          std::vector<FtsTokenizedFields> *out) {
+  out->clear();
+  if (fts_fields.empty() || docs.empty()) {
+    return Status::OK();
+  }
+
+  // Resolve every pipeline up front so workers only run process().
+  std::vector<TokenizerPipelinePtr> pipelines;
+  pipelines.reserve(fts_fields.size());
+  for (const auto &field : fts_fields) {
+    auto fts_params =
+        std::dynamic_pointer_cast<zvec::FtsIndexParams>(field->index_params());
+    if (!fts_params) {
+      return Status::InvalidArgument(
+          "tokenize_fts_batch: field has no FtsIndexParams: ", field->name());
+    }
+    auto pipeline = detail::AcquireFtsPipeline(*fts_params);
+    if (!pipeline.has_value()) {
+      return Status::InternalError(
+          "tokenize_fts_batch: failed to create tokenizer pipeline. field=",
+          field->name(), " err=", pipeline.error().message());
+    }
+    pipelines.push_back(std::move(pipeline.value()));
+  }
+
+  out->resize(docs.size());
+  auto tokenize_doc = [&](size_t i) {
+    auto &tokenized = (*out)[i];
+    for (size_t f = 0; f < fts_fields.size(); ++f) {
+      const std::string &name = fts_fields[f]->name();
+      auto value = docs[i].get<std::string>(name);
+      if (value.has_value()) {
+        tokenized.emplace(
+            name, TokenizedText::tokenize(*pipelines[f], value.value()));
+      }
+    }
+  };
+
+  if (pool == nullptr || docs.size() == 1 || pool->worker_count() <= 1) {
+    for (size_t i = 0; i < docs.size(); ++i) {
+      tokenize_doc(i);
+    }
+    return Status::OK();
+  }
+
+  std::atomic<size_t> next_doc{0};
+  auto worker = [&]() {
+    for (size_t i = next_doc.fetch_add(1, std::memory_order_relaxed);
+         i < docs.size(); i = next_doc.fetch_add(1, std::memory_order_relaxed)) {
+      tokenize_doc(i);
+    }
+  };
+  const size_t task_count = std::min(pool->worker_count(), docs.size());
+  auto group = pool->make_group();
+  for (size_t t = 0; t < task_count; ++t) {
+    group->execute(worker);
+  }
+  group->wait_finish();
+  return Status::OK();
+}
+
+}  // namespace zvec::fts
@@ -0,0 +1,50 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include <zvec/ailego/parallel/thread_pool.h>
+#include <zvec/db/doc.h>
+#include <zvec/db/schema.h>
+#include <zvec/db/status.h>
+#include "fts_tokenized_text.h"
+
+namespace zvec::fts {
+
+/*! Tokenize the FTS fields of a write batch ahead of the ordered write
+ *  section.
+ *
+ *  Tokenization is the dominant CPU cost of ingesting text-heavy documents
+ *  and needs no segment state, so the collection runs it before taking its
+ *  write lock; the segment then feeds the results to
+ *  FtsColumnIndexer::insert(seg_doc_id, const TokenizedText &).  Documents
+ *  are handed out to the pool workers one at a time, which balances batches
+ *  of uneven document sizes.
+ *
+ *  \param fts_fields  FTS fields of the collection schema
+ *  \param docs        Write batch
+ *  \param pool        Pool to tokenize on; nullptr (or a single-document
+ *                     batch) tokenizes on the calling thread
+ *  \param out         Receives one entry per document, in batch order; a
+ *                     field is absent from an entry when the document has
+ *                     no value for it
+ *  \return OK, or the error of a pipeline that could not be created
+ */
+Status tokenize_fts_batch(const FieldSchemaPtrList &fts_fields,
+                          const std::vector<Doc> &docs,
+                          ailego::ThreadPool *pool,
+                          std::vector<FtsTokenizedFields> *out);
+
+}  // namespace zvec::fts
@@ -13,13 +13,15 @@
 // limitations under the License.
 
 #include "fts_column_indexer.h"
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <queue>
+#include <string_view>
 #include <thread>
-#include <unordered_map>
+#include <unordered_set>
 #include <roaring/roaring.h>
-#include <rocksdb/write_batch.h>
+#include <zvec/ailego/encoding/json/mod_json_plus.h>
 #include <zvec/ailego/logger/logger.h>
 #include <zvec/db/status.h>
 #include "db/common/typedef.h"
@@ -29,6 +31,7 @@
 #include "iterator/fts_phrase_iterator.h"
 #include "iterator/fts_term_iterator.h"
 #include "posting/bitpacked_posting_list.h"
+#include "fts_impact_search.h"
 #include "fts_pipeline.h"
 #include "fts_utils.h"
 
@@ -132,9 +135,124 @@ Result<void> FtsColumnIndexer::open(FieldSchema::Ptr field_meta,
   field_meta_ = std::move(field_meta);
   tokenizer_pipeline_ = std::move(pipeline_result.value());
   fts_params_ = fts_param;
+  auto options_ret = load_index_options();
+  if (!options_ret.has_value()) {
+    return options_ret;
+  }
+
+  auto ret = open_reader(field_meta_->name(), ctx, postings_cf, positions_cf,
+                         term_freq_cf, max_tf_cf, doc_len_cf, stat_cf);
+  if (!ret.has_value()) {
+    return ret;
+  }
+  load_complete_shingles();
+  if (doc_len_cf == nullptr) {
+    return ret;
+  }
+
+  // Writing segment: inserts and searches go through the in-memory buffer.
+  ret = load_memory_postings();
+  if (!ret.has_value()) {
+    (void)close();
+  }
+  return ret;
+}
+
+void FtsColumnIndexer::load_complete_shingles() {
+  complete_shingles_.clear();
+  if (phrase_shingles_.empty()) {
+    return;
+  }
+  std::string value;
+  if (stat_cf_ &&
+      ctx_->db_
+          ->Get(ctx_->read_opts_, stat_cf_,
+                make_phrase_shingles_key(field_name_), &value)
+          .ok()) {
+    std::unordered_set<std::string> persisted;
+    decode_shingle_set(value, &persisted);
+    for (const auto &shingle : phrase_shingles_) {
+      if (persisted.count(shingle) != 0) {
+        complete_shingles_.insert(shingle);
+      }
+    }
+  } else if (total_docs() == 0) {
+    // Nothing indexed yet: every configured shingle covers all docs to come.
+    complete_shingles_ = phrase_shingles_;
+  }
+  if (complete_shingles_.size() < phrase_shingles_.size()) {
+    LOG_INFO(
+        "FtsColumnIndexer: %zu of %zu phrase shingles predate this segment's "
+        "docs, phrases over them verify positions. field[%s]",
+        phrase_shingles_.size() - complete_shingles_.size(),
+        phrase_shingles_.size(), field_name_.c_str());
+  }
+}
+
+Result<void> FtsColumnIndexer::load_memory_postings() {
+  auto memory_postings = std::make_shared<FtsMemoryPostings>();
+
+  // Both CFs are empty for a brand-new segment; for a reopened writing
+  // segment they hold everything flushed so far (also when written by the
+  // per-insert Roaring path).
+  {
+    std::unique_ptr<rocksdb::Iterator> iter(
+        ctx_->db_->NewIterator(ctx_->read_opts_, doc_len_cf_.load()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      const rocksdb::Slice key = iter->key();
+      const rocksdb::Slice value = iter->value();
+      if (key.size() != sizeof(uint32_t) || value.size() != sizeof(uint32_t)) {
+        LOG_WARN(
+            "FtsColumnIndexer::load_memory_postings: malformed doc_len entry. "
+            "field[%s] key_size[%zu] value_size[%zu]",
+            field_name_.c_str(), key.size(), value.size());
+        continue;
+      }
+      uint32_t local_doc_id = 0;
+      uint32_t doc_len = 0;
+      std::memcpy(&local_doc_id, key.data(), sizeof(uint32_t));
+      std::memcpy(&doc_len, value.data(), sizeof(uint32_t));
+      memory_postings->restore_doc_len(local_doc_id, doc_len);
+      if (doc_len > 0 &&
+          doc_len < min_doc_len_.load(std::memory_order_relaxed)) {
+        min_doc_len_.store(doc_len, std::memory_order_relaxed);
+      }
+    }
+    if (!iter->status().ok()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FtsColumnIndexer::load_memory_postings: scan doc_len failed. "
+          "field=",
+          field_name_, " status=", iter->status().ToString()));
+    }
+  }
+
+  {
+    std::unique_ptr<rocksdb::Iterator> iter(
+        ctx_->db_->NewIterator(ctx_->read_opts_, positions_cf_));
+    std::string term;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      uint32_t local_doc_id = 0;
+      const rocksdb::Slice value = iter->value();
+      if (!parse_doc_term_key(iter->key().ToString(), &term, &local_doc_id) ||
+          !memory_postings->restore_positions(term, local_doc_id,
+                                              value.data(), value.size())) {
+        LOG_WARN(
+            "FtsColumnIndexer::load_memory_postings: malformed positions "
+            "entry. field[%s] key_size[%zu] value_size[%zu]",
+            field_name_.c_str(), iter->key().size(), value.size());
+      }
+    }
+    if (!iter->status().ok()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FtsColumnIndexer::load_memory_postings: scan positions failed. "
+          "field=",
+          field_name_, " status=", iter->status().ToString()));
+    }
+  }
 
-  return open_reader(field_meta_->name(), ctx, postings_cf, positions_cf,
-                     term_freq_cf, max_tf_cf, doc_len_cf, stat_cf);
+  std::atomic_store_explicit(&memory_postings_, std::move(memory_postings),
+                             std::memory_order_release);
+  return {};
 }
 
 // ============================================================
@@ -153,6 +271,10 @@ Result<void> FtsColumnIndexer::close() {
 
   ctx_ = nullptr;
   tokenizer_pipeline_.reset();
+  std::atomic_store_explicit(&memory_postings_, FtsMemoryPostings::Ptr{},
+                             std::memory_order_release);
+  std::atomic_store_explicit(&sealed_postings_, FtsSealedPostings::Ptr{},
+                             std::memory_order_release);
   postings_cf_ = nullptr;
   positions_cf_ = nullptr;
   term_freq_cf_.store(nullptr, std::memory_order_release);
@@ -191,7 +313,28 @@ Result<std::vector<FtsResult>> FtsColumnIndexer::search(
         field_name_));
   }
 
-  auto iter_result = build_iterator(ast);
+  QueryScoring scoring;
+  if (query_params.collection_stats) {
+    scoring.collection_stats = query_params.collection_stats.get();
+    scoring.collection_scorer = std::make_shared<BM25Scorer>(scorer_->params());
+    scoring.collection_scorer->update_stats(
+        scoring.collection_stats->total_docs,
+        scoring.collection_stats->total_tokens);
+  }
+
+  // Anytime mode: the candidates come from the impact-ordered postings and
+  // the iterator tree below only rescores them.
+  std::optional<std::vector<uint64_t>> impact_ids;
+  if (query_params.anytime && !query_params.candidate_ids) {
+    impact_ids = impact_candidates(ast, query_params, scoring);
+  }
+  const std::optional<std::vector<uint64_t>> &candidate_ids =
+      impact_ids ? impact_ids : query_params.candidate_ids;
+  if (candidate_ids && candidate_ids->empty()) {
+    return std::vector<FtsResult>{};
+  }
+
+  auto iter_result = build_iterator(ast, scoring);
   if (!iter_result.has_value()) {
     LOG_ERROR("FtsColumnIndexer::search: build_iterator failed. field[%s] %s",
               field_name_.c_str(), iter_result.error().message().c_str());
@@ -206,14 +349,10 @@ Result<std::vector<FtsResult>> FtsColumnIndexer::search(
   // Candidate-driven mode: AND a CandidateDocIterator into the root so the
   // small candidate set leads (Conjunction sorts by cost asc), turning the
   // posting walk into per-candidate advance()+matches()+score().
-  if (query_params.candidate_ids) {
-    if (query_params.candidate_ids->empty()) {
-      return std::vector<FtsResult>{};
-    }
+  if (candidate_ids) {
     std::vector<DocIteratorPtr> musts;
     musts.reserve(2);
-    musts.push_back(
-        std::make_unique<CandidateDocIterator>(*query_params.candidate_ids));
+    musts.push_back(std::make_unique<CandidateDocIterator>(*candidate_ids));
     musts.push_back(std::move(root_iter));
     root_iter = std::make_unique<ConjunctionIterator>(
         std::move(musts), std::vector<DocIteratorPtr>{});
@@ -226,6 +365,32 @@ Result<std::vector<FtsResult>> FtsColumnIndexer::search(
                                       std::greater<FtsResult>>;
   MinHeap min_heap;
 
+  // Shared top-k threshold: a doc must beat both the local heap and the
+  // best k-th score any other segment of the query has published.  Other
+  // segments advance it concurrently, so it is re-read every
+  // kThresholdRefreshInterval docs.
+  FtsTopkThreshold *shared_threshold =
+      scoring.collection_stats ? query_params.topk_threshold.get() : nullptr;
+  constexpr uint32_t kThresholdRefreshInterval = 256;
+  uint32_t docs_until_refresh = 0;
+  float shared_score = 0.0f;
+  auto refresh_threshold = [&]() {
+    const float local_score =
+        min_heap.size() == topk ? min_heap.top().score : 0.0f;
+    if (shared_threshold) {
+      shared_threshold->raise(local_score);
+      shared_score = shared_threshold->load();
+    }
+    const float competitive = std::max(local_score, shared_score);
+    if (competitive > 0.0f) {
+      root_iter->set_min_competitive_score(competitive);
+    }
+    docs_until_refresh = kThresholdRefreshInterval;
+  };
+  if (shared_threshold) {
+    refresh_threshold();
+  }
+
   // Filter pushdown: when a filter is present, use the filter-aware next_doc
   // overload so composite iterators skip filtered docs before paying for
   // block-max binary search, do_next alignment, or phase-2 position checks.
@@ -234,18 +399,22 @@ Result<std::vector<FtsResult>> FtsColumnIndexer::search(
   while (doc_id != DocIterator::NO_MORE_DOCS) {
     const uint64_t global_doc_id = static_cast<uint64_t>(doc_id);
 
+    if (shared_threshold && --docs_until_refresh == 0) {
+      refresh_threshold();
+    }
+
     if (root_iter->matches()) {
       float s = root_iter->score();
-      if (s > 0.0f) {
+      if (s > shared_score) {
         if (min_heap.size() < topk) {
           min_heap.push({global_doc_id, s});
           if (min_heap.size() == topk) {
-            root_iter->set_min_competitive_score(min_heap.top().score);
+            refresh_threshold();
           }
         } else if (s > min_heap.top().score) {
           min_heap.pop();
           min_heap.push({global_doc_id, s});
-          root_iter->set_min_competitive_score(min_heap.top().score);
+          refresh_threshold();
         }
       }
     }
@@ -262,6 +431,140 @@ Result<std::vector<FtsResult>> FtsColumnIndexer::search(
   return results;
 }
 
+// ============================================================
+// Collection-wide statistics
+// ============================================================
+
+void FtsColumnIndexer::collect_stats(const FtsAstNode &ast,
+                                     FtsCollectionStats *stats) const {
+  if (!scorer_) {
+    return;
+  }
+  const auto segment_stats = scorer_->stats();
+  stats->total_docs += segment_stats.total_docs;
+  stats->total_tokens += segment_stats.total_tokens;
+
+  std::unordered_set<std::string_view> seen;
+  auto add_term = [&](const std::string &term) {
+    if (seen.insert(term).second) {
+      stats->doc_freqs[term] += doc_freq(term);
+    }
+  };
+  std::vector<const FtsAstNode *> pending{&ast};
+  while (!pending.empty()) {
+    const FtsAstNode *node = pending.back();
+    pending.pop_back();
+    switch (node->type()) {
+      case FtsNodeType::TERM:
+        add_term(static_cast<const TermNode *>(node)->term);
+        break;
+      case FtsNodeType::PHRASE:
+        for (const auto &term : static_cast<const PhraseNode *>(node)->terms) {
+          add_term(term);
+        }
+        break;
+      case FtsNodeType::AND:
+        for (const auto &child : static_cast<const AndNode *>(node)->children) {
+          pending.push_back(child.get());
+        }
+        break;
+      case FtsNodeType::OR:
+        for (const auto &child : static_cast<const OrNode *>(node)->children) {
+          pending.push_back(child.get());
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+std::optional<std::vector<uint64_t>> FtsColumnIndexer::impact_candidates(
+    const FtsAstNode &ast, const FtsQueryParams &query_params,
+    const QueryScoring &scoring) const {
+  auto sealed = sealed_postings();
+  if (!sealed || !sealed->has_impacts() || memory_postings()) {
+    return std::nullopt;
+  }
+
+  // Only a disjunction of plain terms scores as a plain sum of impacts.
+  std::vector<const TermNode *> term_nodes;
+  if (ast.type() == FtsNodeType::TERM) {
+    term_nodes.push_back(static_cast<const TermNode *>(&ast));
+  } else if (ast.type() == FtsNodeType::OR) {
+    for (const auto &child : static_cast<const OrNode &>(ast).children) {
+      if (child->type() != FtsNodeType::TERM || child->must ||
+          child->must_not) {
+        return std::nullopt;
+      }
+      term_nodes.push_back(static_cast<const TermNode *>(child.get()));
+    }
+  }
+  if (term_nodes.empty() || term_nodes.size() > kMaxImpactSearchTerms) {
+    return std::nullopt;
+  }
+
+  const BM25Scorer &scorer =
+      scoring.collection_scorer ? *scoring.collection_scorer : *scorer_;
+  const float impact_weight =
+      (scorer.params().k1 + 1.0f) / FtsSealedPostings::kMaxImpact;
+  std::vector<ImpactSearchTerm> terms(term_nodes.size());
+  for (size_t i = 0; i < term_nodes.size(); ++i) {
+    const TermNode &node = *term_nodes[i];
+    ImpactSearchTerm &term = terms[i];
+    term.impacts = sealed->get_impacts(node.term);
+    uint64_t df = 0;
+    if (scoring.collection_stats) {
+      df = scoring.collection_stats->doc_freq(node.term);
+    } else {
+      for (uint32_t s = 0; s < term.impacts.num_segments(); ++s) {
+        df += term.impacts.segment(s).num_docs;
+      }
+    }
+    term.unit_score = scorer.idf(df) * node.boost * impact_weight;
+  }
+
+  ImpactSearchLimits limits;
+  limits.topk = query_params.topk;
+  limits.budget = query_params.anytime_budget;
+  limits.max_postings = query_params.anytime_max_postings;
+  return impact_ordered_topk(terms, limits, query_params.filter.get());
+}
+
+uint64_t FtsColumnIndexer::doc_freq(const std::string &term) const {
+  if (auto memory_postings = this->memory_postings()) {
+    return memory_postings->doc_freq(term);
+  }
+
+  rocksdb::PinnableSlice raw_data;
+  if (auto sealed = sealed_postings()) {
+    if (!sealed->get_postings(term, &raw_data)) {
+      return 0;
+    }
+  } else if (!ctx_->db_->Get(ctx_->read_opts_, postings_cf_, term, &raw_data)
+                  .ok()) {
+    return 0;
+  }
+
+  if (BitPackedPostingList::is_bitpacked_format(raw_data.data(),
+                                                raw_data.size())) {
+    if (raw_data.size() < BitPackedPostingList::HEADER_SIZE) {
+      return 0;
+    }
+    BitPackedPostingList::Header header;
+    std::memcpy(&header, raw_data.data(), sizeof(header));
+    return header.num_docs;
+  }
+  roaring_bitmap_t *bitmap = roaring_bitmap_portable_deserialize_safe(
+      raw_data.data(), raw_data.size());
+  if (!bitmap) {
+    return 0;
+  }
+  const uint64_t df = roaring_bitmap_get_cardinality(bitmap);
+  roaring_bitmap_free(bitmap);
+  return df;
+}
+
 // ============================================================
 // Side CF reset (dump path)
 // ============================================================
@@ -281,16 +584,17 @@ void FtsColumnIndexer::reset_side_cfs() {
 // ============================================================
 
 Result<DocIteratorPtr> FtsColumnIndexer::build_iterator(
-    const FtsAstNode &node) const {
+    const FtsAstNode &node, const QueryScoring &scoring) const {
   switch (node.type()) {
     case FtsNodeType::TERM:
-      return build_term_iterator(static_cast<const TermNode &>(node));
+      return build_term_iterator(static_cast<const TermNode &>(node), scoring);
     case FtsNodeType::PHRASE:
-      return build_phrase_iterator(static_cast<const PhraseNode &>(node));
+      return build_phrase_iterator(static_cast<const PhraseNode &>(node),
+                                   scoring);
     case FtsNodeType::AND:
-      return build_and_iterator(static_cast<const AndNode &>(node));
+      return build_and_iterator(static_cast<const AndNode &>(node), scoring);
     case FtsNodeType::OR:
-      return build_or_iterator(static_cast<const OrNode &>(node));
+      return build_or_iterator(static_cast<const OrNode &>(node), scoring);
     case FtsNodeType::EMPTY:
       // Null iterator reuses the existing AND/OR/search() null-handling path.
       return DocIteratorPtr{nullptr};
@@ -303,14 +607,25 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_iterator(
 
 Result<DocIteratorPtr> FtsColumnIndexer::create_term_iterator_from_raw(
     const std::string &term, rocksdb::PinnableSlice raw_data,
-    float boost) const {
+    const QueryScoring &scoring, float boost,
+    BM25ScorerPtr encoded_scorer) const {
   if (BitPackedPostingList::is_bitpacked_format(raw_data.data(),
                                                 raw_data.size())) {
-    auto iter = std::make_unique<TermDocIterator>(term, std::move(raw_data),
-                                                  scorer_, boost);
+    auto iter = std::make_unique<TermDocIterator>(
+        term, std::move(raw_data), encoded_scorer ? encoded_scorer : scorer_,
+        boost);
     if (iter->cost() == 0) {
       return DocIteratorPtr{nullptr};
     }
+    if (encoded_scorer) {
+      // Move the bounds from the stats of the cached encoding to the
+      // segment's current ones; the df of the posting is exact.
+      iter->use_collection_stats(scorer_, iter->cost());
+    }
+    if (scoring.collection_stats) {
+      iter->use_collection_stats(scoring.collection_scorer,
+                                 scoring.collection_stats->doc_freq(term));
+    }
     return iter;
   }
 
@@ -358,32 +673,68 @@ Result<DocIteratorPtr> FtsColumnIndexer::create_term_iterator_from_raw(
     }
   }
 
-  return std::make_unique<TermDocIterator>(term, bitmap, df, scorer_,
-                                           max_score_val, ctx_, term_freq_cf,
-                                           doc_len_cf, cf_counter, boost);
+  auto iter = std::make_unique<TermDocIterator>(
+      term, bitmap, df, scorer_, max_score_val, ctx_, term_freq_cf,
+      doc_len_cf, cf_counter, boost);
+  if (scoring.collection_stats) {
+    iter->use_collection_stats(scoring.collection_scorer,
+                               scoring.collection_stats->doc_freq(term));
+  }
+  return iter;
 }
 
 Result<DocIteratorPtr> FtsColumnIndexer::build_term_iterator(
-    const TermNode &term_node) const {
+    const TermNode &term_node, const QueryScoring &scoring) const {
   const std::string &term = term_node.term;
 
   rocksdb::PinnableSlice raw_data;
-  auto s = ctx_->db_->Get(ctx_->read_opts_, postings_cf_, term, &raw_data);
-  if (!s.ok() || raw_data.empty()) {
-    return DocIteratorPtr{nullptr};
+  BM25ScorerPtr encoded_scorer;
+  if (auto memory_postings = this->memory_postings()) {
+    if (!get_memory_posting(*memory_postings, term, &raw_data,
+                            &encoded_scorer)) {
+      return DocIteratorPtr{nullptr};
+    }
+  } else if (auto sealed = sealed_postings()) {
+    if (!sealed->get_postings(term, &raw_data)) {
+      return DocIteratorPtr{nullptr};
+    }
+  } else {
+    auto s = ctx_->db_->Get(ctx_->read_opts_, postings_cf_, term, &raw_data);
+    if (!s.ok() || raw_data.empty()) {
+      return DocIteratorPtr{nullptr};
+    }
   }
 
-  return create_term_iterator_from_raw(term, std::move(raw_data),
-                                       term_node.boost);
+  return create_term_iterator_from_raw(term, std::move(raw_data), scoring,
+                                       term_node.boost,
+                                       std::move(encoded_scorer));
 }
 
 std::vector<rocksdb::PinnableSlice> FtsColumnIndexer::batch_get_postings(
-    const std::vector<rocksdb::Slice> &terms) const {
+    const std::vector<rocksdb::Slice> &terms,
+    std::vector<BM25ScorerPtr> *encoded_scorers) const {
   std::vector<rocksdb::PinnableSlice> raw_postings(terms.size());
+  encoded_scorers->assign(terms.size(), nullptr);
   if (terms.empty()) {
     return raw_postings;
   }
 
+  if (auto memory_postings = this->memory_postings()) {
+    for (size_t i = 0; i < terms.size(); ++i) {
+      (void)get_memory_posting(*memory_postings, terms[i].ToString(),
+                               &raw_postings[i], &(*encoded_scorers)[i]);
+    }
+    return raw_postings;
+  }
+
+  if (auto sealed = sealed_postings()) {
+    for (size_t i = 0; i < terms.size(); ++i) {
+      (void)sealed->get_postings(
+          std::string_view(terms[i].data(), terms[i].size()), &raw_postings[i]);
+    }
+    return raw_postings;
+  }
+
   std::vector<rocksdb::ColumnFamilyHandle *> cfs(terms.size(), postings_cf_);
   std::vector<rocksdb::Status> statuses(terms.size());
   ctx_->db_->MultiGet(ctx_->read_opts_, terms.size(), cfs.data(), terms.data(),
@@ -392,33 +743,86 @@ std::vector<rocksdb::PinnableSlice> FtsColumnIndexer::batch_get_postings(
   return raw_postings;
 }
 
+bool FtsColumnIndexer::get_memory_posting(
+    const FtsMemoryPostings &memory_postings, const std::string &term,
+    rocksdb::PinnableSlice *raw_data, BM25ScorerPtr *encoded_scorer) const {
+  // Re-encoded only after the term gained a document, so a query costs
+  // O(df) per changed term instead of per term.
+  auto encoded = memory_postings.encoded_postings(term, *scorer_);
+  if (!encoded) {
+    return false;
+  }
+  const SegmentStatsSnapshot encoded_stats = encoded->scorer->stats();
+  const SegmentStatsSnapshot stats = scorer_->stats();
+  *encoded_scorer = encoded_stats.total_docs == stats.total_docs &&
+                            encoded_stats.total_tokens == stats.total_tokens
+                        ? nullptr
+                        : encoded->scorer;
+  const rocksdb::Slice data(encoded->data);
+  raw_data->PinSlice(
+      data,
+      [](void *arg1, void * /*arg2*/) {
+        delete static_cast<FtsMemoryPostings::EncodedPtr *>(arg1);
+      },
+      new FtsMemoryPostings::EncodedPtr(std::move(encoded)), nullptr);
+  return true;
+}
+
 Result<DocIteratorPtr> FtsColumnIndexer::build_phrase_iterator(
-    const PhraseNode &phrase_node) const {
+    const PhraseNode &phrase_node, const QueryScoring &scoring) const {
   if (phrase_node.terms.empty()) {
     return DocIteratorPtr{nullptr};
   }
 
   const std::vector<std::string> &terms = phrase_node.terms;
+
+  // Shingles of the adjacent term pairs that were indexed as one term for
+  // every doc of this segment.  A doc lacking one cannot hold the exact
+  // phrase, so their postings join the intersection as zero-weight filters.
+  std::vector<std::string> shingles;
+  if (phrase_node.slop == 0 && !complete_shingles_.empty()) {
+    std::string shingle;
+    for (size_t i = 0; i + 1 < terms.size(); ++i) {
+      make_shingle_term(terms[i], terms[i + 1], &shingle);
+      if (complete_shingles_.count(shingle) != 0) {
+        shingles.push_back(shingle);
+      }
+    }
+  }
+
   std::vector<rocksdb::Slice> term_slices;
-  term_slices.reserve(terms.size());
+  term_slices.reserve(terms.size() + shingles.size());
   for (const auto &t : terms) {
     term_slices.emplace_back(t);
   }
-  auto raw_postings = batch_get_postings(term_slices);
+  for (const auto &t : shingles) {
+    term_slices.emplace_back(t);
+  }
+  std::vector<BM25ScorerPtr> encoded_scorers;
+  auto raw_postings = batch_get_postings(term_slices, &encoded_scorers);
 
   std::vector<DocIteratorPtr> term_iterators;
-  term_iterators.reserve(terms.size());
+  term_iterators.reserve(term_slices.size());
 
   // Phrase-level boost is distributed across the internal term iterators.
   // PhraseDocIterator.score() delegates to conjunction.score() which sums the
   // internal contributions, so multiplying each contribution by boost yields
   // boost * (sum) = boost-applied-once at the phrase level.
-  for (size_t i = 0; i < terms.size(); ++i) {
+  size_t shingle_filters = 0;
+  for (size_t i = 0; i < term_slices.size(); ++i) {
+    const bool is_shingle = i >= terms.size();
     if (raw_postings[i].empty()) {
+      // Without its posting a shingle filters nothing; positions decide.
+      if (is_shingle) {
+        continue;
+      }
       return DocIteratorPtr{nullptr};
     }
     auto iter_result = create_term_iterator_from_raw(
-        terms[i], std::move(raw_postings[i]), phrase_node.boost);
+        is_shingle ? shingles[i - terms.size()] : terms[i],
+        std::move(raw_postings[i]), scoring,
+        is_shingle ? 0.0f : phrase_node.boost,
+        std::move(encoded_scorers[i]));
     if (!iter_result.has_value()) {
       return iter_result;
     }
@@ -426,6 +830,7 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_phrase_iterator(
       return DocIteratorPtr{nullptr};
     }
     term_iterators.push_back(std::move(iter_result.value()));
+    shingle_filters += is_shingle ? 1 : 0;
   }
 
   if (term_iterators.empty()) {
@@ -435,12 +840,26 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_phrase_iterator(
   auto conjunction = std::make_unique<ConjunctionIterator>(
       std::move(term_iterators), std::vector<DocIteratorPtr>{});
 
+  // A two-term phrase is exactly its shingle: no positions to check.
+  if (terms.size() == 2 && shingle_filters == 1) {
+    return DocIteratorPtr{std::move(conjunction)};
+  }
+
+  const uint32_t slop = phrase_node.slop;
+  if (auto memory_postings = this->memory_postings()) {
+    return std::make_unique<PhraseDocIterator>(
+        std::move(conjunction), terms, std::move(memory_postings), slop);
+  }
+  if (auto sealed = sealed_postings()) {
+    return std::make_unique<PhraseDocIterator>(std::move(conjunction), terms,
+                                               std::move(sealed), slop);
+  }
   return std::make_unique<PhraseDocIterator>(std::move(conjunction), terms,
-                                             ctx_, positions_cf_);
+                                             ctx_, positions_cf_, slop);
 }
 
 Result<DocIteratorPtr> FtsColumnIndexer::build_and_iterator(
-    const AndNode &and_node) const {
+    const AndNode &and_node, const QueryScoring &scoring) const {
   if (and_node.children.empty()) {
     return DocIteratorPtr{nullptr};
   }
@@ -458,7 +877,9 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_and_iterator(
     }
   }
 
-  auto term_raw_postings = batch_get_postings(term_key_slices);
+  std::vector<BM25ScorerPtr> encoded_scorers;
+  auto term_raw_postings =
+      batch_get_postings(term_key_slices, &encoded_scorers);
 
   std::vector<DocIteratorPtr> must_iterators;
   std::vector<DocIteratorPtr> must_not_iterators;
@@ -477,7 +898,8 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_and_iterator(
       const auto &term_node = static_cast<const TermNode &>(*child);
       if (!raw.empty()) {
         auto iter_result = create_term_iterator_from_raw(
-            term_node.term, std::move(raw), term_node.boost);
+            term_node.term, std::move(raw), scoring, term_node.boost,
+            std::move(encoded_scorers[batched_cursor]));
         if (!iter_result.has_value()) {
           return iter_result;
         }
@@ -485,7 +907,7 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_and_iterator(
       }
       ++batched_cursor;
     } else {
-      auto iter_result = build_iterator(*child);
+      auto iter_result = build_iterator(*child, scoring);
       if (!iter_result.has_value()) {
         return iter_result;
       }
@@ -523,7 +945,7 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_and_iterator(
 }
 
 Result<DocIteratorPtr> FtsColumnIndexer::build_or_iterator(
-    const OrNode &or_node) const {
+    const OrNode &or_node, const QueryScoring &scoring) const {
   if (or_node.children.empty()) {
     return DocIteratorPtr{nullptr};
   }
@@ -541,7 +963,9 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_or_iterator(
     }
   }
 
-  auto term_raw_postings = batch_get_postings(term_key_slices);
+  std::vector<BM25ScorerPtr> encoded_scorers;
+  auto term_raw_postings =
+      batch_get_postings(term_key_slices, &encoded_scorers);
 
   // Invariant: the AST rewriter (fts::simplify) lifts both must_not and must
   // children out of OrNode into a wrapping AndNode before we get here, so the
@@ -569,7 +993,8 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_or_iterator(
       const auto &term_node = static_cast<const TermNode &>(*child);
       if (!raw.empty()) {
         auto iter_result = create_term_iterator_from_raw(
-            term_node.term, std::move(raw), term_node.boost);
+            term_node.term, std::move(raw), scoring, term_node.boost,
+            std::move(encoded_scorers[batched_cursor]));
         if (!iter_result.has_value()) {
           return iter_result;
         }
@@ -577,7 +1002,7 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_or_iterator(
       }
       ++batched_cursor;
     } else {
-      auto iter_result = build_iterator(*child);
+      auto iter_result = build_iterator(*child, scoring);
       if (!iter_result.has_value()) {
         return iter_result;
       }
@@ -602,6 +1027,95 @@ Result<DocIteratorPtr> FtsColumnIndexer::build_or_iterator(
 // Write operations
 // ============================================================
 
+Result<void> FtsColumnIndexer::load_index_options() {
+  phrase_shingles_.clear();
+  impact_ordered_ = false;
+  if (fts_params_->extra_params().empty()) {
+    return {};
+  }
+  // TokenizerFactory has already validated the JSON object.
+  ailego::JsonValue parsed;
+  if (!parsed.parse(fts_params_->extra_params().c_str()) ||
+      !parsed.is_object()) {
+    return {};
+  }
+  const ailego::JsonObject &extra_json = parsed.as_object();
+
+  auto impact_value = extra_json["impact_ordered"];
+  if (!impact_value.is_null()) {
+    if (!impact_value.is_boolean()) {
+      return tl::make_unexpected(Status::InvalidArgument(
+          "FtsColumnIndexer: impact_ordered must be a boolean. field=",
+          field_meta_->name()));
+    }
+    impact_ordered_ = impact_value.as_bool();
+  }
+
+  auto shingles_value = extra_json["phrase_shingles"];
+  if (shingles_value.is_null()) {
+    return {};
+  }
+  if (!shingles_value.is_array()) {
+    return tl::make_unexpected(Status::InvalidArgument(
+        "FtsColumnIndexer: phrase_shingles must be an array. field=",
+        field_meta_->name()));
+  }
+
+  // Each entry is analyzed like a query phrase; only entries that analyze
+  // to exactly two adjacent terms can be shingled.
+  std::string shingle;
+  for (const auto &entry : shingles_value.as_array()) {
+    if (!entry.is_string()) {
+      return tl::make_unexpected(Status::InvalidArgument(
+          "FtsColumnIndexer: phrase_shingles entries must be strings. field=",
+          field_meta_->name()));
+    }
+    const std::string text = entry.as_stl_string();
+    auto tokens = tokenizer_pipeline_->process(text);
+    if (tokens.size() != 2 || tokens[1].position != tokens[0].position + 1) {
+      LOG_WARN(
+          "FtsColumnIndexer: phrase shingle [%s] is not two adjacent terms, "
+          "ignored. field[%s]",
+          text.c_str(), field_meta_->name().c_str());
+      continue;
+    }
+    make_shingle_term(tokens[0].text, tokens[1].text, &shingle);
+    phrase_shingles_.insert(shingle);
+  }
+  return {};
+}
+
+bool FtsColumnIndexer::add_phrase_shingles(const TokenizedText &tokens,
+                                           TokenizedText *out) const {
+  if (phrase_shingles_.empty()) {
+    return false;
+  }
+  std::string shingle;
+  bool found = false;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    bool has_shingle = false;
+    if (i + 1 < tokens.size() &&
+        tokens.position(i + 1) == tokens.position(i) + 1) {
+      make_shingle_term(tokens.term(i), tokens.term(i + 1), &shingle);
+      has_shingle = phrase_shingles_.count(shingle) != 0;
+    }
+    if (has_shingle && !found) {
+      found = true;
+      for (size_t j = 0; j < i; ++j) {
+        out->append(tokens.term(j), tokens.position(j));
+      }
+    }
+    if (found) {
+      out->append(tokens.term(i), tokens.position(i));
+      if (has_shingle) {
+        // Stacked on the pair's first token, like a synonym.
+        out->append(shingle, tokens.position(i));
+      }
+    }
+  }
+  return found;
+}
+
 Result<void> FtsColumnIndexer::insert(uint64_t seg_doc_id,
                                       const std::string &text) {
   // safe access check
@@ -611,66 +1125,44 @@ Result<void> FtsColumnIndexer::insert(uint64_t seg_doc_id,
         "FtsColumnIndexer::insert: not opened. field=", field_name_));
   }
 
-  // Tokenize
-  std::vector<Token> tokens = tokenizer_pipeline_->process(text);
-  const uint32_t doc_len = static_cast<uint32_t>(tokens.size());
-
-  // Aggregate position lists by term
-  std::unordered_map<std::string, std::vector<uint32_t>> term_positions;
-  for (const auto &token : tokens) {
-    term_positions[token.text].push_back(token.position);
-  }
-
-  // Store seg_doc_id in RocksDB directly, similar to invert indexer
-  const uint32_t doc_id_32 = static_cast<uint32_t>(seg_doc_id);
-
-  // Pre-serialize a single-element Roaring Bitmap for this doc_id once,
-  // reused across all terms to avoid repeated create/serialize/free overhead.
-  roaring_bitmap_t *single_bitmap = roaring_bitmap_create_with_capacity(1);
-  roaring_bitmap_add(single_bitmap, doc_id_32);
-  size_t bitmap_size = roaring_bitmap_portable_size_in_bytes(single_bitmap);
-  std::string bitmap_data(bitmap_size, '\0');
-  roaring_bitmap_portable_serialize(single_bitmap, bitmap_data.data());
-  roaring_bitmap_free(single_bitmap);
-
-  // Batch all writes for this document into a single cross-CF WriteBatch,
-  // reducing 4N+1 individual RocksDB Write() calls to one atomic write.
-  rocksdb::WriteBatch batch;
-
-  for (const auto &[term, positions] : term_positions) {
-    const uint32_t tf = static_cast<uint32_t>(positions.size());
-
-    // 1. Postings CF: merge doc_id bitmap
-    batch.Merge(postings_cf_, term, bitmap_data);
+  return insert(seg_doc_id,
+                TokenizedText::tokenize(*tokenizer_pipeline_, text));
+}
 
-    // 2. Positions CF: term\0doc_id -> delta-varint positions
-    const std::string doc_term_key = make_doc_term_key(term, doc_id_32);
-    batch.Put(positions_cf_, doc_term_key, encode_positions(positions));
+Result<void> FtsColumnIndexer::insert(uint64_t seg_doc_id,
+                                      const TokenizedText &tokens) {
+  // safe access check
 
-    // 3. Term-freq CF: term\0doc_id -> uint32_t tf
-    std::string tf_value(sizeof(uint32_t), '\0');
-    std::memcpy(tf_value.data(), &tf, sizeof(uint32_t));
-    batch.Put(term_freq_cf_.load(), doc_term_key, tf_value);
+  if (!ctx_) {
+    return tl::make_unexpected(Status::InternalError(
+        "FtsColumnIndexer::insert: not opened. field=", field_name_));
+  }
 
-    // 4. Max-TF CF: term -> max(tf) via merge
-    batch.Merge(max_tf_cf_.load(), term, tf_value);
+  auto memory_postings = this->memory_postings();
+  if (!memory_postings) {
+    return tl::make_unexpected(Status::InternalError(
+        "FtsColumnIndexer::insert: postings already sealed. field=",
+        field_name_));
   }
 
-  // 5. Doc-len CF: doc_id -> uint32_t doc_len
-  std::string doc_id_key(sizeof(uint32_t), '\0');
-  std::memcpy(doc_id_key.data(), &doc_id_32, sizeof(uint32_t));
-  std::string doc_len_value(sizeof(uint32_t), '\0');
-  std::memcpy(doc_len_value.data(), &doc_len, sizeof(uint32_t));
-  batch.Put(doc_len_cf_.load(), doc_id_key, doc_len_value);
+  // Shingles are extra index terms, not words: doc_len and the stats count
+  // the analyzed tokens only.
+  const uint32_t doc_len = static_cast<uint32_t>(tokens.size());
+  TokenizedText shingled;
+  const TokenizedText &indexed =
+      add_phrase_shingles(tokens, &shingled) ? shingled : tokens;
 
-  if (auto s = ctx_->db_->Write(ctx_->write_opts_, &batch); !s.ok()) {
-    return tl::make_unexpected(Status::InternalError(
-        "FtsColumnIndexer::insert: write batch failed. field=", field_name_,
-        " status=", s.ToString()));
+  // Store seg_doc_id in the buffer directly, similar to invert indexer.
+  // Nothing reaches RocksDB until flush().
+  const uint32_t doc_id_32 = static_cast<uint32_t>(seg_doc_id);
+  if (!memory_postings->add_document(doc_id_32, indexed, doc_len)) {
+    return tl::make_unexpected(Status::InvalidArgument(
+        "FtsColumnIndexer::insert: doc_id not ascending. field=", field_name_,
+        " doc_id=", seg_doc_id));
   }
 
-  // 6. Update in-memory statistics atomically so concurrent search() calls
-  //    see up-to-date values for BM25 scoring.
+  // Update in-memory statistics atomically so concurrent search() calls
+  // see up-to-date values for BM25 scoring.
   const uint64_t new_total_docs =
       total_docs_.fetch_add(1, std::memory_order_relaxed) + 1;
   const uint64_t new_total_tokens =
@@ -699,6 +1191,17 @@ Result<void> FtsColumnIndexer::flush() {
     return {};
   }
 
+  if (auto memory_postings = this->memory_postings()) {
+    auto s = memory_postings->flush(ctx_, postings_cf_, positions_cf_,
+                                    doc_len_cf_.load(), *scorer_,
+                                    /*all_terms=*/false);
+    if (!s.ok()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FtsColumnIndexer::flush: failed to write postings. field=",
+          field_name_, " status=", s.ToString()));
+    }
+  }
+
   // Write total_docs and total_tokens to $SEGMENT_STAT CF.
   // Use acquire ordering so we see all inserts that happened before flush().
   const uint64_t snapshot_total_docs =
@@ -722,6 +1225,14 @@ Result<void> FtsColumnIndexer::flush() {
         "FtsColumnIndexer::flush: failed to write total_tokens. field=",
         field_name_, " status=", s.ToString()));
   }
+  s = ctx_->db_->Put(ctx_->write_opts_, stat_cf_,
+                     make_phrase_shingles_key(field_name_),
+                     encode_shingle_set(complete_shingles_));
+  if (!s.ok()) {
+    return tl::make_unexpected(Status::InternalError(
+        "FtsColumnIndexer::flush: failed to write phrase shingles. field=",
+        field_name_, " status=", s.ToString()));
+  }
 
   return {};
 }
@@ -739,6 +1250,67 @@ Result<void> FtsColumnIndexer::convert_postings_to_bitpacked() {
         field_name_));
   }
 
+  // ---------------------------------------------------------------
+  // 1) Encode the final postings.  The buffer holds every document of the
+  //    segment, so each term is written exactly once with the final stats;
+  //    it is released afterwards and search() falls through to postings_cf.
+  // ---------------------------------------------------------------
+  if (auto memory_postings = this->memory_postings()) {
+    auto s = memory_postings->flush(ctx_, postings_cf_, positions_cf_,
+                                    doc_len_cf_.load(), *scorer_,
+                                    /*all_terms=*/true);
+    if (!s.ok()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FtsColumnIndexer::convert_postings_to_bitpacked: write failed. "
+          "field=",
+          field_name_, " status=", s.ToString()));
+    }
+    std::atomic_store_explicit(&memory_postings_, FtsMemoryPostings::Ptr{},
+                               std::memory_order_release);
+  } else {
+    auto ret = convert_side_cf_postings();
+    if (!ret) {
+      return ret;
+    }
+  }
+
+  // ---------------------------------------------------------------
+  // 2) Clear $TF / $DOC_LEN / $MAX_TF CFs via DeleteRange.
+  //
+  // All payloads (tf, doc_len, max_score) have been inlined into the
+  // BitPacked postings in step 1.  Wiping them here ensures the SST files
+  // are cleaned up during the dump-side compaction, so the dumped immutable
+  // segment is significantly smaller.  MutableSegment then drops the CFs
+  // entirely after all indexers finish conversion.
+  //
+  // DeleteRange uses [begin, end) semantics; an empty begin and a 256-byte
+  // 0xFF end together cover every possible key in these CFs.
+  // ---------------------------------------------------------------
+  static const std::string kClearBegin{};
+  static const std::string kClearEnd(256, '\xFF');
+
+  const std::pair<const char *, rocksdb::ColumnFamilyHandle *> cfs_to_clear[] =
+      {
+          {"$TF", term_freq_cf_.load()},
+          {"$DOC_LEN", doc_len_cf_.load()},
+          {"$MAX_TF", max_tf_cf_.load()},
+      };
+  for (const auto &[cf_name, cf] : cfs_to_clear) {
+    if (cf == nullptr) {
+      continue;
+    }
+    if (!ctx_->db_->DeleteRange(ctx_->write_opts_, cf, kClearBegin, kClearEnd)
+             .ok()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FtsColumnIndexer::convert_postings_to_bitpacked: failed to clear ",
+          cf_name, " CF. field=", field_name_));
+    }
+  }
+
+  return {};
+}
+
+Result<void> FtsColumnIndexer::convert_side_cf_postings() {
   // ---------------------------------------------------------------
   // 1) Load doc_len_cf into an in-memory vector indexed by local doc_id.
   //    Single segment is at most a few MB even for 1M docs (4B per doc),
@@ -860,65 +1432,7 @@ Result<void> FtsColumnIndexer::convert_postings_to_bitpacked() {
   if (!ret) {
     return ret;
   }
-
-  // ---------------------------------------------------------------
-  // 3) Clear $TF / $DOC_LEN / $MAX_TF CFs via DeleteRange.
-  //
-  // All payloads (tf, doc_len, max_score) have been inlined into the
-  // BitPacked postings in step 2.  Wiping them here ensures the SST files
-  // are cleaned up during the dump-side compaction, so the dumped immutable
-  // segment is significantly smaller.  MutableSegment then drops the CFs
-  // entirely after all indexers finish conversion.
-  //
-  // DeleteRange uses [begin, end) semantics; an empty begin and a 256-byte
-  // 0xFF end together cover every possible key in these CFs.
-  // ---------------------------------------------------------------
-  static const std::string kClearBegin{};
-  static const std::string kClearEnd(256, '\xFF');
-
-  const std::pair<const char *, rocksdb::ColumnFamilyHandle *> cfs_to_clear[] =
-      {
-          {"$TF", term_freq_cf_.load()},
-          {"$DOC_LEN", doc_len_cf_.load()},
-          {"$MAX_TF", max_tf_cf_.load()},
-      };
-  for (const auto &[cf_name, cf] : cfs_to_clear) {
-    if (cf == nullptr) {
-      continue;
-    }
-    if (!ctx_->db_->DeleteRange(ctx_->write_opts_, cf, kClearBegin, kClearEnd)
-             .ok()) {
-      return tl::make_unexpected(Status::InternalError(
-          "FtsColumnIndexer::convert_postings_to_bitpacked: failed to clear ",
-          cf_name, " CF. field=", field_name_));
-    }
-  }
-
   return {};
 }
 
-// ============================================================
-// Private helper methods
-// ============================================================
-
-void FtsColumnIndexer::encode_varint(uint32_t value, std::string *output) {
-  while (value >= 0x80) {
-    output->push_back(static_cast<char>((value & 0x7F) | 0x80));
-    value >>= 7;
-  }
-  output->push_back(static_cast<char>(value));
-}
-
-std::string FtsColumnIndexer::encode_positions(
-    const std::vector<uint32_t> &positions) {
-  std::string result;
-  uint32_t prev_position = 0;
-  for (uint32_t position : positions) {
-    // Delta encoding: store the difference between adjacent positions
-    encode_varint(position - prev_position, &result);
-    prev_position = position;
-  }
-  return result;
-}
-
 }  // namespace zvec::fts
@@ -18,7 +18,9 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <zvec/db/schema.h>
 #include <zvec/db/status.h>
@@ -27,7 +29,9 @@
 #include "iterator/fts_doc_iterator.h"
 #include "tokenizer/tokenizer_factory.h"
 #include "bm25_scorer.h"
+#include "fts_memory_postings.h"
 #include "fts_query_ast.h"
+#include "fts_sealed_postings.h"
 
 
 namespace zvec::fts {
@@ -47,8 +51,10 @@ struct FtsResult {
 /*! FTS column indexer
  *  Handles both read (search with BM25 + WAND) and write (insert / flush)
  *  operations on a single FTS column backed by RocksDB.
- *  Uses cross-CF WriteBatch to batch all per-document writes into a single
- *  atomic RocksDB Write() call for optimal write throughput.
+ *  On the mutable path, inserts go to an in-memory FtsMemoryPostings buffer
+ *  that also serves search(); RocksDB is only written at flush() and at
+ *  convert_postings_to_bitpacked() (seal).  Once sealed, search() reads the
+ *  memory-mapped FtsSealedPostings when they are attached.
  */
 class FtsColumnIndexer {
  public:
@@ -60,6 +66,8 @@ class FtsColumnIndexer {
   // -----------------------------------------------------------------
 
   /*! Initialize for read+write (mutable path).
+   *  When doc_len_cf is present (writing segment) the in-memory posting buffer
+   *  is created and rebuilt from any previously flushed $POS / $DOC_LEN data.
    *  \param field_meta    Field meta describing this FTS field; provides both
    *                       the field name and the tokenizer extra params used
    *                       to acquire/release the shared pipeline.
@@ -117,6 +125,10 @@ class FtsColumnIndexer {
   // -----------------------------------------------------------------
 
   /*! Execute FTS query and return result list with BM25 scores
+   *  With FtsQueryParams::anytime, a disjunction of plain terms on a column
+   *  sealed with impacts picks its candidates score-at-a-time within the
+   *  given budget (see impact_ordered_topk()); the candidates are then
+   *  scored exactly like any other search.
    *  \param ast          Pre-parsed FTS AST (caller owns the parse step)
    *  \param query_params Query parameters (topk, filter, etc.)
    *  \return Result containing sorted results (descending score), or Status
@@ -124,6 +136,13 @@ class FtsColumnIndexer {
   Result<std::vector<FtsResult>> search(
       const FtsAstNode &ast, const FtsQueryParams &query_params) const;
 
+  /*! Add this column's BM25 statistics to \p stats: its document and token
+   *  counts, and the document frequency of every term and phrase word of
+   *  \p ast.  Summed over all segments the result feeds
+   *  FtsQueryParams::collection_stats.
+   */
+  void collect_stats(const FtsAstNode &ast, FtsCollectionStats *stats) const;
+
   /*! Atomically reset $TF/$MAX_TF/$DOC_LEN CF pointers to nullptr.
    *  Called before dropping these CFs so that concurrent search() calls
    *  on the Roaring path gracefully degrade (return default tf=1/doc_len=1).
@@ -141,14 +160,28 @@ class FtsColumnIndexer {
    */
   Result<void> insert(uint64_t seg_doc_id, const std::string &text);
 
-  /*! Flush in-memory statistics to RocksDB (called before segment dump)
+  /*! Insert a document already tokenized with this field's pipeline (see
+   *  tokenize_fts_batch()); no tokenization happens on this path.
+   *  \param seg_doc_id  Segment-local document ID
+   *  \param tokens      Tokenizer output for the field value
+   *  \return Result<void> on success, or Status on failure
+   */
+  Result<void> insert(uint64_t seg_doc_id, const TokenizedText &tokens);
+
+  /*! Flush the in-memory posting buffer and statistics to RocksDB.
+   *  Only the $POS and $DOC_LEN entries of documents inserted since the
+   *  previous flush are written; they are all a reader or a reopened writer
+   *  needs to rebuild the buffer.  BitPacked postings are written once, by
+   *  convert_postings_to_bitpacked().
    *  \return Result<void> on success, or Status on failure
    */
   Result<void> flush();
 
-  /*! Convert all Roaring-format postings in postings_cf to BitPacked format
-   *  with inline tf/doc_len/max_score payloads, then DeleteRange-clear the
-   *  $TF, $DOC_LEN, and $MAX_TF CFs.
+  /*! Write the final BitPacked postings (inline tf/doc_len/max_score
+   *  payloads) to postings_cf, then DeleteRange-clear the $TF, $DOC_LEN, and
+   *  $MAX_TF CFs.  With an in-memory buffer every term is encoded once from
+   *  the buffer and the buffer is released afterwards; without one (legacy
+   *  Roaring postings) the $TF / $DOC_LEN CFs are scanned instead.
    *
    *  Called by MutableSegment::dump_fts_column_indexers() right before the
    *  SST dump.  After all indexers finish conversion, MutableSegment drops
@@ -166,6 +199,36 @@ class FtsColumnIndexer {
    */
   Result<void> convert_postings_to_bitpacked();
 
+  /*! Serve postings and positions of search() from \p sealed instead of
+   *  RocksDB.  Only valid once the column is sealed.
+   */
+  void attach_sealed_postings(FtsSealedPostings::Ptr sealed) {
+    std::atomic_store_explicit(&sealed_postings_, std::move(sealed),
+                               std::memory_order_release);
+  }
+
+  FtsSealedPostings::Ptr sealed_postings() const {
+    return std::atomic_load_explicit(&sealed_postings_,
+                                     std::memory_order_acquire);
+  }
+
+  //! Whether sealing also writes impact-ordered postings ("impact_ordered"
+  //! extra param).
+  bool impact_ordered() const {
+    return impact_ordered_;
+  }
+
+  //! Configured phrase shingles indexed for every doc of this segment.
+  //! Shingles configured after docs were indexed are missing for those docs,
+  //! so phrase search only relies on this subset.
+  const std::unordered_set<std::string> &complete_phrase_shingles() const {
+    return complete_shingles_;
+  }
+
+  const BM25ScorerPtr &scorer() const {
+    return scorer_;
+  }
+
   uint64_t total_docs() const {
     return total_docs_.load(std::memory_order_relaxed);
   }
@@ -186,27 +249,82 @@ class FtsColumnIndexer {
   }
 
  private:
+  // Scoring inputs of one search(): without collection stats every term
+  // iterator scores with the segment scorer.
+  struct QueryScoring {
+    BM25ScorerPtr collection_scorer;
+    const FtsCollectionStats *collection_stats{nullptr};
+  };
+
   // --- Iterator tree construction (search internals) ---
-  Result<DocIteratorPtr> build_iterator(const FtsAstNode &node) const;
-  Result<DocIteratorPtr> build_term_iterator(const TermNode &term_node) const;
+  Result<DocIteratorPtr> build_iterator(const FtsAstNode &node,
+                                        const QueryScoring &scoring) const;
+  Result<DocIteratorPtr> build_term_iterator(
+      const TermNode &term_node, const QueryScoring &scoring) const;
   Result<DocIteratorPtr> build_phrase_iterator(
-      const PhraseNode &phrase_node) const;
-  Result<DocIteratorPtr> build_and_iterator(const AndNode &and_node) const;
-  Result<DocIteratorPtr> build_or_iterator(const OrNode &or_node) const;
+      const PhraseNode &phrase_node, const QueryScoring &scoring) const;
+  Result<DocIteratorPtr> build_and_iterator(const AndNode &and_node,
+                                            const QueryScoring &scoring) const;
+  Result<DocIteratorPtr> build_or_iterator(const OrNode &or_node,
+                                           const QueryScoring &scoring) const;
+  // \p encoded_scorer: scorer the BitPacked block-max scores of \p raw_data
+  // were computed with, if not scorer_ (see get_memory_posting()).
   Result<DocIteratorPtr> create_term_iterator_from_raw(
       const std::string &term, rocksdb::PinnableSlice raw_data,
-      float boost = 1.0f) const;
+      const QueryScoring &scoring, float boost = 1.0f,
+      BM25ScorerPtr encoded_scorer = nullptr) const;
+  // Fills \p encoded_scorers in parallel with the result, for
+  // create_term_iterator_from_raw().
   std::vector<rocksdb::PinnableSlice> batch_get_postings(
-      const std::vector<rocksdb::Slice> &terms) const;
+      const std::vector<rocksdb::Slice> &terms,
+      std::vector<BM25ScorerPtr> *encoded_scorers) const;
+  // Candidates of an anytime search, or nullopt when \p ast or this column
+  // does not support it.
+  std::optional<std::vector<uint64_t>> impact_candidates(
+      const FtsAstNode &ast, const FtsQueryParams &query_params,
+      const QueryScoring &scoring) const;
+  // Document frequency of \p term in this segment (0 if absent).
+  uint64_t doc_freq(const std::string &term) const;
+  // Pin a buffered term's encoded posting into \p raw_data (false if
+  // absent).  A cached encoding may predate the current stats; its scorer is
+  // then returned in \p encoded_scorer, else nullptr.
+  bool get_memory_posting(const FtsMemoryPostings &memory_postings,
+                          const std::string &term,
+                          rocksdb::PinnableSlice *raw_data,
+                          BM25ScorerPtr *encoded_scorer) const;
 
   // --- Write helpers ---
-  static void encode_varint(uint32_t value, std::string *output);
-  static std::string encode_positions(const std::vector<uint32_t> &positions);
+  // Parse the "impact_ordered" and "phrase_shingles" extra params.
+  Result<void> load_index_options();
+  // Copy \p tokens into \p out with a shingle token stacked on the first
+  // token of every configured adjacent pair; false (out untouched) if the
+  // document holds none.
+  bool add_phrase_shingles(const TokenizedText &tokens,
+                           TokenizedText *out) const;
+  // Derive complete_shingles_ from the persisted shingle set; must run after
+  // the segment stats are loaded.
+  void load_complete_shingles();
+  // Rebuild memory_postings_ from flushed $POS / $DOC_LEN entries.
+  Result<void> load_memory_postings();
+  // Scan $TF / $DOC_LEN and re-encode Roaring postings (no buffer present).
+  Result<void> convert_side_cf_postings();
+
+  FtsMemoryPostings::Ptr memory_postings() const {
+    return std::atomic_load_explicit(&memory_postings_,
+                                     std::memory_order_acquire);
+  }
 
   // --- Tokenizer (write path only) ---
   FieldSchema::Ptr field_meta_{};
   TokenizerPipelinePtr tokenizer_pipeline_{nullptr};
   std::shared_ptr<zvec::FtsIndexParams> fts_params_;
+  // Adjacent term pairs (make_shingle_term) indexed as one extra term so
+  // phrases over them skip most position checks; set by open().
+  std::unordered_set<std::string> phrase_shingles_;
+  // Subset of phrase_shingles_ indexed for every doc of this segment;
+  // persisted with the segment stats.  Set by open().
+  std::unordered_set<std::string> complete_shingles_;
+  bool impact_ordered_{false};
 
   // --- Reader state ---
   std::string field_name_;
@@ -222,6 +340,15 @@ class FtsColumnIndexer {
   std::atomic<bool> cf_dropped_{false};
   rocksdb::ColumnFamilyHandle *stat_cf_{nullptr};
 
+  // Writing-segment posting buffer; nullptr for readers and after seal.
+  // Accessed through atomic_load/atomic_store because seal releases it while
+  // searches may still be building iterators.
+  FtsMemoryPostings::Ptr memory_postings_{};
+
+  // Memory-mapped postings of a sealed column; nullptr while writing and for
+  // segments sealed without them, which read RocksDB instead.
+  FtsSealedPostings::Ptr sealed_postings_{};
+
   // Minimum doc length observed so far. Used as a (loose) lower bound on
   // doc_len when computing the WAND max_score for Roaring-format postings.
   std::atomic<uint32_t> min_doc_len_{std::numeric_limits<uint32_t>::max()};
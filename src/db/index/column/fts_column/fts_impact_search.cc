@@ -0,0 +1,237 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fts_impact_search.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace zvec::fts {
+
+namespace {
+
+constexpr uint32_t kRowShift = 12;
+constexpr uint32_t kRowSize = 1u << kRowShift;
+// Accumulator of a doc rejected by the filter; real sums stay far below
+// (kMaxImpactSearchTerms * kMaxImpact).
+constexpr uint16_t kExcluded = 0xFFFF;
+static_assert(kMaxImpactSearchTerms * FtsSealedPostings::kMaxImpact <
+                  kExcluded,
+              "accumulators must not reach the excluded marker");
+constexpr uint64_t kTimeCheckPostings = 4096;
+
+// One impact segment of one term and its integer score contribution.
+struct SegmentRef {
+  uint32_t term;
+  uint32_t segment;
+  uint32_t contribution;
+};
+
+/*! Dense per-doc accumulators.  The array is left uninitialized and each
+ *  row of kRowSize docs is zeroed on its first touch, so a query pays only
+ *  for the rows its postings reach, not for the whole segment.
+ */
+class Accumulators {
+ public:
+  explicit Accumulators(uint32_t num_docs)
+      : values_(new uint16_t[num_docs]),
+        num_docs_(num_docs),
+        touched_((num_docs + kRowSize - 1) / kRowSize, 0) {}
+
+  uint16_t &at(uint32_t doc_id) {
+    const uint32_t row = doc_id >> kRowShift;
+    if (!touched_[row]) {
+      const uint32_t begin = row << kRowShift;
+      std::fill(values_.get() + begin,
+                values_.get() + std::min(num_docs_, begin + kRowSize),
+                uint16_t{0});
+      touched_[row] = 1;
+    }
+    return values_[doc_id];
+  }
+
+  // Call fn(doc_id, value) for every scored doc, in doc_id order.
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    for (uint32_t row = 0; row < touched_.size(); ++row) {
+      if (!touched_[row]) {
+        continue;
+      }
+      const uint32_t begin = row << kRowShift;
+      const uint32_t end = std::min(num_docs_, begin + kRowSize);
+      for (uint32_t doc_id = begin; doc_id < end; ++doc_id) {
+        const uint16_t value = values_[doc_id];
+        if (value != 0 && value != kExcluded) {
+          fn(doc_id, value);
+        }
+      }
+    }
+  }
+
+ private:
+  std::unique_ptr<uint16_t[]> values_;
+  uint32_t num_docs_;
+  std::vector<uint8_t> touched_;
+};
+
+}  // namespace
+
+std::vector<uint64_t> impact_ordered_topk(
+    const std::vector<ImpactSearchTerm> &terms,
+    const ImpactSearchLimits &limits, const IndexFilter *filter) {
+  std::vector<uint64_t> candidates;
+  if (terms.empty() || terms.size() > kMaxImpactSearchTerms ||
+      limits.topk == 0) {
+    return candidates;
+  }
+
+  float max_unit_score = 0.0f;
+  uint32_t max_doc_id = 0;
+  for (const auto &term : terms) {
+    if (!term.impacts.empty() && term.unit_score > 0.0f) {
+      max_unit_score = std::max(max_unit_score, term.unit_score);
+      max_doc_id = std::max(max_doc_id, term.impacts.max_doc_id());
+    }
+  }
+  if (max_unit_score <= 0.0f) {
+    return candidates;
+  }
+
+  // Integer contributions: kMaxImpact of the heaviest term maps to
+  // kMaxImpact, every other term scales by its unit score.
+  auto contribution = [&](uint32_t t, uint32_t s) -> uint32_t {
+    const ImpactSearchTerm &term = terms[t];
+    if (term.unit_score <= 0.0f || s >= term.impacts.num_segments()) {
+      return 0;
+    }
+    return static_cast<uint32_t>(std::lround(
+        term.impacts.segment(s).impact * (term.unit_score / max_unit_score)));
+  };
+  std::vector<SegmentRef> segments;
+  // Each term's contribution of its next unprocessed segment.
+  std::vector<uint32_t> next(terms.size(), 0);
+  uint32_t max_total = 0;
+  for (uint32_t t = 0; t < terms.size(); ++t) {
+    for (uint32_t s = 0; s < terms[t].impacts.num_segments(); ++s) {
+      const uint32_t c = contribution(t, s);
+      if (c > 0) {
+        segments.push_back({t, s, c});
+      }
+    }
+    next[t] = contribution(t, 0);
+    max_total += next[t];
+  }
+  std::stable_sort(segments.begin(), segments.end(),
+                   [](const SegmentRef &a, const SegmentRef &b) {
+                     return a.contribution > b.contribution;
+                   });
+
+  Accumulators accumulators(max_doc_id + 1);
+  // Number of scored docs per accumulator value, for the k-th best value.
+  std::vector<uint64_t> histogram(max_total + 1, 0);
+  auto kth_value = [&](uint64_t k) -> uint32_t {
+    uint64_t seen = 0;
+    for (uint32_t value = max_total; value > 0; --value) {
+      seen += histogram[value];
+      if (seen >= k) {
+        return value;
+      }
+    }
+    return 0;
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t processed = 0;
+  uint64_t next_time_check = kTimeCheckPostings;
+  auto out_of_budget = [&]() {
+    if (limits.max_postings > 0 && processed >= limits.max_postings) {
+      return true;
+    }
+    if (limits.budget.count() > 0 && processed >= next_time_check) {
+      next_time_check = processed + kTimeCheckPostings;
+      return std::chrono::steady_clock::now() - start >= limits.budget;
+    }
+    return false;
+  };
+
+  alignas(16) uint32_t doc_ids[FtsSealedPostings::kPositionBlockSize];
+  bool stop = false;
+  for (const auto &ref : segments) {
+    auto blocks = terms[ref.term].impacts.docs(ref.segment);
+    for (uint32_t n = blocks.next(doc_ids); n > 0 && !stop;
+         n = blocks.next(doc_ids)) {
+      for (uint32_t j = 0; j < n; ++j) {
+        const uint32_t doc_id = doc_ids[j];
+        if (doc_id > max_doc_id) {
+          continue;
+        }
+        uint16_t &acc = accumulators.at(doc_id);
+        if (acc == kExcluded) {
+          continue;
+        }
+        if (acc == 0) {
+          if (filter && filter->is_filtered(doc_id)) {
+            acc = kExcluded;
+            continue;
+          }
+        } else {
+          --histogram[acc];
+        }
+        acc = static_cast<uint16_t>(
+            std::min(uint32_t{acc} + ref.contribution, max_total));
+        ++histogram[acc];
+      }
+      processed += n;
+      stop = out_of_budget();
+    }
+    if (stop) {
+      break;
+    }
+
+    next[ref.term] = contribution(ref.term, ref.segment + 1);
+    uint32_t remaining = 0;
+    for (uint32_t c : next) {
+      remaining += c;
+    }
+    if (remaining == 0) {
+      break;
+    }
+    // Safe to stop once nothing outside the top-k can pass its k-th value:
+    // an unscored doc reaches at most `remaining`, a scored one at most its
+    // accumulator plus `remaining` -- unless there is a single term, whose
+    // docs are final once scored.
+    const uint32_t kth = kth_value(limits.topk);
+    if (kth > 0) {
+      const uint32_t outside =
+          terms.size() == 1 ? remaining
+                            : kth_value(uint64_t{limits.topk} + 1) + remaining;
+      if (outside <= kth) {
+        break;
+      }
+    }
+  }
+
+  // Everything at or above the k-th value. Docs tied at it are
+  // indistinguishable after quantization, so all of them are returned for
+  // the caller to rank by their exact score.
+  const uint32_t threshold = std::max(kth_value(limits.topk), 1u);
+  accumulators.for_each([&](uint32_t doc_id, uint16_t value) {
+    if (value >= threshold) {
+      candidates.push_back(doc_id);
+    }
+  });
+  return candidates;
+}
+
+}  // namespace zvec::fts
@@ -0,0 +1,63 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "db/index/common/index_filter.h"
+#include "fts_sealed_postings.h"
+
+namespace zvec::fts {
+
+//! Most terms one impact-ordered search accepts.
+constexpr size_t kMaxImpactSearchTerms = 16;
+
+//! One query term of an impact-ordered search.
+struct ImpactSearchTerm {
+  FtsSealedPostings::TermImpacts impacts;
+  // Score of one impact unit: idf * boost * (k1 + 1) / kMaxImpact.
+  float unit_score{0.0f};
+};
+
+struct ImpactSearchLimits {
+  uint32_t topk{10};
+  // Wall-clock budget; zero means none.
+  std::chrono::microseconds budget{0};
+  // Postings to score at most, checked per block; zero means none.
+  uint64_t max_postings{0};
+};
+
+/*! Score-at-a-time top-k over impact-ordered postings ("anytime" ranking).
+ *
+ *  The impact segments of all terms are processed in decreasing order of
+ *  their score contribution, adding into per-doc integer accumulators, so
+ *  the best-scoring postings are seen first.  Processing stops when every
+ *  segment is done, when no doc outside the current top-k can still
+ *  overtake its k-th accumulator, or when a limit runs out; the top-k
+ *  accumulated so far is the answer.  Impacts are quantized, so the result
+ *  approximates the BM25 top-k and the caller rescores it exactly.  Every
+ *  doc tied at the k-th accumulator is returned too, since quantization
+ *  cannot tell which of them scores best.
+ *
+ *  \param terms   at most kMaxImpactSearchTerms terms
+ *  \param filter  docs it rejects never enter the result (may be null)
+ *  \return candidate doc_ids, ascending
+ */
+std::vector<uint64_t> impact_ordered_topk(
+    const std::vector<ImpactSearchTerm> &terms,
+    const ImpactSearchLimits &limits, const IndexFilter *filter);
+
+}  // namespace zvec::fts
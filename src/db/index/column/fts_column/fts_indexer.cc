@@ -17,6 +17,7 @@
 #include "db/common/constants.h"
 #include "db/common/file_helper.h"
 #include "fts_rocksdb_merge.h"
+#include "fts_sealed_postings.h"
 #include "fts_utils.h"
 
 namespace zvec {
@@ -104,6 +105,13 @@ Status FtsIndexer::open(const FieldSchemaPtrList &fts_fields, bool create,
                                    ret.error().message());
     }
 
+    // Sealed fields read the mapped postings when they were written.
+    if (doc_len_cf == nullptr) {
+      if (auto sealed = fts::FtsSealedPostings::Open(working_dir_, name)) {
+        indexer->attach_sealed_postings(std::move(sealed));
+      }
+    }
+
     indexers_[name] = indexer;
   }
 
@@ -154,8 +162,21 @@ Status FtsIndexer::create_snapshot(const std::string &snapshot_path) {
   if (!s.ok()) {
     LOG_ERROR("FtsIndexer: create_checkpoint to [%s] failed: %s",
               snapshot_path.c_str(), s.message().c_str());
+    return s;
+  }
+  // The checkpoint only carries RocksDB files; bring the sealed ones along.
+  for (const auto &[name, _] : indexers_) {
+    if (!fts::FtsSealedPostings::Exists(working_dir_, name)) {
+      continue;
+    }
+    s = fts::FtsSealedPostings::Link(working_dir_, snapshot_path, name);
+    if (!s.ok()) {
+      LOG_ERROR("FtsIndexer: link sealed postings to [%s] failed: %s",
+                snapshot_path.c_str(), s.message().c_str());
+      return s;
+    }
   }
-  return s;
+  return Status::OK();
 }
 
 Status FtsIndexer::create_field_indexer(const FieldSchema &field) {
@@ -220,7 +241,8 @@ Status FtsIndexer::remove_field_indexer(const std::string &field_name) {
     indexers_.erase(it);
   }
 
-  // Drop all CFs belonging to this field.
+  // Drop all CFs and sealed files belonging to this field.
+  fts::FtsSealedPostings::Remove(working_dir_, field_name);
   fts_ctx_->drop_cf(field_name);
   fts_ctx_->drop_cf(field_name + kFtsPositionsSuffix);
   fts_ctx_->drop_cf(field_name + kFtsTfSuffix);
@@ -268,6 +290,21 @@ Status FtsIndexer::insert(const std::string &field_name, uint32_t seg_doc_id,
   return Status::OK();
 }
 
+Status FtsIndexer::insert(const std::string &field_name, uint32_t seg_doc_id,
+                          const fts::TokenizedText &tokens) {
+  auto it = indexers_.find(field_name);
+  if (it == indexers_.end()) {
+    return Status::NotFound("FtsIndexer::insert: field not found: ",
+                            field_name);
+  }
+  auto ret = it->second->insert(seg_doc_id, tokens);
+  if (!ret.has_value()) {
+    return Status::InternalError("FtsIndexer::insert failed: ", field_name, " ",
+                                 ret.error().message());
+  }
+  return Status::OK();
+}
+
 Status FtsIndexer::seal(const std::string &field_name) {
   auto it = indexers_.find(field_name);
   if (it == indexers_.end()) {
@@ -293,7 +330,7 @@ Status FtsIndexer::seal(const std::string &field_name) {
   fts_ctx_->drop_cf(field_name + kFtsMaxTfSuffix);
   fts_ctx_->drop_cf(field_name + kFtsDocLenSuffix);
 
-  return Status::OK();
+  return build_sealed_postings(field_name, indexer);
 }
 
 Status FtsIndexer::seal_all() {
@@ -325,6 +362,33 @@ Status FtsIndexer::seal_all() {
     fts_ctx_->drop_cf(name + kFtsDocLenSuffix);
   }
 
+  for (const auto &[name, indexer] : indexers_) {
+    auto s = build_sealed_postings(name, indexer);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status FtsIndexer::build_sealed_postings(
+    const std::string &field_name, const fts::FtsColumnIndexerPtr &indexer) {
+  auto s = fts::FtsSealedPostings::Build(
+      working_dir_, field_name, fts_ctx_.get(), indexer->postings_cf(),
+      indexer->positions_cf(),
+      indexer->impact_ordered() ? indexer->scorer().get() : nullptr);
+  if (!s.ok()) {
+    LOG_ERROR("FtsIndexer: build sealed postings failed for field[%s]: %s",
+              field_name.c_str(), s.message().c_str());
+    return s;
+  }
+  auto sealed = fts::FtsSealedPostings::Open(working_dir_, field_name);
+  if (!sealed) {
+    return Status::InternalError(
+        "FtsIndexer: failed to open sealed postings: ", field_name);
+  }
+  indexer->attach_sealed_postings(std::move(sealed));
   return Status::OK();
 }
 
@@ -63,7 +63,12 @@ class FtsIndexer {
   Status insert(const std::string &field_name, uint32_t seg_doc_id,
                 const std::string &text);
 
-  // Seal a single field: flush + convert_postings_to_bitpacked + drop side CFs.
+  // Insert a document whose field value was tokenized ahead of time.
+  Status insert(const std::string &field_name, uint32_t seg_doc_id,
+                const fts::TokenizedText &tokens);
+
+  // Seal a single field: flush + convert_postings_to_bitpacked + drop side CFs,
+  // then write and attach the field's memory-mapped sealed postings.
   Status seal(const std::string &field_name);
 
   // Seal all fields (used by dump path).
@@ -85,6 +90,9 @@ class FtsIndexer {
   Status open(const FieldSchemaPtrList &fts_fields, bool create,
               bool read_only);
 
+  Status build_sealed_postings(const std::string &field_name,
+                               const fts::FtsColumnIndexerPtr &indexer);
+
   std::string working_dir_;
   std::shared_ptr<RocksdbContext> fts_ctx_;
   std::unordered_map<std::string, fts::FtsColumnIndexerPtr> indexers_;
@@ -0,0 +1,309 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fts_memory_postings.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <rocksdb/write_batch.h>
+#include "posting/bitpacked_posting_list.h"
+#include "fts_utils.h"
+
+namespace zvec::fts {
+
+namespace {
+
+void append_varint(uint32_t value, std::string *output) {
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+}  // namespace
+
+uint32_t FtsMemoryPostings::term_id(std::string_view term) {
+  const uint32_t id = terms_.intern(term);
+  if (id == postings_.size()) {
+    postings_.emplace_back();
+  }
+  return id;
+}
+
+bool FtsMemoryPostings::add_document(uint32_t doc_id,
+                                     const TokenizedText &tokens,
+                                     uint32_t doc_len) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (has_docs_ && doc_id <= last_doc_id_) {
+    return false;
+  }
+  has_docs_ = true;
+  last_doc_id_ = doc_id;
+
+  if (doc_id >= doc_lens_.size()) {
+    doc_lens_.resize(static_cast<size_t>(doc_id) + 1, kNoDocLen);
+  }
+  doc_lens_[doc_id] = doc_len;
+  pending_docs_.push_back(doc_id);
+
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const uint32_t position = tokens.position(i);
+    const uint32_t id = term_id(tokens.term(i));
+    TermPostings &postings = postings_[id];
+    if (postings.doc_ids.empty() || postings.doc_ids.back() != doc_id) {
+      if (postings.doc_ids.size() == postings.persisted_docs) {
+        dirty_terms_.push_back(id);
+      }
+      // Queries still holding the old encoding keep it alive.
+      postings.encoded.reset();
+      postings.doc_ids.push_back(doc_id);
+      postings.tfs.push_back(0);
+      postings.position_offsets.push_back(
+          static_cast<uint32_t>(postings.positions.size()));
+      postings.last_position = 0;
+    }
+    ++postings.tfs.back();
+    append_varint(position - postings.last_position, &postings.positions);
+    postings.last_position = position;
+  }
+  return true;
+}
+
+void FtsMemoryPostings::restore_doc_len(uint32_t doc_id, uint32_t doc_len) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (doc_id >= doc_lens_.size()) {
+    doc_lens_.resize(static_cast<size_t>(doc_id) + 1, kNoDocLen);
+  }
+  doc_lens_[doc_id] = doc_len;
+  if (!has_docs_ || doc_id > last_doc_id_) {
+    has_docs_ = true;
+    last_doc_id_ = doc_id;
+  }
+}
+
+bool FtsMemoryPostings::restore_positions(const std::string &term,
+                                          uint32_t doc_id, const char *data,
+                                          size_t size) {
+  // Every varint ends with a byte whose high bit is clear, so counting those
+  // bytes yields the number of positions, i.e. the term frequency.
+  uint32_t tf = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if ((static_cast<uint8_t>(data[i]) & 0x80) == 0) {
+      ++tf;
+    }
+  }
+  if (tf == 0) {
+    return false;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  const uint32_t id = term_id(term);
+  TermPostings &postings = postings_[id];
+  if (!postings.doc_ids.empty() && postings.doc_ids.back() >= doc_id) {
+    return false;
+  }
+  postings.doc_ids.push_back(doc_id);
+  postings.tfs.push_back(tf);
+  postings.position_offsets.push_back(
+      static_cast<uint32_t>(postings.positions.size()));
+  postings.positions.append(data, size);
+  postings.persisted_docs = static_cast<uint32_t>(postings.doc_ids.size());
+  if (!has_docs_ || doc_id > last_doc_id_) {
+    has_docs_ = true;
+    last_doc_id_ = doc_id;
+  }
+  return true;
+}
+
+std::pair<const char *, size_t> FtsMemoryPostings::positions_slice(
+    const TermPostings &postings, size_t idx) {
+  const size_t begin = postings.position_offsets[idx];
+  const size_t end = idx + 1 < postings.position_offsets.size()
+                         ? postings.position_offsets[idx + 1]
+                         : postings.positions.size();
+  return {postings.positions.data() + begin, end - begin};
+}
+
+std::string FtsMemoryPostings::encode_locked(const TermPostings &postings,
+                                             const BM25Scorer &scorer) const {
+  const size_t count = postings.doc_ids.size();
+  // Same defaulting as the $DOC_LEN-based conversion: a missing or zero
+  // doc_len becomes 1 to keep the BM25 length normalisation finite.
+  std::vector<uint32_t> term_doc_lens(count, 1);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t did = postings.doc_ids[i];
+    if (did < doc_lens_.size() && doc_lens_[did] != kNoDocLen &&
+        doc_lens_[did] > 0) {
+      term_doc_lens[i] = doc_lens_[did];
+    }
+  }
+  return BitPackedPostingList::encode(postings.doc_ids.data(),
+                                      postings.tfs.data(), term_doc_lens.data(),
+                                      count, /*df=*/count, scorer);
+}
+
+FtsMemoryPostings::EncodedPtr FtsMemoryPostings::encoded_postings(
+    const std::string &term, const BM25Scorer &scorer) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  const uint32_t id = terms_.find(term);
+  if (id == TermInterner::kNotFound) {
+    return nullptr;
+  }
+  const TermPostings &postings = postings_[id];
+  EncodedPtr encoded =
+      std::atomic_load_explicit(&postings.encoded, std::memory_order_acquire);
+  if (encoded && encoded->num_docs == postings.doc_ids.size()) {
+    return encoded;
+  }
+
+  // Concurrent readers of a dirtied term may both encode it; either result
+  // is complete, so the last store wins.
+  auto fresh = std::make_shared<Encoded>();
+  fresh->data = encode_locked(postings, scorer);
+  fresh->num_docs = static_cast<uint32_t>(postings.doc_ids.size());
+  fresh->scorer = std::make_shared<BM25Scorer>(scorer.params());
+  const SegmentStatsSnapshot stats = scorer.stats();
+  fresh->scorer->update_stats(stats.total_docs, stats.total_tokens);
+  encoded = std::move(fresh);
+  std::atomic_store_explicit(&postings.encoded, encoded,
+                             std::memory_order_release);
+  return encoded;
+}
+
+uint64_t FtsMemoryPostings::doc_freq(const std::string &term) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  const uint32_t id = terms_.find(term);
+  if (id == TermInterner::kNotFound) {
+    return 0;
+  }
+  return postings_[id].doc_ids.size();
+}
+
+bool FtsMemoryPostings::get_positions(const std::string &term, uint32_t doc_id,
+                                      std::vector<uint32_t> *out) const {
+  out->clear();
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  const uint32_t id = terms_.find(term);
+  if (id == TermInterner::kNotFound) {
+    return false;
+  }
+  const TermPostings &postings = postings_[id];
+  auto doc_it = std::lower_bound(postings.doc_ids.begin(),
+                                 postings.doc_ids.end(), doc_id);
+  if (doc_it == postings.doc_ids.end() || *doc_it != doc_id) {
+    return false;
+  }
+  auto [data, size] =
+      positions_slice(postings, doc_it - postings.doc_ids.begin());
+
+  uint32_t current_position = 0;
+  size_t index = 0;
+  while (index < size) {
+    uint32_t delta = 0;
+    uint32_t shift = 0;
+    while (index < size) {
+      const uint8_t byte = static_cast<uint8_t>(data[index++]);
+      delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      shift += 7;
+      if ((byte & 0x80) == 0) {
+        break;
+      }
+    }
+    current_position += delta;
+    out->push_back(current_position);
+  }
+  return !out->empty();
+}
+
+rocksdb::Status FtsMemoryPostings::flush(
+    RocksdbContext *ctx, rocksdb::ColumnFamilyHandle *postings_cf,
+    rocksdb::ColumnFamilyHandle *positions_cf,
+    rocksdb::ColumnFamilyHandle *doc_len_cf, const BM25Scorer &scorer,
+    bool all_terms) {
+  std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+
+  rocksdb::WriteBatch batch;
+  // (term id, doc count persisted once the batch is written)
+  std::vector<std::pair<uint32_t, uint32_t>> written_terms;
+  size_t written_docs = 0;
+  {
+    // Inserts keep going while the batch is built; only what is buffered at
+    // this point is persisted.
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!all_terms && dirty_terms_.empty() && pending_docs_.empty()) {
+      return rocksdb::Status::OK();
+    }
+
+    std::string key;
+    written_terms.reserve(dirty_terms_.size());
+    for (uint32_t id : dirty_terms_) {
+      const TermPostings &postings = postings_[id];
+      const std::string_view term = terms_.term(id);
+      const uint32_t count = static_cast<uint32_t>(postings.doc_ids.size());
+      for (size_t i = postings.persisted_docs; i < count; ++i) {
+        key.clear();
+        append_doc_term_key(term, postings.doc_ids[i], &key);
+        auto [data, size] = positions_slice(postings, i);
+        batch.Put(positions_cf, key, rocksdb::Slice(data, size));
+      }
+      written_terms.emplace_back(id, count);
+    }
+
+    if (all_terms) {
+      for (uint32_t id = 0; id < postings_.size(); ++id) {
+        const std::string_view term = terms_.term(id);
+        batch.Put(postings_cf, rocksdb::Slice(term.data(), term.size()),
+                  encode_locked(postings_[id], scorer));
+      }
+    }
+
+    if (doc_len_cf != nullptr) {
+      // Same raw uint32 key/value layout as the legacy per-insert writes, so
+      // restore_doc_len() reads both.
+      char doc_id_key[sizeof(uint32_t)];
+      char doc_len_value[sizeof(uint32_t)];
+      for (uint32_t doc_id : pending_docs_) {
+        std::memcpy(doc_id_key, &doc_id, sizeof(uint32_t));
+        std::memcpy(doc_len_value, &doc_lens_[doc_id], sizeof(uint32_t));
+        batch.Put(doc_len_cf, rocksdb::Slice(doc_id_key, sizeof(uint32_t)),
+                  rocksdb::Slice(doc_len_value, sizeof(uint32_t)));
+      }
+    }
+    written_docs = pending_docs_.size();
+  }
+
+  auto s = ctx->db_->Write(ctx->write_opts_, &batch);
+  if (!s.ok()) {
+    return s;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  for (const auto &[id, count] : written_terms) {
+    postings_[id].persisted_docs = count;
+  }
+  // Terms that gained documents during the write stay dirty.
+  dirty_terms_.erase(
+      std::remove_if(dirty_terms_.begin(), dirty_terms_.end(),
+                     [this](uint32_t id) {
+                       return postings_[id].persisted_docs ==
+                              postings_[id].doc_ids.size();
+                     }),
+      dirty_terms_.end());
+  pending_docs_.erase(pending_docs_.begin(),
+                      pending_docs_.begin() + written_docs);
+  return rocksdb::Status::OK();
+}
+
+}  // namespace zvec::fts
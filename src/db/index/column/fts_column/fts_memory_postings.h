@@ -0,0 +1,183 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <rocksdb/status.h>
+#include "db/common/rocksdb_context.h"
+#include "bm25_scorer.h"
+#include "fts_term_interner.h"
+#include "fts_tokenized_text.h"
+
+namespace zvec::fts {
+
+/*! In-memory posting buffer for the writing segment of one FTS column.
+ *
+ *  Replaces the per-term RocksDB Merge() on the insert path: each token is
+ *  interned to a dense term ID (TermInterner) that indexes growable doc_id /
+ *  tf arrays plus a per-term byte buffer of delta-varint positions (the same
+ *  encoding as the $POS CF values).  Queries on the writing segment read the
+ *  buffer directly — a term's posting is encoded to BitPacked on demand and
+ *  the encoding is kept until the term gains a document — so no RocksDB read
+ *  happens for mutable data either.
+ *
+ *  Persistence is incremental and explicit:
+ *    - flush() appends the $POS and $DOC_LEN entries of the documents added
+ *      since the previous flush in a single WriteBatch.  BitPacked postings
+ *      are only written by the sealing flush (all_terms), once per term.
+ *    - A reopened writing segment rebuilds the buffer from $POS + $DOC_LEN
+ *      via restore_doc_len() / restore_positions().
+ *
+ *  Thread-safety: add_document()/restore_*() take the lock exclusively;
+ *  encoded_postings()/get_positions() take it shared, so search may run
+ *  concurrently with insert.  flush() builds its batch under the shared lock
+ *  and writes it without holding the lock.
+ */
+class FtsMemoryPostings {
+ public:
+  using Ptr = std::shared_ptr<FtsMemoryPostings>;
+
+  //! A term's BitPacked posting, shared with the queries reading it.
+  struct Encoded {
+    std::string data;
+    // Number of the term's documents the encoding covers.
+    uint32_t num_docs{0};
+    // Snapshot of the scorer the block-max scores were computed with.
+    BM25ScorerPtr scorer;
+  };
+  using EncodedPtr = std::shared_ptr<const Encoded>;
+
+  FtsMemoryPostings() = default;
+
+  FtsMemoryPostings(const FtsMemoryPostings &) = delete;
+  FtsMemoryPostings &operator=(const FtsMemoryPostings &) = delete;
+
+  /*! Append one document.
+   *  \param doc_id  Segment-local doc_id; must be greater than every doc_id
+   *                 added before, which keeps each posting sorted
+   *  \param tokens  Tokenizer output in ascending position order
+   *  \param doc_len Length used by BM25; tokens may hold more entries than
+   *                 that, e.g. phrase shingles stacked on real tokens
+   *  \return false if doc_id is out of order (nothing is added)
+   */
+  bool add_document(uint32_t doc_id, const TokenizedText &tokens,
+                    uint32_t doc_len);
+
+  /*! Restore one persisted $DOC_LEN entry (reopen path). */
+  void restore_doc_len(uint32_t doc_id, uint32_t doc_len);
+
+  /*! Restore one persisted $POS entry (reopen path).  Entries must arrive in
+   *  ($POS key) order, i.e. ascending doc_id within a term.  The restored
+   *  entry is considered already persisted and is not rewritten by flush().
+   *  \return false if the entry is out of order or empty
+   */
+  bool restore_positions(const std::string &term, uint32_t doc_id,
+                         const char *data, size_t size);
+
+  /*! The current posting of \p term as a BitPacked posting list.
+   *  The encoding is cached per term and reused until a document is added to
+   *  the term, so a hot term is not re-encoded by every query.  Its block-max
+   *  scores therefore reflect Encoded::scorer, which may lag \p scorer.
+   *  \return nullptr if the term is not in the buffer
+   */
+  EncodedPtr encoded_postings(const std::string &term,
+                              const BM25Scorer &scorer) const;
+
+  //! Number of buffered documents containing \p term.
+  uint64_t doc_freq(const std::string &term) const;
+
+  /*! Decode the positions of \p term in \p doc_id.
+   *  \return false if the term does not occur in the document
+   */
+  bool get_positions(const std::string &term, uint32_t doc_id,
+                     std::vector<uint32_t> *out) const;
+
+  /*! Persist buffered data in one WriteBatch.
+   *  \param all_terms  true also encodes every term as a BitPacked posting
+   *                    (seal: BM25 block-max scores must reflect the final
+   *                    segment stats); false only appends new $POS and
+   *                    $DOC_LEN entries
+   *  \param doc_len_cf may be nullptr, in which case doc lengths are only
+   *                    persisted inline in the BitPacked postings
+   */
+  rocksdb::Status flush(RocksdbContext *ctx,
+                        rocksdb::ColumnFamilyHandle *postings_cf,
+                        rocksdb::ColumnFamilyHandle *positions_cf,
+                        rocksdb::ColumnFamilyHandle *doc_len_cf,
+                        const BM25Scorer &scorer, bool all_terms);
+
+  size_t term_count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return postings_.size();
+  }
+
+ private:
+  static constexpr uint32_t kNoDocLen = std::numeric_limits<uint32_t>::max();
+
+  struct TermPostings {
+    std::vector<uint32_t> doc_ids;
+    std::vector<uint32_t> tfs;
+    // Start of each doc's slice in `positions`; the slice ends where the next
+    // doc's starts (or at positions.size() for the last doc).
+    std::vector<uint32_t> position_offsets;
+    std::string positions;
+    // Last position appended for the current (last) doc; deltas restart at 0
+    // for every doc so each slice is a valid $POS value on its own.
+    uint32_t last_position{0};
+    // Number of leading entries already written to RocksDB.
+    uint32_t persisted_docs{0};
+    // Last encoding handed out; stale once doc_ids grew past its num_docs.
+    // Filled by readers under the shared lock, hence atomic access.
+    mutable EncodedPtr encoded;
+  };
+
+  // Returns the term's slot, creating it on first sight.
+  uint32_t term_id(std::string_view term);
+
+  // Slice of the positions buffer belonging to entry \p idx of \p postings.
+  static std::pair<const char *, size_t> positions_slice(
+      const TermPostings &postings, size_t idx);
+
+  std::string encode_locked(const TermPostings &postings,
+                            const BM25Scorer &scorer) const;
+
+  mutable std::shared_mutex mutex_;
+  // Serializes flush(); held across the RocksDB write, unlike mutex_.
+  std::mutex flush_mutex_;
+
+  // Term dictionary; postings_ is indexed by the interned term ID.
+  TermInterner terms_;
+  std::vector<TermPostings> postings_;
+
+  // Terms with entries not yet persisted, in first-touch order.
+  std::vector<uint32_t> dirty_terms_;
+
+  // doc_len indexed by doc_id (kNoDocLen for doc_ids never added).
+  std::vector<uint32_t> doc_lens_;
+  // Docs added since the last flush whose $DOC_LEN entry is still pending.
+  std::vector<uint32_t> pending_docs_;
+
+  bool has_docs_{false};
+  uint32_t last_doc_id_{0};
+};
+
+}  // namespace zvec::fts
@@ -104,11 +104,13 @@ struct TermNode : public FtsAstNode {
 };
 
 /*! Phrase node
- *  Represents an exact phrase query, e.g., "exact phrase"
- *  Requires exact match of word order and adjacent positions
+ *  Represents a phrase query, e.g., "exact phrase"
+ *  Requires exact match of word order and adjacent positions; with a slop
+ *  ("near words"~2) the terms may sit up to slop position moves away.
  */
 struct PhraseNode : public FtsAstNode {
   std::vector<std::string> terms;  // Individual words in the phrase
+  uint32_t slop{0};
 
   FtsNodeType type() const override {
     return FtsNodeType::PHRASE;
@@ -123,6 +125,9 @@ struct PhraseNode : public FtsAstNode {
       result += terms[i];
     }
     result += "\"";
+    if (slop > 0) {
+      result += "~" + std::to_string(slop);
+    }
     result += boost_suffix();
     return result;
   }
@@ -0,0 +1,245 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fts_query_cache.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <zvec/ailego/buffer/block_eviction_queue.h>
+#include <zvec/db/config.h>
+
+namespace zvec::fts {
+
+namespace {
+
+// Bookkeeping charged per entry on top of its key and results: list node,
+// hash node and bucket.
+constexpr size_t kEntryOverhead = 128;
+
+template <typename T>
+void append_fixed(T value, std::string *out) {
+  out->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void append_string(const std::string &value, std::string *out) {
+  append_fixed(static_cast<uint32_t>(value.size()), out);
+  out->append(value);
+}
+
+void append_node(const FtsAstNode &node, std::string *out) {
+  out->push_back(static_cast<char>(node.type()));
+  out->push_back(static_cast<char>((node.must ? 1 : 0) |
+                                   (node.must_not ? 2 : 0) |
+                                   (node.should ? 4 : 0)));
+  append_fixed(node.boost, out);
+  switch (node.type()) {
+    case FtsNodeType::TERM:
+      append_string(static_cast<const TermNode &>(node).term, out);
+      break;
+    case FtsNodeType::PHRASE: {
+      const auto &phrase = static_cast<const PhraseNode &>(node);
+      append_fixed(phrase.slop, out);
+      append_fixed(static_cast<uint32_t>(phrase.terms.size()), out);
+      for (const auto &term : phrase.terms) {
+        append_string(term, out);
+      }
+      break;
+    }
+    case FtsNodeType::AND:
+    case FtsNodeType::OR: {
+      // Operands commute: sort their encodings.
+      const auto &children =
+          node.type() == FtsNodeType::AND
+              ? static_cast<const AndNode &>(node).children
+              : static_cast<const OrNode &>(node).children;
+      std::vector<std::string> keys(children.size());
+      for (size_t i = 0; i < children.size(); ++i) {
+        append_node(*children[i], &keys[i]);
+      }
+      std::sort(keys.begin(), keys.end());
+      append_fixed(static_cast<uint32_t>(keys.size()), out);
+      for (const auto &key : keys) {
+        append_string(key, out);
+      }
+      break;
+    }
+    case FtsNodeType::EMPTY:
+      break;
+  }
+}
+
+}  // namespace
+
+FtsQueryCache &FtsQueryCache::Instance() {
+  // Never destroyed: segments erase their scope while closing, which may
+  // happen during static destruction.
+  static FtsQueryCache *cache =
+      new FtsQueryCache(GlobalConfig::Instance().fts_query_cache_bytes());
+  return *cache;
+}
+
+uint64_t FtsQueryCache::NewScope() {
+  static std::atomic<uint64_t> next_scope{1};
+  return next_scope.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string FtsQueryCache::QueryKey(const std::string &field_name,
+                                    const FtsAstNode &ast,
+                                    const FtsQueryParams &params) {
+  std::string key;
+  append_string(field_name, &key);
+  append_node(ast, &key);
+  // The statistics themselves go into the epoch, so their moves replace
+  // this key's entry instead of adding new keys.
+  if (params.collection_stats) {
+    key.push_back('S');
+  }
+  if (params.anytime) {
+    key.push_back('A');
+    append_fixed(static_cast<int64_t>(params.anytime_budget.count()), &key);
+    append_fixed(params.anytime_max_postings, &key);
+  }
+  return key;
+}
+
+std::string FtsQueryCache::StatsEpoch(const FtsQueryParams &params) {
+  std::string epoch;
+  if (const auto *stats = params.collection_stats.get()) {
+    append_fixed(stats->total_docs, &epoch);
+    append_fixed(stats->total_tokens, &epoch);
+    std::map<std::string, uint64_t> doc_freqs(stats->doc_freqs.begin(),
+                                              stats->doc_freqs.end());
+    for (const auto &[term, doc_freq] : doc_freqs) {
+      append_string(term, &epoch);
+      append_fixed(doc_freq, &epoch);
+    }
+  }
+  return epoch;
+}
+
+FtsQueryCache::FtsQueryCache(size_t capacity)
+    : capacity_(capacity), shard_capacity_(capacity / kShardCount) {
+  // Construct the pool first so it outlives every charge made here.
+  ailego::MemoryLimitPool::get_instance();
+}
+
+FtsQueryCache::~FtsQueryCache() {
+  const size_t charged = charged_.load();
+  if (charged != 0) {
+    ailego::MemoryLimitPool::get_instance().release_external(charged);
+  }
+}
+
+std::string FtsQueryCache::Encode(const Key &key) {
+  std::string encoded;
+  encoded.reserve(sizeof(uint64_t) + sizeof(uint32_t) + key.query.size());
+  append_fixed(key.scope, &encoded);
+  append_fixed(key.topk, &encoded);
+  encoded.append(key.query);
+  return encoded;
+}
+
+FtsQueryCache::Shard &FtsQueryCache::shard(const std::string &encoded) {
+  return shards_[std::hash<std::string>{}(encoded) % kShardCount];
+}
+
+bool FtsQueryCache::get(const Key &key, const Epoch &epoch,
+                        std::vector<FtsResult> *results) {
+  if (capacity_ == 0) {
+    return false;
+  }
+  const std::string encoded = Encode(key);
+  Shard &s = shard(encoded);
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.index.find(encoded);
+    if (it != s.index.end()) {
+      if (it->second->epoch == epoch) {
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        *results = it->second->results;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      // Stale: release its memory now rather than when it ages out.
+      erase(s, it->second);
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void FtsQueryCache::put(const Key &key, const Epoch &epoch,
+                        const std::vector<FtsResult> &results) {
+  std::string encoded = Encode(key);
+  const size_t charge = kEntryOverhead + 2 * encoded.size() +
+                        epoch.stats.size() +
+                        results.size() * sizeof(FtsResult);
+  if (charge > shard_capacity_) {
+    return;
+  }
+  auto &pool = ailego::MemoryLimitPool::get_instance();
+  if (pool.pool_size() != 0 && pool.is_full()) {
+    return;
+  }
+
+  Shard &s = shard(encoded);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto it = s.index.find(encoded);
+  if (it != s.index.end()) {
+    erase(s, it->second);
+  }
+  while (!s.lru.empty() && s.size + charge > shard_capacity_) {
+    erase(s, std::prev(s.lru.end()));
+  }
+  s.lru.push_front(Entry{encoded, key.scope, epoch, results, charge});
+  s.index.emplace(std::move(encoded), s.lru.begin());
+  s.size += charge;
+  charged_.fetch_add(charge, std::memory_order_relaxed);
+  pool.charge_external(charge);
+}
+
+void FtsQueryCache::erase_scope(uint64_t scope) {
+  if (capacity_ == 0) {
+    return;
+  }
+  for (Shard &s : shards_) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (auto it = s.lru.begin(); it != s.lru.end();) {
+      auto next = std::next(it);
+      if (it->scope == scope) {
+        erase(s, it);
+      }
+      it = next;
+    }
+  }
+}
+
+size_t FtsQueryCache::count() const {
+  size_t total = 0;
+  for (const Shard &s : shards_) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    total += s.index.size();
+  }
+  return total;
+}
+
+void FtsQueryCache::erase(Shard &s, std::list<Entry>::iterator it) {
+  s.size -= it->charge;
+  charged_.fetch_sub(it->charge, std::memory_order_relaxed);
+  ailego::MemoryLimitPool::get_instance().release_external(it->charge);
+  s.index.erase(it->key);
+  s.lru.erase(it);
+}
+
+}  // namespace zvec::fts
@@ -0,0 +1,169 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "fts_column_indexer.h"
+#include "fts_query_ast.h"
+#include "fts_types.h"
+
+namespace zvec::fts {
+
+/*! Bounded LRU cache of per-segment FTS results, shared by every collection
+ *  of the process.
+ *
+ *  Hybrid traffic repeats the same keyword queries, and on a sealed segment
+ *  their results only change when a doc of the segment is deleted, when the
+ *  segment's FTS index is rebuilt, or -- under collection-wide statistics --
+ *  when the statistics of the query terms move.  An entry is keyed by
+ *    - scope: process-unique id of one segment's FTS index, renewed when
+ *      the index is replaced and erased when the segment closes;
+ *    - query: the normalized query and everything else that shapes the
+ *      result (see QueryKey());
+ *    - topk;
+ *  and stamped with the epoch it was computed at: the segment's deleted-doc
+ *  count and the statistics epoch of the query (see StatsEpoch()).  A get()
+ *  that finds its key under another epoch drops the entry, so inserts
+ *  elsewhere in the collection never leave stale entries of a sealed
+ *  segment behind; the segment keeps one entry per query.
+ *  Entry memory is charged to the MemoryLimitPool; nothing is admitted
+ *  while the pool is full.
+ *
+ *  Decoded posting blocks are deliberately not cached: sealed postings are
+ *  mmapped, and a BitPacked block decodes in fewer cycles than a hashed
+ *  lookup plus a copy of its 128 doc ids, tfs and lengths would take, while
+ *  the copies would compete with the page cache for the same memory.
+ */
+class FtsQueryCache {
+ public:
+  struct Key {
+    uint64_t scope{0};
+    std::string query;
+    uint32_t topk{0};
+  };
+
+  //! What a cached result was computed from, besides its key.
+  struct Epoch {
+    // Deleted-doc count of the segment
+    uint64_t version{0};
+    // StatsEpoch() of the query
+    std::string stats;
+
+    bool operator==(const Epoch &other) const {
+      return version == other.version && stats == other.stats;
+    }
+  };
+
+  //! Process-wide cache of GlobalConfig::fts_query_cache_bytes() bytes.
+  static FtsQueryCache &Instance();
+
+  //! A scope id never handed out before (never 0).
+  static uint64_t NewScope();
+
+  /*! Normalized text of a query on \p field_name: children of AND / OR in
+   *  canonical order, so operand order does not matter, followed by whether
+   *  \p params scores with collection statistics, and its anytime limits.
+   */
+  static std::string QueryKey(const std::string &field_name,
+                              const FtsAstNode &ast,
+                              const FtsQueryParams &params);
+
+  /*! Statistics epoch of \p params: the collection statistics of the query
+   *  terms, which are all that moves the scores of a sealed segment.  Taken
+   *  verbatim rather than hashed, so equal epochs always mean equal scores;
+   *  empty when the segment scores with its own statistics.
+   */
+  static std::string StatsEpoch(const FtsQueryParams &params);
+
+  explicit FtsQueryCache(size_t capacity);
+  ~FtsQueryCache();
+
+  FtsQueryCache(const FtsQueryCache &) = delete;
+  FtsQueryCache &operator=(const FtsQueryCache &) = delete;
+
+  //! Copy the results cached under \p key at \p epoch into \p results.
+  //! An entry of another epoch is dropped.
+  //! \return false on a miss
+  bool get(const Key &key, const Epoch &epoch,
+           std::vector<FtsResult> *results);
+
+  //! Cache \p results under \p key, replacing the entry of any epoch and
+  //! evicting least recently used entries.
+  void put(const Key &key, const Epoch &epoch,
+           const std::vector<FtsResult> &results);
+
+  //! Drop every entry of \p scope.
+  void erase_scope(uint64_t scope);
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  //! Bytes charged for the cached entries.
+  size_t size_in_bytes() const {
+    return charged_.load(std::memory_order_relaxed);
+  }
+
+  size_t count() const;
+
+  uint64_t hit_count() const {
+    return hits_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t miss_count() const {
+    return misses_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    uint64_t scope{0};
+    Epoch epoch;
+    std::vector<FtsResult> results;
+    size_t charge{0};
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    // Most recently used first.
+    std::list<Entry> lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t size{0};
+  };
+
+  static constexpr uint32_t kShardCount = 16;
+
+  // Key fields packed into one string: scope, topk, query.
+  static std::string Encode(const Key &key);
+
+  Shard &shard(const std::string &encoded);
+  // Unlink \p it from \p s and release its charge.
+  void erase(Shard &s, std::list<Entry>::iterator it);
+
+  size_t capacity_{0};
+  size_t shard_capacity_{0};
+  Shard shards_[kShardCount];
+  std::atomic<size_t> charged_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace zvec::fts
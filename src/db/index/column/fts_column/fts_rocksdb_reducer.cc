@@ -14,6 +14,7 @@
 
 #include "fts_rocksdb_reducer.h"
 #include <cstring>
+#include <iterator>
 #include <vector>
 #include <zvec/ailego/logger/logger.h>
 #include <zvec/db/status.h>
@@ -47,7 +48,8 @@ inline uint32_t dense_rank(uint64_t scan_pos, const roaring::Roaring &bitmap) {
 // Immutable FTS segment CFs:
 //   - postings_cf   : term -> BitPacked posting (inline tf/doc_len/max_score)
 //   - positions_cf  : term\0doc_id -> varint delta positions (phrase queries)
-//   - stat_cf       : field_total_docs / field_total_tokens
+//   - stat_cf       : field_total_docs / field_total_tokens /
+//                     field_phrase_shingles
 //
 // Multi-way merge N source segments into one destination, in two passes.
 // All input postings must be BitPacked; output is BitPacked too — no
@@ -105,6 +107,7 @@ Result<void> FtsRocksdbReducer::cleanup() {
   src_postings_cfs_.clear();
   src_positions_cfs_.clear();
   scan_offset_per_seg_.clear();
+  complete_shingles_.clear();
   num_segments_ = 0;
   state_ = STATE_UNINITED;
   return {};
@@ -113,7 +116,8 @@ Result<void> FtsRocksdbReducer::cleanup() {
 Result<void> FtsRocksdbReducer::feed(
     FtsSegmentStats segment_stats, RocksdbContext *src_ctx,
     rocksdb::ColumnFamilyHandle *src_postings_cf,
-    rocksdb::ColumnFamilyHandle *src_positions_cf) {
+    rocksdb::ColumnFamilyHandle *src_positions_cf,
+    const std::unordered_set<std::string> &complete_shingles) {
   if (state_ != STATE_INITED && state_ != STATE_FEED) {
     return tl::make_unexpected(Status::InternalError(
         "FtsRocksdbReducer: call init() before feed(). field=", field_name_));
@@ -143,6 +147,18 @@ Result<void> FtsRocksdbReducer::feed(
         field_name_));
   }
 
+  // A shingle missing from one source is missing for its docs in the
+  // merged postings too.
+  if (num_segments_ == 0) {
+    complete_shingles_ = complete_shingles;
+  } else {
+    for (auto it = complete_shingles_.begin();
+         it != complete_shingles_.end();) {
+      it = complete_shingles.count(*it) != 0 ? std::next(it)
+                                             : complete_shingles_.erase(it);
+    }
+  }
+
   segment_stats_.emplace_back(std::move(segment_stats));
   src_ctxs_.emplace_back(src_ctx);
   src_postings_cfs_.emplace_back(src_postings_cf);
@@ -488,6 +504,16 @@ Result<void> FtsRocksdbReducer::flush_stat(uint64_t total_docs,
         field_name_));
   }
 
+  if (!ctx_->db_
+           ->Put(ctx_->write_opts_, dst_stat_cf_,
+                 make_phrase_shingles_key(field_name_),
+                 encode_shingle_set(complete_shingles_))
+           .ok()) {
+    return tl::make_unexpected(Status::InternalError(
+        "FtsRocksdbReducer: failed to write phrase shingles. field=",
+        field_name_));
+  }
+
   return {};
 }
 
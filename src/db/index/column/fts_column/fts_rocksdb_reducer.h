@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <roaring.hh>
 #include <zvec/db/status.h>
@@ -59,11 +60,15 @@ class FtsRocksdbReducer {
    *  \param src_ctx             RocksdbContext owning the source CFs
    *  \param src_postings_cf     Source postings CF (must be BitPacked)
    *  \param src_positions_cf    Source positions CF
+   *  \param complete_shingles   Phrase shingles indexed for every doc of the
+   *      source; the destination keeps those common to all sources
    *  \return Result<void> on success, or Status on failure
    */
-  Result<void> feed(FtsSegmentStats segment_stats, RocksdbContext *src_ctx,
-                    rocksdb::ColumnFamilyHandle *src_postings_cf,
-                    rocksdb::ColumnFamilyHandle *src_positions_cf);
+  Result<void> feed(
+      FtsSegmentStats segment_stats, RocksdbContext *src_ctx,
+      rocksdb::ColumnFamilyHandle *src_postings_cf,
+      rocksdb::ColumnFamilyHandle *src_positions_cf,
+      const std::unordered_set<std::string> &complete_shingles = {});
 
   /*! Merge fed segments into the destination: per-term BitPacked postings
    *  to dst_postings_cf, doc_ids remapped to the new segment's dense space,
@@ -144,6 +149,10 @@ class FtsRocksdbReducer {
   uint64_t effective_total_docs_{0};
   uint64_t effective_total_tokens_{0};
 
+  // Phrase shingles complete in every non-empty source, written to dst
+  // stat_cf next to the stats.
+  std::unordered_set<std::string> complete_shingles_{};
+
   // Precomputed cumsum: scan_offset_per_seg_[i] = Σ_{j<i} stats_j.doc_count.
   std::vector<uint64_t> scan_offset_per_seg_{};
 
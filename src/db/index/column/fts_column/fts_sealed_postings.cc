@@ -0,0 +1,1130 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fts_sealed_postings.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <zvec/ailego/logger/logger.h>
+#include <zvec/ailego/utility/string_helper.h>
+#include "db/common/file_helper.h"
+#include "posting/bitpacked_posting_list.h"
+#include "posting/bitpacked_simd_dispatch.h"
+#include "fts_utils.h"
+
+namespace zvec::fts {
+
+namespace {
+
+constexpr uint32_t kDictMagic = 0x44535446;       // "FTSD"
+constexpr uint32_t kPostingsMagic = 0x50535446;   // "FTSP"
+constexpr uint32_t kPositionsMagic = 0x58535446;  // "FTSX"
+constexpr uint32_t kImpactsMagic = 0x49535446;    // "FTSI"
+// 2: block-packed positions with skip entries.
+// 3: optional impacts file.
+constexpr uint32_t kFormatVersion = 3;
+
+constexpr size_t kPostingsAlign = 16;
+constexpr size_t kPositionsAlign = 16;
+constexpr size_t kImpactsAlign = 16;
+constexpr size_t kWriteBufferSize = 1 << 20;
+
+// Dictionary file: header, front-coded entries, uint32 restart offsets.
+struct DictHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_terms;
+  uint32_t num_restarts;
+  uint64_t entries_size;
+  uint64_t postings_file_size;
+  uint64_t positions_file_size;
+  uint64_t impacts_file_size;  // 0: written without impacts
+};
+
+// Postings / positions files: this header, then the aligned payloads.
+struct DataHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t reserved;
+};
+
+// Positions section of one term: this header, a skip entry per block, then
+// the blocks.  Blocks and their packed arrays start 16-byte aligned, as the
+// section itself does, so full chunks unpack straight from the mapping.
+struct PositionsHeader {
+  uint32_t num_docs;
+  uint32_t num_blocks;
+};
+
+struct PositionSkip {
+  uint32_t last_doc_id;
+  uint32_t offset;  // of the block, from the section start
+};
+
+// Positions block: this header, a PositionChunk per chunk of the position
+// stream, then the packed doc_id deltas, the packed (freq - 1)s and the
+// packed chunks.  The stream holds each doc's first position followed by
+// its position deltas, docs back to back.
+struct PositionBlockHeader {
+  uint32_t first_doc_id;
+  uint32_t num_docs;
+  uint32_t num_positions;
+  uint8_t doc_bitwidth;
+  uint8_t freq_bitwidth;
+  uint16_t reserved;
+};
+
+struct PositionChunk {
+  uint32_t offset;  // from the block start
+  uint32_t bitwidth;
+};
+
+// Impacts section of one term: this header, a segment entry per distinct
+// impact (descending), then the segments.  A segment is a run of blocks of
+// up to kBlockSize doc_ids: an ImpactBlockHeader padded to kBlockAlign,
+// then the packed doc_id deltas.
+struct ImpactsHeader {
+  uint32_t num_segments;
+  uint32_t max_doc_id;
+};
+
+struct ImpactSegmentEntry {
+  uint32_t impact;
+  uint32_t num_docs;
+  uint32_t offset;  // of the first block, from the section start
+};
+
+struct ImpactBlockHeader {
+  uint32_t first_doc_id;
+  uint32_t bitwidth;
+};
+
+constexpr size_t kBlockAlign = 16;
+constexpr uint32_t kBlockSize = FtsSealedPostings::kPositionBlockSize;
+static_assert(kBlockSize == BitPackedPostingList::DOCS_PER_BLOCK,
+              "positions blocks must fit the bit-packing primitives");
+
+const char *kDictSuffix = ".fts.dict";
+const char *kPostingsSuffix = ".fts.postings";
+const char *kPositionsSuffix = ".fts.positions";
+const char *kImpactsSuffix = ".fts.impacts";
+const char *kTempSuffix = ".tmp";
+
+std::string sealed_file_path(const std::string &dir,
+                             const std::string &field_name,
+                             const char *suffix) {
+  return ailego::FileHelper::PathJoin(
+      dir, ailego::StringHelper::Concat(field_name, suffix));
+}
+
+void append_varint(uint64_t value, std::string *output) {
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+bool read_varint(const char **p, const char *end, uint64_t *value) {
+  uint64_t result = 0;
+  for (uint32_t shift = 0; shift < 64 && *p < end; shift += 7) {
+    const auto byte = static_cast<uint8_t>(*(*p)++);
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline uint32_t load_u32(const char *p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline size_t align_up(size_t size, size_t align) {
+  return (size + align - 1) / align * align;
+}
+
+inline uint32_t num_chunks(uint32_t num_positions) {
+  return (num_positions + kBlockSize - 1) / kBlockSize;
+}
+
+// Bit-pack \p count (<= kBlockSize) values onto \p out and pad it to
+// kBlockAlign.
+void append_packed(const uint32_t *values, uint32_t count, uint8_t bitwidth,
+                   std::string *out) {
+  alignas(16) uint8_t packed[kBlockSize * sizeof(uint32_t)];
+  BitPackedPostingList::pack_uint32(values, bitwidth, count, packed);
+  out->append(reinterpret_cast<const char *>(packed),
+              BitPackedPostingList::packed_byte_size(bitwidth, count));
+  out->resize(align_up(out->size(), kBlockAlign), '\0');
+}
+
+uint8_t max_bitwidth(const uint32_t *values, uint32_t count) {
+  uint32_t max_value = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    max_value = std::max(max_value, values[i]);
+  }
+  return BitPackedPostingList::bits_needed(max_value);
+}
+
+void release_pin(void *arg1, void * /*arg2*/) {
+  delete static_cast<FtsSealedPostings::Ptr *>(arg1);
+}
+
+}  // namespace
+
+// ============================================================
+// Writer
+// ============================================================
+
+bool FtsSealedPostings::Writer::OutputFile::append(const void *data,
+                                                   size_t bytes, size_t align,
+                                                   uint64_t *offset) {
+  const size_t padding = (align - size % align) % align;
+  buffer.append(padding, '\0');
+  size += padding;
+  if (offset) {
+    *offset = size;
+  }
+  buffer.append(static_cast<const char *>(data), bytes);
+  size += bytes;
+  return buffer.size() < kWriteBufferSize || drain();
+}
+
+bool FtsSealedPostings::Writer::OutputFile::drain() {
+  if (buffer.empty()) {
+    return true;
+  }
+  const bool ok = file.write(buffer.data(), buffer.size()) == buffer.size();
+  buffer.clear();
+  return ok;
+}
+
+FtsSealedPostings::Writer::Writer(const std::string &dir,
+                                  const std::string &field_name)
+    : dir_(dir), field_name_(field_name) {
+  dict_.path = sealed_file_path(dir, field_name, kDictSuffix);
+  postings_.path = sealed_file_path(dir, field_name, kPostingsSuffix);
+  positions_.path = sealed_file_path(dir, field_name, kPositionsSuffix);
+  impacts_.path = sealed_file_path(dir, field_name, kImpactsSuffix);
+}
+
+FtsSealedPostings::Writer::~Writer() {
+  if (opened_) {
+    abort();
+  }
+}
+
+std::vector<FtsSealedPostings::Writer::OutputFile *>
+FtsSealedPostings::Writer::outputs() {
+  // Renamed in this order by finish(): the dictionary last.
+  if (impact_scorer_) {
+    return {&postings_, &positions_, &impacts_, &dict_};
+  }
+  return {&postings_, &positions_, &dict_};
+}
+
+Status FtsSealedPostings::Writer::open() {
+  for (auto *out : outputs()) {
+    if (!out->file.create(out->path + kTempSuffix, 0)) {
+      abort();
+      return Status::InternalError("FtsSealedPostings: create failed: ",
+                                   out->path, kTempSuffix);
+    }
+  }
+  opened_ = true;
+
+  DataHeader header{kPostingsMagic, kFormatVersion, 0};
+  postings_.append(&header, sizeof(header), 1, nullptr);
+  header.magic = kPositionsMagic;
+  positions_.append(&header, sizeof(header), 1, nullptr);
+  if (impact_scorer_) {
+    header.magic = kImpactsMagic;
+    impacts_.append(&header, sizeof(header), 1, nullptr);
+  }
+  return Status::OK();
+}
+
+Status FtsSealedPostings::Writer::add_term(std::string_view term,
+                                           const rocksdb::Slice &postings) {
+  if (!opened_) {
+    return Status::InternalError("FtsSealedPostings: writer not opened");
+  }
+  if (num_terms_ > 0 && term <= std::string_view(last_term_)) {
+    return Status::InvalidArgument(
+        "FtsSealedPostings: terms out of order. field=", field_name_);
+  }
+  if (!BitPackedPostingList::is_bitpacked_format(postings.data(),
+                                                 postings.size())) {
+    return Status::InvalidArgument(
+        "FtsSealedPostings: posting is not BitPacked. field=", field_name_,
+        " term=", std::string(term));
+  }
+  if (has_term_) {
+    auto s = finish_term();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  if (num_terms_ % kRestartInterval == 0) {
+    restarts_.push_back(static_cast<uint32_t>(dict_entries_.size()));
+    term_shared_ = 0;
+  } else {
+    const size_t limit = std::min(term.size(), last_term_.size());
+    size_t shared = 0;
+    while (shared < limit && term[shared] == last_term_[shared]) {
+      ++shared;
+    }
+    term_shared_ = static_cast<uint32_t>(shared);
+  }
+  last_term_.assign(term.data(), term.size());
+  ++num_terms_;
+
+  term_postings_size_ = static_cast<uint32_t>(postings.size());
+  if (!postings_.append(postings.data(), postings.size(), kPostingsAlign,
+                        &term_postings_offset_)) {
+    return Status::InternalError("FtsSealedPostings: write postings failed: ",
+                                 postings_.path);
+  }
+  term_impacts_offset_ = 0;
+  term_impacts_size_ = 0;
+  if (impact_scorer_) {
+    if (!write_impacts(postings, &term_impacts_offset_)) {
+      return Status::InternalError("FtsSealedPostings: write impacts failed: ",
+                                   impacts_.path);
+    }
+    if (term_impacts_offset_ != 0) {
+      term_impacts_size_ =
+          static_cast<uint32_t>(impacts_.size - term_impacts_offset_);
+    }
+  }
+  has_term_ = true;
+  return Status::OK();
+}
+
+Status FtsSealedPostings::Writer::add_positions(
+    uint32_t doc_id, const rocksdb::Slice &positions) {
+  if (!has_term_) {
+    return Status::InternalError("FtsSealedPostings: positions without term");
+  }
+  if (!term_doc_ids_.empty() && doc_id <= term_doc_ids_.back()) {
+    return Status::InvalidArgument(
+        "FtsSealedPostings: positions out of order. field=", field_name_);
+  }
+  const size_t begin = term_positions_.size();
+  const char *p = positions.data();
+  const char *end = p + positions.size();
+  while (p < end) {
+    uint64_t delta = 0;
+    if (!read_varint(&p, end, &delta) ||
+        delta > std::numeric_limits<uint32_t>::max()) {
+      term_positions_.resize(begin);
+      return Status::InvalidArgument(
+          "FtsSealedPostings: malformed positions. field=", field_name_,
+          " doc_id=", doc_id);
+    }
+    term_positions_.push_back(static_cast<uint32_t>(delta));
+  }
+  if (term_positions_.size() == begin) {
+    // No positions: leave the doc out, so a phrase never matches it.
+    return Status::OK();
+  }
+  term_doc_ids_.push_back(doc_id);
+  term_freqs_.push_back(static_cast<uint32_t>(term_positions_.size() - begin));
+  return Status::OK();
+}
+
+bool FtsSealedPostings::Writer::write_positions(uint64_t *offset) {
+  const auto num_docs = static_cast<uint32_t>(term_doc_ids_.size());
+  const uint32_t num_blocks = (num_docs + kBlockSize - 1) / kBlockSize;
+  std::vector<PositionSkip> skips(num_blocks);
+
+  std::string section(
+      align_up(sizeof(PositionsHeader) + num_blocks * sizeof(PositionSkip),
+               kBlockAlign),
+      '\0');
+  alignas(16) uint32_t values[kBlockSize];
+  size_t stream_begin = 0;
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    const uint32_t start = b * kBlockSize;
+    const uint32_t n = std::min(kBlockSize, num_docs - start);
+    const uint32_t *doc_ids = term_doc_ids_.data() + start;
+    const uint32_t *freqs = term_freqs_.data() + start;
+
+    PositionBlockHeader header{};
+    header.first_doc_id = doc_ids[0];
+    header.num_docs = n;
+    for (uint32_t j = 0; j < n; ++j) {
+      header.num_positions += freqs[j];
+    }
+    const uint32_t chunks = num_chunks(header.num_positions);
+
+    const size_t block_start = section.size();
+    skips[b] = {doc_ids[n - 1], static_cast<uint32_t>(block_start)};
+    section.resize(
+        block_start + align_up(sizeof(header) + chunks * sizeof(PositionChunk),
+                               kBlockAlign),
+        '\0');
+
+    values[0] = 0;
+    for (uint32_t j = 1; j < n; ++j) {
+      values[j] = doc_ids[j] - doc_ids[j - 1];
+    }
+    header.doc_bitwidth = max_bitwidth(values, n);
+    append_packed(values, n, header.doc_bitwidth, &section);
+
+    for (uint32_t j = 0; j < n; ++j) {
+      values[j] = freqs[j] - 1;
+    }
+    header.freq_bitwidth = max_bitwidth(values, n);
+    append_packed(values, n, header.freq_bitwidth, &section);
+
+    std::vector<PositionChunk> chunk_metas(chunks);
+    for (uint32_t c = 0; c < chunks; ++c) {
+      const uint32_t count =
+          std::min(kBlockSize, header.num_positions - c * kBlockSize);
+      const uint32_t *stream =
+          term_positions_.data() + stream_begin + c * kBlockSize;
+      const uint8_t bitwidth = max_bitwidth(stream, count);
+      chunk_metas[c] = {static_cast<uint32_t>(section.size() - block_start),
+                        bitwidth};
+      append_packed(stream, count, bitwidth, &section);
+    }
+    stream_begin += header.num_positions;
+
+    std::memcpy(&section[block_start], &header, sizeof(header));
+    if (chunks > 0) {
+      std::memcpy(&section[block_start + sizeof(header)], chunk_metas.data(),
+                  chunks * sizeof(PositionChunk));
+    }
+  }
+
+  const PositionsHeader header{num_docs, num_blocks};
+  std::memcpy(&section[0], &header, sizeof(header));
+  std::memcpy(&section[sizeof(header)], skips.data(),
+              num_blocks * sizeof(PositionSkip));
+  return positions_.append(section.data(), section.size(), kPositionsAlign,
+                           offset);
+}
+
+bool FtsSealedPostings::Writer::write_impacts(const rocksdb::Slice &postings,
+                                              uint64_t *offset) {
+  BitPackedPostingIterator iter;
+  if (iter.open(postings.data(), postings.size()) != 0) {
+    return false;
+  }
+  // Ceil keeps the impact an upper bound of the weight it stands for.
+  const float scale = kMaxImpact / (impact_scorer_->params().k1 + 1.0f);
+  impact_docs_.resize(kMaxImpact + 1);
+  uint32_t max_doc_id = 0;
+  for (uint32_t doc_id = iter.next_doc();
+       doc_id != BitPackedPostingIterator::NO_MORE_DOCS;
+       doc_id = iter.next_doc()) {
+    const float weight = impact_scorer_->score_with_idf(
+        1.0f, iter.term_freq(), iter.doc_len());
+    const auto impact = static_cast<uint32_t>(std::min(
+        std::max(std::ceil(weight * scale), 1.0f), float{kMaxImpact}));
+    impact_docs_[impact].push_back(doc_id);
+    max_doc_id = doc_id;
+  }
+
+  std::vector<ImpactSegmentEntry> segments;
+  for (uint32_t impact = kMaxImpact; impact > 0; --impact) {
+    if (!impact_docs_[impact].empty()) {
+      segments.push_back(
+          {impact, static_cast<uint32_t>(impact_docs_[impact].size()), 0});
+    }
+  }
+  if (segments.empty()) {
+    *offset = 0;
+    return true;
+  }
+
+  std::string section(
+      align_up(sizeof(ImpactsHeader) +
+                   segments.size() * sizeof(ImpactSegmentEntry),
+               kBlockAlign),
+      '\0');
+  alignas(16) uint32_t values[kBlockSize];
+  for (auto &segment : segments) {
+    std::vector<uint32_t> &doc_ids = impact_docs_[segment.impact];
+    segment.offset = static_cast<uint32_t>(section.size());
+    for (uint32_t start = 0; start < segment.num_docs; start += kBlockSize) {
+      const uint32_t n = std::min(kBlockSize, segment.num_docs - start);
+      values[0] = 0;
+      for (uint32_t j = 1; j < n; ++j) {
+        values[j] = doc_ids[start + j] - doc_ids[start + j - 1];
+      }
+      const ImpactBlockHeader header{doc_ids[start], max_bitwidth(values, n)};
+      section.append(reinterpret_cast<const char *>(&header), sizeof(header));
+      section.resize(align_up(section.size(), kBlockAlign), '\0');
+      append_packed(values, n, static_cast<uint8_t>(header.bitwidth),
+                    &section);
+    }
+    doc_ids.clear();
+  }
+
+  const ImpactsHeader header{static_cast<uint32_t>(segments.size()),
+                             max_doc_id};
+  std::memcpy(&section[0], &header, sizeof(header));
+  std::memcpy(&section[sizeof(header)], segments.data(),
+              segments.size() * sizeof(ImpactSegmentEntry));
+  return impacts_.append(section.data(), section.size(), kImpactsAlign,
+                         offset);
+}
+
+Status FtsSealedPostings::Writer::finish_term() {
+  uint64_t positions_offset = 0;
+  uint32_t positions_size = 0;
+  if (!term_doc_ids_.empty()) {
+    if (!write_positions(&positions_offset)) {
+      return Status::InternalError(
+          "FtsSealedPostings: write positions failed: ", positions_.path);
+    }
+    positions_size = static_cast<uint32_t>(positions_.size - positions_offset);
+  }
+
+  append_varint(term_shared_, &dict_entries_);
+  append_varint(last_term_.size() - term_shared_, &dict_entries_);
+  dict_entries_.append(last_term_, term_shared_, std::string::npos);
+  append_varint(term_postings_offset_, &dict_entries_);
+  append_varint(term_postings_size_, &dict_entries_);
+  append_varint(positions_offset, &dict_entries_);
+  append_varint(positions_size, &dict_entries_);
+  append_varint(term_impacts_offset_, &dict_entries_);
+  append_varint(term_impacts_size_, &dict_entries_);
+
+  term_doc_ids_.clear();
+  term_freqs_.clear();
+  term_positions_.clear();
+  has_term_ = false;
+  return Status::OK();
+}
+
+Status FtsSealedPostings::Writer::finish() {
+  if (!opened_) {
+    return Status::InternalError("FtsSealedPostings: writer not opened");
+  }
+  if (has_term_) {
+    auto s = finish_term();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+
+  DictHeader header{kDictMagic,
+                    kFormatVersion,
+                    num_terms_,
+                    static_cast<uint32_t>(restarts_.size()),
+                    dict_entries_.size(),
+                    postings_.size,
+                    positions_.size,
+                    impact_scorer_ ? impacts_.size : 0};
+  bool ok = dict_.append(&header, sizeof(header), 1, nullptr) &&
+            dict_.append(dict_entries_.data(), dict_entries_.size(), 1,
+                         nullptr) &&
+            dict_.append(restarts_.data(), restarts_.size() * sizeof(uint32_t),
+                         1, nullptr);
+  for (auto *out : outputs()) {
+    ok = ok && out->drain() && out->file.flush();
+    out->file.close();
+  }
+  // The dictionary goes last: its presence marks a complete set.
+  for (auto *out : outputs()) {
+    ok = ok && ailego::File::Rename(out->path + kTempSuffix, out->path);
+  }
+  if (!ok) {
+    abort();
+    return Status::InternalError("FtsSealedPostings: finish failed. field=",
+                                 field_name_);
+  }
+  opened_ = false;
+  return Status::OK();
+}
+
+void FtsSealedPostings::Writer::abort() {
+  for (auto *out : outputs()) {
+    out->file.close();
+    out->buffer.clear();
+    ailego::File::Delete(out->path + kTempSuffix);
+  }
+  opened_ = false;
+}
+
+// ============================================================
+// Build / file management
+// ============================================================
+
+Status FtsSealedPostings::Build(const std::string &dir,
+                                const std::string &field_name,
+                                RocksdbContext *ctx,
+                                rocksdb::ColumnFamilyHandle *postings_cf,
+                                rocksdb::ColumnFamilyHandle *positions_cf,
+                                const BM25Scorer *impact_scorer) {
+  if (!ctx || !postings_cf || !positions_cf) {
+    return Status::InvalidArgument(
+        "FtsSealedPostings::Build: null ctx or CF. field=", field_name);
+  }
+
+  Writer writer(dir, field_name);
+  if (impact_scorer) {
+    writer.enable_impacts(impact_scorer);
+  }
+  auto s = writer.open();
+  if (!s.ok()) {
+    return s;
+  }
+
+  // Both CFs iterate in byte order and a $POS key is term + '\0' + doc_id,
+  // so the positions of every term follow in the same order as the terms.
+  std::unique_ptr<rocksdb::Iterator> term_iter(
+      ctx->db_->NewIterator(ctx->read_opts_, postings_cf));
+  std::unique_ptr<rocksdb::Iterator> pos_iter(
+      ctx->db_->NewIterator(ctx->read_opts_, positions_cf));
+  pos_iter->SeekToFirst();
+
+  std::string pos_term;
+  uint32_t pos_doc_id = 0;
+  bool pos_valid = false;
+  auto parse_pos = [&]() {
+    pos_valid = pos_iter->Valid() &&
+                parse_doc_term_key(pos_iter->key().ToString(), &pos_term,
+                                   &pos_doc_id);
+  };
+  parse_pos();
+
+  for (term_iter->SeekToFirst(); term_iter->Valid(); term_iter->Next()) {
+    const rocksdb::Slice key = term_iter->key();
+    const std::string_view term(key.data(), key.size());
+    s = writer.add_term(term, term_iter->value());
+    if (!s.ok()) {
+      return s;
+    }
+    // Skip positions of terms without postings, then take this term's.
+    while (pos_valid && std::string_view(pos_term) < term) {
+      pos_iter->Next();
+      parse_pos();
+    }
+    while (pos_valid && std::string_view(pos_term) == term) {
+      s = writer.add_positions(pos_doc_id, pos_iter->value());
+      if (!s.ok()) {
+        return s;
+      }
+      pos_iter->Next();
+      parse_pos();
+    }
+  }
+  if (!term_iter->status().ok() || !pos_iter->status().ok()) {
+    return Status::InternalError(
+        "FtsSealedPostings::Build: scan failed. field=", field_name,
+        " status=",
+        (term_iter->status().ok() ? pos_iter->status() : term_iter->status())
+            .ToString());
+  }
+
+  return writer.finish();
+}
+
+bool FtsSealedPostings::Exists(const std::string &dir,
+                               const std::string &field_name) {
+  return ailego::File::IsExist(sealed_file_path(dir, field_name, kDictSuffix));
+}
+
+void FtsSealedPostings::Remove(const std::string &dir,
+                               const std::string &field_name) {
+  // Dictionary first, so a crash mid-way never leaves a dangling one.
+  for (const char *suffix :
+       {kDictSuffix, kPostingsSuffix, kPositionsSuffix, kImpactsSuffix}) {
+    const auto path = sealed_file_path(dir, field_name, suffix);
+    if (ailego::File::IsExist(path)) {
+      ailego::File::Delete(path);
+    }
+  }
+}
+
+Status FtsSealedPostings::Link(const std::string &src_dir,
+                               const std::string &dst_dir,
+                               const std::string &field_name) {
+  // The files never change once written, so a hard link is a valid copy.
+  for (const char *suffix :
+       {kPostingsSuffix, kPositionsSuffix, kImpactsSuffix, kDictSuffix}) {
+    const auto src = sealed_file_path(src_dir, field_name, suffix);
+    const auto dst = sealed_file_path(dst_dir, field_name, suffix);
+    if (suffix == kImpactsSuffix && !ailego::File::IsExist(src)) {
+      continue;
+    }
+    std::error_code ec;
+    std::filesystem::create_hard_link(ailego::FileHelper::PathFromUtf8(src),
+                                      ailego::FileHelper::PathFromUtf8(dst),
+                                      ec);
+    if (ec && !FileHelper::CopyFile(src, dst)) {
+      Remove(dst_dir, field_name);
+      return Status::InternalError("FtsSealedPostings::Link: failed to link [",
+                                   src, "] to [", dst, "]");
+    }
+  }
+  return Status::OK();
+}
+
+// ============================================================
+// Reader
+// ============================================================
+
+FtsSealedPostings::Ptr FtsSealedPostings::Open(const std::string &dir,
+                                               const std::string &field_name) {
+  if (!Exists(dir, field_name)) {
+    return nullptr;
+  }
+  auto sealed = std::make_shared<FtsSealedPostings>();
+  if (!sealed->load(dir, field_name)) {
+    LOG_WARN(
+        "FtsSealedPostings: invalid sealed files, falling back to RocksDB. "
+        "dir[%s] field[%s]",
+        dir.c_str(), field_name.c_str());
+    return nullptr;
+  }
+  return sealed;
+}
+
+bool FtsSealedPostings::load(const std::string &dir,
+                             const std::string &field_name) {
+  if (!dict_map_.open(sealed_file_path(dir, field_name, kDictSuffix), true) ||
+      !postings_map_.open(sealed_file_path(dir, field_name, kPostingsSuffix),
+                          true) ||
+      !positions_map_.open(sealed_file_path(dir, field_name, kPositionsSuffix),
+                           true)) {
+    return false;
+  }
+
+  if (dict_map_.size() < sizeof(DictHeader)) {
+    return false;
+  }
+  DictHeader header;
+  std::memcpy(&header, dict_map_.region(), sizeof(header));
+  if (header.impacts_file_size != 0 &&
+      !impacts_map_.open(sealed_file_path(dir, field_name, kImpactsSuffix),
+                         true)) {
+    return false;
+  }
+  if (header.magic != kDictMagic || header.version != kFormatVersion ||
+      header.postings_file_size != postings_map_.size() ||
+      header.impacts_file_size != impacts_map_.size() ||
+      header.positions_file_size != positions_map_.size() ||
+      sizeof(header) + header.entries_size +
+              uint64_t{header.num_restarts} * sizeof(uint32_t) !=
+          dict_map_.size()) {
+    return false;
+  }
+  for (const auto *map : {&postings_map_, &positions_map_, &impacts_map_}) {
+    if (map == &impacts_map_ && header.impacts_file_size == 0) {
+      continue;
+    }
+    DataHeader data_header;
+    if (map->size() < sizeof(data_header)) {
+      return false;
+    }
+    std::memcpy(&data_header, map->region(), sizeof(data_header));
+    const uint32_t magic = map == &postings_map_    ? kPostingsMagic
+                           : map == &positions_map_ ? kPositionsMagic
+                                                    : kImpactsMagic;
+    if (data_header.magic != magic || data_header.version != kFormatVersion) {
+      return false;
+    }
+  }
+
+  const char *base = static_cast<const char *>(dict_map_.region());
+  entries_ = base + sizeof(header);
+  entries_size_ = header.entries_size;
+  restarts_ = entries_ + entries_size_;
+  num_restarts_ = header.num_restarts;
+  num_terms_ = header.num_terms;
+  return true;
+}
+
+bool FtsSealedPostings::find(std::string_view term, TermEntry *entry) const {
+  if (num_restarts_ == 0) {
+    return false;
+  }
+  const char *end = entries_ + entries_size_;
+
+  // Restart entries store the whole term (shared == 0).
+  auto restart_key = [&](uint32_t r, std::string_view *key) {
+    const uint32_t offset = load_u32(restarts_ + r * sizeof(uint32_t));
+    if (offset >= entries_size_) {
+      return false;
+    }
+    const char *p = entries_ + offset;
+    uint64_t shared = 0;
+    uint64_t unshared = 0;
+    if (!read_varint(&p, end, &shared) ||
+        !read_varint(&p, end, &unshared) ||
+        unshared > static_cast<uint64_t>(end - p)) {
+      return false;
+    }
+    *key = std::string_view(p, unshared);
+    return true;
+  };
+
+  // Last restart whose key is <= term.
+  std::string_view key;
+  if (!restart_key(0, &key) || term < key) {
+    return false;
+  }
+  uint32_t lo = 0;
+  uint32_t hi = num_restarts_ - 1;
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo + 1) / 2;
+    if (!restart_key(mid, &key)) {
+      return false;
+    }
+    if (key <= term) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  const char *p = entries_ + load_u32(restarts_ + lo * sizeof(uint32_t));
+  const char *run_end =
+      lo + 1 < num_restarts_
+          ? entries_ + load_u32(restarts_ + (lo + 1) * sizeof(uint32_t))
+          : end;
+  std::string current;
+  while (p < run_end) {
+    uint64_t shared = 0;
+    uint64_t unshared = 0;
+    if (!read_varint(&p, end, &shared) || !read_varint(&p, end, &unshared) ||
+        shared > current.size() || unshared > static_cast<uint64_t>(end - p)) {
+      return false;
+    }
+    current.resize(shared);
+    current.append(p, unshared);
+    p += unshared;
+
+    uint64_t fields[6];
+    for (auto &field : fields) {
+      if (!read_varint(&p, end, &field)) {
+        return false;
+      }
+    }
+    const int cmp = std::string_view(current).compare(term);
+    if (cmp == 0) {
+      entry->postings_offset = fields[0];
+      entry->postings_size = static_cast<uint32_t>(fields[1]);
+      entry->positions_offset = fields[2];
+      entry->positions_size = static_cast<uint32_t>(fields[3]);
+      entry->impacts_offset = fields[4];
+      entry->impacts_size = static_cast<uint32_t>(fields[5]);
+      return true;
+    }
+    if (cmp > 0) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool FtsSealedPostings::get_postings(std::string_view term,
+                                     rocksdb::PinnableSlice *out) const {
+  TermEntry entry;
+  if (!find(term, &entry) ||
+      entry.postings_offset + entry.postings_size > postings_map_.size()) {
+    return false;
+  }
+  const char *data =
+      static_cast<const char *>(postings_map_.region()) + entry.postings_offset;
+  out->PinSlice(rocksdb::Slice(data, entry.postings_size), release_pin,
+                new Ptr(std::const_pointer_cast<FtsSealedPostings>(
+                    shared_from_this())),
+                nullptr);
+  return true;
+}
+
+FtsSealedPostings::TermPositions FtsSealedPostings::get_positions(
+    std::string_view term) const {
+  TermEntry entry;
+  if (!find(term, &entry) || entry.positions_size == 0 ||
+      entry.positions_offset + entry.positions_size > positions_map_.size()) {
+    return TermPositions{};
+  }
+  const char *data = static_cast<const char *>(positions_map_.region()) +
+                     entry.positions_offset;
+  return TermPositions(rocksdb::Slice(data, entry.positions_size));
+}
+
+FtsSealedPostings::TermImpacts FtsSealedPostings::get_impacts(
+    std::string_view term) const {
+  TermEntry entry;
+  if (!has_impacts() || !find(term, &entry) || entry.impacts_size == 0 ||
+      entry.impacts_offset + entry.impacts_size > impacts_map_.size()) {
+    return TermImpacts{};
+  }
+  const char *data =
+      static_cast<const char *>(impacts_map_.region()) + entry.impacts_offset;
+  return TermImpacts(rocksdb::Slice(data, entry.impacts_size));
+}
+
+FtsSealedPostings::TermImpacts::TermImpacts(const rocksdb::Slice &section) {
+  ImpactsHeader header;
+  if (section.size() < sizeof(header)) {
+    return;
+  }
+  std::memcpy(&header, section.data(), sizeof(header));
+  if (sizeof(header) +
+          uint64_t{header.num_segments} * sizeof(ImpactSegmentEntry) >
+      section.size()) {
+    return;
+  }
+  section_ = section.data();
+  size_ = section.size();
+  num_segments_ = header.num_segments;
+  max_doc_id_ = header.max_doc_id;
+}
+
+FtsSealedPostings::TermImpacts::Segment
+FtsSealedPostings::TermImpacts::segment(uint32_t i) const {
+  ImpactSegmentEntry entry;
+  std::memcpy(&entry,
+              section_ + sizeof(ImpactsHeader) + i * sizeof(ImpactSegmentEntry),
+              sizeof(entry));
+  return {entry.impact, entry.num_docs};
+}
+
+FtsSealedPostings::TermImpacts::DocBlocks
+FtsSealedPostings::TermImpacts::docs(uint32_t i) const {
+  ImpactSegmentEntry entry;
+  std::memcpy(&entry,
+              section_ + sizeof(ImpactsHeader) + i * sizeof(ImpactSegmentEntry),
+              sizeof(entry));
+  DocBlocks blocks;
+  if (entry.offset % kBlockAlign == 0 && entry.offset < size_) {
+    blocks.data_ = section_ + entry.offset;
+    blocks.end_ = section_ + size_;
+    blocks.remaining_ = entry.num_docs;
+  }
+  return blocks;
+}
+
+uint32_t FtsSealedPostings::TermImpacts::DocBlocks::next(uint32_t *doc_ids) {
+  if (remaining_ == 0) {
+    return 0;
+  }
+  const uint32_t n = std::min(kBlockSize, remaining_);
+  const size_t header_size = align_up(sizeof(ImpactBlockHeader), kBlockAlign);
+  ImpactBlockHeader header;
+  if (static_cast<size_t>(end_ - data_) < header_size) {
+    remaining_ = 0;
+    return 0;
+  }
+  std::memcpy(&header, data_, sizeof(header));
+  const auto bitwidth = static_cast<uint8_t>(header.bitwidth);
+  const size_t packed_size =
+      BitPackedPostingList::packed_byte_size(bitwidth, n);
+  if (header.bitwidth > 32 ||
+      static_cast<size_t>(end_ - data_) < header_size + packed_size) {
+    remaining_ = 0;
+    return 0;
+  }
+  BitPackedPostingList::unpack_uint32(
+      reinterpret_cast<const uint8_t *>(data_ + header_size), bitwidth, n,
+      doc_ids);
+  doc_ids[0] = header.first_doc_id;
+  for (uint32_t j = 1; j < n; ++j) {
+    doc_ids[j] += doc_ids[j - 1];
+  }
+  data_ += header_size + align_up(packed_size, kBlockAlign);
+  remaining_ -= n;
+  return n;
+}
+
+FtsSealedPostings::TermPositions::TermPositions(const rocksdb::Slice &section) {
+  PositionsHeader header;
+  if (section.size() < sizeof(header)) {
+    return;
+  }
+  std::memcpy(&header, section.data(), sizeof(header));
+  if (header.num_docs == 0 ||
+      header.num_blocks != (header.num_docs + kBlockSize - 1) / kBlockSize ||
+      sizeof(header) + uint64_t{header.num_blocks} * sizeof(PositionSkip) >
+          section.size()) {
+    return;
+  }
+  section_ = section.data();
+  size_ = section.size();
+  num_blocks_ = header.num_blocks;
+  num_docs_ = header.num_docs;
+}
+
+uint32_t FtsSealedPostings::TermPositions::skip_last_doc(
+    uint32_t block) const {
+  return load_u32(section_ + sizeof(PositionsHeader) +
+                  block * sizeof(PositionSkip));
+}
+
+uint32_t FtsSealedPostings::TermPositions::seek_block(uint32_t doc_id) const {
+  // Resume from the decoded block when the target is not behind it.
+  uint32_t lo = 0;
+  if (block_ != kNoBlock &&
+      (block_ == 0 || skip_last_doc(block_ - 1) < doc_id)) {
+    lo = block_;
+  }
+  // Gallop to bracket the block, then binary-search the bracket.
+  uint32_t hi = lo;
+  for (uint32_t step = 1; hi < num_blocks_ && skip_last_doc(hi) < doc_id;
+       step <<= 1) {
+    lo = hi + 1;
+    hi += step;
+  }
+  hi = std::min(hi, num_blocks_);
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (skip_last_doc(mid) < doc_id) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+bool FtsSealedPostings::TermPositions::load_block(uint32_t block) {
+  block_ = kNoBlock;
+  chunk_ = kNoBlock;
+  const uint32_t offset = load_u32(section_ + sizeof(PositionsHeader) +
+                                   block * sizeof(PositionSkip) +
+                                   sizeof(uint32_t));
+  PositionBlockHeader header;
+  if (offset % kBlockAlign != 0 || uint64_t{offset} + sizeof(header) > size_) {
+    return false;
+  }
+  const char *data = section_ + offset;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.num_docs == 0 || header.num_docs > kBlockSize ||
+      header.doc_bitwidth > 32 || header.freq_bitwidth > 32) {
+    return false;
+  }
+
+  const uint32_t n = header.num_docs;
+  const size_t docs_offset = align_up(
+      sizeof(header) + num_chunks(header.num_positions) * sizeof(PositionChunk),
+      kBlockAlign);
+  const size_t freqs_offset =
+      docs_offset +
+      align_up(BitPackedPostingList::packed_byte_size(header.doc_bitwidth, n),
+               kBlockAlign);
+  const size_t freqs_end =
+      freqs_offset +
+      BitPackedPostingList::packed_byte_size(header.freq_bitwidth, n);
+  if (offset + freqs_end > size_) {
+    return false;
+  }
+
+  BitPackedPostingList::unpack_uint32(
+      reinterpret_cast<const uint8_t *>(data + docs_offset),
+      header.doc_bitwidth, n, doc_ids_);
+  doc_ids_[0] = header.first_doc_id;
+  for (uint32_t j = 1; j < n; ++j) {
+    doc_ids_[j] += doc_ids_[j - 1];
+  }
+  BitPackedPostingList::unpack_uint32(
+      reinterpret_cast<const uint8_t *>(data + freqs_offset),
+      header.freq_bitwidth, n, position_ends_);
+  uint64_t end = 0;
+  for (uint32_t j = 0; j < n; ++j) {
+    end += uint64_t{position_ends_[j]} + 1;
+    position_ends_[j] = static_cast<uint32_t>(end);
+  }
+  if (end != header.num_positions) {
+    return false;
+  }
+
+  block_ = block;
+  block_data_ = data;
+  block_docs_ = n;
+  block_positions_ = header.num_positions;
+  num_chunks_ = num_chunks(header.num_positions);
+  return true;
+}
+
+bool FtsSealedPostings::TermPositions::load_chunk(uint32_t chunk) {
+  chunk_ = kNoBlock;
+  if (chunk >= num_chunks_) {
+    return false;
+  }
+  PositionChunk meta;
+  std::memcpy(&meta,
+              block_data_ + sizeof(PositionBlockHeader) +
+                  chunk * sizeof(PositionChunk),
+              sizeof(meta));
+  const uint32_t count =
+      std::min(kBlockSize, block_positions_ - chunk * kBlockSize);
+  const auto bitwidth = static_cast<uint8_t>(meta.bitwidth);
+  if (meta.bitwidth > 32 || meta.offset % kBlockAlign != 0 ||
+      static_cast<uint64_t>(block_data_ - section_) + meta.offset +
+              BitPackedPostingList::packed_byte_size(bitwidth, count) >
+          size_) {
+    return false;
+  }
+  BitPackedPostingList::unpack_uint32(
+      reinterpret_cast<const uint8_t *>(block_data_ + meta.offset), bitwidth,
+      count, chunk_values_);
+  chunk_ = chunk;
+  return true;
+}
+
+bool FtsSealedPostings::TermPositions::find(uint32_t doc_id,
+                                            std::vector<uint32_t> *positions) {
+  positions->clear();
+  if (num_docs_ == 0) {
+    return false;
+  }
+  const uint32_t block = seek_block(doc_id);
+  if (block == num_blocks_ || (block != block_ && !load_block(block))) {
+    return false;
+  }
+  const size_t idx =
+      simd::get_dispatch().find_first_ge(doc_ids_, block_docs_, doc_id, 0);
+  if (idx == block_docs_ || doc_ids_[idx] != doc_id) {
+    return false;
+  }
+
+  // Only the chunks overlapping this doc's slice of the stream are unpacked.
+  const uint32_t begin = idx == 0 ? 0 : position_ends_[idx - 1];
+  const uint32_t end = position_ends_[idx];
+  positions->reserve(end - begin);
+  uint32_t position = 0;
+  for (uint32_t i = begin; i < end;) {
+    const uint32_t chunk = i / kBlockSize;
+    if (chunk != chunk_ && !load_chunk(chunk)) {
+      positions->clear();
+      return false;
+    }
+    const uint32_t chunk_base = chunk * kBlockSize;
+    const uint32_t chunk_end = std::min(end, chunk_base + kBlockSize);
+    for (; i < chunk_end; ++i) {
+      position += chunk_values_[i - chunk_base];
+      positions->push_back(position);
+    }
+  }
+  return true;
+}
+
+}  // namespace zvec::fts
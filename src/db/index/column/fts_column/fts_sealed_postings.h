@@ -0,0 +1,342 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <rocksdb/slice.h>
+#include <zvec/ailego/io/file.h>
+#include <zvec/ailego/io/mmap_file.h>
+#include <zvec/db/status.h>
+#include "db/common/rocksdb_context.h"
+#include "bm25_scorer.h"
+
+namespace zvec::fts {
+
+/*! Read-only, memory-mapped form of one sealed FTS column.
+ *
+ *  Written once at seal (and by compaction) next to the segment's FTS
+ *  RocksDB, as three files per field (four with impacts):
+ *    - term dictionary: terms in byte order, front-coded with a restart
+ *      point every kRestartInterval terms.  A lookup binary-searches the
+ *      restart keys and scans at most one restart run.  Each entry holds
+ *      the term's offset/size in the postings and positions files.
+ *    - postings: the BitPacked posting lists (the postings CF values),
+ *      each 16-byte aligned.
+ *    - positions: per term, the $POS CF values re-cut into blocks of
+ *      DOCS_PER_BLOCK docs parallel to the posting blocks.  A skip entry
+ *      per block (last doc_id, offset) lets a phrase jump straight to the
+ *      block of a candidate doc; inside a block the doc deltas, the
+ *      frequencies and the per-doc position deltas are bit-packed, the
+ *      positions in chunks of DOCS_PER_BLOCK values so a lookup unpacks
+ *      only the chunks holding the wanted doc.
+ *    - impacts (optional): per term, the same docs grouped by quantized
+ *      BM25 term-frequency weight, highest first, for score-at-a-time
+ *      search (see TermImpacts).
+ *
+ *  Queries on a sealed segment read postings and positions straight from
+ *  the mappings, so no RocksDB read happens on the query path.  RocksDB
+ *  stays the source of truth: compaction, snapshots and segments sealed
+ *  before these files existed keep working off the column families.
+ */
+class FtsSealedPostings
+    : public std::enable_shared_from_this<FtsSealedPostings> {
+ public:
+  using Ptr = std::shared_ptr<FtsSealedPostings>;
+
+  static constexpr uint32_t kRestartInterval = 16;
+  //! Docs per positions block, and positions per packed chunk.
+  static constexpr uint32_t kPositionBlockSize = 128;
+  //! Highest quantized impact; impacts range over [1, kMaxImpact].
+  static constexpr uint32_t kMaxImpact = 255;
+
+  /*! Incrementally writes the three files of one field.  Files are written
+   *  under temporary names and renamed by finish(), dictionary last, so a
+   *  reader never sees a partial set.
+   */
+  class Writer {
+   public:
+    Writer(const std::string &dir, const std::string &field_name);
+    ~Writer();
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    /*! Also write the impacts file, quantizing each posting's BM25
+     *  term-frequency weight with the parameters and segment statistics of
+     *  \p scorer, which must outlive the writer.  Call before open().
+     */
+    void enable_impacts(const BM25Scorer *scorer) {
+      impact_scorer_ = scorer;
+    }
+
+    Status open();
+
+    /*! Start a term; terms must arrive in strictly ascending byte order.
+     *  \param postings  BitPacked posting list of the term
+     */
+    Status add_term(std::string_view term, const rocksdb::Slice &postings);
+
+    /*! Add the positions of the current term in \p doc_id; doc_ids must
+     *  ascend within a term.
+     *  \param positions  delta-varint position slice (a $POS CF value)
+     */
+    Status add_positions(uint32_t doc_id, const rocksdb::Slice &positions);
+
+    Status finish();
+
+    //! Remove the temporary files of an unfinished writer.
+    void abort();
+
+   private:
+    // Output file with a write-behind buffer; size counts buffered bytes.
+    struct OutputFile {
+      std::string path;
+      ailego::File file;
+      std::string buffer;
+      uint64_t size{0};
+
+      // Zero-pad to a multiple of \p align, then append \p size bytes
+      // starting at *offset.
+      bool append(const void *data, size_t size, size_t align,
+                  uint64_t *offset);
+      bool drain();
+    };
+
+    Status finish_term();
+    // Append the positions section of the buffered term to positions_.
+    bool write_positions(uint64_t *offset);
+    // Append the impacts section of \p postings to impacts_.
+    bool write_impacts(const rocksdb::Slice &postings, uint64_t *offset);
+    // Output files of this writer: impacts_ only when enabled.
+    std::vector<OutputFile *> outputs();
+
+    std::string dir_;
+    std::string field_name_;
+    OutputFile dict_;
+    OutputFile postings_;
+    OutputFile positions_;
+    OutputFile impacts_;
+    const BM25Scorer *impact_scorer_{nullptr};
+    bool opened_{false};
+
+    std::string dict_entries_;
+    std::vector<uint32_t> restarts_;
+    std::string last_term_;
+    uint32_t num_terms_{0};
+
+    // Current term's dictionary fields and buffered positions.
+    bool has_term_{false};
+    uint32_t term_shared_{0};
+    uint64_t term_postings_offset_{0};
+    uint32_t term_postings_size_{0};
+    uint64_t term_impacts_offset_{0};
+    uint32_t term_impacts_size_{0};
+    std::vector<uint32_t> term_doc_ids_;
+    std::vector<uint32_t> term_freqs_;
+    // Per doc: first position, then deltas (the decoded $POS value).
+    std::vector<uint32_t> term_positions_;
+    // Doc_ids of the current term per impact, reused across terms.
+    std::vector<std::vector<uint32_t>> impact_docs_;
+  };
+
+  /*! Cursor over the positions of one term.  A view into the mapping that
+   *  keeps the last decoded block and position chunk, so probing docs in
+   *  ascending order (as a phrase does) decodes each block at most once.
+   *  Empty when the term has no positions.
+   */
+  class TermPositions {
+   public:
+    TermPositions() = default;
+    explicit TermPositions(const rocksdb::Slice &section);
+
+    bool empty() const {
+      return num_docs_ == 0;
+    }
+
+    /*! Decode the ascending positions of \p doc_id into \p positions.
+     *  Any doc order works; ascending order only moves forward.
+     *  \return false if the term does not occur in \p doc_id
+     */
+    bool find(uint32_t doc_id, std::vector<uint32_t> *positions);
+
+   private:
+    static constexpr uint32_t kNoBlock = std::numeric_limits<uint32_t>::max();
+
+    uint32_t skip_last_doc(uint32_t block) const;
+    // First block whose last doc_id is >= doc_id, or num_blocks_.
+    uint32_t seek_block(uint32_t doc_id) const;
+    bool load_block(uint32_t block);
+    bool load_chunk(uint32_t chunk);
+
+    const char *section_{nullptr};
+    size_t size_{0};
+    uint32_t num_docs_{0};
+    uint32_t num_blocks_{0};
+
+    // Decoded block: doc_ids and the end of each doc's positions in the
+    // block's position stream.
+    uint32_t block_{kNoBlock};
+    const char *block_data_{nullptr};
+    uint32_t block_docs_{0};
+    uint32_t block_positions_{0};
+    uint32_t num_chunks_{0};
+    alignas(16) uint32_t doc_ids_[kPositionBlockSize];
+    uint32_t position_ends_[kPositionBlockSize];
+
+    // Decoded chunk of the current block's position stream.
+    uint32_t chunk_{kNoBlock};
+    alignas(16) uint32_t chunk_values_[kPositionBlockSize];
+  };
+
+  /*! Impact-ordered view of one term's postings.  Docs are grouped into
+   *  segments of equal impact, highest impact first, doc_ids ascending
+   *  within a segment.  An impact q bounds the doc's BM25 term-frequency
+   *  weight from above by q / kMaxImpact * (k1 + 1); multiplied by the
+   *  term's IDF it approximates the doc's score contribution without
+   *  touching tf or doc_len.  Empty when the term has no impacts.
+   */
+  class TermImpacts {
+   public:
+    struct Segment {
+      uint32_t impact{0};
+      uint32_t num_docs{0};
+    };
+
+    //! Block-at-a-time reader of the doc_ids of one segment.
+    class DocBlocks {
+     public:
+      /*! Decode the next (at most kPositionBlockSize) doc_ids of the
+       *  segment into \p doc_ids, 16-byte aligned.
+       *  \return the number decoded; 0 once exhausted (or corrupt)
+       */
+      uint32_t next(uint32_t *doc_ids);
+
+     private:
+      friend class TermImpacts;
+
+      const char *data_{nullptr};
+      const char *end_{nullptr};
+      uint32_t remaining_{0};
+    };
+
+    TermImpacts() = default;
+    explicit TermImpacts(const rocksdb::Slice &section);
+
+    bool empty() const {
+      return num_segments_ == 0;
+    }
+    uint32_t num_segments() const {
+      return num_segments_;
+    }
+    //! Largest doc_id of the term.
+    uint32_t max_doc_id() const {
+      return max_doc_id_;
+    }
+
+    Segment segment(uint32_t i) const;
+    DocBlocks docs(uint32_t i) const;
+
+   private:
+    const char *section_{nullptr};
+    size_t size_{0};
+    uint32_t num_segments_{0};
+    uint32_t max_doc_id_{0};
+  };
+
+  FtsSealedPostings() = default;
+  ~FtsSealedPostings() = default;
+
+  FtsSealedPostings(const FtsSealedPostings &) = delete;
+  FtsSealedPostings &operator=(const FtsSealedPostings &) = delete;
+
+  /*! Write the sealed files of \p field_name from its postings and $POS
+   *  column families.  Every posting must already be BitPacked.
+   *  \param impact_scorer  when set, also write impacts quantized with
+   *                        this scorer (see Writer::enable_impacts())
+   */
+  static Status Build(const std::string &dir, const std::string &field_name,
+                      RocksdbContext *ctx,
+                      rocksdb::ColumnFamilyHandle *postings_cf,
+                      rocksdb::ColumnFamilyHandle *positions_cf,
+                      const BM25Scorer *impact_scorer = nullptr);
+
+  /*! Map the sealed files of \p field_name.
+   *  \return nullptr if the field has no sealed files or they are invalid
+   */
+  static Ptr Open(const std::string &dir, const std::string &field_name);
+
+  static bool Exists(const std::string &dir, const std::string &field_name);
+
+  //! Delete the sealed files of \p field_name (missing files are ignored).
+  static void Remove(const std::string &dir, const std::string &field_name);
+
+  //! Hard-link (or copy, where linking fails) the sealed files of
+  //! \p field_name from \p src_dir into \p dst_dir.
+  static Status Link(const std::string &src_dir, const std::string &dst_dir,
+                     const std::string &field_name);
+
+  /*! Pin the BitPacked posting of \p term into \p out without copying; the
+   *  pin keeps the mappings alive.
+   *  \return false if the term is not in the dictionary
+   */
+  bool get_postings(std::string_view term, rocksdb::PinnableSlice *out) const;
+
+  //! Positions of \p term (empty if the term is not in the dictionary).
+  TermPositions get_positions(std::string_view term) const;
+
+  //! Whether the files were written with impacts.
+  bool has_impacts() const {
+    return impacts_map_.size() > 0;
+  }
+
+  //! Impacts of \p term (empty without impacts or if the term is absent).
+  //! The view is valid while this object lives.
+  TermImpacts get_impacts(std::string_view term) const;
+
+  uint32_t term_count() const {
+    return num_terms_;
+  }
+
+ private:
+  struct TermEntry {
+    uint64_t postings_offset{0};
+    uint32_t postings_size{0};
+    uint64_t positions_offset{0};
+    uint32_t positions_size{0};
+    uint64_t impacts_offset{0};
+    uint32_t impacts_size{0};
+  };
+
+  bool load(const std::string &dir, const std::string &field_name);
+  bool find(std::string_view term, TermEntry *entry) const;
+
+  ailego::MMapFile dict_map_;
+  ailego::MMapFile postings_map_;
+  ailego::MMapFile positions_map_;
+  ailego::MMapFile impacts_map_;
+
+  const char *entries_{nullptr};
+  size_t entries_size_{0};
+  const char *restarts_{nullptr};
+  uint32_t num_restarts_{0};
+  uint32_t num_terms_{0};
+};
+
+}  // namespace zvec::fts
@@ -0,0 +1,96 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fts_term_interner.h"
+#include <cstring>
+#include <functional>
+
+namespace zvec::fts {
+
+size_t TermInterner::probe(std::string_view term, size_t hash) const {
+  const size_t mask = slots_.size() - 1;
+  size_t i = hash & mask;
+  while (slots_[i] != kEmptySlot) {
+    const uint32_t id = slots_[i] - 1;
+    if (hashes_[id] == hash && terms_[id] == term) {
+      break;
+    }
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+uint32_t TermInterner::find(std::string_view term) const {
+  if (slots_.empty()) {
+    return kNotFound;
+  }
+  const size_t slot = probe(term, std::hash<std::string_view>{}(term));
+  return slots_[slot] == kEmptySlot ? kNotFound : slots_[slot] - 1;
+}
+
+uint32_t TermInterner::intern(std::string_view term) {
+  // Keep the load factor at or below 1/2 so probe chains stay short.
+  if ((terms_.size() + 1) * 2 > slots_.size()) {
+    grow();
+  }
+  const size_t hash = std::hash<std::string_view>{}(term);
+  const size_t slot = probe(term, hash);
+  if (slots_[slot] != kEmptySlot) {
+    return slots_[slot] - 1;
+  }
+  const uint32_t id = static_cast<uint32_t>(terms_.size());
+  terms_.push_back(store(term));
+  hashes_.push_back(hash);
+  slots_[slot] = id + 1;
+  return id;
+}
+
+void TermInterner::grow() {
+  const size_t new_size = slots_.empty() ? 1024 : slots_.size() * 2;
+  slots_.assign(new_size, kEmptySlot);
+  const size_t mask = new_size - 1;
+  for (uint32_t id = 0; id < terms_.size(); ++id) {
+    size_t i = hashes_[id] & mask;
+    while (slots_[i] != kEmptySlot) {
+      i = (i + 1) & mask;
+    }
+    slots_[i] = id + 1;
+  }
+}
+
+std::string_view TermInterner::store(std::string_view term) {
+  if (term.empty()) {
+    return std::string_view();
+  }
+  if (term.size() > kBlockSize / 4) {
+    // Oversized terms get a block of their own so the current block is not
+    // abandoned half-empty.
+    auto block = std::make_unique<char[]>(term.size());
+    std::memcpy(block.get(), term.data(), term.size());
+    std::string_view stored(block.get(), term.size());
+    blocks_.insert(blocks_.end() - (blocks_.empty() ? 0 : 1),
+                   std::move(block));
+    return stored;
+  }
+  if (block_used_ + term.size() > kBlockSize) {
+    blocks_.push_back(std::make_unique<char[]>(kBlockSize));
+    block_used_ = 0;
+  }
+  char *dest = blocks_.back().get() + block_used_;
+  std::memcpy(dest, term.data(), term.size());
+  block_used_ += term.size();
+  return std::string_view(dest, term.size());
+}
+
+}  // namespace zvec::fts
@@ -0,0 +1,75 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace zvec::fts {
+
+/*! Maps terms to dense IDs (0, 1, 2, ...) in first-seen order.
+ *
+ *  Term bytes are copied once into arena blocks and never move, so term()
+ *  views stay valid for the interner's lifetime.  Lookups take string_view,
+ *  so interning a token straight from a TokenView does not allocate.  The
+ *  table is open-addressed over IDs with cached hashes; it is not
+ *  thread-safe, the owner serialises access.
+ */
+class TermInterner {
+ public:
+  static constexpr uint32_t kNotFound = std::numeric_limits<uint32_t>::max();
+
+  TermInterner() = default;
+
+  TermInterner(const TermInterner &) = delete;
+  TermInterner &operator=(const TermInterner &) = delete;
+
+  //! ID of \p term, assigning the next ID when it is new.
+  uint32_t intern(std::string_view term);
+
+  //! ID of \p term, or kNotFound.
+  uint32_t find(std::string_view term) const;
+
+  //! Text of \p id; valid for the interner's lifetime.
+  std::string_view term(uint32_t id) const {
+    return terms_[id];
+  }
+
+  size_t size() const {
+    return terms_.size();
+  }
+
+ private:
+  static constexpr size_t kBlockSize = 64 * 1024;
+  static constexpr uint32_t kEmptySlot = 0;
+
+  size_t probe(std::string_view term, size_t hash) const;
+  void grow();
+  std::string_view store(std::string_view term);
+
+  // slots_[i] is 0 when empty, otherwise ID + 1.  Size is a power of two.
+  std::vector<uint32_t> slots_;
+  std::vector<size_t> hashes_;
+  std::vector<std::string_view> terms_;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t block_used_{kBlockSize};
+};
+
+}  // namespace zvec::fts
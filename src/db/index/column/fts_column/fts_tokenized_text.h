@@ -0,0 +1,103 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "tokenizer/tokenizer_factory.h"
+
+namespace zvec::fts {
+
+/*! Tokenizer output of one field value, reduced to what indexing needs.
+ *
+ *  All term bytes live in one buffer with per-token end offsets, so a
+ *  tokenized document costs three growable buffers instead of one
+ *  std::string per token.  Byte offsets into the source text are dropped;
+ *  only term and position are kept.
+ */
+class TokenizedText {
+ public:
+  TokenizedText() = default;
+
+  //! Run \p pipeline over \p text, appending the streamed tokens directly.
+  static TokenizedText tokenize(const TokenizerPipeline &pipeline,
+                                const std::string &text) {
+    TokenizedText result;
+    // Rough guess (one token per ~6 bytes) to skip the first regrowths.
+    result.reserve(text.size() / 6 + 1, text.size());
+    pipeline.process_stream(text, [&result](const TokenView &token) {
+      result.append(token.text, token.position);
+    });
+    return result;
+  }
+
+  explicit TokenizedText(const std::vector<Token> &tokens) {
+    size_t total_bytes = 0;
+    for (const auto &token : tokens) {
+      total_bytes += token.text.size();
+    }
+    reserve(tokens.size(), total_bytes);
+    for (const auto &token : tokens) {
+      append(token.text, token.position);
+    }
+  }
+
+  void reserve(size_t token_count, size_t term_bytes) {
+    terms_.reserve(term_bytes);
+    term_ends_.reserve(token_count);
+    positions_.reserve(token_count);
+  }
+
+  //! Append one token; positions must be ascending.
+  void append(std::string_view term, uint32_t position) {
+    terms_.append(term.data(), term.size());
+    term_ends_.push_back(static_cast<uint32_t>(terms_.size()));
+    positions_.push_back(position);
+  }
+
+  //! Number of tokens (the document length used by BM25)
+  size_t size() const {
+    return positions_.size();
+  }
+
+  bool empty() const {
+    return positions_.empty();
+  }
+
+  //! Term text of token \p i; valid while this object is alive
+  std::string_view term(size_t i) const {
+    const uint32_t begin = i == 0 ? 0 : term_ends_[i - 1];
+    return std::string_view(terms_.data() + begin, term_ends_[i] - begin);
+  }
+
+  //! Position of token \p i, ascending across tokens
+  uint32_t position(size_t i) const {
+    return positions_[i];
+  }
+
+ private:
+  std::string terms_;
+  std::vector<uint32_t> term_ends_;
+  std::vector<uint32_t> positions_;
+};
+
+//! Pre-tokenized FTS fields of one document, keyed by field name.  Fields
+//! missing from the map are tokenized inline by the indexer.
+using FtsTokenizedFields = std::unordered_map<std::string, TokenizedText>;
+
+}  // namespace zvec::fts
@@ -14,14 +14,57 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "db/index/common/index_filter.h"
 
 namespace zvec::fts {
 
+/*! BM25 statistics of one FTS field summed over every segment of a
+ *  collection, so all segments score a query against the same IDF and
+ *  average document length.  Built per query by
+ *  FtsColumnIndexer::collect_stats(); doc_freqs only holds the query terms.
+ */
+struct FtsCollectionStats {
+  uint64_t total_docs{0};
+  uint64_t total_tokens{0};
+  std::unordered_map<std::string, uint64_t> doc_freqs;
+
+  uint64_t doc_freq(const std::string &term) const {
+    auto it = doc_freqs.find(term);
+    return it == doc_freqs.end() ? 0 : it->second;
+  }
+};
+
+/*! Entry score of the global top-k, shared by the per-segment searches of
+ *  one query.  Each segment raises it to its local k-th best score once its
+ *  heap is full; with collection-wide stats scores are comparable across
+ *  segments, so a doc scoring at or below it cannot enter the merged top-k.
+ */
+class FtsTopkThreshold {
+ public:
+  float load() const {
+    return score_.load(std::memory_order_relaxed);
+  }
+
+  void raise(float score) {
+    float current = score_.load(std::memory_order_relaxed);
+    while (score > current &&
+           !score_.compare_exchange_weak(current, score,
+                                         std::memory_order_relaxed)) {
+    }
+  }
+
+ private:
+  std::atomic<float> score_{0.0f};
+};
+
 /*! FTS query parameters passed to FtsColumnIndexer::search(). */
 struct FtsQueryParams {
   uint32_t topk{10};
@@ -34,6 +77,26 @@ struct FtsQueryParams {
   // DocFilter::get_bf_by_keys_and_update when an invert result is highly
   // selective.
   std::optional<std::vector<uint64_t>> candidate_ids;
+  // Optional collection-wide statistics; nullptr scores with the segment's
+  // own statistics.
+  std::shared_ptr<const FtsCollectionStats> collection_stats;
+  // Optional threshold shared with the other segments of the query.  Only
+  // meaningful together with collection_stats, and only when the caller
+  // merges the per-segment results into one top-k by score.
+  std::shared_ptr<FtsTopkThreshold> topk_threshold;
+  // Anytime ranking: on segments sealed with impacts, a disjunction of
+  // plain terms picks its top-k candidates score-at-a-time and stops early
+  // once a limit below runs out, trading exactness for latency.  Ignored
+  // together with candidate_ids and by every other query or segment.
+  bool anytime{false};
+  // Per-segment time budget of anytime ranking; zero means none.
+  std::chrono::microseconds anytime_budget{0};
+  // Postings anytime ranking may score per segment; zero means none.
+  uint64_t anytime_max_postings{0};
+  // Set by a caller whose filter only excludes deleted docs: a sealed
+  // segment may then answer from, and fill, the FtsQueryCache.  Ignored by
+  // anytime ranking with a time budget, whose results vary run to run.
+  bool use_cache{false};
 };
 
 /*! Per-segment statistics needed by the FTS reducer for doc_id remapping.
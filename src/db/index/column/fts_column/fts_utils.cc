@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "fts_utils.h"
+#include <algorithm>
+#include <vector>
 #include <zvec/ailego/logger/logger.h>
 
 namespace zvec::fts {
@@ -35,4 +37,32 @@ bool parse_doc_term_key(const std::string &key, std::string *term_out,
   return true;
 }
 
+std::string encode_shingle_set(
+    const std::unordered_set<std::string> &shingles) {
+  std::vector<std::string> sorted(shingles.begin(), shingles.end());
+  std::sort(sorted.begin(), sorted.end());
+  std::string value;
+  for (const auto &shingle : sorted) {
+    value.append(shingle);
+    value.push_back('\0');
+  }
+  return value;
+}
+
+void decode_shingle_set(std::string_view value,
+                        std::unordered_set<std::string> *shingles) {
+  shingles->clear();
+  size_t begin = 0;
+  while (begin < value.size()) {
+    const size_t end = value.find('\0', begin);
+    if (end == std::string_view::npos) {
+      LOG_WARN("decode_shingle_set: unterminated shingle. size[%zu]",
+               value.size());
+      return;
+    }
+    shingles->emplace(value.substr(begin, end - begin));
+    begin = end + 1;
+  }
+}
+
 }  // namespace zvec::fts
@@ -17,6 +17,8 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 
 namespace zvec::fts {
 
@@ -50,7 +52,7 @@ inline std::string make_doc_term_key(const std::string &term, uint32_t doc_id) {
 // Callers that build many keys in a row can reserve once and reuse the buffer,
 // avoiding per-key allocation. Returns the number of bytes appended so the
 // caller can build Slices into the buffer.
-inline size_t append_doc_term_key(const std::string &term, uint32_t doc_id,
+inline size_t append_doc_term_key(std::string_view term, uint32_t doc_id,
                                   std::string *buf) {
   const size_t bytes = term.size() + 1 + sizeof(uint32_t);
   buf->append(term);
@@ -62,6 +64,16 @@ inline size_t append_doc_term_key(const std::string &term, uint32_t doc_id,
 bool parse_doc_term_key(const std::string &key, std::string *term_out,
                         uint32_t *doc_id_out);
 
+// Phrase shingle term of two adjacent terms: first + '\x1f' + second.  The
+// ASCII unit separator does not occur in analyzed text, so a shingle never
+// collides with a real term.  Overwrites *term, reusing its capacity.
+inline void make_shingle_term(std::string_view first, std::string_view second,
+                              std::string *term) {
+  term->assign(first);
+  term->push_back('\x1f');
+  term->append(second);
+}
+
 // Per-field segment-stat keys (stat_cf) for BM25 scoring.
 inline std::string make_total_docs_key(const std::string &field_name) {
   return field_name + "_total_docs";
@@ -71,6 +83,19 @@ inline std::string make_total_tokens_key(const std::string &field_name) {
   return field_name + "_total_tokens";
 }
 
+// Per-field stat key of the phrase shingles indexed for every doc of the
+// segment; phrases may only rely on those.
+inline std::string make_phrase_shingles_key(const std::string &field_name) {
+  return field_name + "_phrase_shingles";
+}
+
+// Shingle set stat value: each shingle followed by '\0', in sorted order.
+// Terms never hold '\0' (it separates doc-term keys).
+std::string encode_shingle_set(const std::unordered_set<std::string> &shingles);
+
+void decode_shingle_set(std::string_view value,
+                        std::unordered_set<std::string> *shingles);
+
 // uint64 big-endian encoding for stat values.
 inline std::string encode_uint64_value(uint64_t value) {
   std::string out(sizeof(uint64_t), '\0');
@@ -63,7 +63,8 @@ std::vector<std::string> FtsLexer::_ruleNames = {
     "OR",          "AND",          "NOT",      "PLUS_SIGN",  "MINUS_SIGN",
     "COLON",       "CARET",        "LP",       "RP",         "DQUOTA_STRING",
     "ASCII_ALNUM", "ESCAPED_CHAR", "UNI_CHAR", "TERM_START", "TERM_BODY",
-    "REGULAR_ID",  "NUMBER",       "TERM",     "SPACES",     "DEFAULT"};
+    "REGULAR_ID",  "NUMBER",       "TERM",     "SPACES",     "TILDE",
+    "DEFAULT"};
 
 std::vector<std::string> FtsLexer::_channelNames = {"DEFAULT_TOKEN_CHANNEL",
                                                     "HIDDEN"};
@@ -71,12 +72,13 @@ std::vector<std::string> FtsLexer::_channelNames = {"DEFAULT_TOKEN_CHANNEL",
 std::vector<std::string> FtsLexer::_modeNames = {"DEFAULT_MODE"};
 
 std::vector<std::string> FtsLexer::_literalNames = {
-    "", "", "", "", "'+'", "'-'", "':'", "'^'", "'('", "')'"};
+    "", "",   "", "", "'+'", "'-'", "':'", "'^'", "'('", "')'", "", "", "", "",
+    "", "'~'"};
 
 std::vector<std::string> FtsLexer::_symbolicNames = {
-    "",       "OR",    "AND",    "NOT",    "PLUS_SIGN",     "MINUS_SIGN",
-    "COLON",  "CARET", "LP",     "RP",     "DQUOTA_STRING", "REGULAR_ID",
-    "NUMBER", "TERM",  "SPACES", "DEFAULT"};
+    "",       "OR",    "AND",    "NOT",   "PLUS_SIGN",     "MINUS_SIGN",
+    "COLON",  "CARET", "LP",     "RP",    "DQUOTA_STRING", "REGULAR_ID",
+    "NUMBER", "TERM",  "SPACES", "TILDE", "DEFAULT"};
 
 dfa::Vocabulary FtsLexer::_vocabulary(_literalNames, _symbolicNames);
 
@@ -100,7 +102,7 @@ FtsLexer::Initializer::Initializer() {
 
   _serializedATN = {
       0x3,  0x608b, 0xa72a, 0x8133, 0xb9ed, 0x417c, 0x3be7, 0x7786, 0x5964,
-      0x2,  0x11,   0x82,   0x8,    0x1,    0x4,    0x2,    0x9,    0x2,
+      0x2,  0x12,   0x86,   0x8,    0x1,    0x4,    0x2,    0x9,    0x2,
       0x4,  0x3,    0x9,    0x3,    0x4,    0x4,    0x9,    0x4,    0x4,
       0x5,  0x9,    0x5,    0x4,    0x6,    0x9,    0x6,    0x4,    0x7,
       0x9,  0x7,    0x4,    0x8,    0x9,    0x8,    0x4,    0x9,    0x9,
@@ -109,139 +111,142 @@ FtsLexer::Initializer::Initializer() {
       0xe,  0x9,    0xe,    0x4,    0xf,    0x9,    0xf,    0x4,    0x10,
       0x9,  0x10,   0x4,    0x11,   0x9,    0x11,   0x4,    0x12,   0x9,
       0x12, 0x4,    0x13,   0x9,    0x13,   0x4,    0x14,   0x9,    0x14,
-      0x4,  0x15,   0x9,    0x15,   0x3,    0x2,    0x3,    0x2,    0x3,
-      0x2,  0x3,    0x3,    0x3,    0x3,    0x3,    0x3,    0x3,    0x3,
-      0x3,  0x4,    0x3,    0x4,    0x3,    0x4,    0x3,    0x4,    0x3,
-      0x5,  0x3,    0x5,    0x3,    0x6,    0x3,    0x6,    0x3,    0x7,
-      0x3,  0x7,    0x3,    0x8,    0x3,    0x8,    0x3,    0x9,    0x3,
-      0x9,  0x3,    0xa,    0x3,    0xa,    0x3,    0xb,    0x3,    0xb,
-      0x3,  0xb,    0x3,    0xb,    0x7,    0xb,    0x47,   0xa,    0xb,
-      0xc,  0xb,    0xe,    0xb,    0x4a,   0xb,    0xb,    0x3,    0xb,
-      0x3,  0xb,    0x3,    0xc,    0x3,    0xc,    0x3,    0xd,    0x3,
-      0xd,  0x3,    0xd,    0x3,    0xe,    0x3,    0xe,    0x3,    0xf,
-      0x3,  0xf,    0x5,    0xf,    0x57,   0xa,    0xf,    0x3,    0x10,
-      0x3,  0x10,   0x3,    0x10,   0x3,    0x10,   0x5,    0x10,   0x5d,
-      0xa,  0x10,   0x3,    0x11,   0x3,    0x11,   0x7,    0x11,   0x61,
-      0xa,  0x11,   0xc,    0x11,   0xe,    0x11,   0x64,   0xb,    0x11,
-      0x3,  0x12,   0x6,    0x12,   0x67,   0xa,    0x12,   0xd,    0x12,
-      0xe,  0x12,   0x68,   0x3,    0x12,   0x3,    0x12,   0x6,    0x12,
-      0x6d, 0xa,    0x12,   0xd,    0x12,   0xe,    0x12,   0x6e,   0x5,
-      0x12, 0x71,   0xa,    0x12,   0x3,    0x13,   0x3,    0x13,   0x7,
-      0x13, 0x75,   0xa,    0x13,   0xc,    0x13,   0xe,    0x13,   0x78,
-      0xb,  0x13,   0x3,    0x14,   0x6,    0x14,   0x7b,   0xa,    0x14,
-      0xd,  0x14,   0xe,    0x14,   0x7c,   0x3,    0x14,   0x3,    0x14,
-      0x3,  0x15,   0x3,    0x15,   0x2,    0x2,    0x16,   0x3,    0x3,
-      0x5,  0x4,    0x7,    0x5,    0x9,    0x6,    0xb,    0x7,    0xd,
-      0x8,  0xf,    0x9,    0x11,   0xa,    0x13,   0xb,    0x15,   0xc,
-      0x17, 0x2,    0x19,   0x2,    0x1b,   0x2,    0x1d,   0x2,    0x1f,
-      0x2,  0x21,   0xd,    0x23,   0xe,    0x25,   0xf,    0x27,   0x10,
-      0x29, 0x11,   0x3,    0x2,    0x11,   0x4,    0x2,    0x51,   0x51,
-      0x71, 0x71,   0x4,    0x2,    0x54,   0x54,   0x74,   0x74,   0x4,
-      0x2,  0x43,   0x43,   0x63,   0x63,   0x4,    0x2,    0x50,   0x50,
-      0x70, 0x70,   0x4,    0x2,    0x46,   0x46,   0x66,   0x66,   0x4,
-      0x2,  0x56,   0x56,   0x76,   0x76,   0x6,    0x2,    0xc,    0xc,
-      0xf,  0xf,    0x24,   0x24,   0x5e,   0x5e,   0x6,    0x2,    0x32,
-      0x3b, 0x43,   0x5c,   0x61,   0x61,   0x63,   0x7c,   0xc,    0x2,
-      0x23, 0x24,   0x28,   0x28,   0x2a,   0x2d,   0x2f,   0x2f,   0x31,
-      0x31, 0x3c,   0x3c,   0x3f,   0x3f,   0x41,   0x41,   0x5d,   0x60,
-      0x7d, 0x80,   0x3,    0x2,    0x82,   0x1,    0x8,    0x2,    0x25,
-      0x25, 0x27,   0x27,   0x29,   0x29,   0x2f,   0x31,   0x42,   0x42,
-      0x61, 0x61,   0x5,    0x2,    0x43,   0x5c,   0x61,   0x61,   0x63,
-      0x7c, 0x7,    0x2,    0x2f,   0x2f,   0x32,   0x3b,   0x43,   0x5c,
-      0x61, 0x61,   0x63,   0x7c,   0x3,    0x2,    0x32,   0x3b,   0x5,
-      0x2,  0xb,    0xc,    0xf,    0xf,    0x22,   0x22,   0x2,    0x88,
-      0x2,  0x3,    0x3,    0x2,    0x2,    0x2,    0x2,    0x5,    0x3,
-      0x2,  0x2,    0x2,    0x2,    0x7,    0x3,    0x2,    0x2,    0x2,
-      0x2,  0x9,    0x3,    0x2,    0x2,    0x2,    0x2,    0xb,    0x3,
-      0x2,  0x2,    0x2,    0x2,    0xd,    0x3,    0x2,    0x2,    0x2,
-      0x2,  0xf,    0x3,    0x2,    0x2,    0x2,    0x2,    0x11,   0x3,
-      0x2,  0x2,    0x2,    0x2,    0x13,   0x3,    0x2,    0x2,    0x2,
-      0x2,  0x15,   0x3,    0x2,    0x2,    0x2,    0x2,    0x21,   0x3,
-      0x2,  0x2,    0x2,    0x2,    0x23,   0x3,    0x2,    0x2,    0x2,
-      0x2,  0x25,   0x3,    0x2,    0x2,    0x2,    0x2,    0x27,   0x3,
-      0x2,  0x2,    0x2,    0x2,    0x29,   0x3,    0x2,    0x2,    0x2,
-      0x3,  0x2b,   0x3,    0x2,    0x2,    0x2,    0x5,    0x2e,   0x3,
-      0x2,  0x2,    0x2,    0x7,    0x32,   0x3,    0x2,    0x2,    0x2,
-      0x9,  0x36,   0x3,    0x2,    0x2,    0x2,    0xb,    0x38,   0x3,
-      0x2,  0x2,    0x2,    0xd,    0x3a,   0x3,    0x2,    0x2,    0x2,
-      0xf,  0x3c,   0x3,    0x2,    0x2,    0x2,    0x11,   0x3e,   0x3,
-      0x2,  0x2,    0x2,    0x13,   0x40,   0x3,    0x2,    0x2,    0x2,
-      0x15, 0x42,   0x3,    0x2,    0x2,    0x2,    0x17,   0x4d,   0x3,
-      0x2,  0x2,    0x2,    0x19,   0x4f,   0x3,    0x2,    0x2,    0x2,
-      0x1b, 0x52,   0x3,    0x2,    0x2,    0x2,    0x1d,   0x56,   0x3,
-      0x2,  0x2,    0x2,    0x1f,   0x5c,   0x3,    0x2,    0x2,    0x2,
-      0x21, 0x5e,   0x3,    0x2,    0x2,    0x2,    0x23,   0x66,   0x3,
-      0x2,  0x2,    0x2,    0x25,   0x72,   0x3,    0x2,    0x2,    0x2,
-      0x27, 0x7a,   0x3,    0x2,    0x2,    0x2,    0x29,   0x80,   0x3,
-      0x2,  0x2,    0x2,    0x2b,   0x2c,   0x9,    0x2,    0x2,    0x2,
-      0x2c, 0x2d,   0x9,    0x3,    0x2,    0x2,    0x2d,   0x4,    0x3,
-      0x2,  0x2,    0x2,    0x2e,   0x2f,   0x9,    0x4,    0x2,    0x2,
-      0x2f, 0x30,   0x9,    0x5,    0x2,    0x2,    0x30,   0x31,   0x9,
-      0x6,  0x2,    0x2,    0x31,   0x6,    0x3,    0x2,    0x2,    0x2,
-      0x32, 0x33,   0x9,    0x5,    0x2,    0x2,    0x33,   0x34,   0x9,
-      0x2,  0x2,    0x2,    0x34,   0x35,   0x9,    0x7,    0x2,    0x2,
-      0x35, 0x8,    0x3,    0x2,    0x2,    0x2,    0x36,   0x37,   0x7,
-      0x2d, 0x2,    0x2,    0x37,   0xa,    0x3,    0x2,    0x2,    0x2,
-      0x38, 0x39,   0x7,    0x2f,   0x2,    0x2,    0x39,   0xc,    0x3,
-      0x2,  0x2,    0x2,    0x3a,   0x3b,   0x7,    0x3c,   0x2,    0x2,
-      0x3b, 0xe,    0x3,    0x2,    0x2,    0x2,    0x3c,   0x3d,   0x7,
-      0x60, 0x2,    0x2,    0x3d,   0x10,   0x3,    0x2,    0x2,    0x2,
-      0x3e, 0x3f,   0x7,    0x2a,   0x2,    0x2,    0x3f,   0x12,   0x3,
-      0x2,  0x2,    0x2,    0x40,   0x41,   0x7,    0x2b,   0x2,    0x2,
-      0x41, 0x14,   0x3,    0x2,    0x2,    0x2,    0x42,   0x48,   0x7,
-      0x24, 0x2,    0x2,    0x43,   0x47,   0xa,    0x8,    0x2,    0x2,
-      0x44, 0x45,   0x7,    0x5e,   0x2,    0x2,    0x45,   0x47,   0xb,
-      0x2,  0x2,    0x2,    0x46,   0x43,   0x3,    0x2,    0x2,    0x2,
-      0x46, 0x44,   0x3,    0x2,    0x2,    0x2,    0x47,   0x4a,   0x3,
-      0x2,  0x2,    0x2,    0x48,   0x46,   0x3,    0x2,    0x2,    0x2,
-      0x48, 0x49,   0x3,    0x2,    0x2,    0x2,    0x49,   0x4b,   0x3,
-      0x2,  0x2,    0x2,    0x4a,   0x48,   0x3,    0x2,    0x2,    0x2,
-      0x4b, 0x4c,   0x7,    0x24,   0x2,    0x2,    0x4c,   0x16,   0x3,
-      0x2,  0x2,    0x2,    0x4d,   0x4e,   0x9,    0x9,    0x2,    0x2,
-      0x4e, 0x18,   0x3,    0x2,    0x2,    0x2,    0x4f,   0x50,   0x7,
-      0x5e, 0x2,    0x2,    0x50,   0x51,   0x9,    0xa,    0x2,    0x2,
-      0x51, 0x1a,   0x3,    0x2,    0x2,    0x2,    0x52,   0x53,   0x9,
-      0xb,  0x2,    0x2,    0x53,   0x1c,   0x3,    0x2,    0x2,    0x2,
-      0x54, 0x57,   0x5,    0x17,   0xc,    0x2,    0x55,   0x57,   0x5,
-      0x1b, 0xe,    0x2,    0x56,   0x54,   0x3,    0x2,    0x2,    0x2,
-      0x56, 0x55,   0x3,    0x2,    0x2,    0x2,    0x57,   0x1e,   0x3,
-      0x2,  0x2,    0x2,    0x58,   0x5d,   0x5,    0x17,   0xc,    0x2,
-      0x59, 0x5d,   0x5,    0x1b,   0xe,    0x2,    0x5a,   0x5d,   0x9,
-      0xc,  0x2,    0x2,    0x5b,   0x5d,   0x5,    0x19,   0xd,    0x2,
-      0x5c, 0x58,   0x3,    0x2,    0x2,    0x2,    0x5c,   0x59,   0x3,
-      0x2,  0x2,    0x2,    0x5c,   0x5a,   0x3,    0x2,    0x2,    0x2,
-      0x5c, 0x5b,   0x3,    0x2,    0x2,    0x2,    0x5d,   0x20,   0x3,
-      0x2,  0x2,    0x2,    0x5e,   0x62,   0x9,    0xd,    0x2,    0x2,
-      0x5f, 0x61,   0x9,    0xe,    0x2,    0x2,    0x60,   0x5f,   0x3,
-      0x2,  0x2,    0x2,    0x61,   0x64,   0x3,    0x2,    0x2,    0x2,
-      0x62, 0x60,   0x3,    0x2,    0x2,    0x2,    0x62,   0x63,   0x3,
-      0x2,  0x2,    0x2,    0x63,   0x22,   0x3,    0x2,    0x2,    0x2,
-      0x64, 0x62,   0x3,    0x2,    0x2,    0x2,    0x65,   0x67,   0x9,
-      0xf,  0x2,    0x2,    0x66,   0x65,   0x3,    0x2,    0x2,    0x2,
-      0x67, 0x68,   0x3,    0x2,    0x2,    0x2,    0x68,   0x66,   0x3,
-      0x2,  0x2,    0x2,    0x68,   0x69,   0x3,    0x2,    0x2,    0x2,
-      0x69, 0x70,   0x3,    0x2,    0x2,    0x2,    0x6a,   0x6c,   0x7,
-      0x30, 0x2,    0x2,    0x6b,   0x6d,   0x9,    0xf,    0x2,    0x2,
-      0x6c, 0x6b,   0x3,    0x2,    0x2,    0x2,    0x6d,   0x6e,   0x3,
-      0x2,  0x2,    0x2,    0x6e,   0x6c,   0x3,    0x2,    0x2,    0x2,
-      0x6e, 0x6f,   0x3,    0x2,    0x2,    0x2,    0x6f,   0x71,   0x3,
-      0x2,  0x2,    0x2,    0x70,   0x6a,   0x3,    0x2,    0x2,    0x2,
-      0x70, 0x71,   0x3,    0x2,    0x2,    0x2,    0x71,   0x24,   0x3,
-      0x2,  0x2,    0x2,    0x72,   0x76,   0x5,    0x1d,   0xf,    0x2,
-      0x73, 0x75,   0x5,    0x1f,   0x10,   0x2,    0x74,   0x73,   0x3,
-      0x2,  0x2,    0x2,    0x75,   0x78,   0x3,    0x2,    0x2,    0x2,
-      0x76, 0x74,   0x3,    0x2,    0x2,    0x2,    0x76,   0x77,   0x3,
-      0x2,  0x2,    0x2,    0x77,   0x26,   0x3,    0x2,    0x2,    0x2,
-      0x78, 0x76,   0x3,    0x2,    0x2,    0x2,    0x79,   0x7b,   0x9,
-      0x10, 0x2,    0x2,    0x7a,   0x79,   0x3,    0x2,    0x2,    0x2,
-      0x7b, 0x7c,   0x3,    0x2,    0x2,    0x2,    0x7c,   0x7a,   0x3,
-      0x2,  0x2,    0x2,    0x7c,   0x7d,   0x3,    0x2,    0x2,    0x2,
-      0x7d, 0x7e,   0x3,    0x2,    0x2,    0x2,    0x7e,   0x7f,   0x8,
-      0x14, 0x2,    0x2,    0x7f,   0x28,   0x3,    0x2,    0x2,    0x2,
-      0x80, 0x81,   0xb,    0x2,    0x2,    0x2,    0x81,   0x2a,   0x3,
-      0x2,  0x2,    0x2,    0xd,    0x2,    0x46,   0x48,   0x56,   0x5c,
-      0x62, 0x68,   0x6e,   0x70,   0x76,   0x7c,   0x3,    0x8,    0x2,
-      0x2,
+      0x4,  0x15,   0x9,    0x15,   0x4,    0x16,   0x9,    0x16,   0x3,
+      0x2,  0x3,    0x2,    0x3,    0x2,    0x3,    0x3,    0x3,    0x3,
+      0x3,  0x3,    0x3,    0x3,    0x3,    0x4,    0x3,    0x4,    0x3,
+      0x4,  0x3,    0x4,    0x3,    0x5,    0x3,    0x5,    0x3,    0x6,
+      0x3,  0x6,    0x3,    0x7,    0x3,    0x7,    0x3,    0x8,    0x3,
+      0x8,  0x3,    0x9,    0x3,    0x9,    0x3,    0xa,    0x3,    0xa,
+      0x3,  0xb,    0x3,    0xb,    0x3,    0xb,    0x3,    0xb,    0x7,
+      0xb,  0x49,   0xa,    0xb,    0xc,    0xb,    0xe,    0xb,    0x4c,
+      0xb,  0xb,    0x3,    0xb,    0x3,    0xb,    0x3,    0xc,    0x3,
+      0xc,  0x3,    0xd,    0x3,    0xd,    0x3,    0xd,    0x3,    0xe,
+      0x3,  0xe,    0x3,    0xf,    0x3,    0xf,    0x5,    0xf,    0x59,
+      0xa,  0xf,    0x3,    0x10,   0x3,    0x10,   0x3,    0x10,   0x3,
+      0x10, 0x5,    0x10,   0x5f,   0xa,    0x10,   0x3,    0x11,   0x3,
+      0x11, 0x7,    0x11,   0x63,   0xa,    0x11,   0xc,    0x11,   0xe,
+      0x11, 0x66,   0xb,    0x11,   0x3,    0x12,   0x6,    0x12,   0x69,
+      0xa,  0x12,   0xd,    0x12,   0xe,    0x12,   0x6a,   0x3,    0x12,
+      0x3,  0x12,   0x6,    0x12,   0x6f,   0xa,    0x12,   0xd,    0x12,
+      0xe,  0x12,   0x70,   0x5,    0x12,   0x73,   0xa,    0x12,   0x3,
+      0x13, 0x3,    0x13,   0x7,    0x13,   0x77,   0xa,    0x13,   0xc,
+      0x13, 0xe,    0x13,   0x7a,   0xb,    0x13,   0x3,    0x14,   0x6,
+      0x14, 0x7d,   0xa,    0x14,   0xd,    0x14,   0xe,    0x14,   0x7e,
+      0x3,  0x14,   0x3,    0x14,   0x3,    0x15,   0x3,    0x15,   0x3,
+      0x16, 0x3,    0x16,   0x2,    0x2,    0x17,   0x3,    0x3,    0x5,
+      0x4,  0x7,    0x5,    0x9,    0x6,    0xb,    0x7,    0xd,    0x8,
+      0xf,  0x9,    0x11,   0xa,    0x13,   0xb,    0x15,   0xc,    0x17,
+      0x2,  0x19,   0x2,    0x1b,   0x2,    0x1d,   0x2,    0x1f,   0x2,
+      0x21, 0xd,    0x23,   0xe,    0x25,   0xf,    0x27,   0x10,   0x29,
+      0x11, 0x2b,   0x12,   0x3,    0x2,    0x11,   0x4,    0x2,    0x51,
+      0x51, 0x71,   0x71,   0x4,    0x2,    0x54,   0x54,   0x74,   0x74,
+      0x4,  0x2,    0x43,   0x43,   0x63,   0x63,   0x4,    0x2,    0x50,
+      0x50, 0x70,   0x70,   0x4,    0x2,    0x46,   0x46,   0x66,   0x66,
+      0x4,  0x2,    0x56,   0x56,   0x76,   0x76,   0x6,    0x2,    0xc,
+      0xc,  0xf,    0xf,    0x24,   0x24,   0x5e,   0x5e,   0x6,    0x2,
+      0x32, 0x3b,   0x43,   0x5c,   0x61,   0x61,   0x63,   0x7c,   0xc,
+      0x2,  0x23,   0x24,   0x28,   0x28,   0x2a,   0x2d,   0x2f,   0x2f,
+      0x31, 0x31,   0x3c,   0x3c,   0x3f,   0x3f,   0x41,   0x41,   0x5d,
+      0x60, 0x7d,   0x80,   0x3,    0x2,    0x82,   0x1,    0x8,    0x2,
+      0x25, 0x25,   0x27,   0x27,   0x29,   0x29,   0x2f,   0x31,   0x42,
+      0x42, 0x61,   0x61,   0x5,    0x2,    0x43,   0x5c,   0x61,   0x61,
+      0x63, 0x7c,   0x7,    0x2,    0x2f,   0x2f,   0x32,   0x3b,   0x43,
+      0x5c, 0x61,   0x61,   0x63,   0x7c,   0x3,    0x2,    0x32,   0x3b,
+      0x5,  0x2,    0xb,    0xc,    0xf,    0xf,    0x22,   0x22,   0x2,
+      0x8c, 0x2,    0x3,    0x3,    0x2,    0x2,    0x2,    0x2,    0x5,
+      0x3,  0x2,    0x2,    0x2,    0x2,    0x7,    0x3,    0x2,    0x2,
+      0x2,  0x2,    0x9,    0x3,    0x2,    0x2,    0x2,    0x2,    0xb,
+      0x3,  0x2,    0x2,    0x2,    0x2,    0xd,    0x3,    0x2,    0x2,
+      0x2,  0x2,    0xf,    0x3,    0x2,    0x2,    0x2,    0x2,    0x11,
+      0x3,  0x2,    0x2,    0x2,    0x2,    0x13,   0x3,    0x2,    0x2,
+      0x2,  0x2,    0x15,   0x3,    0x2,    0x2,    0x2,    0x2,    0x21,
+      0x3,  0x2,    0x2,    0x2,    0x2,    0x23,   0x3,    0x2,    0x2,
+      0x2,  0x2,    0x25,   0x3,    0x2,    0x2,    0x2,    0x2,    0x27,
+      0x3,  0x2,    0x2,    0x2,    0x2,    0x29,   0x3,    0x2,    0x2,
+      0x2,  0x2,    0x2b,   0x3,    0x2,    0x2,    0x2,    0x3,    0x2d,
+      0x3,  0x2,    0x2,    0x2,    0x5,    0x30,   0x3,    0x2,    0x2,
+      0x2,  0x7,    0x34,   0x3,    0x2,    0x2,    0x2,    0x9,    0x38,
+      0x3,  0x2,    0x2,    0x2,    0xb,    0x3a,   0x3,    0x2,    0x2,
+      0x2,  0xd,    0x3c,   0x3,    0x2,    0x2,    0x2,    0xf,    0x3e,
+      0x3,  0x2,    0x2,    0x2,    0x11,   0x40,   0x3,    0x2,    0x2,
+      0x2,  0x13,   0x42,   0x3,    0x2,    0x2,    0x2,    0x15,   0x44,
+      0x3,  0x2,    0x2,    0x2,    0x17,   0x4f,   0x3,    0x2,    0x2,
+      0x2,  0x19,   0x51,   0x3,    0x2,    0x2,    0x2,    0x1b,   0x54,
+      0x3,  0x2,    0x2,    0x2,    0x1d,   0x58,   0x3,    0x2,    0x2,
+      0x2,  0x1f,   0x5e,   0x3,    0x2,    0x2,    0x2,    0x21,   0x60,
+      0x3,  0x2,    0x2,    0x2,    0x23,   0x68,   0x3,    0x2,    0x2,
+      0x2,  0x25,   0x74,   0x3,    0x2,    0x2,    0x2,    0x27,   0x7c,
+      0x3,  0x2,    0x2,    0x2,    0x29,   0x82,   0x3,    0x2,    0x2,
+      0x2,  0x2b,   0x84,   0x3,    0x2,    0x2,    0x2,    0x2d,   0x2e,
+      0x9,  0x2,    0x2,    0x2,    0x2e,   0x2f,   0x9,    0x3,    0x2,
+      0x2,  0x2f,   0x4,    0x3,    0x2,    0x2,    0x2,    0x30,   0x31,
+      0x9,  0x4,    0x2,    0x2,    0x31,   0x32,   0x9,    0x5,    0x2,
+      0x2,  0x32,   0x33,   0x9,    0x6,    0x2,    0x2,    0x33,   0x6,
+      0x3,  0x2,    0x2,    0x2,    0x34,   0x35,   0x9,    0x5,    0x2,
+      0x2,  0x35,   0x36,   0x9,    0x2,    0x2,    0x2,    0x36,   0x37,
+      0x9,  0x7,    0x2,    0x2,    0x37,   0x8,    0x3,    0x2,    0x2,
+      0x2,  0x38,   0x39,   0x7,    0x2d,   0x2,    0x2,    0x39,   0xa,
+      0x3,  0x2,    0x2,    0x2,    0x3a,   0x3b,   0x7,    0x2f,   0x2,
+      0x2,  0x3b,   0xc,    0x3,    0x2,    0x2,    0x2,    0x3c,   0x3d,
+      0x7,  0x3c,   0x2,    0x2,    0x3d,   0xe,    0x3,    0x2,    0x2,
+      0x2,  0x3e,   0x3f,   0x7,    0x60,   0x2,    0x2,    0x3f,   0x10,
+      0x3,  0x2,    0x2,    0x2,    0x40,   0x41,   0x7,    0x2a,   0x2,
+      0x2,  0x41,   0x12,   0x3,    0x2,    0x2,    0x2,    0x42,   0x43,
+      0x7,  0x2b,   0x2,    0x2,    0x43,   0x14,   0x3,    0x2,    0x2,
+      0x2,  0x44,   0x4a,   0x7,    0x24,   0x2,    0x2,    0x45,   0x49,
+      0xa,  0x8,    0x2,    0x2,    0x46,   0x47,   0x7,    0x5e,   0x2,
+      0x2,  0x47,   0x49,   0xb,    0x2,    0x2,    0x2,    0x48,   0x45,
+      0x3,  0x2,    0x2,    0x2,    0x48,   0x46,   0x3,    0x2,    0x2,
+      0x2,  0x49,   0x4c,   0x3,    0x2,    0x2,    0x2,    0x4a,   0x48,
+      0x3,  0x2,    0x2,    0x2,    0x4a,   0x4b,   0x3,    0x2,    0x2,
+      0x2,  0x4b,   0x4d,   0x3,    0x2,    0x2,    0x2,    0x4c,   0x4a,
+      0x3,  0x2,    0x2,    0x2,    0x4d,   0x4e,   0x7,    0x24,   0x2,
+      0x2,  0x4e,   0x16,   0x3,    0x2,    0x2,    0x2,    0x4f,   0x50,
+      0x9,  0x9,    0x2,    0x2,    0x50,   0x18,   0x3,    0x2,    0x2,
+      0x2,  0x51,   0x52,   0x7,    0x5e,   0x2,    0x2,    0x52,   0x53,
+      0x9,  0xa,    0x2,    0x2,    0x53,   0x1a,   0x3,    0x2,    0x2,
+      0x2,  0x54,   0x55,   0x9,    0xb,    0x2,    0x2,    0x55,   0x1c,
+      0x3,  0x2,    0x2,    0x2,    0x56,   0x59,   0x5,    0x17,   0xc,
+      0x2,  0x57,   0x59,   0x5,    0x1b,   0xe,    0x2,    0x58,   0x56,
+      0x3,  0x2,    0x2,    0x2,    0x58,   0x57,   0x3,    0x2,    0x2,
+      0x2,  0x59,   0x1e,   0x3,    0x2,    0x2,    0x2,    0x5a,   0x5f,
+      0x5,  0x17,   0xc,    0x2,    0x5b,   0x5f,   0x5,    0x1b,   0xe,
+      0x2,  0x5c,   0x5f,   0x9,    0xc,    0x2,    0x2,    0x5d,   0x5f,
+      0x5,  0x19,   0xd,    0x2,    0x5e,   0x5a,   0x3,    0x2,    0x2,
+      0x2,  0x5e,   0x5b,   0x3,    0x2,    0x2,    0x2,    0x5e,   0x5c,
+      0x3,  0x2,    0x2,    0x2,    0x5e,   0x5d,   0x3,    0x2,    0x2,
+      0x2,  0x5f,   0x20,   0x3,    0x2,    0x2,    0x2,    0x60,   0x64,
+      0x9,  0xd,    0x2,    0x2,    0x61,   0x63,   0x9,    0xe,    0x2,
+      0x2,  0x62,   0x61,   0x3,    0x2,    0x2,    0x2,    0x63,   0x66,
+      0x3,  0x2,    0x2,    0x2,    0x64,   0x62,   0x3,    0x2,    0x2,
+      0x2,  0x64,   0x65,   0x3,    0x2,    0x2,    0x2,    0x65,   0x22,
+      0x3,  0x2,    0x2,    0x2,    0x66,   0x64,   0x3,    0x2,    0x2,
+      0x2,  0x67,   0x69,   0x9,    0xf,    0x2,    0x2,    0x68,   0x67,
+      0x3,  0x2,    0x2,    0x2,    0x69,   0x6a,   0x3,    0x2,    0x2,
+      0x2,  0x6a,   0x68,   0x3,    0x2,    0x2,    0x2,    0x6a,   0x6b,
+      0x3,  0x2,    0x2,    0x2,    0x6b,   0x72,   0x3,    0x2,    0x2,
+      0x2,  0x6c,   0x6e,   0x7,    0x30,   0x2,    0x2,    0x6d,   0x6f,
+      0x9,  0xf,    0x2,    0x2,    0x6e,   0x6d,   0x3,    0x2,    0x2,
+      0x2,  0x6f,   0x70,   0x3,    0x2,    0x2,    0x2,    0x70,   0x6e,
+      0x3,  0x2,    0x2,    0x2,    0x70,   0x71,   0x3,    0x2,    0x2,
+      0x2,  0x71,   0x73,   0x3,    0x2,    0x2,    0x2,    0x72,   0x6c,
+      0x3,  0x2,    0x2,    0x2,    0x72,   0x73,   0x3,    0x2,    0x2,
+      0x2,  0x73,   0x24,   0x3,    0x2,    0x2,    0x2,    0x74,   0x78,
+      0x5,  0x1d,   0xf,    0x2,    0x75,   0x77,   0x5,    0x1f,   0x10,
+      0x2,  0x76,   0x75,   0x3,    0x2,    0x2,    0x2,    0x77,   0x7a,
+      0x3,  0x2,    0x2,    0x2,    0x78,   0x76,   0x3,    0x2,    0x2,
+      0x2,  0x78,   0x79,   0x3,    0x2,    0x2,    0x2,    0x79,   0x26,
+      0x3,  0x2,    0x2,    0x2,    0x7a,   0x78,   0x3,    0x2,    0x2,
+      0x2,  0x7b,   0x7d,   0x9,    0x10,   0x2,    0x2,    0x7c,   0x7b,
+      0x3,  0x2,    0x2,    0x2,    0x7d,   0x7e,   0x3,    0x2,    0x2,
+      0x2,  0x7e,   0x7c,   0x3,    0x2,    0x2,    0x2,    0x7e,   0x7f,
+      0x3,  0x2,    0x2,    0x2,    0x7f,   0x80,   0x3,    0x2,    0x2,
+      0x2,  0x80,   0x81,   0x8,    0x14,   0x2,    0x2,    0x81,   0x28,
+      0x3,  0x2,    0x2,    0x2,    0x82,   0x83,   0x7,    0x80,   0x2,
+      0x2,  0x83,   0x2a,   0x3,    0x2,    0x2,    0x2,    0x84,   0x85,
+      0xb,  0x2,    0x2,    0x2,    0x85,   0x2c,   0x3,    0x2,    0x2,
+      0x2,  0xd,    0x2,    0x48,   0x4a,   0x58,   0x5e,   0x64,   0x6a,
+      0x70, 0x72,   0x78,   0x7e,   0x3,    0x8,    0x2,    0x2,
   };
 
   atn::ATNDeserializer deserializer;
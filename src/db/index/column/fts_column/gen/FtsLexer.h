@@ -27,7 +27,8 @@ class FtsLexer : public antlr4::Lexer {
     NUMBER = 12,
     TERM = 13,
     SPACES = 14,
-    DEFAULT = 15
+    TILDE = 15,
+    DEFAULT = 16
   };
 
   FtsLexer(antlr4::CharStream *input);
@@ -931,6 +931,14 @@ tree::TerminalNode *FtsParser::Fts_phraseContext::DQUOTA_STRING() {
   return getToken(FtsParser::DQUOTA_STRING, 0);
 }
 
+tree::TerminalNode *FtsParser::Fts_phraseContext::TILDE() {
+  return getToken(FtsParser::TILDE, 0);
+}
+
+tree::TerminalNode *FtsParser::Fts_phraseContext::NUMBER() {
+  return getToken(FtsParser::NUMBER, 0);
+}
+
 
 size_t FtsParser::Fts_phraseContext::getRuleIndex() const {
   return FtsParser::RuleFts_phrase;
@@ -951,12 +959,23 @@ FtsParser::Fts_phraseContext *FtsParser::fts_phrase() {
   Fts_phraseContext *_localctx =
       _tracker.createInstance<Fts_phraseContext>(_ctx, getState());
   enterRule(_localctx, 22, FtsParser::RuleFts_phrase);
+  size_t _la = 0;
 
   auto onExit = finally([=] { exitRule(); });
   try {
     enterOuterAlt(_localctx, 1);
     setState(93);
     match(FtsParser::DQUOTA_STRING);
+    setState(96);
+    _errHandler->sync(this);
+
+    _la = _input->LA(1);
+    if (_la == FtsParser::TILDE) {
+      setState(94);
+      match(FtsParser::TILDE);
+      setState(95);
+      match(FtsParser::NUMBER);
+    }
 
   } catch (RecognitionException &e) {
     _errHandler->reportError(this, e);
@@ -981,12 +1000,13 @@ std::vector<std::string> FtsParser::_ruleNames = {
     "fts_boost",      "fts_natural_term", "fts_term",         "fts_phrase"};
 
 std::vector<std::string> FtsParser::_literalNames = {
-    "", "", "", "", "'+'", "'-'", "':'", "'^'", "'('", "')'"};
+    "", "",   "", "", "'+'", "'-'", "':'", "'^'", "'('", "')'", "", "", "", "",
+    "", "'~'"};
 
 std::vector<std::string> FtsParser::_symbolicNames = {
-    "",       "OR",    "AND",    "NOT",    "PLUS_SIGN",     "MINUS_SIGN",
-    "COLON",  "CARET", "LP",     "RP",     "DQUOTA_STRING", "REGULAR_ID",
-    "NUMBER", "TERM",  "SPACES", "DEFAULT"};
+    "",       "OR",    "AND",    "NOT",   "PLUS_SIGN",     "MINUS_SIGN",
+    "COLON",  "CARET", "LP",     "RP",    "DQUOTA_STRING", "REGULAR_ID",
+    "NUMBER", "TERM",  "SPACES", "TILDE", "DEFAULT"};
 
 dfa::Vocabulary FtsParser::_vocabulary(_literalNames, _symbolicNames);
 
@@ -1008,7 +1028,7 @@ FtsParser::Initializer::Initializer() {
 
   _serializedATN = {
       0x3,  0x608b, 0xa72a, 0x8133, 0xb9ed, 0x417c, 0x3be7, 0x7786, 0x5964,
-      0x3,  0x11,   0x62,   0x4,    0x2,    0x9,    0x2,    0x4,    0x3,
+      0x3,  0x12,   0x65,   0x4,    0x2,    0x9,    0x2,    0x4,    0x3,
       0x9,  0x3,    0x4,    0x4,    0x9,    0x4,    0x4,    0x5,    0x9,
       0x5,  0x4,    0x6,    0x9,    0x6,    0x4,    0x7,    0x9,    0x7,
       0x4,  0x8,    0x9,    0x8,    0x4,    0x9,    0x9,    0x9,    0x4,
@@ -1031,76 +1051,79 @@ FtsParser::Initializer::Initializer() {
       0xb,  0x6,    0xb,    0x56,   0xa,    0xb,    0xd,    0xb,    0xe,
       0xb,  0x57,   0x3,    0xc,    0x3,    0xc,    0x3,    0xc,    0x3,
       0xc,  0x5,    0xc,    0x5e,   0xa,    0xc,    0x3,    0xd,    0x3,
-      0xd,  0x3,    0xd,    0x2,    0x2,    0xe,    0x2,    0x4,    0x6,
-      0x8,  0xa,    0xc,    0xe,    0x10,   0x12,   0x14,   0x16,   0x18,
-      0x2,  0x2,    0x2,    0x64,   0x2,    0x1a,   0x3,    0x2,    0x2,
-      0x2,  0x4,    0x1d,   0x3,    0x2,    0x2,    0x2,    0x6,    0x25,
-      0x3,  0x2,    0x2,    0x2,    0x8,    0x34,   0x3,    0x2,    0x2,
-      0x2,  0xa,    0x3d,   0x3,    0x2,    0x2,    0x2,    0xc,    0x40,
-      0x3,  0x2,    0x2,    0x2,    0xe,    0x46,   0x3,    0x2,    0x2,
-      0x2,  0x10,   0x4f,   0x3,    0x2,    0x2,    0x2,    0x12,   0x51,
-      0x3,  0x2,    0x2,    0x2,    0x14,   0x55,   0x3,    0x2,    0x2,
-      0x2,  0x16,   0x5d,   0x3,    0x2,    0x2,    0x2,    0x18,   0x5f,
-      0x3,  0x2,    0x2,    0x2,    0x1a,   0x1b,   0x5,    0x4,    0x3,
-      0x2,  0x1b,   0x1c,   0x7,    0x2,    0x2,    0x3,    0x1c,   0x3,
-      0x3,  0x2,    0x2,    0x2,    0x1d,   0x22,   0x5,    0x6,    0x4,
-      0x2,  0x1e,   0x1f,   0x7,    0x3,    0x2,    0x2,    0x1f,   0x21,
-      0x5,  0x6,    0x4,    0x2,    0x20,   0x1e,   0x3,    0x2,    0x2,
-      0x2,  0x21,   0x24,   0x3,    0x2,    0x2,    0x2,    0x22,   0x20,
-      0x3,  0x2,    0x2,    0x2,    0x22,   0x23,   0x3,    0x2,    0x2,
-      0x2,  0x23,   0x5,    0x3,    0x2,    0x2,    0x2,    0x24,   0x22,
-      0x3,  0x2,    0x2,    0x2,    0x25,   0x30,   0x5,    0x8,    0x5,
-      0x2,  0x26,   0x28,   0x7,    0x4,    0x2,    0x2,    0x27,   0x29,
-      0x7,  0x5,    0x2,    0x2,    0x28,   0x27,   0x3,    0x2,    0x2,
-      0x2,  0x28,   0x29,   0x3,    0x2,    0x2,    0x2,    0x29,   0x2c,
-      0x3,  0x2,    0x2,    0x2,    0x2a,   0x2c,   0x7,    0x5,    0x2,
-      0x2,  0x2b,   0x26,   0x3,    0x2,    0x2,    0x2,    0x2b,   0x2a,
-      0x3,  0x2,    0x2,    0x2,    0x2c,   0x2d,   0x3,    0x2,    0x2,
-      0x2,  0x2d,   0x2f,   0x5,    0x8,    0x5,    0x2,    0x2e,   0x2b,
-      0x3,  0x2,    0x2,    0x2,    0x2f,   0x32,   0x3,    0x2,    0x2,
-      0x2,  0x30,   0x2e,   0x3,    0x2,    0x2,    0x2,    0x30,   0x31,
-      0x3,  0x2,    0x2,    0x2,    0x31,   0x7,    0x3,    0x2,    0x2,
-      0x2,  0x32,   0x30,   0x3,    0x2,    0x2,    0x2,    0x33,   0x35,
-      0x5,  0xa,    0x6,    0x2,    0x34,   0x33,   0x3,    0x2,    0x2,
-      0x2,  0x35,   0x36,   0x3,    0x2,    0x2,    0x2,    0x36,   0x34,
-      0x3,  0x2,    0x2,    0x2,    0x36,   0x37,   0x3,    0x2,    0x2,
-      0x2,  0x37,   0x9,    0x3,    0x2,    0x2,    0x2,    0x38,   0x39,
-      0x7,  0x6,    0x2,    0x2,    0x39,   0x3e,   0x5,    0xc,    0x7,
-      0x2,  0x3a,   0x3b,   0x7,    0x7,    0x2,    0x2,    0x3b,   0x3e,
-      0x5,  0xc,    0x7,    0x2,    0x3c,   0x3e,   0x5,    0xc,    0x7,
-      0x2,  0x3d,   0x38,   0x3,    0x2,    0x2,    0x2,    0x3d,   0x3a,
-      0x3,  0x2,    0x2,    0x2,    0x3d,   0x3c,   0x3,    0x2,    0x2,
-      0x2,  0x3e,   0xb,    0x3,    0x2,    0x2,    0x2,    0x3f,   0x41,
-      0x5,  0xe,    0x8,    0x2,    0x40,   0x3f,   0x3,    0x2,    0x2,
-      0x2,  0x40,   0x41,   0x3,    0x2,    0x2,    0x2,    0x41,   0x42,
-      0x3,  0x2,    0x2,    0x2,    0x42,   0x44,   0x5,    0x10,   0x9,
-      0x2,  0x43,   0x45,   0x5,    0x12,   0xa,    0x2,    0x44,   0x43,
-      0x3,  0x2,    0x2,    0x2,    0x44,   0x45,   0x3,    0x2,    0x2,
-      0x2,  0x45,   0xd,    0x3,    0x2,    0x2,    0x2,    0x46,   0x47,
-      0x7,  0xd,    0x2,    0x2,    0x47,   0x48,   0x7,    0x8,    0x2,
-      0x2,  0x48,   0xf,    0x3,    0x2,    0x2,    0x2,    0x49,   0x50,
-      0x5,  0x16,   0xc,    0x2,    0x4a,   0x50,   0x5,    0x18,   0xd,
-      0x2,  0x4b,   0x4c,   0x7,    0xa,    0x2,    0x2,    0x4c,   0x4d,
-      0x5,  0x4,    0x3,    0x2,    0x4d,   0x4e,   0x7,    0xb,    0x2,
-      0x2,  0x4e,   0x50,   0x3,    0x2,    0x2,    0x2,    0x4f,   0x49,
-      0x3,  0x2,    0x2,    0x2,    0x4f,   0x4a,   0x3,    0x2,    0x2,
-      0x2,  0x4f,   0x4b,   0x3,    0x2,    0x2,    0x2,    0x50,   0x11,
-      0x3,  0x2,    0x2,    0x2,    0x51,   0x52,   0x7,    0x9,    0x2,
-      0x2,  0x52,   0x53,   0x7,    0xe,    0x2,    0x2,    0x53,   0x13,
-      0x3,  0x2,    0x2,    0x2,    0x54,   0x56,   0x7,    0x11,   0x2,
-      0x2,  0x55,   0x54,   0x3,    0x2,    0x2,    0x2,    0x56,   0x57,
-      0x3,  0x2,    0x2,    0x2,    0x57,   0x55,   0x3,    0x2,    0x2,
-      0x2,  0x57,   0x58,   0x3,    0x2,    0x2,    0x2,    0x58,   0x15,
-      0x3,  0x2,    0x2,    0x2,    0x59,   0x5e,   0x7,    0xf,    0x2,
-      0x2,  0x5a,   0x5e,   0x7,    0xd,    0x2,    0x2,    0x5b,   0x5e,
-      0x7,  0xe,    0x2,    0x2,    0x5c,   0x5e,   0x5,    0x14,   0xb,
-      0x2,  0x5d,   0x59,   0x3,    0x2,    0x2,    0x2,    0x5d,   0x5a,
-      0x3,  0x2,    0x2,    0x2,    0x5d,   0x5b,   0x3,    0x2,    0x2,
-      0x2,  0x5d,   0x5c,   0x3,    0x2,    0x2,    0x2,    0x5e,   0x17,
-      0x3,  0x2,    0x2,    0x2,    0x5f,   0x60,   0x7,    0xc,    0x2,
-      0x2,  0x60,   0x19,   0x3,    0x2,    0x2,    0x2,    0xd,    0x22,
-      0x28, 0x2b,   0x30,   0x36,   0x3d,   0x40,   0x44,   0x4f,   0x57,
-      0x5d,
+      0xd,  0x3,    0xd,    0x5,    0xd,    0x63,   0xa,    0xd,    0x3,
+      0xd,  0x2,    0x2,    0xe,    0x2,    0x4,    0x6,    0x8,    0xa,
+      0xc,  0xe,    0x10,   0x12,   0x14,   0x16,   0x18,   0x2,    0x2,
+      0x2,  0x68,   0x2,    0x1a,   0x3,    0x2,    0x2,    0x2,    0x4,
+      0x1d, 0x3,    0x2,    0x2,    0x2,    0x6,    0x25,   0x3,    0x2,
+      0x2,  0x2,    0x8,    0x34,   0x3,    0x2,    0x2,    0x2,    0xa,
+      0x3d, 0x3,    0x2,    0x2,    0x2,    0xc,    0x40,   0x3,    0x2,
+      0x2,  0x2,    0xe,    0x46,   0x3,    0x2,    0x2,    0x2,    0x10,
+      0x4f, 0x3,    0x2,    0x2,    0x2,    0x12,   0x51,   0x3,    0x2,
+      0x2,  0x2,    0x14,   0x55,   0x3,    0x2,    0x2,    0x2,    0x16,
+      0x5d, 0x3,    0x2,    0x2,    0x2,    0x18,   0x5f,   0x3,    0x2,
+      0x2,  0x2,    0x1a,   0x1b,   0x5,    0x4,    0x3,    0x2,    0x1b,
+      0x1c, 0x7,    0x2,    0x2,    0x3,    0x1c,   0x3,    0x3,    0x2,
+      0x2,  0x2,    0x1d,   0x22,   0x5,    0x6,    0x4,    0x2,    0x1e,
+      0x1f, 0x7,    0x3,    0x2,    0x2,    0x1f,   0x21,   0x5,    0x6,
+      0x4,  0x2,    0x20,   0x1e,   0x3,    0x2,    0x2,    0x2,    0x21,
+      0x24, 0x3,    0x2,    0x2,    0x2,    0x22,   0x20,   0x3,    0x2,
+      0x2,  0x2,    0x22,   0x23,   0x3,    0x2,    0x2,    0x2,    0x23,
+      0x5,  0x3,    0x2,    0x2,    0x2,    0x24,   0x22,   0x3,    0x2,
+      0x2,  0x2,    0x25,   0x30,   0x5,    0x8,    0x5,    0x2,    0x26,
+      0x28, 0x7,    0x4,    0x2,    0x2,    0x27,   0x29,   0x7,    0x5,
+      0x2,  0x2,    0x28,   0x27,   0x3,    0x2,    0x2,    0x2,    0x28,
+      0x29, 0x3,    0x2,    0x2,    0x2,    0x29,   0x2c,   0x3,    0x2,
+      0x2,  0x2,    0x2a,   0x2c,   0x7,    0x5,    0x2,    0x2,    0x2b,
+      0x26, 0x3,    0x2,    0x2,    0x2,    0x2b,   0x2a,   0x3,    0x2,
+      0x2,  0x2,    0x2c,   0x2d,   0x3,    0x2,    0x2,    0x2,    0x2d,
+      0x2f, 0x5,    0x8,    0x5,    0x2,    0x2e,   0x2b,   0x3,    0x2,
+      0x2,  0x2,    0x2f,   0x32,   0x3,    0x2,    0x2,    0x2,    0x30,
+      0x2e, 0x3,    0x2,    0x2,    0x2,    0x30,   0x31,   0x3,    0x2,
+      0x2,  0x2,    0x31,   0x7,    0x3,    0x2,    0x2,    0x2,    0x32,
+      0x30, 0x3,    0x2,    0x2,    0x2,    0x33,   0x35,   0x5,    0xa,
+      0x6,  0x2,    0x34,   0x33,   0x3,    0x2,    0x2,    0x2,    0x35,
+      0x36, 0x3,    0x2,    0x2,    0x2,    0x36,   0x34,   0x3,    0x2,
+      0x2,  0x2,    0x36,   0x37,   0x3,    0x2,    0x2,    0x2,    0x37,
+      0x9,  0x3,    0x2,    0x2,    0x2,    0x38,   0x39,   0x7,    0x6,
+      0x2,  0x2,    0x39,   0x3e,   0x5,    0xc,    0x7,    0x2,    0x3a,
+      0x3b, 0x7,    0x7,    0x2,    0x2,    0x3b,   0x3e,   0x5,    0xc,
+      0x7,  0x2,    0x3c,   0x3e,   0x5,    0xc,    0x7,    0x2,    0x3d,
+      0x38, 0x3,    0x2,    0x2,    0x2,    0x3d,   0x3a,   0x3,    0x2,
+      0x2,  0x2,    0x3d,   0x3c,   0x3,    0x2,    0x2,    0x2,    0x3e,
+      0xb,  0x3,    0x2,    0x2,    0x2,    0x3f,   0x41,   0x5,    0xe,
+      0x8,  0x2,    0x40,   0x3f,   0x3,    0x2,    0x2,    0x2,    0x40,
+      0x41, 0x3,    0x2,    0x2,    0x2,    0x41,   0x42,   0x3,    0x2,
+      0x2,  0x2,    0x42,   0x44,   0x5,    0x10,   0x9,    0x2,    0x43,
+      0x45, 0x5,    0x12,   0xa,    0x2,    0x44,   0x43,   0x3,    0x2,
+      0x2,  0x2,    0x44,   0x45,   0x3,    0x2,    0x2,    0x2,    0x45,
+      0xd,  0x3,    0x2,    0x2,    0x2,    0x46,   0x47,   0x7,    0xd,
+      0x2,  0x2,    0x47,   0x48,   0x7,    0x8,    0x2,    0x2,    0x48,
+      0xf,  0x3,    0x2,    0x2,    0x2,    0x49,   0x50,   0x5,    0x16,
+      0xc,  0x2,    0x4a,   0x50,   0x5,    0x18,   0xd,    0x2,    0x4b,
+      0x4c, 0x7,    0xa,    0x2,    0x2,    0x4c,   0x4d,   0x5,    0x4,
+      0x3,  0x2,    0x4d,   0x4e,   0x7,    0xb,    0x2,    0x2,    0x4e,
+      0x50, 0x3,    0x2,    0x2,    0x2,    0x4f,   0x49,   0x3,    0x2,
+      0x2,  0x2,    0x4f,   0x4a,   0x3,    0x2,    0x2,    0x2,    0x4f,
+      0x4b, 0x3,    0x2,    0x2,    0x2,    0x50,   0x11,   0x3,    0x2,
+      0x2,  0x2,    0x51,   0x52,   0x7,    0x9,    0x2,    0x2,    0x52,
+      0x53, 0x7,    0xe,    0x2,    0x2,    0x53,   0x13,   0x3,    0x2,
+      0x2,  0x2,    0x54,   0x56,   0x7,    0x12,   0x2,    0x2,    0x55,
+      0x54, 0x3,    0x2,    0x2,    0x2,    0x56,   0x57,   0x3,    0x2,
+      0x2,  0x2,    0x57,   0x55,   0x3,    0x2,    0x2,    0x2,    0x57,
+      0x58, 0x3,    0x2,    0x2,    0x2,    0x58,   0x15,   0x3,    0x2,
+      0x2,  0x2,    0x59,   0x5e,   0x7,    0xf,    0x2,    0x2,    0x5a,
+      0x5e, 0x7,    0xd,    0x2,    0x2,    0x5b,   0x5e,   0x7,    0xe,
+      0x2,  0x2,    0x5c,   0x5e,   0x5,    0x14,   0xb,    0x2,    0x5d,
+      0x59, 0x3,    0x2,    0x2,    0x2,    0x5d,   0x5a,   0x3,    0x2,
+      0x2,  0x2,    0x5d,   0x5b,   0x3,    0x2,    0x2,    0x2,    0x5d,
+      0x5c, 0x3,    0x2,    0x2,    0x2,    0x5e,   0x17,   0x3,    0x2,
+      0x2,  0x2,    0x5f,   0x62,   0x7,    0xc,    0x2,    0x2,    0x60,
+      0x61, 0x7,    0x11,   0x2,    0x2,    0x61,   0x63,   0x7,    0xe,
+      0x2,  0x2,    0x62,   0x60,   0x3,    0x2,    0x2,    0x2,    0x62,
+      0x63, 0x3,    0x2,    0x2,    0x2,    0x63,   0x19,   0x3,    0x2,
+      0x2,  0x2,    0xe,    0x22,   0x28,   0x2b,   0x30,   0x36,   0x3d,
+      0x40, 0x44,   0x4f,   0x57,   0x5d,   0x62,
   };
 
   atn::ATNDeserializer deserializer;
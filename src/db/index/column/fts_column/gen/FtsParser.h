@@ -27,7 +27,8 @@ class FtsParser : public antlr4::Parser {
     NUMBER = 12,
     TERM = 13,
     SPACES = 14,
-    DEFAULT = 15
+    TILDE = 15,
+    DEFAULT = 16
   };
 
   enum {
@@ -273,6 +274,8 @@ class FtsParser : public antlr4::Parser {
                       size_t invoking_state);
     virtual size_t getRuleIndex() const override;
     antlr4::tree::TerminalNode *DQUOTA_STRING();
+    antlr4::tree::TerminalNode *TILDE();
+    antlr4::tree::TerminalNode *NUMBER();
 
     virtual void enterRule(antlr4::tree::ParseTreeListener *listener) override;
     virtual void exitRule(antlr4::tree::ParseTreeListener *listener) override;
@@ -15,20 +15,68 @@
 #include "fts_phrase_iterator.h"
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <unordered_map>
 #include "../fts_utils.h"
+#include "../posting/bitpacked_simd_dispatch.h"
 
 namespace zvec::fts {
 
 PhraseDocIterator::PhraseDocIterator(DocIteratorPtr conjunction,
                                      std::vector<std::string> terms,
                                      RocksdbContext *ctx,
-                                     rocksdb::ColumnFamilyHandle *positions_cf)
+                                     rocksdb::ColumnFamilyHandle *positions_cf,
+                                     uint32_t slop)
     : conjunction_(std::move(conjunction)),
       terms_(std::move(terms)),
+      slop_(slop),
       ctx_(ctx),
       positions_cf_(positions_cf) {
   cached_max_score_ = conjunction_->cached_max_score_;
+  init_unique_terms();
+}
+
+PhraseDocIterator::PhraseDocIterator(DocIteratorPtr conjunction,
+                                     std::vector<std::string> terms,
+                                     FtsMemoryPostings::Ptr memory_postings,
+                                     uint32_t slop)
+    : conjunction_(std::move(conjunction)),
+      terms_(std::move(terms)),
+      slop_(slop),
+      memory_postings_(std::move(memory_postings)) {
+  cached_max_score_ = conjunction_->cached_max_score_;
+  init_unique_terms();
+}
+
+PhraseDocIterator::PhraseDocIterator(DocIteratorPtr conjunction,
+                                     std::vector<std::string> terms,
+                                     FtsSealedPostings::Ptr sealed_postings,
+                                     uint32_t slop)
+    : conjunction_(std::move(conjunction)),
+      terms_(std::move(terms)),
+      slop_(slop),
+      sealed_postings_(std::move(sealed_postings)) {
+  cached_max_score_ = conjunction_->cached_max_score_;
+  init_unique_terms();
+  sealed_positions_.reserve(unique_terms_.size());
+  for (size_t first : unique_terms_) {
+    sealed_positions_.push_back(sealed_postings_->get_positions(terms_[first]));
+  }
+}
+
+void PhraseDocIterator::init_unique_terms() {
+  const size_t n = terms_.size();
+  term_to_unique_.resize(n);
+  std::unordered_map<std::string, size_t> seen;
+  seen.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto [it, inserted] = seen.try_emplace(terms_[i], unique_terms_.size());
+    if (inserted) {
+      unique_terms_.push_back(i);
+    }
+    term_to_unique_[i] = it->second;
+  }
+  positions_.resize(unique_terms_.size());
 }
 
 uint32_t PhraseDocIterator::next_doc() {
@@ -71,37 +119,133 @@ float PhraseDocIterator::max_score() const {
   return conjunction_->max_score();
 }
 
-bool PhraseDocIterator::verify_phrase_positions(uint32_t doc_id) const {
-  const size_t n = terms_.size();
-  if (n == 0) {
+bool PhraseDocIterator::verify_phrase_positions(uint32_t doc_id) {
+  const size_t unique_size = unique_terms_.size();
+  if (unique_size == 0) {
     return false;
   }
 
-  // Deduplicate terms within the phrase. Repeated terms (e.g., "to be or not
-  // to be") collapse into one $POS lookup; term_to_unique_idx maps each phrase
-  // position back to its slot in the unique list.
-  std::vector<size_t> term_to_unique_idx(n);
-  std::vector<size_t> unique_to_first_term_idx;
-  unique_to_first_term_idx.reserve(n);
-  std::unordered_map<std::string, size_t> seen;
-  seen.reserve(n);
+  if (memory_postings_) {
+    for (size_t u = 0; u < unique_size; ++u) {
+      if (!memory_postings_->get_positions(terms_[unique_terms_[u]], doc_id,
+                                           &positions_[u])) {
+        return false;
+      }
+    }
+  } else if (sealed_postings_) {
+    for (size_t u = 0; u < unique_size; ++u) {
+      if (!sealed_positions_[u].find(doc_id, &positions_[u])) {
+        return false;
+      }
+    }
+  } else if (!read_positions(doc_id)) {
+    return false;
+  }
+  for (const auto &positions : positions_) {
+    if (positions.empty()) {
+      return false;
+    }
+  }
+
+  return slop_ == 0 ? match_exact() : match_sloppy();
+}
+
+bool PhraseDocIterator::match_exact() const {
+  const size_t n = terms_.size();
+  // Probe the shortest lists first: they move the candidate start furthest
+  // per probe.  Every cursor only moves forward, so a doc costs one pass
+  // over each list, each step a SIMD find_first_ge.
+  std::vector<size_t> order(n);
   for (size_t i = 0; i < n; ++i) {
-    const size_t next_idx = unique_to_first_term_idx.size();
-    auto [it, inserted] = seen.try_emplace(terms_[i], next_idx);
-    if (inserted) {
-      unique_to_first_term_idx.push_back(i);
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return positions_[term_to_unique_[a]].size() <
+           positions_[term_to_unique_[b]].size();
+  });
+
+  const auto find_first_ge = simd::get_dispatch().find_first_ge;
+  std::vector<size_t> cursors(n, 0);
+  uint32_t start = 0;
+  size_t agreed = 0;
+  for (size_t k = 0; agreed < n; k = (k + 1) % n) {
+    const size_t i = order[k];
+    const auto &positions = positions_[term_to_unique_[i]];
+    const auto size = static_cast<uint32_t>(positions.size());
+    const uint64_t target = uint64_t{start} + i;
+    if (target > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    cursors[i] = find_first_ge(positions.data(), size,
+                               static_cast<uint32_t>(target), cursors[i]);
+    if (cursors[i] == size) {
+      return false;
+    }
+    const uint32_t position = positions[cursors[i]];
+    if (position == target) {
+      ++agreed;
+    } else {
+      // position > target >= i: the phrase cannot start before this.
+      start = position - static_cast<uint32_t>(i);
+      agreed = 1;
     }
-    term_to_unique_idx[i] = it->second;
   }
-  const size_t unique_size = unique_to_first_term_idx.size();
+  return true;
+}
+
+bool PhraseDocIterator::match_sloppy() const {
+  const size_t n = terms_.size();
+  // One cursor per phrase term over x = pos - i.  The window
+  // [min x, max x] only shrinks by dropping its minimum, so advancing the
+  // term at the minimum visits every candidate window once.
+  std::vector<size_t> cursors(n, 0);
+  auto x = [&](size_t i) {
+    return static_cast<int64_t>(positions_[term_to_unique_[i]][cursors[i]]) -
+           static_cast<int64_t>(i);
+  };
+  while (true) {
+    size_t min_i = 0;
+    int64_t min_x = x(0);
+    int64_t max_x = min_x;
+    for (size_t i = 1; i < n; ++i) {
+      const int64_t xi = x(i);
+      if (xi < min_x) {
+        min_x = xi;
+        min_i = i;
+      }
+      max_x = std::max(max_x, xi);
+    }
+    if (max_x - min_x <= static_cast<int64_t>(slop_)) {
+      // A repeated term must occupy distinct positions.
+      bool distinct = true;
+      for (size_t i = 0; i < n && distinct; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+          if (term_to_unique_[i] == term_to_unique_[j] &&
+              cursors[i] == cursors[j]) {
+            distinct = false;
+            break;
+          }
+        }
+      }
+      if (distinct) {
+        return true;
+      }
+    }
+    if (++cursors[min_i] == positions_[term_to_unique_[min_i]].size()) {
+      return false;
+    }
+  }
+}
+
+bool PhraseDocIterator::read_positions(uint32_t doc_id) {
+  const size_t unique_size = unique_terms_.size();
 
   // Build unique (term, doc_id) keys into a single reusable buffer; reserve
   // up-front so the buffer never reallocates and the Slice pointers below stay
   // valid until the MultiGet returns.
   size_t total_key_bytes = 0;
   for (size_t u = 0; u < unique_size; ++u) {
-    total_key_bytes +=
-        terms_[unique_to_first_term_idx[u]].size() + 1 + sizeof(uint32_t);
+    total_key_bytes += terms_[unique_terms_[u]].size() + 1 + sizeof(uint32_t);
   }
   std::string key_buffer;
   key_buffer.reserve(total_key_bytes);
@@ -109,7 +253,7 @@ bool PhraseDocIterator::verify_phrase_positions(uint32_t doc_id) const {
   std::vector<rocksdb::Slice> key_slices;
   key_slices.reserve(unique_size);
   for (size_t u = 0; u < unique_size; ++u) {
-    const std::string &term = terms_[unique_to_first_term_idx[u]];
+    const std::string &term = terms_[unique_terms_[u]];
     const size_t offset = key_buffer.size();
     const size_t bytes = fts::append_doc_term_key(term, doc_id, &key_buffer);
     key_slices.emplace_back(key_buffer.data() + offset, bytes);
@@ -126,58 +270,13 @@ bool PhraseDocIterator::verify_phrase_positions(uint32_t doc_id) const {
   // Decode every position list once. A missing entry means this doc cannot
   // be a phrase match — this happens for docs filtered through the conjunction
   // without a position-CF entry, so we do NOT log here.
-  std::vector<std::vector<uint32_t>> positions_cache(unique_size);
   for (size_t u = 0; u < unique_size; ++u) {
     if (!statuses[u].ok() || values[u].size() == 0) {
       return false;
     }
-    positions_cache[u] = decode_positions(values[u]);
-    if (positions_cache[u].empty()) {
-      return false;
-    }
-  }
-
-  // Pick the term with the shortest position list as anchor so the outer
-  // loop iterates as few candidates as possible. anchor_term_idx stays in
-  // original phrase order — the phrase start equals anchor_pos -
-  // anchor_term_idx.
-  size_t anchor_term_idx = 0;
-  size_t min_size = positions_cache[term_to_unique_idx[0]].size();
-  for (size_t i = 1; i < n; ++i) {
-    const size_t sz = positions_cache[term_to_unique_idx[i]].size();
-    if (sz < min_size) {
-      min_size = sz;
-      anchor_term_idx = i;
-    }
+    positions_[u] = decode_positions(values[u]);
   }
-
-  const auto &anchor_positions =
-      positions_cache[term_to_unique_idx[anchor_term_idx]];
-  const uint32_t anchor_offset = static_cast<uint32_t>(anchor_term_idx);
-  for (uint32_t anchor_pos : anchor_positions) {
-    if (anchor_pos < anchor_offset) {
-      // phrase start would be negative — impossible
-      continue;
-    }
-    const uint32_t start = anchor_pos - anchor_offset;
-    bool phrase_matched = true;
-    for (size_t i = 0; i < n; ++i) {
-      if (i == anchor_term_idx) {
-        continue;
-      }
-      const uint32_t expected = start + static_cast<uint32_t>(i);
-      const auto &positions = positions_cache[term_to_unique_idx[i]];
-      if (!std::binary_search(positions.begin(), positions.end(), expected)) {
-        phrase_matched = false;
-        break;
-      }
-    }
-    if (phrase_matched) {
-      return true;
-    }
-  }
-
-  return false;
+  return true;
 }
 
 std::vector<uint32_t> PhraseDocIterator::decode_positions(
@@ -22,13 +22,17 @@
 #include "fts_conjunction_iterator.h"
 #include "fts_doc_iterator.h"
 #include "../bm25_scorer.h"
+#include "../fts_memory_postings.h"
+#include "../fts_sealed_postings.h"
 
 namespace zvec::fts {
 
 /*! Phrase document iterator (two-phase)
  *
  *  Internally wraps a ConjunctionIterator for phase-1 doc_id intersection.
- *  Phase-2 matches() reads position payloads and checks adjacency.
+ *  Phase-2 matches() reads position payloads and checks adjacency, or with
+ *  a slop, that the terms fall within slop moves of the exact phrase
+ *  (max(pos_i - i) - min(pos_i - i) <= slop, as Lucene measures it).
  */
 class PhraseDocIterator : public DocIterator {
  public:
@@ -36,10 +40,27 @@ class PhraseDocIterator : public DocIterator {
    *  \param conjunction   ConjunctionIterator over all terms in the phrase
    *  \param terms         Processed (tokenized) term strings in phrase order
    *  \param positions_cf  $POS column family for reading position lists
+   *  \param slop          Allowed position moves; 0 means exact adjacency
    */
   PhraseDocIterator(DocIteratorPtr conjunction, std::vector<std::string> terms,
                     RocksdbContext *ctx,
-                    rocksdb::ColumnFamilyHandle *positions_cf);
+                    rocksdb::ColumnFamilyHandle *positions_cf,
+                    uint32_t slop = 0);
+
+  /*! Construct a phrase iterator over a writing segment.
+   *  Positions are read from the in-memory posting buffer instead of $POS;
+   *  the shared_ptr keeps the buffer alive if the indexer seals meanwhile.
+   */
+  PhraseDocIterator(DocIteratorPtr conjunction, std::vector<std::string> terms,
+                    FtsMemoryPostings::Ptr memory_postings, uint32_t slop = 0);
+
+  /*! Construct a phrase iterator over a sealed segment.
+   *  Each term's positions are located in the mapped positions file once,
+   *  here; matches() then moves one cursor per term forward through the
+   *  skip entries, decoding only the blocks and chunks it lands on.
+   */
+  PhraseDocIterator(DocIteratorPtr conjunction, std::vector<std::string> terms,
+                    FtsSealedPostings::Ptr sealed_postings, uint32_t slop = 0);
 
   uint32_t next_doc() override;
   //! Internal-driven filter skip: delegates to the inner conjunction so the
@@ -61,10 +82,24 @@ class PhraseDocIterator : public DocIterator {
   }
 
  private:
+  // Map repeated phrase terms onto one slot each, so a term's positions are
+  // read once per doc (e.g. "to be or not to be" reads four lists).
+  void init_unique_terms();
+
   // Verify that terms appear at consecutive positions in the document.
-  // Issues a single MultiGet across the unique terms in the phrase, decodes
-  // every position list once, then validates adjacency entirely in memory.
-  bool verify_phrase_positions(uint32_t doc_id) const;
+  // Loads every unique term's position list once (one MultiGet on $POS, the
+  // in-memory buffer or the sealed cursors), then matches in memory.
+  bool verify_phrase_positions(uint32_t doc_id);
+
+  // Exact phrase: leapfrog the candidate start across the per-term lists.
+  bool match_exact() const;
+
+  // Sloppy phrase: sweep the smallest window over pos_i - i.
+  bool match_sloppy() const;
+
+  // Read the position lists of the unique phrase terms for doc_id from $POS.
+  // Returns false if any term has no positions in the document.
+  bool read_positions(uint32_t doc_id);
 
   // Decode varint delta-encoded position list out of a RocksDB value slice.
   static std::vector<uint32_t> decode_positions(const rocksdb::Slice &data);
@@ -72,8 +107,19 @@ class PhraseDocIterator : public DocIterator {
  private:
   DocIteratorPtr conjunction_;
   std::vector<std::string> terms_;
-  RocksdbContext *ctx_;
-  rocksdb::ColumnFamilyHandle *positions_cf_;
+  uint32_t slop_{0};
+  // Per phrase term, its slot in unique_terms_; per slot, the term's first
+  // index in terms_.
+  std::vector<size_t> term_to_unique_;
+  std::vector<size_t> unique_terms_;
+  // Per slot, the positions of the current doc (reused across docs).
+  std::vector<std::vector<uint32_t>> positions_;
+  RocksdbContext *ctx_{nullptr};
+  rocksdb::ColumnFamilyHandle *positions_cf_{nullptr};
+  FtsMemoryPostings::Ptr memory_postings_{};
+  FtsSealedPostings::Ptr sealed_postings_{};
+  // Per slot, a cursor over its positions in sealed_postings_.
+  std::vector<FtsSealedPostings::TermPositions> sealed_positions_;
   // Cache matches() result per doc_id to avoid redundant $POS MultiGet when
   // DisjunctionIterator calls matches() from both matches() and score().
   uint32_t cached_matches_doc_id_{NO_MORE_DOCS};
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "fts_term_iterator.h"
+#include <algorithm>
 #include <cstring>
 #include <roaring/roaring.h>
 #include <zvec/ailego/logger/logger.h>
@@ -81,6 +82,7 @@ TermDocIterator::TermDocIterator(std::string term,
   max_score_val_ = bp_iter_.max_score() * boost_;
   cached_max_score_ = max_score_val_;
   idf_weight_ = scorer_->idf(df_);
+  update_block_score_params();
 }
 
 // ============================================================
@@ -131,10 +133,8 @@ float TermDocIterator::score() {
   }
 
   if (mode_ == Mode::BITPACKED) {
-    // Fast path: read tf/doc_len from inline payload (zero I/O)
-    const uint32_t tf = bp_iter_.term_freq();
-    const uint32_t dl = bp_iter_.doc_len();
-    return scorer_->score_with_idf(idf_weight_, tf, dl, boost_);
+    // Fast path: block-at-a-time scores from the inline payload (zero I/O)
+    return zero_scores_ ? 0.0f : bp_iter_.score();
   }
 
   // Roaring mode: read from RocksDB
@@ -143,6 +143,54 @@ float TermDocIterator::score() {
   return scorer_->score_with_idf(idf_weight_, tf, doc_len, boost_);
 }
 
+void TermDocIterator::use_collection_stats(BM25ScorerPtr collection_scorer,
+                                           uint64_t collection_df) {
+  const float segment_idf = idf_weight_;
+  const float segment_avgdl = scorer_->stats().avg_doc_len();
+  scorer_ = std::move(collection_scorer);
+  // A segment whose term is unknown to the collection (stats taken before a
+  // concurrent insert) still needs a sane df.
+  const uint64_t df = std::max(collection_df, df_);
+  idf_weight_ = scorer_->idf(df);
+
+  // score = idf * tf*(k1+1) / (tf + k1*(1-b+b*dl/avgdl)).  The idf part
+  // scales exactly; the tf part grows by at most avgdl'/avgdl when the
+  // average doc length grows and shrinks otherwise.  The small epsilon keeps
+  // float rounding from turning a bound into an underestimate.  Calls
+  // compose, so the stored block bounds may be rescaled more than once.
+  if (segment_idf > 0.0f && segment_avgdl > 0.0f) {
+    const float length_scale =
+        std::max(1.0f, scorer_->stats().avg_doc_len() / segment_avgdl);
+    const float scale = idf_weight_ / segment_idf * length_scale * 1.0001f;
+    bound_scale_ *= scale;
+    max_score_val_ *= scale;
+  } else {
+    bound_scale_ = 0.0f;
+    max_score_val_ = scorer_->max_score_bound(df) * boost_;
+  }
+  cached_max_score_ = max_score_val_;
+  update_block_score_params();
+}
+
+void TermDocIterator::update_block_score_params() {
+  if (mode_ != Mode::BITPACKED) {
+    return;
+  }
+  // The constants of score_with_idf(); the stats of a sealed segment, and
+  // of a query's collection scorer, do not change while iterating.
+  const auto stats = scorer_->stats();
+  zero_scores_ = idf_weight_ <= 0.0f || stats.total_docs == 0;
+  const BM25Params &params = scorer_->params();
+  simd::BM25BlockParams block_params;
+  block_params.weight = boost_ * idf_weight_;
+  block_params.k1 = params.k1;
+  block_params.k1_plus_1 = params.k1 + 1.0f;
+  block_params.b = params.b;
+  block_params.one_minus_b = 1.0f - params.b;
+  block_params.avg_dl = stats.avg_doc_len();
+  bp_iter_.set_score_params(block_params);
+}
+
 uint64_t TermDocIterator::cost() const {
   if (mode_ == Mode::BITPACKED) {
     return bp_iter_.cost();
@@ -158,9 +206,13 @@ DocIterator::BlockMaxInfo TermDocIterator::block_max_info_for(
     uint32_t target) const {
   if (mode_ == Mode::BITPACKED) {
     auto info = bp_iter_.block_max_info_for(target);
+    if (bound_scale_ == 0.0f) {
+      return {max_score_val_, info.block_last_doc};
+    }
     // Apply boost so the upper bound matches score() (which multiplies by
     // boost_) and stays consistent with max_score_val_ for WAND pivoting.
-    return {info.block_max_score * boost_, info.block_last_doc};
+    return {info.block_max_score * boost_ * bound_scale_,
+            info.block_last_doc};
   }
   // Roaring mode: fall back to global max_score (already boosted in ctor),
   // no block structure available.
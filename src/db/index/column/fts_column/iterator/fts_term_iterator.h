@@ -28,7 +28,8 @@ namespace zvec::fts {
 /*! Term document iterator
  *  Supports two internal modes:
  *    1. Roaring mode: sorted doc_id array + RocksDB Get for tf/doc_len
- *    2. BitPacked mode: inline payloads, zero RocksDB I/O for score()
+ *    2. BitPacked mode: inline payloads, zero RocksDB I/O for score(); each
+ *       block is scored at once on its first score() call
  */
 class TermDocIterator : public DocIterator {
  public:
@@ -99,6 +100,18 @@ class TermDocIterator : public DocIterator {
   // Block-Max WAND support (only effective in BitPacked mode)
   BlockMaxInfo block_max_info_for(uint32_t target) const override;
 
+  /*! Score with collection-wide statistics instead of the segment's.
+   *  The WAND and block-max bounds stored with the posting were computed
+   *  with the current scorer; they are rescaled so they still bound the
+   *  scores produced by \p collection_scorer.  Also used to move a cached
+   *  writing-segment encoding to the segment's current stats.
+   *  \param collection_scorer  Scorer loaded with the collection stats
+   *  \param collection_df      Document frequency of the term across the
+   *                            collection
+   */
+  void use_collection_stats(BM25ScorerPtr collection_scorer,
+                            uint64_t collection_df);
+
  private:
   // Read term frequency for the current document (Roaring mode only)
   uint32_t read_term_freq(uint32_t doc_id) const;
@@ -106,6 +119,9 @@ class TermDocIterator : public DocIterator {
   // Read document length for the current document (Roaring mode only)
   uint32_t read_doc_len(uint32_t doc_id) const;
 
+  // Hand the scorer's constants to bp_iter_ (BitPacked mode only)
+  void update_block_score_params();
+
  private:
   enum class Mode { ROARING, BITPACKED };
   Mode mode_;
@@ -116,6 +132,9 @@ class TermDocIterator : public DocIterator {
   float max_score_val_;
   float idf_weight_{0.0f};  // Pre-computed IDF to avoid log() per score()
   float boost_{1.0f};       // Per-term boost (collapsed from repeated terms)
+  // Factor applied to the stored block-max scores; 0 means the stored bounds
+  // cannot be rescaled and max_score_val_ bounds every block instead.
+  float bound_scale_{1.0f};
 
   // Roaring mode state (owns the bitmap; iterator is stack-allocated)
   roaring_bitmap_t *bitmap_{nullptr};
@@ -129,6 +148,9 @@ class TermDocIterator : public DocIterator {
   // BitPacked mode state
   rocksdb::PinnableSlice packed_data_;  // owns the serialized data (zero-copy)
   BitPackedPostingIterator bp_iter_;    // zero-copy iterator over packed_data_
+  // Whether score_with_idf() would score every doc 0 (non-positive IDF or
+  // empty stats); bp_iter_ scores are then not consulted.
+  bool zero_scores_{false};
 };
 
 }  // namespace zvec::fts
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "fts_query_parser.h"
+#include <limits>
 #include <zvec/ailego/utility/string_helper.h>
 #include "db/index/column/fts_column/gen/FtsLexer.h"
 #include "db/index/column/fts_column/gen/FtsParser.h"
@@ -167,12 +168,28 @@ FtsAstNodePtr build_fts_atom(FtsParser::Fts_atomContext *atom_ctx, bool is_must,
   }
 
   if (primary_ctx->fts_phrase() != nullptr) {
-    std::string raw = primary_ctx->fts_phrase()->getText();
+    FtsParser::Fts_phraseContext *phrase_ctx = primary_ctx->fts_phrase();
+    uint32_t slop = 0;
+    if (phrase_ctx->NUMBER() != nullptr) {
+      // Phrase slop: `"a b"~2`.
+      const std::string digits = phrase_ctx->NUMBER()->getText();
+      if (digits.find('.') != std::string::npos) {
+        if (err_msg) {
+          *err_msg = "phrase slop must be a non-negative integer";
+        }
+        return nullptr;
+      }
+      // Any slop past the longest document behaves the same; clamp.
+      slop = digits.size() > 9 ? std::numeric_limits<uint32_t>::max()
+                               : static_cast<uint32_t>(std::stoul(digits));
+    }
+    std::string raw = phrase_ctx->DQUOTA_STRING()->getText();
     std::string phrase_text = unescape(strip_quotes(raw));
     auto tokens = pipeline.process(phrase_text);
     auto phrase_node = std::make_unique<PhraseNode>();
     phrase_node->must = is_must;
     phrase_node->must_not = is_must_not;
+    phrase_node->slop = slop;
     phrase_node->terms.reserve(tokens.size());
     for (auto &t : tokens) {
       phrase_node->terms.push_back(std::move(t.text));
@@ -18,6 +18,7 @@
 #include <memory>
 #include <zvec/ailego/logger/logger.h>
 #include "bitpacked_simd_dispatch.h"
+#include "bitpacked_simd_scalar.h"
 
 #ifdef _MSC_VER
 #include <intrin.h>
@@ -396,6 +397,7 @@ int BitPackedPostingIterator::open(const char *data, size_t size) {
   prefix_sum_fn_ = dispatch.prefix_sum_128;
   find_first_ge_fn_ = dispatch.find_first_ge;
   unpack_fn_ = dispatch.unpack_uint32_128;
+  decode_score_fn_ = dispatch.decode_score_128;
 
   return 0;
 }
@@ -476,6 +478,7 @@ void BitPackedPostingIterator::decode_block(size_t block_idx) {
   // Reset lazy decode flags
   tf_decoded_ = false;
   dl_decoded_ = false;
+  block_scored_ = false;
 
   block_decoded_ = true;
 }
@@ -647,6 +650,21 @@ void BitPackedPostingIterator::ensure_dl_decoded() {
   dl_decoded_ = true;
 }
 
+void BitPackedPostingIterator::score_block() {
+  if (current_block_is_full_) {
+    // Fused path: tf and doc_len go straight from the packed block to scores
+    decode_score_fn_(packed_tf_ptr_, current_bitwidth_tf_, packed_dl_ptr_,
+                     current_bitwidth_dl_, score_params_, block_scores_);
+  } else {
+    ensure_tf_decoded();
+    ensure_dl_decoded();
+    simd::scalar_bm25_scores(block_tfs_, block_doc_lens_,
+                             current_block_num_docs_, score_params_,
+                             block_scores_);
+  }
+  block_scored_ = true;
+}
+
 uint32_t BitPackedPostingIterator::term_freq() {
   if (!block_decoded_ || in_block_pos_ >= current_block_size_) {
     return 0;
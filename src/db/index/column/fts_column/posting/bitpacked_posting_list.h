@@ -150,6 +150,25 @@ class BitPackedPostingIterator {
   /// NOTE: non-const because lazy decode may be triggered on first access.
   uint32_t doc_len();
 
+  /// Set the BM25 constants score() applies; call before scoring.
+  void set_score_params(const simd::BM25BlockParams &params) {
+    score_params_ = params;
+    block_scored_ = false;
+  }
+
+  /// BM25 score of the current document (valid after next_doc/advance).
+  /// The first call in a block decodes the tf and doc_len of all its docs
+  /// and scores them in one kernel pass; later calls read the result.
+  float score() {
+    if (!block_decoded_ || in_block_pos_ >= current_block_size_) {
+      return 0.0f;
+    }
+    if (!block_scored_) {
+      score_block();
+    }
+    return block_scores_[in_block_pos_];
+  }
+
   /// Return both block_max_score and max_doc_id for the block containing
   /// \p target in a single binary search on the skip list.
   /// Does NOT move the iterator position.
@@ -179,6 +198,9 @@ class BitPackedPostingIterator {
   /// Lazy decode: ensure doc_len values are decoded before access.
   void ensure_dl_decoded();
 
+  /// Score every doc of the current block into block_scores_.
+  void score_block();
+
   /// SIMD search: find first index i in block_doc_ids_[start..size)
   /// where doc_id >= target. Uses SSE4.1 for 4-wide comparison.
   size_t simd_find_first_ge(uint32_t target, size_t start) const;
@@ -207,6 +229,11 @@ class BitPackedPostingIterator {
   bool tf_decoded_{false};
   bool dl_decoded_{false};
 
+  // Block scores, computed on the first score() call in a block
+  alignas(16) float block_scores_[BitPackedPostingList::DOCS_PER_BLOCK];
+  bool block_scored_{false};
+  simd::BM25BlockParams score_params_{};
+
   // Store packed data pointers for lazy decode
   const uint8_t *packed_tf_ptr_{nullptr};
   const uint8_t *packed_dl_ptr_{nullptr};
@@ -224,6 +251,7 @@ class BitPackedPostingIterator {
   simd::PrefixSumFunc prefix_sum_fn_{nullptr};
   simd::FindFirstGeFunc find_first_ge_fn_{nullptr};
   simd::UnpackFunc unpack_fn_{nullptr};
+  simd::DecodeScoreFunc decode_score_fn_{nullptr};
 
   // Cache for block_max_info_for to avoid repeated binary searches.
   // If target falls within [cached_bmi_block_min_doc_+1, cached_bmi_last_doc_],
@@ -0,0 +1,479 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bitpacked_simd_avx512.h"
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+#include "bitpacked_posting_list.h"
+#include "bitpacked_simd_sse41.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static inline int ctz_u32(unsigned int v) {
+  unsigned long index;
+  _BitScanForward(&index, v);
+  return static_cast<int>(index);
+}
+#else
+static inline int ctz_u32(unsigned int v) {
+  return __builtin_ctz(v);
+}
+#endif
+
+namespace zvec::fts::simd {
+
+// ------------------------------------------------------------
+// Unpackers
+// ------------------------------------------------------------
+//
+// The packed layout (see scalar_pack_uint32_128) interleaves 4 lanes: value
+// 4k+L is the k-th value of lane L, stored at bit k*bitwidth of the lane's
+// bitstream, whose 32-bit words sit at dwords 4w+L of the block.  A group of
+// 16 output values (k = 4g..4g+3 of every lane) therefore reads a window of
+// at most 5 consecutive 128-bit words, which two masked 512-bit loads cover
+// without touching bytes past the block.
+
+namespace {
+
+constexpr uint32_t kGroups = BitPackedPostingList::DOCS_PER_BLOCK / 16;
+
+inline uint32_t value_mask(uint8_t bitwidth) {
+  return bitwidth >= 32 ? 0xFFFFFFFFu : (1u << bitwidth) - 1u;
+}
+
+// Mask of the first \p n of 16 elements.
+inline __mmask16 first_n_mask16(uint32_t n) {
+  return n >= 16 ? static_cast<__mmask16>(0xFFFF)
+                 : static_cast<__mmask16>((1u << n) - 1u);
+}
+
+class DwordUnpacker {
+ public:
+  DwordUnpacker(const uint8_t *in, uint8_t bitwidth)
+      : in_(reinterpret_cast<const uint32_t *>(in)),
+        bitwidth_(bitwidth),
+        num_dwords_(uint32_t{bitwidth} * 4),
+        mask_(_mm512_set1_epi32(static_cast<int>(value_mask(bitwidth)))),
+        // Bit offset of k = 4g+j relative to k = 4g, per output element.
+        step_(_mm512_mullo_epi32(
+            _mm512_set_epi32(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0),
+            _mm512_set1_epi32(bitwidth))) {}
+
+  __m512i group(uint32_t g) const {
+    const uint32_t first_bit = 4 * g * bitwidth_;
+    const uint32_t first_dword = (first_bit >> 5) * 4;
+    const uint32_t available =
+        num_dwords_ > first_dword ? num_dwords_ - first_dword : 0;
+    const __m512i words_lo = _mm512_maskz_loadu_epi32(
+        first_n_mask16(available), in_ + first_dword);
+    const __m512i words_hi = _mm512_maskz_loadu_epi32(
+        first_n_mask16(available > 16 ? available - 16 : 0),
+        in_ + first_dword + 16);
+
+    const __m512i lanes =
+        _mm512_set_epi32(3, 2, 1, 0, 3, 2, 1, 0, 3, 2, 1, 0, 3, 2, 1, 0);
+    const __m512i bit =
+        _mm512_add_epi32(_mm512_set1_epi32(first_bit & 31), step_);
+    const __m512i shift = _mm512_and_si512(bit, _mm512_set1_epi32(31));
+    const __m512i lo_index = _mm512_add_epi32(
+        _mm512_slli_epi32(_mm512_srli_epi32(bit, 5), 2), lanes);
+    const __m512i hi_index = _mm512_add_epi32(lo_index, _mm512_set1_epi32(4));
+    const __m512i lo = _mm512_permutex2var_epi32(words_lo, lo_index, words_hi);
+    const __m512i hi = _mm512_permutex2var_epi32(words_lo, hi_index, words_hi);
+    // A shift count of 32 yields 0, so a value within one word drops `hi`.
+    const __m512i value = _mm512_or_si512(
+        _mm512_srlv_epi32(lo, shift),
+        _mm512_sllv_epi32(hi, _mm512_sub_epi32(_mm512_set1_epi32(32), shift)));
+    return _mm512_and_si512(value, mask_);
+  }
+
+ private:
+  const uint32_t *in_;
+  uint32_t bitwidth_;
+  uint32_t num_dwords_;
+  __m512i mask_;
+  __m512i step_;
+};
+
+// BM25 scores of 16 postings.  Explicitly rounded operations are never
+// contracted into FMAs, so the evaluation order of scalar_bm25_scores() and
+// with it every bit of the result is kept.
+inline __m512 bm25_scores(__m512i tfs, __m512i doc_lens,
+                          const BM25BlockParams &params) {
+  constexpr int kRound = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+  const __m512 tf = _mm512_cvtepu32_ps(tfs);
+  const __m512 doc_len = _mm512_cvtepu32_ps(doc_lens);
+  __m512 norm = _mm512_div_round_ps(
+      _mm512_mul_round_ps(_mm512_set1_ps(params.b), doc_len, kRound),
+      _mm512_set1_ps(params.avg_dl), kRound);
+  norm = _mm512_add_round_ps(_mm512_set1_ps(params.one_minus_b), norm, kRound);
+  const __m512 denom = _mm512_add_round_ps(
+      tf, _mm512_mul_round_ps(_mm512_set1_ps(params.k1), norm, kRound),
+      kRound);
+  const __m512 tf_norm = _mm512_div_round_ps(
+      _mm512_mul_round_ps(tf, _mm512_set1_ps(params.k1_plus_1), kRound),
+      denom, kRound);
+  return _mm512_mul_round_ps(_mm512_set1_ps(params.weight), tf_norm, kRound);
+}
+
+template <typename Unpacker>
+void unpack_128(const Unpacker &unpacker, uint32_t *out) {
+  for (uint32_t g = 0; g < kGroups; ++g) {
+    _mm512_storeu_si512(out + 16 * g, unpacker.group(g));
+  }
+}
+
+template <typename TfUnpacker, typename DlUnpacker>
+void decode_score_128(const TfUnpacker &tfs, const DlUnpacker &doc_lens,
+                      const BM25BlockParams &params, float *scores) {
+  for (uint32_t g = 0; g < kGroups; ++g) {
+    _mm512_storeu_ps(scores + 16 * g,
+                     bm25_scores(tfs.group(g), doc_lens.group(g), params));
+  }
+}
+
+}  // namespace
+
+// ------------------------------------------------------------
+// avx512_max_128
+// ------------------------------------------------------------
+
+void avx512_max_128(const uint32_t *deltas, const uint32_t *tfs,
+                    const uint32_t *doc_lens, size_t start, uint32_t count,
+                    uint32_t &max_delta, uint32_t &max_tf, uint32_t &max_dl) {
+  __m512i vmax_delta = _mm512_setzero_si512();
+  __m512i vmax_tf = _mm512_setzero_si512();
+  __m512i vmax_dl = _mm512_setzero_si512();
+  for (uint32_t i = 0; i < count; i += 16) {
+    const __mmask16 valid = first_n_mask16(count - i);
+    vmax_delta = _mm512_max_epu32(
+        vmax_delta, _mm512_maskz_loadu_epi32(valid, &deltas[start + i]));
+    vmax_tf = _mm512_max_epu32(
+        vmax_tf, _mm512_maskz_loadu_epi32(valid, &tfs[start + i]));
+    vmax_dl = _mm512_max_epu32(
+        vmax_dl, _mm512_maskz_loadu_epi32(valid, &doc_lens[start + i]));
+  }
+  max_delta = _mm512_reduce_max_epu32(vmax_delta);
+  max_tf = _mm512_reduce_max_epu32(vmax_tf);
+  max_dl = _mm512_reduce_max_epu32(vmax_dl);
+}
+
+// ------------------------------------------------------------
+// avx512_pack_uint32_128 — fallback to SSE4.1
+// ------------------------------------------------------------
+
+void avx512_pack_uint32_128(const uint32_t *in, uint8_t bitwidth,
+                            uint8_t *out) {
+  sse41_pack_uint32_128(in, bitwidth, out);
+}
+
+// ------------------------------------------------------------
+// avx512_unpack_uint32_128
+// ------------------------------------------------------------
+
+void avx512_unpack_uint32_128(const uint8_t *in, uint8_t bitwidth,
+                              uint32_t *out) {
+  unpack_128(DwordUnpacker(in, bitwidth), out);
+}
+
+// ------------------------------------------------------------
+// avx512_prefix_sum_128
+// ------------------------------------------------------------
+
+void avx512_prefix_sum_128(const uint32_t *deltas, uint32_t min_doc_id,
+                           uint32_t /*count*/, uint32_t *out) {
+  // deltas[0] is replaced by min_doc_id through the initial carry.
+  __m512i carry = _mm512_set1_epi32(static_cast<int>(min_doc_id - deltas[0]));
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i last = _mm512_set1_epi32(15);
+  for (uint32_t g = 0; g < kGroups; ++g) {
+    __m512i v = _mm512_loadu_si512(deltas + 16 * g);
+    // In-register inclusive scan: add copies shifted up by 1, 2, 4, 8.
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 15));
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 14));
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 12));
+    v = _mm512_add_epi32(v, _mm512_alignr_epi32(v, zero, 8));
+    v = _mm512_add_epi32(v, carry);
+    _mm512_storeu_si512(out + 16 * g, v);
+    carry = _mm512_permutexvar_epi32(last, v);
+  }
+}
+
+// ------------------------------------------------------------
+// avx512_find_first_ge
+// ------------------------------------------------------------
+
+size_t avx512_find_first_ge(const uint32_t *arr, uint32_t size,
+                            uint32_t target, size_t start) {
+  const __m512i vtarget = _mm512_set1_epi32(static_cast<int>(target));
+  size_t i = start;
+  for (; i + 16 <= size; i += 16) {
+    const __mmask16 ge =
+        _mm512_cmpge_epu32_mask(_mm512_loadu_si512(arr + i), vtarget);
+    if (ge != 0) {
+      return i + ctz_u32(ge);
+    }
+  }
+  if (i < size) {
+    const __mmask16 valid = first_n_mask16(static_cast<uint32_t>(size - i));
+    const __mmask16 ge = _mm512_mask_cmpge_epu32_mask(
+        valid, _mm512_maskz_loadu_epi32(valid, arr + i), vtarget);
+    if (ge != 0) {
+      return i + ctz_u32(ge);
+    }
+  }
+  return size;
+}
+
+// ------------------------------------------------------------
+// avx512_decode_score_128
+// ------------------------------------------------------------
+
+void avx512_decode_score_128(const uint8_t *packed_tfs, uint8_t bitwidth_tf,
+                             const uint8_t *packed_doc_lens,
+                             uint8_t bitwidth_dl,
+                             const BM25BlockParams &params, float *scores) {
+  decode_score_128(DwordUnpacker(packed_tfs, bitwidth_tf),
+                   DwordUnpacker(packed_doc_lens, bitwidth_dl), params,
+                   scores);
+}
+
+bool avx512_kernels_compiled() {
+  return true;
+}
+
+}  // namespace zvec::fts::simd
+
+#if defined(__AVX512VBMI__) && defined(__AVX512BW__)
+
+namespace zvec::fts::simd {
+
+// ------------------------------------------------------------
+// VBMI unpacker
+// ------------------------------------------------------------
+//
+// Up to 25 bits, a value starting at lane bit p lies within the 32 lane bits
+// from (p & ~7), i.e. four whole bytes of the lane's bitstream.  A per
+// bitwidth table lists, for each group, where those bytes sit in a 128-byte
+// window of the block, so one byte permute gathers every value's bytes and
+// a variable shift by (p & 7) aligns it.
+
+namespace {
+
+constexpr uint8_t kMaxVbmiBitwidth = 25;
+
+struct VbmiGroup {
+  alignas(64) uint8_t index[64];
+  alignas(16) uint8_t shift[16];
+  uint32_t first_byte;
+};
+
+class VbmiTables {
+ public:
+  VbmiTables() {
+    for (uint32_t bitwidth = 1; bitwidth <= kMaxVbmiBitwidth; ++bitwidth) {
+      for (uint32_t g = 0; g < kGroups; ++g) {
+        VbmiGroup &group = groups_[bitwidth][g];
+        const uint32_t first_word = (4 * g * bitwidth) >> 5;
+        group.first_byte = first_word * 16;
+        for (uint32_t i = 0; i < 16; ++i) {
+          const uint32_t k = 4 * g + i / 4;
+          const uint32_t lane = i % 4;
+          const uint32_t bit = k * bitwidth - first_word * 32;
+          group.shift[i] = static_cast<uint8_t>(bit & 7);
+          for (uint32_t j = 0; j < 4; ++j) {
+            const uint32_t lane_bit = (bit & ~7u) + 8 * j;
+            group.index[i * 4 + j] = static_cast<uint8_t>(
+                ((lane_bit >> 5) * 4 + lane) * 4 + ((lane_bit >> 3) & 3));
+          }
+        }
+      }
+    }
+  }
+
+  const VbmiGroup *groups(uint8_t bitwidth) const {
+    return groups_[bitwidth];
+  }
+
+ private:
+  VbmiGroup groups_[kMaxVbmiBitwidth + 1][kGroups];
+};
+
+const VbmiTables &vbmi_tables() {
+  static const VbmiTables tables;
+  return tables;
+}
+
+// Mask of the first \p n of 64 bytes.
+inline __mmask64 first_n_mask64(uint32_t n) {
+  return n >= 64 ? ~__mmask64{0} : (__mmask64{1} << n) - 1;
+}
+
+class VbmiUnpacker {
+ public:
+  //! \p bitwidth must be in [1, kMaxVbmiBitwidth].
+  VbmiUnpacker(const uint8_t *in, uint8_t bitwidth)
+      : in_(in),
+        num_bytes_(uint32_t{bitwidth} * 16),
+        groups_(vbmi_tables().groups(bitwidth)),
+        mask_(_mm512_set1_epi32(static_cast<int>(value_mask(bitwidth)))) {}
+
+  __m512i group(uint32_t g) const {
+    const VbmiGroup &group = groups_[g];
+    const uint32_t available = num_bytes_ - group.first_byte;
+    const __m512i bytes_lo = _mm512_maskz_loadu_epi8(
+        first_n_mask64(available), in_ + group.first_byte);
+    const __m512i bytes_hi = _mm512_maskz_loadu_epi8(
+        first_n_mask64(available > 64 ? available - 64 : 0),
+        in_ + group.first_byte + 64);
+    const __m512i value = _mm512_permutex2var_epi8(
+        bytes_lo, _mm512_load_si512(group.index), bytes_hi);
+    const __m512i shift = _mm512_cvtepu8_epi32(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(group.shift)));
+    return _mm512_and_si512(_mm512_srlv_epi32(value, shift), mask_);
+  }
+
+ private:
+  const uint8_t *in_;
+  uint32_t num_bytes_;
+  const VbmiGroup *groups_;
+  __m512i mask_;
+};
+
+inline bool vbmi_fits(uint8_t bitwidth) {
+  return bitwidth >= 1 && bitwidth <= kMaxVbmiBitwidth;
+}
+
+}  // namespace
+
+void avx512_vbmi_unpack_uint32_128(const uint8_t *in, uint8_t bitwidth,
+                                   uint32_t *out) {
+  if (vbmi_fits(bitwidth)) {
+    unpack_128(VbmiUnpacker(in, bitwidth), out);
+  } else {
+    unpack_128(DwordUnpacker(in, bitwidth), out);
+  }
+}
+
+void avx512_vbmi_decode_score_128(const uint8_t *packed_tfs,
+                                  uint8_t bitwidth_tf,
+                                  const uint8_t *packed_doc_lens,
+                                  uint8_t bitwidth_dl,
+                                  const BM25BlockParams &params,
+                                  float *scores) {
+  const bool vbmi_tf = vbmi_fits(bitwidth_tf);
+  const bool vbmi_dl = vbmi_fits(bitwidth_dl);
+  if (vbmi_tf && vbmi_dl) {
+    decode_score_128(VbmiUnpacker(packed_tfs, bitwidth_tf),
+                     VbmiUnpacker(packed_doc_lens, bitwidth_dl), params,
+                     scores);
+  } else if (vbmi_tf) {
+    decode_score_128(VbmiUnpacker(packed_tfs, bitwidth_tf),
+                     DwordUnpacker(packed_doc_lens, bitwidth_dl), params,
+                     scores);
+  } else if (vbmi_dl) {
+    decode_score_128(DwordUnpacker(packed_tfs, bitwidth_tf),
+                     VbmiUnpacker(packed_doc_lens, bitwidth_dl), params,
+                     scores);
+  } else {
+    avx512_decode_score_128(packed_tfs, bitwidth_tf, packed_doc_lens,
+                            bitwidth_dl, params, scores);
+  }
+}
+
+bool avx512_vbmi_kernels_compiled() {
+  return true;
+}
+
+}  // namespace zvec::fts::simd
+
+#else  // !(defined(__AVX512VBMI__) && defined(__AVX512BW__))
+
+// Without VBMI at compile time the VBMI entry points run the AVX-512F code;
+// avx512_vbmi_kernels_compiled() keeps the dispatcher from preferring them.
+
+namespace zvec::fts::simd {
+
+void avx512_vbmi_unpack_uint32_128(const uint8_t *in, uint8_t bitwidth,
+                                   uint32_t *out) {
+  avx512_unpack_uint32_128(in, bitwidth, out);
+}
+
+void avx512_vbmi_decode_score_128(const uint8_t *packed_tfs,
+                                  uint8_t bitwidth_tf,
+                                  const uint8_t *packed_doc_lens,
+                                  uint8_t bitwidth_dl,
+                                  const BM25BlockParams &params,
+                                  float *scores) {
+  avx512_decode_score_128(packed_tfs, bitwidth_tf, packed_doc_lens,
+                          bitwidth_dl, params, scores);
+}
+
+bool avx512_vbmi_kernels_compiled() {
+  return false;
+}
+
+}  // namespace zvec::fts::simd
+
+#endif  // defined(__AVX512VBMI__) && defined(__AVX512BW__)
+
+#else  // !defined(__AVX512F__)
+
+// Stub implementations when AVX-512 is not available at compile time.
+// avx512_kernels_compiled() returns false, so the runtime dispatch layer
+// (bitpacked_simd_dispatch.cc) never calls these, but the linker still needs
+// the symbols.
+
+namespace zvec::fts::simd {
+
+bool avx512_kernels_compiled() {
+  return false;
+}
+
+bool avx512_vbmi_kernels_compiled() {
+  return false;
+}
+
+void avx512_max_128(const uint32_t *, const uint32_t *, const uint32_t *,
+                    size_t, uint32_t, uint32_t &max_delta, uint32_t &max_tf,
+                    uint32_t &max_dl) {
+  max_delta = 0;
+  max_tf = 0;
+  max_dl = 0;
+}
+
+void avx512_pack_uint32_128(const uint32_t *, uint8_t, uint8_t *) {}
+
+void avx512_unpack_uint32_128(const uint8_t *, uint8_t, uint32_t *) {}
+
+void avx512_vbmi_unpack_uint32_128(const uint8_t *, uint8_t, uint32_t *) {}
+
+void avx512_prefix_sum_128(const uint32_t *, uint32_t, uint32_t, uint32_t *) {}
+
+size_t avx512_find_first_ge(const uint32_t *, uint32_t size, uint32_t,
+                            size_t) {
+  return size;
+}
+
+void avx512_decode_score_128(const uint8_t *, uint8_t, const uint8_t *,
+                             uint8_t, const BM25BlockParams &, float *) {}
+
+void avx512_vbmi_decode_score_128(const uint8_t *, uint8_t, const uint8_t *,
+                                  uint8_t, const BM25BlockParams &, float *) {}
+
+}  // namespace zvec::fts::simd
+
+#endif  // defined(__AVX512F__)
@@ -0,0 +1,81 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "bitpacked_simd_dispatch.h"
+
+namespace zvec::fts::simd {
+
+/// Whether this build compiled the AVX-512F kernels below.  The compiler may
+/// lack AVX-512 support, in which case they are stubs that must not be
+/// dispatched to even on an AVX-512 machine.
+bool avx512_kernels_compiled();
+
+/// Whether this build compiled the AVX-512 VBMI unpacker.
+bool avx512_vbmi_kernels_compiled();
+
+/// Compute element-wise max of \p count uint32 values across three arrays
+/// using AVX-512 _mm512_max_epu32.  All arrays may be unaligned.
+void avx512_max_128(const uint32_t *deltas, const uint32_t *tfs,
+                    const uint32_t *doc_lens, size_t start, uint32_t count,
+                    uint32_t &max_delta, uint32_t &max_tf, uint32_t &max_dl);
+
+/// Pack 128 uint32 values at \p bitwidth bits each into \p out.
+/// Falls back to SSE4.1 implementation (packing is write-once, at dump time).
+void avx512_pack_uint32_128(const uint32_t *in, uint8_t bitwidth,
+                            uint8_t *out);
+
+/// Unpack 128 uint32 values at \p bitwidth bits each from \p in, reading the
+/// 4-lane interleaved SSE layout 16 values per step: each value is assembled
+/// from its two 32-bit source words with dword permutes and variable shifts.
+/// \p in may be unaligned; bytes past the packed block are never read.
+void avx512_unpack_uint32_128(const uint8_t *in, uint8_t bitwidth,
+                              uint32_t *out);
+
+/// Same as avx512_unpack_uint32_128(), but for bitwidths up to 25 gathers the
+/// four bytes holding each value with one VBMI byte permute instead.
+void avx512_vbmi_unpack_uint32_128(const uint8_t *in, uint8_t bitwidth,
+                                   uint32_t *out);
+
+/// Compute prefix-sum over \p count (must be 128) delta values, producing
+/// absolute doc_ids, 16 at a time.  Arrays may be unaligned.
+void avx512_prefix_sum_128(const uint32_t *deltas, uint32_t min_doc_id,
+                           uint32_t count, uint32_t *out);
+
+/// Find the first index i in arr[start..size) where arr[i] >= target, using
+/// 16-wide unsigned comparisons.  Never reads past arr[size - 1].
+size_t avx512_find_first_ge(const uint32_t *arr, uint32_t size,
+                            uint32_t target, size_t start);
+
+/// Fused block kernel: unpack the term frequencies and document lengths of a
+/// full 128-doc block 16 at a time and score them in registers, writing the
+/// BM25 scores of the whole block to \p scores.  Matches
+/// scalar_bm25_scores() bit for bit.
+void avx512_decode_score_128(const uint8_t *packed_tfs, uint8_t bitwidth_tf,
+                             const uint8_t *packed_doc_lens,
+                             uint8_t bitwidth_dl,
+                             const BM25BlockParams &params, float *scores);
+
+/// avx512_decode_score_128() with the VBMI unpacker.
+void avx512_vbmi_decode_score_128(const uint8_t *packed_tfs,
+                                  uint8_t bitwidth_tf,
+                                  const uint8_t *packed_doc_lens,
+                                  uint8_t bitwidth_dl,
+                                  const BM25BlockParams &params,
+                                  float *scores);
+
+}  // namespace zvec::fts::simd
@@ -18,6 +18,7 @@
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
     defined(_M_IX86)
 #include "bitpacked_simd_avx2.h"
+#include "bitpacked_simd_avx512.h"
 #include "bitpacked_simd_sse41.h"
 #endif
 
@@ -27,20 +28,39 @@ static DispatchTable init_dispatch() {
   DispatchTable t{};
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
     defined(_M_IX86)
-  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX2) {
+  const auto &flags = zvec::ailego::internal::CpuFeatures::static_flags_;
+  if (flags.AVX512F && avx512_kernels_compiled()) {
+    t.max_128 = avx512_max_128;
+    t.pack_uint32_128 = avx512_pack_uint32_128;
+    t.prefix_sum_128 = avx512_prefix_sum_128;
+    t.find_first_ge = avx512_find_first_ge;
+    if (flags.AVX512_VBMI && flags.AVX512BW &&
+        avx512_vbmi_kernels_compiled()) {
+      t.unpack_uint32_128 = avx512_vbmi_unpack_uint32_128;
+      t.decode_score_128 = avx512_vbmi_decode_score_128;
+    } else {
+      t.unpack_uint32_128 = avx512_unpack_uint32_128;
+      t.decode_score_128 = avx512_decode_score_128;
+    }
+    return t;
+  }
+  if (flags.AVX2) {
     t.max_128 = avx2_max_128;
     t.pack_uint32_128 = avx2_pack_uint32_128;
     t.unpack_uint32_128 = avx2_unpack_uint32_128;
     t.prefix_sum_128 = avx2_prefix_sum_128;
     t.find_first_ge = avx2_find_first_ge;
+    // The AVX2 unpacker is the SSE4.1 one.
+    t.decode_score_128 = sse41_decode_score_128;
     return t;
   }
-  if (zvec::ailego::internal::CpuFeatures::static_flags_.SSE4_1) {
+  if (flags.SSE4_1) {
     t.max_128 = sse41_max_128;
     t.pack_uint32_128 = sse41_pack_uint32_128;
     t.unpack_uint32_128 = sse41_unpack_uint32_128;
     t.prefix_sum_128 = sse41_prefix_sum_128;
     t.find_first_ge = sse41_find_first_ge;
+    t.decode_score_128 = sse41_decode_score_128;
     return t;
   }
 #endif
@@ -49,6 +69,7 @@ static DispatchTable init_dispatch() {
   t.unpack_uint32_128 = scalar_unpack_uint32_128;
   t.prefix_sum_128 = scalar_prefix_sum_128;
   t.find_first_ge = scalar_find_first_ge;
+  t.decode_score_128 = scalar_decode_score_128;
   return t;
 }
 
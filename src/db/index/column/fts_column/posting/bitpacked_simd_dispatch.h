@@ -19,6 +19,21 @@
 
 namespace zvec::fts::simd {
 
+/// Per-term constants of BM25Scorer::score_with_idf(), for scoring a block of
+/// postings at once:
+///   score = weight * tf * k1_plus_1 /
+///           (tf + k1 * (one_minus_b + b * doc_len / avg_dl))
+/// Kernels evaluate it in exactly this order, without fused multiply-adds,
+/// so every kernel returns the same scores.
+struct BM25BlockParams {
+  float weight{0.0f};  ///< boost * idf
+  float k1{1.2f};
+  float k1_plus_1{2.2f};
+  float b{0.75f};
+  float one_minus_b{0.25f};
+  float avg_dl{1.0f};
+};
+
 // Function pointer types for SIMD-dispatched operations.
 using MaxFunc = void (*)(const uint32_t *, const uint32_t *, const uint32_t *,
                          size_t, uint32_t, uint32_t &, uint32_t &, uint32_t &);
@@ -28,6 +43,8 @@ using PrefixSumFunc = void (*)(const uint32_t *, uint32_t, uint32_t,
                                uint32_t *);
 using FindFirstGeFunc = size_t (*)(const uint32_t *, uint32_t, uint32_t,
                                    size_t);
+using DecodeScoreFunc = void (*)(const uint8_t *, uint8_t, const uint8_t *,
+                                 uint8_t, const BM25BlockParams &, float *);
 
 /// Dispatch table populated once at startup via CPU feature detection.
 struct DispatchTable {
@@ -36,6 +53,7 @@ struct DispatchTable {
   UnpackFunc unpack_uint32_128;
   PrefixSumFunc prefix_sum_128;
   FindFirstGeFunc find_first_ge;
+  DecodeScoreFunc decode_score_128;
 };
 
 /// Get the global dispatch table (initialized on first call).
@@ -112,4 +112,32 @@ size_t scalar_find_first_ge(const uint32_t *arr, uint32_t size, uint32_t target,
   return size;
 }
 
+// ------------------------------------------------------------
+// scalar_bm25_scores / scalar_decode_score_128
+// ------------------------------------------------------------
+
+void scalar_bm25_scores(const uint32_t *tfs, const uint32_t *doc_lens,
+                        uint32_t count, const BM25BlockParams &params,
+                        float *scores) {
+  for (uint32_t i = 0; i < count; ++i) {
+    const float tf = static_cast<float>(tfs[i]);
+    const float doc_len = static_cast<float>(doc_lens[i]);
+    const float norm = params.one_minus_b + params.b * doc_len / params.avg_dl;
+    const float tf_norm = tf * params.k1_plus_1 / (tf + params.k1 * norm);
+    scores[i] = params.weight * tf_norm;
+  }
+}
+
+void scalar_decode_score_128(const uint8_t *packed_tfs, uint8_t bitwidth_tf,
+                             const uint8_t *packed_doc_lens,
+                             uint8_t bitwidth_dl,
+                             const BM25BlockParams &params, float *scores) {
+  uint32_t tfs[BitPackedPostingList::DOCS_PER_BLOCK];
+  uint32_t doc_lens[BitPackedPostingList::DOCS_PER_BLOCK];
+  scalar_unpack_uint32_128(packed_tfs, bitwidth_tf, tfs);
+  scalar_unpack_uint32_128(packed_doc_lens, bitwidth_dl, doc_lens);
+  scalar_bm25_scores(tfs, doc_lens, BitPackedPostingList::DOCS_PER_BLOCK,
+                     params, scores);
+}
+
 }  // namespace zvec::fts::simd
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "bitpacked_simd_dispatch.h"
 
 namespace zvec::fts::simd {
 
@@ -45,4 +46,17 @@ void scalar_prefix_sum_128(const uint32_t *deltas, uint32_t min_doc_id,
 size_t scalar_find_first_ge(const uint32_t *arr, uint32_t size, uint32_t target,
                             size_t start);
 
+/// Scalar fallback: BM25 scores of \p count postings from their term
+/// frequencies and document lengths into \p scores.
+void scalar_bm25_scores(const uint32_t *tfs, const uint32_t *doc_lens,
+                        uint32_t count, const BM25BlockParams &params,
+                        float *scores);
+
+/// Scalar fallback: unpack the term frequencies and document lengths of a
+/// full 128-doc block and score it into \p scores.
+void scalar_decode_score_128(const uint8_t *packed_tfs, uint8_t bitwidth_tf,
+                             const uint8_t *packed_doc_lens,
+                             uint8_t bitwidth_dl,
+                             const BM25BlockParams &params, float *scores);
+
 }  // namespace zvec::fts::simd
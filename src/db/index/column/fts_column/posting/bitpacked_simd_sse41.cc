@@ -23,6 +23,7 @@
 #include <smmintrin.h>  // SSE4.1
 #include <cstring>
 #include "bitpacked_posting_list.h"
+#include "bitpacked_simd_scalar.h"
 
 #ifdef _MSC_VER
 #include <intrin.h>
@@ -168,6 +169,23 @@ size_t sse41_find_first_ge(const uint32_t *arr, uint32_t size, uint32_t target,
   return size;
 }
 
+// ------------------------------------------------------------
+// sse41_decode_score_128
+// ------------------------------------------------------------
+
+void sse41_decode_score_128(const uint8_t *packed_tfs, uint8_t bitwidth_tf,
+                            const uint8_t *packed_doc_lens, uint8_t bitwidth_dl,
+                            const BM25BlockParams &params, float *scores) {
+  alignas(16) uint32_t tfs[BitPackedPostingList::DOCS_PER_BLOCK];
+  alignas(16) uint32_t doc_lens[BitPackedPostingList::DOCS_PER_BLOCK];
+  sse41_unpack_uint32_128(packed_tfs, bitwidth_tf, tfs);
+  sse41_unpack_uint32_128(packed_doc_lens, bitwidth_dl, doc_lens);
+  // Scored by the scalar kernel: this file is built for SSE4.1 only, and
+  // keeping the float math in one place keeps scores identical everywhere.
+  scalar_bm25_scores(tfs, doc_lens, BitPackedPostingList::DOCS_PER_BLOCK,
+                     params, scores);
+}
+
 }  // namespace zvec::fts::simd
 
 #else  // !defined(__SSE4_1__) && !(defined(_MSC_VER) && (defined(_M_X64) ||
@@ -197,6 +215,9 @@ size_t sse41_find_first_ge(const uint32_t *, uint32_t size, uint32_t, size_t) {
   return size;
 }
 
+void sse41_decode_score_128(const uint8_t *, uint8_t, const uint8_t *, uint8_t,
+                            const BM25BlockParams &, float *) {}
+
 }  // namespace zvec::fts::simd
 
 #endif  // defined(__SSE4_1__)
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "bitpacked_simd_dispatch.h"
 
 namespace zvec::fts::simd {
 
@@ -47,4 +48,10 @@ void sse41_prefix_sum_128(const uint32_t *deltas, uint32_t min_doc_id,
 size_t sse41_find_first_ge(const uint32_t *arr, uint32_t size, uint32_t target,
                            size_t start);
 
+/// Unpack the term frequencies and document lengths of a full 128-doc block
+/// with the SSE4.1 unpacker and score it into \p scores.
+void sse41_decode_score_128(const uint8_t *packed_tfs, uint8_t bitwidth_tf,
+                            const uint8_t *packed_doc_lens, uint8_t bitwidth_dl,
+                            const BM25BlockParams &params, float *scores);
+
 }  // namespace zvec::fts::simd
@@ -203,6 +203,8 @@ const char *lookup_extra_fold(utf8proc_int32_t cp) {
   return nullptr;
 }
 
+// Appends the NFKD+STRIPMARK form of one codepoint to *out when it is pure
+// ASCII; leaves *out untouched and returns false otherwise.
 bool fold_codepoint_to_ascii(const utf8proc_uint8_t *data, utf8proc_ssize_t len,
                              std::string *out) {
   utf8proc_uint8_t *mapped_raw = nullptr;
@@ -220,72 +222,64 @@ bool fold_codepoint_to_ascii(const utf8proc_uint8_t *data, utf8proc_ssize_t len,
       return false;
     }
   }
-  out->assign(reinterpret_cast<const char *>(mapped_raw),
+  out->append(reinterpret_cast<const char *>(mapped_raw),
               static_cast<size_t>(mapped_len));
   return true;
 }
 
 }  // namespace
 
-std::vector<Token> AsciiFoldingTokenFilter::filter(
-    std::vector<Token> tokens) const {
-  for (auto &token : tokens) {
-    bool all_ascii = true;
-    for (unsigned char c : token.text) {
-      if (c >= 0x80) {
-        all_ascii = false;
-        break;
-      }
+bool AsciiFoldingTokenFilter::apply(std::string *text) const {
+  bool all_ascii = true;
+  for (unsigned char c : *text) {
+    if (c >= 0x80) {
+      all_ascii = false;
+      break;
     }
-    if (all_ascii) {
+  }
+  if (all_ascii) {
+    // Folding may leave empty tokens from empty input. Drop them.
+    return !text->empty();
+  }
+
+  // Rebuilt into a per-thread buffer that is swapped in, so both buffers
+  // keep their capacity across calls.
+  static thread_local std::string result;
+  result.clear();
+  const auto *str = reinterpret_cast<const utf8proc_uint8_t *>(text->data());
+  const auto len = static_cast<utf8proc_ssize_t>(text->size());
+  utf8proc_ssize_t pos = 0;
+  while (pos < len) {
+    if (str[pos] < 0x80) {
+      result.push_back(static_cast<char>(str[pos]));
+      ++pos;
       continue;
     }
 
-    std::string result;
-    result.reserve(token.text.size());
-    const auto *str =
-        reinterpret_cast<const utf8proc_uint8_t *>(token.text.data());
-    const auto len = static_cast<utf8proc_ssize_t>(token.text.size());
-    utf8proc_ssize_t pos = 0;
-    while (pos < len) {
-      if (str[pos] < 0x80) {
-        result.push_back(static_cast<char>(str[pos]));
-        ++pos;
-        continue;
-      }
-
-      utf8proc_int32_t cp;
-      utf8proc_ssize_t bytes = utf8proc_iterate(str + pos, len - pos, &cp);
-      if (bytes < 1) {
-        result.push_back(static_cast<char>(str[pos]));
-        ++pos;
-        continue;
-      }
-
-      const char *fold = lookup_extra_fold(cp);
-      if (fold) {
-        result.append(fold);
-        pos += bytes;
-        continue;
-      }
+    utf8proc_int32_t cp;
+    utf8proc_ssize_t bytes = utf8proc_iterate(str + pos, len - pos, &cp);
+    if (bytes < 1) {
+      result.push_back(static_cast<char>(str[pos]));
+      ++pos;
+      continue;
+    }
 
-      std::string ascii;
-      if (fold_codepoint_to_ascii(str + pos, bytes, &ascii)) {
-        result.append(ascii);
-      } else {
-        // Keep the original codepoint when it has no ASCII equivalent.
-        result.append(token.text, static_cast<size_t>(pos),
-                      static_cast<size_t>(bytes));
-      }
+    const char *fold = lookup_extra_fold(cp);
+    if (fold) {
+      result.append(fold);
       pos += bytes;
+      continue;
+    }
+
+    if (!fold_codepoint_to_ascii(str + pos, bytes, &result)) {
+      // Keep the original codepoint when it has no ASCII equivalent.
+      result.append(*text, static_cast<size_t>(pos),
+                    static_cast<size_t>(bytes));
     }
-    token.text = std::move(result);
+    pos += bytes;
   }
-  // Folding may leave empty tokens from empty input. Remove them.
-  tokens.erase(std::remove_if(tokens.begin(), tokens.end(),
-                              [](const Token &t) { return t.text.empty(); }),
-               tokens.end());
-  return tokens;
+  text->swap(result);
+  return !text->empty();
 }
 
 }  // namespace zvec::fts
@@ -26,7 +26,7 @@ namespace zvec::fts {
  */
 class AsciiFoldingTokenFilter : public TokenFilter {
  public:
-  std::vector<Token> filter(std::vector<Token> tokens) const override;
+  bool apply(std::string *text) const override;
 
   const char *name() const override {
     return "ascii_folding";
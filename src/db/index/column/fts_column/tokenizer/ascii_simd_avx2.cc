@@ -0,0 +1,132 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ascii_simd_avx2.h"
+
+#if defined(__AVX2__) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cstdint>
+#include <zvec/ailego/internal/platform.h>
+#include "ascii_simd_dispatch.h"
+
+namespace zvec::fts::simd {
+
+namespace {
+
+constexpr size_t kStride = 32;
+
+inline __m256i load_32(const char *data) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+}
+
+// 0xFF in every lane holding lo <= byte <= hi.  The compares are signed, so
+// bytes >= 0x80 are negative and never fall inside an ASCII range.
+inline __m256i in_range(__m256i v, char lo, char hi) {
+  return _mm256_and_si256(
+      _mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), v));
+}
+
+// One bit per byte: its sign bit, i.e. set for bytes >= 0x80.
+inline uint32_t sign_bits(__m256i v) {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+}
+
+// One bit per byte: set for [0-9A-Za-z_].
+inline uint32_t word_byte_bits(__m256i v) {
+  // OR-ing 0x20 maps A-Z onto a-z and leaves no other byte inside a-z.
+  const __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+  const __m256i word = _mm256_or_si256(
+      _mm256_or_si256(in_range(v, '0', '9'), in_range(folded, 'a', 'z')),
+      _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+  return sign_bits(word);
+}
+
+}  // namespace
+
+size_t avx2_ascii_prefix_length(const char *data, size_t size) {
+  size_t i = 0;
+  for (; i + kStride <= size; i += kStride) {
+    const uint32_t high = sign_bits(load_32(data + i));
+    if (high != 0) {
+      return i + ailego_ctz32(high);
+    }
+  }
+  return i + scalar_ascii_prefix_length(data + i, size - i);
+}
+
+size_t avx2_classify_ascii(const char *data, size_t size, size_t start,
+                           uint64_t *word_bits) {
+  size_t block = start & ~size_t{63};
+  for (; block + 64 <= size; block += 64) {
+    const __m256i lo = load_32(data + block);
+    const __m256i hi = load_32(data + block + 32);
+    word_bits[block >> 6] = word_byte_bits(lo) |
+                            (static_cast<uint64_t>(word_byte_bits(hi)) << 32);
+    uint64_t high =
+        sign_bits(lo) | (static_cast<uint64_t>(sign_bits(hi)) << 32);
+    // Bytes before start in the first block belong to an earlier segment.
+    high &= ~uint64_t{0} << (std::max(block, start) - block);
+    if (high != 0) {
+      return block + ailego_ctz64(high);
+    }
+  }
+  return scalar_classify_ascii(data, size, std::max(block, start), word_bits);
+}
+
+size_t avx2_lower_ascii_prefix(char *data, size_t size) {
+  size_t i = 0;
+  for (; i + kStride <= size; i += kStride) {
+    const __m256i v = load_32(data + i);
+    if (sign_bits(v) != 0) {
+      // Non-ASCII inside this block: the scalar loop finishes the prefix.
+      break;
+    }
+    const __m256i upper = in_range(v, 'A', 'Z');
+    const __m256i lowered =
+        _mm256_add_epi8(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), lowered);
+  }
+  return i + scalar_lower_ascii_prefix(data + i, size - i);
+}
+
+}  // namespace zvec::fts::simd
+
+#else  // !defined(__AVX2__) && !(defined(_MSC_VER) && (defined(_M_X64) ||
+       // defined(_M_IX86)))
+
+// Stub implementations when AVX2 is not available at compile time.
+// The runtime dispatch layer (ascii_simd_dispatch.cc) will never call
+// these on non-AVX2 machines, but the linker still needs the symbols.
+
+namespace zvec::fts::simd {
+
+size_t avx2_ascii_prefix_length(const char *, size_t) {
+  return 0;
+}
+
+size_t avx2_classify_ascii(const char *, size_t size, size_t, uint64_t *) {
+  return size;
+}
+
+size_t avx2_lower_ascii_prefix(char *, size_t) {
+  return 0;
+}
+
+}  // namespace zvec::fts::simd
+
+#endif  // defined(__AVX2__)
@@ -0,0 +1,36 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zvec::fts::simd {
+
+/// Length of the ASCII prefix of \p data, checking 32 bytes per step with
+/// _mm256_movemask_epi8 over the byte sign bits.
+size_t avx2_ascii_prefix_length(const char *data, size_t size);
+
+/// Word-byte bitmask of data[start, size), see AsciiDispatchTable.  Each
+/// 64-byte block is classified with two 32-byte range compares whose
+/// movemasks form one mask word.
+size_t avx2_classify_ascii(const char *data, size_t size, size_t start,
+                           uint64_t *word_bits);
+
+/// Lowercase A-Z over the ASCII prefix of \p data, 32 bytes per step, and
+/// return the prefix length.
+size_t avx2_lower_ascii_prefix(char *data, size_t size);
+
+}  // namespace zvec::fts::simd
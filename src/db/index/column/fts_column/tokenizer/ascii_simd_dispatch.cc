@@ -0,0 +1,98 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ascii_simd_dispatch.h"
+#include <algorithm>
+#include <ailego/internal/cpu_features.h>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#include "ascii_simd_avx2.h"
+#endif
+
+namespace zvec::fts::simd {
+
+namespace {
+
+inline bool is_word_byte(unsigned char ch) {
+  return (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z') ||
+         (ch >= 'a' && ch <= 'z') || ch == '_';
+}
+
+}  // namespace
+
+size_t scalar_ascii_prefix_length(const char *data, size_t size) {
+  size_t i = 0;
+  while (i < size && (static_cast<unsigned char>(data[i]) & 0x80) == 0) {
+    ++i;
+  }
+  return i;
+}
+
+size_t scalar_classify_ascii(const char *data, size_t size, size_t start,
+                             uint64_t *word_bits) {
+  for (size_t block = start & ~size_t{63}; block < size; block += 64) {
+    const size_t block_end = std::min(size, block + 64);
+    uint64_t bits = 0;
+    for (size_t i = std::max(block, start); i < block_end; ++i) {
+      const auto ch = static_cast<unsigned char>(data[i]);
+      if (ch >= 0x80) {
+        word_bits[block >> 6] = bits;
+        return i;
+      }
+      if (is_word_byte(ch)) {
+        bits |= uint64_t{1} << (i - block);
+      }
+    }
+    word_bits[block >> 6] = bits;
+  }
+  return size;
+}
+
+size_t scalar_lower_ascii_prefix(char *data, size_t size) {
+  size_t i = 0;
+  for (; i < size; ++i) {
+    const auto ch = static_cast<unsigned char>(data[i]);
+    if (ch >= 0x80) {
+      break;
+    }
+    if (ch >= 'A' && ch <= 'Z') {
+      data[i] = static_cast<char>(ch + ('a' - 'A'));
+    }
+  }
+  return i;
+}
+
+static AsciiDispatchTable init_ascii_dispatch() {
+  AsciiDispatchTable t{};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+  if (zvec::ailego::internal::CpuFeatures::static_flags_.AVX2) {
+    t.ascii_prefix_length = avx2_ascii_prefix_length;
+    t.classify_ascii = avx2_classify_ascii;
+    t.lower_ascii_prefix = avx2_lower_ascii_prefix;
+    return t;
+  }
+#endif
+  t.ascii_prefix_length = scalar_ascii_prefix_length;
+  t.classify_ascii = scalar_classify_ascii;
+  t.lower_ascii_prefix = scalar_lower_ascii_prefix;
+  return t;
+}
+
+const AsciiDispatchTable &get_ascii_dispatch() {
+  static const AsciiDispatchTable table = init_ascii_dispatch();
+  return table;
+}
+
+}  // namespace zvec::fts::simd
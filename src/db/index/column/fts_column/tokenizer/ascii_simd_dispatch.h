@@ -0,0 +1,54 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zvec::fts::simd {
+
+// Byte classifiers used by the tokenizers' ASCII fast paths.  A "word byte"
+// is one of [0-9A-Za-z_], i.e. the ASCII bytes that can start or continue a
+// standard-tokenizer word without consulting the word-break rules.
+using AsciiPrefixFunc = size_t (*)(const char *, size_t);
+using ClassifyAsciiFunc = size_t (*)(const char *, size_t, size_t,
+                                     uint64_t *);
+using LowerAsciiPrefixFunc = size_t (*)(char *, size_t);
+
+/// Dispatch table populated once at startup via CPU feature detection.
+struct AsciiDispatchTable {
+  /// Length of the longest prefix of data[0, size) without a byte >= 0x80.
+  AsciiPrefixFunc ascii_prefix_length;
+  /// Classify data[start, size) 64 bytes at a time.  Bit (i % 64) of
+  /// word_bits[i / 64] is set iff data[i] is a word byte.  Stops after the
+  /// 64-byte block holding the first byte >= 0x80 and returns that byte's
+  /// index (size if there is none).  Only bits in [start, returned index)
+  /// are meaningful; word_bits must hold size / 64 + 1 words.
+  ClassifyAsciiFunc classify_ascii;
+  /// Lowercase A-Z in place over the longest ASCII prefix of data[0, size)
+  /// and return that prefix's length.
+  LowerAsciiPrefixFunc lower_ascii_prefix;
+};
+
+/// Get the global ASCII dispatch table (initialized on first call).
+const AsciiDispatchTable &get_ascii_dispatch();
+
+/// Portable implementations; also used for the tails of the SIMD kernels.
+size_t scalar_ascii_prefix_length(const char *data, size_t size);
+size_t scalar_classify_ascii(const char *data, size_t size, size_t start,
+                             uint64_t *word_bits);
+size_t scalar_lower_ascii_prefix(char *data, size_t size);
+
+}  // namespace zvec::fts::simd
@@ -15,7 +15,9 @@
 #include "standard_tokenizer.h"
 #include <algorithm>
 #include <array>
+#include <zvec/ailego/internal/platform.h>
 #include <zvec/ailego/logger/logger.h>
+#include "ascii_simd_dispatch.h"
 #include "unicode_utils.h"
 
 namespace zvec::fts {
@@ -321,10 +323,6 @@ bool is_ascii_letter_or_digit(unsigned char ch) {
          (ch >= 'a' && ch <= 'z');
 }
 
-bool is_ascii_word_body_char(unsigned char ch) {
-  return is_ascii_letter_or_digit(ch) || ch == '_';
-}
-
 bool is_hangul_syllable(uint32_t codepoint) {
   return codepoint >= 0xAC00 && codepoint <= 0xD7A3;
 }
@@ -406,13 +404,15 @@ std::array<CodepointCacheEntry, kCodepointCacheSize> *codepoint_cache() {
   return &cache;
 }
 
-std::vector<StandardCodepoint> decode_standard_utf8(const std::string &text) {
+// Decodes text[begin, text.size()); codepoint offsets are relative to text.
+std::vector<StandardCodepoint> decode_standard_utf8(std::string_view text,
+                                                    size_t begin) {
   std::vector<StandardCodepoint> codepoints;
-  codepoints.reserve(estimate_codepoint_capacity(text.size()));
+  codepoints.reserve(estimate_codepoint_capacity(text.size() - begin));
   auto *cache = codepoint_cache();
   const auto *data = reinterpret_cast<const uint8_t *>(text.data());
   size_t len = text.size();
-  size_t index = 0;
+  size_t index = begin;
 
   while (index < len) {
     int32_t cp = 0;
@@ -710,32 +710,31 @@ size_t trim_non_core_suffix(const std::vector<StandardCodepoint> &codepoints,
   return trimmed;
 }
 
-void emit_non_empty_core_span(const std::string &text,
+// Emits text[begin, end) as the next token; the view points into text.
+void emit_token(std::string_view text, size_t begin, size_t end,
+                uint32_t *position, const TokenSink &sink) {
+  sink(TokenView{text.substr(begin, end - begin), static_cast<uint32_t>(begin),
+                 (*position)++});
+}
+
+void emit_non_empty_core_span(std::string_view text,
                               const std::vector<StandardCodepoint> &codepoints,
                               size_t start, size_t end, uint32_t *position,
-                              std::vector<Token> *tokens) {
+                              const TokenSink &sink) {
   if (start >= end || !span_has_core_token(codepoints, start, end)) {
     return;
   }
-  Token token;
-  token.text = text.substr(codepoints[start].start,
-                           codepoints[end - 1].end - codepoints[start].start);
-  token.offset = codepoints[start].start;
-  token.position = (*position)++;
-  tokens->push_back(std::move(token));
+  emit_token(text, codepoints[start].start, codepoints[end - 1].end, position,
+             sink);
 }
 
-void emit_token_span(const std::string &text,
+void emit_token_span(std::string_view text,
                      const std::vector<StandardCodepoint> &codepoints,
                      size_t start, size_t end, uint32_t max_token_length,
-                     uint32_t *position, std::vector<Token> *tokens) {
+                     uint32_t *position, const TokenSink &sink) {
   if (end - start <= max_token_length) {
-    Token token;
-    token.text = text.substr(codepoints[start].start,
-                             codepoints[end - 1].end - codepoints[start].start);
-    token.offset = codepoints[start].start;
-    token.position = (*position)++;
-    tokens->push_back(std::move(token));
+    emit_token(text, codepoints[start].start, codepoints[end - 1].end,
+               position, sink);
     return;
   }
 
@@ -747,7 +746,7 @@ void emit_token_span(const std::string &text,
         is_token_start(codepoints[index].cls)) {
       size_t emit_end = trim_non_core_suffix(codepoints, token_start, index);
       emit_non_empty_core_span(text, codepoints, token_start, emit_end,
-                               position, tokens);
+                               position, sink);
       token_start = index;
       codepoint_count = 0;
       continue;
@@ -761,69 +760,58 @@ void emit_token_span(const std::string &text,
     token_end = trim_non_core_suffix(codepoints, token_start, end);
   }
   emit_non_empty_core_span(text, codepoints, token_start, token_end, position,
-                           tokens);
+                           sink);
 }
 
-bool is_ascii_text(const std::string &text) {
-  for (unsigned char ch : text) {
-    if ((ch & 0x80) != 0) {
-      return false;
-    }
-  }
-  return true;
+bool is_ascii_space(unsigned char ch) {
+  return ch == ' ' || (ch >= '\t' && ch <= '\r');
 }
 
-size_t scan_ascii_word_token(const std::string &text, size_t start) {
-  size_t end = start + 1;
-  size_t last_sig = start;
-
-  while (end < text.size()) {
-    auto ch = static_cast<unsigned char>(text[end]);
-    if (is_ascii_word_body_char(ch)) {
-      last_sig = end;
-      ++end;
-      continue;
-    }
-
-    WordBreakClass cls = lookup_ascii_word_break_class(ch);
-    if (cls == WordBreakClass::ExtendNumLet) {
-      WordBreakClass left = lookup_ascii_word_break_class(
-          static_cast<unsigned char>(text[last_sig]));
-      if (!significant_connects(left, cls)) {
-        break;
-      }
-      last_sig = end;
-      ++end;
-      continue;
-    }
-    if (!is_token_start(cls)) {
-      size_t right = end + 1;
-      if (right < text.size()) {
-        WordBreakClass left = lookup_ascii_word_break_class(
-            static_cast<unsigned char>(text[last_sig]));
-        WordBreakClass right_cls = lookup_ascii_word_break_class(
-            static_cast<unsigned char>(text[right]));
-        if (punctuation_connects(left, cls, right_cls)) {
-          end = right + 1;
-          last_sig = right;
-          continue;
-        }
-      }
-      break;
+// First index in [start, size) whose bit in \p word_bits equals \p want,
+// or size.  word_bits is the [0-9A-Za-z_] bitmask from
+// simd::AsciiDispatchTable::classify_ascii.
+size_t scan_word_bits(const uint64_t *word_bits, size_t size, size_t start,
+                      bool want) {
+  if (start >= size) {
+    return size;
+  }
+  const uint64_t flip = want ? 0 : ~uint64_t{0};
+  size_t word = start >> 6;
+  uint64_t bits = (word_bits[word] ^ flip) & (~uint64_t{0} << (start & 63));
+  while (bits == 0) {
+    if ((++word << 6) >= size) {
+      return size;
     }
+    bits = word_bits[word] ^ flip;
+  }
+  return std::min(size, (word << 6) + ailego_ctz64(bits));
+}
 
+// The ASCII helpers below take the text as a view that ends where the ASCII
+// segment being tokenized ends; offsets stay relative to the full text.
+size_t scan_ascii_word_token(std::string_view text, const uint64_t *word_bits,
+                             size_t start) {
+  // Runs of [0-9A-Za-z_] always connect, so they are skipped in bulk over the
+  // bitmask.  Every other ASCII byte ends the token unless it is a single
+  // MidLetter / MidNumLet / MidNum / SingleQuote byte joining two letters or
+  // two digits.
+  size_t end = scan_word_bits(word_bits, text.size(), start + 1, false);
+  while (end + 1 < text.size()) {
     WordBreakClass left = lookup_ascii_word_break_class(
-        static_cast<unsigned char>(text[last_sig]));
-    if (!significant_connects(left, cls)) {
+        static_cast<unsigned char>(text[end - 1]));
+    WordBreakClass cls =
+        lookup_ascii_word_break_class(static_cast<unsigned char>(text[end]));
+    WordBreakClass right = lookup_ascii_word_break_class(
+        static_cast<unsigned char>(text[end + 1]));
+    if (!punctuation_connects(left, cls, right)) {
       break;
     }
-    last_sig = end;
-    ++end;
+    end = scan_word_bits(word_bits, text.size(), end + 2, false);
   }
   return end;
 }
 
-bool ascii_span_has_core_token(const std::string &text, size_t start,
+bool ascii_span_has_core_token(std::string_view text, size_t start,
                                size_t end) {
   for (size_t index = start; index < end; ++index) {
     auto ch = static_cast<unsigned char>(text[index]);
@@ -834,7 +822,7 @@ bool ascii_span_has_core_token(const std::string &text, size_t start,
   return false;
 }
 
-size_t trim_ascii_non_core_suffix(const std::string &text, size_t start,
+size_t trim_ascii_non_core_suffix(std::string_view text, size_t start,
                                   size_t end) {
   size_t trimmed = end;
   while (trimmed > start) {
@@ -847,28 +835,20 @@ size_t trim_ascii_non_core_suffix(const std::string &text, size_t start,
   return trimmed;
 }
 
-void emit_non_empty_ascii_core_span(const std::string &text, size_t start,
+void emit_non_empty_ascii_core_span(std::string_view text, size_t start,
                                     size_t end, uint32_t *position,
-                                    std::vector<Token> *tokens) {
+                                    const TokenSink &sink) {
   if (start >= end || !ascii_span_has_core_token(text, start, end)) {
     return;
   }
-  Token token;
-  token.text = text.substr(start, end - start);
-  token.offset = static_cast<uint32_t>(start);
-  token.position = (*position)++;
-  tokens->push_back(std::move(token));
+  emit_token(text, start, end, position, sink);
 }
 
-void emit_ascii_token_span(const std::string &text, size_t start, size_t end,
+void emit_ascii_token_span(std::string_view text, size_t start, size_t end,
                            uint32_t max_token_length, uint32_t *position,
-                           std::vector<Token> *tokens) {
+                           const TokenSink &sink) {
   if (end - start <= max_token_length) {
-    Token token;
-    token.text = text.substr(start, end - start);
-    token.offset = static_cast<uint32_t>(start);
-    token.position = (*position)++;
-    tokens->push_back(std::move(token));
+    emit_token(text, start, end, position, sink);
     return;
   }
 
@@ -880,7 +860,7 @@ void emit_ascii_token_span(const std::string &text, size_t start, size_t end,
     if (codepoint_count >= max_token_length && is_ascii_letter_or_digit(ch)) {
       size_t emit_end = trim_ascii_non_core_suffix(text, token_start, index);
       emit_non_empty_ascii_core_span(text, token_start, emit_end, position,
-                                     tokens);
+                                     sink);
       token_start = index;
       codepoint_count = 0;
       continue;
@@ -893,133 +873,94 @@ void emit_ascii_token_span(const std::string &text, size_t start, size_t end,
   if (end - token_start > max_token_length) {
     token_end = trim_ascii_non_core_suffix(text, token_start, end);
   }
-  emit_non_empty_ascii_core_span(text, token_start, token_end, position,
-                                 tokens);
-}
-
-std::vector<Token> tokenize_ascii(const std::string &text,
-                                  uint32_t max_token_length) {
-  std::vector<Token> tokens;
-  tokens.reserve(estimate_token_capacity(text.size()));
-  uint32_t position = 0;
-  size_t index = 0;
-  while (index < text.size()) {
-    auto ch = static_cast<unsigned char>(text[index]);
-    if (is_ascii_letter_or_digit(ch)) {
-      size_t end = scan_ascii_word_token(text, index);
-      emit_ascii_token_span(text, index, end, max_token_length, &position,
-                            &tokens);
-      index = end;
-      continue;
-    }
-
-    WordBreakClass cls = lookup_ascii_word_break_class(ch);
-    if (cls == WordBreakClass::ExtendNumLet) {
-      size_t end = scan_ascii_word_token(text, index);
-      if (ascii_span_has_core_token(text, index, end)) {
-        emit_ascii_token_span(text, index, end, max_token_length, &position,
-                              &tokens);
-      }
-      index = end;
-      continue;
-    }
-    ++index;
-  }
-  return tokens;
+  emit_non_empty_ascii_core_span(text, token_start, token_end, position, sink);
 }
 
-}  // namespace
-
-Status StandardTokenizer::init(const ailego::JsonObject &config) {
-  max_token_length_ = kDefaultMaxTokenLength;
-  auto length_val = config["max_token_length"];
-  if (!length_val.is_null()) {
-    if (!length_val.is_integer()) {
-      return Status::InvalidArgument(
-          "StandardTokenizer: max_token_length must be integer");
+void tokenize_ascii(std::string_view text, const uint64_t *word_bits,
+                    size_t begin, uint32_t max_token_length,
+                    uint32_t *position, const TokenSink &sink) {
+  size_t index = begin;
+  while (true) {
+    // Only [0-9A-Za-z_] can start a token; everything else is skipped.
+    index = scan_word_bits(word_bits, text.size(), index, true);
+    if (index >= text.size()) {
+      break;
     }
-    auto configured_length = length_val.as_integer();
-    if (configured_length < kMinMaxTokenLength ||
-        configured_length > kMaxMaxTokenLength) {
-      return Status::InvalidArgument(
-          "StandardTokenizer: max_token_length out of range: ",
-          configured_length);
+    size_t end = scan_ascii_word_token(text, word_bits, index);
+    if (text[index] != '_' || ascii_span_has_core_token(text, index, end)) {
+      emit_ascii_token_span(text, index, end, max_token_length, position,
+                            sink);
     }
-    max_token_length_ = static_cast<uint32_t>(configured_length);
+    index = end;
   }
-  return Status::OK();
 }
 
-std::vector<Token> StandardTokenizer::tokenize(const std::string &text) const {
-  if (is_ascii_text(text)) {
-    return tokenize_ascii(text, max_token_length_);
-  }
-
-  std::vector<Token> tokens;
-  tokens.reserve(estimate_token_capacity(text.size()));
-  uint32_t position = 0;
-  std::vector<StandardCodepoint> codepoints = decode_standard_utf8(text);
+// Full UAX #29 machine over text[begin, text.size()).
+void tokenize_unicode(std::string_view text, size_t begin,
+                      uint32_t max_token_length, uint32_t *position,
+                      const TokenSink &sink) {
+  std::vector<StandardCodepoint> codepoints = decode_standard_utf8(text, begin);
 
   size_t index = 0;
   while (index < codepoints.size()) {
     WordBreakClass cls = codepoints[index].cls;
     if (cls == WordBreakClass::Ideographic || cls == WordBreakClass::Hiragana) {
       size_t end = scan_single_token(codepoints, index);
-      emit_token_span(text, codepoints, index, end, max_token_length_,
-                      &position, &tokens);
+      emit_token_span(text, codepoints, index, end, max_token_length, position,
+                      sink);
       index = end;
       continue;
     }
     if (cls == WordBreakClass::Hangul ||
         cls == WordBreakClass::SoutheastAsian) {
       size_t end = scan_word_token(codepoints, index);
-      emit_token_span(text, codepoints, index, end, max_token_length_,
-                      &position, &tokens);
+      emit_token_span(text, codepoints, index, end, max_token_length, position,
+                      sink);
       index = end;
       continue;
     }
     if (cls == WordBreakClass::RegionalIndicator) {
       size_t end = scan_regional_indicator_token(codepoints, index);
-      emit_token_span(text, codepoints, index, end, max_token_length_,
-                      &position, &tokens);
+      emit_token_span(text, codepoints, index, end, max_token_length, position,
+                      sink);
       index = end;
       continue;
     }
     size_t end = scan_keycap_token(codepoints, index);
     if (end > index) {
-      emit_token_span(text, codepoints, index, end, max_token_length_,
-                      &position, &tokens);
+      emit_token_span(text, codepoints, index, end, max_token_length, position,
+                      sink);
       index = end;
       continue;
     }
     if (cls == WordBreakClass::ExtendedPictographic) {
       end = scan_emoji_token(codepoints, index);
-      emit_token_span(text, codepoints, index, end, max_token_length_,
-                      &position, &tokens);
+      emit_token_span(text, codepoints, index, end, max_token_length, position,
+                      sink);
       index = end;
       continue;
     }
     if (cls == WordBreakClass::ZWJ) {
       end = scan_zwj_ext_pict_token(codepoints, index);
       if (end > index) {
-        emit_token_span(text, codepoints, index, end, max_token_length_,
-                        &position, &tokens);
+        emit_token_span(text, codepoints, index, end, max_token_length,
+                        position, sink);
         index = end;
         continue;
       }
     }
     end = scan_emoji_modifier_token(codepoints, index);
     if (end > index) {
-      emit_token_span(text, codepoints, index, end, max_token_length_,
-                      &position, &tokens);
+      emit_token_span(text, codepoints, index, end, max_token_length, position,
+                      sink);
       index = end;
       continue;
     }
     if (cls == WordBreakClass::ExtendNumLet) {
       end = scan_word_token(codepoints, index);
       if (span_has_core_token(codepoints, index, end)) {
-        emit_token_span(text, codepoints, index, end, max_token_length_,
-                        &position, &tokens);
+        emit_token_span(text, codepoints, index, end, max_token_length,
+                        position, sink);
       }
       index = end;
       continue;
@@ -1030,12 +971,99 @@ std::vector<Token> StandardTokenizer::tokenize(const std::string &text) const {
     }
 
     end = scan_word_token(codepoints, index);
-    emit_token_span(text, codepoints, index, end, max_token_length_, &position,
-                    &tokens);
+    emit_token_span(text, codepoints, index, end, max_token_length, position,
+                    sink);
     index = end;
   }
+}
+
+// Bytes of pure ASCII that must follow a whitespace byte before a non-ASCII
+// segment hands back to the ASCII path; shorter runs are cheaper to keep in
+// the segment than to switch for.
+constexpr size_t kMinAsciiResumeRun = 64;
+
+// End of the non-ASCII segment containing the first non-ASCII byte at
+// \p start: the first ASCII whitespace byte followed by a long enough ASCII
+// run (or by the end of the text).
+size_t find_unicode_segment_end(std::string_view text, size_t start) {
+  const auto &dispatch = simd::get_ascii_dispatch();
+  size_t index = start;
+  while (index < text.size()) {
+    auto ch = static_cast<unsigned char>(text[index]);
+    if (!is_ascii_space(ch)) {
+      ++index;
+      continue;
+    }
+    size_t run = dispatch.ascii_prefix_length(text.data() + index,
+                                              text.size() - index);
+    if (index + run == text.size() || run >= kMinAsciiResumeRun) {
+      return index;
+    }
+    index += run;
+  }
+  return text.size();
+}
+
+}  // namespace
+
+Status StandardTokenizer::init(const ailego::JsonObject &config) {
+  max_token_length_ = kDefaultMaxTokenLength;
+  auto length_val = config["max_token_length"];
+  if (!length_val.is_null()) {
+    if (!length_val.is_integer()) {
+      return Status::InvalidArgument(
+          "StandardTokenizer: max_token_length must be integer");
+    }
+    auto configured_length = length_val.as_integer();
+    if (configured_length < kMinMaxTokenLength ||
+        configured_length > kMaxMaxTokenLength) {
+      return Status::InvalidArgument(
+          "StandardTokenizer: max_token_length out of range: ",
+          configured_length);
+    }
+    max_token_length_ = static_cast<uint32_t>(configured_length);
+  }
+  return Status::OK();
+}
+
+std::vector<Token> StandardTokenizer::tokenize(const std::string &text) const {
+  return collect_tokens(text, estimate_token_capacity(text.size()));
+}
 
-  return tokens;
+void StandardTokenizer::tokenize_stream(const std::string &text,
+                                        const TokenSink &sink) const {
+  // No word-break rule joins across ASCII whitespace and no token starts at
+  // one, so text can be cut at whitespace bytes into ASCII-only segments,
+  // handled by the byte-scanning fast path, and segments with non-ASCII
+  // bytes, handled by the full UAX #29 machine, with identical output.
+  const std::string_view view(text);
+  const auto &dispatch = simd::get_ascii_dispatch();
+  thread_local std::vector<uint64_t> word_bits;
+  word_bits.resize(view.size() / 64 + 1);
+  uint32_t position = 0;
+  size_t begin = 0;
+  while (begin < view.size()) {
+    size_t ascii_end = dispatch.classify_ascii(view.data(), view.size(), begin,
+                                               word_bits.data());
+    if (ascii_end == view.size()) {
+      tokenize_ascii(view, word_bits.data(), begin, max_token_length_,
+                     &position, sink);
+      return;
+    }
+    size_t split = ascii_end;
+    while (split > begin &&
+           !is_ascii_space(static_cast<unsigned char>(view[split - 1]))) {
+      --split;
+    }
+    if (split > begin) {
+      tokenize_ascii(view.substr(0, split), word_bits.data(), begin,
+                     max_token_length_, &position, sink);
+    }
+    size_t unicode_end = find_unicode_segment_end(view, ascii_end);
+    tokenize_unicode(view.substr(0, unicode_end), split, max_token_length_,
+                     &position, sink);
+    begin = unicode_end;
+  }
 }
 
 }  // namespace zvec::fts
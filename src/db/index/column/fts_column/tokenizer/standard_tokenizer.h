@@ -24,6 +24,9 @@ namespace zvec::fts {
  *  Uses a UAX #29 word-boundary profile with Lucene/Elasticsearch compatible
  *  token selection. CJK ideographs are emitted as individual single-character
  *  tokens.
+ *  Whitespace-delimited stretches of pure ASCII skip the UAX #29 machine:
+ *  they are classified 64 bytes at a time (AVX2 when available) into a word
+ *  byte bitmask and tokenized by bit scans, with identical output.
  */
 class StandardTokenizer : public Tokenizer {
  public:
@@ -39,6 +42,9 @@ class StandardTokenizer : public Tokenizer {
 
   std::vector<Token> tokenize(const std::string &text) const override;
 
+  void tokenize_stream(const std::string &text,
+                       const TokenSink &sink) const override;
+
   const char *name() const override {
     return "standard";
   }
@@ -59,22 +59,20 @@ bool StemmerTokenFilter::init(const ailego::JsonObject &config) {
   return true;
 }
 
-std::vector<Token> StemmerTokenFilter::filter(std::vector<Token> tokens) const {
+bool StemmerTokenFilter::apply(std::string *text) const {
   static thread_local ThreadLocalStemmerCache tls_cache;
   auto *stemmer = tls_cache.get(language_);
   if (!stemmer) {
-    return tokens;
+    return true;
   }
-  for (auto &token : tokens) {
-    const auto *result = sb_stemmer_stem(
-        stemmer, reinterpret_cast<const unsigned char *>(token.text.data()),
-        static_cast<int>(token.text.size()));
-    if (result) {
-      int len = sb_stemmer_length(stemmer);
-      token.text.assign(reinterpret_cast<const char *>(result), len);
-    }
+  const auto *result = sb_stemmer_stem(
+      stemmer, reinterpret_cast<const unsigned char *>(text->data()),
+      static_cast<int>(text->size()));
+  if (result) {
+    int len = sb_stemmer_length(stemmer);
+    text->assign(reinterpret_cast<const char *>(result), len);
   }
-  return tokens;
+  return true;
 }
 
 }  // namespace zvec::fts
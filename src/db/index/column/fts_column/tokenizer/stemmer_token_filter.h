@@ -33,7 +33,7 @@ class StemmerTokenFilter : public TokenFilter {
   StemmerTokenFilter &operator=(const StemmerTokenFilter &) = delete;
 
   bool init(const ailego::JsonObject &config) override;
-  std::vector<Token> filter(std::vector<Token> tokens) const override;
+  bool apply(std::string *text) const override;
 
   const char *name() const override {
     return "stemmer";
@@ -15,37 +15,57 @@
 #include "token_filter.h"
 #include <utf8proc.h>
 #include <string>
+#include "ascii_simd_dispatch.h"
 
 namespace zvec::fts {
 
-std::vector<Token> LowercaseTokenFilter::filter(
-    std::vector<Token> tokens) const {
-  for (auto &token : tokens) {
-    std::string result;
-    result.reserve(token.text.size());
-    const auto *str =
-        reinterpret_cast<const utf8proc_uint8_t *>(token.text.data());
-    auto len = static_cast<utf8proc_ssize_t>(token.text.size());
-    utf8proc_ssize_t pos = 0;
-    while (pos < len) {
-      utf8proc_int32_t codepoint;
-      utf8proc_ssize_t bytes =
-          utf8proc_iterate(str + pos, len - pos, &codepoint);
-      if (bytes < 1) {
-        result.push_back(token.text[pos]);
-        ++pos;
-        continue;
-      }
-      utf8proc_int32_t lower = utf8proc_tolower(codepoint);
-      utf8proc_uint8_t buf[4];
-      utf8proc_ssize_t written = utf8proc_encode_char(lower, buf);
-      result.append(reinterpret_cast<const char *>(buf),
-                    static_cast<size_t>(written));
-      pos += bytes;
+std::vector<Token> TokenFilter::filter(std::vector<Token> tokens) const {
+  size_t kept = 0;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    if (!apply(&tokens[i].text)) {
+      continue;
     }
-    token.text = std::move(result);
+    if (kept != i) {
+      tokens[kept] = std::move(tokens[i]);
+    }
+    ++kept;
   }
+  tokens.resize(kept);
   return tokens;
 }
 
+bool LowercaseTokenFilter::apply(std::string *text) const {
+  const size_t ascii_prefix =
+      simd::get_ascii_dispatch().lower_ascii_prefix(text->data(), text->size());
+  if (ascii_prefix == text->size()) {
+    return true;
+  }
+
+  // Lowercasing may change the UTF-8 length, so non-ASCII text is rebuilt
+  // into a per-thread buffer that is swapped in; both buffers keep their
+  // capacity across calls.  The ASCII prefix lowered above is copied as is.
+  static thread_local std::string result;
+  result.assign(text->data(), ascii_prefix);
+  const auto *str = reinterpret_cast<const utf8proc_uint8_t *>(text->data());
+  auto len = static_cast<utf8proc_ssize_t>(text->size());
+  auto pos = static_cast<utf8proc_ssize_t>(ascii_prefix);
+  while (pos < len) {
+    utf8proc_int32_t codepoint;
+    utf8proc_ssize_t bytes = utf8proc_iterate(str + pos, len - pos, &codepoint);
+    if (bytes < 1) {
+      result.push_back((*text)[pos]);
+      ++pos;
+      continue;
+    }
+    utf8proc_int32_t lower = utf8proc_tolower(codepoint);
+    utf8proc_uint8_t buf[4];
+    utf8proc_ssize_t written = utf8proc_encode_char(lower, buf);
+    result.append(reinterpret_cast<const char *>(buf),
+                  static_cast<size_t>(written));
+    pos += bytes;
+  }
+  text->swap(result);
+  return true;
+}
+
 }  // namespace zvec::fts
@@ -39,11 +39,20 @@ class TokenFilter {
     return true;
   }
 
-  /*! Filter/transform a list of tokens.
+  /*! Transform one token in place.
+   *  This is what TokenizerPipeline runs: every filter is applied to a
+   *  token before the next token is produced, on a scratch buffer whose
+   *  capacity is reused across tokens.
+   *  \param text  token text, rewritten in place
+   *  \return      false to drop the token
+   */
+  virtual bool apply(std::string *text) const = 0;
+
+  /*! Filter/transform a list of tokens by running apply() on each.
    *  \param tokens  input token list (may be modified in place)
    *  \return        processed token list
    */
-  virtual std::vector<Token> filter(std::vector<Token> tokens) const = 0;
+  std::vector<Token> filter(std::vector<Token> tokens) const;
 
   /*! Return filter name
    */
@@ -57,7 +66,7 @@ using TokenFilterPtr = std::shared_ptr<TokenFilter>;
  */
 class LowercaseTokenFilter : public TokenFilter {
  public:
-  std::vector<Token> filter(std::vector<Token> tokens) const override;
+  bool apply(std::string *text) const override;
 
   const char *name() const override {
     return "lowercase";
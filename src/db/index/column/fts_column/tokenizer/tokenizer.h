@@ -15,8 +15,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <zvec/ailego/encoding/json/mod_json_plus.h>
 #include <zvec/db/status.h>
@@ -34,6 +36,20 @@ struct Token {
   uint32_t position{0};
 };
 
+/*! Non-owning view of a token, passed to a TokenSink.
+ *  text points into the source text (tokenizer output) or into a scratch
+ *  buffer owned by the pipeline (after filtering); it is only valid for the
+ *  duration of the sink call.
+ */
+struct TokenView {
+  std::string_view text;
+  uint32_t offset{0};
+  uint32_t position{0};
+};
+
+//! Receives tokens in ascending position order.
+using TokenSink = std::function<void(const TokenView &)>;
+
 /*! Abstract tokenizer interface
  *  All tokenizer implementations must inherit from this interface
  */
@@ -55,9 +71,36 @@ class Tokenizer {
    */
   virtual std::vector<Token> tokenize(const std::string &text) const = 0;
 
+  /*! Tokenize input text without materialising tokens.
+   *  The default implementation adapts tokenize(); tokenizers that can emit
+   *  views into \p text override this and implement tokenize() with
+   *  collect_tokens().
+   *  \param text  UTF-8 encoded input text
+   *  \param sink  Called once per token, in ascending position order
+   */
+  virtual void tokenize_stream(const std::string &text,
+                               const TokenSink &sink) const {
+    for (const auto &token : tokenize(text)) {
+      sink(TokenView{token.text, token.offset, token.position});
+    }
+  }
+
   /*! Return tokenizer name
    */
   virtual const char *name() const = 0;
+
+ protected:
+  //! tokenize() on top of tokenize_stream(), for stream-native tokenizers.
+  std::vector<Token> collect_tokens(const std::string &text,
+                                    size_t capacity_hint = 0) const {
+    std::vector<Token> tokens;
+    tokens.reserve(capacity_hint);
+    tokenize_stream(text, [&tokens](const TokenView &token) {
+      tokens.push_back(
+          Token{std::string(token.text), token.offset, token.position});
+    });
+    return tokens;
+  }
 };
 
 using TokenizerPtr = std::shared_ptr<Tokenizer>;
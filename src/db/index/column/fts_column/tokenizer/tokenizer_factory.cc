@@ -76,6 +76,24 @@ std::vector<Token> TokenizerPipeline::process(const std::string &text) const {
   return tokens;
 }
 
+void TokenizerPipeline::process_stream(const std::string &text,
+                                       const TokenSink &sink) const {
+  if (filters_.empty()) {
+    tokenizer_->tokenize_stream(text, sink);
+    return;
+  }
+  std::string scratch;
+  tokenizer_->tokenize_stream(text, [&](const TokenView &token) {
+    scratch.assign(token.text.data(), token.text.size());
+    for (const auto &filter : filters_) {
+      if (!filter->apply(&scratch)) {
+        return;
+      }
+    }
+    sink(TokenView{scratch, token.offset, token.position});
+  });
+}
+
 Status TokenizerFactory::create_tokenizer(const std::string &tokenizer_name,
                                           const ailego::JsonObject &extra_json,
                                           TokenizerPtr *tokenizer) {
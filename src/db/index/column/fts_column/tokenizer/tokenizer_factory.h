@@ -35,6 +35,17 @@ class TokenizerPipeline {
    */
   std::vector<Token> process(const std::string &text) const;
 
+  /*! Streaming form of process() for the indexing path.
+   *  Tokenizer and filters are fused into one pass: each token is copied
+   *  into a scratch buffer owned by this call, every filter rewrites it in
+   *  place, and the result is handed to \p sink before the next token is
+   *  produced.  Without filters the views point straight into \p text.
+   *  \param text  UTF-8 encoded input text
+   *  \param sink  Called once per surviving token; the view is only valid
+   *               during the call
+   */
+  void process_stream(const std::string &text, const TokenSink &sink) const;
+
  private:
   TokenizerPtr tokenizer_;
   std::vector<TokenFilterPtr> filters_;
@@ -17,9 +17,9 @@
 
 namespace zvec::fts {
 
-std::vector<Token> WhitespaceTokenizer::tokenize(
-    const std::string &text) const {
-  std::vector<Token> tokens;
+void WhitespaceTokenizer::tokenize_stream(const std::string &text,
+                                          const TokenSink &sink) const {
+  const std::string_view view(text);
   uint32_t position = 0;
   size_t index = 0;
   const size_t text_length = text.size();
@@ -43,14 +43,9 @@ std::vector<Token> WhitespaceTokenizer::tokenize(
       ++index;
     }
 
-    Token token;
-    token.text = text.substr(token_start, index - token_start);
-    token.offset = token_start;
-    token.position = position++;
-    tokens.push_back(std::move(token));
+    sink(TokenView{view.substr(token_start, index - token_start), token_start,
+                   position++});
   }
-
-  return tokens;
 }
 
 }  // namespace zvec::fts
@@ -29,7 +29,12 @@ class WhitespaceTokenizer : public Tokenizer {
     return Status::OK();
   }
 
-  std::vector<Token> tokenize(const std::string &text) const override;
+  std::vector<Token> tokenize(const std::string &text) const override {
+    return collect_tokens(text);
+  }
+
+  void tokenize_stream(const std::string &text,
+                       const TokenSink &sink) const override;
 
   const char *name() const override {
     return "whitespace";
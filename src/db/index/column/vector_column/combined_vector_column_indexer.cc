@@ -27,6 +27,7 @@ bool IsBetterScore(MetricType metric_type, float lhs, float rhs) {
       return lhs > rhs;
     case MetricType::L2:
     case MetricType::COSINE:
+    case MetricType::HAMMING:
     default:
       return lhs < rhs;
   }
@@ -143,7 +143,8 @@ class ProximaEngineHelper {
       return tl::make_unexpected(Status::InvalidArgument("nullptr"));
     }
     switch (field_schema.index_params()->type()) {
-      case IndexType::FLAT: {
+      case IndexType::FLAT:
+      case IndexType::INVERTED_SPARSE: {
         // auto db_index_params =
         //     dynamic_cast<const FlatIndexParams
         //     *>(field_schema.index_params());
@@ -295,6 +296,8 @@ class ProximaEngineHelper {
         return core_interface::MetricType::kL2sq;
       case MetricType::COSINE:
         return core_interface::MetricType::kCosine;
+      case MetricType::HAMMING:
+        return core_interface::MetricType::kHamming;
       default:
         return tl::make_unexpected(
             Status::InvalidArgument("unsupported metric type"));
@@ -334,6 +337,12 @@ class ProximaEngineHelper {
       case DataType::VECTOR_INT8:
         return core_interface::DataType::DT_INT8;
 
+      case DataType::VECTOR_BINARY32:
+        return core_interface::DataType::DT_BINARY32;
+
+      case DataType::VECTOR_BINARY64:
+        return core_interface::DataType::DT_BINARY64;
+
       default:
         return tl::make_unexpected(
             Status::InvalidArgument("unsupported data type"));
@@ -354,8 +363,16 @@ class ProximaEngineHelper {
     // db will ensure the id is consecutive
     index_param_builder->with_use_id_map(false);
 
+    // binary vectors are sized in words by the schema but in bits by the
+    // engine
+    uint32_t dimension = field_schema.dimension();
+    if (field_schema.data_type() == DataType::VECTOR_BINARY32) {
+      dimension *= 32;
+    } else if (field_schema.data_type() == DataType::VECTOR_BINARY64) {
+      dimension *= 64;
+    }
     index_param_builder->with_is_sparse(field_schema.is_sparse_vector())
-        .with_dimension(field_schema.dimension());
+        .with_dimension(dimension);
     if (auto data_type_result =
             convert_to_engine_data_type(field_schema.data_type());
         data_type_result.has_value()) {
@@ -407,6 +424,25 @@ class ProximaEngineHelper {
         return index_param_builder.value()->build();
       }
 
+      case IndexType::INVERTED_SPARSE: {
+        auto index_param_builder_result = _build_common_index_param<
+            InvertedSparseIndexParams, core_interface::FlatIndexParamBuilder>(
+            field_schema);
+        if (!index_param_builder_result.has_value()) {
+          return tl::make_unexpected(Status::InvalidArgument(
+              "failed to build index param: " +
+              index_param_builder_result.error().message()));
+        }
+        auto index_param_builder = index_param_builder_result.value();
+
+        auto db_index_params = dynamic_cast<const InvertedSparseIndexParams *>(
+            field_schema.index_params().get());
+        index_param_builder->with_use_inverted(true);
+        index_param_builder->with_heap_factor(db_index_params->heap_factor());
+
+        return index_param_builder->build();
+      }
+
       case IndexType::HNSW: {
         auto index_param_builder_result =
             _build_common_index_param<HnswIndexParams,
@@ -90,6 +90,10 @@ constexpr uint32_t kUseContiguousMemory = 6;
 constexpr uint32_t kUseIdMap = 7;
 constexpr uint32_t kTwoPassBuild = 8;
 }  // namespace f_vamana
+namespace f_inverted_sparse {
+constexpr uint32_t kBase = 1;
+constexpr uint32_t kHeapFactor = 2;
+}  // namespace f_inverted_sparse
 namespace f_fts {
 constexpr uint32_t kTokenizerName = 1;
 constexpr uint32_t kFilters = 2;
@@ -105,6 +109,7 @@ constexpr uint32_t kVamana = 6;
 constexpr uint32_t kFts = 7;
 constexpr uint32_t kDiskann = 8;
 constexpr uint32_t kIvfRabitq = 9;
+constexpr uint32_t kInvertedSparse = 10;
 }  // namespace f_index_params
 namespace f_field {
 constexpr uint32_t kName = 1;
@@ -378,6 +383,35 @@ FlatIndexParams::OPtr DecodeFlat(std::string_view buf) {
                                            QuantizerParam(base.enable_rotate));
 }
 
+void EncodeInvertedSparse(const InvertedSparseIndexParams *params,
+                          std::string *out) {
+  std::string base;
+  EncodeBase(MakeBase(params), &base);
+  Writer w(out);
+  w.PutMessage(f_inverted_sparse::kBase, base);
+  w.PutFloat(f_inverted_sparse::kHeapFactor, params->heap_factor());
+}
+
+InvertedSparseIndexParams::OPtr DecodeInvertedSparse(std::string_view buf) {
+  BaseParams base;
+  float heap_factor = 1.0f;
+  Reader r(buf);
+  while (r.Next()) {
+    switch (r.field()) {
+      case f_inverted_sparse::kBase:
+        base = DecodeBase(r.bytes());
+        break;
+      case f_inverted_sparse::kHeapFactor:
+        heap_factor = r.float_value();
+        break;
+      default:
+        break;
+    }
+  }
+  return std::make_shared<InvertedSparseIndexParams>(base.metric_type,
+                                                     heap_factor);
+}
+
 void EncodeIvf(const IVFIndexParams *params, std::string *out) {
   std::string base;
   EncodeBase(MakeBase(params), &base);
@@ -604,6 +638,12 @@ void ManifestCodec::EncodeIndexParams(const IndexParams *params,
         w.PutMessage(f_index_params::kFlat, payload);
       }
       break;
+    case IndexType::INVERTED_SPARSE:
+      if (auto *p = dynamic_cast<const InvertedSparseIndexParams *>(params)) {
+        EncodeInvertedSparse(p, &payload);
+        w.PutMessage(f_index_params::kInvertedSparse, payload);
+      }
+      break;
     case IndexType::IVF:
       if (auto *p = dynamic_cast<const IVFIndexParams *>(params)) {
         EncodeIvf(p, &payload);
@@ -660,6 +700,9 @@ IndexParams::Ptr ManifestCodec::DecodeIndexParams(std::string_view buf) {
       case f_index_params::kFlat:
         params = DecodeFlat(r.bytes());
         break;
+      case f_index_params::kInvertedSparse:
+        params = DecodeInvertedSparse(r.bytes());
+        break;
       case f_index_params::kIvf:
         params = DecodeIvf(r.bytes());
         break;
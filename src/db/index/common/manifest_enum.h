@@ -71,6 +71,7 @@ enum class IndexType : int32_t {
   IT_VAMANA = 5,
   IT_DISKANN = 6,
   IT_IVF_RABITQ = 7,
+  IT_INVERTED_SPARSE = 8,
   IT_INVERT = 10,
   IT_FTS = 11,
 };
@@ -90,6 +91,7 @@ enum class MetricType : int32_t {
   MT_L2 = 1,
   MT_IP = 2,
   MT_COSINE = 3,
+  MT_HAMMING = 4,
 };
 
 //! Mirrors proto enum BlockType.
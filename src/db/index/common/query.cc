@@ -113,10 +113,22 @@ Status QueryTarget::validate(const FieldSchema *schema,
               query_vector.size() / sizeof(int8_t), " (INT8)");
         }
         break;
-      case DataType::VECTOR_INT16:
-      case DataType::VECTOR_INT4:
       case DataType::VECTOR_BINARY32:
+        if (dim * sizeof(uint32_t) != query_vector.size()) {
+          return Status::InvalidArgument(
+              "Invalid query: dimension mismatch, expected ", dim, " but got ",
+              query_vector.size() / sizeof(uint32_t), " (BINARY32)");
+        }
+        break;
       case DataType::VECTOR_BINARY64:
+        if (dim * sizeof(uint64_t) != query_vector.size()) {
+          return Status::InvalidArgument(
+              "Invalid query: dimension mismatch, expected ", dim, " but got ",
+              query_vector.size() / sizeof(uint64_t), " (BINARY64)");
+        }
+        break;
+      case DataType::VECTOR_INT16:
+      case DataType::VECTOR_INT4:
         return Status::NotSupported(
             "Invalid query: dense vector type of field[", field_name,
             "] is not supported");
@@ -42,6 +42,8 @@ std::unordered_set<DataType> support_dense_vector_type = {
     DataType::VECTOR_FP32,
     DataType::VECTOR_FP16,
     DataType::VECTOR_INT8,
+    DataType::VECTOR_BINARY32,
+    DataType::VECTOR_BINARY64,
 };
 
 std::unordered_set<DataType> support_sparse_vector_type = {
@@ -54,7 +56,10 @@ std::unordered_set<IndexType> support_dense_vector_index = {
     IndexType::IVF,   IndexType::IVF_RABITQ, IndexType::DISKANN,
     IndexType::VAMANA};
 
-std::unordered_set<IndexType> support_sparse_vector_index = {IndexType::FLAT,
+std::unordered_set<IndexType> support_sparse_vector_index = {
+    IndexType::FLAT, IndexType::HNSW, IndexType::INVERTED_SPARSE};
+
+std::unordered_set<IndexType> support_binary_vector_index = {IndexType::FLAT,
                                                              IndexType::HNSW};
 
 static Status validate_fts_index_params(const FieldSchema &field) {
@@ -129,7 +134,7 @@ Status FieldSchema::validate() const {
             support_sparse_vector_index.end()) {
           return Status::InvalidArgument(
               "schema validate failed: sparse_vector's index_params only "
-              "support FLAT|HNSW index, "
+              "support FLAT|HNSW|INVERTED_SPARSE index, "
               "but field[",
               name_, "]'s index_type is ",
               IndexTypeCodeBook::AsString(index_params_->type()));
@@ -142,6 +147,23 @@ Status FieldSchema::validate() const {
               name_, "]'s metric is ",
               MetricTypeCodeBook::AsString(vector_index_params->metric_type()));
         }
+        if (index_params_->type() == IndexType::INVERTED_SPARSE) {
+          auto inverted_params =
+              std::dynamic_pointer_cast<InvertedSparseIndexParams>(
+                  index_params_);
+          if (!inverted_params) {
+            return Status::InvalidArgument(
+                "schema validate failed: INVERTED_SPARSE index requires "
+                "InvertedSparseIndexParams");
+          }
+          if (!(inverted_params->heap_factor() > 0.0f &&
+                inverted_params->heap_factor() <= 1.0f)) {
+            return Status::InvalidArgument(
+                "schema validate failed: INVERTED_SPARSE heap_factor must be "
+                "in (0, 1], but field[",
+                name_, "]'s heap_factor is ", inverted_params->heap_factor());
+          }
+        }
 
       } else {
         if (support_dense_vector_index.find(index_params_->type()) ==
@@ -280,6 +302,26 @@ Status FieldSchema::validate() const {
               DataTypeCodeBook::AsString(data_type_));
         }
       }
+      const bool is_binary = data_type_ == DataType::VECTOR_BINARY32 ||
+                             data_type_ == DataType::VECTOR_BINARY64;
+      if ((vector_index_params->metric_type() == MetricType::HAMMING) !=
+          is_binary) {
+        return Status::InvalidArgument(
+            "schema validate failed: hamming metric is required by and only "
+            "supports BINARY32/BINARY64 data types, but field[",
+            name_, "]'s data type is ", DataTypeCodeBook::AsString(data_type_),
+            " with metric ",
+            MetricTypeCodeBook::AsString(vector_index_params->metric_type()));
+      }
+      if (is_binary &&
+          support_binary_vector_index.find(index_params_->type()) ==
+              support_binary_vector_index.end()) {
+        return Status::InvalidArgument(
+            "schema validate failed: binary vector's index_params only "
+            "support FLAT|HNSW index, but field[",
+            name_, "]'s index_type is ",
+            IndexTypeCodeBook::AsString(index_params_->type()));
+      }
     }
   } else {
     if (index_params_) {
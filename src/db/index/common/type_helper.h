@@ -50,6 +50,8 @@ struct IndexTypeCodeBook {
         return IndexType::HNSW_RABITQ;
       case wire::IndexType::IT_IVF_RABITQ:
         return IndexType::IVF_RABITQ;
+      case wire::IndexType::IT_INVERTED_SPARSE:
+        return IndexType::INVERTED_SPARSE;
       case wire::IndexType::IT_FLAT:
         return IndexType::FLAT;
       case wire::IndexType::IT_IVF:
@@ -77,6 +79,8 @@ struct IndexTypeCodeBook {
         return wire::IndexType::IT_HNSW_RABITQ;
       case IndexType::IVF_RABITQ:
         return wire::IndexType::IT_IVF_RABITQ;
+      case IndexType::INVERTED_SPARSE:
+        return wire::IndexType::IT_INVERTED_SPARSE;
       case IndexType::FLAT:
         return wire::IndexType::IT_FLAT;
       case IndexType::IVF:
@@ -104,6 +108,8 @@ struct IndexTypeCodeBook {
         return "HNSW_RABITQ";
       case IndexType::IVF_RABITQ:
         return "IVF_RABITQ";
+      case IndexType::INVERTED_SPARSE:
+        return "INVERTED_SPARSE";
       case IndexType::FLAT:
         return "FLAT";
       case IndexType::IVF:
@@ -424,6 +430,8 @@ struct MetricTypeCodeBook {
         return MetricType::L2;
       case wire::MetricType::MT_COSINE:
         return MetricType::COSINE;
+      case wire::MetricType::MT_HAMMING:
+        return MetricType::HAMMING;
       default:
         return MetricType::UNDEFINED;
     }
@@ -437,6 +445,8 @@ struct MetricTypeCodeBook {
         return wire::MetricType::MT_L2;
       case MetricType::COSINE:
         return wire::MetricType::MT_COSINE;
+      case MetricType::HAMMING:
+        return wire::MetricType::MT_HAMMING;
       default:
         return wire::MetricType::MT_UNDEFINED;
     }
@@ -450,6 +460,8 @@ struct MetricTypeCodeBook {
         return "L2";
       case MetricType::COSINE:
         return "COSINE";
+      case MetricType::HAMMING:
+        return "HAMMING";
       default:
         return "UNDEFINED";
     }
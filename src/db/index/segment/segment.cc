@@ -46,6 +46,7 @@
 #include "db/common/typedef.h"
 #include "db/index/column/fts_column/fts_column_indexer.h"
 #include "db/index/column/fts_column/fts_indexer.h"
+#include "db/index/column/fts_column/fts_query_cache.h"
 #include "db/index/column/inverted_column/inverted_indexer.h"
 #include "db/index/column/vector_column/vector_column_indexer.h"
 #include "db/index/column/vector_column/vector_column_params.h"
@@ -134,11 +135,14 @@ class SegmentImpl : public Segment,
 
   bool has_record() override;
 
-  Status Insert(Doc &doc) override;
+  Status Insert(Doc &doc,
+                const fts::FtsTokenizedFields *fts_tokens = nullptr) override;
 
-  Status Update(Doc &doc) override;
+  Status Update(Doc &doc,
+                const fts::FtsTokenizedFields *fts_tokens = nullptr) override;
 
-  Status Upsert(Doc &doc) override;
+  Status Upsert(Doc &doc,
+                const fts::FtsTokenizedFields *fts_tokens = nullptr) override;
 
   Status Delete(const std::string &pk) override;
 
@@ -306,11 +310,15 @@ class SegmentImpl : public Segment,
                       const FieldSchema::Ptr &field);
 
   Status insert_scalar_indexer(Doc &doc);
-  Status insert_fts_indexer(Doc &doc);
+  Status insert_fts_indexer(Doc &doc,
+                            const fts::FtsTokenizedFields *fts_tokens);
   Status insert_vector_indexer(Doc &doc);
-  Status internal_insert(Doc &doc);
-  Status internal_update(Doc &doc);
-  Status internal_upsert(Doc &doc);
+  Status internal_insert(Doc &doc,
+                         const fts::FtsTokenizedFields *fts_tokens = nullptr);
+  Status internal_update(Doc &doc,
+                         const fts::FtsTokenizedFields *fts_tokens = nullptr);
+  Status internal_upsert(Doc &doc,
+                         const fts::FtsTokenizedFields *fts_tokens = nullptr);
   Status internal_delete(const Doc &doc);
 
   Status recover();
@@ -363,6 +371,8 @@ class SegmentImpl : public Segment,
   // FTS index (uses segment-local doc ID)
   FtsIndexer::Ptr fts_indexer_;
   bool has_fts_{false};
+  // FtsQueryCache scope of fts_indexer_, renewed whenever it is replaced
+  std::atomic<uint64_t> fts_cache_scope_{fts::FtsQueryCache::NewScope()};
 
   // vector index (uses block-local doc ID, each indexer starts from 0)
   std::unordered_map<std::string, VectorColumnIndexer::Ptr>
@@ -864,7 +874,8 @@ Status SegmentImpl::insert_vector_indexer(Doc &doc) {
   return Status::OK();
 }
 
-Status SegmentImpl::internal_insert(Doc &doc) {
+Status SegmentImpl::internal_insert(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
   uint64_t g_doc_id = doc_id_allocator_.fetch_add(1);
   doc.set_doc_id(g_doc_id);
 
@@ -893,7 +904,7 @@ Status SegmentImpl::internal_insert(Doc &doc) {
     return s;
   }
   // write FTS index
-  s = insert_fts_indexer(doc);
+  s = insert_fts_indexer(doc, fts_tokens);
   CHECK_RETURN_STATUS(s);
   // write vector index
   s = insert_vector_indexer(doc);
@@ -910,18 +921,20 @@ Status SegmentImpl::internal_insert(Doc &doc) {
   return Status::OK();
 }
 
-Status SegmentImpl::internal_update(Doc &doc) {
+Status SegmentImpl::internal_update(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
   delete_store_->mark_deleted(doc.doc_id());
-  return internal_insert(doc);
+  return internal_insert(doc, fts_tokens);
 }
 
-Status SegmentImpl::internal_upsert(Doc &doc) {
+Status SegmentImpl::internal_upsert(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
   uint64_t g_doc_id;
   bool exist = id_map_->has(doc.pk(), &g_doc_id);
   if (exist) {
     delete_store_->mark_deleted(g_doc_id);
   }
-  return internal_insert(doc);
+  return internal_insert(doc, fts_tokens);
 }
 
 Status SegmentImpl::internal_delete(const Doc &doc) {
@@ -930,7 +943,8 @@ Status SegmentImpl::internal_delete(const Doc &doc) {
   return Status::OK();
 }
 
-Status SegmentImpl::Insert(Doc &doc) {
+Status SegmentImpl::Insert(Doc &doc,
+                           const fts::FtsTokenizedFields *fts_tokens) {
   std::lock_guard lock(seg_mtx_);
 
   if (id_map_ && id_map_->has(doc.pk())) {
@@ -944,10 +958,11 @@ Status SegmentImpl::Insert(Doc &doc) {
   auto s = append_wal(doc);
   CHECK_RETURN_STATUS(s);
 
-  return internal_insert(doc);
+  return internal_insert(doc, fts_tokens);
 }
 
-Status SegmentImpl::Update(Doc &doc) {
+Status SegmentImpl::Update(Doc &doc,
+                           const fts::FtsTokenizedFields *fts_tokens) {
   std::lock_guard lock(seg_mtx_);
   uint64_t g_doc_id;
   if (!id_map_->has(doc.pk(), &g_doc_id)) {
@@ -962,10 +977,11 @@ Status SegmentImpl::Update(Doc &doc) {
   auto s = append_wal(doc);
   CHECK_RETURN_STATUS(s);
 
-  return internal_update(doc);
+  return internal_update(doc, fts_tokens);
 }
 
-Status SegmentImpl::Upsert(Doc &doc) {
+Status SegmentImpl::Upsert(Doc &doc,
+                           const fts::FtsTokenizedFields *fts_tokens) {
   std::lock_guard lock(seg_mtx_);
 
   doc.set_operator(Operator::UPSERT);
@@ -974,7 +990,7 @@ Status SegmentImpl::Upsert(Doc &doc) {
   auto s = append_wal(doc);
   CHECK_RETURN_STATUS(s);
 
-  return internal_upsert(doc);
+  return internal_upsert(doc, fts_tokens);
 }
 
 Status SegmentImpl::Delete(const std::string &pk) {
@@ -4502,18 +4518,32 @@ Status SegmentImpl::flush_fts_indexers() {
 Status SegmentImpl::close_fts_indexers() {
   if (fts_indexer_) {
     fts_indexer_.reset();
+    fts::FtsQueryCache::Instance().erase_scope(fts_cache_scope_.exchange(
+        fts::FtsQueryCache::NewScope(), std::memory_order_acq_rel));
   }
   return Status::OK();
 }
 
-Status SegmentImpl::insert_fts_indexer(Doc &doc) {
+Status SegmentImpl::insert_fts_indexer(
+    Doc &doc, const fts::FtsTokenizedFields *fts_tokens) {
   if (!has_fts_) {
     return Status::OK();
   }
   for (const auto &field : collection_schema_->fts_fields()) {
+    auto segment_doc_id = doc_ids_.size();
+    if (fts_tokens) {
+      auto it = fts_tokens->find(field->name());
+      if (it != fts_tokens->end()) {
+        auto s =
+            fts_indexer_->insert(field->name(), segment_doc_id, it->second);
+        if (!s.ok()) {
+          return s;
+        }
+        continue;
+      }
+    }
     auto value = doc.get<std::string>(field->name());
     if (value.has_value()) {
-      auto segment_doc_id = doc_ids_.size();
       auto s =
           fts_indexer_->insert(field->name(), segment_doc_id, value.value());
       if (!s.ok()) {
@@ -4548,13 +4578,50 @@ Result<std::vector<fts::FtsResult>> SegmentImpl::fts_search(
         Status::NotFound("FTS indexer not found: ", field_name));
   }
 
-  auto ret = indexer->search(ast, params);
-  if (!ret.has_value()) {
-    return tl::make_unexpected(Status::InternalError(
-        "FTS search failed: ", field_name, " ", ret.error().message()));
+  // Results of a sealed segment only change with its deletes and with the
+  // collection statistics, which the epoch stamps on each entry; the writing
+  // segment changes with every insert.  Anytime ranking under a time budget
+  // returns whatever it reached in time, so its results are never cached.
+  auto &cache = fts::FtsQueryCache::Instance();
+  const bool timed = params.anytime && params.anytime_budget.count() > 0;
+  if (!params.use_cache || params.candidate_ids || timed ||
+      cache.capacity() == 0 || segment_meta_->has_writing_forward_block()) {
+    auto ret = indexer->search(ast, params);
+    if (!ret.has_value()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FTS search failed: ", field_name, " ", ret.error().message()));
+    }
+    return std::move(ret.value());
+  }
+
+  const uint64_t deleted =
+      delete_store_ ? delete_store_->range_count(segment_meta_->min_doc_id(),
+                                                 segment_meta_->max_doc_id())
+                    : 0;
+  const fts::FtsQueryCache::Key key{
+      fts_cache_scope_.load(std::memory_order_acquire),
+      fts::FtsQueryCache::QueryKey(field_name, ast, params), params.topk};
+  const fts::FtsQueryCache::Epoch epoch{
+      deleted, fts::FtsQueryCache::StatsEpoch(params)};
+  std::vector<fts::FtsResult> results;
+  if (!cache.get(key, epoch, &results)) {
+    // A threshold shared with other segments prunes this segment's list
+    // below the global bar, so search without it to cache the full list.
+    fts::FtsQueryParams full_params = params;
+    full_params.topk_threshold = nullptr;
+    auto ret = indexer->search(ast, full_params);
+    if (!ret.has_value()) {
+      return tl::make_unexpected(Status::InternalError(
+          "FTS search failed: ", field_name, " ", ret.error().message()));
+    }
+    results = std::move(ret.value());
+    cache.put(key, epoch, results);
   }
-
-  return std::move(ret.value());
+  if (params.topk_threshold && params.collection_stats && params.topk > 0 &&
+      results.size() >= params.topk) {
+    params.topk_threshold->raise(results[params.topk - 1].score);
+  }
+  return results;
 }
 
 Status SegmentImpl::create_fts_index(const std::string &column,
@@ -4768,6 +4835,8 @@ Status SegmentImpl::reload_fts_index(const CollectionSchema &schema,
   } else {
     fts_indexer_ = new_fts_indexer;
   }
+  fts::FtsQueryCache::Instance().erase_scope(fts_cache_scope_.exchange(
+      fts::FtsQueryCache::NewScope(), std::memory_order_acq_rel));
 
   has_fts_ = (fts_indexer_ != nullptr);
   fresh_persist_block_offset();
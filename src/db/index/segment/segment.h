@@ -27,6 +27,7 @@
 #include <zvec/db/status.h>
 #include "db/index/column/fts_column/fts_column_indexer.h"
 #include "db/index/column/fts_column/fts_indexer.h"
+#include "db/index/column/fts_column/fts_tokenized_text.h"
 #include "db/index/column/inverted_column/inverted_column_indexer.h"
 #include "db/index/column/inverted_column/inverted_indexer.h"
 #include "db/index/column/vector_column/combined_vector_column_indexer.h"
@@ -142,11 +143,17 @@ class Segment {
                                   const FtsIndexer::Ptr &new_fts_indexer) = 0;
 
   // ---- Data operations ----------------------------------------------------
-  virtual Status Insert(Doc &doc) = 0;
+  // \p fts_tokens optionally carries the doc's FTS fields tokenized ahead of
+  // the write (see fts::tokenize_fts_batch()); fields missing from it are
+  // tokenized inline.
+  virtual Status Insert(
+      Doc &doc, const fts::FtsTokenizedFields *fts_tokens = nullptr) = 0;
 
-  virtual Status Upsert(Doc &doc) = 0;
+  virtual Status Upsert(
+      Doc &doc, const fts::FtsTokenizedFields *fts_tokens = nullptr) = 0;
 
-  virtual Status Update(Doc &doc) = 0;
+  virtual Status Update(
+      Doc &doc, const fts::FtsTokenizedFields *fts_tokens = nullptr) = 0;
 
   virtual Status Delete(const std::string &pk) = 0;
 
@@ -34,6 +34,7 @@
 #include "db/index/column/fts_column/fts_column_indexer.h"
 #include "db/index/column/fts_column/fts_rocksdb_merge.h"
 #include "db/index/column/fts_column/fts_rocksdb_reducer.h"
+#include "db/index/column/fts_column/fts_sealed_postings.h"
 #include "db/index/column/fts_column/fts_types.h"
 #include "db/index/column/inverted_column/inverted_indexer.h"
 #include "db/index/column/vector_column/engine_helper.hpp"
@@ -1070,9 +1071,9 @@ Status SegmentHelper::ReduceFts(const CollectionSchema::Ptr &schema,
       fts::FtsSegmentStats stats{seg->meta()->min_doc_id(),
                                  seg->meta()->max_doc_id(),
                                  seg->meta()->doc_count()};
-      auto feed_ret =
-          reducer.feed(stats, src_indexer->ctx(), src_indexer->postings_cf(),
-                       src_indexer->positions_cf());
+      auto feed_ret = reducer.feed(
+          stats, src_indexer->ctx(), src_indexer->postings_cf(),
+          src_indexer->positions_cf(), src_indexer->complete_phrase_shingles());
       if (!feed_ret) {
         auto err = feed_ret.error();
         LOG_ERROR("ReduceFts: reducer.feed failed. field[%s] err[%s]",
@@ -1091,6 +1092,29 @@ Status SegmentHelper::ReduceFts(const CollectionSchema::Ptr &schema,
       return err;
     }
     (void)reducer.cleanup();
+
+    // Compaction output is sealed: write the memory-mapped query files too,
+    // with impacts scored against the merged statistics when the field
+    // asks for them.
+    bool impact_ordered =
+        input_segments.front()->get_fts_indexer(name)->impact_ordered();
+    fts::BM25Scorer impact_scorer;
+    if (impact_ordered &&
+        impact_scorer.load_segment_stats(name, dst_ctx.get(), dst_stat_cf) !=
+            0) {
+      LOG_WARN("ReduceFts: no merged BM25 stats, impacts skipped. field[%s]",
+               name.c_str());
+      impact_ordered = false;
+    }
+    s = fts::FtsSealedPostings::Build(
+        dst_fts_path, name, dst_ctx.get(), dst_postings_cf, dst_positions_cf,
+        impact_ordered ? &impact_scorer : nullptr);
+    if (!s.ok()) {
+      LOG_ERROR("ReduceFts: build sealed postings failed. field[%s] err[%s]",
+                name.c_str(), s.message().c_str());
+      (void)dst_ctx->close();
+      return s;
+    }
   }
 
   s = dst_ctx->flush();
@@ -100,6 +100,8 @@ Result<double> normalize_score(double score, const FieldSchema &field) {
       return 0.5 + std::atan(score) / M_PI;
     case MetricType::COSINE:
       return 1.0 - score / 2.0;
+    case MetricType::HAMMING:
+      return 1.0 - 2.0 * std::atan(score) / M_PI;
     default:
       return tl::make_unexpected(Status::InvalidArgument(
           "Unsupported metric type for normalization: ",
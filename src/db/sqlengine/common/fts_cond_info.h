@@ -14,9 +14,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include "db/index/column/fts_column/fts_query_ast.h"
+#include "db/index/column/fts_column/fts_types.h"
 
 namespace zvec::sqlengine {
 
@@ -38,6 +40,14 @@ struct FtsCondInfo {
 
   std::string field_name;
   fts::FtsAstNodePtr fts_ast;
+  // Set by the planner when the query spans several segments: BM25
+  // statistics of the whole collection and the top-k threshold shared by
+  // the per-segment searches.
+  std::shared_ptr<const fts::FtsCollectionStats> collection_stats;
+  std::shared_ptr<fts::FtsTopkThreshold> topk_threshold;
+  // Anytime ranking requested by the query (see fts::FtsQueryParams).
+  bool anytime{false};
+  std::chrono::microseconds anytime_budget{0};
 };
 
 }  // namespace zvec::sqlengine
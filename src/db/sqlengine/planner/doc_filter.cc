@@ -70,6 +70,10 @@ bool DocFilter::empty() const {
            forward_filter_expr_);
 }
 
+bool DocFilter::has_query_filter() const {
+  return invert_filter_ || forward_plan_ || forward_filter_expr_;
+}
+
 bool DocFilter::is_filtered(uint64_t id) const {
   if (delete_filter_ && delete_filter_->is_filtered(id)) {
     return true;
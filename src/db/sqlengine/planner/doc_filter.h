@@ -52,6 +52,9 @@ class DocFilter : public IndexFilter {
 
   bool empty() const;
 
+  //! Whether any filter besides the delete filter applies.
+  bool has_query_filter() const;
+
  private:
   std::optional<bool> get_forward_bit(uint64_t id) const;
   std::optional<bool> is_matched_by_forward_filter(uint64_t id) const;
@@ -130,6 +130,12 @@ Result<FtsIndexResults::Ptr> FtsRecallNode::prepare() {
   // Push down remaining filters (delete / forward) so filtered docs are
   // skipped during scoring and we still return up to topk results.
   params.filter = doc_filter_->empty() ? nullptr : doc_filter_;
+  params.collection_stats = fts_cond->collection_stats;
+  params.topk_threshold = fts_cond->topk_threshold;
+  params.anytime = fts_cond->anytime;
+  params.anytime_budget = fts_cond->anytime_budget;
+  // Deletes are versioned by the segment; any other filter is per query.
+  params.use_cache = !params.candidate_ids && !doc_filter_->has_query_filter();
 
   auto results =
       segment_->fts_search(fts_cond->field_name, *fts_cond->fts_ast, params);
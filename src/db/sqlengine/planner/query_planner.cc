@@ -366,6 +366,12 @@ Result<PlanInfo::Ptr> QueryPlanner::make_physical_plan(
   Optimizer::Ptr optimizer =
       InvertCondOptimizer::CreateInvertCondOptimizer(schema_);
   int num_segments = segments.size();
+  // Merged FTS results are only ordered correctly when every segment scores
+  // with the same BM25 statistics.  The shared threshold assumes the merge
+  // keeps the global top-n by score, which group by does not.
+  if (has_fts && num_segments > 1) {
+    share_fts_stats(segments, *query_infos, !has_group_by);
+  }
   std::vector<PlanInfo::Ptr> segment_plans(segments.size());
   for (int idx = 0; idx < num_segments; ++idx) {
     auto &segment = segments[idx];
@@ -639,6 +645,26 @@ Result<PlanInfo::Ptr> QueryPlanner::invert_scan(
   return std::make_shared<PlanInfo>(std::move(node), std::move(schema));
 }
 
+void QueryPlanner::share_fts_stats(
+    const std::vector<Segment::Ptr> &segments,
+    const std::vector<sqlengine::QueryInfo::Ptr> &query_infos,
+    bool share_threshold) {
+  const auto &fts_cond = query_infos[0]->fts_cond_info();
+  auto stats = std::make_shared<fts::FtsCollectionStats>();
+  for (const auto &segment : segments) {
+    if (auto indexer = segment->get_fts_indexer(fts_cond->field_name)) {
+      indexer->collect_stats(*fts_cond->fts_ast, stats.get());
+    }
+  }
+  auto threshold =
+      share_threshold ? std::make_shared<fts::FtsTopkThreshold>() : nullptr;
+  for (const auto &query_info : query_infos) {
+    const auto &cond = query_info->fts_cond_info();
+    cond->collection_stats = stats;
+    cond->topk_threshold = threshold;
+  }
+}
+
 Result<PlanInfo::Ptr> QueryPlanner::fts_scan(
     Segment::Ptr seg, QueryInfo::Ptr query_info,
     std::unique_ptr<arrow::compute::Expression> forward_filter,
@@ -65,6 +65,13 @@ class QueryPlanner {
       std::unique_ptr<arrow::compute::Expression> forward_filter,
       bool single_stage_search);
 
+  // Attach collection-wide BM25 statistics (and, if \p share_threshold, one
+  // shared top-k threshold) to the FTS condition of every segment query.
+  static void share_fts_stats(
+      const std::vector<Segment::Ptr> &segments,
+      const std::vector<sqlengine::QueryInfo::Ptr> &query_infos,
+      bool share_threshold);
+
   static DocFilter::Ptr build_doc_filter(
       const Segment::Ptr &seg, const QueryInfo::Ptr &query_info,
       std::unique_ptr<arrow::compute::Expression> &forward_filter,
@@ -269,7 +269,13 @@ Result<FtsCondInfo::Ptr> SQLEngineImpl::parse_fts_query(
   fts::simplify(ast);
   LOG_DEBUG("FTS AST after rewrite : %s", ast ? ast->text().c_str() : "<null>");
 
-  return std::make_shared<FtsCondInfo>(field_name, std::move(ast));
+  auto fts_cond = std::make_shared<FtsCondInfo>(field_name, std::move(ast));
+  if (fts_query_param) {
+    fts_cond->anytime = fts_query_param->anytime();
+    fts_cond->anytime_budget =
+        std::chrono::microseconds(fts_query_param->anytime_budget_us());
+  }
+  return fts_cond;
 }
 
 Result<QueryInfo::Ptr> SQLEngineImpl::parse_sql_info(
@@ -456,14 +462,14 @@ Status fill_doc_field(const std::shared_ptr<arrow::Array> &chunk,
                                      field_schema.dimension(), doc_it);
 
     case DataType::VECTOR_BINARY32:
-      return fill_doc_vector<uint32_t>(
-          (arrow::BinaryArray *)chunk.get(), field_schema.name(),
-          field_schema.dimension() / sizeof(uint32_t), doc_it);
+      return fill_doc_vector<uint32_t>((arrow::BinaryArray *)chunk.get(),
+                                       field_schema.name(),
+                                       field_schema.dimension(), doc_it);
 
     case DataType::VECTOR_BINARY64:
-      return fill_doc_vector<uint64_t>(
-          (arrow::BinaryArray *)chunk.get(), field_schema.name(),
-          field_schema.dimension() / sizeof(uint64_t), doc_it);
+      return fill_doc_vector<uint64_t>((arrow::BinaryArray *)chunk.get(),
+                                       field_schema.name(),
+                                       field_schema.dimension(), doc_it);
 
     case DataType::SPARSE_VECTOR_FP32:
       return fill_doc_sparse_vector<float>((arrow::StructArray *)chunk.get(),
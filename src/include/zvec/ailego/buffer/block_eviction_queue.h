@@ -142,6 +142,10 @@ class MemoryLimitPool {
 
   bool is_full();
 
+  size_t pool_size() const {
+    return pool_size_;
+  }
+
  private:
   MemoryLimitPool() = default;
 
@@ -896,6 +896,7 @@ typedef uint32_t zvec_metric_type_t;
 #define ZVEC_METRIC_TYPE_IP 2
 #define ZVEC_METRIC_TYPE_COSINE 3
 #define ZVEC_METRIC_TYPE_MIPSL2 4
+#define ZVEC_METRIC_TYPE_HAMMING 5
 
 /**
  * @brief Quantization type codes (must match zvec::QuantizeType in
@@ -1251,6 +1252,12 @@ ZVEC_EXPORT zvec_error_code_t ZVEC_CALL zvec_index_params_set_invert_params(
  *   stemmer:
  *     - "stemmer_lang" (Snowball language/algorithm; default "english"),
  *       for example {"stemmer_lang":"porter"} for ES behaviour.
+ * Index:
+ *   - "phrase_shingles" (array of two-word strings, e.g. ["new york"];
+ *     default []). Each pair is also indexed as one term, so exact phrases
+ *     containing it skip most position checks.
+ *   - "impact_ordered" (bool, default false). Sealed segments also store
+ *     postings ordered by BM25 impact, used by anytime FTS queries.
  * @return ZVEC_OK on success, error code on failure
  */
 ZVEC_EXPORT zvec_error_code_t ZVEC_CALL zvec_index_params_set_fts_params(
@@ -1846,6 +1853,43 @@ zvec_query_params_fts_set_default_operator(zvec_fts_query_params_t *params,
 ZVEC_EXPORT const char *ZVEC_CALL zvec_query_params_fts_get_default_operator(
     const zvec_fts_query_params_t *params);
 
+/**
+ * @brief Set whether to use anytime ranking: OR-of-terms queries on fields
+ * indexed with impact-ordered postings rank score-at-a-time and may stop
+ * early, returning an approximate top-k
+ * @param params FTS query parameters pointer
+ * @param anytime Whether to use anytime ranking
+ * @return zvec_error_code_t Error code
+ */
+ZVEC_EXPORT zvec_error_code_t ZVEC_CALL zvec_query_params_fts_set_anytime(
+    zvec_fts_query_params_t *params, bool anytime);
+
+/**
+ * @brief Get whether to use anytime ranking
+ * @param params FTS query parameters pointer
+ * @return bool Whether to use anytime ranking
+ */
+ZVEC_EXPORT bool ZVEC_CALL
+zvec_query_params_fts_get_anytime(const zvec_fts_query_params_t *params);
+
+/**
+ * @brief Set the per-segment time budget of anytime ranking
+ * @param params FTS query parameters pointer
+ * @param budget_us Time budget in microseconds; 0 means no limit
+ * @return zvec_error_code_t Error code
+ */
+ZVEC_EXPORT zvec_error_code_t ZVEC_CALL
+zvec_query_params_fts_set_anytime_budget_us(zvec_fts_query_params_t *params,
+                                            uint32_t budget_us);
+
+/**
+ * @brief Get the per-segment time budget of anytime ranking
+ * @param params FTS query parameters pointer
+ * @return uint32_t Time budget in microseconds
+ */
+ZVEC_EXPORT uint32_t ZVEC_CALL zvec_query_params_fts_get_anytime_budget_us(
+    const zvec_fts_query_params_t *params);
+
 // -----------------------------------------------------------------------------
 // zvec_vamana_query_params_t (Vamana Query Parameters)
 // -----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <zvec/ailego/container/params.h>
 #include <zvec/ailego/math_batch/utils.h>
 #include <zvec/core/framework/index_error.h>
@@ -55,6 +56,14 @@ struct IndexMetric : public IndexModule {
   using MatrixBatchDistance = std::function<void(
       const void **m, const void *q, size_t num, size_t dim, float *out)>;
 
+  //! How a metric measures raw dense vectors, for algorithms that estimate
+  //! it from per-subspace partial sums (e.g. PQ lookup tables)
+  enum class Measure {
+    kUnknown = 0,           // not a sum over dimensions
+    kSquaredEuclidean = 1,  // sum of squared differences
+    kInnerProduct = 2,      // minus the sum of products
+  };
+
   //! Destructor
   ~IndexMetric(void) override {}
 
@@ -124,6 +133,11 @@ struct IndexMetric : public IndexModule {
     return false;
   }
 
+  //! Retrieve how the metric measures raw vectors
+  virtual Measure measure(void) const {
+    return Measure::kUnknown;
+  }
+
   //! Compute the distance between feature and query
   float distance(const void *m, const void *q, size_t dim) const {
     float dist;
@@ -138,6 +152,14 @@ struct IndexMetric : public IndexModule {
     return nullptr;
   }
 
+  //! Sparse Query Preprocess Function, rewriting the query into the buffer
+  typedef void (*SparseQueryPreprocessFunc)(const void *q_sparse_data,
+                                            std::string &buffer);
+
+  virtual SparseQueryPreprocessFunc get_sparse_query_preprocess_func() const {
+    return nullptr;
+  }
+
   //! Distance offset applied during graph build to make the internal distance
   //! non-negative for ratio-based pruning (e.g. Vamana RobustPrune's
   //! occlude_factor = d(q,c) / d(p,c)). Metrics whose internal distance is a
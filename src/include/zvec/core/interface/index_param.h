@@ -83,7 +83,8 @@ enum class MetricType {
   kL2sq,  // Euclidean
   kInnerProduct,
   kCosine,
-  kMIPSL2sq  // spherical?
+  kMIPSL2sq,  // spherical?
+  kHamming    // binary vectors only
 };
 
 enum class QuantizerType {
@@ -361,6 +362,10 @@ struct ZVEC_CORE_API FlatIndexParam : public BaseIndexParam {
   FlatIndexParam() : BaseIndexParam(IndexType::kFlat) {}
 
   IndexMeta::MajorOrder major_order = IndexMeta::MajorOrder::MO_ROW;
+  // sparse vectors only: search posting lists instead of scanning vectors
+  bool use_inverted = false;
+  // upper bounds of the inverted search are scaled by it, 1.0 is exact
+  float heap_factor = 1.0f;
 
  protected:
   bool DeserializeFromJsonObject(const ailego::JsonObject &json_obj) override;
@@ -375,6 +380,8 @@ struct ZVEC_CORE_API IVFIndexParam : public BaseIndexParam {
   std::shared_ptr<BaseIndexParam> l1Index = nullptr;
   std::shared_ptr<BaseIndexParam> l2Index = nullptr;
   bool use_soar = false;
+  // scan inverted lists by 4-bit PQ codes, then rerank the shortlist
+  bool use_fastscan = false;
 
   // Constructors with delegation
   IVFIndexParam();
@@ -119,6 +119,14 @@ class FlatIndexParamBuilder
     : public BaseIndexParamBuilder<FlatIndexParamBuilder, FlatIndexParam> {
  public:
   FlatIndexParamBuilder() = default;
+  FlatIndexParamBuilder &with_use_inverted(bool use_inverted) {
+    param->use_inverted = use_inverted;
+    return *this;
+  }
+  FlatIndexParamBuilder &with_heap_factor(float heap_factor) {
+    param->heap_factor = heap_factor;
+    return *this;
+  }
   std::shared_ptr<FlatIndexParam> build() override {
     return param;
   }
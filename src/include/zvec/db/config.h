@@ -100,6 +100,9 @@ class ZVEC_API GlobalConfig : public ailego::Singleton<GlobalConfig> {
     // Independent from brute_force_by_keys_ratio: per-candidate FTS cost
     // (phrase phase-2 IO, BM25) is higher, so a tighter default fits.
     float fts_brute_force_by_keys_ratio;
+    // Bytes of per-segment FTS results cached for repeated queries on
+    // sealed segments, charged to the memory limit; 0 disables the cache.
+    uint64_t fts_query_cache_bytes;
 
     // optimize
     uint32_t optimize_thread_count;
@@ -191,6 +194,11 @@ class ZVEC_API GlobalConfig : public ailego::Singleton<GlobalConfig> {
     return config_.fts_brute_force_by_keys_ratio;
   }
 
+  //! FTS query result cache size in bytes (0 disables it)
+  uint64_t fts_query_cache_bytes() const noexcept {
+    return config_.fts_query_cache_bytes;
+  }
+
   //! Optimize thread count
   uint32_t optimize_thread_count() const noexcept {
     return config_.optimize_thread_count;
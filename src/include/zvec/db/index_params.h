@@ -56,7 +56,7 @@ class ZVEC_API IndexParams {
     return type_ == IndexType::FLAT || type_ == IndexType::HNSW ||
            type_ == IndexType::HNSW_RABITQ || type_ == IndexType::IVF ||
            type_ == IndexType::IVF_RABITQ || type_ == IndexType::DISKANN ||
-           type_ == IndexType::VAMANA;
+           type_ == IndexType::VAMANA || type_ == IndexType::INVERTED_SPARSE;
   }
 
   IndexType type() const {
@@ -500,6 +500,56 @@ class ZVEC_API FlatIndexParams : public VectorIndexParams {
   }
 };
 
+/*
+ * Vector: Inverted sparse index params, sparse vectors under IP only
+ */
+class ZVEC_API InvertedSparseIndexParams : public VectorIndexParams {
+ public:
+  InvertedSparseIndexParams(MetricType metric_type = MetricType::IP,
+                            float heap_factor = 1.0f)
+      : VectorIndexParams(IndexType::INVERTED_SPARSE, metric_type),
+        heap_factor_(heap_factor) {}
+
+  using OPtr = std::shared_ptr<InvertedSparseIndexParams>;
+
+ public:
+  Ptr clone() const override {
+    return std::make_shared<InvertedSparseIndexParams>(metric_type_,
+                                                       heap_factor_);
+  }
+
+  std::string to_string() const override {
+    auto base_str = vector_index_params_to_string(
+        "InvertedSparseIndexParams", metric_type_, quantize_type_);
+    std::ostringstream oss;
+    oss << base_str << ",heap_factor:" << heap_factor_ << "}";
+    return oss.str();
+  }
+
+  bool operator==(const IndexParams &other) const override {
+    return type() == other.type() &&
+           metric_type() ==
+               static_cast<const InvertedSparseIndexParams &>(other)
+                   .metric_type() &&
+           heap_factor_ ==
+               static_cast<const InvertedSparseIndexParams &>(other)
+                   .heap_factor_;
+  }
+
+  void set_heap_factor(float heap_factor) {
+    heap_factor_ = heap_factor;
+  }
+  float heap_factor() const {
+    return heap_factor_;
+  }
+
+ protected:
+  // Upper bounds are scaled by it before they are compared with the top-k
+  // threshold; 1.0 keeps the search exact, smaller values skip more postings
+  // at some recall
+  float heap_factor_{1.0f};
+};
+
 // define default index params
 const FlatIndexParams DefaultVectorIndexParams(MetricType::IP);
 
@@ -837,6 +887,12 @@ class ZVEC_API VamanaIndexParams : public VectorIndexParams {
  *     stemmer:
  *       - "stemmer_lang" (Snowball language/algorithm; default "english"),
  *         for example {"stemmer_lang":"porter"} for ES behaviour.
+ *   Index:
+ *     - "phrase_shingles" (array of two-word strings, e.g. ["new york"];
+ *       default []). Each pair is also indexed as one term, so exact
+ *       phrases containing it skip most position checks.
+ *     - "impact_ordered" (bool, default false). Sealed segments also store
+ *       postings ordered by BM25 impact, used by anytime FTS queries.
  *
  * Not copyable.  Use shared_ptr<FtsIndexParams> for shared ownership.
  */
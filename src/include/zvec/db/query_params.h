@@ -313,10 +313,33 @@ class ZVEC_API FtsQueryParams : public QueryParams {
     default_operator_ = default_operator;
   }
 
+  bool anytime() const {
+    return anytime_;
+  }
+
+  void set_anytime(bool anytime) {
+    anytime_ = anytime;
+  }
+
+  uint32_t anytime_budget_us() const {
+    return anytime_budget_us_;
+  }
+
+  void set_anytime_budget_us(uint32_t budget_us) {
+    anytime_budget_us_ = budget_us;
+  }
+
  private:
   // Default boolean operator for adjacent bare terms.
   // Supported values (case-insensitive): "OR" (default), "AND".
   std::string default_operator_;
+  // Anytime ranking: OR-of-terms queries on fields indexed with
+  // "impact_ordered" rank score-at-a-time and may stop early, returning an
+  // approximate top-k.
+  bool anytime_{false};
+  // Time budget of anytime ranking per segment, in microseconds; 0 means
+  // no limit.
+  uint32_t anytime_budget_us_{0};
 };
 
 }  // namespace zvec
@@ -29,6 +29,7 @@ enum class IndexType : uint32_t {
   DISKANN = 5,
   VAMANA = 6,
   IVF_RABITQ = 7,
+  INVERTED_SPARSE = 8,
   INVERT = 10,
   FTS = 11,
 };
@@ -86,6 +87,7 @@ enum class MetricType : uint32_t {
   IP = 2,
   COSINE = 3,
   MIPSL2 = 4,
+  HAMMING = 5,
 };
 
 enum class Operator : uint32_t {
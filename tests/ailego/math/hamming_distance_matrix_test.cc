@@ -0,0 +1,112 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <vector>
+#include <ailego/math/distance.h>
+#include <ailego/utility/matrix_helper.h>
+#include <gtest/gtest.h>
+
+using namespace zvec;
+using namespace zvec::ailego;
+
+template <typename T>
+static float HammingReference(const T *lhs, const T *rhs, size_t words) {
+  size_t count = 0;
+  for (size_t i = 0; i < words; ++i) {
+    T diff = lhs[i] ^ rhs[i];
+    for (; diff; diff &= diff - 1) {
+      ++count;
+    }
+  }
+  return static_cast<float>(count);
+}
+
+template <typename T>
+static void TestHammingGeneral(void) {
+  const size_t bits = sizeof(T) << 3;
+  std::mt19937_64 gen((std::random_device())());
+
+  // Cover every tail length of the 128-byte vector blocks
+  for (size_t words = 1; words <= 2048 / bits + 3; ++words) {
+    std::vector<T> lhs(words), rhs(words);
+    for (size_t i = 0; i < words; ++i) {
+      lhs[i] = static_cast<T>(gen());
+      rhs[i] = static_cast<T>(gen());
+    }
+    EXPECT_FLOAT_EQ(HammingReference(lhs.data(), rhs.data(), words),
+                    Distance::Hamming(lhs.data(), rhs.data(), words * bits));
+    EXPECT_FLOAT_EQ(0.0f,
+                    Distance::Hamming(lhs.data(), lhs.data(), words * bits));
+
+    std::vector<T> inverse(words);
+    for (size_t i = 0; i < words; ++i) {
+      inverse[i] = static_cast<T>(~lhs[i]);
+    }
+    EXPECT_FLOAT_EQ(
+        static_cast<float>(words * bits),
+        Distance::Hamming(lhs.data(), inverse.data(), words * bits));
+  }
+}
+
+TEST(DistanceMatrix, Hamming_Binary32_General) {
+  TestHammingGeneral<uint32_t>();
+}
+
+TEST(DistanceMatrix, Hamming_Binary64_General) {
+  TestHammingGeneral<uint64_t>();
+}
+
+template <typename T, size_t M, size_t N>
+static void TestHammingMatrix(void) {
+  const size_t bits = sizeof(T) << 3;
+  std::mt19937_64 gen((std::random_device())());
+  const size_t words =
+      (std::uniform_int_distribution<size_t>(1, 32))(gen);
+
+  std::vector<T> matrix1(M * words), matrix2(M * words);
+  std::vector<T> query1(N * words), query2(N * words);
+  for (auto &v : matrix1) {
+    v = static_cast<T>(gen());
+  }
+  for (auto &v : query1) {
+    v = static_cast<T>(gen());
+  }
+  MatrixHelper::Transpose<T, M>(matrix1.data(), words, matrix2.data());
+  MatrixHelper::Transpose<T, N>(query1.data(), words, query2.data());
+
+  std::vector<float> results(M * N);
+  HammingDistanceMatrix<T, M, N>::Compute(matrix2.data(), query2.data(),
+                                          words * bits, results.data());
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = 0; j < M; ++j) {
+      EXPECT_FLOAT_EQ(HammingReference(&matrix1[j * words],
+                                       &query1[i * words], words),
+                      results[i * M + j]);
+    }
+  }
+}
+
+TEST(DistanceMatrix, Hamming_Binary32_Matrix) {
+  TestHammingMatrix<uint32_t, 2, 1>();
+  TestHammingMatrix<uint32_t, 4, 4>();
+  TestHammingMatrix<uint32_t, 16, 8>();
+  TestHammingMatrix<uint32_t, 32, 32>();
+}
+
+TEST(DistanceMatrix, Hamming_Binary64_Matrix) {
+  TestHammingMatrix<uint64_t, 2, 2>();
+  TestHammingMatrix<uint64_t, 8, 1>();
+  TestHammingMatrix<uint64_t, 32, 16>();
+}
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <functional>
 #include <random>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -1626,3 +1628,76 @@ TEST(DistanceMatrix, TestInnerProductSparseDimWithZero) {
 
   EXPECT_GE(0.00001, std::abs(result0 - result1));
 }
+
+TEST(DistanceMatrix, InnerProductSparseScatteredQuery) {
+  std::mt19937 gen((std::random_device())());
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+  // Sorted unique indices spread over the given number of segments
+  auto make_sparse = [&](uint32_t count, uint32_t segs,
+                         std::vector<uint32_t> *indices,
+                         std::vector<float> *values) {
+    std::uniform_int_distribution<uint32_t> index_dist(0, segs * 65536 - 1);
+    std::set<uint32_t> uniq;
+    if (count > 2) {
+      uniq.insert(0);
+      uniq.insert(65535);
+    }
+    while (uniq.size() < count) {
+      uniq.insert(index_dist(gen));
+    }
+    indices->assign(uniq.begin(), uniq.end());
+    values->clear();
+    for (size_t i = 0; i < indices->size(); ++i) {
+      values->push_back(float(dist(gen)));
+    }
+  };
+
+  const uint32_t counts[] = {1, 3, 7, 8, 16, 64, 300, 2000};
+  for (uint32_t q_count : counts) {
+    for (uint32_t segs : {1u, 3u}) {
+      std::vector<uint32_t> q_indices;
+      std::vector<float> q_values;
+      make_sparse(q_count, segs, &q_indices, &q_values);
+
+      std::string query;
+      MinusInnerProductSparseMatrix<float>::transform_sparse_format(
+          q_indices.size(), q_indices.data(), q_values.data(), query);
+      std::string scattered;
+      MinusInnerProductSparseMatrix<float>::transform_sparse_query(
+          query.data(), scattered);
+
+      for (uint32_t m_count : counts) {
+        std::vector<uint32_t> m_indices;
+        std::vector<float> m_values;
+        make_sparse(m_count, segs, &m_indices, &m_values);
+        // Share a part of the query terms to get non trivial products
+        for (size_t i = 0; i < m_indices.size() && i < q_indices.size();
+             i += 2) {
+          m_indices[i] = q_indices[i];
+        }
+        std::sort(m_indices.begin(), m_indices.end());
+        m_indices.erase(std::unique(m_indices.begin(), m_indices.end()),
+                        m_indices.end());
+        m_values.resize(m_indices.size());
+
+        std::string doc;
+        MinusInnerProductSparseMatrix<float>::transform_sparse_format(
+            m_indices.size(), m_indices.data(), m_values.data(), doc);
+
+        float expected = 0.0f;
+        MinusInnerProductSparseMatrix<float>::Compute(
+            doc.data(), query.data(), &expected);
+        float result = 0.0f;
+        MinusInnerProductSparseMatrix<float>::ComputeQuery(
+            doc.data(), scattered.data(), &result);
+        EXPECT_NEAR(expected, result, 1e-3f * (1.0f + std::abs(expected)));
+
+        // A plain query is accepted as well
+        MinusInnerProductSparseMatrix<float>::ComputeQuery(
+            doc.data(), query.data(), &result);
+        EXPECT_NEAR(expected, result, 1e-3f * (1.0f + std::abs(expected)));
+      }
+    }
+  }
+}
@@ -4609,6 +4609,20 @@ void test_fts_query_params_functions(void) {
   err = zvec_query_params_fts_set_default_operator(NULL, "AND");
   TEST_ASSERT(err == ZVEC_ERROR_INVALID_ARGUMENT);
 
+  // Anytime ranking is off, without a budget, by default.
+  TEST_ASSERT(!zvec_query_params_fts_get_anytime(p1));
+  TEST_ASSERT(zvec_query_params_fts_get_anytime_budget_us(p1) == 0);
+  err = zvec_query_params_fts_set_anytime(p1, true);
+  TEST_ASSERT(err == ZVEC_OK);
+  TEST_ASSERT(zvec_query_params_fts_get_anytime(p1));
+  err = zvec_query_params_fts_set_anytime_budget_us(p1, 500);
+  TEST_ASSERT(err == ZVEC_OK);
+  TEST_ASSERT(zvec_query_params_fts_get_anytime_budget_us(p1) == 500);
+  err = zvec_query_params_fts_set_anytime(NULL, true);
+  TEST_ASSERT(err == ZVEC_ERROR_INVALID_ARGUMENT);
+  err = zvec_query_params_fts_set_anytime_budget_us(NULL, 500);
+  TEST_ASSERT(err == ZVEC_ERROR_INVALID_ARGUMENT);
+
   zvec_query_params_fts_destroy(p1);
   TEST_END();
 }
@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <atomic>
 #include <cstring>
+#include <random>
 #include <set>
 #include <thread>
 #include <unordered_set>
@@ -26,6 +27,7 @@
 #include <gtest/gtest.h>
 #include <zvec/ailego/container/vector.h>
 #include <zvec/core/framework/index_framework.h>
+#include "diskann_builder.h"
 #include "diskann_holder.h"
 #include "diskann_params.h"
 
@@ -1028,3 +1030,664 @@ TEST_F(DiskAnnSearcherTest, TestRnnSearch) {
   ASSERT_EQ(topk, results.size());
   ASSERT_LT(radius, results[topk - 1].score());
 }
+
+TEST_F(DiskAnnSearcherTest, TestShardedBuild) {
+  IndexBuilder::Pointer builder = IndexFactory::CreateBuilder("DiskAnnBuilder");
+  ASSERT_NE(builder, nullptr);
+
+  auto holder =
+      make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  size_t doc_cnt = 10000UL;
+  for (size_t i = 0; i < doc_cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = i;
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+  }
+
+  Params params;
+  params.set(PARAM_DISKANN_BUILDER_MAX_DEGREE, 32);
+  params.set(PARAM_DISKANN_BUILDER_LIST_SIZE, 100);
+  params.set(PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM, 32);
+  params.set(PARAM_DISKANN_BUILDER_THREAD_COUNT, 4);
+  params.set(PARAM_DISKANN_BUILDER_SHARD_COUNT, 4);
+
+  ASSERT_EQ(0, builder->init(*_index_meta_ptr, params));
+  ASSERT_EQ(0, builder->train(holder));
+  ASSERT_EQ(0, builder->build(holder));
+
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  string path = _dir + "/TestShardedBuild";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+  ASSERT_EQ(doc_cnt, builder->stats().built_count());
+
+  IndexSearcher::Pointer searcher =
+      IndexFactory::CreateSearcher("DiskAnnSearcher");
+  ASSERT_TRUE(searcher != nullptr);
+  Params search_params;
+  search_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 300);
+  ASSERT_EQ(0, searcher->init(search_params));
+
+  auto storage = IndexFactory::CreateStorage("FileReadStorage");
+  ASSERT_EQ(0, storage->open(path, false));
+  ASSERT_EQ(0, searcher->load(storage, IndexMetric::Pointer()));
+
+  auto knnCtx = searcher->create_context();
+  auto linearCtx = searcher->create_context();
+  ASSERT_TRUE(!!knnCtx);
+  ASSERT_TRUE(!!linearCtx);
+
+  NumericalVector<float> vec(dim);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  size_t topk = 50;
+  knnCtx->set_topk(topk);
+  linearCtx->set_topk(topk);
+
+  // Queries spread over every shard and their boundaries
+  size_t totalHits = 0;
+  size_t totalCnts = 0;
+  size_t topk1Hits = 0;
+  for (size_t i = 0; i < doc_cnt; i += 97) {
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = i + 0.1f;
+    }
+    ASSERT_EQ(0, searcher->search_impl(vec.data(), qmeta, knnCtx));
+    ASSERT_EQ(0, searcher->search_bf_impl(vec.data(), qmeta, linearCtx));
+
+    auto &knnResult = knnCtx->result();
+    auto &linearResult = linearCtx->result();
+    ASSERT_EQ(topk, linearResult.size());
+    ASSERT_FALSE(knnResult.empty());
+    topk1Hits += i == knnResult[0].key();
+
+    std::set<uint64_t> truth;
+    for (size_t k = 0; k < topk; ++k) {
+      truth.insert(linearResult[k].key());
+    }
+    for (size_t k = 0; k < knnResult.size(); ++k) {
+      totalHits += truth.count(knnResult[k].key());
+    }
+    totalCnts += topk;
+  }
+
+  EXPECT_GT(totalHits * 1.0f / totalCnts, 0.90f);
+  EXPECT_GT(topk1Hits * 97.0f / doc_cnt, 0.90f);
+}
+
+TEST_F(DiskAnnSearcherTest, TestStreamerAddRemove) {
+  IndexBuilder::Pointer builder = IndexFactory::CreateBuilder("DiskAnnBuilder");
+  ASSERT_NE(builder, nullptr);
+
+  auto holder =
+      make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  size_t doc_cnt = 2000UL;
+  for (size_t i = 0; i < doc_cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = i;
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+  }
+
+  Params params;
+  params.set(PARAM_DISKANN_BUILDER_MAX_DEGREE, 32);
+  params.set(PARAM_DISKANN_BUILDER_LIST_SIZE, 100);
+  params.set(PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM, 32);
+  params.set(PARAM_DISKANN_BUILDER_THREAD_COUNT, 4);
+  ASSERT_EQ(0, builder->init(*_index_meta_ptr, params));
+  ASSERT_EQ(0, builder->train(holder));
+  ASSERT_EQ(0, builder->build(holder));
+
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  string path = _dir + "/TestStreamerAddRemove";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("DiskAnnStreamer");
+  ASSERT_NE(streamer, nullptr);
+  Params search_params;
+  search_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 200);
+  search_params.set(PARAM_DISKANN_STREAMER_DELTA_MAX_DEGREE, 16);
+  // Keep optimize on the delta graph, the rebuild is covered below
+  search_params.set(PARAM_DISKANN_STREAMER_CONSOLIDATE_RATIO, 1.0f);
+  ASSERT_EQ(0, streamer->init(*_index_meta_ptr, search_params));
+  auto storage = IndexFactory::CreateStorage("FileReadStorage");
+  ASSERT_EQ(0, storage->open(path, false));
+  ASSERT_EQ(0, streamer->open(storage));
+
+  auto ctx = streamer->create_context();
+  ASSERT_NE(ctx, nullptr);
+  size_t topk = 10;
+  ctx->set_topk(topk);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  NumericalVector<float> vec(dim);
+  auto fill = [&](float val) {
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = val;
+    }
+  };
+
+  // Streamed vectors sit between the on-disk ones
+  const uint64_t base_key = 100000UL;
+  for (size_t i = 0; i < doc_cnt; i += 2) {
+    fill(i + 0.5f);
+    ASSERT_EQ(0, streamer->add_impl(base_key + i, vec.data(), qmeta, ctx));
+  }
+  fill(1.0f);
+  EXPECT_EQ(IndexError_Duplicate,
+            streamer->add_impl(1, vec.data(), qmeta, ctx));
+
+  // Tombstone every tenth on-disk vector and a few streamed ones
+  for (size_t i = 0; i < doc_cnt; i += 10) {
+    ASSERT_EQ(0, streamer->remove(i, ctx));
+  }
+  EXPECT_EQ(IndexError_NoExist, streamer->remove(0, ctx));
+  for (size_t i = 0; i < doc_cnt; i += 20) {
+    ASSERT_EQ(0, streamer->remove(base_key + i, ctx));
+  }
+
+  auto check = [&](void) {
+    size_t delta_hits = 0;
+    size_t delta_cnt = 0;
+    for (size_t i = 0; i < doc_cnt; i += 2) {
+      fill(i + 0.5f);
+      ASSERT_EQ(0, streamer->search_impl(vec.data(), qmeta, ctx));
+      auto &result = ctx->result();
+      ASSERT_EQ(topk, result.size());
+      for (auto &doc : result) {
+        uint64_t key = doc.key();
+        ASSERT_FALSE(key < doc_cnt && key % 10 == 0);
+        ASSERT_FALSE(key >= base_key && (key - base_key) % 20 == 0);
+      }
+      if (i % 20 != 0) {
+        delta_hits += result[0].key() == base_key + i;
+        ++delta_cnt;
+      }
+    }
+    EXPECT_GT(delta_hits * 1.0f / delta_cnt, 0.95f);
+  };
+  check();
+
+  std::string value;
+  EXPECT_EQ(IndexError_NoExist, streamer->get_vector(10, ctx, value));
+  ASSERT_EQ(0, streamer->get_vector(base_key + 2, ctx, value));
+  EXPECT_FLOAT_EQ(2.5f, reinterpret_cast<const float *>(value.data())[0]);
+
+  // Consolidation drops the streamed tombstones without losing neighbors
+  ASSERT_EQ(0, streamer->optimize(nullptr));
+  check();
+
+  // A deleted on-disk key may be inserted again
+  fill(10.0f);
+  ASSERT_EQ(0, streamer->add_impl(10, vec.data(), qmeta, ctx));
+  ASSERT_EQ(0, streamer->search_impl(vec.data(), qmeta, ctx));
+  EXPECT_EQ(10UL, ctx->result()[0].key());
+
+  auto provider = streamer->create_provider();
+  ASSERT_NE(provider, nullptr);
+  size_t expected = doc_cnt - doc_cnt / 10 + doc_cnt / 2 - doc_cnt / 20 + 1;
+  EXPECT_EQ(expected, provider->count());
+  size_t iterated = 0;
+  for (auto iter = provider->create_iterator(); iter->is_valid();
+       iter->next()) {
+    ++iterated;
+  }
+  EXPECT_EQ(expected, iterated);
+}
+
+TEST_F(DiskAnnSearcherTest, TestStreamerPersistAndRebuild) {
+  IndexBuilder::Pointer builder = IndexFactory::CreateBuilder("DiskAnnBuilder");
+  ASSERT_NE(builder, nullptr);
+
+  auto holder =
+      make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  size_t doc_cnt = 2000UL;
+  uint32_t label_cnt = 4;
+  std::unordered_map<uint64_t, uint32_t> labels;
+  for (size_t i = 0; i < doc_cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = i;
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+    labels[i] = i % label_cnt;
+  }
+
+  Params params;
+  params.set(PARAM_DISKANN_BUILDER_MAX_DEGREE, 32);
+  params.set(PARAM_DISKANN_BUILDER_LIST_SIZE, 100);
+  params.set(PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM, 32);
+  params.set(PARAM_DISKANN_BUILDER_THREAD_COUNT, 4);
+  ASSERT_EQ(0, builder->init(*_index_meta_ptr, params));
+  ASSERT_EQ(0, dynamic_cast<DiskAnnBuilder *>(builder.get())->set_labels(
+                   labels));
+  ASSERT_EQ(0, builder->train(holder));
+  ASSERT_EQ(0, builder->build(holder));
+
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  string path = _dir + "/TestStreamerPersistAndRebuild";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+
+  auto open_streamer = [&](void) {
+    IndexStreamer::Pointer streamer =
+        IndexFactory::CreateStreamer("DiskAnnStreamer");
+    Params search_params;
+    search_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 200);
+    EXPECT_EQ(0, streamer->init(*_index_meta_ptr, search_params));
+    auto storage = IndexFactory::CreateStorage("FileReadStorage");
+    EXPECT_EQ(0, storage->open(path, false));
+    EXPECT_EQ(0, streamer->open(storage));
+    return streamer;
+  };
+  auto label_context = [&](IndexStreamer::Pointer &streamer, uint32_t label) {
+    auto ctx = streamer->create_context();
+    Params label_params;
+    label_params.set(PARAM_DISKANN_SEARCHER_QUERY_LABEL, label);
+    EXPECT_EQ(0, ctx->update(label_params));
+    return ctx;
+  };
+
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  NumericalVector<float> vec(dim);
+  auto fill = [&](float val) {
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = val;
+    }
+  };
+
+  // Streamed vectors take the label of the context adding them
+  auto streamer = open_streamer();
+  const uint64_t base_key = 100000UL;
+  for (size_t i = 0; i < doc_cnt; i += 2) {
+    auto ctx = label_context(streamer, i % label_cnt);
+    fill(i + 0.5f);
+    ASSERT_EQ(0, streamer->add_impl(base_key + i, vec.data(), qmeta, ctx));
+  }
+  auto ctx = streamer->create_context();
+  for (size_t i = 0; i < doc_cnt; i += 10) {
+    ASSERT_EQ(0, streamer->remove(i, ctx));
+  }
+  for (size_t i = 0; i < doc_cnt; i += 20) {
+    ASSERT_EQ(0, streamer->remove(base_key + i, ctx));
+  }
+  size_t expected = doc_cnt - doc_cnt / 10 + doc_cnt / 2 - doc_cnt / 20;
+
+  // Labeled searches return the streamed vectors of their label only
+  size_t topk = 10;
+  auto check = [&](IndexStreamer::Pointer &streamer) {
+    size_t delta_hits = 0;
+    size_t delta_cnt = 0;
+    for (size_t i = 2; i < doc_cnt; i += 4) {
+      uint32_t label = i % label_cnt;
+      auto label_ctx = label_context(streamer, label);
+      label_ctx->set_topk(topk);
+      fill(i + 0.5f);
+      ASSERT_EQ(0, streamer->search_impl(vec.data(), qmeta, label_ctx));
+      auto &result = label_ctx->result();
+      ASSERT_EQ(topk, result.size());
+      for (auto &doc : result) {
+        uint64_t key = doc.key() >= base_key ? doc.key() - base_key : doc.key();
+        ASSERT_EQ(label, key % label_cnt);
+        ASSERT_FALSE(doc.key() < doc_cnt && key % 10 == 0);
+        ASSERT_FALSE(doc.key() >= base_key && key % 20 == 0);
+      }
+      delta_hits += result[0].key() == base_key + i;
+      ++delta_cnt;
+    }
+    EXPECT_GT(delta_hits * 1.0f / delta_cnt, 0.95f);
+
+    std::string value;
+    auto fetch_ctx = streamer->create_context();
+    EXPECT_EQ(IndexError_NoExist, streamer->get_vector(10, fetch_ctx, value));
+    EXPECT_EQ(IndexError_NoExist,
+              streamer->get_vector(base_key + 20, fetch_ctx, value));
+    ASSERT_EQ(0, streamer->get_vector(base_key + 2, fetch_ctx, value));
+    EXPECT_FLOAT_EQ(2.5f, reinterpret_cast<const float *>(value.data())[0]);
+    EXPECT_EQ(expected, streamer->create_provider()->count());
+  };
+  check(streamer);
+
+  // The delta graph and the tombstones survive a restart
+  ASSERT_EQ(0, streamer->flush(0));
+  ASSERT_TRUE(File::IsExist(path + ".delta"));
+  ASSERT_EQ(0, streamer->close());
+  streamer = open_streamer();
+  check(streamer);
+
+  // Past the consolidate ratio optimize folds them into a new disk graph
+  ASSERT_EQ(0, streamer->optimize(nullptr));
+  EXPECT_FALSE(File::IsExist(path + ".delta"));
+  EXPECT_EQ(expected, streamer->stats().loaded_count());
+  check(streamer);
+  ASSERT_EQ(0, streamer->close());
+  EXPECT_FALSE(File::IsExist(path + ".delta"));
+
+  streamer = open_streamer();
+  EXPECT_EQ(expected, streamer->stats().loaded_count());
+  check(streamer);
+}
+
+TEST_F(DiskAnnSearcherTest, TestAdaptiveNodeCache) {
+  IndexBuilder::Pointer builder = IndexFactory::CreateBuilder("DiskAnnBuilder");
+  ASSERT_NE(builder, nullptr);
+
+  auto holder =
+      make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  size_t doc_cnt = 3000UL;
+  for (size_t i = 0; i < doc_cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = i;
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+  }
+
+  Params params;
+  params.set(PARAM_DISKANN_BUILDER_MAX_DEGREE, 32);
+  params.set(PARAM_DISKANN_BUILDER_LIST_SIZE, 100);
+  params.set(PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM, 32);
+  ASSERT_EQ(0, builder->init(*_index_meta_ptr, params));
+  ASSERT_EQ(0, builder->train(holder));
+  ASSERT_EQ(0, builder->build(holder));
+
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  string path = _dir + "/TestAdaptiveNodeCache";
+  string hot_set_path = _dir + "/TestAdaptiveNodeCache.hot";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+
+  auto open_searcher = [&](bool cached) {
+    IndexSearcher::Pointer searcher =
+        IndexFactory::CreateSearcher("DiskAnnSearcher");
+    Params search_params;
+    search_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 100);
+    if (cached) {
+      search_params.set(PARAM_DISKANN_SEARCHER_CACHE_MEMORY_SIZE,
+                        uint64_t{4 * 1024 * 1024});
+      search_params.set(PARAM_DISKANN_SEARCHER_CACHE_HOT_SET_PATH,
+                        hot_set_path);
+    }
+    EXPECT_EQ(0, searcher->init(search_params));
+    auto storage = IndexFactory::CreateStorage("FileReadStorage");
+    EXPECT_EQ(0, storage->open(path, false));
+    EXPECT_EQ(0, searcher->load(storage, IndexMetric::Pointer()));
+    return searcher;
+  };
+
+  // A skewed workload repeating a few hot queries
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  NumericalVector<float> vec(dim);
+  size_t topk = 10;
+  auto run = [&](IndexSearcher::Pointer &searcher, size_t rounds,
+                 std::vector<uint64_t> *keys) {
+    auto ctx = searcher->create_context();
+    ctx->set_topk(topk);
+    for (size_t r = 0; r < rounds; ++r) {
+      for (size_t q = 0; q < 20; ++q) {
+        for (size_t j = 0; j < dim; ++j) {
+          vec[j] = q * 7 + 0.3f;
+        }
+        EXPECT_EQ(0, searcher->search_impl(vec.data(), qmeta, ctx));
+        for (auto &doc : ctx->result()) {
+          keys->push_back(doc.key());
+        }
+      }
+    }
+    return dynamic_cast<DiskAnnContext *>(ctx.get())->query_stats();
+  };
+
+  auto plain = open_searcher(false);
+  std::vector<uint64_t> plain_keys;
+  auto plain_stats = run(plain, 5, &plain_keys);
+  EXPECT_EQ(0UL, plain_stats.node_cache_hits);
+
+  auto cached = open_searcher(true);
+  std::vector<uint64_t> cached_keys;
+  auto cached_stats = run(cached, 5, &cached_keys);
+  EXPECT_EQ(plain_keys, cached_keys);
+  EXPECT_GT(cached_stats.node_cache_hits, 0UL);
+  EXPECT_EQ(cached_stats.node_cache_hits, cached_stats.saved_ios);
+  EXPECT_LT(cached_stats.io_num, plain_stats.io_num);
+  ASSERT_EQ(0, cached->unload());
+
+  // The persisted hot set serves the very first round after a restart
+  auto warm = open_searcher(true);
+  std::vector<uint64_t> warm_keys;
+  auto warm_stats = run(warm, 1, &warm_keys);
+  plain_keys.resize(warm_keys.size());
+  EXPECT_EQ(plain_keys, warm_keys);
+  EXPECT_GT(warm_stats.node_cache_hits, warm_stats.io_num);
+}
+
+TEST_F(DiskAnnSearcherTest, TestLabeledSearch) {
+  IndexBuilder::Pointer builder = IndexFactory::CreateBuilder("DiskAnnBuilder");
+  ASSERT_NE(builder, nullptr);
+
+  // Eight tenants whose vectors are interleaved across the space
+  auto holder =
+      make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  size_t doc_cnt = 4000UL;
+  uint32_t label_cnt = 8;
+  std::mt19937 gen(15583);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::unordered_map<uint64_t, uint32_t> labels;
+  for (size_t i = 0; i < doc_cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = dist(gen);
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+    labels[i] = i % label_cnt;
+  }
+
+  Params params;
+  params.set(PARAM_DISKANN_BUILDER_MAX_DEGREE, 32);
+  params.set(PARAM_DISKANN_BUILDER_LIST_SIZE, 100);
+  params.set(PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM, 32);
+  params.set(PARAM_DISKANN_BUILDER_THREAD_COUNT, 4);
+  ASSERT_EQ(0, builder->init(*_index_meta_ptr, params));
+  auto *diskann_builder = dynamic_cast<DiskAnnBuilder *>(builder.get());
+  ASSERT_NE(diskann_builder, nullptr);
+  ASSERT_EQ(0, diskann_builder->set_labels(labels));
+  ASSERT_EQ(0, builder->train(holder));
+  ASSERT_EQ(0, builder->build(holder));
+
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  string path = _dir + "/TestLabeledSearch";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+
+  IndexSearcher::Pointer searcher =
+      IndexFactory::CreateSearcher("DiskAnnSearcher");
+  ASSERT_TRUE(searcher != nullptr);
+  Params search_params;
+  search_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 100);
+  ASSERT_EQ(0, searcher->init(search_params));
+  auto storage = IndexFactory::CreateStorage("FileReadStorage");
+  ASSERT_EQ(0, storage->open(path, false));
+  ASSERT_EQ(0, searcher->load(storage, IndexMetric::Pointer()));
+
+  auto knnCtx = searcher->create_context();
+  auto linearCtx = searcher->create_context();
+  auto filterCtx = searcher->create_context();
+  size_t topk = 10;
+  knnCtx->set_topk(topk);
+  linearCtx->set_topk(topk);
+  filterCtx->set_topk(topk);
+
+  // A filtered search keeps as many candidates of the label as the labeled
+  // one only with a list label_cnt times longer
+  Params filter_params;
+  filter_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 100 * label_cnt);
+  ASSERT_EQ(0, filterCtx->update(filter_params));
+
+  NumericalVector<float> vec(dim);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  size_t totalHits = 0;
+  size_t totalCnts = 0;
+  for (size_t q = 0; q < 64; ++q) {
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = dist(gen);
+    }
+    uint32_t label = q % label_cnt;
+    Params label_params;
+    label_params.set(PARAM_DISKANN_SEARCHER_QUERY_LABEL, label);
+    ASSERT_EQ(0, knnCtx->update(label_params));
+    ASSERT_EQ(0, linearCtx->update(label_params));
+    filterCtx->set_filter([label, label_cnt](uint64_t key) {
+      return key % label_cnt != label;
+    });
+
+    ASSERT_EQ(0, searcher->search_impl(vec.data(), qmeta, knnCtx));
+    ASSERT_EQ(0, searcher->search_bf_impl(vec.data(), qmeta, linearCtx));
+    ASSERT_EQ(0, searcher->search_impl(vec.data(), qmeta, filterCtx));
+
+    auto &knnResult = knnCtx->result();
+    auto &linearResult = linearCtx->result();
+    ASSERT_EQ(topk, knnResult.size());
+    ASSERT_EQ(topk, linearResult.size());
+    std::set<uint64_t> truth;
+    for (size_t k = 0; k < topk; ++k) {
+      EXPECT_EQ(label, knnResult[k].key() % label_cnt);
+      EXPECT_EQ(label, linearResult[k].key() % label_cnt);
+      truth.insert(linearResult[k].key());
+    }
+    for (size_t k = 0; k < topk; ++k) {
+      totalHits += truth.count(knnResult[k].key());
+    }
+    totalCnts += topk;
+  }
+  EXPECT_GT(totalHits * 1.0f / totalCnts, 0.90f);
+
+  // Walking the label subgraph reads and scores fewer nodes than filtering
+  // the results of an equally deep search
+  auto knnStats = dynamic_cast<DiskAnnContext *>(knnCtx.get())->query_stats();
+  auto filterStats =
+      dynamic_cast<DiskAnnContext *>(filterCtx.get())->query_stats();
+  EXPECT_LT(knnStats.io_num, filterStats.io_num);
+  EXPECT_LT(knnStats.dist_num, filterStats.dist_num);
+
+  // A label without vectors matches nothing
+  Params unknown_params;
+  unknown_params.set(PARAM_DISKANN_SEARCHER_QUERY_LABEL, label_cnt);
+  ASSERT_EQ(0, knnCtx->update(unknown_params));
+  ASSERT_EQ(0, searcher->search_impl(vec.data(), qmeta, knnCtx));
+  EXPECT_TRUE(knnCtx->result().empty());
+}
+
+TEST_F(DiskAnnSearcherTest, TestPipelinedSearch) {
+  IndexBuilder::Pointer builder = IndexFactory::CreateBuilder("DiskAnnBuilder");
+  ASSERT_NE(builder, nullptr);
+
+  auto holder =
+      make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  size_t doc_cnt = 3000UL;
+  std::mt19937 gen(20571);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  for (size_t i = 0; i < doc_cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = dist(gen);
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+  }
+
+  Params params;
+  params.set(PARAM_DISKANN_BUILDER_MAX_DEGREE, 32);
+  params.set(PARAM_DISKANN_BUILDER_LIST_SIZE, 100);
+  params.set(PARAM_DISKANN_BUILDER_MAX_PQ_CHUNK_NUM, 32);
+  ASSERT_EQ(0, builder->init(*_index_meta_ptr, params));
+  ASSERT_EQ(0, builder->train(holder));
+  ASSERT_EQ(0, builder->build(holder));
+
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  string path = _dir + "/TestPipelinedSearch";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+
+  IndexSearcher::Pointer searcher =
+      IndexFactory::CreateSearcher("DiskAnnSearcher");
+  ASSERT_TRUE(searcher != nullptr);
+  uint32_t beam_width = 4;
+  Params search_params;
+  search_params.set(PARAM_DISKANN_SEARCHER_LIST_SIZE, 100);
+  search_params.set(PARAM_DISKANN_SEARCHER_BEAM_WIDTH, beam_width);
+  ASSERT_EQ(0, searcher->init(search_params));
+  auto storage = IndexFactory::CreateStorage("FileReadStorage");
+  ASSERT_EQ(0, storage->open(path, false));
+  ASSERT_EQ(0, searcher->load(storage, IndexMetric::Pointer()));
+
+  auto knnCtx = searcher->create_context();
+  auto linearCtx = searcher->create_context();
+  size_t topk = 10;
+  knnCtx->set_topk(topk);
+  linearCtx->set_topk(topk);
+  auto *diskann_ctx = dynamic_cast<DiskAnnContext *>(knnCtx.get());
+  ASSERT_NE(diskann_ctx, nullptr);
+
+  NumericalVector<float> vec(dim);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  size_t totalHits = 0;
+  size_t totalCnts = 0;
+  uint64_t totalIos = 0;
+  for (size_t q = 0; q < 32; ++q) {
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = dist(gen);
+    }
+    ASSERT_EQ(0, searcher->search_impl(vec.data(), qmeta, knnCtx));
+    ASSERT_EQ(0, searcher->search_bf_impl(vec.data(), qmeta, linearCtx));
+
+    // Every search reports its own reads and the beam width it settled on
+    auto &stats = diskann_ctx->last_query_stats();
+    EXPECT_GT(stats.io_num, 0UL);
+    EXPECT_GE(stats.io_us, stats.io_wait_us);
+    EXPECT_GE(stats.beam_width, 1u);
+    EXPECT_LE(stats.beam_width, 4 * beam_width);
+    EXPECT_GE(stats.max_inflight_ios, 1UL);
+    EXPECT_LE(stats.max_inflight_ios, 4UL * beam_width);
+    totalIos += stats.io_num;
+
+    auto &knnResult = knnCtx->result();
+    auto &linearResult = linearCtx->result();
+    ASSERT_EQ(topk, knnResult.size());
+    ASSERT_EQ(topk, linearResult.size());
+    std::set<uint64_t> truth;
+    for (size_t k = 0; k < topk; ++k) {
+      truth.insert(linearResult[k].key());
+    }
+    for (size_t k = 0; k < topk; ++k) {
+      totalHits += truth.count(knnResult[k].key());
+    }
+    totalCnts += topk;
+  }
+  EXPECT_GT(totalHits * 1.0f / totalCnts, 0.90f);
+  EXPECT_EQ(totalIos, diskann_ctx->query_stats().io_num);
+
+  // A beam without reads in flight is rejected on load
+  IndexSearcher::Pointer invalid_searcher =
+      IndexFactory::CreateSearcher("DiskAnnSearcher");
+  ASSERT_TRUE(invalid_searcher != nullptr);
+  Params invalid_params;
+  invalid_params.set(PARAM_DISKANN_SEARCHER_BEAM_WIDTH, 0);
+  ASSERT_EQ(0, invalid_searcher->init(invalid_params));
+  auto invalid_storage = IndexFactory::CreateStorage("FileReadStorage");
+  ASSERT_EQ(0, invalid_storage->open(path, false));
+  EXPECT_EQ(IndexError_InvalidArgument,
+            invalid_searcher->load(invalid_storage, IndexMetric::Pointer()));
+}
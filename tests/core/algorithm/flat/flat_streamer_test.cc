@@ -1303,6 +1303,48 @@ TEST_F(FlatStreamerTest, TestInt8WithRotate) {
   EXPECT_EQ(kTopk, linearCtx->result().size());
 }
 
+TEST_F(FlatStreamerTest, TestHammingBinary32) {
+  constexpr size_t kBits = 96;
+  constexpr size_t kWords = kBits / 32;
+  IndexMeta meta(IndexMeta::DataType::DT_BINARY32, kBits);
+  meta.set_metric("Hamming", 0, Params());
+
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("FlatStreamer");
+  ASSERT_TRUE(streamer != nullptr);
+  Params params;
+  Params stg_params;
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  ASSERT_EQ(0, storage->init(stg_params));
+  ASSERT_EQ(0, storage->open(dir_ + "TestHammingBinary32.index", true));
+  ASSERT_EQ(0, streamer->init(meta, params));
+  ASSERT_EQ(0, streamer->open(storage));
+
+  // Vector i differs from the all-zero query in exactly i % 97 bits
+  const size_t cnt = 1000U;
+  IndexQueryMeta qmeta(IndexMeta::DT_BINARY32, kBits);
+  auto ctx = streamer->create_context();
+  ASSERT_TRUE(!!ctx);
+  for (size_t i = 0; i < cnt; i++) {
+    std::vector<uint32_t> vec(kWords, 0u);
+    for (size_t b = 0; b < i % 97; ++b) {
+      vec[b / 32] |= 1u << (b % 32);
+    }
+    ASSERT_EQ(0, streamer->add_impl(i, vec.data(), qmeta, ctx));
+  }
+
+  std::vector<uint32_t> query(kWords, 0u);
+  ctx->set_topk(20);
+  ASSERT_EQ(0, streamer->search_impl(query.data(), qmeta, ctx));
+  auto &results = ctx->result();
+  ASSERT_EQ(20U, results.size());
+  for (size_t k = 0; k < results.size(); ++k) {
+    EXPECT_FLOAT_EQ(static_cast<float>(results[k].key() % 97),
+                    results[k].score());
+    EXPECT_FLOAT_EQ(static_cast<float>(k / 11), results[k].score());
+  }
+}
+
 #if defined(__GNUC__) || defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
\ No newline at end of file
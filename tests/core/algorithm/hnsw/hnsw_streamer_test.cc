@@ -25,6 +25,7 @@
 #include <future>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <set>
 #include <gtest/gtest.h>
 #include <zvec/ailego/container/vector.h>
@@ -2408,6 +2409,52 @@ TEST_F(HnswStreamerTest, TestMipsEuclideanMetric) {
   EXPECT_NEAR((uint64_t)(2 * COUNT - 1), results[0].key(), 10);
 }
 
+TEST_F(HnswStreamerTest, TestHammingMetric) {
+  constexpr size_t static bits = 256;
+  constexpr size_t static words = bits / 64;
+  IndexMeta meta(IndexMeta::DataType::DT_BINARY64, bits);
+  meta.set_metric("Hamming", 0, ailego::Params());
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  ASSERT_NE(nullptr, storage);
+  ailego::Params stg_params;
+  ASSERT_EQ(0, storage->init(stg_params));
+  ASSERT_EQ(0, storage->open(dir_ + "TestHammingMetric", true));
+
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("HnswStreamer");
+  ASSERT_TRUE(streamer != nullptr);
+  ailego::Params params;
+  ASSERT_EQ(0, streamer->init(meta, params));
+  ASSERT_EQ(0, streamer->open(storage));
+
+  const size_t COUNT = 2000;
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_BINARY64, bits);
+  std::mt19937_64 gen(11);
+  std::vector<std::vector<uint64_t>> vecs(COUNT, std::vector<uint64_t>(words));
+  auto ctx = streamer->create_context();
+  for (size_t i = 0; i < COUNT; i++) {
+    for (auto &w : vecs[i]) {
+      w = gen();
+    }
+    ASSERT_EQ(0, streamer->add_impl(i, vecs[i].data(), qmeta, ctx));
+  }
+
+  ctx->set_topk(10);
+  for (size_t i = 0; i < COUNT; i += 97) {
+    // a query a few bits away from vector i still finds it first
+    std::vector<uint64_t> query = vecs[i];
+    query[0] ^= 0x7;
+    ASSERT_EQ(0, streamer->search_impl(query.data(), qmeta, ctx));
+    const auto &results = ctx->result();
+    ASSERT_EQ(10u, results.size());
+    EXPECT_EQ(i, results[0].key());
+    EXPECT_FLOAT_EQ(3.0f, results[0].score());
+    for (size_t k = 1; k < results.size(); ++k) {
+      EXPECT_LE(results[k - 1].score(), results[k].score());
+    }
+  }
+}
+
 TEST_F(HnswStreamerTest, TestBruteForceSetupInContext) {
   IndexStreamer::Pointer streamer =
       IndexFactory::CreateStreamer("HnswStreamer");
@@ -4224,6 +4271,261 @@ TEST_F(HnswStreamerTest, TestContiguousMultiThreadSearch) {
   s3.wait();
 }
 
+TEST_F(HnswStreamerTest, TestContiguousLayouts) {
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  ASSERT_NE(nullptr, storage);
+  ailego::Params stg_params;
+  ASSERT_EQ(0, storage->init(stg_params));
+  ASSERT_EQ(0, storage->open(dir_ + "TestContiguousLayouts.index", true));
+
+  size_t cnt = 3000UL;
+  std::mt19937 gen(15583);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<NumericalVector<float>> data(cnt, NumericalVector<float>(dim));
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < dim; ++j) {
+      data[i][j] = dist(gen);
+    }
+  }
+
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  {
+    auto builder = IndexFactory::CreateStreamer("HnswStreamer");
+    ASSERT_NE(nullptr, builder);
+    ailego::Params build_params;
+    build_params.set(PARAM_HNSW_STREAMER_MAX_NEIGHBOR_COUNT, 16U);
+    build_params.set(PARAM_HNSW_STREAMER_EFCONSTRUCTION, 64U);
+    build_params.set(PARAM_HNSW_STREAMER_BRUTE_FORCE_THRESHOLD, 1000U);
+    ASSERT_EQ(0, builder->init(*index_meta_ptr_, build_params));
+    ASSERT_EQ(0, builder->open(storage));
+    auto ctx = builder->create_context();
+    ASSERT_TRUE(!!ctx);
+    for (size_t i = 0; i < cnt; i++) {
+      ASSERT_EQ(0, builder->add_impl(i, data[i].data(), qmeta, ctx));
+    }
+    ASSERT_EQ(0, builder->flush(0UL));
+    ASSERT_EQ(0, builder->close());
+  }
+
+  // Invalid layout is rejected
+  {
+    auto searcher = IndexFactory::CreateStreamer("HnswStreamer");
+    ailego::Params params;
+    params.set(PARAM_HNSW_STREAMER_USE_CONTIGUOUS_MEMORY, true);
+    params.set(PARAM_HNSW_STREAMER_CONTIGUOUS_LAYOUT, 3U);
+    ASSERT_NE(0, searcher->init(*index_meta_ptr_, params));
+  }
+
+  size_t topk = 10;
+  size_t colocated_record_size = 0;
+  for (uint32_t layout : {1U, 2U}) {
+    auto searcher = IndexFactory::CreateStreamer("HnswStreamer");
+    ASSERT_NE(nullptr, searcher);
+    ailego::Params search_params;
+    search_params.set(PARAM_HNSW_STREAMER_MAX_NEIGHBOR_COUNT, 16U);
+    search_params.set(PARAM_HNSW_STREAMER_EF, 64U);
+    search_params.set(PARAM_HNSW_STREAMER_BRUTE_FORCE_THRESHOLD, 1000U);
+    search_params.set(PARAM_HNSW_STREAMER_USE_CONTIGUOUS_MEMORY, true);
+    search_params.set(PARAM_HNSW_STREAMER_CONTIGUOUS_LAYOUT, layout);
+    ASSERT_EQ(0, searcher->init(*index_meta_ptr_, search_params));
+    ASSERT_EQ(0, searcher->open(storage));
+
+    // A neighbor code takes at most one byte per four dimensions, so the
+    // 32 L0 neighbor slots add at most 128 bytes to a record
+    auto *hnsw_streamer = dynamic_cast<HnswStreamer *>(searcher.get());
+    ASSERT_NE(nullptr, hnsw_streamer);
+    size_t record_size = hnsw_streamer->contiguous_record_size();
+    ASSERT_EQ(0UL, record_size % 64);
+    if (layout == 1U) {
+      colocated_record_size = record_size;
+    } else {
+      size_t codes_size = (32 * dim / 4 + 63) & ~size_t(63);
+      EXPECT_GT(record_size, colocated_record_size);
+      EXPECT_LE(record_size, colocated_record_size + codes_size);
+    }
+
+    auto linearCtx = searcher->create_context();
+    auto knnCtx = searcher->create_context();
+    linearCtx->set_topk(topk);
+    knnCtx->set_topk(topk);
+    int totalHits = 0;
+    int totalCnts = 0;
+    NumericalVector<float> vec(dim);
+    for (size_t i = 0; i < 200; i++) {
+      for (size_t j = 0; j < dim; ++j) {
+        vec[j] = dist(gen);
+      }
+      ASSERT_EQ(0, searcher->search_impl(vec.data(), qmeta, knnCtx));
+      ASSERT_EQ(0, searcher->search_bf_impl(vec.data(), qmeta, linearCtx));
+      auto &knnResult = knnCtx->result();
+      ASSERT_EQ(topk, knnResult.size());
+      auto &linearResult = linearCtx->result();
+      ASSERT_EQ(topk, linearResult.size());
+      // Results are re-ranked with exact distances
+      ASSERT_LE(knnResult[0].score(), knnResult[topk - 1].score());
+      for (size_t k = 0; k < topk; ++k) {
+        totalCnts++;
+        for (size_t j = 0; j < topk; ++j) {
+          if (linearResult[j].key() == knnResult[k].key()) {
+            totalHits++;
+            break;
+          }
+        }
+      }
+    }
+    float recall = totalHits * 1.0f / totalCnts;
+    EXPECT_GT(recall, 0.85f) << "layout " << layout;
+    ASSERT_EQ(0, searcher->close());
+  }
+}
+
+TEST_F(HnswStreamerTest, TestNeighborCodeBookPersisted) {
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  ASSERT_NE(nullptr, storage);
+  ailego::Params stg_params;
+  ASSERT_EQ(0, storage->init(stg_params));
+  ASSERT_EQ(0,
+            storage->open(dir_ + "TestNeighborCodeBookPersisted.index", true));
+
+  size_t cnt = 2000UL;
+  std::mt19937 gen(7717);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  {
+    auto builder = IndexFactory::CreateStreamer("HnswStreamer");
+    ASSERT_NE(nullptr, builder);
+    ailego::Params build_params;
+    build_params.set(PARAM_HNSW_STREAMER_MAX_NEIGHBOR_COUNT, 16U);
+    build_params.set(PARAM_HNSW_STREAMER_EFCONSTRUCTION, 64U);
+    ASSERT_EQ(0, builder->init(*index_meta_ptr_, build_params));
+    ASSERT_EQ(0, builder->open(storage));
+    auto ctx = builder->create_context();
+    NumericalVector<float> vec(dim);
+    for (size_t i = 0; i < cnt; i++) {
+      for (size_t j = 0; j < dim; ++j) {
+        vec[j] = dist(gen);
+      }
+      ASSERT_EQ(0, builder->add_impl(i, vec.data(), qmeta, ctx));
+    }
+    ASSERT_EQ(0, builder->flush(0UL));
+    ASSERT_EQ(0, builder->close());
+  }
+  ASSERT_EQ(nullptr, storage->get("HnswNeighborCodeBook"));
+
+  std::vector<NumericalVector<float>> queries(50, NumericalVector<float>(dim));
+  for (auto &query : queries) {
+    for (size_t j = 0; j < dim; ++j) {
+      query[j] = dist(gen);
+    }
+  }
+
+  // The second open reuses the codebook trained by the first one, so the
+  // code-guided traversal, and thus every result, is the same
+  size_t topk = 10;
+  std::vector<std::vector<uint64_t>> results[2];
+  for (auto &keys : results) {
+    auto searcher = IndexFactory::CreateStreamer("HnswStreamer");
+    ASSERT_NE(nullptr, searcher);
+    ailego::Params search_params;
+    search_params.set(PARAM_HNSW_STREAMER_MAX_NEIGHBOR_COUNT, 16U);
+    search_params.set(PARAM_HNSW_STREAMER_EF, 32U);
+    search_params.set(PARAM_HNSW_STREAMER_USE_CONTIGUOUS_MEMORY, true);
+    search_params.set(PARAM_HNSW_STREAMER_CONTIGUOUS_LAYOUT, 2U);
+    ASSERT_EQ(0, searcher->init(*index_meta_ptr_, search_params));
+    ASSERT_EQ(0, searcher->open(storage));
+    ASSERT_NE(nullptr, storage->get("HnswNeighborCodeBook"));
+
+    auto ctx = searcher->create_context();
+    ctx->set_topk(topk);
+    for (const auto &query : queries) {
+      ASSERT_EQ(0, searcher->search_impl(query.data(), qmeta, ctx));
+      keys.emplace_back();
+      for (const auto &doc : ctx->result()) {
+        keys.back().push_back(doc.key());
+      }
+    }
+    ASSERT_EQ(0, searcher->close());
+  }
+  EXPECT_EQ(results[0], results[1]);
+}
+
+TEST_F(HnswStreamerTest, TestBulkBuild) {
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("HnswStreamer");
+  ASSERT_NE(nullptr, streamer);
+  ailego::Params params;
+  params.set(PARAM_HNSW_STREAMER_MAX_NEIGHBOR_COUNT, 16U);
+  params.set(PARAM_HNSW_STREAMER_EFCONSTRUCTION, 64U);
+  params.set(PARAM_HNSW_STREAMER_EF, 64U);
+  params.set(PARAM_HNSW_STREAMER_BRUTE_FORCE_THRESHOLD, 1000U);
+  params.set(PARAM_HNSW_STREAMER_BUILD_THREAD_COUNT, 2U);
+  params.set(PARAM_HNSW_STREAMER_BUILD_SEED_COUNT, 500U);
+  ASSERT_EQ(0, streamer->init(*index_meta_ptr_, params));
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  ASSERT_NE(nullptr, storage);
+  ASSERT_EQ(0, storage->init(ailego::Params()));
+  ASSERT_EQ(0, storage->open(dir_ + "TestBulkBuild.index", true));
+  ASSERT_EQ(0, streamer->open(storage));
+
+  size_t cnt = 5000UL;
+  std::mt19937 gen(15583);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  auto holder =
+      std::make_shared<OnePassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  for (size_t i = 0; i < cnt; i++) {
+    NumericalVector<float> vec(dim);
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = dist(gen);
+    }
+    ASSERT_TRUE(holder->emplace(i, vec));
+  }
+  ASSERT_EQ(0, streamer->build(holder));
+  ASSERT_EQ(cnt, streamer->create_provider()->count());
+
+  // Bulk build only applies to an empty index
+  auto holder2 =
+      std::make_shared<OnePassIndexHolder<IndexMeta::DataType::DT_FP32>>(dim);
+  ASSERT_TRUE(holder2->emplace(cnt, NumericalVector<float>(dim)));
+  ASSERT_NE(0, streamer->build(holder2));
+
+  size_t topk = 10;
+  auto linearCtx = streamer->create_context();
+  auto knnCtx = streamer->create_context();
+  linearCtx->set_topk(topk);
+  knnCtx->set_topk(topk);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dim);
+  NumericalVector<float> vec(dim);
+  int totalHits = 0;
+  int totalCnts = 0;
+  for (size_t i = 0; i < 200; i++) {
+    for (size_t j = 0; j < dim; ++j) {
+      vec[j] = dist(gen);
+    }
+    ASSERT_EQ(0, streamer->search_impl(vec.data(), qmeta, knnCtx));
+    ASSERT_EQ(0, streamer->search_bf_impl(vec.data(), qmeta, linearCtx));
+    auto &knnResult = knnCtx->result();
+    ASSERT_EQ(topk, knnResult.size());
+    auto &linearResult = linearCtx->result();
+    for (size_t k = 0; k < topk; ++k) {
+      totalCnts++;
+      for (size_t j = 0; j < topk; ++j) {
+        if (linearResult[j].key() == knnResult[k].key()) {
+          totalHits++;
+          break;
+        }
+      }
+    }
+  }
+  float recall = totalHits * 1.0f / totalCnts;
+  EXPECT_GT(recall, 0.90f);
+
+  // Streaming inserts keep working on the bulk built graph
+  auto ctx = streamer->create_context();
+  ASSERT_EQ(0, streamer->add_impl(cnt, vec.data(), qmeta, ctx));
+  ASSERT_EQ(0, streamer->search_impl(vec.data(), qmeta, knnCtx));
+  ASSERT_EQ(cnt, knnCtx->result()[0].key());
+}
+
 // Test HNSW + INT8 quantization + rotation end-to-end
 TEST_F(HnswStreamerTest, TestInt8WithRotate) {
   constexpr size_t kTestDim = 128;
@@ -0,0 +1,398 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <zvec/ailego/logger/logger.h>
+#include <zvec/core/framework/index_framework.h>
+#include <zvec/core/framework/index_streamer.h>
+#include "tests/test_util.h"
+#include "inverted_sparse_context.h"
+#include "inverted_sparse_params.h"
+#include "inverted_sparse_streamer.h"
+
+using namespace zvec::core;
+using namespace zvec::ailego;
+using namespace std;
+
+class InvertedSparseStreamerTest : public testing::Test {
+ protected:
+  struct SparseData {
+    std::vector<uint32_t> indices;
+    std::vector<float> values;
+  };
+
+  void SetUp(void) override;
+  void TearDown(void) override;
+
+  //! Learned sparse vectors, positive weights on a skewed vocabulary
+  static std::vector<SparseData> generate(size_t cnt, size_t nnz,
+                                          uint32_t seed);
+
+  IndexStreamer::Pointer create_streamer(const std::string &name,
+                                         const Params &params);
+
+  static std::string dir_;
+  IndexMeta index_meta_;
+};
+
+std::string InvertedSparseStreamerTest::dir_(
+    "inverted_sparse_streamer_test_dir/");
+
+void InvertedSparseStreamerTest::SetUp(void) {
+  LoggerBroker::SetLevel(Logger::LEVEL_WARN);
+
+  index_meta_ = IndexMeta(IndexMeta::MetaType::MT_SPARSE,
+                          IndexMeta::DataType::DT_FP32);
+  index_meta_.set_metric("InnerProductSparse", 0, Params());
+
+  zvec::test_util::RemoveTestPath(dir_);
+}
+
+void InvertedSparseStreamerTest::TearDown(void) {
+  zvec::test_util::RemoveTestPath(dir_);
+}
+
+std::vector<InvertedSparseStreamerTest::SparseData>
+InvertedSparseStreamerTest::generate(size_t cnt, size_t nnz, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::exponential_distribution<float> term(0.01f);
+  std::uniform_real_distribution<float> weight(0.01f, 2.0f);
+
+  std::vector<SparseData> data(cnt);
+  for (auto &vec : data) {
+    std::vector<uint32_t> indices;
+    while (indices.size() < nnz) {
+      uint32_t index = static_cast<uint32_t>(term(gen)) % 30000u;
+      if (std::find(indices.begin(), indices.end(), index) == indices.end()) {
+        indices.push_back(index);
+      }
+    }
+    std::sort(indices.begin(), indices.end());
+    vec.indices = indices;
+    for (size_t i = 0; i < nnz; ++i) {
+      vec.values.push_back(weight(gen));
+    }
+  }
+  return data;
+}
+
+IndexStreamer::Pointer InvertedSparseStreamerTest::create_streamer(
+    const std::string &name, const Params &params) {
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("InvertedSparseStreamer");
+  if (!streamer) {
+    return streamer;
+  }
+
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  Params stg_params;
+  if (storage->init(stg_params) != 0 ||
+      storage->open(dir_ + name, true) != 0 ||
+      streamer->init(index_meta_, params) != 0 ||
+      streamer->open(storage) != 0) {
+    return IndexStreamer::Pointer();
+  }
+  return streamer;
+}
+
+TEST_F(InvertedSparseStreamerTest, TestSearchMatchesLinear) {
+  auto streamer = create_streamer("TestSearchMatchesLinear", Params());
+  ASSERT_TRUE(streamer != nullptr);
+
+  size_t cnt = 3000u;
+  auto docs = generate(cnt, 40u, 1u);
+  auto ctx = streamer->create_context();
+  ASSERT_TRUE(!!ctx);
+  IndexQueryMeta qmeta(IndexMeta::DT_FP32);
+  for (size_t i = 0; i < cnt; ++i) {
+    ASSERT_EQ(0, streamer->add_impl(i, docs[i].indices.size(),
+                                    docs[i].indices.data(),
+                                    docs[i].values.data(), qmeta, ctx));
+  }
+
+  auto queries = generate(50u, 20u, 2u);
+  auto linear_ctx = streamer->create_context();
+  size_t topk = 10u;
+  ctx->set_topk(topk);
+  linear_ctx->set_topk(topk);
+  size_t scored = 0;
+  for (const auto &query : queries) {
+    ASSERT_EQ(0, streamer->search_impl(query.indices.size(),
+                                       query.indices.data(),
+                                       query.values.data(), qmeta, ctx));
+    ASSERT_EQ(0, streamer->search_bf_impl(
+                     query.indices.size(), query.indices.data(),
+                     query.values.data(), qmeta, linear_ctx));
+
+    auto &result = ctx->result();
+    auto &expected = linear_ctx->result();
+    ASSERT_EQ(topk, result.size());
+    ASSERT_EQ(topk, expected.size());
+    for (size_t i = 0; i < topk; ++i) {
+      EXPECT_NEAR(expected[i].score(), result[i].score(), 1e-4);
+    }
+
+    auto *inverted_ctx = dynamic_cast<InvertedSparseContext *>(ctx.get());
+    ASSERT_TRUE(inverted_ctx != nullptr);
+    scored += inverted_ctx->stats().dist_calced_count();
+  }
+  // The pruning scores only a fraction of the documents
+  EXPECT_LT(scored, queries.size() * cnt / 2);
+}
+
+TEST_F(InvertedSparseStreamerTest, TestHeapFactor) {
+  auto streamer = create_streamer("TestHeapFactor", Params());
+  ASSERT_TRUE(streamer != nullptr);
+
+  size_t cnt = 3000u;
+  auto docs = generate(cnt, 40u, 3u);
+  auto ctx = streamer->create_context();
+  IndexQueryMeta qmeta(IndexMeta::DT_FP32);
+  for (size_t i = 0; i < cnt; ++i) {
+    ASSERT_EQ(0, streamer->add_impl(i, docs[i].indices.size(),
+                                    docs[i].indices.data(),
+                                    docs[i].values.data(), qmeta, ctx));
+  }
+
+  auto approx_ctx = streamer->create_context();
+  Params query_params;
+  query_params.set(PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR, 0.9f);
+  ASSERT_EQ(0, approx_ctx->update(query_params));
+  Params invalid_params;
+  invalid_params.set(PARAM_INVERTED_SPARSE_STREAMER_HEAP_FACTOR, 1.5f);
+  ASSERT_NE(0, approx_ctx->update(invalid_params));
+
+  auto queries = generate(50u, 20u, 4u);
+  size_t topk = 10u;
+  ctx->set_topk(topk);
+  approx_ctx->set_topk(topk);
+  size_t exact_scored = 0;
+  size_t approx_scored = 0;
+  size_t hits = 0;
+  for (const auto &query : queries) {
+    ASSERT_EQ(0, streamer->search_impl(query.indices.size(),
+                                       query.indices.data(),
+                                       query.values.data(), qmeta, ctx));
+    ASSERT_EQ(0, streamer->search_impl(query.indices.size(),
+                                       query.indices.data(),
+                                       query.values.data(), qmeta,
+                                       approx_ctx));
+    auto &exact = ctx->result();
+    auto &approx = approx_ctx->result();
+    for (auto &doc : approx) {
+      for (auto &expected : exact) {
+        hits += doc.key() == expected.key();
+      }
+    }
+
+    exact_scored += dynamic_cast<InvertedSparseContext *>(ctx.get())
+                        ->stats()
+                        .dist_calced_count();
+    approx_scored += dynamic_cast<InvertedSparseContext *>(approx_ctx.get())
+                         ->stats()
+                         .dist_calced_count();
+  }
+  EXPECT_LE(approx_scored, exact_scored);
+  EXPECT_GT(hits, queries.size() * topk * 7 / 10);
+}
+
+TEST_F(InvertedSparseStreamerTest, TestOutOfOrderIdsAndReopen) {
+  std::string path = dir_ + "TestOutOfOrderIdsAndReopen";
+  size_t cnt = 1000u;
+  auto docs = generate(cnt, 30u, 5u);
+  IndexQueryMeta qmeta(IndexMeta::DT_FP32);
+  auto queries = generate(20u, 10u, 6u);
+  size_t topk = 5u;
+
+  auto check = [&](IndexStreamer::Pointer &streamer) {
+    auto ctx = streamer->create_context();
+    auto linear_ctx = streamer->create_context();
+    ctx->set_topk(topk);
+    linear_ctx->set_topk(topk);
+    for (const auto &query : queries) {
+      ASSERT_EQ(0, streamer->search_impl(query.indices.size(),
+                                         query.indices.data(),
+                                         query.values.data(), qmeta, ctx));
+      ASSERT_EQ(0, streamer->search_bf_impl(
+                       query.indices.size(), query.indices.data(),
+                       query.values.data(), qmeta, linear_ctx));
+      ASSERT_EQ(linear_ctx->result().size(), ctx->result().size());
+      for (size_t i = 0; i < ctx->result().size(); ++i) {
+        EXPECT_NEAR(linear_ctx->result()[i].score(),
+                    ctx->result()[i].score(), 1e-4);
+      }
+    }
+  };
+
+  {
+    auto streamer = create_streamer("TestOutOfOrderIdsAndReopen", Params());
+    ASSERT_TRUE(streamer != nullptr);
+    auto ctx = streamer->create_context();
+    // Every other id first, then the gaps behind them
+    for (size_t i = 0; i < cnt; i += 2) {
+      ASSERT_EQ(0, streamer->add_with_id_impl(
+                       i, docs[i].indices.size(), docs[i].indices.data(),
+                       docs[i].values.data(), qmeta, ctx));
+    }
+    for (size_t i = cnt - 1; i < cnt; i -= 2) {
+      ASSERT_EQ(0, streamer->add_with_id_impl(
+                       i, docs[i].indices.size(), docs[i].indices.data(),
+                       docs[i].values.data(), qmeta, ctx));
+    }
+    check(streamer);
+    ASSERT_EQ(0, streamer->flush(0));
+    ASSERT_EQ(0, streamer->close());
+  }
+
+  // The posting lists are loaded from the flush
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("InvertedSparseStreamer");
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  Params stg_params;
+  ASSERT_EQ(0, storage->init(stg_params));
+  ASSERT_EQ(0, storage->open(path, false));
+  ASSERT_EQ(0, streamer->init(index_meta_, Params()));
+  ASSERT_EQ(0, streamer->open(storage));
+  check(streamer);
+}
+
+TEST_F(InvertedSparseStreamerTest, TestFlushedPostingsReloaded) {
+  std::string path = dir_ + "TestFlushedPostingsReloaded";
+  size_t cnt = 3000u;
+  auto docs = generate(cnt, 30u, 9u);
+  IndexQueryMeta qmeta(IndexMeta::DT_FP32);
+
+  {
+    auto streamer = create_streamer("TestFlushedPostingsReloaded", Params());
+    ASSERT_TRUE(streamer != nullptr);
+    auto ctx = streamer->create_context();
+    for (size_t i = 0; i < cnt; ++i) {
+      ASSERT_EQ(0, streamer->add_impl(i, docs[i].indices.size(),
+                                      docs[i].indices.data(),
+                                      docs[i].values.data(), qmeta, ctx));
+      if (i == 500u) {
+        ASSERT_EQ(0, streamer->flush(0));
+      }
+    }
+    ASSERT_EQ(0, streamer->flush(0));
+    ASSERT_EQ(0, streamer->close());
+  }
+
+  auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+  ASSERT_EQ(0, storage->init(Params()));
+  ASSERT_EQ(0, storage->open(path, false));
+  // The second flush outgrew the segment of the first
+  EXPECT_TRUE(storage->has(PARAM_INVERTED_SPARSE_POSTINGS_SEG_ID_PREFIX + "0"));
+  EXPECT_TRUE(storage->has(PARAM_INVERTED_SPARSE_POSTINGS_SEG_ID_PREFIX + "1"));
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("InvertedSparseStreamer");
+  ASSERT_EQ(0, streamer->init(index_meta_, Params()));
+  ASSERT_EQ(0, streamer->open(storage));
+
+  auto *inverted = dynamic_cast<InvertedSparseStreamer *>(streamer.get());
+  ASSERT_TRUE(inverted != nullptr);
+  EXPECT_EQ(cnt, inverted->index().doc_count());
+  InvertedSparseIndex::PostingList list;
+  ASSERT_TRUE(inverted->index().posting_list(docs[0].indices[0], &list));
+  EXPECT_EQ(0u, list.ids.front());
+  EXPECT_EQ(list.ids.size(), list.values.size());
+  EXPECT_EQ((list.ids.size() + InvertedSparseIndex::kBlockSize - 1) /
+                InvertedSparseIndex::kBlockSize,
+            list.blocks.size());
+
+  auto ctx = streamer->create_context();
+  auto linear_ctx = streamer->create_context();
+  size_t topk = 10u;
+  ctx->set_topk(topk);
+  linear_ctx->set_topk(topk);
+  for (const auto &query : generate(20u, 10u, 10u)) {
+    ASSERT_EQ(0, streamer->search_impl(query.indices.size(),
+                                       query.indices.data(),
+                                       query.values.data(), qmeta, ctx));
+    ASSERT_EQ(0, streamer->search_bf_impl(
+                     query.indices.size(), query.indices.data(),
+                     query.values.data(), qmeta, linear_ctx));
+    ASSERT_EQ(linear_ctx->result().size(), ctx->result().size());
+    for (size_t i = 0; i < ctx->result().size(); ++i) {
+      EXPECT_NEAR(linear_ctx->result()[i].score(), ctx->result()[i].score(),
+                  1e-4);
+    }
+  }
+}
+
+TEST_F(InvertedSparseStreamerTest, TestDumpAndLoad) {
+  auto streamer = create_streamer("TestDumpAndLoad", Params());
+  ASSERT_TRUE(streamer != nullptr);
+
+  size_t cnt = 1000u;
+  auto docs = generate(cnt, 30u, 7u);
+  auto ctx = streamer->create_context();
+  IndexQueryMeta qmeta(IndexMeta::DT_FP32);
+  for (size_t i = 0; i < cnt; ++i) {
+    ASSERT_EQ(0, streamer->add_impl(i, docs[i].indices.size(),
+                                    docs[i].indices.data(),
+                                    docs[i].values.data(), qmeta, ctx));
+  }
+
+  std::string path = dir_ + "TestDumpAndLoad.dump";
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_NE(dumper, nullptr);
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, streamer->dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+
+  IndexSearcher::Pointer searcher =
+      IndexFactory::CreateSearcher("InvertedSparseSearcher");
+  ASSERT_TRUE(searcher != nullptr);
+  auto read_storage = IndexFactory::CreateStorage("FileReadStorage");
+  ASSERT_EQ(0, read_storage->init(Params()));
+  ASSERT_EQ(0, read_storage->open(path, false));
+  EXPECT_TRUE(read_storage->has(PARAM_INVERTED_SPARSE_DUMP_POSTINGS_SEG_ID));
+  ASSERT_EQ(0, searcher->init(Params()));
+  ASSERT_EQ(0, searcher->load(read_storage, IndexMetric::Pointer()));
+
+  auto searcher_ctx = searcher->create_context();
+  ASSERT_TRUE(!!searcher_ctx);
+  auto queries = generate(20u, 10u, 8u);
+  size_t topk = 10u;
+  ctx->set_topk(topk);
+  searcher_ctx->set_topk(topk);
+  for (const auto &query : queries) {
+    ASSERT_EQ(0, streamer->search_impl(query.indices.size(),
+                                       query.indices.data(),
+                                       query.values.data(), qmeta, ctx));
+    ASSERT_EQ(0, searcher->search_impl(query.indices.size(),
+                                       query.indices.data(),
+                                       query.values.data(), qmeta,
+                                       searcher_ctx));
+    ASSERT_EQ(ctx->result().size(), searcher_ctx->result().size());
+    for (size_t i = 0; i < ctx->result().size(); ++i) {
+      EXPECT_EQ(ctx->result()[i].key(), searcher_ctx->result()[i].key());
+    }
+  }
+}
+
+TEST_F(InvertedSparseStreamerTest, TestUnsupportedMetric) {
+  IndexStreamer::Pointer streamer =
+      IndexFactory::CreateStreamer("InvertedSparseStreamer");
+  ASSERT_TRUE(streamer != nullptr);
+
+  IndexMeta meta(IndexMeta::MetaType::MT_SPARSE,
+                 IndexMeta::DataType::DT_FP32);
+  meta.set_metric("SquaredEuclideanSparse", 0, Params());
+  ASSERT_NE(0, streamer->init(meta, Params()));
+}
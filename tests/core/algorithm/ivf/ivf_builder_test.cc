@@ -17,6 +17,7 @@
 #include <vector>
 #include <gtest/gtest.h>
 #include <zvec/ailego/container/vector.h>
+#include "ivf_entity.h"
 
 using namespace zvec::core;
 using namespace zvec::ailego;
@@ -525,4 +526,139 @@ TEST_F(IVFBuilderTest, TestIndexThreads) {
   ASSERT_EQ(doc_cnt, stats1.built_count());
   auto &stats2 = builder2->stats();
   ASSERT_EQ(doc_cnt, stats2.built_count());
-}
\ No newline at end of file
+}
+
+TEST_F(IVFBuilderTest, TestRebalanceWithDrift) {
+  //! Train by uniform vectors, and build by drifted vectors
+  std::mt19937 gen(8237);
+  std::uniform_real_distribution<float> uniform(0.0f, 100.0f);
+  std::uniform_real_distribution<float> drifted(40.0f, 42.0f);
+  auto train_holder =
+      std::make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(
+          dimension_);
+  for (size_t i = 0; i < 1000; ++i) {
+    NumericalVector<float> vec(dimension_);
+    for (size_t j = 0; j < dimension_; ++j) {
+      vec[j] = uniform(gen);
+    }
+    train_holder->emplace(i, vec);
+  }
+  const size_t drifted_count = 1800;
+  auto build_holder =
+      std::make_shared<MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>>(
+          dimension_);
+  for (size_t i = 0; i < 2000; ++i) {
+    NumericalVector<float> vec(dimension_);
+    for (size_t j = 0; j < dimension_; ++j) {
+      vec[j] = i < drifted_count ? drifted(gen) : uniform(gen);
+    }
+    build_holder->emplace(i, vec);
+  }
+
+  //! Without rebalancing, the stats come from the centroid search
+  float plain_factor = 0.0f;
+  {
+    IVFBuilder plain;
+    ASSERT_EQ(0, plain.init(index_meta_, params_));
+    ASSERT_EQ(0, plain.train(threads_, train_holder));
+    ASSERT_EQ(0, plain.build(threads_, build_holder));
+    plain_factor = plain.imbalance_factor();
+    EXPECT_GT(plain_factor, 2.0f);
+    size_t total = 0;
+    for (const auto &it : plain.centroid_stats()) {
+      total += it.vector_count;
+      EXPECT_LE(it.residual_mean, it.residual_max);
+      if (it.vector_count > 1) {
+        EXPECT_GT(it.residual_max, 0.0f);
+      }
+    }
+    EXPECT_EQ(2000u, total);
+  }
+
+  Params params = params_;
+  params.set(PARAM_IVF_BUILDER_REBALANCE_ENABLE, true);
+  params.set(PARAM_IVF_BUILDER_REBALANCE_SPLIT_RATIO, 1.0f);
+  IVFBuilder builder;
+  EXPECT_NE(0, builder.init(index_meta_, params));
+  builder.cleanup();
+
+  params.set(PARAM_IVF_BUILDER_REBALANCE_SPLIT_RATIO, 2.0f);
+  params.set(PARAM_IVF_BUILDER_REBALANCE_MERGE_RATIO, 0.2f);
+  params.set(PARAM_IVF_BUILDER_REBALANCE_IMBALANCE_FACTOR, 0.5f);
+  EXPECT_NE(0, builder.init(index_meta_, params));
+  builder.cleanup();
+
+  //! Below the imbalance factor limit the lists are left as they are, and
+  //! the factor never exceeds the list count
+  {
+    Params loose = params;
+    loose.set(PARAM_IVF_BUILDER_REBALANCE_IMBALANCE_FACTOR, 8.0f);
+    IVFBuilder untouched;
+    ASSERT_EQ(0, untouched.init(index_meta_, loose));
+    ASSERT_EQ(0, untouched.train(threads_, train_holder));
+    ASSERT_EQ(0, untouched.build(threads_, build_holder));
+    EXPECT_EQ(8u, untouched.centroid_index()->centroids_count());
+    EXPECT_GT(untouched.imbalance_factor(), 2.0f);
+  }
+
+  params.set(PARAM_IVF_BUILDER_REBALANCE_IMBALANCE_FACTOR, 1.5f);
+  ASSERT_EQ(0, builder.init(index_meta_, params));
+  ASSERT_EQ(0, builder.train(threads_, train_holder));
+  ASSERT_EQ(0, builder.build(threads_, build_holder));
+
+  auto stats = builder.centroid_stats();
+  EXPECT_EQ(builder.centroid_index()->centroids_count(), stats.size());
+  size_t total = 0;
+  for (const auto &it : stats) {
+    total += it.vector_count;
+    EXPECT_LT(it.vector_count, drifted_count);
+    EXPECT_LE(it.residual_mean, it.residual_max);
+  }
+  EXPECT_EQ(2000u, total);
+
+  std::string path = "./ivf_rebalance_index";
+  auto dumper = IndexFactory::CreateDumper("FileDumper");
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, builder.dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+  EXPECT_EQ(2000u, builder.stats().dumped_count());
+
+  auto storage = IndexFactory::CreateStorage("MMapFileReadStorage");
+  ASSERT_EQ(0, storage->init(Params()));
+  ASSERT_EQ(0, storage->open(path, false));
+  IVFEntity entity;
+  ASSERT_EQ(0, entity.load(storage));
+  ASSERT_EQ(stats.size(), entity.inverted_list_count());
+  for (size_t i = 0; i < stats.size(); ++i) {
+    auto list_stats = entity.centroid_stats(i);
+    ASSERT_NE(nullptr, list_stats);
+    EXPECT_EQ(stats[i].vector_count, list_stats->vector_count);
+    EXPECT_EQ(stats[i].vector_count,
+              entity.inverted_list_meta(i)->vector_count);
+    EXPECT_FLOAT_EQ(stats[i].residual_mean, list_stats->residual_mean);
+  }
+  EXPECT_LT(builder.imbalance_factor(), plain_factor);
+  EXPECT_FLOAT_EQ(builder.imbalance_factor(), entity.imbalance_factor());
+
+  //! Rebalance every 500 labeled vectors on two levels of centroids
+  params.set(PARAM_IVF_BUILDER_CENTROID_COUNT, "4*2");
+  params.set(PARAM_IVF_BUILDER_REBALANCE_INTERVAL, 500u);
+  IVFBuilder incremental;
+  ASSERT_EQ(0, incremental.init(index_meta_, params));
+  ASSERT_EQ(0, incremental.train(threads_, train_holder));
+  ASSERT_EQ(0, incremental.build(threads_, build_holder));
+  total = 0;
+  for (const auto &it : incremental.centroid_stats()) {
+    total += it.vector_count;
+    EXPECT_LT(it.vector_count, drifted_count);
+  }
+  EXPECT_EQ(2000u, total);
+  EXPECT_EQ(2000u, incremental.stats().built_count());
+  EXPECT_LT(incremental.imbalance_factor(), plain_factor);
+
+  path = "./ivf_rebalance_incremental_index";
+  ASSERT_EQ(0, dumper->create(path));
+  ASSERT_EQ(0, incremental.dump(dumper));
+  ASSERT_EQ(0, dumper->close());
+  EXPECT_EQ(2000u, incremental.stats().dumped_count());
+}
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include "zvec/core/framework/index_framework.h"
 #include "ivf_builder.h"
+#include "ivf_fastscan.h"
 
 #if defined(__GNUC__) || defined(__GNUG__)
 #pragma GCC diagnostic push
@@ -3839,6 +3840,271 @@ TEST_F(IVFSearcherTest, TestNprobeClampToListCount) {
   EXPECT_EQ(0, ret);
 }
 
+TEST_F(IVFSearcherTest, TestFastScan) {
+  dimension_ = 32;
+  index_meta_.set_meta(IndexMeta::DataType::DT_FP32, dimension_);
+
+  IVFBuilder builder;
+  Params build_params;
+  build_params.set(PARAM_IVF_BUILDER_CENTROID_COUNT, "8");
+  build_params.set(PARAM_IVF_BUILDER_CLUSTER_CLASS, "KmeansCluster");
+  build_params.set(PARAM_IVF_BUILDER_FASTSCAN_ENABLE, true);
+  build_params.set(PARAM_IVF_BUILDER_FASTSCAN_SUBSPACE_COUNT, 7u);
+  EXPECT_NE(0, builder.init(index_meta_, build_params));
+  builder.cleanup();
+
+  build_params.set(PARAM_IVF_BUILDER_FASTSCAN_SUBSPACE_COUNT, 16u);
+  int ret = builder.init(index_meta_, build_params);
+  ASSERT_EQ(0, ret);
+
+  MultiPassIndexHolder<IndexMeta::DataType::DT_FP32> *holder =
+      new MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>(dimension_);
+  std::mt19937 gen(15583);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  for (size_t i = 0; i < 2000; ++i) {
+    NumericalVector<float> vec(dimension_);
+    for (size_t j = 0; j < dimension_; ++j) {
+      vec[j] = dist(gen);
+    }
+    holder->emplace(i, vec);
+  }
+  holder_.reset(holder);
+
+  ret = builder.train(threads_, holder_);
+  ASSERT_EQ(0, ret);
+  ret = builder.build(threads_, holder_);
+  ASSERT_EQ(0, ret);
+  IndexDumper::Pointer dumper = IndexFactory::CreateDumper("FileDumper");
+  ret = dumper->create(index_path_);
+  EXPECT_EQ(0, ret);
+  ret = builder.dump(dumper);
+  EXPECT_EQ(0, ret);
+  EXPECT_EQ(0, dumper->close());
+
+  IVFSearcher searcher;
+  Params search_params;
+  search_params.set(PARAM_IVF_SEARCHER_NPROBE, 8u);
+  search_params.set(PARAM_IVF_SEARCHER_BRUTE_FORCE_THRESHOLD, 1);
+  ret = searcher.init(search_params);
+  EXPECT_EQ(0, ret);
+
+  IndexStorage::Pointer container =
+      IndexFactory::CreateStorage("MMapFileReadStorage");
+  container->init(Params());
+  ret = container->open(index_path_, false);
+  EXPECT_EQ(0, ret);
+  ret = searcher.load(container, IndexMetric::Pointer());
+  ASSERT_EQ(0, ret);
+
+  size_t topk = 10;
+  auto context = searcher.create_context();
+  context->set_topk(topk);
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dimension_);
+  size_t hits = 0;
+  size_t total = 0;
+  for (size_t q = 0; q < 50; ++q) {
+    std::vector<float> query(dimension_);
+    for (size_t j = 0; j < dimension_; ++j) {
+      query[j] = dist(gen);
+    }
+    ret = searcher.search_bf_impl(query.data(), qmeta, context);
+    ASSERT_EQ(0, ret);
+    auto expected = context->result(0);
+
+    ret = searcher.search_impl(query.data(), qmeta, context);
+    ASSERT_EQ(0, ret);
+    auto &result = context->result(0);
+    ASSERT_EQ(topk, result.size());
+    for (size_t i = 1; i < result.size(); ++i) {
+      EXPECT_LE(result[i - 1].score(), result[i].score());
+    }
+    for (auto &doc : result) {
+      for (auto &exp : expected) {
+        if (exp.key() == doc.key()) {
+          // Reranked by the exact distance
+          EXPECT_FLOAT_EQ(exp.score(), doc.score());
+          ++hits;
+          break;
+        }
+      }
+    }
+    total += topk;
+  }
+  EXPECT_GT(hits * 1.0f / total, 0.9f);
+
+  // Filtered keys never come back from the fast scan path
+  context->set_filter([](uint64_t key) { return key % 2 == 0; });
+  std::vector<float> query(dimension_, 0.5f);
+  ret = searcher.search_impl(query.data(), qmeta, context);
+  ASSERT_EQ(0, ret);
+  EXPECT_EQ(topk, context->result(0).size());
+  for (auto &doc : context->result(0)) {
+    EXPECT_EQ(1u, doc.key() % 2);
+  }
+
+  ret = searcher.unload();
+  EXPECT_EQ(0, ret);
+}
+
+TEST_F(IVFSearcherTest, TestFastScanDefaultSubspaceCount) {
+  const std::vector<std::pair<uint32_t, uint32_t>> cases = {
+      {2, 2},     {3, 3},     {9, 3},     {97, 97},   {128, 64},
+      {768, 256}, {960, 240}, {1024, 256}, {1536, 256}, {1031, 1}};
+  for (const auto &c : cases) {
+    IndexMeta meta;
+    meta.set_meta(IndexMeta::DataType::DT_FP32, c.first);
+    meta.set_metric("SquaredEuclidean", 0, Params());
+    IVFFastScan fastscan;
+    ASSERT_EQ(0, fastscan.init(meta, 0)) << "dimension " << c.first;
+    EXPECT_EQ(c.second, fastscan.subspace_count()) << "dimension " << c.first;
+  }
+}
+
+TEST_F(IVFSearcherTest, TestFastScanDefaultParams) {
+  // Neither dimension is 2 * subspace count with at most 256 subspaces
+  for (uint32_t dim : {768u, 9u}) {
+    dimension_ = dim;
+    index_meta_.set_meta(IndexMeta::DataType::DT_FP32, dimension_);
+
+    IVFBuilder builder;
+    Params build_params;
+    build_params.set(PARAM_IVF_BUILDER_CENTROID_COUNT, "4");
+    build_params.set(PARAM_IVF_BUILDER_CLUSTER_CLASS, "KmeansCluster");
+    build_params.set(PARAM_IVF_BUILDER_FASTSCAN_ENABLE, true);
+    ASSERT_EQ(0, builder.init(index_meta_, build_params)) << dim;
+
+    MultiPassIndexHolder<IndexMeta::DataType::DT_FP32> *holder =
+        new MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>(dimension_);
+    std::mt19937 gen(dim);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t i = 0; i < 500; ++i) {
+      NumericalVector<float> vec(dimension_);
+      for (size_t j = 0; j < dimension_; ++j) {
+        vec[j] = dist(gen);
+      }
+      holder->emplace(i, vec);
+    }
+    holder_.reset(holder);
+
+    ASSERT_EQ(0, builder.train(threads_, holder_));
+    ASSERT_EQ(0, builder.build(threads_, holder_));
+    IndexDumper::Pointer dumper = IndexFactory::CreateDumper("FileDumper");
+    ASSERT_EQ(0, dumper->create(index_path_));
+    ASSERT_EQ(0, builder.dump(dumper));
+    ASSERT_EQ(0, dumper->close());
+
+    IVFSearcher searcher;
+    Params search_params;
+    search_params.set(PARAM_IVF_SEARCHER_NPROBE, 4u);
+    search_params.set(PARAM_IVF_SEARCHER_BRUTE_FORCE_THRESHOLD, 1);
+    ASSERT_EQ(0, searcher.init(search_params));
+    IndexStorage::Pointer container =
+        IndexFactory::CreateStorage("MMapFileReadStorage");
+    container->init(Params());
+    ASSERT_EQ(0, container->open(index_path_, false));
+    ASSERT_EQ(0, searcher.load(container, IndexMetric::Pointer()));
+
+    // Indexed vectors find themselves through the fast scan and rerank
+    auto context = searcher.create_context();
+    context->set_topk(1);
+    IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dimension_);
+    auto provider = searcher.create_provider();
+    for (uint64_t key = 0; key < 500; key += 50) {
+      const void *query = provider->get_vector(key);
+      ASSERT_NE(nullptr, query);
+      ASSERT_EQ(0, searcher.search_impl(query, qmeta, context));
+      ASSERT_EQ(1u, context->result(0).size());
+      EXPECT_EQ(key, context->result(0)[0].key()) << dim;
+    }
+    EXPECT_EQ(0, searcher.unload());
+  }
+}
+
+TEST_F(IVFSearcherTest, TestBatchScan) {
+  dimension_ = 16;
+  for (auto order : {IndexMeta::MO_COLUMN, IndexMeta::MO_ROW}) {
+    index_meta_.set_meta(IndexMeta::DataType::DT_FP32, dimension_);
+    index_meta_.set_major_order(order);
+
+    IVFBuilder builder;
+    Params build_params;
+    build_params.set(PARAM_IVF_BUILDER_CENTROID_COUNT, "8");
+    build_params.set(PARAM_IVF_BUILDER_CLUSTER_CLASS, "KmeansCluster");
+    ASSERT_EQ(0, builder.init(index_meta_, build_params));
+
+    MultiPassIndexHolder<IndexMeta::DataType::DT_FP32> *holder =
+        new MultiPassIndexHolder<IndexMeta::DataType::DT_FP32>(dimension_);
+    std::mt19937 gen(3571);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t i = 0; i < 3000; ++i) {
+      NumericalVector<float> vec(dimension_);
+      for (size_t j = 0; j < dimension_; ++j) {
+        vec[j] = dist(gen);
+      }
+      holder->emplace(i, vec);
+    }
+    holder_.reset(holder);
+    ASSERT_EQ(0, builder.train(threads_, holder_));
+    ASSERT_EQ(0, builder.build(threads_, holder_));
+    IndexDumper::Pointer dumper = IndexFactory::CreateDumper("FileDumper");
+    ASSERT_EQ(0, dumper->create(index_path_));
+    ASSERT_EQ(0, builder.dump(dumper));
+    ASSERT_EQ(0, dumper->close());
+
+    IVFSearcher searcher;
+    Params search_params;
+    search_params.set(PARAM_IVF_SEARCHER_NPROBE, 3u);
+    search_params.set(PARAM_IVF_SEARCHER_BRUTE_FORCE_THRESHOLD, 1);
+    ASSERT_EQ(0, searcher.init(search_params));
+    IndexStorage::Pointer container =
+        IndexFactory::CreateStorage("MMapFileReadStorage");
+    container->init(Params());
+    ASSERT_EQ(0, container->open(index_path_, false));
+    ASSERT_EQ(0, searcher.load(container, IndexMetric::Pointer()));
+
+    //! 37 queries cover the 32, 4 and 1 query kernels
+    const size_t qnum = 37;
+    const size_t topk = 20;
+    std::vector<float> queries(qnum * dimension_);
+    for (auto &v : queries) {
+      v = dist(gen);
+    }
+    IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, dimension_);
+    auto batch_context = searcher.create_context();
+    auto single_context = searcher.create_context();
+    Params single_params = search_params;
+    single_params.set(PARAM_IVF_SEARCHER_BATCH_SCAN_ENABLE, false);
+    ASSERT_EQ(0, single_context->update(single_params));
+
+    for (bool filtered : {false, true}) {
+      for (auto *ctx : {&batch_context, &single_context}) {
+        (*ctx)->set_topk(topk);
+        if (filtered) {
+          (*ctx)->set_filter([](uint64_t key) { return key % 3 == 0; });
+        }
+      }
+      ASSERT_EQ(0, searcher.search_impl(queries.data(), qmeta, qnum,
+                                        batch_context));
+      ASSERT_EQ(0, searcher.search_impl(queries.data(), qmeta, qnum,
+                                        single_context));
+      for (size_t q = 0; q < qnum; ++q) {
+        auto &batch = batch_context->result(q);
+        auto &single = single_context->result(q);
+        ASSERT_EQ(topk, batch.size());
+        ASSERT_EQ(single.size(), batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+          EXPECT_EQ(single[i].key(), batch[i].key());
+          EXPECT_FLOAT_EQ(single[i].score(), batch[i].score());
+          if (filtered) {
+            EXPECT_NE(0u, batch[i].key() % 3);
+          }
+        }
+      }
+    }
+    ASSERT_EQ(0, searcher.unload());
+  }
+}
+
 #if defined(__GNUC__) || defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
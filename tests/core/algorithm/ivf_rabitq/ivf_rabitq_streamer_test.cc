@@ -1376,5 +1376,69 @@ TEST_F(IvfRabitqStreamerTest, TestSmallDataset) {
            result.size(), (size_t)result[0].key(), result[0].score());
 }
 
+TEST_F(IvfRabitqStreamerTest, TestBatchScanMatchesPerQuery) {
+  constexpr size_t kDocCount = 2000;
+  // More queries than one scan tile, so clusters are scanned in several tiles
+  constexpr size_t kQueryCount = IvfRabitqEntity::kMaxScanTile * 2 + 3;
+  auto holder = BuildHolder(kDim, kDocCount);
+
+  // 1-bit codes prune on the estimate itself, so the per-query and the tiled
+  // scan keep the exact same top-k whatever order the clusters are visited in
+  ailego::Params params;
+  params.set(PARAM_IVF_RABITQ_NLIST, 16U);
+  params.set(PARAM_RABITQ_TOTAL_BITS, 1U);
+  IndexStreamer::Pointer streamer;
+  BuildAndOpenStreamer(*index_meta_ptr_, holder, params,
+                       dir_ + "/TestBatchScanMatchesPerQuery", &streamer);
+  ASSERT_NE(nullptr, streamer);
+
+  std::vector<float> queries(kQueryCount * kDim);
+  for (size_t q = 0; q < kQueryCount; ++q) {
+    NumericalVector<float> vec(kDim);
+    FillTestVector(q * 97 + 5, &vec);
+    std::memcpy(&queries[q * kDim], vec.data(), kDim * sizeof(float));
+  }
+  IndexQueryMeta query_meta(IndexMeta::DataType::DT_FP32, kDim);
+
+  auto search = [&](bool batch_scan, bool with_filter,
+                    std::vector<IndexDocumentList> *results) {
+    auto context = streamer->create_context();
+    context->set_topk(20);
+    if (with_filter) {
+      context->set_filter([](uint64_t key) { return key % 3 == 0; });
+    }
+    ailego::Params search_params;
+    search_params.set(PARAM_IVF_RABITQ_NPROBE, 6U);
+    search_params.set(PARAM_IVF_RABITQ_BATCH_SCAN_ENABLE, batch_scan);
+    ASSERT_EQ(0, context->update(search_params));
+    ASSERT_EQ(0, streamer->search_impl(queries.data(), query_meta,
+                                       kQueryCount, context));
+    results->clear();
+    for (size_t q = 0; q < kQueryCount; ++q) {
+      results->push_back(context->result(q));
+    }
+  };
+
+  for (bool with_filter : {false, true}) {
+    std::vector<IndexDocumentList> per_query;
+    std::vector<IndexDocumentList> batched;
+    search(false, with_filter, &per_query);
+    search(true, with_filter, &batched);
+    ASSERT_EQ(kQueryCount, per_query.size());
+    ASSERT_EQ(kQueryCount, batched.size());
+    for (size_t q = 0; q < kQueryCount; ++q) {
+      ASSERT_GT(per_query[q].size(), 0UL);
+      ASSERT_EQ(per_query[q].size(), batched[q].size());
+      for (size_t i = 0; i < per_query[q].size(); ++i) {
+        EXPECT_EQ(per_query[q][i].key(), batched[q][i].key());
+        EXPECT_FLOAT_EQ(per_query[q][i].score(), batched[q][i].score());
+        if (with_filter) {
+          EXPECT_NE(0UL, batched[q][i].key() % 3);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace core
 }  // namespace zvec
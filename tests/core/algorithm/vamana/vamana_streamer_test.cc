@@ -21,6 +21,7 @@
 #include <future>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <gtest/gtest.h>
 #include <zvec/ailego/container/vector.h>
 #include "tests/test_util.h"
@@ -785,6 +786,83 @@ TEST_F(VamanaStreamerTest, TestConcurrentBuild) {
   ASSERT_GT(result.size(), 0UL);
 }
 
+TEST_F(VamanaStreamerTest, TestParallelRefineReproducible) {
+  size_t cnt = 3000U;
+  std::mt19937 gen(7793);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::vector<NumericalVector<float>> vecs(cnt, NumericalVector<float>(kDim));
+  for (auto &vec : vecs) {
+    for (size_t j = 0; j < kDim; ++j) {
+      vec[j] = dist(gen);
+    }
+  }
+
+  // The same data refined with one and with four threads
+  IndexQueryMeta qmeta(IndexMeta::DataType::DT_FP32, kDim);
+  auto build = [&](uint32_t thread_count) {
+    ailego::Params params;
+    params.set(PARAM_VAMANA_STREAMER_TWO_PASS_BUILD_ENABLE, true);
+    params.set(PARAM_VAMANA_STREAMER_BUILD_THREAD_COUNT, thread_count);
+    auto streamer = CreateVamanaStreamer(params);
+    EXPECT_NE(nullptr, streamer);
+    auto storage = IndexFactory::CreateStorage("MMapFileStorage");
+    EXPECT_EQ(0, storage->init(ailego::Params()));
+    EXPECT_EQ(0, storage->open(dir_ + "TestParallelRefine" +
+                                   std::to_string(thread_count),
+                               true));
+    EXPECT_EQ(0, streamer->open(storage));
+    auto ctx = streamer->create_context();
+    for (size_t i = 0; i < cnt; i++) {
+      EXPECT_EQ(0, streamer->add_impl(i, vecs[i].data(), qmeta, ctx));
+    }
+    auto *vamana = dynamic_cast<VamanaStreamer *>(streamer.get());
+    EXPECT_NE(nullptr, vamana);
+    EXPECT_EQ(0, vamana->finalize_build());
+    return streamer;
+  };
+  auto serial = build(1U);
+  auto parallel = build(4U);
+
+  auto serialCtx = serial->create_context();
+  auto parallelCtx = parallel->create_context();
+  auto linearCtx = serial->create_context();
+  size_t topk = 10;
+  serialCtx->set_topk(topk);
+  parallelCtx->set_topk(topk);
+  linearCtx->set_topk(topk);
+  NumericalVector<float> vec(kDim);
+  int totalHits = 0;
+  int totalCnts = 0;
+  for (size_t q = 0; q < 100; ++q) {
+    for (size_t j = 0; j < kDim; ++j) {
+      vec[j] = dist(gen);
+    }
+    ASSERT_EQ(0, serial->search_impl(vec.data(), qmeta, serialCtx));
+    ASSERT_EQ(0, parallel->search_impl(vec.data(), qmeta, parallelCtx));
+    ASSERT_EQ(0, serial->search_bf_impl(vec.data(), qmeta, linearCtx));
+
+    auto &serialResult = serialCtx->result();
+    auto &parallelResult = parallelCtx->result();
+    ASSERT_EQ(serialResult.size(), parallelResult.size());
+    for (size_t k = 0; k < serialResult.size(); ++k) {
+      EXPECT_EQ(serialResult[k].key(), parallelResult[k].key());
+      EXPECT_FLOAT_EQ(serialResult[k].score(), parallelResult[k].score());
+    }
+
+    auto &linearResult = linearCtx->result();
+    for (size_t k = 0; k < topk; ++k) {
+      totalCnts++;
+      for (size_t j = 0; j < topk; ++j) {
+        if (linearResult[j].key() == serialResult[k].key()) {
+          totalHits++;
+          break;
+        }
+      }
+    }
+  }
+  EXPECT_GT(totalHits * 1.0f / totalCnts, 0.90f);
+}
+
 TEST_F(VamanaStreamerTest, TestAsymmetricQueryMetric) {
   constexpr size_t kTestDimension = 2;
 
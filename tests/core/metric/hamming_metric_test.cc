@@ -0,0 +1,93 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "zvec/core/framework/index_factory.h"
+
+using namespace zvec;
+using namespace zvec::core;
+
+TEST(HammingMetric, General) {
+  auto metric = IndexFactory::CreateMetric("Hamming");
+  ASSERT_TRUE(metric);
+
+  IndexMeta meta;
+  meta.set_meta(IndexMeta::DataType::DT_FP32, 64);
+  ASSERT_NE(0, metric->init(meta, ailego::Params()));
+  meta.set_meta(IndexMeta::DataType::DT_BINARY64, 96);
+  ASSERT_NE(0, metric->init(meta, ailego::Params()));
+  meta.set_meta(IndexMeta::DataType::DT_BINARY64, 128);
+  ASSERT_EQ(0, metric->init(meta, ailego::Params()));
+  meta.set_meta(IndexMeta::DataType::DT_BINARY32, 96);
+  ASSERT_EQ(0, metric->init(meta, ailego::Params()));
+
+  IndexMeta meta2;
+  meta2.set_meta(IndexMeta::DataType::DT_BINARY64, 96);
+  EXPECT_TRUE(metric->is_matched(meta));
+  EXPECT_FALSE(metric->is_matched(meta2));
+  EXPECT_TRUE(metric->is_matched(
+      meta, IndexQueryMeta(IndexMeta::DataType::DT_BINARY32, 96)));
+  EXPECT_FALSE(metric->is_matched(
+      meta, IndexQueryMeta(IndexMeta::DataType::DT_BINARY32, 64)));
+
+  EXPECT_TRUE(metric->distance());
+  EXPECT_TRUE(metric->batch_distance());
+  EXPECT_FALSE(metric->query_metric());
+  EXPECT_FALSE(metric->distance_matrix(0, 0));
+  EXPECT_FALSE(metric->distance_matrix(3, 5));
+  EXPECT_FALSE(metric->distance_matrix(8, 32));
+  EXPECT_TRUE(metric->distance_matrix(1, 1));
+  EXPECT_TRUE(metric->distance_matrix(8, 4));
+  EXPECT_TRUE(metric->distance_matrix(32, 32));
+  EXPECT_FALSE(metric->support_normalize());
+}
+
+TEST(HammingMetric, Distance) {
+  auto metric = IndexFactory::CreateMetric("Hamming");
+  ASSERT_TRUE(metric);
+
+  const size_t dim = 256;
+  IndexMeta meta;
+  meta.set_meta(IndexMeta::DataType::DT_BINARY64, dim);
+  ASSERT_EQ(0, metric->init(meta, ailego::Params()));
+
+  std::mt19937_64 gen(7);
+  std::vector<uint64_t> query(dim / 64);
+  for (auto &v : query) {
+    v = gen();
+  }
+  std::vector<std::vector<uint64_t>> vectors(5, query);
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    // flip the lowest i bits of every word
+    for (auto &v : vectors[i]) {
+      v ^= (uint64_t{1} << i) - 1;
+    }
+  }
+
+  auto distance = metric->distance();
+  auto batch_distance = metric->batch_distance();
+  std::vector<const void *> ptrs;
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    float result = -1.0f;
+    distance(vectors[i].data(), query.data(), dim, &result);
+    EXPECT_FLOAT_EQ(static_cast<float>(i * (dim / 64)), result);
+    ptrs.push_back(vectors[i].data());
+  }
+  std::vector<float> results(vectors.size());
+  batch_distance(ptrs.data(), query.data(), ptrs.size(), dim, results.data());
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    EXPECT_FLOAT_EQ(static_cast<float>(i * (dim / 64)), results[i]);
+  }
+}
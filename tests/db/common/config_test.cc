@@ -15,6 +15,7 @@
 #include "zvec/db/config.h"
 #include <gtest/gtest.h>
 #include "zvec/db/status.h"
+#include "db/common/constants.h"
 
 using namespace zvec;
 
@@ -55,6 +56,8 @@ TEST_F(ConfigTest, InitializeWithDefaultConfig) {
   ASSERT_EQ(GlobalConfig::Instance().invert_to_forward_scan_ratio(), 0.9f);
   ASSERT_EQ(GlobalConfig::Instance().brute_force_by_keys_ratio(), 0.1f);
   ASSERT_EQ(GlobalConfig::Instance().fts_brute_force_by_keys_ratio(), 0.05f);
+  ASSERT_EQ(GlobalConfig::Instance().fts_query_cache_bytes(),
+            DEFAULT_FTS_QUERY_CACHE_BYTES);
   ASSERT_GT(GlobalConfig::Instance().optimize_thread_count(), 0);
   ASSERT_FALSE(GlobalConfig::Instance().optimize_thread_binding());
 }
@@ -173,6 +176,16 @@ TEST_F(ConfigTest, ValidateConfigWithInvalidRatios) {
   ASSERT_NE(status.message().find(
                 "fts_brute_force_by_keys_ratio must be between 0 and 1"),
             std::string::npos);
+
+  // Test fts_query_cache_bytes above the memory limit
+  config.fts_brute_force_by_keys_ratio = 0.05f;  // Reset to valid value
+  config.fts_query_cache_bytes = config.memory_limit_bytes + 1;
+  status = config_instance.validate(config);
+  ASSERT_FALSE(status.ok());
+  ASSERT_EQ(status.code(), StatusCode::INVALID_ARGUMENT);
+  ASSERT_NE(status.message().find(
+                "fts_query_cache_bytes must not exceed memory_limit_bytes"),
+            std::string::npos);
 }
 
 TEST_F(ConfigTest, ValidateConfigWithInvalidFileLogSettings) {
@@ -25,6 +25,12 @@
 #if defined(__SSE4_1__)
 #include "db/index/column/fts_column/posting/bitpacked_simd_sse41.h"
 #endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#include <ailego/internal/cpu_features.h>
+#include "db/index/column/fts_column/posting/bitpacked_simd_avx512.h"
+#define FTS_TEST_AVX512 1
+#endif
 
 using namespace zvec::fts;
 
@@ -213,6 +219,139 @@ TEST_P(BitPackingTest, ScalarLayoutMatchesSimd) {
 }
 #endif  // defined(__SSE4_1__)
 
+#if defined(FTS_TEST_AVX512)
+static bool avx512_available() {
+  const auto &flags = zvec::ailego::internal::CpuFeatures::static_flags_;
+  return flags.AVX512F && simd::avx512_kernels_compiled();
+}
+
+static bool avx512_vbmi_available() {
+  const auto &flags = zvec::ailego::internal::CpuFeatures::static_flags_;
+  return avx512_available() && flags.AVX512BW && flags.AVX512_VBMI &&
+         simd::avx512_vbmi_kernels_compiled();
+}
+
+// Both AVX-512 unpackers must decode the shared on-disk layout.  The packed
+// block sits at an odd offset at the very end of its buffer, as a block of
+// a memory-mapped posting list may.
+TEST_P(BitPackingTest, Avx512UnpackMatchesScalar) {
+  if (!avx512_available()) {
+    GTEST_SKIP() << "AVX-512 not available";
+  }
+  const uint8_t bitwidth = GetParam();
+  const uint32_t count = 128;
+  const uint32_t mask =
+      (bitwidth == 32) ? 0xFFFFFFFFu : ((1u << bitwidth) - 1u);
+
+  std::vector<uint32_t> values(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    values[i] = (i * 2654435761u + 7u) & mask;
+  }
+
+  const size_t packed_size = static_cast<size_t>(bitwidth) * 16;
+  uint8_t scratch[32 * 16];
+  simd::scalar_pack_uint32_128(values.data(), bitwidth, scratch);
+  std::vector<uint8_t> buffer(packed_size + 1);
+  std::memcpy(buffer.data() + 1, scratch, packed_size);
+
+  uint32_t decoded[count];
+  simd::avx512_unpack_uint32_128(buffer.data() + 1, bitwidth, decoded);
+  for (uint32_t i = 0; i < count; ++i) {
+    ASSERT_EQ(decoded[i], values[i]) << "AVX-512F @" << i;
+  }
+  if (avx512_vbmi_available()) {
+    std::fill(decoded, decoded + count, 0xDEADBEEFu);
+    simd::avx512_vbmi_unpack_uint32_128(buffer.data() + 1, bitwidth, decoded);
+    for (uint32_t i = 0; i < count; ++i) {
+      ASSERT_EQ(decoded[i], values[i]) << "AVX-512 VBMI @" << i;
+    }
+  }
+}
+
+// The fused kernels must produce exactly the scalar scores, so a query ranks
+// the same on every CPU.
+TEST_P(BitPackingTest, DecodeScoreKernelsMatchScalar) {
+  const uint8_t bitwidth_tf = GetParam();
+  const uint8_t bitwidth_dl = static_cast<uint8_t>(bitwidth_tf % 24 + 1);
+  const uint32_t count = 128;
+  const uint32_t mask_tf =
+      (bitwidth_tf == 32) ? 0xFFFFFFFFu : ((1u << bitwidth_tf) - 1u);
+  const uint32_t mask_dl = (1u << bitwidth_dl) - 1u;
+
+  std::mt19937 rng(bitwidth_tf);
+  std::vector<uint32_t> tfs(count), doc_lens(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    tfs[i] = std::max(1u, static_cast<uint32_t>(rng()) & mask_tf);
+    doc_lens[i] = static_cast<uint32_t>(rng()) & mask_dl;
+  }
+  alignas(16) uint8_t packed_tfs[32 * 16];
+  alignas(16) uint8_t packed_dls[32 * 16];
+  simd::scalar_pack_uint32_128(tfs.data(), bitwidth_tf, packed_tfs);
+  simd::scalar_pack_uint32_128(doc_lens.data(), bitwidth_dl, packed_dls);
+
+  simd::BM25BlockParams params;
+  params.weight = 1.7f * 3.25f;
+  params.avg_dl = 37.5f;
+
+  float expected[count];
+  simd::scalar_decode_score_128(packed_tfs, bitwidth_tf, packed_dls,
+                                bitwidth_dl, params, expected);
+
+  float actual[count];
+  simd::get_dispatch().decode_score_128(packed_tfs, bitwidth_tf, packed_dls,
+                                        bitwidth_dl, params, actual);
+  EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected)))
+      << "dispatched kernel";
+  if (avx512_available()) {
+    simd::avx512_decode_score_128(packed_tfs, bitwidth_tf, packed_dls,
+                                  bitwidth_dl, params, actual);
+    EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected)))
+        << "AVX-512F kernel";
+  }
+  if (avx512_vbmi_available()) {
+    simd::avx512_vbmi_decode_score_128(packed_tfs, bitwidth_tf, packed_dls,
+                                       bitwidth_dl, params, actual);
+    EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected)))
+        << "AVX-512 VBMI kernel";
+  }
+}
+
+TEST(BitPackingTest, Avx512PrefixSumAndSearchMatchScalar) {
+  if (!avx512_available()) {
+    GTEST_SKIP() << "AVX-512 not available";
+  }
+  const uint32_t count = 128;
+  std::mt19937 rng(7);
+  std::vector<uint32_t> deltas(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    deltas[i] = rng() % 1000;
+  }
+  deltas[0] = 0;
+
+  std::vector<uint32_t> expected(count), actual(count);
+  simd::scalar_prefix_sum_128(deltas.data(), 1000000u, count,
+                              expected.data());
+  simd::avx512_prefix_sum_128(deltas.data(), 1000000u, count,
+                              actual.data());
+  ASSERT_EQ(expected, actual);
+
+  for (uint32_t size : {1u, 15u, 16u, 17u, 100u, 128u}) {
+    for (size_t start : {size_t{0}, size_t{3}, size_t{16}}) {
+      if (start >= size) continue;
+      for (uint32_t target :
+           {0u, expected[0], expected[size / 2], expected[size - 1],
+            expected[size - 1] + 1}) {
+        EXPECT_EQ(simd::avx512_find_first_ge(expected.data(), size, target,
+                                             start),
+                  simd::scalar_find_first_ge(expected.data(), size, target,
+                                             start))
+            << "size=" << size << " start=" << start << " target=" << target;
+      }
+    }
+  }
+}
+#endif  // defined(FTS_TEST_AVX512)
+
 // Test all bitwidths from 1 to 32
 INSTANTIATE_TEST_SUITE_P(AllBitwidths, BitPackingTest,
                          ::testing::Range(static_cast<uint8_t>(1),
@@ -864,3 +1003,58 @@ TEST(BitPackedPostingListTest, AdvanceConsistentWithNextDoc) {
     }
   }
 }
+
+// ============================================================
+// Block scoring: score() vs BM25Scorer
+// ============================================================
+
+TEST(BitPackedPostingListTest, BlockScoresMatchScorer) {
+  BM25Scorer scorer = make_scorer(1000, 50000);
+  const size_t count = 300;  // two full blocks and a tail block
+  std::vector<uint32_t> doc_ids(count), tfs(count), doc_lens(count);
+  std::mt19937 rng(11);
+  uint32_t current = 0;
+  for (size_t i = 0; i < count; ++i) {
+    current += (rng() % 5) + 1;
+    doc_ids[i] = current;
+    tfs[i] = (rng() % 20) + 1;
+    doc_lens[i] = (rng() % 500) + 1;
+  }
+  std::string encoded = BitPackedPostingList::encode(
+      doc_ids.data(), tfs.data(), doc_lens.data(), count, count, scorer);
+
+  const float idf = scorer.idf(count);
+  const float boost = 1.5f;
+  simd::BM25BlockParams params;
+  params.weight = boost * idf;
+  params.k1 = scorer.params().k1;
+  params.k1_plus_1 = scorer.params().k1 + 1.0f;
+  params.b = scorer.params().b;
+  params.one_minus_b = 1.0f - scorer.params().b;
+  params.avg_dl = scorer.stats().avg_doc_len();
+
+  BitPackedPostingIterator iter;
+  ASSERT_EQ(iter.open(encoded.data(), encoded.size()), 0);
+  iter.set_score_params(params);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(iter.next_doc(), doc_ids[i]);
+    EXPECT_FLOAT_EQ(iter.score(),
+                    scorer.score_with_idf(idf, tfs[i], doc_lens[i], boost))
+        << "i=" << i;
+  }
+
+  // Seeking into a block and re-scoring after new params.
+  BitPackedPostingIterator seek;
+  ASSERT_EQ(seek.open(encoded.data(), encoded.size()), 0);
+  seek.set_score_params(params);
+  ASSERT_EQ(seek.advance(doc_ids[200]), doc_ids[200]);
+  EXPECT_FLOAT_EQ(seek.score(),
+                  scorer.score_with_idf(idf, tfs[200], doc_lens[200], boost));
+  params.weight = idf;
+  seek.set_score_params(params);
+  EXPECT_FLOAT_EQ(seek.score(),
+                  scorer.score_with_idf(idf, tfs[200], doc_lens[200]));
+  ASSERT_EQ(seek.advance(doc_ids[290]), doc_ids[290]);
+  EXPECT_FLOAT_EQ(seek.score(),
+                  scorer.score_with_idf(idf, tfs[290], doc_lens[290]));
+}
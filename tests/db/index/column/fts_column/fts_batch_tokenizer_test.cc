@@ -0,0 +1,146 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/index/column/fts_column/fts_batch_tokenizer.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <zvec/db/index_params.h>
+#include "db/index/column/fts_column/tokenizer/tokenizer_factory.h"
+
+using namespace zvec;
+using namespace zvec::fts;
+
+namespace {
+
+FieldSchema::Ptr make_fts_field(const std::string &name) {
+  return std::make_shared<FieldSchema>(
+      name, DataType::STRING, true,
+      std::make_shared<zvec::FtsIndexParams>("whitespace"));
+}
+
+TokenizerPipelinePtr make_whitespace_pipeline() {
+  fts::FtsIndexParams params;
+  params.tokenizer_name = "whitespace";
+  params.filters = {"lowercase"};
+  return TokenizerFactory::create(params).value();
+}
+
+void expect_same_tokens(const TokenizedText &actual,
+                        const std::vector<Token> &expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(actual.term(i), expected[i].text);
+    EXPECT_EQ(actual.position(i), expected[i].position);
+  }
+}
+
+std::vector<Doc> make_docs(size_t count) {
+  std::vector<Doc> docs(count);
+  for (size_t i = 0; i < count; ++i) {
+    docs[i].set_pk("pk_" + std::to_string(i));
+    std::string title = "Doc " + std::to_string(i);
+    std::string body;
+    // Uneven document sizes so workers pick up different amounts of work.
+    for (size_t w = 0; w <= i % 17; ++w) {
+      body += "Word" + std::to_string(w * i) + " ";
+    }
+    docs[i].set<std::string>("title", title);
+    if (i % 3 != 0) {
+      docs[i].set<std::string>("body", body);
+    }
+  }
+  return docs;
+}
+
+}  // namespace
+
+TEST(FtsBatchTokenizerTest, TokenizedTextKeepsTermsAndPositions) {
+  std::vector<Token> tokens = {{"alpha", 0, 0}, {"", 6, 1}, {"gamma", 7, 4}};
+  TokenizedText text(tokens);
+  expect_same_tokens(text, tokens);
+  EXPECT_TRUE(TokenizedText().empty());
+}
+
+// The pooled path must produce exactly what the field pipeline produces for
+// every document, in batch order, and leave fields without a value out.
+TEST(FtsBatchTokenizerTest, PooledBatchMatchesPipelineOutput) {
+  FieldSchemaPtrList fields = {make_fts_field("title"), make_fts_field("body")};
+  auto docs = make_docs(200);
+  auto pipeline = make_whitespace_pipeline();
+
+  ailego::ThreadPool pool(4, false);
+  std::vector<FtsTokenizedFields> tokenized;
+  ASSERT_TRUE(tokenize_fts_batch(fields, docs, &pool, &tokenized).ok());
+  ASSERT_EQ(tokenized.size(), docs.size());
+
+  for (size_t i = 0; i < docs.size(); ++i) {
+    auto title = tokenized[i].find("title");
+    ASSERT_NE(title, tokenized[i].end());
+    expect_same_tokens(
+        title->second,
+        pipeline->process(docs[i].get<std::string>("title").value()));
+
+    auto body = tokenized[i].find("body");
+    if (i % 3 == 0) {
+      EXPECT_EQ(body, tokenized[i].end());
+    } else {
+      ASSERT_NE(body, tokenized[i].end());
+      expect_same_tokens(
+          body->second,
+          pipeline->process(docs[i].get<std::string>("body").value()));
+    }
+  }
+}
+
+TEST(FtsBatchTokenizerTest, InlineAndPooledResultsAgree) {
+  FieldSchemaPtrList fields = {make_fts_field("title"), make_fts_field("body")};
+  auto docs = make_docs(64);
+
+  std::vector<FtsTokenizedFields> inline_result;
+  ASSERT_TRUE(tokenize_fts_batch(fields, docs, nullptr, &inline_result).ok());
+
+  ailego::ThreadPool pool(3, false);
+  std::vector<FtsTokenizedFields> pooled_result;
+  ASSERT_TRUE(tokenize_fts_batch(fields, docs, &pool, &pooled_result).ok());
+
+  ASSERT_EQ(inline_result.size(), pooled_result.size());
+  for (size_t i = 0; i < docs.size(); ++i) {
+    ASSERT_EQ(inline_result[i].size(), pooled_result[i].size());
+    for (const auto &[name, text] : inline_result[i]) {
+      const auto &other = pooled_result[i].at(name);
+      ASSERT_EQ(text.size(), other.size());
+      for (size_t t = 0; t < text.size(); ++t) {
+        EXPECT_EQ(text.term(t), other.term(t));
+        EXPECT_EQ(text.position(t), other.position(t));
+      }
+    }
+  }
+}
+
+TEST(FtsBatchTokenizerTest, NoFtsFieldsProducesNoOutput) {
+  auto docs = make_docs(4);
+  std::vector<FtsTokenizedFields> tokenized(1);
+  ASSERT_TRUE(tokenize_fts_batch({}, docs, nullptr, &tokenized).ok());
+  EXPECT_TRUE(tokenized.empty());
+}
+
+TEST(FtsBatchTokenizerTest, FieldWithoutFtsParamsIsRejected) {
+  FieldSchemaPtrList fields = {
+      std::make_shared<FieldSchema>("title", DataType::STRING)};
+  auto docs = make_docs(2);
+  std::vector<FtsTokenizedFields> tokenized;
+  EXPECT_FALSE(tokenize_fts_batch(fields, docs, nullptr, &tokenized).ok());
+}
@@ -0,0 +1,223 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <gtest/gtest.h>
+#include <zvec/db/index_params.h>
+#include "db/common/constants.h"
+#include "db/common/file_helper.h"
+#include "db/index/column/fts_column/fts_ast_rewriter.h"
+#include "db/index/column/fts_column/fts_column_indexer.h"
+#include "db/index/column/fts_column/fts_rocksdb_merge.h"
+#include "db/index/column/fts_column/parser/fts_query_parser.h"
+#include "db/index/column/fts_column/tokenizer/tokenizer_factory.h"
+
+using namespace zvec;
+using namespace zvec::fts;
+
+namespace {
+
+const std::string kStatsDir{"./test_fts_collection_stats"};
+const std::string kField{"content"};
+
+// One FTS column in its own RocksDB, standing in for one segment.
+struct SegmentColumn {
+  RocksdbContext db;
+  FtsColumnIndexer indexer;
+
+  void open(const std::string &path) {
+    std::vector<std::string> cf_names = {kField,
+                                         kField + zvec::kFtsPositionsSuffix,
+                                         kField + zvec::kFtsTfSuffix,
+                                         kField + zvec::kFtsMaxTfSuffix,
+                                         kField + zvec::kFtsDocLenSuffix,
+                                         zvec::kFtsStatCfName};
+    std::unordered_map<std::string, std::shared_ptr<rocksdb::MergeOperator>>
+        per_cf_ops = {
+            {kField, std::make_shared<FtsPostingsMerge>()},
+            {kField + zvec::kFtsMaxTfSuffix,
+             std::make_shared<FtsMaxTfMerge>()},
+        };
+    ASSERT_TRUE(
+        db.create(RocksdbContext::Args{path, cf_names, nullptr, per_cf_ops})
+            .ok());
+    auto fts_params = std::make_shared<zvec::FtsIndexParams>("whitespace");
+    auto field_meta = std::make_shared<FieldSchema>(kField, DataType::STRING,
+                                                    false, fts_params);
+    ASSERT_TRUE(indexer
+                    .open(field_meta, &db, db.get_cf(cf_names[0]),
+                          db.get_cf(cf_names[1]), db.get_cf(cf_names[2]),
+                          db.get_cf(cf_names[3]), db.get_cf(cf_names[4]),
+                          db.get_cf(cf_names[5]))
+                    .has_value());
+  }
+
+  void seal() {
+    ASSERT_TRUE(indexer.flush().has_value());
+    ASSERT_TRUE(indexer.convert_postings_to_bitpacked().has_value());
+  }
+
+  void close() {
+    (void)indexer.close();
+    db.close();
+  }
+};
+
+FtsAstNodePtr parse_query(const std::string &query) {
+  zvec::fts::FtsIndexParams params;
+  params.tokenizer_name = "whitespace";
+  params.filters = {"lowercase"};
+  auto pipeline = TokenizerFactory::create(params).value();
+  FtsQueryParser parser;
+  auto ast = parser.parse(query, pipeline);
+  EXPECT_TRUE(ast) << query;
+  if (ast) {
+    simplify(ast);
+  }
+  return ast;
+}
+
+// Skewed corpus: "alpha" is common in the first half and rare in the
+// second, so per-segment IDFs disagree with the collection's.
+std::string make_doc(uint32_t i, uint32_t num_docs) {
+  static const std::vector<std::string> kWords = {
+      "alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta"};
+  const bool first_half = i < num_docs / 2;
+  std::string doc;
+  const uint32_t len = 3 + (i * 7) % 11;
+  for (uint32_t k = 0; k < len; ++k) {
+    uint32_t w = (i * 31 + k * 17) % kWords.size();
+    if (!first_half && w == 0 && (i + k) % 5 != 0) {
+      w = 1;
+    }
+    doc += kWords[w] + " ";
+  }
+  if (first_half && i % 3 == 0) {
+    doc += "alpha alpha";
+  }
+  return doc;
+}
+
+std::vector<float> top_scores(std::vector<FtsResult> results, uint32_t topk) {
+  std::vector<float> scores;
+  for (const auto &r : results) {
+    scores.push_back(r.score);
+  }
+  std::sort(scores.rbegin(), scores.rend());
+  if (scores.size() > topk) {
+    scores.resize(topk);
+  }
+  return scores;
+}
+
+}  // namespace
+
+class FtsCollectionStatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    zvec::FileHelper::RemoveDirectory(kStatsDir);
+    ASSERT_TRUE(zvec::FileHelper::CreateDirectory(kStatsDir));
+  }
+
+  void TearDown() override {
+    zvec::FileHelper::RemoveDirectory(kStatsDir);
+  }
+};
+
+TEST_F(FtsCollectionStatsTest, TopkThresholdOnlyRises) {
+  FtsTopkThreshold threshold;
+  EXPECT_EQ(threshold.load(), 0.0f);
+  threshold.raise(2.5f);
+  threshold.raise(1.0f);
+  EXPECT_EQ(threshold.load(), 2.5f);
+  threshold.raise(3.0f);
+  EXPECT_EQ(threshold.load(), 3.0f);
+}
+
+// Two segments searched with collection stats and a shared threshold must
+// return the same merged top-k scores as one segment holding every doc,
+// both while the segments are writing and once they are sealed.
+TEST_F(FtsCollectionStatsTest, SegmentsScoreLikeOneSegment) {
+  constexpr uint32_t kNumDocs = 600;
+  constexpr uint32_t kTopk = 10;
+  SegmentColumn whole;
+  SegmentColumn first;
+  SegmentColumn second;
+  whole.open(kStatsDir + "/whole");
+  first.open(kStatsDir + "/first");
+  second.open(kStatsDir + "/second");
+  for (uint32_t i = 0; i < kNumDocs; ++i) {
+    const std::string doc = make_doc(i, kNumDocs);
+    ASSERT_TRUE(whole.indexer.insert(i, doc).has_value());
+    auto &part = i < kNumDocs / 2 ? first : second;
+    ASSERT_TRUE(part.indexer.insert(i % (kNumDocs / 2), doc).has_value());
+  }
+
+  const std::vector<std::string> queries = {
+      "alpha", "alpha beta", "alpha OR theta", "+alpha gamma",
+      "\"alpha alpha\"", "delta eta zeta"};
+
+  auto check = [&]() {
+    for (const auto &query : queries) {
+      auto ast = parse_query(query);
+      ASSERT_TRUE(ast);
+
+      FtsQueryParams whole_params;
+      whole_params.topk = kTopk;
+      auto expected = whole.indexer.search(*ast, whole_params);
+      ASSERT_TRUE(expected.has_value()) << query;
+
+      auto stats = std::make_shared<FtsCollectionStats>();
+      first.indexer.collect_stats(*ast, stats.get());
+      second.indexer.collect_stats(*ast, stats.get());
+      EXPECT_EQ(stats->total_docs, whole.indexer.total_docs());
+      EXPECT_EQ(stats->total_tokens, whole.indexer.total_tokens());
+
+      FtsQueryParams params;
+      params.topk = kTopk;
+      params.collection_stats = stats;
+      params.topk_threshold = std::make_shared<FtsTopkThreshold>();
+      std::vector<FtsResult> merged;
+      for (auto *part : {&first, &second}) {
+        auto results = part->indexer.search(*ast, params);
+        ASSERT_TRUE(results.has_value()) << query;
+        merged.insert(merged.end(), results.value().begin(),
+                      results.value().end());
+      }
+
+      auto expected_scores = top_scores(expected.value(), kTopk);
+      auto actual_scores = top_scores(merged, kTopk);
+      ASSERT_EQ(actual_scores.size(), expected_scores.size()) << query;
+      for (size_t i = 0; i < actual_scores.size(); ++i) {
+        EXPECT_NEAR(actual_scores[i], expected_scores[i],
+                    1e-4f * expected_scores[i])
+            << query << " rank " << i;
+      }
+    }
+  };
+
+  check();
+  whole.seal();
+  first.seal();
+  second.seal();
+  check();
+
+  whole.close();
+  first.close();
+  second.close();
+}
@@ -401,6 +401,158 @@ TEST_F(FtsColumnIndexerTest, SearchPhraseHighFrequencyLeadingTerm) {
   EXPECT_EQ(ids[1], 1ull);
 }
 
+// Slop allows position moves the way Lucene counts them: a gap of k words
+// costs k, and swapping two adjacent terms costs 2.
+TEST_F(FtsColumnIndexerTest, SearchSloppyPhrase) {
+  auto indexer = make_indexer();
+  EXPECT_TRUE(indexer->insert(0, "quick brown fox").has_value());
+  EXPECT_TRUE(indexer->insert(1, "quick red brown fox").has_value());
+  EXPECT_TRUE(indexer->insert(2, "fox quick").has_value());
+  EXPECT_TRUE(indexer->insert(3, "quick").has_value());
+
+  auto matched = [&](const std::string &query) {
+    std::vector<FtsResult> results;
+    EXPECT_TRUE(search_ok(*indexer, query, 10, &results)) << query;
+    std::vector<uint64_t> ids;
+    for (const auto &r : results) {
+      ids.push_back(r.doc_id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  EXPECT_TRUE(matched("\"quick fox\"").empty());
+  EXPECT_EQ(matched("\"quick fox\"~1"), std::vector<uint64_t>({0}));
+  EXPECT_EQ(matched("\"quick fox\"~2"), std::vector<uint64_t>({0, 1, 2}));
+  EXPECT_EQ(matched("\"quick brown fox\"~1"), std::vector<uint64_t>({0, 1}));
+}
+
+// Configured shingles add one term per adjacent pair without touching
+// document lengths; phrases must return the same docs through the shingle
+// shortcut (two terms), as a prefilter (longer phrases), and after flush.
+TEST_F(FtsColumnIndexerTest, SearchPhraseWithShingles) {
+  auto fts_params = std::make_shared<zvec::FtsIndexParams>(
+      "whitespace", std::vector<std::string>{"lowercase"},
+      R"({"phrase_shingles": ["Machine Learning", "solo", "a b c"]})");
+  auto indexer = std::make_unique<FtsColumnIndexer>();
+  ASSERT_TRUE(indexer
+                  ->open(make_test_field_meta("content", fts_params), &db_,
+                         postings_cf_, positions_cf_, term_freq_cf_,
+                         max_tf_cf_, doc_len_cf_, stat_cf_)
+                  .has_value());
+  EXPECT_TRUE(indexer->insert(0, "machine learning model").has_value());
+  EXPECT_TRUE(indexer->insert(1, "learning machine translation").has_value());
+  EXPECT_TRUE(indexer->insert(2, "Machine Learning").has_value());
+  EXPECT_TRUE(indexer->insert(3, "machine learning machine model").has_value());
+  EXPECT_EQ(indexer->total_tokens(), 12u);
+
+  auto matched = [&](const std::string &query) {
+    std::vector<FtsResult> results;
+    EXPECT_TRUE(search_ok(*indexer, query, 10, &results)) << query;
+    std::vector<uint64_t> ids;
+    for (const auto &r : results) {
+      ids.push_back(r.doc_id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  auto check = [&]() {
+    EXPECT_EQ(matched("\"machine learning\""),
+              std::vector<uint64_t>({0, 2, 3}));
+    EXPECT_EQ(matched("\"machine learning model\""),
+              std::vector<uint64_t>({0}));
+    EXPECT_EQ(matched("\"learning machine\""), std::vector<uint64_t>({1, 3}));
+    EXPECT_EQ(matched("\"machine learning\"~2"),
+              std::vector<uint64_t>({0, 1, 2, 3}));
+  };
+  check();
+  ASSERT_TRUE(indexer->flush().has_value());
+  ASSERT_TRUE(indexer->convert_postings_to_bitpacked().has_value());
+  check();
+}
+
+// A shingle configured after docs were indexed has no posting for them:
+// phrases over it must verify positions instead of requiring the shingle,
+// and the segment keeps treating it as incomplete after it is reopened.
+TEST_F(FtsColumnIndexerTest, SearchPhraseWithShinglesAddedLater) {
+  auto fts_params = std::make_shared<zvec::FtsIndexParams>(
+      "whitespace", std::vector<std::string>{"lowercase"},
+      R"({"phrase_shingles": ["machine learning"]})");
+  auto open_with_shingles = [&]() {
+    auto indexer = std::make_unique<FtsColumnIndexer>();
+    EXPECT_TRUE(indexer
+                    ->open(make_test_field_meta("content", fts_params), &db_,
+                           postings_cf_, positions_cf_, term_freq_cf_,
+                           max_tf_cf_, doc_len_cf_, stat_cf_)
+                    .has_value());
+    return indexer;
+  };
+  {
+    auto indexer = make_indexer("content");
+    EXPECT_TRUE(indexer->insert(0, "machine learning model").has_value());
+    EXPECT_TRUE(indexer->flush().has_value());
+  }
+
+  auto indexer = open_with_shingles();
+  EXPECT_TRUE(indexer->complete_phrase_shingles().empty());
+  EXPECT_TRUE(indexer->insert(1, "machine learning").has_value());
+  EXPECT_TRUE(indexer->insert(2, "learning machine").has_value());
+
+  auto matched = [&](const std::string &query) {
+    std::vector<FtsResult> results;
+    EXPECT_TRUE(search_ok(*indexer, query, 10, &results)) << query;
+    std::vector<uint64_t> ids;
+    for (const auto &r : results) {
+      ids.push_back(r.doc_id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  auto check = [&]() {
+    EXPECT_EQ(matched("\"machine learning\""), std::vector<uint64_t>({0, 1}));
+    EXPECT_EQ(matched("\"machine learning model\""),
+              std::vector<uint64_t>({0}));
+  };
+  check();
+  ASSERT_TRUE(indexer->flush().has_value());
+  indexer.reset();
+  indexer = open_with_shingles();
+  EXPECT_TRUE(indexer->complete_phrase_shingles().empty());
+  check();
+  ASSERT_TRUE(indexer->convert_postings_to_bitpacked().has_value());
+  check();
+}
+
+// A segment that starts empty indexes its configured shingles for every doc
+// and records them, so they still filter phrases after a reopen.
+TEST_F(FtsColumnIndexerTest, PhraseShinglesPersistWithSegmentStats) {
+  auto fts_params = std::make_shared<zvec::FtsIndexParams>(
+      "whitespace", std::vector<std::string>{"lowercase"},
+      R"({"phrase_shingles": ["machine learning"]})");
+  for (int round = 0; round < 2; ++round) {
+    FtsColumnIndexer indexer;
+    ASSERT_TRUE(indexer
+                    .open(make_test_field_meta("content", fts_params), &db_,
+                          postings_cf_, positions_cf_, term_freq_cf_,
+                          max_tf_cf_, doc_len_cf_, stat_cf_)
+                    .has_value());
+    ASSERT_EQ(indexer.complete_phrase_shingles().size(), 1u) << round;
+    EXPECT_TRUE(indexer.insert(round, "machine learning").has_value());
+    ASSERT_TRUE(indexer.flush().has_value());
+  }
+}
+
+TEST_F(FtsColumnIndexerTest, OpenRejectsMalformedPhraseShingles) {
+  auto fts_params = std::make_shared<zvec::FtsIndexParams>(
+      "whitespace", std::vector<std::string>{"lowercase"},
+      R"({"phrase_shingles": "machine learning"})");
+  FtsColumnIndexer indexer;
+  EXPECT_FALSE(indexer
+                   .open(make_test_field_meta("content", fts_params), &db_,
+                         postings_cf_, positions_cf_, term_freq_cf_,
+                         max_tf_cf_, doc_len_cf_, stat_cf_)
+                   .has_value());
+}
+
 // ============================================================
 // search() - boolean query (AND / OR)
 // ============================================================
@@ -1157,10 +1309,11 @@ TEST_F(FtsColumnIndexerTest, ConvertPostingsToBitpackedClearsSideCfs) {
   }
   EXPECT_TRUE(indexer->flush().has_value());
 
-  // Sanity: side CFs are populated before conversion.
-  EXPECT_GT(count_cf_entries(db_, term_freq_cf_), 0u);
+  // Sanity: flush() persists doc lengths; $TF / $MAX_TF are no longer
+  // written since tf lives in the in-memory buffer and the BitPacked postings.
+  EXPECT_EQ(count_cf_entries(db_, term_freq_cf_), 0u);
   EXPECT_GT(count_cf_entries(db_, doc_len_cf_), 0u);
-  EXPECT_GT(count_cf_entries(db_, max_tf_cf_), 0u);
+  EXPECT_EQ(count_cf_entries(db_, max_tf_cf_), 0u);
 
   EXPECT_TRUE(indexer->convert_postings_to_bitpacked().has_value());
 
@@ -1255,6 +1408,127 @@ TEST_F(FtsColumnIndexerTest, SearchAfterConvertPostingsToBitpacked) {
   EXPECT_EQ(ids[1], 2ull);
 }
 
+// ============================================================
+// In-memory posting buffer (writing segment)
+// ============================================================
+
+// insert() only touches the in-memory buffer: nothing reaches RocksDB until
+// flush(), yet the writing indexer can already search (terms and phrases).
+TEST_F(FtsColumnIndexerTest, InsertBuffersPostingsUntilFlush) {
+  auto indexer = make_indexer("content");
+  EXPECT_TRUE(indexer->insert(0, "machine learning model").has_value());
+  EXPECT_TRUE(indexer->insert(1, "learning machine").has_value());
+
+  EXPECT_EQ(count_cf_entries(db_, postings_cf_), 0u);
+  EXPECT_EQ(count_cf_entries(db_, positions_cf_), 0u);
+  EXPECT_EQ(count_cf_entries(db_, doc_len_cf_), 0u);
+
+  std::vector<FtsResult> results;
+  EXPECT_TRUE(search_ok(*indexer, "learning", 10, &results));
+  EXPECT_EQ(results.size(), 2u);
+  EXPECT_TRUE(search_ok(*indexer, "\"machine learning\"", 10, &results));
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0].doc_id, 0ull);
+
+  EXPECT_TRUE(indexer->flush().has_value());
+  // One $POS entry per (term, doc); postings wait for the seal.
+  EXPECT_EQ(count_cf_entries(db_, postings_cf_), 0u);
+  EXPECT_EQ(count_cf_entries(db_, positions_cf_), 5u);
+  EXPECT_EQ(count_cf_entries(db_, doc_len_cf_), 2u);
+
+  // Each flush appends only the new entries; an idle flush is a no-op.
+  EXPECT_TRUE(indexer->insert(2, "model").has_value());
+  EXPECT_TRUE(indexer->flush().has_value());
+  EXPECT_TRUE(indexer->flush().has_value());
+  EXPECT_EQ(count_cf_entries(db_, positions_cf_), 6u);
+  EXPECT_EQ(count_cf_entries(db_, doc_len_cf_), 3u);
+
+  // One BitPacked posting per distinct term.
+  EXPECT_TRUE(indexer->convert_postings_to_bitpacked().has_value());
+  EXPECT_EQ(count_postings_entries_and_check_bitpacked(db_, postings_cf_), 3u);
+}
+
+// Documents must arrive in ascending doc_id order so every buffered posting
+// stays sorted; an out-of-order insert is rejected without side effects.
+TEST_F(FtsColumnIndexerTest, InsertRejectsNonAscendingDocId) {
+  auto indexer = make_indexer("content");
+  EXPECT_TRUE(indexer->insert(3, "hello").has_value());
+  EXPECT_FALSE(indexer->insert(3, "hello again").has_value());
+  EXPECT_FALSE(indexer->insert(1, "hello").has_value());
+  EXPECT_EQ(indexer->total_docs(), 1u);
+
+  std::vector<FtsResult> results;
+  EXPECT_TRUE(search_ok(*indexer, "hello", 10, &results));
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0].doc_id, 3ull);
+}
+
+// A document tokenized ahead of time (the batched ingest path) is indexed
+// exactly like the same text passed to insert(text).
+TEST_F(FtsColumnIndexerTest, InsertPreTokenizedMatchesTextInsert) {
+  auto indexer = make_indexer("content");
+  auto pipeline = make_whitespace_pipeline();
+  EXPECT_TRUE(indexer->insert(0, "machine learning model").has_value());
+  EXPECT_TRUE(
+      indexer->insert(1, TokenizedText(pipeline->process("Learning Machine")))
+          .has_value());
+  EXPECT_EQ(indexer->total_docs(), 2u);
+  EXPECT_EQ(indexer->total_tokens(), 5u);
+
+  std::vector<FtsResult> results;
+  EXPECT_TRUE(search_ok(*indexer, "learning", 10, &results));
+  EXPECT_EQ(results.size(), 2u);
+  EXPECT_TRUE(search_ok(*indexer, "\"learning machine\"", 10, &results));
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0].doc_id, 1ull);
+}
+
+// Reopening a writing segment rebuilds the buffer from the flushed $POS and
+// $DOC_LEN entries; later inserts and flushes extend the restored postings.
+TEST_F(FtsColumnIndexerTest, ReopenRestoresBufferedPostings) {
+  {
+    auto indexer = make_indexer("content");
+    EXPECT_TRUE(indexer->insert(0, "alpha beta").has_value());
+    EXPECT_TRUE(indexer->flush().has_value());
+    EXPECT_TRUE(indexer->insert(1, "alpha gamma alpha").has_value());
+    EXPECT_TRUE(indexer->flush().has_value());
+  }
+
+  auto indexer = make_indexer("content");
+  EXPECT_EQ(indexer->total_docs(), 2u);
+  EXPECT_FALSE(indexer->insert(1, "duplicate").has_value());
+  EXPECT_TRUE(indexer->insert(2, "beta alpha").has_value());
+
+  std::vector<FtsResult> results;
+  EXPECT_TRUE(search_ok(*indexer, "alpha", 10, &results));
+  EXPECT_EQ(results.size(), 3u);
+  EXPECT_TRUE(search_ok(*indexer, "\"alpha gamma\"", 10, &results));
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0].doc_id, 1ull);
+
+  EXPECT_TRUE(indexer->flush().has_value());
+  EXPECT_TRUE(indexer->convert_postings_to_bitpacked().has_value());
+
+  std::string raw;
+  ASSERT_TRUE(db_.db_->Get(db_.read_opts_, postings_cf_, "alpha", &raw).ok());
+  BitPackedPostingIterator iter;
+  ASSERT_EQ(iter.open(raw.data(), raw.size()), 0);
+  std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> decoded;
+  for (uint32_t did = iter.next_doc();
+       did != BitPackedPostingIterator::NO_MORE_DOCS; did = iter.next_doc()) {
+    decoded.emplace_back(did, iter.term_freq(), iter.doc_len());
+  }
+  ASSERT_EQ(decoded.size(), 3u);
+  EXPECT_EQ(decoded[0], std::make_tuple(0u, 1u, 2u));
+  EXPECT_EQ(decoded[1], std::make_tuple(1u, 2u, 3u));
+  EXPECT_EQ(decoded[2], std::make_tuple(2u, 1u, 2u));
+
+  // Sealed: the buffer is released and search reads postings_cf.
+  EXPECT_FALSE(indexer->insert(3, "alpha").has_value());
+  EXPECT_TRUE(search_ok(*indexer, "alpha", 10, &results));
+  EXPECT_EQ(results.size(), 3u);
+}
+
 // ============================================================
 // Multi-column shared RocksDB tests
 //
@@ -0,0 +1,350 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/index/column/fts_column/fts_impact_search.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "db/common/file_helper.h"
+#include "db/index/column/fts_column/bm25_scorer.h"
+#include "db/index/column/fts_column/posting/bitpacked_posting_list.h"
+
+using namespace zvec;
+using namespace zvec::fts;
+
+namespace {
+
+const std::string kImpactDir{"./test_fts_impacts"};
+const std::vector<std::string> kVocab = {"alpha", "beta", "gamma", "delta"};
+
+// Random corpus with skewed term frequencies and doc lengths, sealed with
+// impacts.  Terms occur in a doc with decreasing probability.
+class FtsImpactSearchTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kNumDocs = 5000;
+
+  void SetUp() override {
+    zvec::FileHelper::RemoveDirectory(kImpactDir);
+    ASSERT_TRUE(zvec::FileHelper::CreateDirectory(kImpactDir));
+
+    std::mt19937 rng(7);
+    doc_lens_.resize(kNumDocs);
+    uint64_t total_tokens = 0;
+    for (uint32_t doc_id = 0; doc_id < kNumDocs; ++doc_id) {
+      doc_lens_[doc_id] = 5 + rng() % 200;
+      total_tokens += doc_lens_[doc_id];
+      for (size_t t = 0; t < kVocab.size(); ++t) {
+        if (rng() % (t + 2) == 0) {
+          tfs_[kVocab[t]][doc_id] = 1 + rng() % (1 + doc_lens_[doc_id] / 10);
+        }
+      }
+    }
+    scorer_.update_stats(kNumDocs, total_tokens);
+
+    FtsSealedPostings::Writer writer(kImpactDir, "content");
+    writer.enable_impacts(&scorer_);
+    ASSERT_TRUE(writer.open().ok());
+    for (const auto &[term, docs] : tfs_) {
+      std::vector<uint32_t> doc_ids, tfs, doc_lens;
+      for (const auto &[doc_id, tf] : docs) {
+        doc_ids.push_back(doc_id);
+        tfs.push_back(tf);
+        doc_lens.push_back(doc_lens_[doc_id]);
+      }
+      ASSERT_TRUE(writer
+                      .add_term(term, BitPackedPostingList::encode(
+                                          doc_ids.data(), tfs.data(),
+                                          doc_lens.data(), doc_ids.size(),
+                                          doc_ids.size(), scorer_))
+                      .ok());
+    }
+    ASSERT_TRUE(writer.finish().ok());
+    sealed_ = FtsSealedPostings::Open(kImpactDir, "content");
+    ASSERT_NE(sealed_, nullptr);
+  }
+
+  void TearDown() override {
+    sealed_.reset();
+    zvec::FileHelper::RemoveDirectory(kImpactDir);
+  }
+
+  std::vector<ImpactSearchTerm> search_terms(
+      const std::vector<std::string> &terms) const {
+    const float impact_weight =
+        (scorer_.params().k1 + 1.0f) / FtsSealedPostings::kMaxImpact;
+    std::vector<ImpactSearchTerm> result;
+    for (const auto &term : terms) {
+      ImpactSearchTerm search_term;
+      search_term.impacts = sealed_->get_impacts(term);
+      search_term.unit_score =
+          scorer_.idf(tfs_.at(term).size()) * impact_weight;
+      result.push_back(search_term);
+    }
+    return result;
+  }
+
+  float exact_score(const std::vector<std::string> &terms,
+                    uint32_t doc_id) const {
+    float score = 0.0f;
+    for (const auto &term : terms) {
+      const auto &docs = tfs_.at(term);
+      auto it = docs.find(doc_id);
+      if (it != docs.end()) {
+        score += scorer_.score(docs.size(), it->second, doc_lens_[doc_id]);
+      }
+    }
+    return score;
+  }
+
+  // The topk best exact scores over all docs, descending.
+  std::vector<float> exact_topk(const std::vector<std::string> &terms,
+                                uint32_t topk) const {
+    std::vector<float> scores;
+    for (uint32_t doc_id = 0; doc_id < kNumDocs; ++doc_id) {
+      const float score = exact_score(terms, doc_id);
+      if (score > 0.0f) {
+        scores.push_back(score);
+      }
+    }
+    std::sort(scores.begin(), scores.end(), std::greater<float>());
+    scores.resize(std::min<size_t>(scores.size(), topk));
+    return scores;
+  }
+
+  // The topk best exact scores among \p candidates, descending.
+  std::vector<float> rescore(const std::vector<std::string> &terms,
+                             const std::vector<uint64_t> &candidates,
+                             uint32_t topk) const {
+    std::vector<float> scores;
+    for (uint64_t doc_id : candidates) {
+      scores.push_back(exact_score(terms, static_cast<uint32_t>(doc_id)));
+    }
+    std::sort(scores.begin(), scores.end(), std::greater<float>());
+    scores.resize(std::min<size_t>(scores.size(), topk));
+    return scores;
+  }
+
+  BM25Scorer scorer_;
+  std::vector<uint32_t> doc_lens_;
+  std::map<std::string, std::map<uint32_t, uint32_t>> tfs_;
+  FtsSealedPostings::Ptr sealed_;
+};
+
+}  // namespace
+
+// Every posting lands in exactly one segment, under the ceil-quantized
+// BM25 weight of its tf and doc_len; segments descend by impact.
+TEST_F(FtsImpactSearchTest, ImpactsGroupDocsByImpact) {
+  ASSERT_TRUE(sealed_->has_impacts());
+  EXPECT_TRUE(sealed_->get_impacts("missing").empty());
+
+  const float scale =
+      FtsSealedPostings::kMaxImpact / (scorer_.params().k1 + 1.0f);
+  alignas(16) uint32_t doc_ids[FtsSealedPostings::kPositionBlockSize];
+  for (const auto &[term, docs] : tfs_) {
+    auto impacts = sealed_->get_impacts(term);
+    ASSERT_FALSE(impacts.empty()) << term;
+    EXPECT_EQ(impacts.max_doc_id(), docs.rbegin()->first) << term;
+
+    std::set<uint32_t> seen;
+    uint32_t last_impact = FtsSealedPostings::kMaxImpact + 1;
+    for (uint32_t s = 0; s < impacts.num_segments(); ++s) {
+      const auto segment = impacts.segment(s);
+      EXPECT_LT(segment.impact, last_impact) << term;
+      last_impact = segment.impact;
+
+      auto blocks = impacts.docs(s);
+      uint32_t num_docs = 0;
+      int64_t last_doc_id = -1;
+      for (uint32_t n = blocks.next(doc_ids); n > 0;
+           n = blocks.next(doc_ids)) {
+        for (uint32_t j = 0; j < n; ++j) {
+          const uint32_t doc_id = doc_ids[j];
+          EXPECT_GT(int64_t{doc_id}, last_doc_id) << term;
+          last_doc_id = doc_id;
+          ASSERT_TRUE(docs.count(doc_id)) << term << " " << doc_id;
+          EXPECT_TRUE(seen.insert(doc_id).second) << term << " " << doc_id;
+
+          const float weight = scorer_.score_with_idf(
+              1.0f, docs.at(doc_id), doc_lens_[doc_id]);
+          const auto expected = static_cast<uint32_t>(std::min(
+              std::max(std::ceil(weight * scale), 1.0f),
+              float{FtsSealedPostings::kMaxImpact}));
+          EXPECT_EQ(segment.impact, expected) << term << " " << doc_id;
+        }
+        num_docs += n;
+      }
+      EXPECT_EQ(num_docs, segment.num_docs) << term;
+    }
+    EXPECT_EQ(seen.size(), docs.size()) << term;
+  }
+}
+
+TEST_F(FtsImpactSearchTest, WriterWithoutImpacts) {
+  const std::string dir = kImpactDir + "/plain";
+  ASSERT_TRUE(zvec::FileHelper::CreateDirectory(dir));
+  {
+    FtsSealedPostings::Writer writer(dir, "content");
+    ASSERT_TRUE(writer.open().ok());
+    const uint32_t doc_id = 3, tf = 1, doc_len = 10;
+    ASSERT_TRUE(writer
+                    .add_term("alpha", BitPackedPostingList::encode(
+                                           &doc_id, &tf, &doc_len, 1, 1,
+                                           scorer_))
+                    .ok());
+    ASSERT_TRUE(writer.finish().ok());
+  }
+  auto sealed = FtsSealedPostings::Open(dir, "content");
+  ASSERT_NE(sealed, nullptr);
+  EXPECT_FALSE(sealed->has_impacts());
+  EXPECT_TRUE(sealed->get_impacts("alpha").empty());
+  EXPECT_TRUE(impact_ordered_topk({{sealed->get_impacts("alpha"), 1.0f}},
+                                  ImpactSearchLimits{}, nullptr)
+                  .empty());
+}
+
+// Without limits, rescoring the candidates recovers the exact top-k scores
+// up to the quantization error: each term's impact is off by less than one
+// unit, and its contribution rounds by at most half a unit more.
+TEST_F(FtsImpactSearchTest, ExhaustiveSearchFindsTopkWithinQuantization) {
+  const std::vector<std::vector<std::string>> queries = {
+      {"alpha"},
+      {"delta"},
+      {"alpha", "beta"},
+      {"gamma", "delta"},
+      {"alpha", "beta", "gamma", "delta"},
+  };
+  for (uint32_t topk : {1u, 10u, 100u}) {
+    for (const auto &query : queries) {
+      const auto terms = search_terms(query);
+      float tolerance = 0.0f;
+      for (const auto &term : terms) {
+        tolerance += 2.0f * term.unit_score;
+      }
+      ImpactSearchLimits limits;
+      limits.topk = topk;
+      auto candidates = impact_ordered_topk(terms, limits, nullptr);
+      ASSERT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+      ASSERT_FALSE(candidates.empty());
+
+      const auto expected = exact_topk(query, topk);
+      const auto actual = rescore(query, candidates, topk);
+      ASSERT_EQ(actual.size(), expected.size()) << query[0] << " " << topk;
+      for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_NEAR(actual[i], expected[i], tolerance)
+            << query[0] << " " << topk;
+      }
+    }
+  }
+}
+
+// Docs whose exact scores differ by less than one impact unit quantize to
+// the same impact; the best of them comes last in doc_id order and must
+// still reach the caller's exact rescoring.
+TEST_F(FtsImpactSearchTest, TiesAtKthImpactAllReturned) {
+  const std::string dir = kImpactDir + "/ties";
+  ASSERT_TRUE(zvec::FileHelper::CreateDirectory(dir));
+  constexpr uint32_t kTiedDocs = 64;
+  std::vector<uint32_t> doc_ids(kTiedDocs), tfs(kTiedDocs, 1),
+      doc_lens(kTiedDocs);
+  uint64_t total_tokens = 0;
+  for (uint32_t i = 0; i < kTiedDocs; ++i) {
+    doc_ids[i] = i;
+    // Shorter docs score higher: the last doc is the best one.
+    doc_lens[i] = 100000 - i;
+    total_tokens += doc_lens[i];
+  }
+  BM25Scorer scorer;
+  scorer.update_stats(kTiedDocs, total_tokens);
+  {
+    FtsSealedPostings::Writer writer(dir, "content");
+    writer.enable_impacts(&scorer);
+    ASSERT_TRUE(writer.open().ok());
+    ASSERT_TRUE(writer
+                    .add_term("alpha", BitPackedPostingList::encode(
+                                           doc_ids.data(), tfs.data(),
+                                           doc_lens.data(), kTiedDocs,
+                                           kTiedDocs, scorer))
+                    .ok());
+    ASSERT_TRUE(writer.finish().ok());
+  }
+  auto sealed = FtsSealedPostings::Open(dir, "content");
+  ASSERT_NE(sealed, nullptr);
+  ImpactSearchTerm term;
+  term.impacts = sealed->get_impacts("alpha");
+  ASSERT_EQ(term.impacts.num_segments(), 1u);
+  term.unit_score = scorer.idf(kTiedDocs) * (scorer.params().k1 + 1.0f) /
+                    FtsSealedPostings::kMaxImpact;
+
+  ImpactSearchLimits limits;
+  limits.topk = 4;
+  auto candidates = impact_ordered_topk({term}, limits, nullptr);
+  EXPECT_EQ(candidates.size(), kTiedDocs);
+  EXPECT_TRUE(std::find(candidates.begin(), candidates.end(),
+                        kTiedDocs - 1) != candidates.end());
+}
+
+TEST_F(FtsImpactSearchTest, FilteredDocsNeverReturned) {
+  auto filter = EasyIndexFilter::Create(
+      [](uint64_t doc_id) { return doc_id % 2 == 0; });
+  const std::vector<std::string> query = {"alpha", "gamma"};
+  ImpactSearchLimits limits;
+  limits.topk = 50;
+  auto candidates =
+      impact_ordered_topk(search_terms(query), limits, filter.get());
+  ASSERT_GE(candidates.size(), 50u);
+  for (uint64_t doc_id : candidates) {
+    EXPECT_EQ(doc_id % 2, 1u);
+  }
+}
+
+// A posting limit stops after the first block of the heaviest segment.
+TEST_F(FtsImpactSearchTest, MaxPostingsBoundsWork) {
+  const std::vector<std::string> query = {"alpha", "beta"};
+  auto terms = search_terms(query);
+  ImpactSearchLimits limits;
+  limits.topk = 10;
+  limits.max_postings = 1;
+  auto candidates = impact_ordered_topk(terms, limits, nullptr);
+  ASSERT_FALSE(candidates.empty());
+
+  // Candidates all come from the segment with the largest contribution.
+  const auto &heaviest = *std::max_element(
+      terms.begin(), terms.end(),
+      [](const ImpactSearchTerm &a, const ImpactSearchTerm &b) {
+        return a.impacts.segment(0).impact * a.unit_score <
+               b.impacts.segment(0).impact * b.unit_score;
+      });
+  std::set<uint64_t> first_block;
+  alignas(16) uint32_t doc_ids[FtsSealedPostings::kPositionBlockSize];
+  auto blocks = heaviest.impacts.docs(0);
+  const uint32_t n = blocks.next(doc_ids);
+  first_block.insert(doc_ids, doc_ids + n);
+  for (uint64_t doc_id : candidates) {
+    EXPECT_TRUE(first_block.count(doc_id)) << doc_id;
+  }
+  // They share one quantized score, so all of them are kept for rescoring
+  // rather than the first few in doc_id order.
+  EXPECT_EQ(first_block.size(), candidates.size());
+
+  // An expired time budget still returns the first block's docs.
+  limits.max_postings = 0;
+  limits.budget = std::chrono::microseconds(1);
+  EXPECT_FALSE(impact_ordered_topk(terms, limits, nullptr).empty());
+}
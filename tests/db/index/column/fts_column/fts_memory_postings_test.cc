@@ -0,0 +1,112 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/index/column/fts_column/fts_memory_postings.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "db/index/column/fts_column/iterator/fts_term_iterator.h"
+
+using namespace zvec::fts;
+
+namespace {
+
+TokenizedText make_tokens(const std::vector<std::string> &terms) {
+  TokenizedText tokens;
+  for (size_t i = 0; i < terms.size(); ++i) {
+    tokens.append(terms[i], static_cast<uint32_t>(i));
+  }
+  return tokens;
+}
+
+// Adds \p tokens as the next doc and keeps \p scorer in step, as the indexer
+// does on insert.
+void add_doc(FtsMemoryPostings *postings, BM25Scorer *scorer, uint32_t doc_id,
+             const TokenizedText &tokens) {
+  ASSERT_TRUE(postings->add_document(doc_id, tokens,
+                                     static_cast<uint32_t>(tokens.size())));
+  const auto stats = scorer->stats();
+  scorer->update_stats(stats.total_docs + 1,
+                       stats.total_tokens + tokens.size());
+}
+
+}  // namespace
+
+TEST(FtsMemoryPostingsTest, EncodingReusedUntilTermGainsDoc) {
+  FtsMemoryPostings postings;
+  BM25Scorer scorer;
+  add_doc(&postings, &scorer, 0, make_tokens({"hot", "cold"}));
+  add_doc(&postings, &scorer, 1, make_tokens({"hot"}));
+
+  EXPECT_EQ(postings.encoded_postings("missing", scorer), nullptr);
+  auto first = postings.encoded_postings("hot", scorer);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->num_docs, 2u);
+  EXPECT_EQ(postings.encoded_postings("hot", scorer), first);
+
+  // Other terms changing, and the stats with them, keep the encoding.
+  add_doc(&postings, &scorer, 2, make_tokens({"cold", "cold"}));
+  EXPECT_EQ(postings.encoded_postings("hot", scorer), first);
+  EXPECT_EQ(first->scorer->stats().total_docs, 2u);
+
+  add_doc(&postings, &scorer, 3, make_tokens({"hot"}));
+  auto second = postings.encoded_postings("hot", scorer);
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(second, first);
+  EXPECT_EQ(second->num_docs, 3u);
+  EXPECT_EQ(second->scorer->stats().total_docs, 4u);
+  // A query still holding the old encoding keeps a valid posting.
+  EXPECT_TRUE(BitPackedPostingList::is_bitpacked_format(first->data.data(),
+                                                        first->data.size()));
+}
+
+TEST(FtsMemoryPostingsTest, StaleEncodingBoundsRescaled) {
+  FtsMemoryPostings postings;
+  auto scorer = std::make_shared<BM25Scorer>();
+  for (uint32_t doc_id = 0; doc_id < 300; ++doc_id) {
+    std::vector<std::string> terms(1 + doc_id % 7, "filler");
+    if (doc_id % 3 == 0) {
+      terms[0] = "rare";
+    }
+    add_doc(&postings, scorer.get(), doc_id, make_tokens(terms));
+  }
+  auto encoded = postings.encoded_postings("rare", *scorer);
+  ASSERT_NE(encoded, nullptr);
+
+  // Many docs without the term: its idf and the average doc length grow,
+  // so the cached block-max scores undershoot the current scores.
+  for (uint32_t doc_id = 300; doc_id < 3000; ++doc_id) {
+    std::vector<std::string> terms(20, "filler");
+    add_doc(&postings, scorer.get(), doc_id, make_tokens(terms));
+  }
+  ASSERT_EQ(postings.encoded_postings("rare", *scorer), encoded);
+
+  rocksdb::PinnableSlice raw;
+  *raw.GetSelf() = encoded->data;
+  raw.PinSelf();
+  TermDocIterator iter("rare", std::move(raw), encoded->scorer, 1.0f);
+  iter.use_collection_stats(scorer, iter.cost());
+
+  size_t checked = 0;
+  for (uint32_t doc = iter.next_doc(); doc != DocIterator::NO_MORE_DOCS;
+       doc = iter.next_doc()) {
+    const float score = iter.score();
+    EXPECT_NEAR(score, scorer->score(iter.cost(), 1, 1 + doc % 7), 1e-4f);
+    EXPECT_LE(score, iter.block_max_info_for(doc).block_max_score);
+    EXPECT_LE(score, iter.max_score());
+    ++checked;
+  }
+  EXPECT_EQ(checked, 100u);
+}
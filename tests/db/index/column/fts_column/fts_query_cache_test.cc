@@ -0,0 +1,228 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/index/column/fts_column/fts_query_cache.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace zvec::fts;
+
+namespace {
+
+FtsAstNodePtr make_or(const std::vector<std::string> &terms) {
+  auto node = std::make_unique<OrNode>();
+  for (const auto &term : terms) {
+    node->children.push_back(std::make_unique<TermNode>(term));
+  }
+  return node;
+}
+
+FtsQueryCache::Key make_key(uint64_t scope, const std::string &query,
+                            uint32_t topk = 10) {
+  FtsQueryCache::Key key;
+  key.scope = scope;
+  key.query = query;
+  key.topk = topk;
+  return key;
+}
+
+const FtsQueryCache::Epoch kEpoch{};
+
+std::vector<FtsResult> make_results(size_t n) {
+  std::vector<FtsResult> results;
+  for (size_t i = 0; i < n; ++i) {
+    results.push_back({i, static_cast<float>(n - i)});
+  }
+  return results;
+}
+
+}  // namespace
+
+TEST(FtsQueryCacheTest, QueryKeyIgnoresOperandOrder) {
+  FtsQueryParams params;
+  auto ab = make_or({"alpha", "beta"});
+  auto ba = make_or({"beta", "alpha"});
+  EXPECT_EQ(FtsQueryCache::QueryKey("content", *ab, params),
+            FtsQueryCache::QueryKey("content", *ba, params));
+  EXPECT_NE(FtsQueryCache::QueryKey("content", *ab, params),
+            FtsQueryCache::QueryKey("title", *ab, params));
+}
+
+TEST(FtsQueryCacheTest, QueryKeyCoversEverythingThatShapesResults) {
+  FtsQueryParams params;
+  const TermNode term("alpha");
+  const std::string base = FtsQueryCache::QueryKey("content", term, params);
+
+  TermNode boosted("alpha");
+  boosted.boost = 2.0f;
+  EXPECT_NE(base, FtsQueryCache::QueryKey("content", boosted, params));
+
+  TermNode must("alpha", true);
+  EXPECT_NE(base, FtsQueryCache::QueryKey("content", must, params));
+
+  PhraseNode phrase;
+  phrase.terms = {"alpha", "beta"};
+  const std::string exact = FtsQueryCache::QueryKey("content", phrase, params);
+  phrase.slop = 2;
+  EXPECT_NE(exact, FtsQueryCache::QueryKey("content", phrase, params));
+
+  FtsQueryParams with_stats;
+  auto stats = std::make_shared<FtsCollectionStats>();
+  stats->total_docs = 100;
+  stats->total_tokens = 1000;
+  stats->doc_freqs["alpha"] = 7;
+  with_stats.collection_stats = stats;
+  const std::string stats_key =
+      FtsQueryCache::QueryKey("content", term, with_stats);
+  EXPECT_NE(base, stats_key);
+  // Moving statistics keep the key and change only the epoch.
+  const std::string epoch = FtsQueryCache::StatsEpoch(with_stats);
+  EXPECT_TRUE(FtsQueryCache::StatsEpoch(params).empty());
+  EXPECT_FALSE(epoch.empty());
+  stats->doc_freqs["alpha"] = 8;
+  EXPECT_EQ(stats_key, FtsQueryCache::QueryKey("content", term, with_stats));
+  EXPECT_NE(epoch, FtsQueryCache::StatsEpoch(with_stats));
+
+  FtsQueryParams anytime;
+  anytime.anytime = true;
+  const std::string anytime_key =
+      FtsQueryCache::QueryKey("content", term, anytime);
+  EXPECT_NE(base, anytime_key);
+  anytime.anytime_max_postings = 1000;
+  EXPECT_NE(anytime_key, FtsQueryCache::QueryKey("content", term, anytime));
+}
+
+TEST(FtsQueryCacheTest, GetReturnsWhatPutStored) {
+  FtsQueryCache cache(1 << 20);
+  const uint64_t scope = FtsQueryCache::NewScope();
+  std::vector<FtsResult> results;
+
+  EXPECT_FALSE(cache.get(make_key(scope, "q"), kEpoch, &results));
+  EXPECT_EQ(cache.miss_count(), 1u);
+
+  cache.put(make_key(scope, "q"), kEpoch, make_results(3));
+  ASSERT_TRUE(cache.get(make_key(scope, "q"), kEpoch, &results));
+  ASSERT_EQ(results.size(), 3u);
+  EXPECT_EQ(results[0].doc_id, 0u);
+  EXPECT_FLOAT_EQ(results[0].score, 3.0f);
+  EXPECT_EQ(cache.hit_count(), 1u);
+  EXPECT_EQ(cache.count(), 1u);
+  EXPECT_GT(cache.size_in_bytes(), 3 * sizeof(FtsResult));
+
+  // Every key field distinguishes entries.
+  EXPECT_FALSE(cache.get(make_key(scope, "q", 5), kEpoch, &results));
+  EXPECT_FALSE(cache.get(make_key(scope + 1, "q"), kEpoch, &results));
+  EXPECT_FALSE(cache.get(make_key(scope, "r"), kEpoch, &results));
+
+  // Putting the same key again replaces the entry.
+  cache.put(make_key(scope, "q"), kEpoch, make_results(1));
+  ASSERT_TRUE(cache.get(make_key(scope, "q"), kEpoch, &results));
+  EXPECT_EQ(results.size(), 1u);
+  EXPECT_EQ(cache.count(), 1u);
+}
+
+TEST(FtsQueryCacheTest, OtherEpochDropsEntry) {
+  FtsQueryCache cache(1 << 20);
+  const uint64_t scope = FtsQueryCache::NewScope();
+  std::vector<FtsResult> results;
+
+  FtsQueryParams params;
+  auto stats = std::make_shared<FtsCollectionStats>();
+  stats->total_docs = 100;
+  stats->total_tokens = 1000;
+  stats->doc_freqs["alpha"] = 7;
+  params.collection_stats = stats;
+  const FtsQueryCache::Epoch first{0, FtsQueryCache::StatsEpoch(params)};
+  cache.put(make_key(scope, "q"), first, make_results(3));
+  const size_t bytes = cache.size_in_bytes();
+
+  // Inserts elsewhere in the collection move the statistics: the sealed
+  // segment's entry is stale and goes, instead of lingering beside a new one.
+  stats->total_docs = 101;
+  const FtsQueryCache::Epoch second{0, FtsQueryCache::StatsEpoch(params)};
+  EXPECT_FALSE(cache.get(make_key(scope, "q"), second, &results));
+  EXPECT_EQ(cache.count(), 0u);
+  EXPECT_EQ(cache.size_in_bytes(), 0u);
+
+  cache.put(make_key(scope, "q"), second, make_results(3));
+  EXPECT_EQ(cache.size_in_bytes(), bytes);
+  ASSERT_TRUE(cache.get(make_key(scope, "q"), second, &results));
+  EXPECT_EQ(results.size(), 3u);
+
+  // So do deletes in the segment.
+  const FtsQueryCache::Epoch deleted{1, second.stats};
+  EXPECT_FALSE(cache.get(make_key(scope, "q"), deleted, &results));
+  cache.put(make_key(scope, "q"), deleted, make_results(2));
+  EXPECT_EQ(cache.count(), 1u);
+  EXPECT_FALSE(cache.get(make_key(scope, "q"), second, &results));
+  EXPECT_EQ(cache.count(), 0u);
+}
+
+TEST(FtsQueryCacheTest, EraseScopeDropsOnlyThatScope) {
+  FtsQueryCache cache(1 << 20);
+  const uint64_t a = FtsQueryCache::NewScope();
+  const uint64_t b = FtsQueryCache::NewScope();
+  for (int i = 0; i < 10; ++i) {
+    cache.put(make_key(a, "q" + std::to_string(i)), kEpoch, make_results(2));
+    cache.put(make_key(b, "q" + std::to_string(i)), kEpoch, make_results(2));
+  }
+  ASSERT_EQ(cache.count(), 20u);
+  const size_t bytes = cache.size_in_bytes();
+
+  cache.erase_scope(a);
+  EXPECT_EQ(cache.count(), 10u);
+  EXPECT_EQ(cache.size_in_bytes(), bytes / 2);
+  std::vector<FtsResult> results;
+  EXPECT_FALSE(cache.get(make_key(a, "q0"), kEpoch, &results));
+  EXPECT_TRUE(cache.get(make_key(b, "q0"), kEpoch, &results));
+
+  cache.erase_scope(b);
+  EXPECT_EQ(cache.count(), 0u);
+  EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
+
+TEST(FtsQueryCacheTest, EvictsLeastRecentlyUsedWithinCapacity) {
+  // Room for a handful of entries per shard.
+  const size_t capacity = 16 * 1024;
+  FtsQueryCache cache(capacity);
+  const uint64_t scope = FtsQueryCache::NewScope();
+  std::vector<FtsResult> results;
+
+  cache.put(make_key(scope, "hot"), kEpoch, make_results(8));
+  for (int i = 0; i < 500; ++i) {
+    cache.put(make_key(scope, "q" + std::to_string(i)), kEpoch, make_results(8));
+    // Touching the hot entry keeps it at the head of its shard.
+    ASSERT_TRUE(cache.get(make_key(scope, "hot"), kEpoch, &results)) << i;
+    ASSERT_LE(cache.size_in_bytes(), capacity);
+  }
+  EXPECT_LT(cache.count(), 500u);
+  EXPECT_FALSE(cache.get(make_key(scope, "q0"), kEpoch, &results));
+  EXPECT_TRUE(cache.get(make_key(scope, "q499"), kEpoch, &results));
+
+  // An entry larger than a shard is never admitted.
+  cache.put(make_key(scope, "huge"), kEpoch, make_results(capacity));
+  EXPECT_FALSE(cache.get(make_key(scope, "huge"), kEpoch, &results));
+}
+
+TEST(FtsQueryCacheTest, ZeroCapacityDisablesCache) {
+  FtsQueryCache cache(0);
+  const uint64_t scope = FtsQueryCache::NewScope();
+  cache.put(make_key(scope, "q"), kEpoch, make_results(1));
+  std::vector<FtsResult> results;
+  EXPECT_FALSE(cache.get(make_key(scope, "q"), kEpoch, &results));
+  EXPECT_EQ(cache.count(), 0u);
+  EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
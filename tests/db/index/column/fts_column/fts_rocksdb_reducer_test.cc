@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <gtest/gtest.h>
 #include <roaring/roaring.h>
@@ -403,6 +404,44 @@ TEST_F(FtsRocksdbReducerTest, FeedAcceptsEmptySegmentAsNoop) {
   EXPECT_EQ(results[0].doc_id, 3ull);
 }
 
+// The merged segment may only rely on the phrase shingles every non-empty
+// source indexed for all its docs.
+TEST_F(FtsRocksdbReducerTest, MergedPhraseShinglesAreIntersected) {
+  auto indexer0 = MakeSrc0Indexer();
+  InsertDocs(indexer0.get(), {{0, "machine learning"}});
+  auto indexer1 = MakeSrc1Indexer();
+  InsertDocs(indexer1.get(), {{0, "deep learning"}});
+
+  std::string machine_learning, deep_learning;
+  make_shingle_term("machine", "learning", &machine_learning);
+  make_shingle_term("deep", "learning", &deep_learning);
+
+  FtsRocksdbReducer reducer = MakeReducer();
+  ASSERT_TRUE(reducer
+                  .feed(MakeSegmentStats(0, 0), &src0_db_, src0_postings_,
+                        src0_positions_, {machine_learning, deep_learning})
+                  .has_value());
+  FtsSegmentStats empty_stats;
+  empty_stats.doc_count = 0;
+  ASSERT_TRUE(
+      reducer.feed(empty_stats, &src1_db_, src1_postings_, src1_positions_)
+          .has_value());
+  ASSERT_TRUE(reducer
+                  .feed(MakeSegmentStats(1, 1), &src1_db_, src1_postings_,
+                        src1_positions_, {machine_learning})
+                  .has_value());
+  ASSERT_TRUE(reducer.reduce(NoDeleteFilter()).has_value());
+
+  std::string value;
+  ASSERT_TRUE(dst_db_.db_
+                  ->Get(dst_db_.read_opts_, dst_stat_,
+                        make_phrase_shingles_key(kFieldName), &value)
+                  .ok());
+  std::unordered_set<std::string> shingles;
+  decode_shingle_set(value, &shingles);
+  EXPECT_EQ(shingles, std::unordered_set<std::string>({machine_learning}));
+}
+
 // ============================================================
 // Single segment: basic merge without deletes
 // ============================================================
@@ -0,0 +1,360 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/index/column/fts_column/fts_sealed_postings.h"
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <gtest/gtest.h>
+#include <zvec/db/index_params.h>
+#include "db/common/constants.h"
+#include "db/common/file_helper.h"
+#include "db/index/column/fts_column/fts_ast_rewriter.h"
+#include "db/index/column/fts_column/fts_column_indexer.h"
+#include "db/index/column/fts_column/fts_rocksdb_merge.h"
+#include "db/index/column/fts_column/parser/fts_query_parser.h"
+#include "db/index/column/fts_column/posting/bitpacked_posting_list.h"
+#include "db/index/column/fts_column/tokenizer/tokenizer_factory.h"
+
+using namespace zvec;
+using namespace zvec::fts;
+
+namespace {
+
+const std::string kSealedDir{"./test_fts_sealed"};
+
+// A byte string that passes the BitPacked magic check; the reader never
+// decodes it.
+std::string fake_posting(const std::string &term) {
+  std::string data(sizeof(uint32_t), '\0');
+  const uint32_t magic = BitPackedPostingList::MAGIC;
+  std::memcpy(data.data(), &magic, sizeof(magic));
+  return data + term;
+}
+
+}  // namespace
+
+class FtsSealedPostingsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    zvec::FileHelper::RemoveDirectory(kSealedDir);
+    ASSERT_TRUE(zvec::FileHelper::CreateDirectory(kSealedDir));
+  }
+
+  void TearDown() override {
+    zvec::FileHelper::RemoveDirectory(kSealedDir);
+  }
+};
+
+// Delta-varint position slice, as stored in the $POS column family.
+std::string encode_positions(const std::vector<uint32_t> &positions) {
+  std::string data;
+  uint32_t last = 0;
+  for (uint32_t position : positions) {
+    uint32_t delta = position - last;
+    while (delta >= 0x80) {
+      data.push_back(static_cast<char>((delta & 0x7F) | 0x80));
+      delta >>= 7;
+    }
+    data.push_back(static_cast<char>(delta));
+    last = position;
+  }
+  return data;
+}
+
+// Terms sharing long prefixes across several restart runs must all resolve,
+// and terms between, before and after them must miss.
+TEST_F(FtsSealedPostingsTest, DictionaryLookupAcrossRestarts) {
+  std::map<std::string, std::map<uint32_t, std::vector<uint32_t>>> terms;
+  for (uint32_t i = 0; i < 200; ++i) {
+    const std::string term = "term_" + std::to_string(i * 3);
+    for (uint32_t doc = 0; doc < i % 4; ++doc) {
+      for (uint32_t k = 0; k <= doc; ++k) {
+        terms[term][doc * 7].push_back(i + k * 5);
+      }
+    }
+  }
+
+  {
+    FtsSealedPostings::Writer writer(kSealedDir, "content");
+    ASSERT_TRUE(writer.open().ok());
+    for (const auto &[term, positions] : terms) {
+      ASSERT_TRUE(writer.add_term(term, fake_posting(term)).ok());
+      for (const auto &[doc_id, doc_positions] : positions) {
+        ASSERT_TRUE(
+            writer.add_positions(doc_id, encode_positions(doc_positions))
+                .ok());
+      }
+    }
+    ASSERT_TRUE(writer.finish().ok());
+  }
+
+  auto sealed = FtsSealedPostings::Open(kSealedDir, "content");
+  ASSERT_NE(sealed, nullptr);
+  EXPECT_EQ(sealed->term_count(), terms.size());
+
+  for (const auto &[term, positions] : terms) {
+    rocksdb::PinnableSlice posting;
+    ASSERT_TRUE(sealed->get_postings(term, &posting)) << term;
+    EXPECT_EQ(posting.ToString(), fake_posting(term));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(posting.data()) % 16, 0u);
+
+    auto term_positions = sealed->get_positions(term);
+    EXPECT_EQ(term_positions.empty(), positions.empty());
+    std::vector<uint32_t> found;
+    for (const auto &[doc_id, doc_positions] : positions) {
+      ASSERT_TRUE(term_positions.find(doc_id, &found));
+      EXPECT_EQ(found, doc_positions);
+    }
+    EXPECT_FALSE(term_positions.find(1, &found));
+  }
+
+  for (const std::string miss : {"", "a", "term_", "term_1", "term_597x",
+                                 "term_598", "zzz"}) {
+    rocksdb::PinnableSlice posting;
+    EXPECT_FALSE(sealed->get_postings(miss, &posting)) << miss;
+    EXPECT_TRUE(sealed->get_positions(miss).empty()) << miss;
+  }
+}
+
+// One term spread over many blocks, with docs whose positions straddle
+// packed chunks: lookups must decode the same positions in ascending order,
+// after jumping backwards, and across skipped blocks.
+TEST_F(FtsSealedPostingsTest, PositionsAcrossBlocksAndChunks) {
+  std::map<uint32_t, std::vector<uint32_t>> docs;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    const uint32_t doc_id = i * 3 + (i % 7 == 0 ? 1 : 0);
+    const uint32_t freq = i % 97 == 0 ? 300 : 1 + (i * 13) % 9;
+    uint32_t position = i % 5;
+    for (uint32_t k = 0; k < freq; ++k) {
+      docs[doc_id].push_back(position);
+      position += 1 + (k * 31 + i) % (i % 11 == 0 ? 70000 : 40);
+    }
+  }
+
+  {
+    FtsSealedPostings::Writer writer(kSealedDir, "content");
+    ASSERT_TRUE(writer.open().ok());
+    ASSERT_TRUE(writer.add_term("alpha", fake_posting("alpha")).ok());
+    for (const auto &[doc_id, positions] : docs) {
+      ASSERT_TRUE(
+          writer.add_positions(doc_id, encode_positions(positions)).ok());
+    }
+    ASSERT_TRUE(writer.add_term("beta", fake_posting("beta")).ok());
+    EXPECT_FALSE(writer.add_positions(5, std::string(1, '\x80')).ok());
+    ASSERT_TRUE(writer.finish().ok());
+  }
+
+  auto sealed = FtsSealedPostings::Open(kSealedDir, "content");
+  ASSERT_NE(sealed, nullptr);
+  EXPECT_TRUE(sealed->get_positions("beta").empty());
+
+  auto ascending = sealed->get_positions("alpha");
+  std::vector<uint32_t> found;
+  for (uint32_t doc_id = 0; doc_id < 3005; ++doc_id) {
+    auto it = docs.find(doc_id);
+    ASSERT_EQ(ascending.find(doc_id, &found), it != docs.end()) << doc_id;
+    if (it != docs.end()) {
+      EXPECT_EQ(found, it->second) << doc_id;
+    } else {
+      EXPECT_TRUE(found.empty());
+    }
+  }
+
+  auto sparse = sealed->get_positions("alpha");
+  for (uint32_t doc_id : {2997u, 3u, 1500u, 1501u, 0u, 2997u, 6u}) {
+    auto it = docs.find(doc_id);
+    ASSERT_EQ(sparse.find(doc_id, &found), it != docs.end()) << doc_id;
+    if (it != docs.end()) {
+      EXPECT_EQ(found, it->second) << doc_id;
+    }
+  }
+}
+
+TEST_F(FtsSealedPostingsTest, WriterRejectsUnsortedTermsAndRawPostings) {
+  FtsSealedPostings::Writer writer(kSealedDir, "content");
+  ASSERT_TRUE(writer.open().ok());
+  ASSERT_TRUE(writer.add_term("beta", fake_posting("beta")).ok());
+  EXPECT_FALSE(writer.add_term("alpha", fake_posting("alpha")).ok());
+  EXPECT_FALSE(writer.add_term("gamma", "not bitpacked").ok());
+  writer.abort();
+  EXPECT_FALSE(FtsSealedPostings::Exists(kSealedDir, "content"));
+}
+
+TEST_F(FtsSealedPostingsTest, EmptyFieldLinkAndRemove) {
+  {
+    FtsSealedPostings::Writer writer(kSealedDir, "content");
+    ASSERT_TRUE(writer.open().ok());
+    ASSERT_TRUE(writer.finish().ok());
+  }
+  auto sealed = FtsSealedPostings::Open(kSealedDir, "content");
+  ASSERT_NE(sealed, nullptr);
+  rocksdb::PinnableSlice posting;
+  EXPECT_FALSE(sealed->get_postings("any", &posting));
+
+  const std::string snapshot_dir = kSealedDir + "/snapshot";
+  ASSERT_TRUE(zvec::FileHelper::CreateDirectory(snapshot_dir));
+  ASSERT_TRUE(
+      FtsSealedPostings::Link(kSealedDir, snapshot_dir, "content").ok());
+  EXPECT_NE(FtsSealedPostings::Open(snapshot_dir, "content"), nullptr);
+
+  FtsSealedPostings::Remove(snapshot_dir, "content");
+  EXPECT_FALSE(FtsSealedPostings::Exists(snapshot_dir, "content"));
+  EXPECT_EQ(FtsSealedPostings::Open(snapshot_dir, "content"), nullptr);
+}
+
+// ============================================================
+// Sealed column: search over the mapping matches search over RocksDB
+// ============================================================
+
+namespace {
+
+std::vector<FtsResult> search_query(const FtsColumnIndexer &indexer,
+                                    const std::string &query,
+                                    bool anytime = false,
+                                    uint64_t anytime_max_postings = 0) {
+  zvec::fts::FtsIndexParams params;
+  params.tokenizer_name = "whitespace";
+  params.filters = {"lowercase"};
+  auto pipeline = TokenizerFactory::create(params).value();
+  FtsQueryParser parser;
+  auto ast = parser.parse(query, pipeline);
+  EXPECT_TRUE(ast) << query;
+  if (!ast) {
+    return {};
+  }
+  simplify(ast);
+  FtsQueryParams query_params;
+  query_params.topk = 100;
+  query_params.anytime = anytime;
+  query_params.anytime_max_postings = anytime_max_postings;
+  auto ret = indexer.search(*ast, query_params);
+  EXPECT_TRUE(ret.has_value()) << query;
+  return ret.has_value() ? ret.value() : std::vector<FtsResult>{};
+}
+
+}  // namespace
+
+TEST_F(FtsSealedPostingsTest, SealedSearchMatchesRocksdbSearch) {
+  const std::string db_path = kSealedDir + "/fts.rocksdb";
+  const std::string field = "content";
+  std::vector<std::string> cf_names = {field,
+                                       field + zvec::kFtsPositionsSuffix,
+                                       field + zvec::kFtsTfSuffix,
+                                       field + zvec::kFtsMaxTfSuffix,
+                                       field + zvec::kFtsDocLenSuffix,
+                                       zvec::kFtsStatCfName};
+  std::unordered_map<std::string, std::shared_ptr<rocksdb::MergeOperator>>
+      per_cf_ops = {
+          {field, std::make_shared<FtsPostingsMerge>()},
+          {field + zvec::kFtsMaxTfSuffix, std::make_shared<FtsMaxTfMerge>()},
+      };
+  RocksdbContext db;
+  ASSERT_TRUE(
+      db.create(RocksdbContext::Args{db_path, cf_names, nullptr, per_cf_ops})
+          .ok());
+
+  auto fts_params = std::make_shared<zvec::FtsIndexParams>("whitespace");
+  auto field_meta = std::make_shared<FieldSchema>(field, DataType::STRING,
+                                                  false, fts_params);
+  FtsColumnIndexer indexer;
+  ASSERT_TRUE(indexer
+                  .open(field_meta, &db, db.get_cf(cf_names[0]),
+                        db.get_cf(cf_names[1]), db.get_cf(cf_names[2]),
+                        db.get_cf(cf_names[3]), db.get_cf(cf_names[4]),
+                        db.get_cf(cf_names[5]))
+                  .has_value());
+
+  const std::vector<std::string> docs = {
+      "the quick brown fox", "quick brown dogs and quick cats",
+      "a lazy brown fox",    "fox jumps over the lazy dog",
+      "brown brown brown",   "nothing in common",
+  };
+  for (uint32_t i = 0; i < 300; ++i) {
+    ASSERT_TRUE(indexer.insert(i, docs[i % docs.size()]).has_value());
+  }
+  ASSERT_TRUE(indexer.flush().has_value());
+  ASSERT_TRUE(indexer.convert_postings_to_bitpacked().has_value());
+
+  const std::vector<std::string> queries = {
+      "brown",          "fox",
+      "quick brown",    "\"brown fox\"",
+      "\"lazy dog\"",   "brown OR cats",
+      "missing",        "\"brown brown\"",
+      "\"fox brown\"~2", "\"quick cats\"~3"};
+  std::vector<std::vector<FtsResult>> expected;
+  for (const auto &query : queries) {
+    expected.push_back(search_query(indexer, query));
+  }
+
+  ASSERT_TRUE(FtsSealedPostings::Build(db_path, field, &db,
+                                       indexer.postings_cf(),
+                                       indexer.positions_cf())
+                  .ok());
+  auto sealed = FtsSealedPostings::Open(db_path, field);
+  ASSERT_NE(sealed, nullptr);
+  indexer.attach_sealed_postings(sealed);
+
+  for (size_t q = 0; q < queries.size(); ++q) {
+    auto actual = search_query(indexer, queries[q]);
+    ASSERT_EQ(actual.size(), expected[q].size()) << queries[q];
+    for (size_t i = 0; i < actual.size(); ++i) {
+      EXPECT_EQ(actual[i].doc_id, expected[q][i].doc_id) << queries[q];
+      EXPECT_FLOAT_EQ(actual[i].score, expected[q][i].score) << queries[q];
+    }
+  }
+
+  // Anytime search needs impacts; without them it is the regular search.
+  EXPECT_EQ(search_query(indexer, "brown", true).size(),
+            expected[0].size());
+
+  // Rebuild with impacts.  Term disjunctions rank from the impacts and are
+  // rescored exactly, so scores only drift within a quantization step; any
+  // other query ignores the anytime flag.
+  indexer.attach_sealed_postings(nullptr);
+  sealed.reset();
+  FtsSealedPostings::Remove(db_path, field);
+  ASSERT_TRUE(FtsSealedPostings::Build(db_path, field, &db,
+                                       indexer.postings_cf(),
+                                       indexer.positions_cf(),
+                                       indexer.scorer().get())
+                  .ok());
+  sealed = FtsSealedPostings::Open(db_path, field);
+  ASSERT_NE(sealed, nullptr);
+  ASSERT_TRUE(sealed->has_impacts());
+  indexer.attach_sealed_postings(sealed);
+
+  for (size_t q = 0; q < queries.size(); ++q) {
+    auto actual = search_query(indexer, queries[q], true);
+    ASSERT_EQ(actual.size(), expected[q].size()) << queries[q];
+    for (size_t i = 0; i < actual.size(); ++i) {
+      EXPECT_NEAR(actual[i].score, expected[q][i].score, 0.05f)
+          << queries[q];
+    }
+  }
+
+  // A posting limit cuts the scan short but still returns exact scores.
+  auto limited = search_query(indexer, "brown OR cats", true, 1);
+  ASSERT_FALSE(limited.empty());
+  EXPECT_LE(limited.size(), expected[5].size());
+  for (size_t i = 1; i < limited.size(); ++i) {
+    EXPECT_GE(limited[i - 1].score, limited[i].score);
+  }
+
+  ASSERT_TRUE(indexer.close().has_value());
+  db.close();
+}
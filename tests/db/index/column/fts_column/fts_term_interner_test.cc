@@ -0,0 +1,65 @@
+// Copyright 2025-present the zvec project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "db/index/column/fts_column/fts_term_interner.h"
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace zvec::fts;
+
+TEST(TermInternerTest, AssignsDenseIdsInFirstSeenOrder) {
+  TermInterner interner;
+  EXPECT_EQ(interner.intern("beta"), 0u);
+  EXPECT_EQ(interner.intern("alpha"), 1u);
+  EXPECT_EQ(interner.intern("beta"), 0u);
+  EXPECT_EQ(interner.intern(""), 2u);
+  EXPECT_EQ(interner.size(), 3u);
+
+  EXPECT_EQ(interner.find("alpha"), 1u);
+  EXPECT_EQ(interner.find(""), 2u);
+  EXPECT_EQ(interner.find("gamma"), TermInterner::kNotFound);
+  EXPECT_EQ(interner.term(0), "beta");
+  EXPECT_EQ(interner.term(1), "alpha");
+}
+
+TEST(TermInternerTest, EmptyInternerFindsNothing) {
+  TermInterner interner;
+  EXPECT_EQ(interner.find("anything"), TermInterner::kNotFound);
+  EXPECT_EQ(interner.size(), 0u);
+}
+
+// Terms must survive table growth and arena block switches, including terms
+// larger than an arena block.
+TEST(TermInternerTest, TermsStayValidAcrossGrowth) {
+  TermInterner interner;
+  std::vector<std::string> terms;
+  for (int i = 0; i < 50000; ++i) {
+    terms.push_back("term_" + std::to_string(i));
+  }
+  terms.push_back(std::string(100000, 'x'));
+  terms.push_back(std::string(20000, 'y'));
+
+  for (size_t i = 0; i < terms.size(); ++i) {
+    // The source string is a temporary copy: the interner must own the bytes.
+    std::string copy = terms[i];
+    ASSERT_EQ(interner.intern(copy), i);
+  }
+  ASSERT_EQ(interner.size(), terms.size());
+  for (size_t i = 0; i < terms.size(); ++i) {
+    EXPECT_EQ(interner.term(static_cast<uint32_t>(i)), terms[i]);
+    EXPECT_EQ(interner.find(terms[i]), i);
+    EXPECT_EQ(interner.intern(terms[i]), i);
+  }
+}
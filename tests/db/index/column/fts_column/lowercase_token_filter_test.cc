@@ -122,3 +122,13 @@ TEST_F(LowercaseTokenFilterTest, PreservesOffsetAndPosition) {
   EXPECT_EQ(result[0].offset, 5);
   EXPECT_EQ(result[0].position, 3);
 }
+
+TEST_F(LowercaseTokenFilterTest, ApplyRewritesInPlace) {
+  std::string text = "ABC\xC3\x84\xC3\x96";  // "ABCÄÖ"
+  EXPECT_TRUE(filter_.apply(&text));
+  EXPECT_EQ(text, "abc\xC3\xA4\xC3\xB6");  // "abcäö"
+
+  text = "MiXeD";
+  EXPECT_TRUE(filter_.apply(&text));
+  EXPECT_EQ(text, "mixed");
+}
@@ -12,10 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cctype>
+#include <random>
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
 #include "db/index/column/fts_column/fts_types.h"
+#include "db/index/column/fts_column/tokenizer/ascii_simd_dispatch.h"
 #include "db/index/column/fts_column/tokenizer/tokenizer_factory.h"
 
 using namespace zvec::fts;
@@ -483,3 +486,192 @@ TEST(StandardTokenizerConfigTest, MaxTokenLengthValidation) {
   params.extra_params = R"({"max_token_length":1})";
   EXPECT_TRUE(TokenizerFactory::create(params).has_value());
 }
+
+// --- Streaming API ---
+
+// process_stream() must emit exactly what process() returns, with and
+// without filters, on both the ASCII fast path and the UAX#29 path.
+TEST(StandardTokenizerStreamTest, StreamMatchesProcess) {
+  const std::vector<std::string> texts = {
+      "Hello, World! foo_bar 3.14 e-mail",
+      "Caf\xC3\xA9 \xC3\x86sir STRASSE \xE4\xB8\xAD\xE6\x96\x87 running",
+      std::string(600, 'a') + " tail",
+      "",
+  };
+  for (const auto &filters :
+       {std::vector<std::string>{},
+        std::vector<std::string>{"lowercase", "ascii_folding"}}) {
+    FtsIndexParams params;
+    params.tokenizer_name = "standard";
+    params.filters = filters;
+    auto pipeline = TokenizerFactory::create(params).value();
+    for (const auto &text : texts) {
+      auto expected = pipeline->process(text);
+      std::vector<Token> streamed;
+      pipeline->process_stream(text, [&](const TokenView &token) {
+        streamed.push_back(
+            Token{std::string(token.text), token.offset, token.position});
+      });
+      ASSERT_EQ(streamed.size(), expected.size()) << text;
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(streamed[i].text, expected[i].text);
+        EXPECT_EQ(streamed[i].offset, expected[i].offset);
+        EXPECT_EQ(streamed[i].position, expected[i].position);
+      }
+    }
+  }
+}
+
+// Without filters the streamed views point into the source text.
+TEST(StandardTokenizerStreamTest, UnfilteredViewsPointIntoSource) {
+  FtsIndexParams params;
+  params.tokenizer_name = "standard";
+  params.filters.clear();
+  auto pipeline = TokenizerFactory::create(params).value();
+  const std::string text = "alpha beta";
+  size_t count = 0;
+  pipeline->process_stream(text, [&](const TokenView &token) {
+    EXPECT_EQ(token.text.data(), text.data() + token.offset);
+    ++count;
+  });
+  EXPECT_EQ(count, 2u);
+}
+
+// --- ASCII fast path ---
+
+namespace {
+
+TokenizerPipelinePtr make_standard_pipeline(uint32_t max_token_length) {
+  FtsIndexParams params;
+  params.tokenizer_name = "standard";
+  params.filters.clear();
+  params.extra_params =
+      R"({"max_token_length":)" + std::to_string(max_token_length) + "}";
+  return TokenizerFactory::create(params).value();
+}
+
+// Random ASCII mixing word bytes with every punctuation class the word-break
+// rules treat specially, so runs end at connectors as well as separators.
+std::string random_ascii(std::mt19937 *rng, size_t size, bool with_spaces) {
+  static const std::string kAlphabet =
+      "abcXYZ019_.,;:'\"-/!@#*()[]{}\t\n";
+  std::uniform_int_distribution<size_t> pick(0, kAlphabet.size() - 1);
+  std::string text;
+  for (size_t i = 0; i < size; ++i) {
+    char ch = kAlphabet[pick(*rng)];
+    if (!with_spaces && (ch == '\t' || ch == '\n')) {
+      ch = '-';
+    }
+    text.push_back(ch);
+  }
+  return text;
+}
+
+}  // namespace
+
+// Pure-ASCII text goes through the byte-scanning fast path.  Wrapping it in
+// non-ASCII words keeps it in one UAX #29 segment, so both paths must agree
+// token for token.
+TEST(StandardTokenizerAsciiTest, FastPathMatchesUnicodePath) {
+  const std::string kWord = "\xC3\xA9";  // U+00E9, ALetter
+  std::mt19937 rng(20251018);
+  for (uint32_t max_len : {1u, 3u, 255u}) {
+    auto pipeline = make_standard_pipeline(max_len);
+    for (int round = 0; round < 500; ++round) {
+      // Shorter than the run needed to switch back to the ASCII path.
+      const std::string ascii = random_ascii(&rng, 1 + round % 60, true);
+      const std::string wrapped = kWord + "-" + ascii + "-" + kWord;
+      auto expected = pipeline->process(ascii);
+      auto actual = pipeline->process(wrapped);
+      ASSERT_EQ(actual.size(), expected.size() + 2) << ascii;
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i + 1].text, expected[i].text) << ascii;
+        EXPECT_EQ(actual[i + 1].offset, expected[i].offset + 3) << ascii;
+        EXPECT_EQ(actual[i + 1].position, expected[i].position + 1) << ascii;
+      }
+    }
+  }
+}
+
+// Mixed text is cut at whitespace into ASCII and non-ASCII segments; the
+// result must equal tokenizing every piece on its own.
+TEST(StandardTokenizerAsciiTest, MixedSegmentsMatchPerPieceTokenization) {
+  const std::vector<std::string> unicode_pieces = {
+      "Caf\xC3\xA9", "na\xC3\xAFve's", "\xE4\xB8\xAD\xE6\x96\x87",
+      "\xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD", "e\xCC\x81t\xC3\xA9_x",
+      "\xFF\xFE" "broken"};
+  std::mt19937 rng(7);
+  auto pipeline = make_standard_pipeline(255);
+  for (int round = 0; round < 200; ++round) {
+    std::vector<std::string> pieces;
+    const int piece_count = 1 + round % 8;
+    for (int i = 0; i < piece_count; ++i) {
+      if (rng() % 3 == 0) {
+        pieces.push_back(unicode_pieces[rng() % unicode_pieces.size()]);
+      } else {
+        pieces.push_back(random_ascii(&rng, rng() % 150, false));
+      }
+    }
+
+    std::string text;
+    std::vector<Token> expected;
+    for (const auto &piece : pieces) {
+      if (!text.empty()) {
+        text.push_back(' ');
+      }
+      const auto base_offset = static_cast<uint32_t>(text.size());
+      const auto base_position = static_cast<uint32_t>(expected.size());
+      for (auto token : pipeline->process(piece)) {
+        token.offset += base_offset;
+        token.position += base_position;
+        expected.push_back(std::move(token));
+      }
+      text += piece;
+    }
+
+    auto actual = pipeline->process(text);
+    ASSERT_EQ(actual.size(), expected.size()) << text;
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i].text, expected[i].text) << text;
+      EXPECT_EQ(actual[i].offset, expected[i].offset) << text;
+      EXPECT_EQ(actual[i].position, expected[i].position) << text;
+    }
+  }
+}
+
+// The dispatched (SIMD when available) classifiers agree with the scalar
+// ones at every start offset, across the 64-byte block boundaries.
+TEST(StandardTokenizerAsciiTest, DispatchedClassifiersMatchScalar) {
+  const auto &dispatch = simd::get_ascii_dispatch();
+  std::mt19937 rng(99);
+  for (int round = 0; round < 300; ++round) {
+    std::string text = random_ascii(&rng, round, true);
+    if (round % 4 == 1 && !text.empty()) {
+      text[rng() % text.size()] = static_cast<char>(0xC3);
+    }
+    EXPECT_EQ(dispatch.ascii_prefix_length(text.data(), text.size()),
+              simd::scalar_ascii_prefix_length(text.data(), text.size()));
+
+    std::vector<uint64_t> bits(text.size() / 64 + 1);
+    std::vector<uint64_t> scalar_bits(text.size() / 64 + 1);
+    for (size_t start = 0; start <= text.size(); ++start) {
+      const size_t end = dispatch.classify_ascii(text.data(), text.size(),
+                                                 start, bits.data());
+      ASSERT_EQ(end, simd::scalar_classify_ascii(text.data(), text.size(),
+                                                 start, scalar_bits.data()));
+      for (size_t i = start; i < end; ++i) {
+        const bool bit = (bits[i / 64] >> (i % 64)) & 1;
+        ASSERT_EQ(bit, ((scalar_bits[i / 64] >> (i % 64)) & 1) != 0) << i;
+        const auto ch = static_cast<unsigned char>(text[i]);
+        EXPECT_EQ(bit, std::isalnum(ch) != 0 || ch == '_') << i;
+      }
+    }
+
+    std::string lowered = text;
+    std::string expected = text;
+    EXPECT_EQ(
+        dispatch.lower_ascii_prefix(lowered.data(), lowered.size()),
+        simd::scalar_lower_ascii_prefix(expected.data(), expected.size()));
+    EXPECT_EQ(lowered, expected);
+  }
+}
@@ -269,6 +269,8 @@ TEST(MetricTypeCodeBookTest, WireToCppConversion) {
   EXPECT_EQ(MetricTypeCodeBook::Get(wire::MetricType::MT_L2), MetricType::L2);
   EXPECT_EQ(MetricTypeCodeBook::Get(wire::MetricType::MT_COSINE),
             MetricType::COSINE);
+  EXPECT_EQ(MetricTypeCodeBook::Get(wire::MetricType::MT_HAMMING),
+            MetricType::HAMMING);
   EXPECT_EQ(MetricTypeCodeBook::Get(wire::MetricType::MT_UNDEFINED),
             MetricType::UNDEFINED);
   EXPECT_EQ(MetricTypeCodeBook::Get(static_cast<wire::MetricType>(999)),
@@ -281,6 +283,8 @@ TEST(MetricTypeCodeBookTest, CppToWireConversion) {
   EXPECT_EQ(MetricTypeCodeBook::Get(MetricType::L2), wire::MetricType::MT_L2);
   EXPECT_EQ(MetricTypeCodeBook::Get(MetricType::COSINE),
             wire::MetricType::MT_COSINE);
+  EXPECT_EQ(MetricTypeCodeBook::Get(MetricType::HAMMING),
+            wire::MetricType::MT_HAMMING);
   // MIPSL2 is a C++-only metric type without a wire-format counterpart.
   EXPECT_EQ(MetricTypeCodeBook::Get(MetricType::MIPSL2),
             wire::MetricType::MT_UNDEFINED);
@@ -295,6 +299,7 @@ TEST(MetricTypeCodeBookTest, CppToStringConversion) {
   EXPECT_EQ(MetricTypeCodeBook::AsString(MetricType::IP), "IP");
   EXPECT_EQ(MetricTypeCodeBook::AsString(MetricType::L2), "L2");
   EXPECT_EQ(MetricTypeCodeBook::AsString(MetricType::COSINE), "COSINE");
+  EXPECT_EQ(MetricTypeCodeBook::AsString(MetricType::HAMMING), "HAMMING");
   EXPECT_EQ(MetricTypeCodeBook::AsString(MetricType::MIPSL2), "UNDEFINED");
   EXPECT_EQ(MetricTypeCodeBook::AsString(MetricType::UNDEFINED), "UNDEFINED");
   EXPECT_EQ(MetricTypeCodeBook::AsString(static_cast<MetricType>(999)),
@@ -995,6 +995,34 @@ TEST(FieldSchemaTest, IvfIndexRejectsRabitqQuantization) {
       << status.message();
 }
 
+TEST(FieldSchemaTest, HammingIndexValidation) {
+  // Binary vectors are served by FLAT and HNSW with the hamming metric
+  for (auto data_type :
+       {DataType::VECTOR_BINARY32, DataType::VECTOR_BINARY64}) {
+    FieldSchema flat("vector_field", data_type, 8, false,
+                     std::make_shared<FlatIndexParams>(MetricType::HAMMING));
+    EXPECT_TRUE(flat.validate().ok()) << flat.validate().message();
+
+    FieldSchema hnsw(
+        "vector_field", data_type, 8, false,
+        std::make_shared<HnswIndexParams>(MetricType::HAMMING, 16, 100));
+    EXPECT_TRUE(hnsw.validate().ok()) << hnsw.validate().message();
+
+    FieldSchema ip("vector_field", data_type, 8, false,
+                   std::make_shared<FlatIndexParams>(MetricType::IP));
+    EXPECT_FALSE(ip.validate().ok());
+
+    FieldSchema ivf(
+        "vector_field", data_type, 8, false,
+        std::make_shared<IVFIndexParams>(MetricType::HAMMING, 128));
+    EXPECT_FALSE(ivf.validate().ok());
+  }
+
+  FieldSchema fp32("vector_field", DataType::VECTOR_FP32, 128, false,
+                   std::make_shared<FlatIndexParams>(MetricType::HAMMING));
+  EXPECT_FALSE(fp32.validate().ok());
+}
+
 TEST(FieldSchemaTest, IvfRabitqIndexValidationDimensionAndDataTypes) {
   {
     auto index_params =
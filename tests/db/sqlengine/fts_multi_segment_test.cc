@@ -38,8 +38,8 @@ namespace zvec::sqlengine {
 //   * segments_[0] (read LAST) holds the globally highest-scoring doc, and
 //   * segments_[1] (read FIRST) holds many low-scoring docs.
 //
-// Per-segment BM25 stats (rare term -> high IDF in segments_[0], common term
-// -> low IDF in segments_[1]) guarantee s0_0 outranks every doc in
+// All segments score with the collection-wide BM25 stats, so the same IDF
+// applies everywhere; s0_0's TF=5 guarantees it outranks every doc in
 // segments_[1]. Without the global sort the first doc in the merged stream is
 // the much lower-scoring s1_*, which breaks both the descending invariant and
 // topk truncation.
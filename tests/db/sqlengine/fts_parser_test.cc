@@ -211,6 +211,51 @@ TEST_F(FtsParserTest, PhraseWithThreeWords) {
   EXPECT_EQ(phrase.terms[2], "three");
 }
 
+TEST_F(FtsParserTest, PhraseWithSlop) {
+  auto ast = parse("\"exact phrase\"~3");
+  ASSERT_NE(ast, nullptr);
+  const auto &phrase = as_phrase(*ast);
+  ASSERT_EQ(phrase.terms.size(), 2u);
+  EXPECT_EQ(phrase.slop, 3u);
+  EXPECT_EQ(phrase.text(), "\"exact phrase\"~3");
+}
+
+TEST_F(FtsParserTest, PhraseWithSlopAndModifier) {
+  auto ast = parse("+\"exact phrase\"~2 other");
+  ASSERT_NE(ast, nullptr);
+  const auto &or_node = as_or(*ast);
+  ASSERT_EQ(or_node.children.size(), 2u);
+  const auto &phrase = as_phrase(*or_node.children[0]);
+  EXPECT_TRUE(phrase.must);
+  EXPECT_EQ(phrase.slop, 2u);
+  EXPECT_EQ(as_term(*or_node.children[1]).term, "other");
+}
+
+// Whitespace around `~` is insignificant; the slop belongs to the phrase.
+TEST_F(FtsParserTest, PhraseSlopWithSpaces) {
+  for (const std::string query :
+       {"\"exact phrase\" ~2", "\"exact phrase\"~ 2"}) {
+    auto ast = parse(query);
+    ASSERT_NE(ast, nullptr) << query;
+    EXPECT_EQ(as_phrase(*ast).slop, 2u) << query;
+  }
+}
+
+TEST_F(FtsParserTest, PhraseSlopRejectsFraction) {
+  auto ast = parse("\"exact phrase\"~1.5");
+  EXPECT_EQ(ast, nullptr);
+  EXPECT_EQ(err_msg(), "phrase slop must be a non-negative integer");
+}
+
+// `~` is reserved for phrase slop, like `^` for boost.
+TEST_F(FtsParserTest, TildeWithoutPhraseIsSyntaxError) {
+  for (const std::string query : {"foo~2", "foo ~ bar", "~"}) {
+    auto ast = parse(query);
+    EXPECT_EQ(ast, nullptr) << query;
+    EXPECT_FALSE(err_msg().empty()) << query;
+  }
+}
+
 // ============================================================
 // Explicit OR
 // ============================================================
@@ -485,15 +485,18 @@ class MockSegment : public Segment {
     return Status::OK();
   }
 
-  Status Insert(Doc &doc) override {
+  Status Insert(Doc &doc,
+                const fts::FtsTokenizedFields *fts_tokens = nullptr) override {
     return Status::OK();
   }
 
-  Status Upsert(Doc &doc) override {
+  Status Upsert(Doc &doc,
+                const fts::FtsTokenizedFields *fts_tokens = nullptr) override {
     return Status::OK();
   }
 
-  Status Update(Doc &doc) override {
+  Status Update(Doc &doc,
+                const fts::FtsTokenizedFields *fts_tokens = nullptr) override {
     return Status::OK();
   }
 